@@ -0,0 +1,206 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "AllocationRegistry.hpp"
+
+AllocationRegistry::AllocationRegistry()
+{
+    active = 0;
+}
+
+AllocationRegistry::~AllocationRegistry()
+{
+}
+
+void AllocationRegistry::activate()
+{
+    atomicCompareAndSwap(&active, 0, 1);
+}
+
+bool AllocationRegistry::isActive()
+{
+    return atomicLoad(&active) != 0;
+}
+
+void AllocationRegistry::add(void *pointer, size_t size, int kind, int device, void *owner)
+{
+    if (pointer == NULL || !isActive())
+    {
+        return;
+    }
+    char *start = (char*)pointer;
+    char *end = start + (size > 0 ? size : 1);
+
+    MutexLock lock(mutex);
+
+    // Remove the allocations that overlap the new one: Start at the
+    // last allocation that starts before the new one, and remove all
+    // allocations that start before the end of the new one
+    std::map<char*, AllocationInfo>::iterator it = allocations.upper_bound(start);
+    if (it != allocations.begin())
+    {
+        std::map<char*, AllocationInfo>::iterator previous = it;
+        previous--;
+        if (previous->second.start + previous->second.size > start)
+        {
+            it = previous;
+        }
+    }
+    while (it != allocations.end() && it->first < end)
+    {
+        allocations.erase(it++);
+    }
+
+    AllocationInfo info;
+    info.start = start;
+    info.size = size;
+    info.kind = kind;
+    info.device = device;
+    info.owner = owner;
+    allocations[start] = info;
+}
+
+void AllocationRegistry::remove(void *pointer)
+{
+    if (!isActive())
+    {
+        return;
+    }
+    MutexLock lock(mutex);
+    allocations.erase((char*)pointer);
+}
+
+void AllocationRegistry::removeOwner(void *owner)
+{
+    if (!isActive())
+    {
+        return;
+    }
+    MutexLock lock(mutex);
+    std::map<char*, AllocationInfo>::iterator it = allocations.begin();
+    while (it != allocations.end())
+    {
+        if (it->second.owner == owner)
+        {
+            allocations.erase(it++);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
+void AllocationRegistry::removeDevice(int device)
+{
+    if (!isActive())
+    {
+        return;
+    }
+    MutexLock lock(mutex);
+    std::map<char*, AllocationInfo>::iterator it = allocations.begin();
+    while (it != allocations.end())
+    {
+        if (it->second.device == device)
+        {
+            allocations.erase(it++);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
+bool AllocationRegistry::lookup(const void *pointer, AllocationInfo *info)
+{
+    char *p = (char*)pointer;
+    if (isActive())
+    {
+        MutexLock lock(mutex);
+        std::map<char*, AllocationInfo>::iterator it = allocations.upper_bound(p);
+        if (it != allocations.begin())
+        {
+            it--;
+            const AllocationInfo &candidate = it->second;
+            if (p < candidate.start + candidate.size || p == candidate.start)
+            {
+                *info = candidate;
+                return true;
+            }
+        }
+    }
+    info->start = NULL;
+    info->size = 0;
+    info->kind = ALLOCATION_KIND_UNKNOWN;
+    info->device = -1;
+    info->owner = NULL;
+    return false;
+}
+
+size_t AllocationRegistry::getCount()
+{
+    MutexLock lock(mutex);
+    return allocations.size();
+}
+
+CopyPath AllocationRegistry::selectCopyPath(const AllocationInfo &dst, const AllocationInfo &src)
+{
+    // If one side is unknown, it may be anything, and the direction
+    // has to be determined by the CUDA API
+    if (dst.kind == ALLOCATION_KIND_UNKNOWN || src.kind == ALLOCATION_KIND_UNKNOWN)
+    {
+        return COPY_PATH_DEFAULT;
+    }
+    bool dstDevice = (dst.kind == ALLOCATION_KIND_DEVICE);
+    bool srcDevice = (src.kind == ALLOCATION_KIND_DEVICE);
+    if (dstDevice && srcDevice)
+    {
+        if (dst.device != src.device || dst.device == -1)
+        {
+            return COPY_PATH_PEER;
+        }
+        return COPY_PATH_DEVICE_TO_DEVICE;
+    }
+    if (dstDevice)
+    {
+        return COPY_PATH_HOST_TO_DEVICE;
+    }
+    if (srcDevice)
+    {
+        return COPY_PATH_DEVICE_TO_HOST;
+    }
+
+    // Page-locked memory may be the target of asynchronous copies
+    // that are still pending, so only copies between pageable memory
+    // regions may be done with a plain memcpy
+    if (dst.kind == ALLOCATION_KIND_PAGEABLE && src.kind == ALLOCATION_KIND_PAGEABLE)
+    {
+        return COPY_PATH_HOST_TO_HOST;
+    }
+    return COPY_PATH_DEFAULT;
+}
@@ -0,0 +1,199 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ALLOCATIONREGISTRY
+#define ALLOCATIONREGISTRY
+
+#include "Threading.hpp"
+
+#include <map>
+
+/**
+ * The kinds of memory that are distinguished by the AllocationRegistry.
+ * The values of ALLOCATION_KIND_HOST and ALLOCATION_KIND_DEVICE match
+ * the values of CU_MEMORYTYPE_HOST / cudaMemoryTypeHost and
+ * CU_MEMORYTYPE_DEVICE / cudaMemoryTypeDevice, respectively.
+ */
+
+/** Memory that is not known to the registry */
+#define ALLOCATION_KIND_UNKNOWN  0
+
+/** Page-locked (or registered) host memory */
+#define ALLOCATION_KIND_HOST     1
+
+/** Device memory */
+#define ALLOCATION_KIND_DEVICE   2
+
+/**
+ * Pageable host memory. This is never stored in the registry, but
+ * may be assigned by callers that know that a pointer refers to
+ * pageable host memory, e.g. because it points to a Java array
+ */
+#define ALLOCATION_KIND_PAGEABLE 3
+
+
+/**
+ * Information about one allocation
+ */
+struct AllocationInfo
+{
+    /** The start address of the allocation */
+    char *start;
+
+    /** The size of the allocation, in bytes */
+    size_t size;
+
+    /** The ALLOCATION_KIND of the allocation */
+    int kind;
+
+    /** The device of the allocation, or -1 if it is not known */
+    int device;
+
+    /** The owner of the allocation, e.g. the context, or NULL */
+    void *owner;
+};
+
+
+/**
+ * The paths that may be used for a copy between two allocations
+ */
+enum CopyPath
+{
+    /** Let the CUDA API determine the direction (cuMemcpy / cudaMemcpyDefault) */
+    COPY_PATH_DEFAULT,
+
+    /** A plain memcpy between pageable host memory regions */
+    COPY_PATH_HOST_TO_HOST,
+
+    /** A copy from host memory to device memory */
+    COPY_PATH_HOST_TO_DEVICE,
+
+    /** A copy from device memory to host memory */
+    COPY_PATH_DEVICE_TO_HOST,
+
+    /** A copy between two allocations on the same device */
+    COPY_PATH_DEVICE_TO_DEVICE,
+
+    /** A copy between allocations on different devices */
+    COPY_PATH_PEER
+};
+
+
+/**
+ * A registry for the memory allocations that have been made through
+ * the bindings. It maps address intervals to the kind of memory and
+ * the device that they belong to. With unified virtual addressing,
+ * this allows determining the direction of a copy between two
+ * pointers without querying the driver.<br />
+ * <br />
+ * Allocations that are freed outside of the bindings (e.g. by
+ * destroying a context) may remain in the registry until they are
+ * removed with removeOwner or removeDevice, or until an overlapping
+ * allocation is added.<br />
+ * <br />
+ * The registry is inactive until activate() is called, e.g. when it
+ * is first queried. While it is inactive, all operations return
+ * immediately, so that callers may skip gathering the information
+ * about an allocation. Allocations that have been made before the
+ * activation are not known.<br />
+ * <br />
+ * Each library that links this class (e.g. the driver and the runtime
+ * API bindings) has its own registry, which only contains the
+ * allocations that have been made through this library.
+ */
+class AllocationRegistry
+{
+    public:
+        AllocationRegistry();
+        ~AllocationRegistry();
+
+        /**
+         * Activates this registry, so that it records allocations
+         */
+        void activate();
+
+        /**
+         * Returns whether this registry is active
+         */
+        bool isActive();
+
+        /**
+         * Adds the given allocation. Any allocations that overlap the
+         * given range are removed, because they can only be stale.
+         */
+        void add(void *pointer, size_t size, int kind, int device, void *owner);
+
+        /**
+         * Removes the allocation that starts at the given pointer,
+         * if it is present
+         */
+        void remove(void *pointer);
+
+        /**
+         * Removes all allocations that have the given owner
+         */
+        void removeOwner(void *owner);
+
+        /**
+         * Removes all allocations of the given device
+         */
+        void removeDevice(int device);
+
+        /**
+         * Looks up the allocation that contains the given pointer.
+         * Returns whether such an allocation was found. If not, then
+         * the kind of the given info is set to ALLOCATION_KIND_UNKNOWN.
+         */
+        bool lookup(const void *pointer, AllocationInfo *info);
+
+        /**
+         * Returns the number of allocations in this registry
+         */
+        size_t getCount();
+
+        /**
+         * Selects the path for copying between the given allocations.
+         * The kinds of the allocations may be ALLOCATION_KIND_PAGEABLE
+         * when the caller knows that they refer to pageable host memory.
+         */
+        static CopyPath selectCopyPath(const AllocationInfo &dst, const AllocationInfo &src);
+
+    private:
+        Mutex mutex;
+
+        /** Whether this registry is active */
+        volatile int active;
+
+        /** The allocations, by their start address */
+        std::map<char*, AllocationInfo> allocations;
+
+        AllocationRegistry(const AllocationRegistry&);
+        AllocationRegistry& operator=(const AllocationRegistry&);
+};
+
+
+#endif
@@ -0,0 +1,619 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "BounceRing.hpp"
+#include "Logger.hpp"
+#include "PointerUtils.hpp"
+
+#include <cstring>
+
+/**
+ * The slots of one stream. The slots are used in the order in which
+ * they are stored, so that the slot at the 'next' index is the one
+ * that was used least recently. A ring that was removed is only deleted
+ * when no thread is waiting for one of its slots any more.
+ */
+struct BounceStreamRing
+{
+    std::vector<BounceSlot*> slots;
+    size_t next;
+    int waiters;
+    bool removed;
+};
+
+/**
+ * The names of the primitive array classes, and the sizes of their
+ * elements in bytes
+ */
+static const char *arrayClassNames[] = { "[B", "[Z", "[C", "[S", "[I", "[F", "[J", "[D" };
+static const size_t arrayElementSizes[] = { 1, 1, 2, 2, 4, 4, 8, 8 };
+static const int arrayClassCount = 8;
+
+
+BounceRing::BounceRing(BounceRingFunctions functions, int notReadyResult)
+{
+    this->functions = functions;
+    this->notReadyResult = notReadyResult;
+    enabled = 0;
+    slotSize = 0;
+    slotCount = 0;
+    copies = 0;
+    bytes = 0;
+    waits = 0;
+    pending = 0;
+}
+
+BounceRing::~BounceRing()
+{
+}
+
+void BounceRing::enable(JNIEnv *env, size_t slotSize, int slotCount)
+{
+    MutexLock lock(mutex);
+    std::vector<BounceStreamRing*> removed;
+    if (this->slotSize != slotSize || this->slotCount != slotCount)
+    {
+        std::map<std::pair<void*, void*>, BounceStreamRing*>::iterator it;
+        for (it = rings.begin(); it != rings.end(); ++it)
+        {
+            removed.push_back(it->second);
+        }
+        rings.clear();
+    }
+    this->slotSize = slotSize;
+    this->slotCount = slotCount;
+    enabled = 1;
+    destroyRings(env, removed);
+}
+
+void BounceRing::disable(JNIEnv *env)
+{
+    MutexLock lock(mutex);
+    enabled = 0;
+    std::vector<BounceStreamRing*> removed;
+    std::map<std::pair<void*, void*>, BounceStreamRing*>::iterator it;
+    for (it = rings.begin(); it != rings.end(); ++it)
+    {
+        removed.push_back(it->second);
+    }
+    rings.clear();
+    destroyRings(env, removed);
+}
+
+bool BounceRing::isEnabled()
+{
+    return atomicLoad(&enabled) != 0;
+}
+
+size_t BounceRing::getSlotSize()
+{
+    MutexLock lock(mutex);
+    return slotSize;
+}
+
+bool BounceRing::acquire(JNIEnv *env, jobject pointerObject, size_t offset, void *stream, size_t size, bool readArray, BounceSlot **slot)
+{
+    *slot = NULL;
+    if (!isEnabled() || size == 0 || !env->IsInstanceOf(pointerObject, Pointer_class))
+    {
+        return true;
+    }
+
+    // Only Pointers to buffers that are backed by arrays are bounced
+    jobject buffer = env->GetObjectField(pointerObject, Pointer_buffer);
+    if (buffer == NULL)
+    {
+        return true;
+    }
+    jboolean isDirect = env->CallBooleanMethod(buffer, Buffer_isDirect);
+    if (env->ExceptionCheck())
+    {
+        return false;
+    }
+    if (isDirect)
+    {
+        env->DeleteLocalRef(buffer);
+        return true;
+    }
+    jarray array = (jarray)env->CallObjectMethod(buffer, Buffer_array);
+    env->DeleteLocalRef(buffer);
+    if (env->ExceptionCheck())
+    {
+        return false;
+    }
+    jlong byteOffset = env->GetLongField(pointerObject, Pointer_byteOffset);
+
+    // The range of the copy has to be checked here, since the array is
+    // accessed with memcpy
+    size_t arrayBytes = 0;
+    if (!getArrayBytes(env, array, &arrayBytes))
+    {
+        env->DeleteLocalRef(array);
+        return false;
+    }
+    size_t start = (size_t)byteOffset + offset;
+    if (byteOffset < 0 || start < offset || start > arrayBytes || size > arrayBytes - start)
+    {
+        env->DeleteLocalRef(array);
+        ThrowByName(env, "java/lang/ArrayIndexOutOfBoundsException",
+            "The copy exceeds the array of the host pointer");
+        return false;
+    }
+
+    void *owner = NULL;
+    if (functions.getOwner(&owner) != 0)
+    {
+        env->DeleteLocalRef(array);
+        return true;
+    }
+
+    BounceSlot *acquired = NULL;
+    {
+        MutexLock lock(mutex);
+        if (size > slotSize)
+        {
+            env->DeleteLocalRef(array);
+            return true;
+        }
+        std::pair<void*, void*> key(owner, stream);
+        std::map<std::pair<void*, void*>, BounceStreamRing*>::iterator it = rings.find(key);
+        BounceStreamRing *ring = NULL;
+        if (it != rings.end())
+        {
+            ring = it->second;
+        }
+        else
+        {
+            ring = new BounceStreamRing();
+            ring->next = 0;
+            ring->waiters = 0;
+            ring->removed = false;
+            rings[key] = ring;
+        }
+
+        // A copy from the array has to see the results of the earlier
+        // copies of the stream into the same range of the array
+        if (readArray && !finishOverlapping(env, ring, array, start, size))
+        {
+            env->DeleteLocalRef(array);
+            return true;
+        }
+        acquired = nextSlot(env, ring);
+        if (acquired == NULL)
+        {
+            env->DeleteLocalRef(array);
+            return true;
+        }
+        acquired->array = array;
+        acquired->offset = start;
+        acquired->size = size;
+        acquired->toArray = !readArray;
+    }
+
+    // The array is only accessed while it is copied into the slot,
+    // and not while the copy from the slot is pending
+    if (readArray)
+    {
+        void *arrayPointer = env->GetPrimitiveArrayCritical(array, NULL);
+        if (arrayPointer == NULL)
+        {
+            MutexLock lock(mutex);
+            acquired->array = NULL;
+            acquired->state = BOUNCE_SLOT_FREE;
+            slotsChanged.broadcast();
+            return false;
+        }
+        memcpy(acquired->buffer, (char*)arrayPointer + acquired->offset, size);
+        env->ReleasePrimitiveArrayCritical(array, arrayPointer, JNI_ABORT);
+    }
+    *slot = acquired;
+    return true;
+}
+
+int BounceRing::commit(JNIEnv *env, BounceSlot *slot, void *stream, int copyResult)
+{
+    MutexLock lock(mutex);
+    slotsChanged.broadcast();
+    jarray localArray = slot->array;
+    slot->array = NULL;
+    if (copyResult != 0)
+    {
+        slot->state = BOUNCE_SLOT_FREE;
+        env->DeleteLocalRef(localArray);
+        return copyResult;
+    }
+    int result = functions.recordEvent(slot->event, stream);
+    if (result != 0)
+    {
+        // Without the event, it is not known when the copy is complete
+        Logger::log(LOG_ERROR, "Could not record event of bounce slot, error %d\n", result);
+        slot->state = BOUNCE_SLOT_FREE;
+        env->DeleteLocalRef(localArray);
+        return result;
+    }
+    copies++;
+    bytes += slot->size;
+    if (slot->toArray)
+    {
+        slot->array = (jarray)env->NewGlobalRef(localArray);
+        if (slot->array == NULL)
+        {
+            slot->toArray = false;
+        }
+        else
+        {
+            pending++;
+        }
+    }
+    env->DeleteLocalRef(localArray);
+    slot->state = BOUNCE_SLOT_PENDING;
+    return 0;
+}
+
+void BounceRing::completeReady(JNIEnv *env)
+{
+    MutexLock lock(mutex);
+    if (pending == 0)
+    {
+        return;
+    }
+    std::map<std::pair<void*, void*>, BounceStreamRing*>::iterator it;
+    for (it = rings.begin(); it != rings.end() && pending > 0; ++it)
+    {
+        // The copies of one stream are completed in the order in which
+        // they have been enqueued, so that later copies into the same
+        // array take precedence
+        BounceStreamRing *ring = it->second;
+        size_t n = ring->slots.size();
+        for (size_t i=0; i<n; i++)
+        {
+            BounceSlot *slot = ring->slots[(ring->next + i) % n];
+            if (slot->state == BOUNCE_SLOT_PENDING && !finish(env, slot))
+            {
+                break;
+            }
+        }
+    }
+}
+
+void BounceRing::removeStream(JNIEnv *env, void *stream)
+{
+    MutexLock lock(mutex);
+    std::vector<BounceStreamRing*> removed;
+    std::map<std::pair<void*, void*>, BounceStreamRing*>::iterator it = rings.begin();
+    while (it != rings.end())
+    {
+        if (it->first.second == stream)
+        {
+            removed.push_back(it->second);
+            rings.erase(it++);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    destroyRings(env, removed);
+}
+
+void BounceRing::removeOwner(JNIEnv *env, void *owner)
+{
+    MutexLock lock(mutex);
+    std::vector<BounceStreamRing*> removed;
+    std::map<std::pair<void*, void*>, BounceStreamRing*>::iterator it = rings.begin();
+    while (it != rings.end())
+    {
+        if (it->first.first == owner)
+        {
+            removed.push_back(it->second);
+            rings.erase(it++);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    destroyRings(env, removed);
+}
+
+void BounceRing::getStatistics(BounceRingStatistics *statistics)
+{
+    MutexLock lock(mutex);
+    statistics->copies = copies;
+    statistics->bytes = bytes;
+    statistics->waits = waits;
+    statistics->pending = pending;
+}
+
+/**
+ * Obtains the size of the given primitive array in bytes. Returns false
+ * if an exception is pending.
+ */
+bool BounceRing::getArrayBytes(JNIEnv *env, jarray array, size_t *arrayBytes)
+{
+    {
+        MutexLock lock(mutex);
+        if (arrayClasses.empty())
+        {
+            for (int i=0; i<arrayClassCount; i++)
+            {
+                jclass arrayClass = env->FindClass(arrayClassNames[i]);
+                if (arrayClass == NULL)
+                {
+                    for (size_t j=0; j<arrayClasses.size(); j++)
+                    {
+                        env->DeleteGlobalRef(arrayClasses[j]);
+                    }
+                    arrayClasses.clear();
+                    return false;
+                }
+                arrayClasses.push_back((jclass)env->NewGlobalRef(arrayClass));
+                env->DeleteLocalRef(arrayClass);
+            }
+        }
+    }
+    for (int i=0; i<arrayClassCount; i++)
+    {
+        if (env->IsInstanceOf(array, arrayClasses[i]))
+        {
+            *arrayBytes = (size_t)env->GetArrayLength(array) * arrayElementSizes[i];
+            return true;
+        }
+    }
+    ThrowByName(env, "java/lang/IllegalArgumentException",
+        "The host pointer does not refer to a primitive array");
+    return false;
+}
+
+/**
+ * Returns the next slot of the given ring, creating it if the ring does
+ * not have all slots yet, and waiting until the pending copy of the
+ * slot is complete if necessary. Returns NULL if the slot is acquired
+ * by another thread, could not be created, or if the ring was removed
+ * while waiting. To be called while holding the mutex.
+ */
+BounceSlot* BounceRing::nextSlot(JNIEnv *env, BounceStreamRing *ring)
+{
+    while (ring->next < ring->slots.size())
+    {
+        BounceSlot *slot = ring->slots[ring->next];
+        if (slot->state == BOUNCE_SLOT_ACQUIRED)
+        {
+            return NULL;
+        }
+        if (slot->state == BOUNCE_SLOT_PENDING && !finish(env, slot))
+        {
+            // The slot may have been finished and acquired by another
+            // thread while waiting, so its state is checked again
+            waits++;
+            if (!wait(ring, slot))
+            {
+                return NULL;
+            }
+            continue;
+        }
+        ring->next = (ring->next + 1) % (size_t)slotCount;
+        slot->state = BOUNCE_SLOT_ACQUIRED;
+        return slot;
+    }
+
+    BounceSlot *slot = new BounceSlot();
+    slot->buffer = NULL;
+    slot->event = NULL;
+    slot->state = BOUNCE_SLOT_FREE;
+    slot->array = NULL;
+    slot->offset = 0;
+    slot->size = 0;
+    slot->toArray = false;
+    int result = functions.allocHost(&slot->buffer, slotSize);
+    if (result == 0)
+    {
+        result = functions.createEvent(&slot->event);
+    }
+    if (result != 0)
+    {
+        Logger::log(LOG_DEBUG, "Could not create bounce slot of %ld bytes, error %d\n",
+            (long)slotSize, result);
+        if (slot->buffer != NULL)
+        {
+            functions.freeHost(slot->buffer);
+        }
+        delete slot;
+        return NULL;
+    }
+    ring->slots.push_back(slot);
+    ring->next = (ring->next + 1) % (size_t)slotCount;
+    slot->state = BOUNCE_SLOT_ACQUIRED;
+    return slot;
+}
+
+/**
+ * Finishes the pending copies of the given ring into the given range of
+ * the given array, in the order in which they have been enqueued,
+ * waiting for them if necessary. Returns false if the ring was removed
+ * while waiting. To be called while holding the mutex.
+ */
+bool BounceRing::finishOverlapping(JNIEnv *env, BounceStreamRing *ring, jarray array, size_t offset, size_t size)
+{
+    bool found = true;
+    while (found)
+    {
+        found = false;
+        size_t n = ring->slots.size();
+        for (size_t i=0; i<n && !found; i++)
+        {
+            BounceSlot *slot = ring->slots[(ring->next + i) % n];
+            if (slot->state != BOUNCE_SLOT_PENDING || !slot->toArray)
+            {
+                continue;
+            }
+            if (slot->offset >= offset + size || offset >= slot->offset + slot->size)
+            {
+                continue;
+            }
+            if (!env->IsSameObject(slot->array, array) || finish(env, slot))
+            {
+                continue;
+            }
+
+            // The slots may have changed while waiting, so they are
+            // checked again from the start
+            waits++;
+            if (!wait(ring, slot))
+            {
+                return false;
+            }
+            found = true;
+        }
+    }
+    return true;
+}
+
+/**
+ * Waits for the event of the given slot of the given ring, without
+ * holding the mutex. The slot is not finished, since it may already
+ * have been finished or reused by another thread. Returns false if the
+ * ring was removed in the meantime. To be called while holding the
+ * mutex.
+ */
+bool BounceRing::wait(BounceStreamRing *ring, BounceSlot *slot)
+{
+    void *event = slot->event;
+    ring->waiters++;
+    mutex.unlock();
+    functions.synchronizeEvent(event);
+    mutex.lock();
+    ring->waiters--;
+    slotsChanged.broadcast();
+    return !ring->removed;
+}
+
+/**
+ * Finishes the pending copy of the given slot if its event is complete,
+ * copying the slot into the array if necessary. Returns whether the
+ * slot was finished. To be called while holding the mutex.
+ */
+bool BounceRing::finish(JNIEnv *env, BounceSlot *slot)
+{
+    int result = functions.queryEvent(slot->event);
+    if (result == notReadyResult)
+    {
+        return false;
+    }
+    release(env, slot, result);
+    return true;
+}
+
+/**
+ * Releases the given slot after its event was reached with the given
+ * result, copying the slot into the array if necessary. To be called
+ * while holding the mutex.
+ */
+void BounceRing::release(JNIEnv *env, BounceSlot *slot, int result)
+{
+    if (slot->toArray)
+    {
+        if (result == 0)
+        {
+            complete(env, slot);
+        }
+        else
+        {
+            Logger::log(LOG_ERROR, "Copy into bounce slot failed, error %d\n", result);
+        }
+        env->DeleteGlobalRef(slot->array);
+        slot->array = NULL;
+        slot->toArray = false;
+        pending--;
+    }
+    slot->state = BOUNCE_SLOT_FREE;
+}
+
+/**
+ * Copies the given slot into its array
+ */
+void BounceRing::complete(JNIEnv *env, BounceSlot *slot)
+{
+    void *arrayPointer = env->GetPrimitiveArrayCritical(slot->array, NULL);
+    if (arrayPointer == NULL)
+    {
+        Logger::log(LOG_ERROR, "Could not access array to complete bounced copy\n");
+        env->ExceptionClear();
+        return;
+    }
+    memcpy((char*)arrayPointer + slot->offset, slot->buffer, slot->size);
+    env->ReleasePrimitiveArrayCritical(slot->array, arrayPointer, 0);
+}
+
+/**
+ * Finishes the pending copies of the given rings, which have already
+ * been removed from the map, and releases and deletes them. The rings
+ * are deleted only after the threads that are waiting for their slots
+ * and the threads that acquired their slots are done with them. The
+ * events are synchronized without holding the mutex. To be called
+ * while holding the mutex.
+ */
+void BounceRing::destroyRings(JNIEnv *env, std::vector<BounceStreamRing*> &removed)
+{
+    for (size_t r=0; r<removed.size(); r++)
+    {
+        removed[r]->removed = true;
+    }
+    for (size_t r=0; r<removed.size(); r++)
+    {
+        BounceStreamRing *ring = removed[r];
+        size_t n = ring->slots.size();
+        bool busy = true;
+        while (busy)
+        {
+            busy = ring->waiters > 0;
+            for (size_t i=0; i<n && !busy; i++)
+            {
+                busy = ring->slots[i]->state == BOUNCE_SLOT_ACQUIRED;
+            }
+            if (busy)
+            {
+                slotsChanged.wait(mutex);
+            }
+        }
+        for (size_t i=0; i<n; i++)
+        {
+            BounceSlot *slot = ring->slots[(ring->next + i) % n];
+            if (slot->state == BOUNCE_SLOT_PENDING)
+            {
+                mutex.unlock();
+                int result = functions.synchronizeEvent(slot->event);
+                mutex.lock();
+                release(env, slot, result);
+            }
+            functions.destroyEvent(slot->event);
+            functions.freeHost(slot->buffer);
+            delete slot;
+        }
+        delete ring;
+    }
+}
@@ -0,0 +1,285 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef BOUNCERING
+#define BOUNCERING
+
+#include <jni.h>
+#include <map>
+#include <utility>
+#include <vector>
+#include "Threading.hpp"
+
+/**
+ * The functions that are used by a BounceRing, for the driver or the
+ * runtime API. Each function returns 0 on success, or the CUDA error
+ * code. Streams and events are the CUstream/cudaStream_t and
+ * CUevent/cudaEvent_t handles.
+ */
+struct BounceRingFunctions
+{
+    /**
+     * Obtains the owner of the streams of the calling thread: The
+     * current context, or a value that identifies the current device
+     * for the runtime API
+     */
+    int (*getOwner)(void **owner);
+
+    int (*allocHost)(void **pointer, size_t size);
+    int (*freeHost)(void *pointer);
+    int (*createEvent)(void **event);
+    int (*destroyEvent)(void *event);
+    int (*recordEvent)(void *event, void *stream);
+
+    /**
+     * Returns 0 if the event is complete, the "not ready" code that was
+     * given to the BounceRing if it is not, or an error code
+     */
+    int (*queryEvent)(void *event);
+
+    int (*synchronizeEvent)(void *event);
+};
+
+
+/**
+ * Statistics about the copies that went through a BounceRing
+ */
+struct BounceRingStatistics
+{
+    /** The number of copies and bytes that went through a slot */
+    jcuda_int64 copies;
+    jcuda_int64 bytes;
+
+    /** The number of times that a slot had to be waited for */
+    jcuda_int64 waits;
+
+    /** The number of copies into Java arrays that are not completed yet */
+    jcuda_int64 pending;
+};
+
+
+/**
+ * A page-locked slot of a BounceRing
+ */
+struct BounceSlot
+{
+    /** The page-locked memory of the slot */
+    void *buffer;
+
+    /** The event that is recorded after the copy that uses the slot */
+    void *event;
+
+    /** The state of the slot, a BOUNCE_SLOT_ constant */
+    int state;
+
+    /**
+     * For copies into Java arrays: The array (a local reference until
+     * the copy was enqueued, and a global reference afterwards), and
+     * the range of the array that the slot is copied into
+     */
+    jarray array;
+    size_t offset;
+    size_t size;
+
+    /** Whether the slot has to be copied into the array on completion */
+    bool toArray;
+};
+
+struct BounceStreamRing;
+
+/**
+ * A ring of page-locked bounce buffers for each stream, that makes
+ * asynchronous copies between Java arrays and device memory truly
+ * asynchronous without accessing the arrays after the call returned.<br />
+ * <br />
+ * For a copy from a Java array, the array is copied into the next slot
+ * of the ring of the stream, and the copy from this slot is enqueued.
+ * For a copy into a Java array, the copy into the next slot is
+ * enqueued, and the slot is copied into the array in a completion
+ * step, which is executed when the stream, context or device is
+ * synchronized, when an event is synchronized or found to be complete,
+ * or at the latest when the slot is used again. After enqueuing a copy,
+ * an event is recorded for the slot, so that the slot is only reused
+ * when the copy is complete. The calling thread only waits when all
+ * slots of the stream are still in use, or when a copy from an array
+ * would read a range of the array that a pending copy of the same
+ * stream is still going to write. The mutex of the ring is not held
+ * while waiting.<br />
+ * <br />
+ * The completion step is only triggered by the synchronization functions
+ * of the library that uses the ring. For example, a copy into an array
+ * that was bounced by the runtime API is not completed when the context
+ * is synchronized with the driver API, but only when the slot is used
+ * again, or when the ring is disabled.<br />
+ * <br />
+ * Copies that are larger than one slot have to be split by the caller
+ * into chunks of at most getSlotSize bytes, which are acquired one after
+ * the other. The slots are created lazily, up to the given number for
+ * each stream.
+ */
+class BounceRing
+{
+    public:
+
+        /**
+         * Creates a new, disabled ring that uses the given functions. The
+         * given result is the error code that is returned by the
+         * queryEvent function for events that are not complete.
+         */
+        BounceRing(BounceRingFunctions functions, int notReadyResult);
+
+        /**
+         * Destroys this ring. The slots have to be released with
+         * disable before.
+         */
+        ~BounceRing();
+
+        /**
+         * Enables this ring, with the given number of slots of the given
+         * size for each stream. If the ring was enabled with a different
+         * configuration, then all slots are released first.
+         */
+        void enable(JNIEnv *env, size_t slotSize, int slotCount);
+
+        /**
+         * Disables this ring. The pending copies are completed, and all
+         * slots are released.
+         */
+        void disable(JNIEnv *env);
+
+        /**
+         * Returns whether this ring is enabled
+         */
+        bool isEnabled();
+
+        /**
+         * Returns the size of the slots of this ring
+         */
+        size_t getSlotSize();
+
+        /**
+         * Acquires a slot for a copy of the given size between the Java
+         * array that the given Java Pointer object refers to and device
+         * memory, in the given stream. The copy starts at the given
+         * offset, in bytes, from the position of the pointer. If the
+         * copy reads from the array, then the array is copied into the
+         * slot. The slot is stored in the given pointer, or NULL if the
+         * copy is not bounced, e.g. because the pointer does not refer
+         * to an array, or the copy is larger than a slot. Returns false
+         * if an exception is pending, e.g. an
+         * ArrayIndexOutOfBoundsException if the copy exceeds the array.
+         */
+        bool acquire(JNIEnv *env, jobject pointerObject, size_t offset, void *stream, size_t size, bool readArray, BounceSlot **slot);
+
+        /**
+         * Commits the given slot after the copy from or to its buffer
+         * was enqueued in the given stream with the given result. If the
+         * copy failed, then the slot is simply released. Otherwise, the
+         * event of the slot is recorded, and for copies into an array,
+         * the completion is scheduled. Returns the error code of
+         * recording the event, or the given result.
+         */
+        int commit(JNIEnv *env, BounceSlot *slot, void *stream, int copyResult);
+
+        /**
+         * Completes all copies into Java arrays whose events are
+         * complete. To be called when work may have been completed,
+         * e.g. after synchronizing a stream, context or event.
+         */
+        void completeReady(JNIEnv *env);
+
+        /**
+         * Completes the pending copies of the given stream, and releases
+         * its slots, e.g. before the stream is destroyed
+         */
+        void removeStream(JNIEnv *env, void *stream);
+
+        /**
+         * Completes the pending copies of all streams of the given
+         * owner, and releases their slots, e.g. before the context is
+         * destroyed or the device is reset
+         */
+        void removeOwner(JNIEnv *env, void *owner);
+
+        /**
+         * Returns the current statistics of this ring
+         */
+        void getStatistics(BounceRingStatistics *statistics);
+
+    private:
+
+        /** The states of a slot */
+        static const int BOUNCE_SLOT_FREE = 0;
+        static const int BOUNCE_SLOT_ACQUIRED = 1;
+        static const int BOUNCE_SLOT_PENDING = 2;
+
+        BounceRingFunctions functions;
+        int notReadyResult;
+
+        /** Guards all members except for the 'enabled' flag */
+        Mutex mutex;
+
+        /**
+         * Signalled when a thread stopped waiting for a slot, or when
+         * an acquired slot was committed or released
+         */
+        ConditionVariable slotsChanged;
+
+        volatile int enabled;
+        size_t slotSize;
+        int slotCount;
+
+        /** The rings, by their owner and stream */
+        std::map<std::pair<void*, void*>, BounceStreamRing*> rings;
+
+        /**
+         * Global references to the primitive array classes, which are
+         * obtained when the first copy is acquired
+         */
+        std::vector<jclass> arrayClasses;
+
+        /** Statistics */
+        jcuda_int64 copies;
+        jcuda_int64 bytes;
+        jcuda_int64 waits;
+        jcuda_int64 pending;
+
+        bool getArrayBytes(JNIEnv *env, jarray array, size_t *arrayBytes);
+        BounceSlot* nextSlot(JNIEnv *env, BounceStreamRing *ring);
+        bool finishOverlapping(JNIEnv *env, BounceStreamRing *ring, jarray array, size_t offset, size_t size);
+        bool wait(BounceStreamRing *ring, BounceSlot *slot);
+        bool finish(JNIEnv *env, BounceSlot *slot);
+        void release(JNIEnv *env, BounceSlot *slot, int result);
+        void complete(JNIEnv *env, BounceSlot *slot);
+        void destroyRings(JNIEnv *env, std::vector<BounceStreamRing*> &removed);
+
+        BounceRing(const BounceRing&);
+        BounceRing& operator=(const BounceRing&);
+};
+
+
+#endif
@@ -0,0 +1,256 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "CompletionService.hpp"
+#include "Logger.hpp"
+
+/**
+ * The number of rounds without completions in which the polling
+ * thread only yields, before it starts sleeping
+ */
+#define COMPLETION_YIELD_ROUNDS 16
+
+
+CompletionService::CompletionService(CompletionQueryFunction queryFunction, int notReadyResult,
+    CompletionBatchFunction batchFunction, long maxPollMicros, ThreadFunction exitFunction)
+{
+    this->queryFunction = queryFunction;
+    this->notReadyResult = notReadyResult;
+    this->batchFunction = batchFunction;
+    this->maxPollMicros = maxPollMicros < 1 ? 1 : maxPollMicros;
+    this->exitFunction = exitFunction;
+    started = false;
+    stopping = false;
+    removalsRequested = 0;
+    removalsCompleted = 0;
+    pending = 0;
+    completed = 0;
+    batches = 0;
+}
+
+CompletionService::~CompletionService()
+{
+    {
+        MutexLock lock(mutex);
+        stopping = true;
+        condition.signal();
+    }
+    thread.join();
+}
+
+bool CompletionService::add(void *context, void *event, void *userData)
+{
+    CompletionEntry entry;
+    entry.context = context;
+    entry.event = event;
+    entry.userData = userData;
+    entry.result = notReadyResult;
+
+    MutexLock lock(mutex);
+    if (!started)
+    {
+        if (!thread.start(&CompletionService::run, this))
+        {
+            Logger::log(LOG_ERROR, "Could not start the completion polling thread\n");
+            return false;
+        }
+        started = true;
+    }
+    incoming.push_back(entry);
+    atomicAdd(&pending, (jcuda_int64)1);
+    condition.signal();
+    return true;
+}
+
+void CompletionService::removeContext(void *context, int result)
+{
+    MutexLock lock(mutex);
+    if (!started || stopping)
+    {
+        return;
+    }
+    removals.push_back(std::make_pair(context, result));
+    removalsRequested++;
+    jcuda_int64 request = removalsRequested;
+    condition.signal();
+    while (removalsCompleted < request)
+    {
+        removalCondition.wait(mutex);
+    }
+}
+
+void CompletionService::getStatistics(jcuda_int64 *pending, jcuda_int64 *completed, jcuda_int64 *batches)
+{
+    *pending = atomicLoad(&this->pending);
+    *completed = atomicLoad(&this->completed);
+    *batches = atomicLoad(&this->batches);
+}
+
+void CompletionService::run(void *argument)
+{
+    CompletionService *service = (CompletionService*)argument;
+    service->poll();
+    if (service->exitFunction != NULL)
+    {
+        service->exitFunction(argument);
+    }
+}
+
+/**
+ * The loop of the polling thread. The entries that are polled are only
+ * accessed by this thread, so the mutex is only held for moving the
+ * incoming entries into the polled ones, and for taking the removals.
+ * The polled entries are grouped by their context, in the order in
+ * which they have been added.
+ */
+void CompletionService::poll()
+{
+    std::map<void*, std::vector<CompletionEntry> > polled;
+    std::vector<CompletionEntry> done;
+    std::vector<std::pair<void*, int> > currentRemovals;
+    std::vector<void*> events;
+    std::vector<int> results;
+    int idleRounds = 0;
+    long sleepMicros = 1;
+    while (true)
+    {
+        jcuda_int64 removalsTaken = 0;
+        {
+            MutexLock lock(mutex);
+            while (polled.empty() && incoming.empty() && removals.empty() && done.empty())
+            {
+                if (stopping)
+                {
+                    return;
+                }
+                condition.wait(mutex);
+            }
+            for (size_t i=0; i<incoming.size(); i++)
+            {
+                polled[incoming[i].context].push_back(incoming[i]);
+            }
+            incoming.clear();
+            currentRemovals.swap(removals);
+            removalsTaken = removalsRequested;
+        }
+
+        // Pass the entries of removed contexts to the batch function,
+        // and let the removing threads continue
+        if (!currentRemovals.empty())
+        {
+            for (size_t r=0; r<currentRemovals.size(); r++)
+            {
+                std::map<void*, std::vector<CompletionEntry> >::iterator it = polled.find(currentRemovals[r].first);
+                if (it == polled.end())
+                {
+                    continue;
+                }
+                for (size_t i=0; i<it->second.size(); i++)
+                {
+                    it->second[i].result = currentRemovals[r].second;
+                    done.push_back(it->second[i]);
+                }
+                polled.erase(it);
+            }
+            currentRemovals.clear();
+            MutexLock lock(mutex);
+            removalsCompleted = removalsTaken;
+            removalCondition.broadcast();
+        }
+
+        // Query the events of each context, keeping the pending ones
+        // in their order
+        std::map<void*, std::vector<CompletionEntry> >::iterator it = polled.begin();
+        while (it != polled.end())
+        {
+            std::vector<CompletionEntry> &entries = it->second;
+            int count = (int)entries.size();
+            events.resize(count);
+            results.resize(count);
+            for (int i=0; i<count; i++)
+            {
+                events[i] = entries[i].event;
+            }
+            queryFunction(it->first, &events[0], &results[0], count);
+            size_t kept = 0;
+            for (int i=0; i<count; i++)
+            {
+                if (results[i] == notReadyResult)
+                {
+                    entries[kept++] = entries[i];
+                }
+                else
+                {
+                    entries[i].result = results[i];
+                    done.push_back(entries[i]);
+                }
+            }
+            entries.resize(kept);
+            if (entries.empty())
+            {
+                polled.erase(it++);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        // Entries that the batch function could not handle are kept,
+        // and passed to it again after the maximum poll interval
+        if (!done.empty() && !batchFunction(&done[0], (int)done.size()))
+        {
+            Thread::sleepMicros(maxPollMicros);
+        }
+        else if (!done.empty())
+        {
+            atomicAdd(&pending, -(jcuda_int64)done.size());
+            atomicAdd(&completed, (jcuda_int64)done.size());
+            atomicAdd(&batches, (jcuda_int64)1);
+            done.clear();
+            idleRounds = 0;
+            sleepMicros = 1;
+        }
+        else if (!polled.empty())
+        {
+            idleRounds++;
+            if (idleRounds < COMPLETION_YIELD_ROUNDS)
+            {
+                Thread::yield();
+            }
+            else
+            {
+                Thread::sleepMicros(sleepMicros);
+                sleepMicros *= 2;
+                if (sleepMicros > maxPollMicros)
+                {
+                    sleepMicros = maxPollMicros;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,169 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef COMPLETIONSERVICE
+#define COMPLETIONSERVICE
+
+#include <map>
+#include <utility>
+#include <vector>
+#include "Threading.hpp"
+
+/**
+ * The function that is used by a CompletionService to query whether
+ * the given events, which all belong to the given context (which is
+ * NULL for the runtime API), have been completed, e.g. with
+ * cuEventQuery or cudaEventQuery. The result for each event is 0 if
+ * the event is complete, the "not ready" code that was given to the
+ * CompletionService if it is not, or an error code. The function is
+ * called once for each context in each round of polling, so that the
+ * context only has to be made current once.
+ */
+typedef void (*CompletionQueryFunction)(void *context, void **events, int *results, int count);
+
+/**
+ * An event that was registered at a CompletionService
+ */
+struct CompletionEntry
+{
+    void *context;
+    void *event;
+    void *userData;
+
+    /** The result of querying the event when it was completed */
+    int result;
+};
+
+/**
+ * The function that is called by the polling thread of a
+ * CompletionService with all entries that have been completed
+ * in one round of polling. Returns whether the entries have been
+ * handled. If not, the service keeps them, and passes them to the
+ * function again after the maximum poll interval.
+ */
+typedef bool (*CompletionBatchFunction)(CompletionEntry *entries, int count);
+
+
+/**
+ * A service that detects the completion of events without blocking any
+ * thread. Events are registered together with arbitrary user data. A
+ * single thread polls all pending events, grouped by their context,
+ * and passes the ones that have been completed in one round to the
+ * CompletionBatchFunction. The batch function is called by the polling
+ * thread, and should hand any slow work to other threads.<br />
+ * <br />
+ * The polling thread backs off adaptively: After a round in which no
+ * event was completed, it first yields, and then sleeps for a time that
+ * is doubled after each such round, up to the maximum poll interval.
+ * When an event is completed, it polls eagerly again. While no events
+ * are pending, it waits without polling.
+ */
+class CompletionService
+{
+    public:
+
+        /**
+         * Creates a new service with the given functions. The given
+         * exit function, if not NULL, is called by the polling thread
+         * before it terminates. The polling thread is started when
+         * the first event is registered.
+         */
+        CompletionService(CompletionQueryFunction queryFunction, int notReadyResult,
+            CompletionBatchFunction batchFunction, long maxPollMicros, ThreadFunction exitFunction);
+
+        /**
+         * Destroys this service, after all registered events have
+         * been completed and passed to the batch function
+         */
+        ~CompletionService();
+
+        /**
+         * Registers the given event. The event must have been recorded,
+         * and must not be destroyed or recorded again until the entry
+         * was passed to the batch function. Returns false if the
+         * polling thread could not be started.
+         */
+        bool add(void *context, void *event, void *userData);
+
+        /**
+         * Removes the pending events of the given context, e.g. before
+         * the context is destroyed. Their entries are passed to the
+         * batch function with the given result. This waits until the
+         * polling thread no longer queries the events of the context,
+         * but not until the batch function has been called. It must
+         * not be called by the batch function.
+         */
+        void removeContext(void *context, int result);
+
+        /**
+         * Obtains the number of events that are pending, the number of
+         * events that have been completed, and the number of batches
+         * that they have been completed in
+         */
+        void getStatistics(jcuda_int64 *pending, jcuda_int64 *completed, jcuda_int64 *batches);
+
+    private:
+        CompletionQueryFunction queryFunction;
+        int notReadyResult;
+        CompletionBatchFunction batchFunction;
+        long maxPollMicros;
+        ThreadFunction exitFunction;
+
+        /** Guards the incoming entries and the state of the thread */
+        Mutex mutex;
+        ConditionVariable condition;
+
+        /** The entries that have been added since the last round */
+        std::vector<CompletionEntry> incoming;
+
+        /**
+         * The contexts whose entries should be removed, with the result
+         * for their entries, and the number of removals that have been
+         * requested and completed
+         */
+        std::vector<std::pair<void*, int> > removals;
+        jcuda_int64 removalsRequested;
+        jcuda_int64 removalsCompleted;
+        ConditionVariable removalCondition;
+
+        Thread thread;
+        bool started;
+        bool stopping;
+
+        volatile jcuda_int64 pending;
+        volatile jcuda_int64 completed;
+        volatile jcuda_int64 batches;
+
+        static void run(void *argument);
+        void poll();
+
+        CompletionService(const CompletionService&);
+        CompletionService& operator=(const CompletionService&);
+};
+
+
+#endif
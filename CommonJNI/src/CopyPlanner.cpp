@@ -0,0 +1,516 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "CopyPlanner.hpp"
+
+#include <cstring>
+
+/** The number of page-locked staging buffers of each device */
+#define COPY_STAGING_BUFFERS 4
+
+/** The number of internal streams that the chunks are distributed over */
+#define COPY_STAGING_STREAMS 2
+
+
+/**
+ * The staging resources of one device. The buffers are used as a ring,
+ * and each buffer has an event that is recorded after the transfer
+ * that uses the buffer, so that it is only overwritten when this
+ * transfer is complete.
+ */
+struct CopyStaging
+{
+    /** Serializes the staged copies on the device */
+    Mutex mutex;
+
+    /** The size of each buffer, or 0 if the resources are not created */
+    size_t chunkSize;
+
+    void *buffers[COPY_STAGING_BUFFERS];
+    void *bufferEvents[COPY_STAGING_BUFFERS];
+    void *streams[COPY_STAGING_STREAMS];
+
+    /** The events that the stream of the caller waits for */
+    void *doneEvents[COPY_STAGING_STREAMS];
+
+    /** The event that the internal streams wait for */
+    void *startEvent;
+
+    CopyStaging()
+    {
+        chunkSize = 0;
+        memset(buffers, 0, sizeof(buffers));
+        memset(bufferEvents, 0, sizeof(bufferEvents));
+        memset(streams, 0, sizeof(streams));
+        memset(doneEvents, 0, sizeof(doneEvents));
+        startEvent = NULL;
+    }
+};
+
+
+/**
+ * The strategy of the last copy of each thread
+ */
+static JCUDA_THREAD_LOCAL int lastStrategy = -1;
+
+
+CopyPlanner::CopyPlanner(CopyPlannerFunctions functions)
+{
+    this->functions = functions;
+    enabled = 0;
+    chunkSize = 0;
+    stagingThreshold = 0;
+    for (int i=0; i<COPY_STRATEGY_COUNT; i++)
+    {
+        copyCounts[i] = 0;
+        copyBytes[i] = 0;
+    }
+}
+
+CopyPlanner::~CopyPlanner()
+{
+    std::map<int, CopyStaging*>::iterator it;
+    for (it = stagings.begin(); it != stagings.end(); ++it)
+    {
+        delete it->second;
+    }
+}
+
+void CopyPlanner::enable(size_t chunkSize, size_t stagingThreshold)
+{
+    MutexLock lock(mutex);
+    this->chunkSize = chunkSize;
+    this->stagingThreshold = stagingThreshold;
+    enabled = 1;
+}
+
+void CopyPlanner::disable()
+{
+    MutexLock lock(mutex);
+    enabled = 0;
+}
+
+bool CopyPlanner::isEnabled()
+{
+    return atomicLoad(&enabled) != 0;
+}
+
+int CopyPlanner::plan(int dstKind, int srcKind, size_t bytes)
+{
+    if (!isEnabled())
+    {
+        return COPY_STRATEGY_DIRECT;
+    }
+    int hostKind = dstKind == COPY_MEMORY_DEVICE ? srcKind : dstKind;
+    int deviceKind = dstKind == COPY_MEMORY_DEVICE ? dstKind : srcKind;
+    if (deviceKind != COPY_MEMORY_DEVICE ||
+        (hostKind != COPY_MEMORY_PAGEABLE && hostKind != COPY_MEMORY_ARRAY))
+    {
+        return COPY_STRATEGY_DIRECT;
+    }
+    MutexLock lock(mutex);
+    if (bytes < stagingThreshold || chunkSize == 0)
+    {
+        return COPY_STRATEGY_DIRECT;
+    }
+    if (bytes <= chunkSize)
+    {
+        return COPY_STRATEGY_STAGED;
+    }
+    return COPY_STRATEGY_CHUNKED;
+}
+
+bool CopyPlanner::copyHtoD(JNIEnv *env, void *dst, PointerData *src, size_t bytes, int strategy, void *stream, bool async, int *result)
+{
+    size_t size = 0;
+    CopyStaging *staging = getStaging(&size);
+    if (staging == NULL)
+    {
+        return copyDirect(env, src, dst, bytes, true, stream, async, result);
+    }
+    MutexLock lock(staging->mutex);
+    *result = prepareStaging(staging, size);
+    if (*result != 0)
+    {
+        return copyDirect(env, src, dst, bytes, true, stream, async, result);
+    }
+
+    int streamCount = strategy == COPY_STRATEGY_CHUNKED ? COPY_STAGING_STREAMS : 1;
+    *result = beginStaging(staging, stream, streamCount);
+    if (*result != 0)
+    {
+        return true;
+    }
+    size_t offset = 0;
+    for (int k=0; offset < bytes; k++)
+    {
+        size_t chunk = bytes - offset < size ? bytes - offset : size;
+        int b = k % COPY_STAGING_BUFFERS;
+
+        // Wait until the previous transfer from this buffer is complete
+        *result = functions.synchronizeEvent(staging->bufferEvents[b]);
+        if (*result != 0)
+        {
+            break;
+        }
+
+        // The host memory is only accessed while the chunk is copied
+        void *host = src->getPointer(env);
+        if (host == NULL)
+        {
+            endStaging(staging, stream, streamCount, true);
+            return false;
+        }
+        memcpy(staging->buffers[b], (char*)host + offset, chunk);
+        src->releasePointer(env, JNI_ABORT);
+
+        void *internalStream = staging->streams[k % streamCount];
+        *result = functions.copy((char*)dst + offset, staging->buffers[b], chunk, true, internalStream, true);
+        if (*result != 0)
+        {
+            break;
+        }
+        *result = functions.recordEvent(staging->bufferEvents[b], internalStream);
+        if (*result != 0)
+        {
+            break;
+        }
+        offset += chunk;
+    }
+    int endResult = endStaging(staging, stream, streamCount, !async);
+    if (*result == 0)
+    {
+        *result = endResult;
+    }
+    if (*result == 0)
+    {
+        record(strategy, bytes);
+    }
+    return true;
+}
+
+bool CopyPlanner::copyDtoH(JNIEnv *env, PointerData *dst, void *src, size_t bytes, int strategy, void *stream, int *result)
+{
+    size_t size = 0;
+    CopyStaging *staging = getStaging(&size);
+    if (staging == NULL)
+    {
+        return copyDirect(env, dst, src, bytes, false, stream, false, result);
+    }
+    MutexLock lock(staging->mutex);
+    *result = prepareStaging(staging, size);
+    if (*result != 0)
+    {
+        return copyDirect(env, dst, src, bytes, false, stream, false, result);
+    }
+
+    int streamCount = strategy == COPY_STRATEGY_CHUNKED ? COPY_STAGING_STREAMS : 1;
+    *result = beginStaging(staging, stream, streamCount);
+    if (*result != 0)
+    {
+        return true;
+    }
+
+    // The transfers of up to one chunk per buffer are issued ahead,
+    // and each chunk is copied into the host memory as soon as its
+    // transfer is complete
+    size_t chunkCount = (bytes + size - 1) / size;
+    size_t issued = 0;
+    bool accessible = true;
+    for (size_t k=0; k<chunkCount && *result == 0; k++)
+    {
+        while (issued < chunkCount && issued < k + COPY_STAGING_BUFFERS)
+        {
+            size_t offset = issued * size;
+            size_t chunk = bytes - offset < size ? bytes - offset : size;
+            int b = (int)(issued % COPY_STAGING_BUFFERS);
+            void *internalStream = staging->streams[issued % streamCount];
+            *result = functions.copy(staging->buffers[b], (char*)src + offset, chunk, false, internalStream, true);
+            if (*result != 0)
+            {
+                break;
+            }
+            *result = functions.recordEvent(staging->bufferEvents[b], internalStream);
+            if (*result != 0)
+            {
+                break;
+            }
+            issued++;
+        }
+        if (*result != 0)
+        {
+            break;
+        }
+        size_t offset = k * size;
+        size_t chunk = bytes - offset < size ? bytes - offset : size;
+        int b = (int)(k % COPY_STAGING_BUFFERS);
+        *result = functions.synchronizeEvent(staging->bufferEvents[b]);
+        if (*result != 0)
+        {
+            break;
+        }
+        void *host = dst->getPointer(env);
+        if (host == NULL)
+        {
+            accessible = false;
+            break;
+        }
+        memcpy((char*)host + offset, staging->buffers[b], chunk);
+        dst->releasePointer(env, 0);
+    }
+    int endResult = endStaging(staging, stream, streamCount, true);
+    if (!accessible)
+    {
+        return false;
+    }
+    if (*result == 0)
+    {
+        *result = endResult;
+    }
+    if (*result == 0)
+    {
+        record(strategy, bytes);
+    }
+    return true;
+}
+
+void CopyPlanner::record(int strategy, size_t bytes)
+{
+    atomicAdd(&copyCounts[strategy], (jcuda_int64)1);
+    atomicAdd(&copyBytes[strategy], (jcuda_int64)bytes);
+    lastStrategy = strategy;
+}
+
+int CopyPlanner::getLastStrategy()
+{
+    return lastStrategy;
+}
+
+void CopyPlanner::getStatistics(CopyPlannerStatistics *statistics)
+{
+    for (int i=0; i<COPY_STRATEGY_COUNT; i++)
+    {
+        statistics->counts[i] = atomicLoad(&copyCounts[i]);
+        statistics->bytes[i] = atomicLoad(&copyBytes[i]);
+    }
+}
+
+void CopyPlanner::removeDevice(int device)
+{
+    CopyStaging *staging = NULL;
+    {
+        MutexLock lock(mutex);
+        std::map<int, CopyStaging*>::iterator it = stagings.find(device);
+        if (it == stagings.end())
+        {
+            return;
+        }
+        staging = it->second;
+        stagings.erase(it);
+    }
+    {
+        MutexLock lock(staging->mutex);
+        destroyStaging(staging);
+    }
+    delete staging;
+}
+
+/**
+ * Returns the staging resources of the current device, creating the
+ * (empty) resources if necessary, and stores the current chunk size
+ * in the given pointer. Returns NULL if the current device could
+ * not be determined.
+ */
+CopyStaging* CopyPlanner::getStaging(size_t *chunkSize)
+{
+    int device = 0;
+    if (functions.getCurrentDevice(&device) != 0)
+    {
+        return NULL;
+    }
+    MutexLock lock(mutex);
+    *chunkSize = this->chunkSize;
+    std::map<int, CopyStaging*>::iterator it = stagings.find(device);
+    if (it != stagings.end())
+    {
+        return it->second;
+    }
+    CopyStaging *staging = new CopyStaging();
+    stagings[device] = staging;
+    return staging;
+}
+
+/**
+ * Creates the resources of the given staging for the given chunk size,
+ * if they have not been created for this size yet. To be called while
+ * holding the mutex of the staging.
+ */
+int CopyPlanner::prepareStaging(CopyStaging *staging, size_t chunkSize)
+{
+    if (staging->chunkSize == chunkSize)
+    {
+        return 0;
+    }
+    destroyStaging(staging);
+
+    int result = 0;
+    for (int i=0; i<COPY_STAGING_BUFFERS && result == 0; i++)
+    {
+        result = functions.allocHost(&staging->buffers[i], chunkSize);
+        if (result == 0)
+        {
+            result = functions.createEvent(&staging->bufferEvents[i]);
+        }
+    }
+    for (int i=0; i<COPY_STAGING_STREAMS && result == 0; i++)
+    {
+        result = functions.createStream(&staging->streams[i]);
+        if (result == 0)
+        {
+            result = functions.createEvent(&staging->doneEvents[i]);
+        }
+    }
+    if (result == 0)
+    {
+        result = functions.createEvent(&staging->startEvent);
+    }
+    if (result != 0)
+    {
+        Logger::log(LOG_DEBUG, "Could not create staging buffers of %ld bytes, error %d\n",
+            (long)chunkSize, result);
+        destroyStaging(staging);
+        return result;
+    }
+    staging->chunkSize = chunkSize;
+    return 0;
+}
+
+/**
+ * Releases the resources of the given staging, after the pending
+ * transfers that use its buffers are complete. To be called while
+ * holding the mutex of the staging.
+ */
+void CopyPlanner::destroyStaging(CopyStaging *staging)
+{
+    for (int i=0; i<COPY_STAGING_BUFFERS; i++)
+    {
+        if (staging->bufferEvents[i] != NULL)
+        {
+            functions.synchronizeEvent(staging->bufferEvents[i]);
+            functions.destroyEvent(staging->bufferEvents[i]);
+            staging->bufferEvents[i] = NULL;
+        }
+        if (staging->buffers[i] != NULL)
+        {
+            functions.freeHost(staging->buffers[i]);
+            staging->buffers[i] = NULL;
+        }
+    }
+    for (int i=0; i<COPY_STAGING_STREAMS; i++)
+    {
+        if (staging->doneEvents[i] != NULL)
+        {
+            functions.destroyEvent(staging->doneEvents[i]);
+            staging->doneEvents[i] = NULL;
+        }
+        if (staging->streams[i] != NULL)
+        {
+            functions.destroyStream(staging->streams[i]);
+            staging->streams[i] = NULL;
+        }
+    }
+    if (staging->startEvent != NULL)
+    {
+        functions.destroyEvent(staging->startEvent);
+        staging->startEvent = NULL;
+    }
+    staging->chunkSize = 0;
+}
+
+/**
+ * Lets the given number of internal streams wait for the preceding
+ * work in the given stream of the caller
+ */
+int CopyPlanner::beginStaging(CopyStaging *staging, void *stream, int streamCount)
+{
+    int result = functions.recordEvent(staging->startEvent, stream);
+    for (int i=0; i<streamCount && result == 0; i++)
+    {
+        result = functions.streamWaitEvent(staging->streams[i], staging->startEvent);
+    }
+    return result;
+}
+
+/**
+ * Lets the given stream of the caller wait for the work in the given
+ * number of internal streams, and optionally waits until this work
+ * is complete
+ */
+int CopyPlanner::endStaging(CopyStaging *staging, void *stream, int streamCount, bool synchronize)
+{
+    int result = 0;
+    for (int i=0; i<streamCount && result == 0; i++)
+    {
+        result = functions.recordEvent(staging->doneEvents[i], staging->streams[i]);
+        if (result == 0)
+        {
+            result = functions.streamWaitEvent(stream, staging->doneEvents[i]);
+        }
+        if (result == 0 && synchronize)
+        {
+            result = functions.synchronizeEvent(staging->doneEvents[i]);
+        }
+    }
+    return result;
+}
+
+/**
+ * Copies directly between the given host memory and device memory,
+ * when the staging resources are not available
+ */
+bool CopyPlanner::copyDirect(JNIEnv *env, PointerData *host, void *device, size_t bytes, bool toDevice, void *stream, bool async, int *result)
+{
+    void *hostPointer = host->getPointer(env);
+    if (hostPointer == NULL)
+    {
+        return false;
+    }
+    if (toDevice)
+    {
+        *result = functions.copy(device, hostPointer, bytes, true, stream, async);
+    }
+    else
+    {
+        *result = functions.copy(hostPointer, device, bytes, false, stream, async);
+    }
+    host->releasePointer(env, toDevice ? JNI_ABORT : 0);
+    if (*result == 0)
+    {
+        record(COPY_STRATEGY_DIRECT, bytes);
+    }
+    return true;
+}
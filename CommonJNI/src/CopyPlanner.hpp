@@ -0,0 +1,252 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef COPYPLANNER
+#define COPYPLANNER
+
+#include <jni.h>
+#include <map>
+#include "Logger.hpp"
+#include "PointerUtils.hpp"
+#include "Threading.hpp"
+
+/**
+ * The kinds of memory that the CopyPlanner distinguishes
+ */
+
+/** Device memory */
+#define COPY_MEMORY_DEVICE   0
+
+/** Page-locked host memory */
+#define COPY_MEMORY_PINNED   1
+
+/** Pageable host memory, e.g. a direct buffer that is not registered */
+#define COPY_MEMORY_PAGEABLE 2
+
+/** A Java array, which may only be accessed in critical sections */
+#define COPY_MEMORY_ARRAY    3
+
+/** Memory that is always copied directly, e.g. arrays of pointers */
+#define COPY_MEMORY_OTHER    4
+
+
+/**
+ * The strategies that the CopyPlanner may choose
+ */
+
+/** The memory of the caller is passed to the CUDA API */
+#define COPY_STRATEGY_DIRECT  0
+
+/** The host memory is copied through one page-locked staging buffer */
+#define COPY_STRATEGY_STAGED  1
+
+/**
+ * The copy is split into chunks that are staged through a ring of
+ * page-locked buffers, and distributed over several streams
+ */
+#define COPY_STRATEGY_CHUNKED 2
+
+/** The number of strategies */
+#define COPY_STRATEGY_COUNT   3
+
+
+/**
+ * The functions that are used by a CopyPlanner, for the driver or the
+ * runtime API. Each function returns 0 on success, or the CUDA error
+ * code. Streams and events are the CUstream/cudaStream_t and
+ * CUevent/cudaEvent_t handles of the current device.
+ */
+struct CopyPlannerFunctions
+{
+    int (*getCurrentDevice)(int *device);
+
+    /**
+     * Copies between host and device memory, in the given direction,
+     * with cudaMemcpy or cudaMemcpyAsync
+     */
+    int (*copy)(void *dst, const void *src, size_t bytes, bool toDevice, void *stream, bool async);
+
+    int (*allocHost)(void **pointer, size_t size);
+    int (*freeHost)(void *pointer);
+    int (*createStream)(void **stream);
+    int (*destroyStream)(void *stream);
+    int (*createEvent)(void **event);
+    int (*destroyEvent)(void *event);
+    int (*recordEvent)(void *event, void *stream);
+    int (*synchronizeEvent)(void *event);
+    int (*streamWaitEvent)(void *stream, void *event);
+};
+
+
+/**
+ * Statistics about the copies that have been planned
+ */
+struct CopyPlannerStatistics
+{
+    /** The number of copies and bytes, for each COPY_STRATEGY */
+    jcuda_int64 counts[COPY_STRATEGY_COUNT];
+    jcuda_int64 bytes[COPY_STRATEGY_COUNT];
+};
+
+
+struct CopyStaging;
+
+/**
+ * A planner for copies between host and device memory. It chooses a
+ * strategy depending on the kinds of memory that are involved:<br />
+ * <br />
+ * Copies between device memory and page-locked memory, and all copies
+ * that are smaller than the staging threshold, are passed directly
+ * to the CUDA API.<br />
+ * <br />
+ * Copies between device memory and Java arrays or pageable memory
+ * are staged through page-locked buffers: The host memory is only
+ * accessed while one chunk is copied into or out of a staging buffer,
+ * so that Java arrays are not pinned during the transfer. Copies that
+ * are larger than one chunk are pipelined, so that copying one chunk
+ * on the host overlaps the transfers of the previous chunks, which
+ * are distributed over several streams.<br />
+ * <br />
+ * The staging resources are created for each device when the first
+ * staged copy is made on this device, and staged copies on the same
+ * device are serialized. While the planner is enabled, the strategy
+ * that was chosen for the last copy of each thread is recorded.
+ */
+class CopyPlanner
+{
+    public:
+
+        /**
+         * Creates a new, disabled planner that uses the given functions
+         */
+        CopyPlanner(CopyPlannerFunctions functions);
+
+        /**
+         * Destroys this planner. The staging resources have to be
+         * released with removeDevice before.
+         */
+        ~CopyPlanner();
+
+        /**
+         * Enables this planner. Host memory is staged in chunks of the
+         * given size, for copies that have at least the given size.
+         */
+        void enable(size_t chunkSize, size_t stagingThreshold);
+
+        /**
+         * Disables this planner, so that all copies are direct
+         */
+        void disable();
+
+        /**
+         * Returns whether this planner is enabled
+         */
+        bool isEnabled();
+
+        /**
+         * Returns the COPY_STRATEGY for a copy of the given number of
+         * bytes between the given COPY_MEMORY kinds
+         */
+        int plan(int dstKind, int srcKind, size_t bytes);
+
+        /**
+         * Executes a copy from the given host memory to the given device
+         * memory with the given strategy, which is COPY_STRATEGY_STAGED
+         * or COPY_STRATEGY_CHUNKED. The copy is ordered after the
+         * preceding work in the given stream, and the following work
+         * in this stream waits for the copy. If the copy is not
+         * asynchronous, then this call returns when it is complete.
+         * The error code is stored in the given result. Returns false
+         * if the host memory could not be accessed, with a pending
+         * Java exception.
+         */
+        bool copyHtoD(JNIEnv *env, void *dst, PointerData *src, size_t bytes, int strategy, void *stream, bool async, int *result);
+
+        /**
+         * Executes a copy from the given device memory to the given host
+         * memory with the given strategy, which is COPY_STRATEGY_STAGED
+         * or COPY_STRATEGY_CHUNKED. This call returns when the data has
+         * been written into the host memory. The error code is stored
+         * in the given result. Returns false if the host memory could
+         * not be accessed, with a pending Java exception.
+         */
+        bool copyDtoH(JNIEnv *env, PointerData *dst, void *src, size_t bytes, int strategy, void *stream, int *result);
+
+        /**
+         * Records that a copy of the given size was made with the
+         * given strategy
+         */
+        void record(int strategy, size_t bytes);
+
+        /**
+         * Returns the strategy that was recorded for the last copy of
+         * the calling thread, or -1 if there was none
+         */
+        static int getLastStrategy();
+
+        /**
+         * Returns the current statistics of this planner
+         */
+        void getStatistics(CopyPlannerStatistics *statistics);
+
+        /**
+         * Releases the staging resources of the given device, which
+         * must be the current device
+         */
+        void removeDevice(int device);
+
+    private:
+
+        CopyPlannerFunctions functions;
+
+        /** Guards the staging resources of all devices */
+        Mutex mutex;
+
+        volatile int enabled;
+        size_t chunkSize;
+        size_t stagingThreshold;
+
+        /** The staging resources, by device */
+        std::map<int, CopyStaging*> stagings;
+
+        /** Statistics */
+        volatile jcuda_int64 copyCounts[COPY_STRATEGY_COUNT];
+        volatile jcuda_int64 copyBytes[COPY_STRATEGY_COUNT];
+
+        CopyStaging* getStaging(size_t *chunkSize);
+        int prepareStaging(CopyStaging *staging, size_t chunkSize);
+        void destroyStaging(CopyStaging *staging);
+        int beginStaging(CopyStaging *staging, void *stream, int streamCount);
+        int endStaging(CopyStaging *staging, void *stream, int streamCount, bool synchronize);
+        bool copyDirect(JNIEnv *env, PointerData *host, void *device, size_t bytes, bool toDevice, void *stream, bool async, int *result);
+
+        CopyPlanner(const CopyPlanner&);
+        CopyPlanner& operator=(const CopyPlanner&);
+};
+
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "CopyRect.hpp"
+
+/**
+ * The axes along which rectangles may be merged
+ */
+#define AXIS_X 0
+#define AXIS_Y 1
+#define AXIS_Z 2
+
+
+/**
+ * Returns whether the rectangle b directly follows the rectangle a
+ * along the given axis, in the source and in the destination, and
+ * both have the same position and extent along the other axes
+ */
+static bool isAdjacent(const CopyRect &a, const CopyRect &b, int axis)
+{
+    switch (axis)
+    {
+        case AXIS_X:
+            return
+                a.srcY == b.srcY && a.srcZ == b.srcZ &&
+                a.dstY == b.dstY && a.dstZ == b.dstZ &&
+                a.height == b.height && a.depth == b.depth &&
+                b.srcX == a.srcX + a.width &&
+                b.dstX == a.dstX + a.width;
+
+        case AXIS_Y:
+            return
+                a.srcX == b.srcX && a.srcZ == b.srcZ &&
+                a.dstX == b.dstX && a.dstZ == b.dstZ &&
+                a.width == b.width && a.depth == b.depth &&
+                b.srcY == a.srcY + a.height &&
+                b.dstY == a.dstY + a.height;
+
+        case AXIS_Z:
+            return
+                a.srcX == b.srcX && a.srcY == b.srcY &&
+                a.dstX == b.dstX && a.dstY == b.dstY &&
+                a.width == b.width && a.height == b.height &&
+                b.srcZ == a.srcZ + a.depth &&
+                b.dstZ == a.dstZ + a.depth;
+    }
+    return false;
+}
+
+/**
+ * Merges runs of consecutive rectangles that are adjacent along the
+ * given axis, and returns the new number of rectangles
+ */
+static int coalesce(CopyRect *rects, int count, int axis)
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    int n = 0;
+    for (int i=1; i<count; i++)
+    {
+        CopyRect &last = rects[n];
+        const CopyRect &next = rects[i];
+        if (isAdjacent(last, next, axis))
+        {
+            switch (axis)
+            {
+                case AXIS_X: last.width += next.width; break;
+                case AXIS_Y: last.height += next.height; break;
+                case AXIS_Z: last.depth += next.depth; break;
+            }
+        }
+        else
+        {
+            n++;
+            rects[n] = next;
+        }
+    }
+    return n + 1;
+}
+
+int coalesceCopyRects(CopyRect *rects, int count)
+{
+    // Merging along one axis may create rectangles that can be merged
+    // along another axis (e.g. rows of tiles that have been merged
+    // along X may be merged along Y), so repeat until nothing changes
+    while (true)
+    {
+        int newCount = coalesce(rects, count, AXIS_X);
+        newCount = coalesce(rects, newCount, AXIS_Y);
+        newCount = coalesce(rects, newCount, AXIS_Z);
+        if (newCount == count)
+        {
+            return count;
+        }
+        count = newCount;
+    }
+}
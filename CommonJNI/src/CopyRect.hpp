@@ -0,0 +1,64 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef COPYRECT
+#define COPYRECT
+
+#include <stddef.h>
+
+/**
+ * A sub-rectangle (or sub-box) copy between a source and a destination
+ * with fixed pitches. The X offsets and the width are given in bytes,
+ * all other values are given in rows or slices.
+ */
+struct CopyRect
+{
+    size_t srcX;
+    size_t srcY;
+    size_t srcZ;
+    size_t dstX;
+    size_t dstY;
+    size_t dstZ;
+    size_t width;
+    size_t height;
+    size_t depth;
+};
+
+/**
+ * Coalesces consecutive copy rectangles in the given array that are
+ * adjacent in the source and in the destination, and form a single
+ * rectangle when they are combined, e.g. neighboring tiles of a row,
+ * or rows of tiles that are stacked on top of each other. The merged
+ * rectangles are written to the start of the array, in the order of
+ * their first rectangle, and their number is returned.<br />
+ * <br />
+ * Only consecutive rectangles are merged, so that the order in which
+ * the copies are issued is preserved.
+ */
+int coalesceCopyRects(CopyRect *rects, int count);
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "DeviceSnapshot.hpp"
+#include <cstring>
+
+DeviceSnapshot::DeviceSnapshot(DeviceSnapshotFunctions functions)
+{
+    this->functions = functions;
+    data = NULL;
+    size = 0;
+}
+
+DeviceSnapshot::~DeviceSnapshot()
+{
+    delete[] data;
+}
+
+int DeviceSnapshot::get(void **data, size_t *size)
+{
+    MutexLock lock(mutex);
+    if (this->data == NULL)
+    {
+        int deviceCount = 0;
+        int result = functions.getDeviceCount(&deviceCount);
+        if (result != 0)
+        {
+            return result;
+        }
+        size_t newSize = DEVICE_SNAPSHOT_HEADER_SIZE + (size_t)deviceCount * DEVICE_SNAPSHOT_RECORD_SIZE;
+        char *newData = new char[newSize];
+        memset(newData, 0, newSize);
+
+        int *header = (int*)newData;
+        header[0] = DEVICE_SNAPSHOT_VERSION;
+        header[1] = deviceCount;
+        header[2] = DEVICE_SNAPSHOT_ATTRIBUTE_COUNT;
+        header[3] = DEVICE_SNAPSHOT_RECORD_SIZE;
+        for (int d=0; d<deviceCount; d++)
+        {
+            char *record = newData + DEVICE_SNAPSHOT_HEADER_SIZE + (size_t)d * DEVICE_SNAPSHOT_RECORD_SIZE;
+
+            size_t totalMem = 0;
+            if (functions.getTotalMem(&totalMem, d) == 0)
+            {
+                jcuda_int64 value = (jcuda_int64)totalMem;
+                memcpy(record + DEVICE_SNAPSHOT_TOTAL_MEM_OFFSET, &value, sizeof(value));
+            }
+            char *name = record + DEVICE_SNAPSHOT_NAME_OFFSET;
+            if (functions.getName(name, DEVICE_SNAPSHOT_NAME_LENGTH, d) != 0)
+            {
+                name[0] = 0;
+            }
+            name[DEVICE_SNAPSHOT_NAME_LENGTH - 1] = 0;
+
+            int *attributes = (int*)(record + DEVICE_SNAPSHOT_ATTRIBUTES_OFFSET);
+            for (int a=0; a<DEVICE_SNAPSHOT_ATTRIBUTE_COUNT; a++)
+            {
+                int value = 0;
+                if (functions.getAttribute(&value, a, d) == 0)
+                {
+                    attributes[a] = value;
+                }
+            }
+        }
+        this->size = newSize;
+        this->data = newData;
+    }
+    *data = this->data;
+    *size = this->size;
+    return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef DEVICESNAPSHOT
+#define DEVICESNAPSHOT
+
+#include "Threading.hpp"
+
+/**
+ * The layout of a device snapshot. All values are stored in the native
+ * byte order. The snapshot starts with a header of DEVICE_SNAPSHOT_HEADER_SIZE
+ * bytes, consisting of 4 ints:
+ * <pre>
+ *   0: The version of the layout (DEVICE_SNAPSHOT_VERSION)
+ *   4: The number of devices
+ *   8: The number of attributes per device (DEVICE_SNAPSHOT_ATTRIBUTE_COUNT)
+ *  12: The number of bytes per device record
+ * </pre>
+ * It is followed by one record for each device:
+ * <pre>
+ *   0: The total memory of the device, in bytes, as a 64 bit value
+ *   8: The name of the device, as a 0-terminated string of at most
+ *      DEVICE_SNAPSHOT_NAME_LENGTH bytes
+ * 264: The values of the attributes 0 to DEVICE_SNAPSHOT_ATTRIBUTE_COUNT-1,
+ *      as ints. The value of an attribute that could not be queried is 0.
+ * </pre>
+ */
+#define DEVICE_SNAPSHOT_VERSION 1
+#define DEVICE_SNAPSHOT_HEADER_SIZE 16
+#define DEVICE_SNAPSHOT_NAME_LENGTH 256
+#define DEVICE_SNAPSHOT_ATTRIBUTE_COUNT 128
+
+#define DEVICE_SNAPSHOT_TOTAL_MEM_OFFSET 0
+#define DEVICE_SNAPSHOT_NAME_OFFSET 8
+#define DEVICE_SNAPSHOT_ATTRIBUTES_OFFSET (DEVICE_SNAPSHOT_NAME_OFFSET + DEVICE_SNAPSHOT_NAME_LENGTH)
+#define DEVICE_SNAPSHOT_RECORD_SIZE (DEVICE_SNAPSHOT_ATTRIBUTES_OFFSET + DEVICE_SNAPSHOT_ATTRIBUTE_COUNT * 4)
+
+
+/**
+ * The functions that are used to query the device properties, for
+ * the driver or the runtime API. Each function returns 0 on success,
+ * or the CUDA error code.
+ */
+struct DeviceSnapshotFunctions
+{
+    int (*getDeviceCount)(int *count);
+    int (*getAttribute)(int *value, int attribute, int device);
+    int (*getTotalMem)(size_t *bytes, int device);
+    int (*getName)(char *name, int length, int device);
+};
+
+
+/**
+ * A snapshot of the attributes, the total memory and the name of all
+ * devices, in the layout that is described above. The snapshot is
+ * created once, when it is first requested, and is never modified
+ * afterwards, so that it may be exposed as a read-only buffer.
+ */
+class DeviceSnapshot
+{
+    public:
+        DeviceSnapshot(DeviceSnapshotFunctions functions);
+        ~DeviceSnapshot();
+
+        /**
+         * Obtains the snapshot, creating it if necessary. Returns 0 on
+         * success, or the error code from querying the number of devices.
+         */
+        int get(void **data, size_t *size);
+
+    private:
+        DeviceSnapshotFunctions functions;
+        Mutex mutex;
+        char *data;
+        size_t size;
+
+        DeviceSnapshot(const DeviceSnapshot&);
+        DeviceSnapshot& operator=(const DeviceSnapshot&);
+};
+
+
+#endif
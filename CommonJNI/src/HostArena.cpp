@@ -0,0 +1,637 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "HostArena.hpp"
+#include "Logger.hpp"
+
+/**
+ * The number of bytes that a thread cache may keep for one size
+ * class, and the maximum number of blocks per size class
+ */
+#define THREAD_CACHE_BYTES_PER_CLASS (256 * 1024)
+#define THREAD_CACHE_MAX_BLOCKS_PER_CLASS 32
+
+/**
+ * Returns the next block in the intrusive free list that
+ * starts with the given block
+ */
+#define NEXT_BLOCK(block) (*(void**)(block))
+
+
+/**
+ * The cache of free blocks of one thread, for one arena. The caches
+ * of one thread are stored as a linked list in a thread local value.
+ * The caches of one arena are stored as a linked list in the arena.
+ */
+class HostArenaThreadCache
+{
+    public:
+        HostArenaThreadCache(HostArena *arena)
+        {
+            this->arena = arena;
+            for (int i=0; i<HostArena::MAX_SIZE_CLASSES; i++)
+            {
+                lists[i] = NULL;
+                counts[i] = 0;
+            }
+            nextInArena = NULL;
+            nextInThread = NULL;
+        }
+
+        /** The arena, or NULL if the arena was destroyed */
+        HostArena *arena;
+
+        /** The free lists for each size class, and their lengths */
+        void *lists[HostArena::MAX_SIZE_CLASSES];
+        int counts[HostArena::MAX_SIZE_CLASSES];
+
+        HostArenaThreadCache *nextInArena;
+        HostArenaThreadCache *nextInThread;
+};
+
+Mutex HostArena::threadCacheMutex;
+ThreadLocalKey HostArena::threadCacheKey(&HostArena::destroyThreadCaches);
+
+
+HostArena::HostArena(HostArenaAllocFunction allocFunction, HostArenaFreeFunction freeFunction,
+    size_t regionSize, size_t alignment, unsigned int flags)
+{
+    this->allocFunction = allocFunction;
+    this->freeFunction = freeFunction;
+    this->flags = flags;
+
+    if (alignment < sizeof(void*))
+    {
+        alignment = sizeof(void*);
+    }
+    this->alignment = alignment;
+    alignmentShift = 0;
+    while (((size_t)1 << alignmentShift) < alignment)
+    {
+        alignmentShift++;
+    }
+
+    // The region must at least hold four blocks of the largest size class
+    if (regionSize < 4 * alignment)
+    {
+        regionSize = 4 * alignment;
+    }
+    this->regionSize = (regionSize + alignment - 1) & ~(alignment - 1);
+
+    // The size classes are the multiples 1, 2, 3, 4, 6, 8, 12, 16...
+    // of the alignment, up to a quarter of the region size
+    classCount = 0;
+    for (int i=0; i<MAX_SIZE_CLASSES; i++)
+    {
+        size_t multiple = 1;
+        if (i > 0)
+        {
+            int q = (i + 1) / 2;
+            multiple = ((i & 1) != 0) ? ((size_t)1 << q) : ((size_t)3 << (q - 1));
+        }
+        size_t classSize = multiple << alignmentShift;
+        if (classSize > this->regionSize / 4)
+        {
+            break;
+        }
+        classSizes[i] = classSize;
+        int limit = (int)(THREAD_CACHE_BYTES_PER_CLASS / classSize);
+        cacheLimits[i] = limit < THREAD_CACHE_MAX_BLOCKS_PER_CLASS ? limit : THREAD_CACHE_MAX_BLOCKS_PER_CLASS;
+        freeLists[i] = NULL;
+        classCount++;
+    }
+
+    currentRegion = NULL;
+    carvePointer = NULL;
+    carveEnd = NULL;
+    threadCaches = NULL;
+
+    reservedBytes = 0;
+    carvedBytes = 0;
+    usedBytes = 0;
+    requestedBytes = 0;
+    highWaterMark = 0;
+    regionCount = 0;
+
+    Logger::log(LOG_DEBUG, "Created host arena with region size %ld, alignment %ld and %d size classes\n",
+        (long)this->regionSize, (long)this->alignment, classCount);
+}
+
+
+HostArena::~HostArena()
+{
+    // Detach all thread caches. The blocks that they contain are
+    // part of the regions that are released below. The caches
+    // themselves are deleted when their threads exit.
+    threadCacheMutex.lock();
+    for (HostArenaThreadCache *cache = threadCaches; cache != NULL; cache = cache->nextInArena)
+    {
+        cache->arena = NULL;
+    }
+    threadCaches = NULL;
+    threadCacheMutex.unlock();
+
+    std::map<char*, size_t>::iterator iter;
+    for (iter = regions.begin(); iter != regions.end(); ++iter)
+    {
+        freeFunction(iter->first);
+    }
+    for (iter = dedicatedRegions.begin(); iter != dedicatedRegions.end(); ++iter)
+    {
+        freeFunction(iter->first);
+    }
+    Logger::log(LOG_DEBUG, "Destroyed host arena\n");
+}
+
+
+/**
+ * Returns the index of the size class for the given size, or -1 if the
+ * size is larger than the largest size class.
+ */
+int HostArena::getSizeClass(size_t size)
+{
+    size_t k = (size + alignment - 1) >> alignmentShift;
+    if (k <= 1)
+    {
+        return 0;
+    }
+    int p = 0;
+    size_t v = k - 1;
+    while (v > 1)
+    {
+        v >>= 1;
+        p++;
+    }
+    size_t base = (size_t)1 << p;
+    int index = 0;
+    if (p > 0 && k <= base + base / 2)
+    {
+        index = 2 * p;
+    }
+    else
+    {
+        index = 2 * p + 1;
+    }
+    if (index >= classCount)
+    {
+        return -1;
+    }
+    return index;
+}
+
+size_t HostArena::getBlockSize(size_t size)
+{
+    int sizeClass = getSizeClass(size);
+    if (sizeClass < 0)
+    {
+        return (size + alignment - 1) & ~(alignment - 1);
+    }
+    return classSizes[sizeClass];
+}
+
+
+/**
+ * Returns the cache of the calling thread for this arena, creating
+ * it if necessary. Returns NULL if the cache could not be created.
+ */
+HostArenaThreadCache* HostArena::getThreadCache()
+{
+    HostArenaThreadCache *head = (HostArenaThreadCache*)threadCacheKey.get();
+    for (HostArenaThreadCache *cache = head; cache != NULL; cache = cache->nextInThread)
+    {
+        if (cache->arena == this)
+        {
+            return cache;
+        }
+    }
+
+    MutexLock lock(threadCacheMutex);
+
+    // Remove the caches of arenas that have been destroyed
+    HostArenaThreadCache **link = &head;
+    while (*link != NULL)
+    {
+        HostArenaThreadCache *cache = *link;
+        if (cache->arena == NULL)
+        {
+            *link = cache->nextInThread;
+            delete cache;
+        }
+        else
+        {
+            link = &cache->nextInThread;
+        }
+    }
+
+    HostArenaThreadCache *cache = new HostArenaThreadCache(this);
+    if (cache == NULL)
+    {
+        threadCacheKey.set(head);
+        return NULL;
+    }
+    cache->nextInThread = head;
+    cache->nextInArena = threadCaches;
+    threadCaches = cache;
+    threadCacheKey.set(cache);
+    return cache;
+}
+
+
+/**
+ * Called when a thread exits, with the list of caches of this thread:
+ * Returns all cached blocks to their arenas, and deletes the caches.
+ */
+void HostArena::destroyThreadCaches(void *value)
+{
+    MutexLock lock(threadCacheMutex);
+    HostArenaThreadCache *cache = (HostArenaThreadCache*)value;
+    while (cache != NULL)
+    {
+        HostArenaThreadCache *next = cache->nextInThread;
+        HostArena *arena = cache->arena;
+        if (arena != NULL)
+        {
+            for (int i=0; i<arena->classCount; i++)
+            {
+                arena->flush(i, cache, cache->counts[i]);
+            }
+            HostArenaThreadCache **link = &arena->threadCaches;
+            while (*link != cache)
+            {
+                link = &(*link)->nextInArena;
+            }
+            *link = cache->nextInArena;
+        }
+        delete cache;
+        cache = next;
+    }
+}
+
+
+int HostArena::allocate(void **pointer, size_t size)
+{
+    if (size == 0)
+    {
+        size = 1;
+    }
+    int sizeClass = getSizeClass(size);
+    if (sizeClass < 0)
+    {
+        return allocateDedicated(pointer, size);
+    }
+
+    HostArenaThreadCache *cache = getThreadCache();
+    void *block = NULL;
+    if (cache != NULL && cache->counts[sizeClass] > 0)
+    {
+        block = cache->lists[sizeClass];
+        cache->lists[sizeClass] = NEXT_BLOCK(block);
+        cache->counts[sizeClass]--;
+    }
+    else
+    {
+        int result = refill(sizeClass, cache, &block);
+        if (result != 0)
+        {
+            *pointer = NULL;
+            return result;
+        }
+    }
+    recordAllocation(classSizes[sizeClass], size);
+    *pointer = block;
+    return 0;
+}
+
+
+void HostArena::free(void *pointer, size_t size)
+{
+    if (pointer == NULL)
+    {
+        return;
+    }
+    if (size == 0)
+    {
+        size = 1;
+    }
+    int sizeClass = getSizeClass(size);
+    if (sizeClass < 0)
+    {
+        if (freeDedicated(pointer))
+        {
+            recordFree((size + alignment - 1) & ~(alignment - 1), size);
+        }
+        return;
+    }
+    recordFree(classSizes[sizeClass], size);
+
+    HostArenaThreadCache *cache = getThreadCache();
+    if (cache == NULL)
+    {
+        MutexLock lock(mutex);
+        NEXT_BLOCK(pointer) = freeLists[sizeClass];
+        freeLists[sizeClass] = pointer;
+        return;
+    }
+    NEXT_BLOCK(pointer) = cache->lists[sizeClass];
+    cache->lists[sizeClass] = pointer;
+    cache->counts[sizeClass]++;
+
+    int limit = cacheLimits[sizeClass];
+    if (cache->counts[sizeClass] > limit)
+    {
+        flush(sizeClass, cache, cache->counts[sizeClass] - limit / 2);
+    }
+}
+
+bool HostArena::owns(void *pointer, size_t size)
+{
+    if (pointer == NULL)
+    {
+        return false;
+    }
+    if (size == 0)
+    {
+        size = 1;
+    }
+    char *p = (char*)pointer;
+    MutexLock lock(mutex);
+    int sizeClass = getSizeClass(size);
+    if (sizeClass < 0)
+    {
+        return dedicatedRegions.find(p) != dedicatedRegions.end();
+    }
+    if (((size_t)p & (alignment - 1)) != 0)
+    {
+        return false;
+    }
+
+    // Find the region with the greatest start that is not greater
+    // than the pointer
+    std::map<char*, size_t>::iterator iter = regions.upper_bound(p);
+    if (iter == regions.begin())
+    {
+        return false;
+    }
+    --iter;
+
+    // Only the part of the current region that was carved already
+    // may contain blocks
+    char *end = iter->first + iter->second;
+    if (iter->first == currentRegion)
+    {
+        end = carvePointer;
+    }
+    if (p >= end)
+    {
+        return false;
+    }
+    return (size_t)(end - p) >= classSizes[sizeClass];
+}
+
+
+/**
+ * Obtains one block of the given size class for the caller, and fills
+ * the given thread cache (if it is not NULL) with up to half of its
+ * limit of blocks. Returns 0 on success, or the error code from
+ * allocating a new region.
+ */
+int HostArena::refill(int sizeClass, HostArenaThreadCache *cache, void **block)
+{
+    int count = 1;
+    if (cache != NULL)
+    {
+        count += cacheLimits[sizeClass] / 2;
+    }
+
+    MutexLock lock(mutex);
+    for (int i=0; i<count; i++)
+    {
+        void *b = freeLists[sizeClass];
+        if (b != NULL)
+        {
+            freeLists[sizeClass] = NEXT_BLOCK(b);
+        }
+        else
+        {
+            int result = carve(sizeClass, &b);
+            if (result != 0)
+            {
+                // The first block is required, the others are optional
+                if (i == 0)
+                {
+                    return result;
+                }
+                break;
+            }
+        }
+        if (i == 0)
+        {
+            *block = b;
+        }
+        else
+        {
+            NEXT_BLOCK(b) = cache->lists[sizeClass];
+            cache->lists[sizeClass] = b;
+            cache->counts[sizeClass]++;
+        }
+    }
+    return 0;
+}
+
+
+/**
+ * Moves the given number of blocks of the given size class from the
+ * given thread cache back into the free list of this arena.
+ */
+void HostArena::flush(int sizeClass, HostArenaThreadCache *cache, int count)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+    void *first = cache->lists[sizeClass];
+    void *last = first;
+    for (int i=1; i<count; i++)
+    {
+        last = NEXT_BLOCK(last);
+    }
+    cache->lists[sizeClass] = NEXT_BLOCK(last);
+    cache->counts[sizeClass] -= count;
+
+    MutexLock lock(mutex);
+    NEXT_BLOCK(last) = freeLists[sizeClass];
+    freeLists[sizeClass] = first;
+}
+
+
+/**
+ * Carves a new block of the given size class from the current region,
+ * allocating a new region if necessary. Must be called while holding
+ * the mutex. Returns 0 on success, or the error code from allocating
+ * a new region.
+ */
+int HostArena::carve(int sizeClass, void **block)
+{
+    size_t blockSize = classSizes[sizeClass];
+    if ((size_t)(carveEnd - carvePointer) < blockSize)
+    {
+        carveRemainder();
+
+        void *start = NULL;
+        int result = allocFunction(&start, regionSize, flags);
+        if (result != 0)
+        {
+            Logger::log(LOG_ERROR, "Could not allocate host arena region of %ld bytes, error %d\n",
+                (long)regionSize, result);
+            return result;
+        }
+        regions[(char*)start] = regionSize;
+        currentRegion = (char*)start;
+        atomicAdd(&reservedBytes, (jcuda_int64)regionSize);
+        atomicAdd(&regionCount, (jcuda_int64)1);
+
+        // Regions are usually page aligned. If a larger alignment was
+        // requested, the first bytes of the region may be skipped.
+        size_t address = (size_t)start;
+        size_t aligned = (address + alignment - 1) & ~(alignment - 1);
+        carvePointer = (char*)aligned;
+        carveEnd = (char*)start + regionSize;
+        Logger::log(LOG_DEBUG, "Allocated host arena region %p of %ld bytes\n", start, (long)regionSize);
+    }
+    *block = carvePointer;
+    carvePointer += blockSize;
+    atomicAdd(&carvedBytes, (jcuda_int64)blockSize);
+    return 0;
+}
+
+
+/**
+ * Distributes the part of the current region that was not carved
+ * yet into the free lists, largest size classes first. Must be
+ * called while holding the mutex.
+ */
+void HostArena::carveRemainder()
+{
+    int sizeClass = classCount - 1;
+    while (sizeClass >= 0)
+    {
+        size_t blockSize = classSizes[sizeClass];
+        if ((size_t)(carveEnd - carvePointer) >= blockSize)
+        {
+            NEXT_BLOCK(carvePointer) = freeLists[sizeClass];
+            freeLists[sizeClass] = carvePointer;
+            carvePointer += blockSize;
+            atomicAdd(&carvedBytes, (jcuda_int64)blockSize);
+        }
+        else
+        {
+            sizeClass--;
+        }
+    }
+}
+
+
+int HostArena::allocateDedicated(void **pointer, size_t size)
+{
+    size_t blockSize = (size + alignment - 1) & ~(alignment - 1);
+    void *start = NULL;
+    int result = allocFunction(&start, blockSize, flags);
+    if (result != 0)
+    {
+        *pointer = NULL;
+        return result;
+    }
+    mutex.lock();
+    dedicatedRegions[(char*)start] = blockSize;
+    mutex.unlock();
+
+    atomicAdd(&reservedBytes, (jcuda_int64)blockSize);
+    atomicAdd(&carvedBytes, (jcuda_int64)blockSize);
+    atomicAdd(&regionCount, (jcuda_int64)1);
+    recordAllocation(blockSize, size);
+    *pointer = start;
+    return 0;
+}
+
+
+bool HostArena::freeDedicated(void *pointer)
+{
+    size_t size = 0;
+
+    mutex.lock();
+    std::map<char*, size_t>::iterator iter = dedicatedRegions.find((char*)pointer);
+    if (iter != dedicatedRegions.end())
+    {
+        size = iter->second;
+        dedicatedRegions.erase(iter);
+    }
+    mutex.unlock();
+
+    if (size == 0)
+    {
+        Logger::log(LOG_ERROR, "Pointer %p was not allocated from this host arena\n", pointer);
+        return false;
+    }
+    freeFunction(pointer);
+    atomicAdd(&reservedBytes, -(jcuda_int64)size);
+    atomicAdd(&carvedBytes, -(jcuda_int64)size);
+    atomicAdd(&regionCount, (jcuda_int64)-1);
+    return true;
+}
+
+
+void HostArena::recordAllocation(size_t blockSize, size_t size)
+{
+    jcuda_int64 used = atomicAdd(&usedBytes, (jcuda_int64)blockSize);
+    atomicAdd(&requestedBytes, (jcuda_int64)size);
+    atomicMax(&highWaterMark, used);
+}
+
+void HostArena::recordFree(size_t blockSize, size_t size)
+{
+    atomicAdd(&usedBytes, -(jcuda_int64)blockSize);
+    atomicAdd(&requestedBytes, -(jcuda_int64)size);
+}
+
+
+void HostArena::getStatistics(HostArenaStatistics *statistics)
+{
+    statistics->reservedBytes = atomicLoad(&reservedBytes);
+    statistics->usedBytes = atomicLoad(&usedBytes);
+    statistics->requestedBytes = atomicLoad(&requestedBytes);
+    statistics->highWaterMark = atomicLoad(&highWaterMark);
+    statistics->regionCount = atomicLoad(&regionCount);
+    jcuda_int64 carved = atomicLoad(&carvedBytes);
+    if (carved > 0)
+    {
+        statistics->fragmentation = (float)(1.0 - (double)statistics->requestedBytes / (double)carved);
+    }
+    else
+    {
+        statistics->fragmentation = 0.0f;
+    }
+}
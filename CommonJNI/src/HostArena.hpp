@@ -0,0 +1,222 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef HOSTARENA
+#define HOSTARENA
+
+#include "Threading.hpp"
+
+#include <map>
+
+/**
+ * The function that is used by a HostArena to allocate a region of
+ * page-locked host memory, e.g. cuMemHostAlloc or cudaHostAlloc.
+ * Returns 0 on success, or the CUDA error code.
+ */
+typedef int (*HostArenaAllocFunction)(void **pointer, size_t size, unsigned int flags);
+
+/**
+ * The function that is used by a HostArena to release a region
+ * that was allocated with the HostArenaAllocFunction
+ */
+typedef int (*HostArenaFreeFunction)(void *pointer);
+
+
+/**
+ * Statistics about the state of a HostArena
+ */
+struct HostArenaStatistics
+{
+    /** The number of bytes of page-locked memory held by the arena */
+    jcuda_int64 reservedBytes;
+
+    /** The number of bytes that are currently handed out, in blocks */
+    jcuda_int64 usedBytes;
+
+    /** The number of bytes that are currently requested by callers */
+    jcuda_int64 requestedBytes;
+
+    /** The maximum value that usedBytes ever had */
+    jcuda_int64 highWaterMark;
+
+    /** The number of regions (including dedicated large blocks) */
+    jcuda_int64 regionCount;
+
+    /**
+     * The fraction of the memory that was carved from the regions
+     * that does not hold requested data: The waste due to rounding
+     * to size classes, plus the memory of freed blocks that is
+     * cached for re-use.
+     */
+    float fragmentation;
+};
+
+
+class HostArenaThreadCache;
+
+/**
+ * An arena for page-locked host memory. The arena allocates large
+ * regions of page-locked memory with the given HostArenaAllocFunction,
+ * and hands out aligned blocks from these regions.<br />
+ * <br />
+ * Requests are rounded up to a size class (a multiple of the alignment
+ * of the form 2^n or 3*2^n), so that allocating and freeing are O(1)
+ * operations on intrusive free lists, one per size class. Each thread
+ * keeps a small cache of free blocks for each size class, so that in
+ * the common case, no lock has to be acquired. Requests that are larger
+ * than the largest size class receive a dedicated region.<br />
+ * <br />
+ * Freed blocks are not coalesced, and regions are only released when
+ * the arena is destroyed.
+ */
+class HostArena
+{
+    public:
+
+        /**
+         * Creates a new arena that allocates regions of the given size
+         * with the given functions and flags, and hands out blocks that
+         * have (at least) the given alignment, which must be a power
+         * of two.
+         */
+        HostArena(HostArenaAllocFunction allocFunction, HostArenaFreeFunction freeFunction,
+            size_t regionSize, size_t alignment, unsigned int flags);
+
+        /**
+         * Destroys this arena, releasing all regions. All blocks that
+         * have been allocated from this arena become invalid.
+         */
+        ~HostArena();
+
+        /**
+         * Allocates a block of at least the given size. Returns 0 on
+         * success, or the error code from the HostArenaAllocFunction
+         * if a new region could not be allocated.
+         */
+        int allocate(void **pointer, size_t size);
+
+        /**
+         * Returns the given block, which must have been allocated
+         * from this arena with the given size
+         */
+        void free(void *pointer, size_t size);
+
+        /**
+         * Returns whether the given pointer is the start of a block of
+         * the given size that was carved from this arena. This does not
+         * detect whether the block is currently allocated or free. The
+         * regions are looked up by their start address, so this takes
+         * logarithmic time in the number of regions.
+         */
+        bool owns(void *pointer, size_t size);
+
+        /**
+         * Returns the current statistics of this arena
+         */
+        void getStatistics(HostArenaStatistics *statistics);
+
+        /**
+         * Returns the number of bytes of a block that is handed
+         * out for a request of the given size
+         */
+        size_t getBlockSize(size_t size);
+
+    private:
+        friend class HostArenaThreadCache;
+
+        /** The maximum number of size classes */
+        static const int MAX_SIZE_CLASSES = 64;
+
+        HostArenaAllocFunction allocFunction;
+        HostArenaFreeFunction freeFunction;
+        size_t regionSize;
+        size_t alignment;
+        int alignmentShift;
+        unsigned int flags;
+
+        /** The sizes of the size classes, and their number */
+        size_t classSizes[MAX_SIZE_CLASSES];
+        int classCount;
+
+        /** The maximum number of blocks per size class in a thread cache */
+        int cacheLimits[MAX_SIZE_CLASSES];
+
+        /** Guards the free lists and regions */
+        Mutex mutex;
+
+        /** The intrusive free lists for each size class */
+        void *freeLists[MAX_SIZE_CLASSES];
+
+        /** The sizes of the regions that are carved into blocks, by start */
+        std::map<char*, size_t> regions;
+
+        /** The sizes of the regions that hold a single large block, by start */
+        std::map<char*, size_t> dedicatedRegions;
+
+        /** The start of the region that blocks are currently carved from */
+        char *currentRegion;
+
+        /** The part of the current region that was not carved yet */
+        char *carvePointer;
+        char *carveEnd;
+
+        /** The thread caches for this arena, guarded by the threadCacheMutex */
+        HostArenaThreadCache *threadCaches;
+
+        /** Statistics */
+        volatile jcuda_int64 reservedBytes;
+        volatile jcuda_int64 carvedBytes;
+        volatile jcuda_int64 usedBytes;
+        volatile jcuda_int64 requestedBytes;
+        volatile jcuda_int64 highWaterMark;
+        volatile jcuda_int64 regionCount;
+
+        int getSizeClass(size_t size);
+        HostArenaThreadCache* getThreadCache();
+        int refill(int sizeClass, HostArenaThreadCache *cache, void **block);
+        void flush(int sizeClass, HostArenaThreadCache *cache, int count);
+        int carve(int sizeClass, void **block);
+        void carveRemainder();
+        int allocateDedicated(void **pointer, size_t size);
+        bool freeDedicated(void *pointer);
+        void recordAllocation(size_t blockSize, size_t size);
+        void recordFree(size_t blockSize, size_t size);
+
+        /** Guards the linkage between arenas and thread caches */
+        static Mutex threadCacheMutex;
+
+        /** The key for the thread local list of thread caches */
+        static ThreadLocalKey threadCacheKey;
+
+        static void destroyThreadCaches(void *value);
+
+        HostArena(const HostArena&);
+        HostArena& operator=(const HostArena&);
+};
+
+
+#endif
@@ -0,0 +1,128 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "LockFreeStack.hpp"
+
+/**
+ * The index that marks the end of a list
+ */
+#define NO_NODE (-1)
+
+/**
+ * Packing and unpacking of the index and the tag of a list head
+ */
+#define HEAD(index, tag) ((jcuda_int64)(((unsigned long long)(unsigned int)(tag) << 32) | (unsigned int)(index)))
+#define HEAD_INDEX(head) ((int)(unsigned int)((unsigned long long)(head) & 0xFFFFFFFFULL))
+#define HEAD_TAG(head) ((unsigned int)((unsigned long long)(head) >> 32))
+
+
+LockFreeStack::LockFreeStack(int capacity)
+{
+    this->capacity = capacity;
+    nodes = new Node[capacity];
+    for (int i=0; i<capacity; i++)
+    {
+        nodes[i].value = NULL;
+        nodes[i].next = (i + 1 < capacity) ? i + 1 : NO_NODE;
+    }
+    head = HEAD(NO_NODE, 0);
+    freeHead = HEAD(capacity > 0 ? 0 : NO_NODE, 0);
+}
+
+LockFreeStack::~LockFreeStack()
+{
+    delete[] nodes;
+}
+
+int LockFreeStack::getCapacity()
+{
+    return capacity;
+}
+
+bool LockFreeStack::push(void *value)
+{
+    int index = popNode(&freeHead);
+    if (index == NO_NODE)
+    {
+        return false;
+    }
+    nodes[index].value = value;
+    pushNode(&head, index);
+    return true;
+}
+
+void* LockFreeStack::pop()
+{
+    int index = popNode(&head);
+    if (index == NO_NODE)
+    {
+        return NULL;
+    }
+    void *value = nodes[index].value;
+    pushNode(&freeHead, index);
+    return value;
+}
+
+/**
+ * Removes the first node from the given list, and returns its index,
+ * or NO_NODE if the list is empty
+ */
+int LockFreeStack::popNode(volatile jcuda_int64 *list)
+{
+    while (true)
+    {
+        jcuda_int64 oldHead = atomicLoad(list);
+        int index = HEAD_INDEX(oldHead);
+        if (index == NO_NODE)
+        {
+            return NO_NODE;
+        }
+        int next = nodes[index].next;
+        jcuda_int64 newHead = HEAD(next, HEAD_TAG(oldHead) + 1);
+        if (atomicCompareAndSwap(list, oldHead, newHead))
+        {
+            return index;
+        }
+    }
+}
+
+/**
+ * Inserts the node with the given index at the front of the given list
+ */
+void LockFreeStack::pushNode(volatile jcuda_int64 *list, int index)
+{
+    while (true)
+    {
+        jcuda_int64 oldHead = atomicLoad(list);
+        nodes[index].next = HEAD_INDEX(oldHead);
+        jcuda_int64 newHead = HEAD(index, HEAD_TAG(oldHead) + 1);
+        if (atomicCompareAndSwap(list, oldHead, newHead))
+        {
+            return;
+        }
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef LOCKFREESTACK
+#define LOCKFREESTACK
+
+#include "Threading.hpp"
+
+/**
+ * A lock-free stack of (non-NULL) pointers with a fixed capacity.<br />
+ * <br />
+ * The stack uses a fixed array of nodes, which are linked by their
+ * indices. The heads of the list of used nodes and of the list of
+ * free nodes are 64 bit values that consist of the index of the first
+ * node and a tag that is incremented with each modification, so that
+ * the compare-and-swap operations are not affected by the ABA problem.
+ * Since nodes are never released while the stack exists, reading the
+ * link of a node that was concurrently popped is harmless.
+ */
+class LockFreeStack
+{
+    public:
+
+        /**
+         * Creates a new stack with the given capacity
+         */
+        LockFreeStack(int capacity);
+
+        ~LockFreeStack();
+
+        /**
+         * Pushes the given value on this stack. Returns false if
+         * the stack is full.
+         */
+        bool push(void *value);
+
+        /**
+         * Pops a value from this stack. Returns NULL if the
+         * stack is empty.
+         */
+        void* pop();
+
+        /**
+         * Returns the capacity of this stack
+         */
+        int getCapacity();
+
+    private:
+
+        struct Node
+        {
+            void *value;
+            volatile int next;
+        };
+
+        int capacity;
+        Node *nodes;
+
+        volatile jcuda_int64 head;
+        volatile jcuda_int64 freeHead;
+
+        int popNode(volatile jcuda_int64 *list);
+        void pushNode(volatile jcuda_int64 *list, int index);
+
+        LockFreeStack(const LockFreeStack&);
+        LockFreeStack& operator=(const LockFreeStack&);
+};
+
+
+#endif
@@ -0,0 +1,252 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "NumaPlacement.hpp"
+#include "Logger.hpp"
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__linux__)
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#  if defined(SYS_mbind) && defined(SYS_get_mempolicy)
+#    define JCUDA_NUMA_BINDING
+#  endif
+#endif
+
+
+#ifdef JCUDA_NUMA_BINDING
+
+// The values from numaif.h, which is only available with libnuma
+#define JCUDA_MPOL_PREFERRED 1
+#define JCUDA_MPOL_F_NODE    (1 << 0)
+#define JCUDA_MPOL_F_ADDR    (1 << 1)
+
+/**
+ * The maximum number of NUMA nodes that memory may be bound to
+ */
+#define JCUDA_MAX_NUMA_NODES 1024
+
+/**
+ * Maps the given number of bytes of anonymous memory, with a policy
+ * that prefers the given node for all pages. The pages are not
+ * faulted in yet. Returns NULL if the memory could not be mapped.
+ */
+static void* mapOnNode(size_t size, int node)
+{
+    if (node >= JCUDA_MAX_NUMA_NODES)
+    {
+        return NULL;
+    }
+    void *pointer = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pointer == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    // The node is only preferred, and not strictly bound, so that
+    // page faults fall back to other nodes instead of failing when
+    // the node is out of memory
+    const int bitsPerWord = 8 * sizeof(unsigned long);
+    unsigned long mask[JCUDA_MAX_NUMA_NODES / (8 * sizeof(unsigned long))];
+    memset(mask, 0, sizeof(mask));
+    mask[node / bitsPerWord] |= 1UL << (node % bitsPerWord);
+    if (syscall(SYS_mbind, pointer, size, JCUDA_MPOL_PREFERRED, mask,
+        (unsigned long)JCUDA_MAX_NUMA_NODES + 1, 0) != 0)
+    {
+        munmap(pointer, size);
+        return NULL;
+    }
+    return pointer;
+}
+
+#endif
+
+
+NumaPlacement::NumaPlacement(NumaPlacementFunctions functions)
+{
+    this->functions = functions;
+    mode = HOST_PLACEMENT_DEFAULT;
+    sysfsRoot = "/sys";
+}
+
+NumaPlacement::~NumaPlacement()
+{
+}
+
+void NumaPlacement::setMode(int mode)
+{
+    this->mode = mode;
+}
+
+int NumaPlacement::getMode()
+{
+    return atomicLoad(&mode);
+}
+
+void NumaPlacement::setSysfsRoot(const char *root)
+{
+    MutexLock lock(mutex);
+    sysfsRoot = root;
+    deviceNodes.clear();
+}
+
+bool NumaPlacement::allocate(void **pointer, size_t size, unsigned int flags, int *result)
+{
+    *result = 0;
+    if (getMode() != HOST_PLACEMENT_DEVICE || (flags & WRITE_COMBINED_FLAG) != 0 || size == 0)
+    {
+        return false;
+    }
+#ifdef JCUDA_NUMA_BINDING
+    int device = -1;
+    if (functions.getCurrentDevice(&device) != 0)
+    {
+        return false;
+    }
+    int node = getDeviceNode(device);
+    if (node < 0)
+    {
+        return false;
+    }
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t mappedSize = (size + pageSize - 1) / pageSize * pageSize;
+    void *memory = mapOnNode(mappedSize, node);
+    if (memory == NULL)
+    {
+        Logger::log(LOG_DEBUG, "Could not map %ld bytes on node %d\n", (long)size, node);
+        return false;
+    }
+
+    // Page-locking the memory faults in all pages, on the preferred node
+    int registerResult = functions.registerHost(memory, size, flags);
+    if (registerResult != 0)
+    {
+        Logger::log(LOG_DEBUG, "Could not page-lock %ld bytes on node %d, error %d\n",
+            (long)size, node, registerResult);
+        munmap(memory, mappedSize);
+        return false;
+    }
+    {
+        MutexLock lock(mutex);
+        allocations[memory] = mappedSize;
+    }
+    Logger::log(LOG_DEBUG, "Allocated %ld bytes on node %d for device %d\n", (long)size, node, device);
+    *pointer = memory;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool NumaPlacement::free(void *pointer, int *result)
+{
+    *result = 0;
+#ifdef JCUDA_NUMA_BINDING
+    size_t mappedSize = 0;
+    {
+        MutexLock lock(mutex);
+        std::map<void*, size_t>::iterator it = allocations.find(pointer);
+        if (it == allocations.end())
+        {
+            return false;
+        }
+        mappedSize = it->second;
+        allocations.erase(it);
+    }
+    *result = functions.unregisterHost(pointer);
+    munmap(pointer, mappedSize);
+    return true;
+#else
+    return false;
+#endif
+}
+
+int NumaPlacement::getDeviceNode(int device)
+{
+    MutexLock lock(mutex);
+    std::map<int, int>::iterator it = deviceNodes.find(device);
+    if (it != deviceNodes.end())
+    {
+        return it->second;
+    }
+    int node = -1;
+    char busId[64];
+    if (functions.getPCIBusId(busId, sizeof(busId), device) == 0)
+    {
+        node = readNumaNode(sysfsRoot.c_str(), busId);
+    }
+    Logger::log(LOG_DEBUG, "NUMA node of device %d is %d\n", device, node);
+    deviceNodes[device] = node;
+    return node;
+}
+
+int NumaPlacement::getMemoryNode(void *pointer)
+{
+#ifdef JCUDA_NUMA_BINDING
+    int node = -1;
+    if (syscall(SYS_get_mempolicy, &node, NULL, 0UL, pointer, JCUDA_MPOL_F_NODE | JCUDA_MPOL_F_ADDR) == 0)
+    {
+        return node;
+    }
+#endif
+    return -1;
+}
+
+int NumaPlacement::readNumaNode(const char *sysfsRoot, const char *busId)
+{
+    // The sysfs tree uses lower case hex digits and a domain of
+    // four digits, where the CUDA bus ID may have eight digits
+    std::string name = busId;
+    size_t colon = name.find(':');
+    while (colon != std::string::npos && colon > 4 && name[0] == '0')
+    {
+        name.erase(0, 1);
+        colon--;
+    }
+    for (size_t i=0; i<name.size(); i++)
+    {
+        name[i] = (char)tolower((unsigned char)name[i]);
+    }
+    std::string path = std::string(sysfsRoot) + "/bus/pci/devices/" + name + "/numa_node";
+
+    FILE *file = fopen(path.c_str(), "r");
+    if (file == NULL)
+    {
+        return -1;
+    }
+    int node = -1;
+    if (fscanf(file, "%d", &node) != 1)
+    {
+        node = -1;
+    }
+    fclose(file);
+    return node < 0 ? -1 : node;
+}
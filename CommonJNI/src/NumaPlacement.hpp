@@ -0,0 +1,185 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NUMAPLACEMENT
+#define NUMAPLACEMENT
+
+#include <map>
+#include <string>
+#include "Threading.hpp"
+
+/**
+ * The placement modes for page-locked host memory
+ */
+
+/** The memory is allocated by the CUDA API, wherever it decides */
+#define HOST_PLACEMENT_DEFAULT 0
+
+/** The memory is allocated on the NUMA node of the current device */
+#define HOST_PLACEMENT_DEVICE  1
+
+
+/**
+ * The functions that are used by a NumaPlacement, for the driver or the
+ * runtime API. Each function returns 0 on success, or the CUDA error code.
+ */
+struct NumaPlacementFunctions
+{
+    /**
+     * Obtains the ordinal of the current device
+     */
+    int (*getCurrentDevice)(int *device);
+
+    /**
+     * Obtains the PCI bus ID of the given device, in the form
+     * [domain]:[bus]:[device].[function]
+     */
+    int (*getPCIBusId)(char *busId, int length, int device);
+
+    /**
+     * Page-locks the given memory, e.g. with cuMemHostRegister or
+     * cudaHostRegister. The flags are the CU_MEMHOSTALLOC or
+     * cudaHostAlloc flags, except for the write-combined flag.
+     */
+    int (*registerHost)(void *pointer, size_t size, unsigned int flags);
+
+    /**
+     * Unlocks memory that was page-locked with registerHost
+     */
+    int (*unregisterHost)(void *pointer);
+};
+
+
+/**
+ * Places page-locked host memory on the NUMA node that the current
+ * device is attached to. The node of a device is looked up once, from
+ * the numa_node file of its PCI bus ID in the sysfs tree.<br />
+ * <br />
+ * When the placement mode is HOST_PLACEMENT_DEVICE, the memory is
+ * mapped, bound to the node of the current device, and then
+ * page-locked, which faults in all pages on this node. If the node is
+ * not known, or the memory should be write-combined (which is only
+ * possible for memory that is allocated by CUDA), or the platform does
+ * not support binding memory to nodes, then the memory has to be
+ * allocated by the CUDA API as usual.<br />
+ * <br />
+ * Binding memory is currently only supported on Linux.
+ */
+class NumaPlacement
+{
+    public:
+
+        /**
+         * Creates a new placement that uses the given functions, with
+         * the mode HOST_PLACEMENT_DEFAULT and the sysfs tree at /sys
+         */
+        NumaPlacement(NumaPlacementFunctions functions);
+
+        /**
+         * Destroys this placement. Memory that was allocated with
+         * this placement is not released.
+         */
+        ~NumaPlacement();
+
+        /**
+         * Sets the HOST_PLACEMENT mode
+         */
+        void setMode(int mode);
+
+        /**
+         * Returns the HOST_PLACEMENT mode
+         */
+        int getMode();
+
+        /**
+         * Sets the root of the sysfs tree that the nodes of the
+         * devices are looked up in, and clears the known nodes
+         */
+        void setSysfsRoot(const char *root);
+
+        /**
+         * Allocates the given number of bytes of page-locked memory,
+         * according to the placement mode. Returns whether the memory
+         * was allocated by this placement, and stores the error code
+         * in the given result. If this returns false, the memory has
+         * to be allocated with the CUDA API.
+         */
+        bool allocate(void **pointer, size_t size, unsigned int flags, int *result);
+
+        /**
+         * Frees the given memory if it was allocated by this placement.
+         * Returns whether this was the case, and stores the error code
+         * in the given result. If this returns false, the memory has
+         * to be freed with the CUDA API.
+         */
+        bool free(void *pointer, int *result);
+
+        /**
+         * Returns the NUMA node of the given device, or -1 if it
+         * is not known
+         */
+        int getDeviceNode(int device);
+
+        /**
+         * Returns the NUMA node that the page of the given host memory
+         * is located on, or -1 if this is not known
+         */
+        int getMemoryNode(void *pointer);
+
+        /**
+         * Reads the NUMA node of the device with the given PCI bus ID
+         * from the sysfs tree with the given root. Returns -1 if the
+         * node is not known.
+         */
+        static int readNumaNode(const char *sysfsRoot, const char *busId);
+
+    private:
+
+        /** The write-combined flag of cuMemHostAlloc and cudaHostAlloc */
+        static const unsigned int WRITE_COMBINED_FLAG = 0x04;
+
+        NumaPlacementFunctions functions;
+
+        /** Guards all members except for the mode */
+        Mutex mutex;
+
+        volatile int mode;
+
+        std::string sysfsRoot;
+
+        /** The NUMA nodes of the devices that have been looked up */
+        std::map<int, int> deviceNodes;
+
+        /** The sizes of the mappings of the allocations */
+        std::map<void*, size_t> allocations;
+
+        NumaPlacement(const NumaPlacement&);
+        NumaPlacement& operator=(const NumaPlacement&);
+};
+
+
+#endif
@@ -0,0 +1,496 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PeerRouter.hpp"
+#include "Logger.hpp"
+
+/**
+ * The number of staging buffers of a link
+ */
+#define PEER_STAGING_BUFFERS 2
+
+
+/**
+ * The state of the copies between one pair of endpoints
+ */
+struct PeerLink
+{
+    PeerEndpoint dst;
+    PeerEndpoint src;
+
+    /** The PEER_ROUTE that is taken */
+    int route;
+
+    /** Serializes the copies over this link */
+    Mutex mutex;
+
+    /**
+     * The staging resources, which are created when the first staged
+     * copy is made: The page-locked buffers, the streams for copying
+     * into the buffers (on the source) and out of the buffers (on the
+     * destination), and the events that are recorded when a buffer was
+     * filled and drained.
+     */
+    void *buffers[PEER_STAGING_BUFFERS];
+    void *srcStream;
+    void *dstStream;
+    void *filledEvents[PEER_STAGING_BUFFERS];
+    void *drainedEvents[PEER_STAGING_BUFFERS];
+    bool drainedRecorded[PEER_STAGING_BUFFERS];
+
+    /** The event that marks the start of an asynchronous copy */
+    void *startEvent;
+
+    /** The buffer that is used for the next chunk */
+    int nextBuffer;
+
+    /** The size of the buffers */
+    size_t bufferSize;
+};
+
+/**
+ * Returns whether the given endpoint is the given other endpoint,
+ * or, for the runtime API, on the same device
+ */
+static bool matches(PeerEndpoint endpoint, PeerEndpoint other)
+{
+    if (endpoint.context != NULL || other.context != NULL)
+    {
+        return endpoint.context == other.context;
+    }
+    return endpoint.device == other.device;
+}
+
+
+PeerRouter::PeerRouter(PeerRouterFunctions functions)
+{
+    this->functions = functions;
+    enabled = false;
+    chunkSize = 0;
+    discovered = false;
+    deviceCount = 0;
+    directCount = 0;
+    directBytes = 0;
+    stagedCount = 0;
+    stagedBytes = 0;
+}
+
+PeerRouter::~PeerRouter()
+{
+    disable();
+}
+
+int PeerRouter::discover()
+{
+    if (discovered)
+    {
+        return 0;
+    }
+    int count = 0;
+    int result = functions.getDeviceCount(&count);
+    if (result != 0)
+    {
+        return result;
+    }
+    canAccess.assign((size_t)count * count, 0);
+    busIds.assign(count, std::string());
+    for (int d=0; d<count; d++)
+    {
+        char busId[64] = { 0 };
+        if (functions.getPCIBusId(busId, (int)sizeof(busId), d) == 0)
+        {
+            busIds[d] = busId;
+        }
+        for (int p=0; p<count; p++)
+        {
+            int access = 0;
+            if (p != d && functions.canAccessPeer(&access, d, p) == 0)
+            {
+                canAccess[d * count + p] = access;
+            }
+        }
+    }
+    deviceCount = count;
+    discovered = true;
+
+    for (int d=0; d<count; d++)
+    {
+        std::string peers;
+        for (int p=0; p<count; p++)
+        {
+            peers += canAccess[d * count + p] ? '1' : (p == d ? '-' : '0');
+        }
+        Logger::log(LOG_DEBUG, "Peer topology: device %d at %s, peer access %s\n",
+            d, busIds[d].c_str(), peers.c_str());
+    }
+    return 0;
+}
+
+int PeerRouter::getRouteInternal(int srcDevice, int dstDevice)
+{
+    if (srcDevice == dstDevice)
+    {
+        return PEER_ROUTE_LOCAL;
+    }
+    if (srcDevice < 0 || srcDevice >= deviceCount ||
+        dstDevice < 0 || dstDevice >= deviceCount)
+    {
+        return PEER_ROUTE_STAGED;
+    }
+    if (canAccess[dstDevice * deviceCount + srcDevice] ||
+        canAccess[srcDevice * deviceCount + dstDevice])
+    {
+        return PEER_ROUTE_DIRECT;
+    }
+    return PEER_ROUTE_STAGED;
+}
+
+int PeerRouter::enable(size_t chunkSize)
+{
+    MutexLock lock(mutex);
+    int result = discover();
+    if (result != 0)
+    {
+        return result;
+    }
+    this->chunkSize = chunkSize;
+    enabled = true;
+    return 0;
+}
+
+void PeerRouter::disable()
+{
+    MutexLock lock(mutex);
+    for (LinkMap::iterator it = links.begin(); it != links.end(); ++it)
+    {
+        PeerLink *link = it->second;
+        link->mutex.lock();
+        releaseStaging(link);
+        link->mutex.unlock();
+        delete link;
+    }
+    links.clear();
+    enabled = false;
+}
+
+bool PeerRouter::isEnabled()
+{
+    return enabled;
+}
+
+int PeerRouter::getRoute(int srcDevice, int dstDevice, int *route)
+{
+    MutexLock lock(mutex);
+    int result = discover();
+    if (result != 0)
+    {
+        return result;
+    }
+    *route = getRouteInternal(srcDevice, dstDevice);
+    return 0;
+}
+
+void PeerRouter::removeEndpoint(PeerEndpoint endpoint)
+{
+    MutexLock lock(mutex);
+    LinkMap::iterator it = links.begin();
+    while (it != links.end())
+    {
+        PeerLink *link = it->second;
+        if (matches(link->dst, endpoint) || matches(link->src, endpoint))
+        {
+            link->mutex.lock();
+            releaseStaging(link);
+            link->mutex.unlock();
+            delete link;
+            links.erase(it++);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void PeerRouter::getStatistics(PeerRouterStatistics *statistics)
+{
+    statistics->directCount = atomicLoad(&directCount);
+    statistics->directBytes = atomicLoad(&directBytes);
+    statistics->stagedCount = atomicLoad(&stagedCount);
+    statistics->stagedBytes = atomicLoad(&stagedBytes);
+}
+
+/**
+ * Returns the link between the given endpoints, creating it if
+ * necessary. When the link is created and the devices may access
+ * each other, peer access is enabled in both directions where it
+ * is supported. If it can not be enabled in either direction, then
+ * the copies are staged.
+ */
+PeerLink* PeerRouter::getLink(PeerEndpoint dstEndpoint, PeerEndpoint srcEndpoint)
+{
+    std::pair<EndpointKey, EndpointKey> key(
+        EndpointKey(dstEndpoint.device, dstEndpoint.context),
+        EndpointKey(srcEndpoint.device, srcEndpoint.context));
+    LinkMap::iterator it = links.find(key);
+    if (it != links.end())
+    {
+        return it->second;
+    }
+
+    PeerLink *link = new PeerLink();
+    link->dst = dstEndpoint;
+    link->src = srcEndpoint;
+    link->route = getRouteInternal(srcEndpoint.device, dstEndpoint.device);
+    for (int i=0; i<PEER_STAGING_BUFFERS; i++)
+    {
+        link->buffers[i] = NULL;
+        link->filledEvents[i] = NULL;
+        link->drainedEvents[i] = NULL;
+        link->drainedRecorded[i] = false;
+    }
+    link->srcStream = NULL;
+    link->dstStream = NULL;
+    link->startEvent = NULL;
+    link->nextBuffer = 0;
+    link->bufferSize = 0;
+
+    if (link->route == PEER_ROUTE_DIRECT)
+    {
+        bool enabledAny = false;
+        int s = srcEndpoint.device;
+        int d = dstEndpoint.device;
+        if (canAccess[d * deviceCount + s] &&
+            functions.enablePeerAccess(dstEndpoint, srcEndpoint) == 0)
+        {
+            enabledAny = true;
+        }
+        if (canAccess[s * deviceCount + d] &&
+            functions.enablePeerAccess(srcEndpoint, dstEndpoint) == 0)
+        {
+            enabledAny = true;
+        }
+        if (!enabledAny)
+        {
+            Logger::log(LOG_DEBUG, "Peer access between device %d and %d could not be enabled, staging copies\n", s, d);
+            link->route = PEER_ROUTE_STAGED;
+        }
+    }
+    links[key] = link;
+    return link;
+}
+
+int PeerRouter::copy(void *dst, PeerEndpoint dstEndpoint, const void *src, PeerEndpoint srcEndpoint,
+    size_t bytes, void *stream, bool async)
+{
+    if (!enabled)
+    {
+        return functions.copyPeer(dst, dstEndpoint, src, srcEndpoint, bytes, stream, async);
+    }
+    mutex.lock();
+    if (!enabled || bytes == 0)
+    {
+        mutex.unlock();
+        return functions.copyPeer(dst, dstEndpoint, src, srcEndpoint, bytes, stream, async);
+    }
+    PeerLink *link = getLink(dstEndpoint, srcEndpoint);
+    size_t currentChunkSize = chunkSize;
+
+    // The link is locked before the router is unlocked, so that it
+    // can not be released while the copy is issued
+    link->mutex.lock();
+    mutex.unlock();
+
+    int result = 0;
+    if (link->route != PEER_ROUTE_STAGED)
+    {
+        result = functions.copyPeer(dst, dstEndpoint, src, srcEndpoint, bytes, stream, async);
+        if (result == 0)
+        {
+            atomicAdd(&directCount, (jcuda_int64)1);
+            atomicAdd(&directBytes, (jcuda_int64)bytes);
+        }
+    }
+    else
+    {
+        if (link->buffers[0] == NULL || link->bufferSize != currentChunkSize)
+        {
+            releaseStaging(link);
+            link->bufferSize = currentChunkSize;
+            result = initStaging(link);
+        }
+        if (result == 0)
+        {
+            result = copyStaged(link, (char*)dst, (const char*)src, bytes, stream, async);
+        }
+        if (result == 0)
+        {
+            atomicAdd(&stagedCount, (jcuda_int64)1);
+            atomicAdd(&stagedBytes, (jcuda_int64)bytes);
+        }
+    }
+    link->mutex.unlock();
+    return result;
+}
+
+/**
+ * Creates the staging buffers, streams and events of the given link.
+ * On failure, the resources that have been created are released.
+ */
+int PeerRouter::initStaging(PeerLink *link)
+{
+    int result = 0;
+    for (int i=0; i<PEER_STAGING_BUFFERS && result == 0; i++)
+    {
+        result = functions.allocHost(link->src, &link->buffers[i], link->bufferSize);
+        if (result == 0) result = functions.createEvent(link->src, &link->filledEvents[i]);
+        if (result == 0) result = functions.createEvent(link->dst, &link->drainedEvents[i]);
+    }
+    if (result == 0) result = functions.createStream(link->src, &link->srcStream);
+    if (result == 0) result = functions.createStream(link->dst, &link->dstStream);
+    if (result == 0) result = functions.createEvent(link->dst, &link->startEvent);
+    if (result != 0)
+    {
+        Logger::log(LOG_ERROR, "Could not create the staging resources for copies from device %d to %d\n",
+            link->src.device, link->dst.device);
+        releaseStaging(link);
+    }
+    return result;
+}
+
+/**
+ * Waits for all staged copies of the given link, and releases its
+ * staging resources
+ */
+void PeerRouter::releaseStaging(PeerLink *link)
+{
+    // The copies out of the buffers may have been issued in a stream
+    // of the caller, so wait until all buffers have been drained
+    for (int i=0; i<PEER_STAGING_BUFFERS; i++)
+    {
+        if (link->drainedRecorded[i])
+        {
+            functions.synchronizeEvent(link->dst, link->drainedEvents[i]);
+            link->drainedRecorded[i] = false;
+        }
+    }
+    if (link->srcStream != NULL)
+    {
+        functions.synchronizeStream(link->src, link->srcStream);
+        functions.destroyStream(link->src, link->srcStream);
+        link->srcStream = NULL;
+    }
+    if (link->dstStream != NULL)
+    {
+        functions.synchronizeStream(link->dst, link->dstStream);
+        functions.destroyStream(link->dst, link->dstStream);
+        link->dstStream = NULL;
+    }
+    for (int i=0; i<PEER_STAGING_BUFFERS; i++)
+    {
+        if (link->filledEvents[i] != NULL)
+        {
+            functions.destroyEvent(link->src, link->filledEvents[i]);
+            link->filledEvents[i] = NULL;
+        }
+        if (link->drainedEvents[i] != NULL)
+        {
+            functions.destroyEvent(link->dst, link->drainedEvents[i]);
+            link->drainedEvents[i] = NULL;
+        }
+        if (link->buffers[i] != NULL)
+        {
+            functions.freeHost(link->src, link->buffers[i]);
+            link->buffers[i] = NULL;
+        }
+    }
+    if (link->startEvent != NULL)
+    {
+        functions.destroyEvent(link->dst, link->startEvent);
+        link->startEvent = NULL;
+    }
+    link->nextBuffer = 0;
+}
+
+/**
+ * Copies the given data through the staging buffers of the given link.
+ * Each chunk is copied into the next buffer, in the source stream, after
+ * the buffer has been drained. Then it is copied out of the buffer, in
+ * the destination stream, after the buffer has been filled. Thus, the
+ * transfers out of the source device overlap with the transfers into
+ * the destination device.
+ */
+int PeerRouter::copyStaged(PeerLink *link, char *dst, const char *src, size_t bytes, void *stream, bool async)
+{
+    int result = 0;
+    void *dstStream = async ? stream : link->dstStream;
+    if (async)
+    {
+        // The source side starts after the preceding work in the stream
+        result = functions.recordEvent(link->dst, link->startEvent, dstStream);
+        if (result != 0) return result;
+        result = functions.streamWaitEvent(link->src, link->srcStream, link->startEvent);
+        if (result != 0) return result;
+    }
+
+    size_t offset = 0;
+    while (offset < bytes)
+    {
+        size_t n = bytes - offset;
+        if (n > link->bufferSize)
+        {
+            n = link->bufferSize;
+        }
+        int b = link->nextBuffer;
+        link->nextBuffer = (b + 1) % PEER_STAGING_BUFFERS;
+
+        if (link->drainedRecorded[b])
+        {
+            result = functions.streamWaitEvent(link->src, link->srcStream, link->drainedEvents[b]);
+            if (result != 0) return result;
+        }
+        result = functions.copyDtoHAsync(link->src, link->buffers[b], src + offset, n, link->srcStream);
+        if (result != 0) return result;
+        result = functions.recordEvent(link->src, link->filledEvents[b], link->srcStream);
+        if (result != 0) return result;
+
+        result = functions.streamWaitEvent(link->dst, dstStream, link->filledEvents[b]);
+        if (result != 0) return result;
+        result = functions.copyHtoDAsync(link->dst, dst + offset, link->buffers[b], n, dstStream);
+        if (result != 0) return result;
+        result = functions.recordEvent(link->dst, link->drainedEvents[b], dstStream);
+        if (result != 0) return result;
+        link->drainedRecorded[b] = true;
+
+        offset += n;
+    }
+    if (!async)
+    {
+        result = functions.synchronizeStream(link->dst, dstStream);
+    }
+    return result;
+}
@@ -0,0 +1,234 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PEERROUTER
+#define PEERROUTER
+
+#include <map>
+#include <string>
+#include <vector>
+#include "Threading.hpp"
+
+/**
+ * The routes that a copy between two devices may take
+ */
+#define PEER_ROUTE_LOCAL  0
+#define PEER_ROUTE_DIRECT 1
+#define PEER_ROUTE_STAGED 2
+
+
+/**
+ * One side of a copy between devices: The device ordinal, and the
+ * context that the memory belongs to. The context is the CUcontext
+ * for the driver API, and NULL for the runtime API, where the
+ * device identifies the primary context.
+ */
+struct PeerEndpoint
+{
+    int device;
+    void *context;
+};
+
+
+/**
+ * The functions that are used by a PeerRouter, for the driver or the
+ * runtime API. Each function returns 0 on success, or the CUDA error
+ * code. The functions that receive an endpoint are executed with the
+ * context of this endpoint being current. Streams and events are the
+ * CUstream/cudaStream_t and CUevent/cudaEvent_t handles.
+ */
+struct PeerRouterFunctions
+{
+    int (*getDeviceCount)(int *count);
+    int (*canAccessPeer)(int *canAccess, int device, int peerDevice);
+    int (*getPCIBusId)(char *busId, int length, int device);
+
+    /**
+     * Enables the access of the given endpoint to the memory of the
+     * given peer. Access that is already enabled is not an error.
+     */
+    int (*enablePeerAccess)(PeerEndpoint endpoint, PeerEndpoint peer);
+
+    /**
+     * The plain cuMemcpyPeer/cudaMemcpyPeer, or its Async version
+     */
+    int (*copyPeer)(void *dst, PeerEndpoint dstEndpoint, const void *src, PeerEndpoint srcEndpoint, size_t bytes, void *stream, bool async);
+
+    /**
+     * Allocates and frees page-locked host memory that may be used
+     * in all contexts
+     */
+    int (*allocHost)(PeerEndpoint endpoint, void **pointer, size_t size);
+    int (*freeHost)(PeerEndpoint endpoint, void *pointer);
+
+    int (*createStream)(PeerEndpoint endpoint, void **stream);
+    int (*destroyStream)(PeerEndpoint endpoint, void *stream);
+    int (*synchronizeStream)(PeerEndpoint endpoint, void *stream);
+    int (*synchronizeEvent)(PeerEndpoint endpoint, void *event);
+    int (*createEvent)(PeerEndpoint endpoint, void **event);
+    int (*destroyEvent)(PeerEndpoint endpoint, void *event);
+    int (*recordEvent)(PeerEndpoint endpoint, void *event, void *stream);
+    int (*streamWaitEvent)(PeerEndpoint endpoint, void *stream, void *event);
+    int (*copyDtoHAsync)(PeerEndpoint endpoint, void *dst, const void *src, size_t bytes, void *stream);
+    int (*copyHtoDAsync)(PeerEndpoint endpoint, void *dst, const void *src, size_t bytes, void *stream);
+};
+
+
+/**
+ * Statistics about the copies that have been routed
+ */
+struct PeerRouterStatistics
+{
+    /** The number of copies and bytes that did not need staging */
+    jcuda_int64 directCount;
+    jcuda_int64 directBytes;
+
+    /** The number of copies and bytes that were staged in host memory */
+    jcuda_int64 stagedCount;
+    jcuda_int64 stagedBytes;
+};
+
+
+struct PeerLink;
+
+/**
+ * A router for copies between the memory of different devices. When
+ * it is enabled, the topology is discovered once: Which device may
+ * access the memory of which other device, and the PCI bus IDs of
+ * all devices. For each pair of endpoints that may access each
+ * other, peer access is enabled when the first copy between them is
+ * made, and the copy is passed to the driver.<br />
+ * <br />
+ * Copies between endpoints that can not access each other are split
+ * into chunks, and routed through two page-locked staging buffers:
+ * While one chunk is copied from the source device into one buffer,
+ * the previous chunk is copied from the other buffer to the destination
+ * device. The halves are ordered with events, so the host does not
+ * wait for any of them.<br />
+ * <br />
+ * For asynchronous staged copies, the copies to the destination are
+ * issued in the given stream, which must belong to the destination
+ * endpoint. When the router is disabled, all copies are passed to
+ * the driver.
+ */
+class PeerRouter
+{
+    public:
+        PeerRouter(PeerRouterFunctions functions);
+
+        /**
+         * Destroys this router, releasing all staging resources
+         */
+        ~PeerRouter();
+
+        /**
+         * Enables the routing, with staged copies being split into
+         * chunks of the given size. Discovers the topology if this
+         * was not done yet. Returns 0 on success, or the error code
+         * from the discovery.
+         */
+        int enable(size_t chunkSize);
+
+        /**
+         * Disables the routing, after waiting for all staged copies,
+         * and releases all staging resources
+         */
+        void disable();
+
+        /**
+         * Returns whether the routing is enabled
+         */
+        bool isEnabled();
+
+        /**
+         * Copies the given number of bytes between the given endpoints.
+         * If 'async' is true, then the copy is ordered with respect to
+         * the given stream. Otherwise, this call returns when the copy
+         * is complete.
+         */
+        int copy(void *dst, PeerEndpoint dstEndpoint, const void *src, PeerEndpoint srcEndpoint,
+            size_t bytes, void *stream, bool async);
+
+        /**
+         * Obtains the PEER_ROUTE that is taken for copies from the given
+         * source device to the given destination device, discovering
+         * the topology if necessary. Returns 0 on success, or the error
+         * code from the discovery.
+         */
+        int getRoute(int srcDevice, int dstDevice, int *route);
+
+        /**
+         * Releases the staging resources of all copies from or to the
+         * given endpoint, which is about to be destroyed. For the runtime
+         * API (with a NULL context), all copies from or to the device
+         * are affected. For the driver API, the device is ignored.
+         */
+        void removeEndpoint(PeerEndpoint endpoint);
+
+        /**
+         * Returns the statistics of all copies that have been routed
+         */
+        void getStatistics(PeerRouterStatistics *statistics);
+
+    private:
+        PeerRouterFunctions functions;
+
+        /** Guards the topology and the links */
+        Mutex mutex;
+
+        volatile bool enabled;
+        size_t chunkSize;
+
+        /** The topology, which is discovered once */
+        bool discovered;
+        int deviceCount;
+        std::vector<int> canAccess;
+        std::vector<std::string> busIds;
+
+        /** The links between pairs of endpoints, keyed by (destination, source) */
+        typedef std::pair<int, void*> EndpointKey;
+        typedef std::map<std::pair<EndpointKey, EndpointKey>, PeerLink*> LinkMap;
+        LinkMap links;
+
+        volatile jcuda_int64 directCount;
+        volatile jcuda_int64 directBytes;
+        volatile jcuda_int64 stagedCount;
+        volatile jcuda_int64 stagedBytes;
+
+        int discover();
+        int getRouteInternal(int srcDevice, int dstDevice);
+        PeerLink* getLink(PeerEndpoint dstEndpoint, PeerEndpoint srcEndpoint);
+        int initStaging(PeerLink *link);
+        void releaseStaging(PeerLink *link);
+        int copyStaged(PeerLink *link, char *dst, const char *src, size_t bytes, void *stream, bool async);
+
+        PeerRouter(const PeerRouter&);
+        PeerRouter& operator=(const PeerRouter&);
+};
+
+
+#endif
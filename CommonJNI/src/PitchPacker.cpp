@@ -0,0 +1,429 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PitchPacker.hpp"
+#include "Logger.hpp"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PITCH_PACKER_SSE2
+#include <emmintrin.h>
+#endif
+
+/**
+ * The number of bytes that one thread copies at a time
+ */
+#define PITCH_CHUNK_BYTES (256 * 1024)
+
+/**
+ * The granularity of the sizes of the staging buffers
+ */
+#define PITCH_STAGING_GRANULARITY (64 * 1024)
+
+/**
+ * A copy of rows between pitched memory regions, which is split into
+ * chunks of rows that are copied by the threads of the packer
+ */
+struct PitchJob
+{
+    char *dst;
+    size_t dstPitch;
+    size_t dstSlicePitch;
+    const char *src;
+    size_t srcPitch;
+    size_t srcSlicePitch;
+    size_t width;
+    size_t height;
+    size_t rows;
+    size_t rowsPerChunk;
+    int chunkCount;
+    volatile int nextChunk;
+
+    /** Whether the destination is only read by the device */
+    bool streaming;
+};
+
+
+/**
+ * Copies one row of the given number of bytes. If the destination is
+ * streaming, then the bytes are written with non-temporal stores, so
+ * that they do not evict the cache lines of the caller.
+ */
+static void copyRow(char *dst, const char *src, size_t n, bool streaming)
+{
+#ifdef PITCH_PACKER_SSE2
+    if (streaming && n >= 256)
+    {
+        size_t head = (16 - ((size_t)dst & 15)) & 15;
+        memcpy(dst, src, head);
+        dst += head;
+        src += head;
+        n -= head;
+        while (n >= 64)
+        {
+            __m128i a = _mm_loadu_si128((const __m128i*)(src     ));
+            __m128i b = _mm_loadu_si128((const __m128i*)(src + 16));
+            __m128i c = _mm_loadu_si128((const __m128i*)(src + 32));
+            __m128i d = _mm_loadu_si128((const __m128i*)(src + 48));
+            _mm_stream_si128((__m128i*)(dst     ), a);
+            _mm_stream_si128((__m128i*)(dst + 16), b);
+            _mm_stream_si128((__m128i*)(dst + 32), c);
+            _mm_stream_si128((__m128i*)(dst + 48), d);
+            dst += 64;
+            src += 64;
+            n -= 64;
+        }
+    }
+#endif
+    memcpy(dst, src, n);
+}
+
+/**
+ * Copies chunks of rows of the given job, until all chunks have been
+ * taken by one of the threads
+ */
+static void runJob(PitchJob *job)
+{
+    while (true)
+    {
+        int chunk = atomicAdd(&job->nextChunk, 1) - 1;
+        if (chunk >= job->chunkCount)
+        {
+            break;
+        }
+        size_t first = (size_t)chunk * job->rowsPerChunk;
+        size_t last = first + job->rowsPerChunk;
+        if (last > job->rows)
+        {
+            last = job->rows;
+        }
+        for (size_t row = first; row < last; row++)
+        {
+            size_t z = row / job->height;
+            size_t y = row % job->height;
+            copyRow(
+                job->dst + z * job->dstSlicePitch + y * job->dstPitch,
+                job->src + z * job->srcSlicePitch + y * job->srcPitch,
+                job->width, job->streaming);
+        }
+    }
+#ifdef PITCH_PACKER_SSE2
+    if (job->streaming)
+    {
+        _mm_sfence();
+    }
+#endif
+}
+
+
+PitchPacker::PitchPacker(PitchPackerFunctions functions)
+{
+    this->functions = functions;
+    enabled = 0;
+    threshold = 0;
+    workerCount = 0;
+    job = NULL;
+    generation = 0;
+    activeWorkers = 0;
+    stopping = false;
+    copies = 0;
+    bytes = 0;
+    nanos = 0;
+}
+
+PitchPacker::~PitchPacker()
+{
+    stopWorkers();
+}
+
+bool PitchPacker::enable(int threadCount, size_t threshold)
+{
+    MutexLock jobLock(jobMutex);
+    stopWorkers();
+    if (threadCount <= 0)
+    {
+        threadCount = Thread::getProcessorCount();
+    }
+    for (int i=1; i<threadCount; i++)
+    {
+        Thread *worker = new Thread();
+        workers.push_back(worker);
+        if (!worker->start(&PitchPacker::runWorker, this))
+        {
+            Logger::log(LOG_ERROR, "Could not start pitch packer worker\n");
+            stopWorkers();
+            return false;
+        }
+    }
+    workerCount = (int)workers.size();
+    atomicStore(&this->threshold, (jcuda_int64)threshold);
+    enabled = 1;
+    return true;
+}
+
+void PitchPacker::disable()
+{
+    {
+        MutexLock jobLock(jobMutex);
+        enabled = 0;
+        stopWorkers();
+    }
+    MutexLock lock(mutex);
+    std::map<void*, std::vector<PitchStaging> >::iterator it;
+    for (it = stagings.begin(); it != stagings.end(); ++it)
+    {
+        for (size_t i=0; i<it->second.size(); i++)
+        {
+            functions.freeHost(it->second[i].buffer);
+        }
+    }
+    stagings.clear();
+}
+
+bool PitchPacker::accepts(size_t bytes)
+{
+    if (atomicLoad(&enabled) == 0 || bytes == 0)
+    {
+        return false;
+    }
+    return (jcuda_int64)bytes >= atomicLoad(&threshold);
+}
+
+int PitchPacker::acquire(size_t size, PitchStaging *staging)
+{
+    void *owner = NULL;
+    int result = functions.getOwner(&owner);
+    if (result != 0)
+    {
+        return result;
+    }
+
+    MutexLock lock(mutex);
+    std::vector<PitchStaging> &available = stagings[owner];
+    for (size_t i=0; i<available.size(); i++)
+    {
+        if (available[i].size >= size)
+        {
+            *staging = available[i];
+            available.erase(available.begin() + i);
+            return 0;
+        }
+    }
+    size_t alignedSize = (size + PITCH_STAGING_GRANULARITY - 1) / PITCH_STAGING_GRANULARITY * PITCH_STAGING_GRANULARITY;
+    staging->owner = owner;
+    staging->buffer = NULL;
+    staging->size = alignedSize;
+    result = functions.allocHost(&staging->buffer, alignedSize);
+    if (result != 0)
+    {
+        Logger::log(LOG_DEBUG, "Could not allocate pitch staging buffer of %ld bytes, error %d\n",
+            (long)alignedSize, result);
+    }
+    return result;
+}
+
+void PitchPacker::release(PitchStaging *staging)
+{
+    MutexLock lock(mutex);
+    stagings[staging->owner].push_back(*staging);
+}
+
+void PitchPacker::pack(void *dst, const void *src, size_t srcPitch, size_t srcHeight, size_t width, size_t height, size_t depth)
+{
+    PitchJob pitchJob;
+    pitchJob.dst = (char*)dst;
+    pitchJob.dstPitch = width;
+    pitchJob.dstSlicePitch = width * height;
+    pitchJob.src = (const char*)src;
+    pitchJob.srcPitch = srcPitch;
+    pitchJob.srcSlicePitch = srcPitch * srcHeight;
+    pitchJob.width = width;
+    pitchJob.height = height;
+    pitchJob.rows = height * depth;
+    pitchJob.streaming = true;
+    execute(&pitchJob);
+}
+
+void PitchPacker::unpack(void *dst, size_t dstPitch, size_t dstHeight, const void *src, size_t width, size_t height, size_t depth)
+{
+    PitchJob pitchJob;
+    pitchJob.dst = (char*)dst;
+    pitchJob.dstPitch = dstPitch;
+    pitchJob.dstSlicePitch = dstPitch * dstHeight;
+    pitchJob.src = (const char*)src;
+    pitchJob.srcPitch = width;
+    pitchJob.srcSlicePitch = width * height;
+    pitchJob.width = width;
+    pitchJob.height = height;
+    pitchJob.rows = height * depth;
+    pitchJob.streaming = false;
+    execute(&pitchJob);
+}
+
+void PitchPacker::removeOwner(void *owner)
+{
+    MutexLock lock(mutex);
+    std::map<void*, std::vector<PitchStaging> >::iterator it = stagings.find(owner);
+    if (it == stagings.end())
+    {
+        return;
+    }
+    for (size_t i=0; i<it->second.size(); i++)
+    {
+        functions.freeHost(it->second[i].buffer);
+    }
+    stagings.erase(it);
+}
+
+void PitchPacker::getStatistics(PitchPackerStatistics *statistics)
+{
+    statistics->copies = atomicLoad(&copies);
+    statistics->bytes = atomicLoad(&bytes);
+    statistics->nanos = atomicLoad(&nanos);
+}
+
+/**
+ * Executes the given job, with the calling thread and the workers. The
+ * job is split into chunks, and the workers are only involved if there
+ * is more than one chunk. Other jobs are executed by the calling thread
+ * without taking the job mutex, so that they may run concurrently.
+ */
+void PitchPacker::execute(PitchJob *pitchJob)
+{
+    if (pitchJob->width == 0 || pitchJob->rows == 0)
+    {
+        return;
+    }
+    jcuda_int64 before = getNanoTime();
+    pitchJob->rowsPerChunk = PITCH_CHUNK_BYTES / pitchJob->width;
+    if (pitchJob->rowsPerChunk == 0)
+    {
+        pitchJob->rowsPerChunk = 1;
+    }
+    pitchJob->chunkCount = (int)((pitchJob->rows + pitchJob->rowsPerChunk - 1) / pitchJob->rowsPerChunk);
+    pitchJob->nextChunk = 0;
+
+    if (pitchJob->chunkCount == 1 || atomicLoad(&workerCount) == 0)
+    {
+        runJob(pitchJob);
+    }
+    else
+    {
+        MutexLock jobLock(jobMutex);
+        if (workers.empty())
+        {
+            runJob(pitchJob);
+        }
+        else
+        {
+            {
+                MutexLock lock(workerMutex);
+                job = pitchJob;
+                generation++;
+                workerCondition.broadcast();
+            }
+            runJob(pitchJob);
+
+            // All chunks have been taken, but may still be copied
+            MutexLock lock(workerMutex);
+            job = NULL;
+            while (activeWorkers > 0)
+            {
+                finishedCondition.wait(workerMutex);
+            }
+        }
+    }
+    atomicAdd(&copies, (jcuda_int64)1);
+    atomicAdd(&bytes, (jcuda_int64)(pitchJob->width * pitchJob->rows));
+    atomicAdd(&nanos, getNanoTime() - before);
+}
+
+/**
+ * Stops and deletes the worker threads. To be called while holding
+ * the job mutex.
+ */
+void PitchPacker::stopWorkers()
+{
+    workerCount = 0;
+    {
+        MutexLock lock(workerMutex);
+        stopping = true;
+        workerCondition.broadcast();
+    }
+    for (size_t i=0; i<workers.size(); i++)
+    {
+        if (workers[i]->isRunning())
+        {
+            workers[i]->join();
+        }
+        delete workers[i];
+    }
+    workers.clear();
+    MutexLock lock(workerMutex);
+    stopping = false;
+}
+
+/**
+ * The main loop of a worker: Takes part in each job that is posted,
+ * until the packer is stopped. A worker that wakes up after the job
+ * has been completed by the other threads ignores it.
+ */
+void PitchPacker::work()
+{
+    jcuda_int64 seen = 0;
+    while (true)
+    {
+        PitchJob *pitchJob = NULL;
+        {
+            MutexLock lock(workerMutex);
+            while (!stopping && (job == NULL || generation == seen))
+            {
+                workerCondition.wait(workerMutex);
+            }
+            if (stopping)
+            {
+                return;
+            }
+            seen = generation;
+            pitchJob = job;
+            activeWorkers++;
+        }
+        runJob(pitchJob);
+        MutexLock lock(workerMutex);
+        activeWorkers--;
+        if (activeWorkers == 0)
+        {
+            finishedCondition.broadcast();
+        }
+    }
+}
+
+void PitchPacker::runWorker(void *packer)
+{
+    ((PitchPacker*)packer)->work();
+}
@@ -0,0 +1,223 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PITCHPACKER
+#define PITCHPACKER
+
+#include <jni.h>
+#include <map>
+#include <vector>
+#include "Threading.hpp"
+
+/**
+ * The functions that are used by a PitchPacker, for the driver or the
+ * runtime API. Each function returns 0 on success, or the CUDA error
+ * code.
+ */
+struct PitchPackerFunctions
+{
+    /**
+     * Obtains the owner of the staging buffers of the calling thread:
+     * The current context, or a value that identifies the current
+     * device for the runtime API
+     */
+    int (*getOwner)(void **owner);
+
+    int (*allocHost)(void **pointer, size_t size);
+    int (*freeHost)(void *pointer);
+};
+
+
+/**
+ * Statistics about the copies that went through a PitchPacker
+ */
+struct PitchPackerStatistics
+{
+    /** The number of copies and bytes that have been packed or unpacked */
+    jcuda_int64 copies;
+    jcuda_int64 bytes;
+
+    /** The time that was spent for packing and unpacking, in nanoseconds */
+    jcuda_int64 nanos;
+};
+
+
+/**
+ * A page-locked staging buffer of a PitchPacker
+ */
+struct PitchStaging
+{
+    void *owner;
+    void *buffer;
+    size_t size;
+};
+
+
+struct PitchJob;
+
+/**
+ * A packer for 2D and 3D copies between pitched host memory, e.g. a
+ * Java array, and device memory. Instead of passing the pitched host
+ * memory to the CUDA API, which copies it row by row from pageable
+ * memory, the rows are gathered into a contiguous page-locked staging
+ * buffer, which is then copied with a single transfer. Copies into
+ * host memory are transferred into a staging buffer, and then
+ * scattered into the rows of the host memory.<br />
+ * <br />
+ * The rows are copied by the calling thread and a pool of worker
+ * threads. Rows that are packed into a staging buffer are written
+ * with non-temporal SSE2 stores where available, because the staging
+ * buffer is only read by the device.<br />
+ * <br />
+ * The staging buffers are created lazily for each owner, and kept
+ * until the owner is removed or the packer is disabled.
+ */
+class PitchPacker
+{
+    public:
+
+        /**
+         * Creates a new, disabled packer that uses the given functions
+         */
+        PitchPacker(PitchPackerFunctions functions);
+
+        /**
+         * Destroys this packer. The staging buffers have to be released
+         * with disable before.
+         */
+        ~PitchPacker();
+
+        /**
+         * Enables this packer, for copies that have at least the given
+         * number of bytes, using the given number of threads including
+         * the calling thread. If the number of threads is not positive,
+         * then the number of processors is used. Returns whether the
+         * worker threads could be started.
+         */
+        bool enable(int threadCount, size_t threshold);
+
+        /**
+         * Disables this packer, stops the worker threads, and releases
+         * all staging buffers
+         */
+        void disable();
+
+        /**
+         * Returns whether a copy of the given number of bytes should be
+         * packed
+         */
+        bool accepts(size_t bytes);
+
+        /**
+         * Acquires a staging buffer of at least the given size for the
+         * owner of the calling thread. Returns 0 on success, or the CUDA
+         * error code.
+         */
+        int acquire(size_t size, PitchStaging *staging);
+
+        /**
+         * Returns the given staging buffer, so that it may be reused
+         */
+        void release(PitchStaging *staging);
+
+        /**
+         * Packs the given number of slices, each consisting of the given
+         * number of rows of the given width in bytes, from the given
+         * pitched memory into the given contiguous staging memory. The
+         * source slices have the given number of rows of the given pitch.
+         */
+        void pack(void *dst, const void *src, size_t srcPitch, size_t srcHeight, size_t width, size_t height, size_t depth);
+
+        /**
+         * Unpacks the given number of slices, each consisting of the
+         * given number of rows of the given width in bytes, from the
+         * given contiguous staging memory into the given pitched memory.
+         * The destination slices have the given number of rows of the
+         * given pitch.
+         */
+        void unpack(void *dst, size_t dstPitch, size_t dstHeight, const void *src, size_t width, size_t height, size_t depth);
+
+        /**
+         * Releases the staging buffers of the given owner, e.g. before
+         * the context is destroyed or the device is reset
+         */
+        void removeOwner(void *owner);
+
+        /**
+         * Returns the current statistics of this packer
+         */
+        void getStatistics(PitchPackerStatistics *statistics);
+
+    private:
+
+        PitchPackerFunctions functions;
+
+        /** Guards the staging buffers */
+        Mutex mutex;
+
+        /** The configuration, which is read without the mutex */
+        volatile int enabled;
+        volatile jcuda_int64 threshold;
+
+        /** The free staging buffers, by owner */
+        std::map<void*, std::vector<PitchStaging> > stagings;
+
+        /**
+         * Serializes the jobs that are posted to the workers, and
+         * guards the list of workers
+         */
+        Mutex jobMutex;
+
+        /** The number of workers, which is read without the job mutex */
+        volatile int workerCount;
+
+        /** Guards the job and the state of the workers */
+        Mutex workerMutex;
+        ConditionVariable workerCondition;
+        ConditionVariable finishedCondition;
+        std::vector<Thread*> workers;
+        PitchJob *job;
+        jcuda_int64 generation;
+        int activeWorkers;
+        bool stopping;
+
+        /** Statistics */
+        volatile jcuda_int64 copies;
+        volatile jcuda_int64 bytes;
+        volatile jcuda_int64 nanos;
+
+        void execute(PitchJob *pitchJob);
+        void stopWorkers();
+        void work();
+        static void runWorker(void *packer);
+
+        PitchPacker(const PitchPacker&);
+        PitchPacker& operator=(const PitchPacker&);
+};
+
+
+#endif
@@ -299,6 +299,62 @@ bool isPointerBackedByNativeMemory(JNIEnv *env, jobject object)
 }
 
 
+/**
+ * Returns whether the given pointer object is a pointer to a
+ * buffer (which may be a direct buffer or a buffer that wraps
+ * a Java array) or to an array of pointers. Such a pointer
+ * always refers to host memory.
+ */
+bool isPointerBackedByBuffer(JNIEnv *env, jobject object)
+{
+    if (object == NULL)
+    {
+        return false;
+    }
+    jboolean isPointer = env->IsInstanceOf(object, Pointer_class);
+    if (!isPointer)
+    {
+        return false;
+    }
+    jobject buffer = env->GetObjectField(object, Pointer_buffer);
+    if (buffer != NULL)
+    {
+        return true;
+    }
+    jobject pointers = env->GetObjectField(object, Pointer_pointers);
+    return pointers != NULL;
+}
+
+
+/**
+ * Returns whether the given pointer object is a pointer to a
+ * buffer that is not direct, and thus wraps a Java array
+ */
+bool isPointerBackedByArray(JNIEnv *env, jobject object)
+{
+    if (object == NULL)
+    {
+        return false;
+    }
+    jboolean isPointer = env->IsInstanceOf(object, Pointer_class);
+    if (!isPointer)
+    {
+        return false;
+    }
+    jobject buffer = env->GetObjectField(object, Pointer_buffer);
+    if (buffer == NULL)
+    {
+        return false;
+    }
+    jboolean isDirect = env->CallBooleanMethod(buffer, Buffer_isDirect);
+    if (env->ExceptionCheck())
+    {
+        return false;
+    }
+    return isDirect != JNI_TRUE;
+}
+
+
 
 
 /**
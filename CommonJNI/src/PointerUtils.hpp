@@ -46,6 +46,8 @@ void* getPointer(JNIEnv *env, jobject pointerObject);
 bool isDirectByteBuffer(JNIEnv *env, jobject object);
 
 bool isPointerBackedByNativeMemory(JNIEnv *env, jobject object);
+bool isPointerBackedByBuffer(JNIEnv *env, jobject object);
+bool isPointerBackedByArray(JNIEnv *env, jobject object);
 
 int initPointerUtils(JNIEnv *env);
 
@@ -0,0 +1,773 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "RegistrationCache.hpp"
+#include "Logger.hpp"
+#include "PointerUtils.hpp"
+
+#include <algorithm>
+
+/**
+ * An event that is recorded after the asynchronous copies from or to
+ * a registered buffer in one stream
+ */
+struct RegistrationFence
+{
+    /** The device and owner of the event */
+    int device;
+    void *owner;
+
+    void *stream;
+    void *event;
+};
+
+
+/**
+ * A direct ByteBuffer that is tracked by a RegistrationCache
+ */
+struct RegistrationEntry
+{
+    /** The memory of the buffer */
+    char *start;
+    size_t size;
+
+    /** The weak global reference to the buffer */
+    jweak buffer;
+
+    /**
+     * The global reference to the buffer while it is registered, so
+     * that it is not collected while its memory is registered
+     */
+    jobject pinned;
+
+    /** The identifier of this entry, to validate tickets */
+    jcuda_int64 id;
+
+    /** The number of transfers since the buffer was (un)registered */
+    int transfers;
+
+    /** Whether the buffer was registered by the cache */
+    bool registered;
+
+    /**
+     * Whether the buffer has been evicted, and will be unregistered
+     * when its pending copies are complete
+     */
+    bool retired;
+
+    /**
+     * Whether the memory of the buffer was already registered by
+     * someone else, so that the cache does not have to register it
+     */
+    bool external;
+
+    /** Whether registering the buffer failed, so that it is not retried */
+    bool failed;
+
+    /** The device and owner of the registration */
+    int device;
+    void *owner;
+
+    /** The number of transfers that have been recorded but not completed */
+    int issuing;
+
+    /** The events of the asynchronous copies, one for each stream */
+    std::vector<RegistrationFence> fences;
+
+    /** The position of this entry in the usage list */
+    std::list<RegistrationEntry*>::iterator usagePosition;
+};
+
+
+RegistrationCache::RegistrationCache(RegistrationCacheFunctions functions, int alreadyRegisteredResult, int notReadyResult)
+{
+    this->functions = functions;
+    this->alreadyRegisteredResult = alreadyRegisteredResult;
+    this->notReadyResult = notReadyResult;
+    enabled = 0;
+    threshold = 1;
+    budget = 0;
+    byteBufferClass = NULL;
+    nextId = 1;
+    transfersSinceSweep = 0;
+    registeredCount = 0;
+    registeredBytes = 0;
+    hits = 0;
+    misses = 0;
+    evictions = 0;
+}
+
+RegistrationCache::~RegistrationCache()
+{
+    // The references are not deleted here, because there
+    // may not be a JNIEnv when the library is unloaded
+    std::map<char*, RegistrationEntry*>::iterator it;
+    for (it = entries.begin(); it != entries.end(); it++)
+    {
+        delete it->second;
+    }
+}
+
+bool RegistrationCache::enable(JNIEnv *env, int threshold, jcuda_int64 budget)
+{
+    MutexLock lock(mutex);
+    if (byteBufferClass == NULL)
+    {
+        jclass cls = env->FindClass("java/nio/ByteBuffer");
+        if (cls == NULL)
+        {
+            return false;
+        }
+        byteBufferClass = (jclass)env->NewGlobalRef(cls);
+        env->DeleteLocalRef(cls);
+        if (byteBufferClass == NULL)
+        {
+            return false;
+        }
+    }
+    this->threshold = threshold < 1 ? 1 : threshold;
+    this->budget = budget < 0 ? 0 : budget;
+
+    // Make room if the budget was reduced
+    evict(env, 0);
+    atomicCompareAndSwap(&enabled, 0, 1);
+
+    Logger::log(LOG_DEBUG, "Enabled registration cache with threshold %d and budget %ld\n",
+        this->threshold, (long)this->budget);
+    return true;
+}
+
+void RegistrationCache::disable(JNIEnv *env)
+{
+    MutexLock lock(mutex);
+    atomicCompareAndSwap(&enabled, 1, 0);
+    while (!usage.empty())
+    {
+        remove(env, usage.front(), true);
+    }
+}
+
+bool RegistrationCache::isEnabled()
+{
+    return atomicLoad(&enabled) != 0;
+}
+
+void RegistrationCache::recordTransfer(JNIEnv *env, jobject pointerObject, RegistrationTicket *ticket)
+{
+    ticket->start = NULL;
+    ticket->id = 0;
+    if (!isEnabled())
+    {
+        return;
+    }
+    jobject buffer = NULL;
+    char *start = NULL;
+    size_t size = 0;
+    if (!getBufferRange(env, pointerObject, &buffer, &start, &size))
+    {
+        return;
+    }
+
+    MutexLock lock(mutex);
+    if (!isEnabled())
+    {
+        env->DeleteLocalRef(buffer);
+        return;
+    }
+    transfersSinceSweep++;
+    if (transfersSinceSweep >= SWEEP_INTERVAL)
+    {
+        sweep(env);
+    }
+
+    RegistrationEntry *entry = findContaining(start, size);
+    if (entry != NULL && env->IsSameObject(entry->buffer, NULL))
+    {
+        // The buffer of the entry has been collected, and its
+        // memory is now used by another buffer
+        remove(env, entry, true);
+        entry = NULL;
+    }
+    if (entry == NULL)
+    {
+        if (!removeOverlapping(env, start, size))
+        {
+            // The buffer overlaps a registered one, but is not
+            // contained in it, so it may not be registered
+            env->DeleteLocalRef(buffer);
+            misses++;
+            return;
+        }
+        jweak weakBuffer = env->NewWeakGlobalRef(buffer);
+        env->DeleteLocalRef(buffer);
+        if (weakBuffer == NULL)
+        {
+            return;
+        }
+        entry = new RegistrationEntry();
+        entry->start = start;
+        entry->size = size;
+        entry->buffer = weakBuffer;
+        entry->pinned = NULL;
+        entry->id = nextId++;
+        entry->transfers = 0;
+        entry->registered = false;
+        entry->retired = false;
+        entry->external = false;
+        entry->failed = false;
+        entry->device = -1;
+        entry->owner = NULL;
+        entry->issuing = 0;
+        entries[start] = entry;
+        usage.push_front(entry);
+        entry->usagePosition = usage.begin();
+        trim(env);
+    }
+    else
+    {
+        env->DeleteLocalRef(buffer);
+        usage.splice(usage.begin(), usage, entry->usagePosition);
+    }
+
+    if (entry->external)
+    {
+        hits++;
+        return;
+    }
+    if (entry->registered && !entry->retired)
+    {
+        hits++;
+    }
+    else
+    {
+        // A retired buffer is registered again after it has
+        // been unregistered
+        misses++;
+        if (!entry->registered)
+        {
+            entry->transfers++;
+            if (!entry->failed && entry->transfers >= threshold)
+            {
+                registerEntry(env, entry);
+            }
+        }
+    }
+    if (entry->registered)
+    {
+        entry->issuing++;
+        ticket->start = entry->start;
+        ticket->id = entry->id;
+    }
+}
+
+void RegistrationCache::completeTransfer(RegistrationTicket *ticket, void *stream, bool asynchronous)
+{
+    if (ticket->start == NULL)
+    {
+        return;
+    }
+    MutexLock lock(mutex);
+    std::map<char*, RegistrationEntry*>::iterator it = entries.find(ticket->start);
+    if (it == entries.end() || it->second->id != ticket->id)
+    {
+        // The entry has been removed in the meantime
+        return;
+    }
+    RegistrationEntry *entry = it->second;
+    entry->issuing--;
+    if (!asynchronous || !entry->registered)
+    {
+        return;
+    }
+
+    int device = -1;
+    void *owner = NULL;
+    int result = functions.getOwner(&device, &owner);
+    if (result != 0)
+    {
+        Logger::log(LOG_ERROR, "Could not obtain the owner of the event for buffer %p, error %d\n",
+            entry->start, result);
+        return;
+    }
+    RegistrationFence *fence = NULL;
+    for (size_t i=0; i<entry->fences.size(); i++)
+    {
+        RegistrationFence &f = entry->fences[i];
+        if (f.device == device && f.owner == owner && f.stream == stream)
+        {
+            fence = &f;
+            break;
+        }
+    }
+    if (fence == NULL)
+    {
+        void *event = NULL;
+        result = functions.createEvent(&event);
+        if (result != 0)
+        {
+            Logger::log(LOG_ERROR, "Could not create event for buffer %p, error %d\n",
+                entry->start, result);
+            return;
+        }
+        RegistrationFence newFence;
+        newFence.device = device;
+        newFence.owner = owner;
+        newFence.stream = stream;
+        newFence.event = event;
+        entry->fences.push_back(newFence);
+        fence = &entry->fences.back();
+    }
+    result = functions.recordEvent(fence->event, stream);
+    if (result != 0)
+    {
+        Logger::log(LOG_ERROR, "Could not record event for buffer %p, error %d\n",
+            entry->start, result);
+    }
+}
+
+void RegistrationCache::release(JNIEnv *env, jobject pointerObject)
+{
+    jobject buffer = NULL;
+    char *start = NULL;
+    size_t size = 0;
+    if (byteBufferClass == NULL || !getBufferRange(env, pointerObject, &buffer, &start, &size))
+    {
+        return;
+    }
+    env->DeleteLocalRef(buffer);
+
+    MutexLock lock(mutex);
+    std::map<char*, RegistrationEntry*>::iterator it = entries.find(start);
+    if (it != entries.end() && it->second->size == size)
+    {
+        remove(env, it->second, true);
+    }
+}
+
+void RegistrationCache::removeOwner(JNIEnv *env, void *owner)
+{
+    MutexLock lock(mutex);
+    std::vector<RegistrationEntry*> removed;
+    std::list<RegistrationEntry*>::iterator it;
+    for (it = usage.begin(); it != usage.end(); it++)
+    {
+        dropEvents(*it, -1, owner);
+        if ((*it)->registered && (*it)->owner == owner)
+        {
+            removed.push_back(*it);
+        }
+    }
+    for (size_t i=0; i<removed.size(); i++)
+    {
+        remove(env, removed[i], false);
+    }
+}
+
+void RegistrationCache::removeDevice(JNIEnv *env, int device)
+{
+    MutexLock lock(mutex);
+    std::vector<RegistrationEntry*> removed;
+    std::list<RegistrationEntry*>::iterator it;
+    for (it = usage.begin(); it != usage.end(); it++)
+    {
+        dropEvents(*it, device, NULL);
+        if ((*it)->registered && (*it)->device == device)
+        {
+            removed.push_back(*it);
+        }
+    }
+    for (size_t i=0; i<removed.size(); i++)
+    {
+        remove(env, removed[i], false);
+    }
+}
+
+void RegistrationCache::getStatistics(RegistrationCacheStatistics *statistics)
+{
+    MutexLock lock(mutex);
+    statistics->registeredCount = registeredCount;
+    statistics->registeredBytes = registeredBytes;
+    statistics->hits = hits;
+    statistics->misses = misses;
+    statistics->evictions = evictions;
+}
+
+
+/**
+ * Obtains the memory of the direct ByteBuffer that the given Java
+ * Pointer object refers to. Returns whether the pointer refers to
+ * a direct ByteBuffer. If so, the given buffer will be a local
+ * reference that has to be deleted by the caller.
+ */
+bool RegistrationCache::getBufferRange(JNIEnv *env, jobject pointerObject, jobject *buffer, char **start, size_t *size)
+{
+    if (pointerObject == NULL || !env->IsInstanceOf(pointerObject, Pointer_class))
+    {
+        return false;
+    }
+    jobject bufferObject = env->GetObjectField(pointerObject, Pointer_buffer);
+    if (bufferObject == NULL)
+    {
+        return false;
+    }
+    if (env->IsInstanceOf(bufferObject, byteBufferClass))
+    {
+        void *address = env->GetDirectBufferAddress(bufferObject);
+        jlong capacity = env->GetDirectBufferCapacity(bufferObject);
+        if (address != NULL && capacity > 0)
+        {
+            *buffer = bufferObject;
+            *start = (char*)address;
+            *size = (size_t)capacity;
+            return true;
+        }
+    }
+    env->DeleteLocalRef(bufferObject);
+    return false;
+}
+
+/**
+ * Returns the entry that contains the given range. Since the entries
+ * do not overlap, this can only be the last one that starts at or
+ * before the given range.
+ */
+RegistrationEntry* RegistrationCache::findContaining(char *start, size_t size)
+{
+    std::map<char*, RegistrationEntry*>::iterator it = entries.upper_bound(start);
+    if (it == entries.begin())
+    {
+        return NULL;
+    }
+    it--;
+    RegistrationEntry *entry = it->second;
+    if (entry->start + entry->size >= start + size)
+    {
+        return entry;
+    }
+    return NULL;
+}
+
+/**
+ * Removes all entries that overlap the given range, unless one of them
+ * refers to registered memory. Since registered buffers are pinned,
+ * this can only be memory of a buffer that was not collected yet.
+ * Returns whether the entries have been removed.
+ */
+bool RegistrationCache::removeOverlapping(JNIEnv *env, char *start, size_t size)
+{
+    std::vector<RegistrationEntry*> overlapping;
+    std::map<char*, RegistrationEntry*>::iterator it = entries.lower_bound(start);
+    if (it != entries.begin())
+    {
+        std::map<char*, RegistrationEntry*>::iterator previous = it;
+        previous--;
+        if (previous->second->start + previous->second->size > start)
+        {
+            overlapping.push_back(previous->second);
+        }
+    }
+    while (it != entries.end() && it->first < start + size)
+    {
+        overlapping.push_back(it->second);
+        it++;
+    }
+    for (size_t i=0; i<overlapping.size(); i++)
+    {
+        RegistrationEntry *entry = overlapping[i];
+        if (entry->registered || (entry->external && !env->IsSameObject(entry->buffer, NULL)))
+        {
+            return false;
+        }
+    }
+    for (size_t i=0; i<overlapping.size(); i++)
+    {
+        remove(env, overlapping[i], true);
+    }
+    return true;
+}
+
+/**
+ * Registers the memory of the given entry, if it fits into the budget
+ * after evicting the least recently used buffers, and pins its buffer
+ */
+void RegistrationCache::registerEntry(JNIEnv *env, RegistrationEntry *entry)
+{
+    if ((jcuda_int64)entry->size > budget || !evict(env, entry->size))
+    {
+        return;
+    }
+    jobject pinned = env->NewGlobalRef(entry->buffer);
+    if (pinned == NULL)
+    {
+        // The buffer has been collected
+        return;
+    }
+    int result = functions.registerHost(entry->start, entry->size, &entry->device, &entry->owner);
+    if (result == 0)
+    {
+        entry->pinned = pinned;
+        entry->registered = true;
+        registeredCount++;
+        registeredBytes += entry->size;
+        Logger::log(LOG_DEBUG, "Registered buffer %p of %ld bytes after %d transfers\n",
+            entry->start, (long)entry->size, entry->transfers);
+        return;
+    }
+    env->DeleteGlobalRef(pinned);
+    if (result == alreadyRegisteredResult)
+    {
+        entry->external = true;
+    }
+    else
+    {
+        entry->failed = true;
+        Logger::log(LOG_DEBUG, "Could not register buffer %p of %ld bytes, error %d\n",
+            entry->start, (long)entry->size, result);
+    }
+}
+
+/**
+ * Retires the least recently used buffers until the given number of
+ * bytes may be registered without exceeding the budget, once the
+ * retired buffers have been unregistered. Returns whether the given
+ * number of bytes may be registered now.
+ */
+bool RegistrationCache::evict(JNIEnv *env, size_t size)
+{
+    if (registeredBytes + (jcuda_int64)size <= budget)
+    {
+        return true;
+    }
+    reap(env);
+    if (registeredBytes + (jcuda_int64)size <= budget)
+    {
+        return true;
+    }
+
+    // The bytes of the retired buffers are released when their
+    // pending copies are complete
+    jcuda_int64 remainingBytes = registeredBytes;
+    for (size_t i=0; i<retired.size(); i++)
+    {
+        remainingBytes -= retired[i]->size;
+    }
+    std::vector<RegistrationEntry*> victims;
+    if (remainingBytes + (jcuda_int64)size > budget)
+    {
+        std::list<RegistrationEntry*>::reverse_iterator it;
+        for (it = usage.rbegin(); it != usage.rend(); it++)
+        {
+            if ((*it)->registered && !(*it)->retired)
+            {
+                victims.push_back(*it);
+                remainingBytes -= (*it)->size;
+                if (remainingBytes + (jcuda_int64)size <= budget)
+                {
+                    break;
+                }
+            }
+        }
+        if (remainingBytes + (jcuda_int64)size > budget)
+        {
+            return false;
+        }
+    }
+    for (size_t i=0; i<victims.size(); i++)
+    {
+        victims[i]->retired = true;
+        retired.push_back(victims[i]);
+        evictions++;
+    }
+    reap(env);
+    return registeredBytes + (jcuda_int64)size <= budget;
+}
+
+/**
+ * Unregisters the retired buffers whose pending copies are complete
+ */
+void RegistrationCache::reap(JNIEnv *env)
+{
+    size_t i = 0;
+    while (i < retired.size())
+    {
+        if (isIdle(retired[i]))
+        {
+            // This removes the entry from the retired entries
+            unregister(env, retired[i], true);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+/**
+ * Returns whether there are no pending copies from or to the buffer
+ * of the given entry
+ */
+bool RegistrationCache::isIdle(RegistrationEntry *entry)
+{
+    if (entry->issuing > 0)
+    {
+        return false;
+    }
+    for (size_t i=0; i<entry->fences.size(); i++)
+    {
+        if (functions.queryEvent(entry->fences[i].event) == notReadyResult)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Unregisters the retired buffers whose copies are complete, and
+ * removes all entries whose buffers have been garbage collected.
+ * These can only be entries that are not registered.
+ */
+void RegistrationCache::sweep(JNIEnv *env)
+{
+    transfersSinceSweep = 0;
+    reap(env);
+    std::vector<RegistrationEntry*> collected;
+    std::list<RegistrationEntry*>::iterator it;
+    for (it = usage.begin(); it != usage.end(); it++)
+    {
+        if (env->IsSameObject((*it)->buffer, NULL))
+        {
+            collected.push_back(*it);
+        }
+    }
+    for (size_t i=0; i<collected.size(); i++)
+    {
+        remove(env, collected[i], true);
+    }
+}
+
+/**
+ * Removes the least recently used entries that are not registered,
+ * until the number of entries does not exceed MAX_ENTRIES
+ */
+void RegistrationCache::trim(JNIEnv *env)
+{
+    std::list<RegistrationEntry*>::iterator it = usage.end();
+    while (entries.size() > MAX_ENTRIES && it != usage.begin())
+    {
+        it--;
+        if (it == usage.begin())
+        {
+            // The most recently used entry is always kept
+            break;
+        }
+        RegistrationEntry *entry = *it;
+        if (!entry->registered)
+        {
+            it++;
+            remove(env, entry, false);
+        }
+    }
+}
+
+/**
+ * Unregisters the memory of the given registered entry, which stays
+ * in the cache, and unpins its buffer. If the registration is valid,
+ * then the pending copies are waited for before. Otherwise, e.g. when
+ * its context has been destroyed, only the bookkeeping is updated.
+ */
+void RegistrationCache::unregister(JNIEnv *env, RegistrationEntry *entry, bool valid)
+{
+    for (size_t i=0; i<entry->fences.size(); i++)
+    {
+        if (valid)
+        {
+            functions.synchronizeEvent(entry->fences[i].event);
+        }
+        functions.destroyEvent(entry->fences[i].event);
+    }
+    entry->fences.clear();
+    if (valid)
+    {
+        int result = functions.unregisterHost(entry->start);
+        if (result != 0)
+        {
+            Logger::log(LOG_DEBUG, "Could not unregister buffer %p, error %d\n", entry->start, result);
+        }
+    }
+    if (entry->retired)
+    {
+        retired.erase(std::find(retired.begin(), retired.end(), entry));
+        entry->retired = false;
+    }
+    env->DeleteGlobalRef(entry->pinned);
+    entry->pinned = NULL;
+    entry->registered = false;
+    entry->transfers = 0;
+    registeredCount--;
+    registeredBytes -= entry->size;
+}
+
+/**
+ * Discards the events of the given entry that belong to the given
+ * owner, or to the given device if the owner is NULL, without
+ * destroying them, because they have been invalidated
+ */
+void RegistrationCache::dropEvents(RegistrationEntry *entry, int device, void *owner)
+{
+    std::vector<RegistrationFence> &fences = entry->fences;
+    size_t i = 0;
+    while (i < fences.size())
+    {
+        bool dropped = owner != NULL ? fences[i].owner == owner : fences[i].device == device;
+        if (dropped)
+        {
+            fences.erase(fences.begin() + i);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+/**
+ * Removes the given entry from this cache. If it is registered, then
+ * it is unregistered, after its pending copies are complete if the
+ * given flag is set, or only in the bookkeeping otherwise.
+ */
+void RegistrationCache::remove(JNIEnv *env, RegistrationEntry *entry, bool unregister)
+{
+    if (entry->registered)
+    {
+        this->unregister(env, entry, unregister);
+    }
+    entries.erase(entry->start);
+    usage.erase(entry->usagePosition);
+    env->DeleteWeakGlobalRef(entry->buffer);
+    delete entry;
+}
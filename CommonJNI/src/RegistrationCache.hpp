@@ -0,0 +1,336 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REGISTRATIONCACHE
+#define REGISTRATIONCACHE
+
+#include <jni.h>
+#include <list>
+#include <map>
+#include <vector>
+#include "Threading.hpp"
+
+/**
+ * The functions that are used by a RegistrationCache, for the driver
+ * or the runtime API. Each function returns 0 on success, or the CUDA
+ * error code. Streams and events are the CUstream/cudaStream_t and
+ * CUevent/cudaEvent_t handles.
+ */
+struct RegistrationCacheFunctions
+{
+    /**
+     * Registers the given range of host memory as page-locked memory
+     * that may be used in all contexts, e.g. with cuMemHostRegister
+     * or cudaHostRegister, and stores the device and the owner (the
+     * context, or NULL for the runtime API) that the registration
+     * belongs to
+     */
+    int (*registerHost)(void *pointer, size_t size, int *device, void **owner);
+
+    /**
+     * Unregisters a range that was registered with registerHost
+     */
+    int (*unregisterHost)(void *pointer);
+
+    /**
+     * Obtains the device and the owner (the context, or NULL for the
+     * runtime API) that the events created by the calling thread
+     * belong to
+     */
+    int (*getOwner)(int *device, void **owner);
+
+    int (*createEvent)(void **event);
+    int (*destroyEvent)(void *event);
+    int (*recordEvent)(void *event, void *stream);
+
+    /**
+     * Returns 0 if the event is complete, the "not ready" code that was
+     * given to the RegistrationCache if it is not, or an error code
+     */
+    int (*queryEvent)(void *event);
+
+    int (*synchronizeEvent)(void *event);
+};
+
+
+/**
+ * Statistics about the state of a RegistrationCache
+ */
+struct RegistrationCacheStatistics
+{
+    /** The number of buffers that are currently registered */
+    jcuda_int64 registeredCount;
+
+    /** The number of bytes that are currently registered */
+    jcuda_int64 registeredBytes;
+
+    /** The number of transfers that used a registered buffer */
+    jcuda_int64 hits;
+
+    /** The number of transfers that used a buffer that was not registered */
+    jcuda_int64 misses;
+
+    /** The number of buffers that have been unregistered to meet the budget */
+    jcuda_int64 evictions;
+};
+
+
+/**
+ * Identifies a transfer from or to a buffer that is registered by a
+ * RegistrationCache, between recordTransfer and completeTransfer
+ */
+struct RegistrationTicket
+{
+    /** The start of the buffer, or NULL if it is not registered */
+    char *start;
+
+    /** The identifier of the entry of the buffer */
+    jcuda_int64 id;
+};
+
+
+struct RegistrationEntry;
+
+/**
+ * A cache that registers direct ByteBuffers that are used for copies
+ * between host and device memory as page-locked memory, so that these
+ * copies may use the full DMA bandwidth, and asynchronous copies are
+ * really asynchronous.<br />
+ * <br />
+ * The transfers of each direct ByteBuffer are counted. When a buffer
+ * has been used for the given number of transfers, its whole memory is
+ * registered. Copies from or to slices of a buffer that is registered
+ * are counted as hits. The registered buffers are kept in the order in
+ * which they have been used, and when the registered memory would
+ * exceed the budget, the least recently used buffers are evicted.<br />
+ * <br />
+ * After each asynchronous copy from or to a registered buffer, an
+ * event of the buffer is recorded in the stream of the copy, with one
+ * event for each stream that the buffer is used in. An evicted buffer
+ * is only unregistered when all its events are complete, so neither
+ * the device nor the calling thread has to be synchronized. Until
+ * then, the evicted buffer still counts towards the budget, and the
+ * buffer that should be registered is registered with a later
+ * transfer.<br />
+ * <br />
+ * A registered buffer is referred to with a global reference, so that
+ * it can not be garbage collected while its memory is registered.
+ * All other buffers are only referred to with weak references, and
+ * are removed when they have been collected. Buffers may also be
+ * released explicitly, e.g. before their memory is freed.
+ */
+class RegistrationCache
+{
+    public:
+
+        /**
+         * Creates a new, disabled cache that uses the given functions.
+         * The given results are the error code that is returned by the
+         * registerHost function when the memory is already registered,
+         * and the error code that is returned by the queryEvent
+         * function for events that are not complete.
+         */
+        RegistrationCache(RegistrationCacheFunctions functions, int alreadyRegisteredResult, int notReadyResult);
+
+        /**
+         * Destroys this cache. The memory that is still registered
+         * is not unregistered.
+         */
+        ~RegistrationCache();
+
+        /**
+         * Enables this cache, or updates its parameters if it is already
+         * enabled. Buffers are registered after they have been used for
+         * the given number of transfers, as long as the total number
+         * of registered bytes does not exceed the given budget.
+         * Returns false if the ByteBuffer class could not be found,
+         * with a pending exception.
+         */
+        bool enable(JNIEnv *env, int threshold, jcuda_int64 budget);
+
+        /**
+         * Disables this cache, and unregisters all buffers after their
+         * pending copies have been completed
+         */
+        void disable(JNIEnv *env);
+
+        /**
+         * Returns whether this cache is enabled
+         */
+        bool isEnabled();
+
+        /**
+         * Records a transfer from or to the given Java Pointer object.
+         * To be called before the copy is issued. If the pointer refers
+         * to a direct ByteBuffer that becomes hot with this transfer,
+         * then the buffer is registered. If the buffer is registered,
+         * then it is not unregistered until the transfer is completed
+         * with completeTransfer, using the given ticket.
+         */
+        void recordTransfer(JNIEnv *env, jobject pointerObject, RegistrationTicket *ticket);
+
+        /**
+         * Completes the transfer with the given ticket. To be called
+         * after the copy was issued. If the copy is asynchronous, then
+         * the event of the buffer for the given stream is recorded.
+         */
+        void completeTransfer(RegistrationTicket *ticket, void *stream, bool asynchronous);
+
+        /**
+         * Unregisters the direct ByteBuffer that the given Java Pointer
+         * object refers to, if it was registered by this cache, after
+         * its pending copies have been completed
+         */
+        void release(JNIEnv *env, jobject pointerObject);
+
+        /**
+         * Removes the buffers whose registration belongs to the given
+         * owner, without unregistering them, because the registration
+         * has been invalidated, e.g. by destroying the context. The
+         * events of the owner are discarded without destroying them.
+         */
+        void removeOwner(JNIEnv *env, void *owner);
+
+        /**
+         * Removes the buffers whose registration belongs to the given
+         * device, without unregistering them, e.g. when the device is
+         * reset. The events of the device are discarded without
+         * destroying them.
+         */
+        void removeDevice(JNIEnv *env, int device);
+
+        /**
+         * Returns the current statistics of this cache
+         */
+        void getStatistics(RegistrationCacheStatistics *statistics);
+
+    private:
+
+        /** The maximum number of buffers that are tracked, registered or not */
+        static const size_t MAX_ENTRIES = 4096;
+
+        /** The number of transfers after which the buffers are checked for collection */
+        static const int SWEEP_INTERVAL = 256;
+
+        RegistrationCacheFunctions functions;
+        int alreadyRegisteredResult;
+        int notReadyResult;
+
+        /** Guards all members except for the 'enabled' flag */
+        Mutex mutex;
+
+        volatile int enabled;
+        int threshold;
+        jcuda_int64 budget;
+
+        /** The global reference to the java.nio.ByteBuffer class */
+        jclass byteBufferClass;
+
+        /** The entries, by their start address */
+        std::map<char*, RegistrationEntry*> entries;
+
+        /** The entries, the most recently used first */
+        std::list<RegistrationEntry*> usage;
+
+        /** The entries that have been evicted, but are still registered */
+        std::vector<RegistrationEntry*> retired;
+
+        /** The identifier for the next entry */
+        jcuda_int64 nextId;
+
+        int transfersSinceSweep;
+
+        /** Statistics */
+        jcuda_int64 registeredCount;
+        jcuda_int64 registeredBytes;
+        jcuda_int64 hits;
+        jcuda_int64 misses;
+        jcuda_int64 evictions;
+
+        bool getBufferRange(JNIEnv *env, jobject pointerObject, jobject *buffer, char **start, size_t *size);
+        RegistrationEntry* findContaining(char *start, size_t size);
+        bool removeOverlapping(JNIEnv *env, char *start, size_t size);
+        void registerEntry(JNIEnv *env, RegistrationEntry *entry);
+        bool evict(JNIEnv *env, size_t size);
+        void reap(JNIEnv *env);
+        bool isIdle(RegistrationEntry *entry);
+        void sweep(JNIEnv *env);
+        void trim(JNIEnv *env);
+        void unregister(JNIEnv *env, RegistrationEntry *entry, bool valid);
+        void dropEvents(RegistrationEntry *entry, int device, void *owner);
+        void remove(JNIEnv *env, RegistrationEntry *entry, bool unregister);
+
+        RegistrationCache(const RegistrationCache&);
+        RegistrationCache& operator=(const RegistrationCache&);
+};
+
+
+/**
+ * A transfer from or to a Java Pointer object that is recorded in a
+ * RegistrationCache when it is created, and completed when it is
+ * destroyed. If the copy is asynchronous, then issued has to be
+ * called with the stream after the copy was issued.
+ */
+class RegistrationTransfer
+{
+    public:
+
+        RegistrationTransfer(RegistrationCache &cache, JNIEnv *env, jobject pointerObject) : cache(cache)
+        {
+            stream = NULL;
+            asynchronous = false;
+            cache.recordTransfer(env, pointerObject, &ticket);
+        }
+
+        ~RegistrationTransfer()
+        {
+            cache.completeTransfer(&ticket, stream, asynchronous);
+        }
+
+        /**
+         * Marks the copy as an asynchronous copy that was issued in
+         * the given stream
+         */
+        void issued(void *stream)
+        {
+            this->stream = stream;
+            asynchronous = true;
+        }
+
+    private:
+
+        RegistrationCache &cache;
+        RegistrationTicket ticket;
+        void *stream;
+        bool asynchronous;
+
+        RegistrationTransfer(const RegistrationTransfer&);
+        RegistrationTransfer& operator=(const RegistrationTransfer&);
+};
+
+
+#endif
@@ -0,0 +1,241 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "SharedMemory.hpp"
+#include <string>
+
+#ifndef _WIN32
+#  include <errno.h>
+#  include <fcntl.h>
+#  include <signal.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#endif
+
+/**
+ * The number of attempts to wait for the creator of a segment to
+ * set its size, and the time between the attempts, in microseconds
+ */
+#define SHARED_MEMORY_OPEN_ATTEMPTS 1000
+#define SHARED_MEMORY_OPEN_INTERVAL 1000
+
+
+SharedMemory::SharedMemory()
+{
+    pointer = NULL;
+    size = 0;
+#ifdef _WIN32
+    handle = NULL;
+#endif
+}
+
+SharedMemory::~SharedMemory()
+{
+    close();
+}
+
+void* SharedMemory::getPointer()
+{
+    return pointer;
+}
+
+size_t SharedMemory::getSize()
+{
+    return size;
+}
+
+#ifdef _WIN32
+
+int SharedMemory::open(const char *name, size_t size, bool *created)
+{
+    close();
+    std::string mappingName = std::string("Local\\") + name;
+    jcuda_int64 size64 = (jcuda_int64)size;
+    handle = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+        (DWORD)(size64 >> 32), (DWORD)(size64 & 0xFFFFFFFF), mappingName.c_str());
+    if (handle == NULL)
+    {
+        return (int)GetLastError();
+    }
+    *created = (GetLastError() != ERROR_ALREADY_EXISTS);
+    pointer = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (pointer == NULL)
+    {
+        int error = (int)GetLastError();
+        CloseHandle(handle);
+        handle = NULL;
+        return error;
+    }
+    MEMORY_BASIC_INFORMATION info;
+    VirtualQuery(pointer, &info, sizeof(info));
+    this->size = (size_t)info.RegionSize;
+    return 0;
+}
+
+void SharedMemory::close()
+{
+    if (pointer != NULL)
+    {
+        UnmapViewOfFile(pointer);
+        pointer = NULL;
+    }
+    if (handle != NULL)
+    {
+        CloseHandle(handle);
+        handle = NULL;
+    }
+    size = 0;
+}
+
+void SharedMemory::unlink(const char *name)
+{
+}
+
+int SharedMemory::getProcessId()
+{
+    return (int)GetCurrentProcessId();
+}
+
+bool SharedMemory::isProcessAlive(int processId)
+{
+    HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, (DWORD)processId);
+    if (process == NULL)
+    {
+        return GetLastError() == ERROR_ACCESS_DENIED;
+    }
+    bool alive = (WaitForSingleObject(process, 0) == WAIT_TIMEOUT);
+    CloseHandle(process);
+    return alive;
+}
+
+#else
+
+/**
+ * Returns the POSIX name for the given segment name, which has
+ * to start with a slash
+ */
+static std::string getPosixName(const char *name)
+{
+    if (name[0] == '/')
+    {
+        return std::string(name);
+    }
+    return std::string("/") + name;
+}
+
+int SharedMemory::open(const char *name, size_t size, bool *created)
+{
+    close();
+    std::string posixName = getPosixName(name);
+    *created = true;
+    int fd = shm_open(posixName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd == -1 && errno == EEXIST)
+    {
+        *created = false;
+        fd = shm_open(posixName.c_str(), O_RDWR, 0600);
+    }
+    if (fd == -1)
+    {
+        return errno;
+    }
+    if (*created)
+    {
+        if (ftruncate(fd, (off_t)size) == -1)
+        {
+            int error = errno;
+            ::close(fd);
+            shm_unlink(posixName.c_str());
+            return error;
+        }
+    }
+    else
+    {
+        // Wait until the creator has set the size of the segment
+        struct stat info;
+        info.st_size = 0;
+        for (int i=0; i<SHARED_MEMORY_OPEN_ATTEMPTS; i++)
+        {
+            if (fstat(fd, &info) == -1)
+            {
+                int error = errno;
+                ::close(fd);
+                return error;
+            }
+            if (info.st_size > 0)
+            {
+                break;
+            }
+            Thread::sleepMicros(SHARED_MEMORY_OPEN_INTERVAL);
+        }
+        if (info.st_size == 0)
+        {
+            ::close(fd);
+            return ETIMEDOUT;
+        }
+        size = (size_t)info.st_size;
+    }
+    void *p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    int error = errno;
+    ::close(fd);
+    if (p == MAP_FAILED)
+    {
+        return error;
+    }
+    pointer = p;
+    this->size = size;
+    return 0;
+}
+
+void SharedMemory::close()
+{
+    if (pointer != NULL)
+    {
+        munmap(pointer, size);
+        pointer = NULL;
+    }
+    size = 0;
+}
+
+void SharedMemory::unlink(const char *name)
+{
+    std::string posixName = getPosixName(name);
+    shm_unlink(posixName.c_str());
+}
+
+int SharedMemory::getProcessId()
+{
+    return (int)getpid();
+}
+
+bool SharedMemory::isProcessAlive(int processId)
+{
+    // A process that may not be signalled still exists
+    return kill((pid_t)processId, 0) == 0 || errno == EPERM;
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef SHAREDMEMORY
+#define SHAREDMEMORY
+
+#include "Threading.hpp"
+
+/**
+ * A named segment of memory that is shared between the processes
+ * of one node. On Windows, this is a file mapping that is backed by
+ * the paging file. Otherwise, it is a POSIX shared memory object.
+ */
+class SharedMemory
+{
+    public:
+        SharedMemory();
+
+        /**
+         * Unmaps the segment if it is still mapped
+         */
+        ~SharedMemory();
+
+        /**
+         * Opens the segment with the given name, or creates it with
+         * the given size if it does not exist yet. The memory of a new
+         * segment is filled with zeros. Whether the segment was created
+         * is stored in the given flag. Returns 0 on success, and the
+         * error code of the operating system otherwise.<br />
+         * <br />
+         * A process that opens an existing segment may see it before
+         * the creator has initialized its contents, so the contents
+         * should contain a marker that is written last.
+         */
+        int open(const char *name, size_t size, bool *created);
+
+        /**
+         * Unmaps the segment. The segment itself persists until it
+         * is removed with unlink.
+         */
+        void close();
+
+        void* getPointer();
+        size_t getSize();
+
+        /**
+         * Removes the name of the segment with the given name, so that
+         * it is destroyed when all processes have unmapped it. This has
+         * no effect on Windows, where the segment is destroyed
+         * when the last handle is closed.
+         */
+        static void unlink(const char *name);
+
+        /**
+         * Returns the ID of the calling process
+         */
+        static int getProcessId();
+
+        /**
+         * Returns whether the process with the given ID exists
+         */
+        static bool isProcessAlive(int processId);
+
+    private:
+        void *pointer;
+        size_t size;
+
+#ifdef _WIN32
+        HANDLE handle;
+#endif
+
+        SharedMemory(const SharedMemory&);
+        SharedMemory& operator=(const SharedMemory&);
+};
+
+
+#endif
@@ -0,0 +1,346 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "Threading.hpp"
+
+#ifndef _WIN32
+#  include <errno.h>
+#  include <sched.h>
+#  include <time.h>
+#  include <unistd.h>
+#  include <sys/time.h>
+#  if defined (__APPLE__) || defined(MACOSX)
+#    include <mach/mach_time.h>
+#  endif
+#endif
+
+
+//=== Mutex ==================================================================
+
+#ifdef _WIN32
+
+Mutex::Mutex()            { InitializeCriticalSection(&handle); }
+Mutex::~Mutex()           { DeleteCriticalSection(&handle); }
+void Mutex::lock()        { EnterCriticalSection(&handle); }
+void Mutex::unlock()      { LeaveCriticalSection(&handle); }
+bool Mutex::tryLock()     { return TryEnterCriticalSection(&handle) != 0; }
+
+#else
+
+Mutex::Mutex()            { pthread_mutex_init(&handle, NULL); }
+Mutex::~Mutex()           { pthread_mutex_destroy(&handle); }
+void Mutex::lock()        { pthread_mutex_lock(&handle); }
+void Mutex::unlock()      { pthread_mutex_unlock(&handle); }
+bool Mutex::tryLock()     { return pthread_mutex_trylock(&handle) == 0; }
+
+#endif
+
+
+//=== ConditionVariable ======================================================
+
+#ifdef _WIN32
+
+ConditionVariable::ConditionVariable()
+{
+    InitializeConditionVariable(&handle);
+}
+
+ConditionVariable::~ConditionVariable()
+{
+}
+
+void ConditionVariable::wait(Mutex &mutex)
+{
+    SleepConditionVariableCS(&handle, &mutex.handle, INFINITE);
+}
+
+bool ConditionVariable::wait(Mutex &mutex, long milliseconds)
+{
+    return SleepConditionVariableCS(&handle, &mutex.handle, (DWORD)milliseconds) != 0;
+}
+
+bool ConditionVariable::waitMicros(Mutex &mutex, long micros)
+{
+    return wait(mutex, (micros + 999) / 1000);
+}
+
+void ConditionVariable::signal()
+{
+    WakeConditionVariable(&handle);
+}
+
+void ConditionVariable::broadcast()
+{
+    WakeAllConditionVariable(&handle);
+}
+
+#else
+
+ConditionVariable::ConditionVariable()
+{
+    pthread_cond_init(&handle, NULL);
+}
+
+ConditionVariable::~ConditionVariable()
+{
+    pthread_cond_destroy(&handle);
+}
+
+void ConditionVariable::wait(Mutex &mutex)
+{
+    pthread_cond_wait(&handle, &mutex.handle);
+}
+
+bool ConditionVariable::wait(Mutex &mutex, long milliseconds)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    long long nanos = (long long)now.tv_usec * 1000 + (long long)milliseconds * 1000000;
+    struct timespec deadline;
+    deadline.tv_sec = now.tv_sec + (time_t)(nanos / 1000000000);
+    deadline.tv_nsec = (long)(nanos % 1000000000);
+    return pthread_cond_timedwait(&handle, &mutex.handle, &deadline) != ETIMEDOUT;
+}
+
+bool ConditionVariable::waitMicros(Mutex &mutex, long micros)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    long long nanos = (long long)now.tv_usec * 1000 + (long long)micros * 1000;
+    struct timespec deadline;
+    deadline.tv_sec = now.tv_sec + (time_t)(nanos / 1000000000);
+    deadline.tv_nsec = (long)(nanos % 1000000000);
+    return pthread_cond_timedwait(&handle, &mutex.handle, &deadline) != ETIMEDOUT;
+}
+
+void ConditionVariable::signal()
+{
+    pthread_cond_signal(&handle);
+}
+
+void ConditionVariable::broadcast()
+{
+    pthread_cond_broadcast(&handle);
+}
+
+#endif
+
+
+//=== Thread =================================================================
+
+Thread::Thread()
+{
+    function = NULL;
+    argument = NULL;
+    running = false;
+}
+
+Thread::~Thread()
+{
+    join();
+}
+
+bool Thread::isRunning()
+{
+    return running;
+}
+
+#ifdef _WIN32
+
+DWORD WINAPI Thread::run(LPVOID thread)
+{
+    Thread *t = (Thread*)thread;
+    t->function(t->argument);
+    return 0;
+}
+
+bool Thread::start(ThreadFunction function, void *argument)
+{
+    if (running)
+    {
+        return false;
+    }
+    this->function = function;
+    this->argument = argument;
+    handle = CreateThread(NULL, 0, &Thread::run, this, 0, NULL);
+    running = (handle != NULL);
+    return running;
+}
+
+void Thread::join()
+{
+    if (running)
+    {
+        WaitForSingleObject(handle, INFINITE);
+        CloseHandle(handle);
+        running = false;
+    }
+}
+
+int Thread::getProcessorCount()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+}
+
+void Thread::sleepMicros(long micros)
+{
+    Sleep((DWORD)((micros + 999) / 1000));
+}
+
+void Thread::yield()
+{
+    SwitchToThread();
+}
+
+#else
+
+void* Thread::run(void *thread)
+{
+    Thread *t = (Thread*)thread;
+    t->function(t->argument);
+    return NULL;
+}
+
+bool Thread::start(ThreadFunction function, void *argument)
+{
+    if (running)
+    {
+        return false;
+    }
+    this->function = function;
+    this->argument = argument;
+    running = (pthread_create(&handle, NULL, &Thread::run, this) == 0);
+    return running;
+}
+
+void Thread::join()
+{
+    if (running)
+    {
+        pthread_join(handle, NULL);
+        running = false;
+    }
+}
+
+int Thread::getProcessorCount()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+}
+
+void Thread::sleepMicros(long micros)
+{
+    usleep((useconds_t)micros);
+}
+
+void Thread::yield()
+{
+    sched_yield();
+}
+
+#endif
+
+
+//=== ThreadLocalKey =========================================================
+
+#ifdef _WIN32
+
+ThreadLocalKey::ThreadLocalKey(ThreadLocalDestructor destructor)
+{
+    // Fiber local storage offers destructor callbacks, which are
+    // also invoked when a thread that never used fibers exits
+    handle = FlsAlloc((PFLS_CALLBACK_FUNCTION)destructor);
+}
+
+ThreadLocalKey::~ThreadLocalKey()
+{
+    FlsFree(handle);
+}
+
+void* ThreadLocalKey::get()
+{
+    return FlsGetValue(handle);
+}
+
+void ThreadLocalKey::set(void *value)
+{
+    FlsSetValue(handle, value);
+}
+
+#else
+
+ThreadLocalKey::ThreadLocalKey(ThreadLocalDestructor destructor)
+{
+    pthread_key_create(&handle, destructor);
+}
+
+ThreadLocalKey::~ThreadLocalKey()
+{
+    pthread_key_delete(handle);
+}
+
+void* ThreadLocalKey::get()
+{
+    return pthread_getspecific(handle);
+}
+
+void ThreadLocalKey::set(void *value)
+{
+    pthread_setspecific(handle, value);
+}
+
+#endif
+
+
+//=== Time ===================================================================
+
+jcuda_int64 getNanoTime()
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency = { 0 };
+    if (frequency.QuadPart == 0)
+    {
+        QueryPerformanceFrequency(&frequency);
+    }
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (jcuda_int64)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#elif defined (__APPLE__) || defined(MACOSX)
+    static mach_timebase_info_data_t timebase = { 0, 0 };
+    if (timebase.denom == 0)
+    {
+        mach_timebase_info(&timebase);
+    }
+    return (jcuda_int64)(mach_absolute_time() * timebase.numer / timebase.denom);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (jcuda_int64)ts.tv_sec * 1000000000LL + (jcuda_int64)ts.tv_nsec;
+#endif
+}
@@ -0,0 +1,365 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef THREADING
+#define THREADING
+
+#ifdef _WIN32
+#  ifndef WINDOWS_LEAN_AND_MEAN
+#    define WINDOWS_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#  define JCUDA_THREAD_LOCAL __declspec(thread)
+#else
+#  include <pthread.h>
+#  define JCUDA_THREAD_LOCAL __thread
+#endif
+
+#include <stddef.h>
+
+/**
+ * Minimal platform abstraction for the threading primitives that are
+ * required by the native utility classes (memory arenas, pools,
+ * schedulers...). This covers mutexes, condition variables, threads,
+ * thread local storage with cleanup, and atomic operations on
+ * 32 and 64 bit values.
+ */
+
+#ifdef _WIN32
+typedef __int64 jcuda_int64;
+#else
+typedef long long jcuda_int64;
+#endif
+
+
+/**
+ * A non-recursive mutex
+ */
+class Mutex
+{
+    public:
+        Mutex();
+        ~Mutex();
+
+        void lock();
+        void unlock();
+        bool tryLock();
+
+    private:
+        friend class ConditionVariable;
+
+#ifdef _WIN32
+        CRITICAL_SECTION handle;
+#else
+        pthread_mutex_t handle;
+#endif
+
+        // Not copyable
+        Mutex(const Mutex&);
+        Mutex& operator=(const Mutex&);
+};
+
+
+/**
+ * Locks the given mutex for the lifetime of this object
+ */
+class MutexLock
+{
+    public:
+        MutexLock(Mutex &mutex) : mutex(mutex)
+        {
+            mutex.lock();
+        }
+        ~MutexLock()
+        {
+            mutex.unlock();
+        }
+
+    private:
+        Mutex &mutex;
+
+        MutexLock(const MutexLock&);
+        MutexLock& operator=(const MutexLock&);
+};
+
+
+/**
+ * A condition variable that may be used together with a Mutex
+ */
+class ConditionVariable
+{
+    public:
+        ConditionVariable();
+        ~ConditionVariable();
+
+        /**
+         * Wait until this condition is signalled. The given mutex
+         * must be locked by the calling thread.
+         */
+        void wait(Mutex &mutex);
+
+        /**
+         * Wait until this condition is signalled, or the given number
+         * of milliseconds have passed. Returns whether the condition
+         * was signalled (as far as this can be determined).
+         */
+        bool wait(Mutex &mutex, long milliseconds);
+
+        /**
+         * Wait until this condition is signalled, or the given number
+         * of microseconds have passed. On Windows, the time is rounded
+         * up to milliseconds. Returns whether the condition was
+         * signalled (as far as this can be determined).
+         */
+        bool waitMicros(Mutex &mutex, long micros);
+
+        void signal();
+        void broadcast();
+
+    private:
+#ifdef _WIN32
+        CONDITION_VARIABLE handle;
+#else
+        pthread_cond_t handle;
+#endif
+
+        ConditionVariable(const ConditionVariable&);
+        ConditionVariable& operator=(const ConditionVariable&);
+};
+
+
+/**
+ * The type of the function that may be executed by a Thread
+ */
+typedef void (*ThreadFunction)(void *argument);
+
+/**
+ * A native thread
+ */
+class Thread
+{
+    public:
+        Thread();
+        ~Thread();
+
+        /**
+         * Start this thread, executing the given function with the
+         * given argument. Returns whether the thread could be started.
+         */
+        bool start(ThreadFunction function, void *argument);
+
+        /**
+         * Wait until this thread has finished
+         */
+        void join();
+
+        /**
+         * Returns whether this thread has been started and not
+         * been joined yet
+         */
+        bool isRunning();
+
+        /**
+         * Returns the number of processors that are available
+         */
+        static int getProcessorCount();
+
+        /**
+         * Puts the calling thread to sleep for the given number of
+         * microseconds
+         */
+        static void sleepMicros(long micros);
+
+        /**
+         * Yield the remaining time slice of the calling thread
+         */
+        static void yield();
+
+    private:
+        ThreadFunction function;
+        void *argument;
+        bool running;
+
+#ifdef _WIN32
+        HANDLE handle;
+        static DWORD WINAPI run(LPVOID thread);
+#else
+        pthread_t handle;
+        static void* run(void *thread);
+#endif
+
+        Thread(const Thread&);
+        Thread& operator=(const Thread&);
+};
+
+
+/**
+ * The type of the function that is called for non-NULL thread
+ * local values when a thread exits
+ */
+typedef void (*ThreadLocalDestructor)(void *value);
+
+/**
+ * A key for a thread local value. Other than JCUDA_THREAD_LOCAL
+ * variables, this allows dynamically creating keys, and allows
+ * registering a destructor that is called when a thread exits
+ * while its value is non-NULL.
+ */
+class ThreadLocalKey
+{
+    public:
+        ThreadLocalKey(ThreadLocalDestructor destructor=NULL);
+        ~ThreadLocalKey();
+
+        void* get();
+        void set(void *value);
+
+    private:
+#ifdef _WIN32
+        DWORD handle;
+#else
+        pthread_key_t handle;
+#endif
+
+        ThreadLocalKey(const ThreadLocalKey&);
+        ThreadLocalKey& operator=(const ThreadLocalKey&);
+};
+
+
+/**
+ * Returns a monotonic time stamp, in nanoseconds
+ */
+jcuda_int64 getNanoTime();
+
+
+/**
+ * Atomic operations. All of them imply a full memory barrier.
+ */
+#ifdef _WIN32
+
+inline int atomicAdd(volatile int *value, int delta)
+{
+    return (int)InterlockedExchangeAdd((volatile LONG*)value, (LONG)delta) + delta;
+}
+inline jcuda_int64 atomicAdd(volatile jcuda_int64 *value, jcuda_int64 delta)
+{
+    return InterlockedExchangeAdd64(value, delta) + delta;
+}
+inline bool atomicCompareAndSwap(volatile int *value, int expected, int newValue)
+{
+    return InterlockedCompareExchange((volatile LONG*)value, (LONG)newValue, (LONG)expected) == (LONG)expected;
+}
+inline bool atomicCompareAndSwap(volatile jcuda_int64 *value, jcuda_int64 expected, jcuda_int64 newValue)
+{
+    return InterlockedCompareExchange64(value, newValue, expected) == expected;
+}
+inline bool atomicCompareAndSwap(void* volatile *value, void *expected, void *newValue)
+{
+    return InterlockedCompareExchangePointer(value, newValue, expected) == expected;
+}
+inline jcuda_int64 atomicLoad(volatile jcuda_int64 *value)
+{
+    return InterlockedCompareExchange64(value, 0, 0);
+}
+inline void* atomicLoad(void* volatile *value)
+{
+    return InterlockedCompareExchangePointer(value, NULL, NULL);
+}
+
+#else
+
+inline int atomicAdd(volatile int *value, int delta)
+{
+    return __sync_add_and_fetch(value, delta);
+}
+inline jcuda_int64 atomicAdd(volatile jcuda_int64 *value, jcuda_int64 delta)
+{
+    return __sync_add_and_fetch(value, delta);
+}
+inline bool atomicCompareAndSwap(volatile int *value, int expected, int newValue)
+{
+    return __sync_bool_compare_and_swap(value, expected, newValue);
+}
+inline bool atomicCompareAndSwap(volatile jcuda_int64 *value, jcuda_int64 expected, jcuda_int64 newValue)
+{
+    return __sync_bool_compare_and_swap(value, expected, newValue);
+}
+inline bool atomicCompareAndSwap(void* volatile *value, void *expected, void *newValue)
+{
+    return __sync_bool_compare_and_swap(value, expected, newValue);
+}
+inline jcuda_int64 atomicLoad(volatile jcuda_int64 *value)
+{
+    return __sync_add_and_fetch(value, 0);
+}
+inline void* atomicLoad(void* volatile *value)
+{
+    __sync_synchronize();
+    return *value;
+}
+
+#endif
+
+inline int atomicLoad(volatile int *value)
+{
+    return atomicAdd(value, 0);
+}
+
+/**
+ * Atomically sets the given value to the given new value
+ */
+inline void atomicStore(volatile jcuda_int64 *value, jcuda_int64 newValue)
+{
+    jcuda_int64 current = atomicLoad(value);
+    while (!atomicCompareAndSwap(value, current, newValue))
+    {
+        current = atomicLoad(value);
+    }
+}
+
+/**
+ * Atomically sets the given value to the maximum of its current
+ * value and the given candidate value
+ */
+inline void atomicMax(volatile jcuda_int64 *value, jcuda_int64 candidate)
+{
+    jcuda_int64 current = atomicLoad(value);
+    while (candidate > current)
+    {
+        if (atomicCompareAndSwap(value, current, candidate))
+        {
+            return;
+        }
+        current = atomicLoad(value);
+    }
+}
+
+
+#endif
@@ -0,0 +1,183 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * A test for the lookup of the NUMA nodes of devices in the
+ * NumaPlacement, using a fake sysfs tree in a temporary directory
+ */
+
+#include "NumaPlacement.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** The number of checks that failed */
+static int failures = 0;
+
+/** The PCI bus ID that is reported for all devices */
+static const char *reportedBusId = "";
+
+/**
+ * Compares the given values, and prints a message if they differ
+ */
+static void check(const char *description, int expected, int actual)
+{
+    if (expected != actual)
+    {
+        printf("FAILED: %s: expected %d, but was %d\n", description, expected, actual);
+        failures++;
+    }
+    else
+    {
+        printf("passed: %s\n", description);
+    }
+}
+
+/**
+ * Creates the numa_node file for the given sysfs device directory
+ * name in the given root, with the given contents
+ */
+static void writeNumaNode(const std::string &root, const char *name, const char *contents)
+{
+    std::string path = root + "/bus";
+    mkdir(path.c_str(), 0700);
+    path += "/pci";
+    mkdir(path.c_str(), 0700);
+    path += "/devices";
+    mkdir(path.c_str(), 0700);
+    path += "/";
+    path += name;
+    mkdir(path.c_str(), 0700);
+    path += "/numa_node";
+    FILE *file = fopen(path.c_str(), "w");
+    if (file == NULL)
+    {
+        printf("Could not create %s\n", path.c_str());
+        exit(EXIT_FAILURE);
+    }
+    fputs(contents, file);
+    fclose(file);
+}
+
+/**
+ * Removes the numa_node file and the directories that have been
+ * created by writeNumaNode
+ */
+static void removeNumaNode(const std::string &root, const char *name)
+{
+    std::string devices = root + "/bus/pci/devices";
+    std::string device = devices + "/" + name;
+    remove((device + "/numa_node").c_str());
+    rmdir(device.c_str());
+    rmdir(devices.c_str());
+    rmdir((root + "/bus/pci").c_str());
+    rmdir((root + "/bus").c_str());
+}
+
+static int getCurrentDevice(int *device)
+{
+    *device = 0;
+    return 0;
+}
+
+static int getPCIBusId(char *busId, int length, int /*device*/)
+{
+    strncpy(busId, reportedBusId, (size_t)length - 1);
+    busId[length - 1] = '\0';
+    return 0;
+}
+
+static int registerHost(void * /*pointer*/, size_t /*size*/, unsigned int /*flags*/)
+{
+    return 1;
+}
+
+static int unregisterHost(void * /*pointer*/)
+{
+    return 1;
+}
+
+static NumaPlacementFunctions functions =
+{
+    &getCurrentDevice,
+    &getPCIBusId,
+    &registerHost,
+    &unregisterHost
+};
+
+int main()
+{
+    char rootTemplate[] = "/tmp/NumaPlacementTestXXXXXX";
+    if (mkdtemp(rootTemplate) == NULL)
+    {
+        printf("Could not create temporary directory\n");
+        return EXIT_FAILURE;
+    }
+    std::string root = rootTemplate;
+    writeNumaNode(root, "0000:0b:00.0", "1\n");
+    writeNumaNode(root, "0000:0c:00.0", "-1\n");
+    writeNumaNode(root, "0000:0d:00.0", "garbage\n");
+
+    check("Four digit domain",
+        1, NumaPlacement::readNumaNode(root.c_str(), "0000:0b:00.0"));
+    check("Eight digit domain and upper case digits",
+        1, NumaPlacement::readNumaNode(root.c_str(), "00000000:0B:00.0"));
+    check("Unknown node",
+        -1, NumaPlacement::readNumaNode(root.c_str(), "0000:0c:00.0"));
+    check("Invalid contents",
+        -1, NumaPlacement::readNumaNode(root.c_str(), "0000:0d:00.0"));
+    check("Missing device",
+        -1, NumaPlacement::readNumaNode(root.c_str(), "0000:0e:00.0"));
+    check("Missing tree",
+        -1, NumaPlacement::readNumaNode((root + "/missing").c_str(), "0000:0b:00.0"));
+
+    // The node is looked up once, and looked up again after the root changed
+    NumaPlacement placement(functions);
+    reportedBusId = "0000:0B:00.0";
+    placement.setSysfsRoot(root.c_str());
+    check("Device node", 1, placement.getDeviceNode(0));
+    reportedBusId = "0000:0C:00.0";
+    check("Known device node", 1, placement.getDeviceNode(0));
+    placement.setSysfsRoot(root.c_str());
+    check("Device node after setting the root", -1, placement.getDeviceNode(0));
+
+    removeNumaNode(root, "0000:0b:00.0");
+    removeNumaNode(root, "0000:0c:00.0");
+    removeNumaNode(root, "0000:0d:00.0");
+    rmdir(root.c_str());
+
+    if (failures > 0)
+    {
+        printf("%d checks failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -28,6 +28,7 @@
 
 #include "JCublas2.hpp"
 #include "JCublas2_common.hpp"
+#include "BounceRing.hpp"
 #include <iostream>
 #include <string>
 #include <map>
@@ -97,6 +98,117 @@ JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *jvm, void *reserved)
 }
 
 
+/**
+ * Obtains the owner of the slots of the calling thread, which is the
+ * current device, offset by one, so that it is never NULL
+ */
+static int getBounceOwner(void **owner)
+{
+    int device = -1;
+    int result = cudaGetDevice(&device);
+    if (result == cudaSuccess)
+    {
+        *owner = (void*)((size_t)device + 1);
+    }
+    return result;
+}
+
+/**
+ * Allocates portable page-locked memory for a slot
+ */
+static int allocBounceHost(void **pointer, size_t size)
+{
+    return cudaHostAlloc(pointer, size, cudaHostAllocPortable);
+}
+
+/**
+ * Frees the memory of a slot
+ */
+static int freeBounceHost(void *pointer)
+{
+    return cudaFreeHost(pointer);
+}
+
+/**
+ * Creates an event without timing
+ */
+static int createBounceEvent(void **event)
+{
+    return cudaEventCreateWithFlags((cudaEvent_t*)event, cudaEventDisableTiming);
+}
+
+/**
+ * Destroys the given event
+ */
+static int destroyBounceEvent(void *event)
+{
+    return cudaEventDestroy((cudaEvent_t)event);
+}
+
+/**
+ * Records the given event in the given stream
+ */
+static int recordBounceEvent(void *event, void *stream)
+{
+    return cudaEventRecord((cudaEvent_t)event, (cudaStream_t)stream);
+}
+
+/**
+ * Queries whether the given event has been reached
+ */
+static int queryBounceEvent(void *event)
+{
+    return cudaEventQuery((cudaEvent_t)event);
+}
+
+/**
+ * Waits until the given event has been reached
+ */
+static int synchronizeBounceEvent(void *event)
+{
+    return cudaEventSynchronize((cudaEvent_t)event);
+}
+
+/**
+ * The functions for the bounceRing. The owner of the streams is the
+ * current device, offset by one, so that it is never NULL.
+ */
+BounceRingFunctions bounceRingFunctions =
+{
+    &getBounceOwner,
+    &allocBounceHost,
+    &freeBounceHost,
+    &createBounceEvent,
+    &destroyBounceEvent,
+    &recordBounceEvent,
+    &queryBounceEvent,
+    &synchronizeBounceEvent
+};
+
+/**
+ * The ring of page-locked slots for the asynchronous copies from Java
+ * arrays. Only copies to the device are bounced here, so the slots
+ * are recycled when they are used again. The slots of a device or a
+ * stream are released by the JCuda resource listener of JCublas2
+ * before the device is reset or the stream is destroyed.
+ */
+BounceRing bounceRing(bounceRingFunctions, cudaErrorNotReady);
+
+/**
+ * Commits the given slot of the bounceRing after the given cublas
+ * copy was enqueued, and returns the cublas status of the copy
+ */
+static int commitBouncedCopy(JNIEnv *env, BounceSlot *slot, cudaStream_t stream, int result)
+{
+    int commitResult = bounceRing.commit(env, slot, stream, result);
+    if (result == CUBLAS_STATUS_SUCCESS && commitResult != 0)
+    {
+        return CUBLAS_STATUS_EXECUTION_FAILED;
+    }
+    return result;
+}
+
+
 
 
 
@@ -315,20 +427,67 @@ JNIEXPORT jint JNICALL Java_jcuda_jcublas_JCublas2_cublasSetVectorAsyncNative
     void *hostMemory = NULL;
     cudaStream_t nativeStream = NULL;
 
+    deviceMemory = getPointer(env, y);
+
+    nativeStream = (cudaStream_t)getNativePointerValue(env, stream);
+
+    // Vectors from Java arrays are copied through page-locked slots, in
+    // chunks of as many elements as fit into one slot. If no slot is
+    // available for a chunk, then the remaining elements are copied
+    // directly.
+    int first = 0;
+    if (n > 0 && incx > 0 && incy > 0 && elemSize > 0)
+    {
+        size_t slotElements = bounceRing.getSlotSize() / elemSize;
+        size_t chunkElements = slotElements == 0 ? 0 : (slotElements - 1) / incx + 1;
+        if (chunkElements > (size_t)n)
+        {
+            chunkElements = (size_t)n;
+        }
+        while (chunkElements > 0 && first < n)
+        {
+            int count = n - first;
+            if ((size_t)count > chunkElements)
+            {
+                count = (int)chunkElements;
+            }
+            BounceSlot *slot = NULL;
+            size_t offset = (size_t)first * incx * elemSize;
+            size_t size = ((size_t)(count - 1) * incx + 1) * elemSize;
+            if (!bounceRing.acquire(env, x, offset, nativeStream, size, true, &slot)) return JCUBLAS_STATUS_INTERNAL_ERROR;
+            if (slot == NULL)
+            {
+                break;
+            }
+            Logger::log(LOG_TRACE, "Setting %d elements of size %d from java with inc %d to '%s' with inc %d (bounced)\n",
+                count, elemSize, incx, "y", incy);
+            char *deviceChunk = (char*)deviceMemory + (size_t)first * incy * elemSize;
+            int result = cublasSetVectorAsync(count, elemSize, slot->buffer, incx, deviceChunk, incy, nativeStream);
+            result = commitBouncedCopy(env, slot, nativeStream, result);
+            if (result != CUBLAS_STATUS_SUCCESS)
+            {
+                return result;
+            }
+            first += count;
+        }
+        if (first == n)
+        {
+            return CUBLAS_STATUS_SUCCESS;
+        }
+    }
+
     PointerData *xPointerData = initPointerData(env, x);
     if (xPointerData == NULL)
     {
         return JCUBLAS_STATUS_INTERNAL_ERROR;
     }
 
-    deviceMemory = getPointer(env, y);
-
-    nativeStream = (cudaStream_t)getNativePointerValue(env, stream);
-
     Logger::log(LOG_TRACE, "Setting %d elements of size %d from java with inc %d to '%s' with inc %d\n",
-        n, elemSize, incx, "y", incy);
+        n - first, elemSize, incx, "y", incy);
 
-    cublasStatus_t result = cublasSetVectorAsync(n, elemSize, (void*)xPointerData->getPointer(env), incx, deviceMemory, incy, nativeStream);
+    hostMemory = (char*)xPointerData->getPointer(env) + (size_t)first * incx * elemSize;
+    deviceMemory = (char*)deviceMemory + (size_t)first * incy * elemSize;
+    cublasStatus_t result = cublasSetVectorAsync(n - first, elemSize, hostMemory, incx, deviceMemory, incy, nativeStream);
 
     if (!releasePointerData(env, xPointerData, JNI_ABORT)) return JCUBLAS_STATUS_INTERNAL_ERROR;
     return result;
@@ -409,26 +568,139 @@ JNIEXPORT jint JNICALL Java_jcuda_jcublas_JCublas2_cublasSetMatrixAsyncNative
     void *hostMemory = NULL;
     cudaStream_t nativeStream = NULL;
 
+    deviceMemory = getPointer(env, B);
+
+    nativeStream = (cudaStream_t)getNativePointerValue(env, stream);
+
+    // Matrices from Java arrays are copied through page-locked slots, in
+    // chunks of as many columns as fit into one slot. If no slot is
+    // available for a chunk, then the remaining columns are copied
+    // directly.
+    int first = 0;
+    if (rows > 0 && cols > 0 && lda >= rows && ldb >= rows && elemSize > 0)
+    {
+        size_t slotElements = bounceRing.getSlotSize() / elemSize;
+        size_t chunkColumns = slotElements < (size_t)rows ? 0 : (slotElements - rows) / lda + 1;
+        if (chunkColumns > (size_t)cols)
+        {
+            chunkColumns = (size_t)cols;
+        }
+        while (chunkColumns > 0 && first < cols)
+        {
+            int count = cols - first;
+            if ((size_t)count > chunkColumns)
+            {
+                count = (int)chunkColumns;
+            }
+            BounceSlot *slot = NULL;
+            size_t offset = (size_t)first * lda * elemSize;
+            size_t size = ((size_t)(count - 1) * lda + rows) * elemSize;
+            if (!bounceRing.acquire(env, A, offset, nativeStream, size, true, &slot)) return JCUBLAS_STATUS_INTERNAL_ERROR;
+            if (slot == NULL)
+            {
+                break;
+            }
+            Logger::log(LOG_TRACE, "Setting %dx%d elements of size %d from java with lda %d to '%s' with ldb %d (bounced)\n",
+                rows, count, elemSize, lda, "B", ldb);
+            char *deviceChunk = (char*)deviceMemory + (size_t)first * ldb * elemSize;
+            int result = cublasSetMatrixAsync(rows, count, elemSize, slot->buffer, lda, deviceChunk, ldb, nativeStream);
+            result = commitBouncedCopy(env, slot, nativeStream, result);
+            if (result != CUBLAS_STATUS_SUCCESS)
+            {
+                return result;
+            }
+            first += count;
+        }
+        if (first == cols)
+        {
+            return CUBLAS_STATUS_SUCCESS;
+        }
+    }
+
     PointerData *APointerData = initPointerData(env, A);
     if (APointerData == NULL)
     {
         return JCUBLAS_STATUS_INTERNAL_ERROR;
     }
 
-    deviceMemory = getPointer(env, B);
-
-    nativeStream = (cudaStream_t)getNativePointerValue(env, stream);
-
     Logger::log(LOG_TRACE, "Setting %dx%d elements of size %d from java with lda %d to '%s' with ldb %d\n",
-        rows, cols, elemSize, lda, "B", ldb);
+        rows, cols - first, elemSize, lda, "B", ldb);
 
-    cublasStatus_t result = cublasSetMatrixAsync(rows, cols, elemSize, (void*)APointerData->getPointer(env), lda, deviceMemory, ldb, nativeStream);
+    hostMemory = (char*)APointerData->getPointer(env) + (size_t)first * lda * elemSize;
+    deviceMemory = (char*)deviceMemory + (size_t)first * ldb * elemSize;
+    cublasStatus_t result = cublasSetMatrixAsync(rows, cols - first, elemSize, hostMemory, lda, deviceMemory, ldb, nativeStream);
 
     if (!releasePointerData(env, APointerData, JNI_ABORT)) return JCUBLAS_STATUS_INTERNAL_ERROR;
     return result;
 }
 
 
+/*
+ * Class:     jcuda_jcublas_JCublas2
+ * Method:    cublasBounceRingEnableNative
+ * Signature: (JI)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_jcublas_JCublas2_cublasBounceRingEnableNative
+  (JNIEnv *env, jclass cla, jlong slotSize, jint slotCount)
+{
+    Logger::log(LOG_TRACE, "Executing cublasBounceRingEnable\n");
+
+    if (slotSize < 1 || slotCount < 1)
+    {
+        return CUBLAS_STATUS_INVALID_VALUE;
+    }
+    bounceRing.enable(env, (size_t)slotSize, (int)slotCount);
+    return CUBLAS_STATUS_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_jcublas_JCublas2
+ * Method:    cublasBounceRingDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_jcublas_JCublas2_cublasBounceRingDisableNative
+  (JNIEnv *env, jclass cla)
+{
+    Logger::log(LOG_TRACE, "Executing cublasBounceRingDisable\n");
+
+    bounceRing.disable(env);
+    return CUBLAS_STATUS_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_jcublas_JCublas2
+ * Method:    cublasBounceRingRemoveDeviceNative
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_jcuda_jcublas_JCublas2_cublasBounceRingRemoveDeviceNative
+  (JNIEnv *env, jclass cla)
+{
+    Logger::log(LOG_TRACE, "Removing bounce slots of current device\n");
+
+    void *owner = NULL;
+    if (getBounceOwner(&owner) == cudaSuccess)
+    {
+        bounceRing.removeOwner(env, owner);
+    }
+}
+
+
+/*
+ * Class:     jcuda_jcublas_JCublas2
+ * Method:    cublasBounceRingRemoveStreamNative
+ * Signature: (Ljcuda/runtime/cudaStream_t;)V
+ */
+JNIEXPORT void JNICALL Java_jcuda_jcublas_JCublas2_cublasBounceRingRemoveStreamNative
+  (JNIEnv *env, jclass cla, jobject stream)
+{
+    Logger::log(LOG_TRACE, "Removing bounce slots of stream\n");
+
+    bounceRing.removeStream(env, (void*)getNativePointerValue(env, stream));
+}
+
+
 /*
  * Passes the call to Cublas
  *
@@ -171,6 +171,38 @@ JNIEXPORT jint JNICALL Java_jcuda_jcublas_JCublas2_cublasGetVectorAsyncNative
 JNIEXPORT jint JNICALL Java_jcuda_jcublas_JCublas2_cublasSetMatrixAsyncNative
   (JNIEnv *, jclass, jint, jint, jint, jobject, jint, jobject, jint, jobject);
 
+/*
+ * Class:     jcuda_jcublas_JCublas2
+ * Method:    cublasBounceRingEnableNative
+ * Signature: (JI)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_jcublas_JCublas2_cublasBounceRingEnableNative
+  (JNIEnv *, jclass, jlong, jint);
+
+/*
+ * Class:     jcuda_jcublas_JCublas2
+ * Method:    cublasBounceRingDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_jcublas_JCublas2_cublasBounceRingDisableNative
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     jcuda_jcublas_JCublas2
+ * Method:    cublasBounceRingRemoveDeviceNative
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_jcuda_jcublas_JCublas2_cublasBounceRingRemoveDeviceNative
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     jcuda_jcublas_JCublas2
+ * Method:    cublasBounceRingRemoveStreamNative
+ * Signature: (Ljcuda/runtime/cudaStream_t;)V
+ */
+JNIEXPORT void JNICALL Java_jcuda_jcublas_JCublas2_cublasBounceRingRemoveStreamNative
+  (JNIEnv *, jclass, jobject);
+
 /*
  * Class:     jcuda_jcublas_JCublas2
  * Method:    cublasGetMatrixAsyncNative
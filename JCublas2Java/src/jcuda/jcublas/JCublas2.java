@@ -29,6 +29,8 @@
 package jcuda.jcublas;
 
 import jcuda.*;
+import jcuda.runtime.JCuda;
+import jcuda.runtime.cudaResourceListener;
 import jcuda.runtime.cudaStream_t;
 
 /**
@@ -530,6 +532,94 @@ public class JCublas2
         cudaStream_t stream);
 
 
+    /**
+     * Enables the bounce ring for {@link JCublas2#cublasSetVectorAsync}
+     * and {@link JCublas2#cublasSetMatrixAsync}. Each stream gets up to
+     * the given number of page-locked slots of the given size. When the
+     * host data is a Java array, the part of the array that is read is
+     * copied into the next slot, and the transfer from this slot is
+     * enqueued, so that the array is not accessed after the call
+     * returned. A slot is reused when its transfer is complete. Data
+     * that is larger than one slot is split into chunks of whole
+     * elements or columns, and transferred directly if a single element
+     * or column does not fit into a slot, or no slot is available.<br />
+     * <br />
+     * The slots of a device are released before the device is reset
+     * with {@link JCuda#cudaDeviceReset} or {@link JCuda#cudaThreadExit},
+     * and the slots of a stream before the stream is destroyed with
+     * {@link JCuda#cudaStreamDestroy}.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param slotSize The size of each slot, in bytes
+     * @param slotCount The maximum number of slots for each stream
+     *
+     * @return CUBLAS_STATUS_SUCCESS, CUBLAS_STATUS_INVALID_VALUE
+     *
+     * @see JCublas2#cublasBounceRingDisable
+     */
+    public static int cublasBounceRingEnable(long slotSize, int slotCount)
+    {
+        addBounceRingListener();
+        return checkResult(cublasBounceRingEnableNative(slotSize, slotCount));
+    }
+    private static native int cublasBounceRingEnableNative(long slotSize, int slotCount);
+
+    /**
+     * The listener that releases the slots of the bounce ring before a
+     * device is reset or a stream is destroyed
+     */
+    private static cudaResourceListener bounceRingListener = null;
+
+    /**
+     * Adds the listener that releases the slots of the bounce ring to
+     * JCuda, if it was not added yet
+     */
+    private static synchronized void addBounceRingListener()
+    {
+        if (bounceRingListener != null)
+        {
+            return;
+        }
+        bounceRingListener = new cudaResourceListener()
+        {
+            public void deviceResetting()
+            {
+                cublasBounceRingRemoveDeviceNative();
+            }
+
+            public void streamDestroying(cudaStream_t stream)
+            {
+                cublasBounceRingRemoveStreamNative(stream);
+            }
+        };
+        JCuda.addResourceListener(bounceRingListener);
+    }
+    private static native void cublasBounceRingRemoveDeviceNative();
+    private static native void cublasBounceRingRemoveStreamNative(cudaStream_t stream);
+
+
+    /**
+     * Disables the bounce ring, and releases all slots after their
+     * transfers are complete.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @return CUBLAS_STATUS_SUCCESS
+     *
+     * @see JCublas2#cublasBounceRingEnable
+     */
+    public static int cublasBounceRingDisable()
+    {
+        return checkResult(cublasBounceRingDisableNative());
+    }
+    private static native int cublasBounceRingDisableNative();
+
+
     /**
      * <pre>
      * cublasStatus_t 
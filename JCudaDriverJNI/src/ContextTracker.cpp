@@ -0,0 +1,277 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ContextTracker.hpp"
+
+/** The maximum number of pushes that are recorded in the shadow stack */
+#define CONTEXT_TRACKER_MAX_DEPTH 64
+
+/**
+ * The thread local record. It is zero-initialized, and a generation
+ * of 0 means that the current context is not known.
+ */
+struct ContextRecord
+{
+    /** The context that is current, if the generation is valid */
+    CUcontext context;
+
+    /** The global generation at which the context was recorded */
+    int generation;
+
+    /** The shadow stack of pushes, storing whether they were elided */
+    int depth;
+    bool elided[CONTEXT_TRACKER_MAX_DEPTH];
+
+    /** The number of pushes beyond the maximum depth */
+    int overflow;
+};
+
+static JCUDA_THREAD_LOCAL ContextRecord record;
+
+static volatile int enabledFlag = 0;
+static volatile int globalGeneration = 1;
+static volatile jcuda_int64 performedSwitches = 0;
+static volatile jcuda_int64 elidedSwitches = 0;
+
+
+/**
+ * Returns whether the record of the calling thread is valid
+ */
+static bool isKnown()
+{
+    return record.generation == atomicLoad(&globalGeneration);
+}
+
+/**
+ * Records the given context as the current one for the calling thread
+ */
+static void recordCurrent(CUcontext ctx)
+{
+    record.context = ctx;
+    record.generation = atomicLoad(&globalGeneration);
+}
+
+/**
+ * Queries the current context from the driver and records it. This
+ * is not a context switch, and cheap compared to one.
+ */
+static void refresh()
+{
+    CUcontext ctx;
+    if (cuCtxGetCurrent(&ctx) == CUDA_SUCCESS)
+    {
+        recordCurrent(ctx);
+    }
+    else
+    {
+        record.generation = 0;
+    }
+}
+
+/**
+ * Records a push in the shadow stack
+ */
+static void pushRecord(bool elided)
+{
+    if (record.overflow > 0 || record.depth == CONTEXT_TRACKER_MAX_DEPTH)
+    {
+        record.overflow++;
+    }
+    else
+    {
+        record.elided[record.depth] = elided;
+        record.depth++;
+    }
+}
+
+/**
+ * Performs the topmost push of the shadow stack if it was elided,
+ * so that a subsequent pop will restore the context that was pushed.
+ * Returns CUDA_SUCCESS, or the error from the driver.
+ */
+static CUresult materializeTop()
+{
+    if (record.overflow > 0 || record.depth == 0 || !record.elided[record.depth - 1])
+    {
+        return CUDA_SUCCESS;
+    }
+    if (!isKnown())
+    {
+        refresh();
+    }
+    CUresult result = cuCtxPushCurrent(record.context);
+    atomicAdd(&performedSwitches, 1);
+    if (result == CUDA_SUCCESS)
+    {
+        record.elided[record.depth - 1] = false;
+    }
+    return result;
+}
+
+
+void ContextTracker::setEnabled(bool enabled)
+{
+    atomicCompareAndSwap(&enabledFlag, enabled ? 0 : 1, enabled ? 1 : 0);
+    invalidate();
+}
+
+bool ContextTracker::isEnabled()
+{
+    return atomicLoad(&enabledFlag) != 0;
+}
+
+CUresult ContextTracker::setCurrent(CUcontext ctx)
+{
+    if (isEnabled() && isKnown() && record.context == ctx)
+    {
+        atomicAdd(&elidedSwitches, 1);
+        return CUDA_SUCCESS;
+    }
+    CUresult result = materializeTop();
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    result = cuCtxSetCurrent(ctx);
+    atomicAdd(&performedSwitches, 1);
+    if (result == CUDA_SUCCESS)
+    {
+        recordCurrent(ctx);
+    }
+    else
+    {
+        record.generation = 0;
+    }
+    return result;
+}
+
+CUresult ContextTracker::pushCurrent(CUcontext ctx)
+{
+    if (isEnabled() && isKnown() && record.context == ctx &&
+        record.overflow == 0 && record.depth < CONTEXT_TRACKER_MAX_DEPTH)
+    {
+        atomicAdd(&elidedSwitches, 1);
+        pushRecord(true);
+        return CUDA_SUCCESS;
+    }
+    CUresult result = cuCtxPushCurrent(ctx);
+    atomicAdd(&performedSwitches, 1);
+    if (result == CUDA_SUCCESS)
+    {
+        pushRecord(false);
+        recordCurrent(ctx);
+    }
+    else
+    {
+        record.generation = 0;
+    }
+    return result;
+}
+
+CUresult ContextTracker::popCurrent(CUcontext *pctx)
+{
+    // The shadow stack is consulted even if tracking is disabled,
+    // because an elided push must never lead to a real pop
+    bool elided = false;
+    if (record.overflow > 0)
+    {
+        record.overflow--;
+    }
+    else if (record.depth > 0)
+    {
+        record.depth--;
+        elided = record.elided[record.depth];
+    }
+    if (elided)
+    {
+        if (!isKnown())
+        {
+            refresh();
+        }
+        atomicAdd(&elidedSwitches, 1);
+        *pctx = record.context;
+        return CUDA_SUCCESS;
+    }
+    CUresult result = cuCtxPopCurrent(pctx);
+    atomicAdd(&performedSwitches, 1);
+
+    // Without tracking, the record is only invalidated, instead of
+    // querying the context that is current after the pop
+    if (isEnabled())
+    {
+        refresh();
+    }
+    else
+    {
+        record.generation = 0;
+    }
+    return result;
+}
+
+CUresult ContextTracker::getCurrent(CUcontext *pctx)
+{
+    CUresult result = cuCtxGetCurrent(pctx);
+    if (result == CUDA_SUCCESS)
+    {
+        recordCurrent(*pctx);
+    }
+    return result;
+}
+
+void ContextTracker::contextCreated(CUcontext ctx)
+{
+    pushRecord(false);
+    recordCurrent(ctx);
+}
+
+void ContextTracker::contextDestroyed(CUcontext ctx)
+{
+    // Destroying the current context pops it from the stack
+    if (isKnown() && record.context == ctx &&
+        record.overflow == 0 && record.depth > 0 && !record.elided[record.depth - 1])
+    {
+        record.depth--;
+    }
+    invalidate();
+}
+
+void ContextTracker::invalidate()
+{
+    atomicAdd(&globalGeneration, 1);
+}
+
+void ContextTracker::getSwitchCounts(jcuda_int64 *performed, jcuda_int64 *elided)
+{
+    *performed = atomicLoad(&performedSwitches);
+    *elided = atomicLoad(&elidedSwitches);
+}
+
+void ContextTracker::resetSwitchCounts()
+{
+    atomicAdd(&performedSwitches, -atomicLoad(&performedSwitches));
+    atomicAdd(&elidedSwitches, -atomicLoad(&elidedSwitches));
+}
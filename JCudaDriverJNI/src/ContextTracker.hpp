@@ -0,0 +1,137 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef CONTEXTTRACKER
+#define CONTEXTTRACKER
+
+#include <cuda.h>
+#include "Threading.hpp"
+
+/**
+ * Keeps a thread local record of the context that is current on the
+ * calling thread, so that redundant context switches may be elided.<br />
+ * <br />
+ * When tracking is enabled, a setCurrent or pushCurrent for the context
+ * that is already current is not passed to the driver. An elided push
+ * is remembered in a shadow stack, so that the matching popCurrent is
+ * elided as well. If the current context is changed with setCurrent
+ * while the topmost push was elided, this push is performed lazily,
+ * so that the following pop restores the right context.<br />
+ * <br />
+ * The record of a thread is only valid until a context is destroyed
+ * or detached on any thread. Contexts that are made current without
+ * using this class (for example, by the runtime API) can not be
+ * detected. For this reason, tracking is disabled by default, and
+ * all calls are passed to the driver.
+ */
+class ContextTracker
+{
+    public:
+
+        /**
+         * Enable or disable the elision of redundant context switches.
+         * Changing the state invalidates the records of all threads.
+         */
+        static void setEnabled(bool enabled);
+
+        static bool isEnabled();
+
+        /**
+         * Tracked versions of the respective driver functions
+         */
+        static CUresult setCurrent(CUcontext ctx);
+        static CUresult pushCurrent(CUcontext ctx);
+        static CUresult popCurrent(CUcontext *pctx);
+        static CUresult getCurrent(CUcontext *pctx);
+
+        /**
+         * Notifies the tracker that the given context was created and
+         * pushed on the context stack of the calling thread
+         */
+        static void contextCreated(CUcontext ctx);
+
+        /**
+         * Notifies the tracker that the given context was destroyed
+         * or detached by the calling thread. This invalidates the
+         * records of all threads.
+         */
+        static void contextDestroyed(CUcontext ctx);
+
+        /**
+         * Invalidates the records of all threads
+         */
+        static void invalidate();
+
+        /**
+         * Obtain the number of context switches that have been passed
+         * to the driver, and the number of switches that have been
+         * elided, since the last reset
+         */
+        static void getSwitchCounts(jcuda_int64 *performed, jcuda_int64 *elided);
+
+        static void resetSwitchCounts();
+
+    private:
+        ContextTracker();
+};
+
+
+/**
+ * Pushes the given context for the lifetime of this object, using
+ * the ContextTracker. The context is only popped when it could be
+ * pushed, which may be checked with getResult.
+ */
+class ContextScope
+{
+    public:
+        ContextScope(CUcontext ctx)
+        {
+            result = ContextTracker::pushCurrent(ctx);
+        }
+        ~ContextScope()
+        {
+            if (result == CUDA_SUCCESS)
+            {
+                CUcontext popped;
+                ContextTracker::popCurrent(&popped);
+            }
+        }
+
+        CUresult getResult()
+        {
+            return result;
+        }
+
+    private:
+        CUresult result;
+
+        ContextScope(const ContextScope&);
+        ContextScope& operator=(const ContextScope&);
+};
+
+
+#endif
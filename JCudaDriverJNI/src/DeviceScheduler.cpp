@@ -0,0 +1,414 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "DeviceScheduler.hpp"
+#include "ContextTracker.hpp"
+
+/**
+ * The scheduler that the calling thread is a worker thread of, or NULL
+ */
+static JCUDA_THREAD_LOCAL DeviceScheduler *currentScheduler = NULL;
+
+
+//=== SchedulerTask ==========================================================
+
+SchedulerTask::SchedulerTask(TaskFunction function, TaskCleanupFunction cleanup,
+    void *userData, int references)
+{
+    this->function = function;
+    this->cleanup = cleanup;
+    this->userData = userData;
+    this->references = references;
+    device = -1;
+    event = NULL;
+    completed = false;
+    result = CUDA_SUCCESS;
+}
+
+SchedulerTask::~SchedulerTask()
+{
+}
+
+CUresult SchedulerTask::query()
+{
+    MutexLock lock(mutex);
+    if (!completed)
+    {
+        return CUDA_ERROR_NOT_READY;
+    }
+    return result;
+}
+
+CUresult SchedulerTask::synchronize()
+{
+    MutexLock lock(mutex);
+    while (!completed)
+    {
+        condition.wait(mutex);
+    }
+    return result;
+}
+
+int SchedulerTask::getDevice()
+{
+    return atomicLoad(&device);
+}
+
+void SchedulerTask::release()
+{
+    if (atomicAdd(&references, -1) == 0)
+    {
+        delete this;
+    }
+}
+
+
+//=== SchedulerDevice ========================================================
+
+SchedulerDevice::SchedulerDevice()
+{
+    scheduler = NULL;
+    index = -1;
+    context = NULL;
+    load = 0;
+    executed = 0;
+}
+
+SchedulerDevice::~SchedulerDevice()
+{
+}
+
+
+//=== DeviceScheduler ========================================================
+
+DeviceScheduler::DeviceScheduler(unsigned int contextFlags, ThreadFunction workerExit,
+    ContextDestroyFunction contextDestroy)
+{
+    this->contextFlags = contextFlags;
+    this->workerExit = workerExit;
+    this->contextDestroy = contextDestroy;
+    pendingTasks = 0;
+    started = false;
+    stopping = 0;
+    nextDevice = 0;
+}
+
+DeviceScheduler::~DeviceScheduler()
+{
+}
+
+void DeviceScheduler::shutdown()
+{
+    if (started)
+    {
+        synchronize();
+    }
+    {
+        MutexLock lock(mutex);
+        stopping = 1;
+        workAvailable.broadcast();
+    }
+    for (size_t i=0; i<devices.size(); i++)
+    {
+        devices[i]->thread.join();
+    }
+    for (size_t i=0; i<devices.size(); i++)
+    {
+        destroyDevice(devices[i]);
+    }
+    devices.clear();
+}
+
+CUresult DeviceScheduler::init()
+{
+    int deviceCount = 0;
+    CUresult result = cuDeviceGetCount(&deviceCount);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    if (deviceCount == 0)
+    {
+        return CUDA_ERROR_NO_DEVICE;
+    }
+    for (int i=0; i<deviceCount; i++)
+    {
+        SchedulerDevice *device = createDevice();
+        device->scheduler = this;
+        device->index = i;
+        devices.push_back(device);
+
+        CUdevice nativeDevice;
+        result = cuDeviceGet(&nativeDevice, i);
+        if (result != CUDA_SUCCESS)
+        {
+            return result;
+        }
+
+        // The new context is pushed on the stack of the calling
+        // thread. It is popped after the streams have been created.
+        result = cuCtxCreate(&device->context, contextFlags, nativeDevice);
+        if (result != CUDA_SUCCESS)
+        {
+            device->context = NULL;
+            return result;
+        }
+        ContextTracker::contextCreated(device->context);
+        result = createStreams(device);
+        CUcontext popped;
+        ContextTracker::popCurrent(&popped);
+        if (result != CUDA_SUCCESS)
+        {
+            return result;
+        }
+    }
+    for (size_t i=0; i<devices.size(); i++)
+    {
+        if (!devices[i]->thread.start(&DeviceScheduler::runWorker, devices[i]))
+        {
+            return CUDA_ERROR_UNKNOWN;
+        }
+    }
+    started = true;
+    return CUDA_SUCCESS;
+}
+
+int DeviceScheduler::getDeviceCount()
+{
+    return (int)devices.size();
+}
+
+CUcontext DeviceScheduler::getContext(int device)
+{
+    if (device < 0 || device >= (int)devices.size())
+    {
+        return NULL;
+    }
+    return devices[device]->context;
+}
+
+bool DeviceScheduler::isWorkerThread()
+{
+    return currentScheduler == this;
+}
+
+CUresult DeviceScheduler::synchronize()
+{
+    MutexLock lock(mutex);
+    while (pendingTasks > 0)
+    {
+        allCompleted.wait(mutex);
+    }
+    return CUDA_SUCCESS;
+}
+
+SchedulerTask* DeviceScheduler::createTask(TaskFunction function, TaskCleanupFunction cleanup,
+    void *userData, int references)
+{
+    return new SchedulerTask(function, cleanup, userData, references);
+}
+
+SchedulerDevice* DeviceScheduler::assign(int device)
+{
+    // Unbound tasks go to the device with the lowest load. The search
+    // starts at a different device each time, to break ties evenly.
+    SchedulerDevice *target = NULL;
+    if (device >= 0)
+    {
+        target = devices[device];
+    }
+    else
+    {
+        int n = (int)devices.size();
+        int start = (atomicAdd(&nextDevice, 1) & 0x7FFFFFFF) % n;
+        for (int i=0; i<n; i++)
+        {
+            SchedulerDevice *candidate = devices[(start + i) % n];
+            if (target == NULL || atomicLoad(&candidate->load) < atomicLoad(&target->load))
+            {
+                target = candidate;
+            }
+        }
+    }
+    atomicAdd(&target->load, 1);
+    return target;
+}
+
+void DeviceScheduler::runWorker(void *device)
+{
+    SchedulerDevice *d = (SchedulerDevice*)device;
+    DeviceScheduler *scheduler = d->scheduler;
+    currentScheduler = scheduler;
+    scheduler->work(d);
+    currentScheduler = NULL;
+    if (scheduler->workerExit != NULL)
+    {
+        scheduler->workerExit(NULL);
+    }
+}
+
+/**
+ * The main loop of the worker of the given device: Lets the scheduler
+ * complete and launch tasks. While tasks are running, the worker polls
+ * them in fixed intervals, and otherwise it waits until there is work.
+ * In both cases, it is woken up when a task is submitted.
+ */
+void DeviceScheduler::work(SchedulerDevice *device)
+{
+    ContextTracker::setCurrent(device->context);
+    while (true)
+    {
+        int runningCount = 0;
+        if (schedule(device, &runningCount))
+        {
+            continue;
+        }
+        MutexLock lock(mutex);
+        if (runningCount > 0)
+        {
+            workAvailable.waitMicros(mutex, SCHEDULER_POLL_INTERVAL_MICROS);
+            continue;
+        }
+        if (hasQueuedTasks(device))
+        {
+            continue;
+        }
+        if (stopping)
+        {
+            break;
+        }
+        workAvailable.wait(mutex);
+    }
+}
+
+bool DeviceScheduler::launch(SchedulerDevice *device, CUstream stream, SchedulerTask *task)
+{
+    atomicCompareAndSwap(&task->device, -1, device->index);
+
+    CUevent event = NULL;
+    CUresult result = CUDA_SUCCESS;
+    if (!device->idleEvents.empty())
+    {
+        event = device->idleEvents.back();
+        device->idleEvents.pop_back();
+    }
+    else
+    {
+        result = cuEventCreate(&event, CU_EVENT_DISABLE_TIMING);
+        if (result != CUDA_SUCCESS)
+        {
+            complete(device, task, result);
+            return false;
+        }
+    }
+    result = task->function(task->userData, device->index, device->context, stream);
+    if (result == CUDA_SUCCESS)
+    {
+        result = cuEventRecord(event, stream);
+    }
+    if (result != CUDA_SUCCESS)
+    {
+        device->idleEvents.push_back(event);
+        complete(device, task, result);
+        return false;
+    }
+    task->event = event;
+    return true;
+}
+
+int DeviceScheduler::poll(SchedulerDevice *device, std::vector<SchedulerTask*> &running)
+{
+    int runningCount = 0;
+    for (size_t slot=0; slot<running.size(); slot++)
+    {
+        SchedulerTask *task = running[slot];
+        if (task == NULL)
+        {
+            continue;
+        }
+        CUresult result = cuEventQuery(task->event);
+        if (result == CUDA_ERROR_NOT_READY)
+        {
+            runningCount++;
+            continue;
+        }
+        running[slot] = NULL;
+        device->idleEvents.push_back(task->event);
+        task->event = NULL;
+        complete(device, task, result);
+    }
+    return runningCount;
+}
+
+/**
+ * Completes the given task with the given result, and releases the
+ * reference of the scheduler
+ */
+void DeviceScheduler::complete(SchedulerDevice *device, SchedulerTask *task, CUresult result)
+{
+    if (task->cleanup != NULL)
+    {
+        task->cleanup(task->userData);
+    }
+    {
+        MutexLock lock(task->mutex);
+        task->result = result;
+        task->completed = true;
+        task->condition.broadcast();
+    }
+    atomicAdd(&device->load, -1);
+    atomicAdd(&device->executed, 1);
+    task->release();
+
+    MutexLock lock(mutex);
+    pendingTasks--;
+    if (pendingTasks == 0)
+    {
+        allCompleted.broadcast();
+    }
+}
+
+/**
+ * Destroys the context of the given device, which also destroys its
+ * streams and events, and deletes the device
+ */
+void DeviceScheduler::destroyDevice(SchedulerDevice *device)
+{
+    if (device->context != NULL)
+    {
+        if (contextDestroy != NULL)
+        {
+            contextDestroy(device->context);
+        }
+        else
+        {
+            cuCtxDestroy(device->context);
+            ContextTracker::contextDestroyed(device->context);
+        }
+    }
+    delete device;
+}
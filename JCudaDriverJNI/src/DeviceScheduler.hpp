@@ -0,0 +1,297 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef DEVICESCHEDULER
+#define DEVICESCHEDULER
+
+#include <cuda.h>
+#include <vector>
+#include "Threading.hpp"
+
+/**
+ * The time that a worker waits before polling its running tasks
+ * again, when it could not launch a new task, in microseconds
+ */
+#define SCHEDULER_POLL_INTERVAL_MICROS 50
+
+/**
+ * The function that executes a task. It is called by the worker thread
+ * of the device that the task was assigned to, with the context of
+ * this device being current, and should enqueue the work of the task
+ * asynchronously in the given stream. Returns CUDA_SUCCESS, or an
+ * error code that will be the result of the task.
+ */
+typedef CUresult (*TaskFunction)(void *userData, int device, CUcontext context, CUstream stream);
+
+/**
+ * The function that is called by the worker thread after a task has
+ * been completed, to release the user data
+ */
+typedef void (*TaskCleanupFunction)(void *userData);
+
+/**
+ * The function that destroys the contexts of a scheduler, so that
+ * all resources that are associated with them are released as well
+ */
+typedef CUresult (*ContextDestroyFunction)(CUcontext context);
+
+
+class DeviceScheduler;
+
+/**
+ * A task that was submitted to a DeviceScheduler
+ */
+class SchedulerTask
+{
+    public:
+
+        /**
+         * Returns CUDA_ERROR_NOT_READY if this task is not complete
+         * yet, and otherwise the result of the task
+         */
+        CUresult query();
+
+        /**
+         * Waits until this task is complete, and returns its result
+         */
+        CUresult synchronize();
+
+        /**
+         * Returns the device that executes this task, or -1 if it
+         * was not assigned to a device yet
+         */
+        int getDevice();
+
+        /**
+         * Releases the caller's reference to this task. The task is
+         * deleted when it is complete and has been released.
+         */
+        void release();
+
+    private:
+        friend class DeviceScheduler;
+
+        SchedulerTask(TaskFunction function, TaskCleanupFunction cleanup,
+            void *userData, int references);
+        ~SchedulerTask();
+
+        TaskFunction function;
+        TaskCleanupFunction cleanup;
+        void *userData;
+
+        volatile int device;
+        volatile int references;
+
+        /** The event that is recorded after the work of the task */
+        CUevent event;
+
+        /** The completion state, guarded by the mutex */
+        Mutex mutex;
+        ConditionVariable condition;
+        bool completed;
+        CUresult result;
+
+        SchedulerTask(const SchedulerTask&);
+        SchedulerTask& operator=(const SchedulerTask&);
+};
+
+
+/**
+ * The state of one device of a DeviceScheduler. Schedulers extend
+ * this with their streams and queues.
+ */
+struct SchedulerDevice
+{
+    SchedulerDevice();
+    virtual ~SchedulerDevice();
+
+    DeviceScheduler *scheduler;
+    int index;
+    CUcontext context;
+
+    /** The events that may be used for tasks */
+    std::vector<CUevent> idleEvents;
+
+    /** Guards the queues of the device */
+    Mutex queueMutex;
+
+    /** The number of queued and running tasks */
+    volatile int load;
+
+    /** The number of tasks that have been completed on this device */
+    volatile jcuda_int64 executed;
+
+    Thread thread;
+};
+
+
+/**
+ * The base of the schedulers that distribute tasks over all devices.
+ * For each device, it creates a context, the streams of the scheduler,
+ * and a worker thread. The worker thread launches the tasks of the
+ * device, and detects their completion with an event that is recorded
+ * in their stream after the task function returned. While tasks are
+ * running, it polls their events, and otherwise it waits until a task
+ * is submitted.
+ */
+class DeviceScheduler
+{
+    public:
+
+        /**
+         * Deletes this scheduler. The subclass has to call shutdown()
+         * in its destructor.
+         */
+        virtual ~DeviceScheduler();
+
+        /**
+         * Creates the contexts, streams and worker threads. The
+         * context stack of the calling thread is not modified.
+         */
+        CUresult init();
+
+        int getDeviceCount();
+
+        /**
+         * Returns the context of the given device, or NULL if the
+         * index is invalid
+         */
+        CUcontext getContext(int device);
+
+        /**
+         * Returns whether the calling thread is one of the worker
+         * threads of this scheduler, i.e. whether it is called from
+         * within a task function. The scheduler may not be destroyed
+         * from a worker thread.
+         */
+        bool isWorkerThread();
+
+        /**
+         * Waits until all submitted tasks are complete. This must not
+         * be called from within a task function.
+         */
+        CUresult synchronize();
+
+    protected:
+
+        /**
+         * Creates a new scheduler that creates contexts with the given
+         * flags. The given exit function, if not NULL, is called by each
+         * worker thread before it terminates. The given destroy function,
+         * if not NULL, is used for destroying the contexts.
+         */
+        DeviceScheduler(unsigned int contextFlags, ThreadFunction workerExit,
+            ContextDestroyFunction contextDestroy);
+
+        /**
+         * Waits for all tasks, stops the worker threads and destroys
+         * the contexts
+         */
+        void shutdown();
+
+        /**
+         * Creates a new task with the given number of references
+         */
+        static SchedulerTask* createTask(TaskFunction function, TaskCleanupFunction cleanup,
+            void *userData, int references);
+
+        /**
+         * Returns the given device, or the device with the lowest load
+         * if the given device is -1, and increments its load
+         */
+        SchedulerDevice* assign(int device);
+
+        /**
+         * Executes the function of the given task in the given stream,
+         * and records the completion event of the task. Returns whether
+         * the task is running. Otherwise, it has been completed.
+         */
+        bool launch(SchedulerDevice *device, CUstream stream, SchedulerTask *task);
+
+        /**
+         * Completes all given running tasks whose events have been
+         * reached, sets their entries to NULL, and returns the number
+         * of tasks that are still running
+         */
+        int poll(SchedulerDevice *device, std::vector<SchedulerTask*> &running);
+
+        /**
+         * Creates the state of one device
+         */
+        virtual SchedulerDevice* createDevice() = 0;
+
+        /**
+         * Creates the streams for the given device, whose context
+         * is current
+         */
+        virtual CUresult createStreams(SchedulerDevice *device) = 0;
+
+        /**
+         * Completes the finished tasks of the given device and launches
+         * new ones. Stores the number of running tasks in the given
+         * pointer, and returns whether any task was launched.
+         */
+        virtual bool schedule(SchedulerDevice *device, int *runningCount) = 0;
+
+        /**
+         * Returns whether there are tasks that the given device could
+         * launch. This is called while the mutex is held.
+         */
+        virtual bool hasQueuedTasks(SchedulerDevice *device) = 0;
+
+        std::vector<SchedulerDevice*> devices;
+
+        /** Guards the waiting for work and for completion */
+        Mutex mutex;
+        ConditionVariable workAvailable;
+        ConditionVariable allCompleted;
+
+        /** The number of tasks that have not been completed */
+        volatile int pendingTasks;
+
+        bool started;
+
+    private:
+        unsigned int contextFlags;
+        ThreadFunction workerExit;
+        ContextDestroyFunction contextDestroy;
+        volatile int stopping;
+
+        /** The device that the search for the lowest load starts at */
+        volatile int nextDevice;
+
+        static void runWorker(void *device);
+        void work(SchedulerDevice *device);
+        void complete(SchedulerDevice *device, SchedulerTask *task, CUresult result);
+        void destroyDevice(SchedulerDevice *device);
+
+        DeviceScheduler(const DeviceScheduler&);
+        DeviceScheduler& operator=(const DeviceScheduler&);
+};
+
+
+#endif
@@ -0,0 +1,547 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "IpcRegistry.hpp"
+#include "ContextTracker.hpp"
+#include "Logger.hpp"
+
+/**
+ * The number of attempts to wait for the creator of a segment to
+ * initialize it, and the time between the attempts, in microseconds
+ */
+#define IPC_ATTACH_ATTEMPTS 1000
+#define IPC_ATTACH_INTERVAL 1000
+
+/** The number of attempts to read a slot that is being written */
+#define IPC_READ_ATTEMPTS 100
+
+
+IpcRegistry::IpcRegistry(int maxIdle)
+{
+    this->maxIdle = maxIdle;
+    idleCount = 0;
+    header = NULL;
+    slots = NULL;
+    attachment = -1;
+    openCount = 0;
+    hitCount = 0;
+}
+
+IpcRegistry::~IpcRegistry()
+{
+    if (header != NULL)
+    {
+        std::vector<std::string> names = publishedNames;
+        for (size_t i=0; i<names.size(); i++)
+        {
+            unpublish(names[i].c_str());
+        }
+    }
+    idle.clear();
+    while (!entries.empty())
+    {
+        close(entries.begin()->second);
+    }
+    if (header != NULL)
+    {
+        atomicCompareAndSwap(&header->attachments[attachment], SharedMemory::getProcessId(), 0);
+        reap();
+        bool last = true;
+        for (int i=0; i<IPC_MAX_ATTACHMENTS; i++)
+        {
+            if (atomicLoad(&header->attachments[i]) != 0)
+            {
+                last = false;
+                break;
+            }
+        }
+        segment.close();
+        if (last)
+        {
+            SharedMemory::unlink(segmentName.c_str());
+        }
+    }
+}
+
+CUresult IpcRegistry::attach(const char *segmentName, int slotCount)
+{
+    if (header != NULL || slotCount <= 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    size_t size = sizeof(IpcSegmentHeader) + (size_t)slotCount * sizeof(IpcSegmentSlot);
+    bool created = false;
+    int error = segment.open(segmentName, size, &created);
+    if (error != 0)
+    {
+        Logger::log(LOG_ERROR, "Could not open shared memory segment %s, error %d\n", segmentName, error);
+        return CUDA_ERROR_OPERATING_SYSTEM;
+    }
+    IpcSegmentHeader *h = (IpcSegmentHeader*)segment.getPointer();
+    if (created)
+    {
+        h->version = IPC_SEGMENT_VERSION;
+        h->slotCount = slotCount;
+        atomicCompareAndSwap(&h->magic, 0, IPC_SEGMENT_MAGIC);
+    }
+    else
+    {
+        for (int i=0; i<IPC_ATTACH_ATTEMPTS; i++)
+        {
+            if (atomicLoad(&h->magic) == IPC_SEGMENT_MAGIC)
+            {
+                break;
+            }
+            Thread::sleepMicros(IPC_ATTACH_INTERVAL);
+        }
+        size_t requiredSize = sizeof(IpcSegmentHeader) + (size_t)h->slotCount * sizeof(IpcSegmentSlot);
+        if (atomicLoad(&h->magic) != IPC_SEGMENT_MAGIC ||
+            h->version != IPC_SEGMENT_VERSION || segment.getSize() < requiredSize)
+        {
+            Logger::log(LOG_ERROR, "Invalid shared memory segment %s\n", segmentName);
+            segment.close();
+            return CUDA_ERROR_OPERATING_SYSTEM;
+        }
+    }
+    header = h;
+    slots = (IpcSegmentSlot*)(h + 1);
+
+    // Reclaim the attachments of processes that terminated without
+    // detaching, so that the segment does not run out of them
+    reap();
+    int processId = SharedMemory::getProcessId();
+    for (int i=0; i<IPC_MAX_ATTACHMENTS; i++)
+    {
+        if (atomicCompareAndSwap(&h->attachments[i], 0, processId))
+        {
+            attachment = i;
+            break;
+        }
+    }
+    if (attachment == -1)
+    {
+        Logger::log(LOG_ERROR, "Too many registries attached to shared memory segment %s\n", segmentName);
+        header = NULL;
+        slots = NULL;
+        segment.close();
+        return CUDA_ERROR_OUT_OF_MEMORY;
+    }
+    this->segmentName = segmentName;
+    return CUDA_SUCCESS;
+}
+
+CUresult IpcRegistry::open(const CUipcMemHandle &handle, unsigned int flags, CUdeviceptr *dptr)
+{
+    Key key;
+    key.handle = handle;
+    CUresult result = cuCtxGetCurrent(&key.context);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    if (key.context == NULL)
+    {
+        return CUDA_ERROR_INVALID_CONTEXT;
+    }
+
+    // The same handle may not be opened twice in one context. So the
+    // entry is inserted before the handle is opened, and other threads
+    // that open the same handle wait until the entry is complete. The
+    // handle itself is opened without holding the lock.
+    Entry *entry = NULL;
+    {
+        MutexLock lock(mutex);
+        std::map<Key, Entry*>::iterator it = entries.find(key);
+        while (it != entries.end() && it->second->opening)
+        {
+            openCompleted.wait(mutex);
+            it = entries.find(key);
+        }
+        if (it != entries.end())
+        {
+            entry = it->second;
+            if (entry->references == 0)
+            {
+                idle.erase(entry->idlePosition);
+                idleCount--;
+            }
+            entry->references++;
+            *dptr = entry->dptr;
+            atomicAdd(&hitCount, 1);
+            return CUDA_SUCCESS;
+        }
+        entry = new Entry();
+        entry->key = key;
+        entry->dptr = 0;
+        entry->references = 1;
+        entry->opening = true;
+        entries[key] = entry;
+    }
+    CUdeviceptr opened = 0;
+    result = cuIpcOpenMemHandle(&opened, handle, flags);
+
+    MutexLock lock(mutex);
+    if (result != CUDA_SUCCESS)
+    {
+        entries.erase(key);
+        delete entry;
+    }
+    else
+    {
+        entry->dptr = opened;
+        entry->opening = false;
+        pointers[opened] = entry;
+        atomicAdd(&openCount, 1);
+        *dptr = opened;
+    }
+    openCompleted.broadcast();
+    return result;
+}
+
+CUresult IpcRegistry::release(CUdeviceptr dptr)
+{
+    MutexLock lock(mutex);
+    std::map<CUdeviceptr, Entry*>::iterator it = pointers.find(dptr);
+    if (it == pointers.end() || it->second->references == 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    Entry *entry = it->second;
+    entry->references--;
+    if (entry->references > 0)
+    {
+        return CUDA_SUCCESS;
+    }
+    idle.push_back(entry);
+    entry->idlePosition = --idle.end();
+    idleCount++;
+    CUresult result = CUDA_SUCCESS;
+    while (idleCount > maxIdle)
+    {
+        Entry *oldest = idle.front();
+        idle.pop_front();
+        idleCount--;
+        CUresult closeResult = close(oldest);
+        if (closeResult != CUDA_SUCCESS)
+        {
+            result = closeResult;
+        }
+    }
+    return result;
+}
+
+void IpcRegistry::removeContext(CUcontext context)
+{
+    MutexLock lock(mutex);
+    std::vector<Entry*> removed;
+    for (std::map<Key, Entry*>::iterator it = entries.begin(); it != entries.end(); ++it)
+    {
+        if (it->second->key.context == context && !it->second->opening)
+        {
+            removed.push_back(it->second);
+        }
+    }
+    for (size_t i=0; i<removed.size(); i++)
+    {
+        Entry *entry = removed[i];
+        if (entry->references == 0)
+        {
+            idle.erase(entry->idlePosition);
+            idleCount--;
+        }
+        close(entry);
+    }
+}
+
+CUresult IpcRegistry::trim()
+{
+    MutexLock lock(mutex);
+    CUresult result = CUDA_SUCCESS;
+    while (!idle.empty())
+    {
+        Entry *entry = idle.front();
+        idle.pop_front();
+        idleCount--;
+        CUresult closeResult = close(entry);
+        if (closeResult != CUDA_SUCCESS)
+        {
+            result = closeResult;
+        }
+    }
+    return result;
+}
+
+/**
+ * Closes the handle of the given entry in the context that it was
+ * opened in, and deletes the entry. The entry must not be contained
+ * in the idle list.
+ */
+CUresult IpcRegistry::close(Entry *entry)
+{
+    CUresult result = CUDA_SUCCESS;
+    {
+        ContextScope scope(entry->key.context);
+        result = scope.getResult();
+        if (result == CUDA_SUCCESS)
+        {
+            result = cuIpcCloseMemHandle(entry->dptr);
+        }
+    }
+    entries.erase(entry->key);
+    pointers.erase(entry->dptr);
+    delete entry;
+    return result;
+}
+
+CUresult IpcRegistry::publish(const char *name, CUdeviceptr dptr, size_t size)
+{
+    if (header == NULL)
+    {
+        return CUDA_ERROR_NOT_INITIALIZED;
+    }
+    size_t nameLength = strlen(name);
+    if (nameLength == 0 || nameLength >= IPC_NAME_LENGTH)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    CUipcMemHandle handle;
+    CUresult result = cuIpcGetMemHandle(&handle, dptr);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    CUdevice device;
+    if (cuCtxGetDevice(&device) != CUDA_SUCCESS)
+    {
+        device = -1;
+    }
+    IpcSegmentSlot *slot = claimSlot(name);
+    if (slot == NULL)
+    {
+        return CUDA_ERROR_OUT_OF_MEMORY;
+    }
+    atomicAdd(&slot->sequence, 1);
+    slot->processId = SharedMemory::getProcessId();
+    slot->device = (int)device;
+    slot->size = (jcuda_int64)size;
+    memset(slot->name, 0, IPC_NAME_LENGTH);
+    memcpy(slot->name, name, nameLength);
+    slot->handle = handle;
+    atomicAdd(&slot->sequence, 1);
+    atomicCompareAndSwap(&slot->state, IPC_SLOT_BUSY, IPC_SLOT_PUBLISHED);
+
+    MutexLock lock(mutex);
+    for (size_t i=0; i<publishedNames.size(); i++)
+    {
+        if (publishedNames[i] == name)
+        {
+            return CUDA_SUCCESS;
+        }
+    }
+    publishedNames.push_back(name);
+    return CUDA_SUCCESS;
+}
+
+CUresult IpcRegistry::unpublish(const char *name)
+{
+    if (header == NULL)
+    {
+        return CUDA_ERROR_NOT_INITIALIZED;
+    }
+    int processId = SharedMemory::getProcessId();
+    bool found = false;
+    for (int i=0; i<header->slotCount; i++)
+    {
+        IpcSegmentSlot *slot = &slots[i];
+        IpcSegmentSlot copy;
+        if (!readSlot(slot, &copy) || copy.processId != processId ||
+            strncmp(copy.name, name, IPC_NAME_LENGTH) != 0)
+        {
+            continue;
+        }
+        if (atomicCompareAndSwap(&slot->state, IPC_SLOT_PUBLISHED, IPC_SLOT_BUSY))
+        {
+            atomicAdd(&slot->sequence, 1);
+            memset(slot->name, 0, IPC_NAME_LENGTH);
+            slot->processId = 0;
+            atomicAdd(&slot->sequence, 1);
+            atomicCompareAndSwap(&slot->state, IPC_SLOT_BUSY, IPC_SLOT_FREE);
+            found = true;
+        }
+    }
+
+    MutexLock lock(mutex);
+    for (size_t i=0; i<publishedNames.size(); i++)
+    {
+        if (publishedNames[i] == name)
+        {
+            publishedNames.erase(publishedNames.begin() + i);
+            break;
+        }
+    }
+    return found ? CUDA_SUCCESS : CUDA_ERROR_NOT_FOUND;
+}
+
+CUresult IpcRegistry::lookup(const char *name, CUipcMemHandle *handle, size_t *size, int *device)
+{
+    if (header == NULL)
+    {
+        return CUDA_ERROR_NOT_INITIALIZED;
+    }
+    for (int i=0; i<header->slotCount; i++)
+    {
+        IpcSegmentSlot copy;
+        if (readSlot(&slots[i], &copy) && strncmp(copy.name, name, IPC_NAME_LENGTH) == 0)
+        {
+            *handle = copy.handle;
+            *size = (size_t)copy.size;
+            *device = copy.device;
+            return CUDA_SUCCESS;
+        }
+    }
+    return CUDA_ERROR_NOT_FOUND;
+}
+
+CUresult IpcRegistry::openPublished(const char *name, unsigned int flags, CUdeviceptr *dptr, size_t *size)
+{
+    CUipcMemHandle handle;
+    int device;
+    CUresult result = lookup(name, &handle, size, &device);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    return open(handle, flags, dptr);
+}
+
+void IpcRegistry::getStatistics(jcuda_int64 *opened, jcuda_int64 *hits)
+{
+    *opened = atomicLoad(&openCount);
+    *hits = atomicLoad(&hitCount);
+}
+
+/**
+ * Claims the slot that contains the handle that was published under
+ * the given name, or a free slot. Returns NULL if all slots are used.
+ */
+IpcSegmentSlot* IpcRegistry::claimSlot(const char *name)
+{
+    for (int i=0; i<header->slotCount; i++)
+    {
+        IpcSegmentSlot *slot = &slots[i];
+        IpcSegmentSlot copy;
+        if (readSlot(slot, &copy) && strncmp(copy.name, name, IPC_NAME_LENGTH) == 0 &&
+            atomicCompareAndSwap(&slot->state, IPC_SLOT_PUBLISHED, IPC_SLOT_BUSY))
+        {
+            return slot;
+        }
+    }
+    for (int attempt=0; attempt<2; attempt++)
+    {
+        for (int i=0; i<header->slotCount; i++)
+        {
+            IpcSegmentSlot *slot = &slots[i];
+            if (atomicCompareAndSwap(&slot->state, IPC_SLOT_FREE, IPC_SLOT_BUSY))
+            {
+                return slot;
+            }
+        }
+
+        // All slots are used: Free the slots of terminated processes
+        // and try again
+        reap();
+    }
+    return NULL;
+}
+
+/**
+ * Copies the contents of the given slot, if it contains a published
+ * handle. Returns whether a consistent copy could be made.
+ */
+bool IpcRegistry::readSlot(IpcSegmentSlot *slot, IpcSegmentSlot *copy)
+{
+    for (int i=0; i<IPC_READ_ATTEMPTS; i++)
+    {
+        if (atomicLoad(&slot->state) != IPC_SLOT_PUBLISHED)
+        {
+            return false;
+        }
+        int before = atomicLoad(&slot->sequence);
+        if ((before & 1) == 0)
+        {
+            memcpy(copy, (const void*)slot, sizeof(IpcSegmentSlot));
+            int after = atomicLoad(&slot->sequence);
+            if (before == after)
+            {
+                return atomicLoad(&slot->state) == IPC_SLOT_PUBLISHED;
+            }
+        }
+        Thread::yield();
+    }
+    return false;
+}
+
+
+/**
+ * Frees the attachments and the slots of processes that terminated
+ * without detaching from the segment or unpublishing their handles
+ */
+void IpcRegistry::reap()
+{
+    for (int i=0; i<IPC_MAX_ATTACHMENTS; i++)
+    {
+        int processId = atomicLoad(&header->attachments[i]);
+        if (processId != 0 && !SharedMemory::isProcessAlive(processId))
+        {
+            Logger::log(LOG_DEBUG, "Reclaiming attachment of terminated process %d\n", processId);
+            atomicCompareAndSwap(&header->attachments[i], processId, 0);
+        }
+    }
+    for (int i=0; i<header->slotCount; i++)
+    {
+        IpcSegmentSlot *slot = &slots[i];
+        IpcSegmentSlot copy;
+        if (!readSlot(slot, &copy) || SharedMemory::isProcessAlive(copy.processId))
+        {
+            continue;
+        }
+        if (atomicCompareAndSwap(&slot->state, IPC_SLOT_PUBLISHED, IPC_SLOT_BUSY))
+        {
+            // The slot may have been replaced since it was read
+            if (slot->processId != copy.processId)
+            {
+                atomicCompareAndSwap(&slot->state, IPC_SLOT_BUSY, IPC_SLOT_PUBLISHED);
+                continue;
+            }
+            atomicAdd(&slot->sequence, 1);
+            memset(slot->name, 0, IPC_NAME_LENGTH);
+            slot->processId = 0;
+            atomicAdd(&slot->sequence, 1);
+            atomicCompareAndSwap(&slot->state, IPC_SLOT_BUSY, IPC_SLOT_FREE);
+        }
+    }
+}
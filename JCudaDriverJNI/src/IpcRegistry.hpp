@@ -0,0 +1,263 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef IPCREGISTRY
+#define IPCREGISTRY
+
+#include <cuda.h>
+#include <cstring>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+#include "Threading.hpp"
+#include "SharedMemory.hpp"
+
+/** The maximum length of a published name, including the terminating 0 */
+#define IPC_NAME_LENGTH 64
+
+/** The value of IpcSegmentHeader::magic of an initialized segment */
+#define IPC_SEGMENT_MAGIC 0x4A435043
+
+#define IPC_SEGMENT_VERSION 2
+
+/** The maximum number of registries that may be attached to a segment */
+#define IPC_MAX_ATTACHMENTS 64
+
+/** The states of an IpcSegmentSlot */
+#define IPC_SLOT_FREE 0
+#define IPC_SLOT_BUSY 1
+#define IPC_SLOT_PUBLISHED 2
+
+/**
+ * The header of the shared memory segment of an IpcRegistry. It is
+ * followed by slotCount instances of IpcSegmentSlot.
+ */
+struct IpcSegmentHeader
+{
+    /** IPC_SEGMENT_MAGIC, written after the header was initialized */
+    volatile int magic;
+    int version;
+    int slotCount;
+
+    /**
+     * The IDs of the processes of the registries that are attached to
+     * the segment, or 0 for unused entries. The entries of processes
+     * that terminated without detaching are reclaimed when another
+     * registry attaches to the segment.
+     */
+    volatile int attachments[IPC_MAX_ATTACHMENTS];
+};
+
+/**
+ * A slot for one published handle in the shared memory segment. A slot
+ * is claimed by switching its state from IPC_SLOT_FREE (or, to replace
+ * an entry, IPC_SLOT_PUBLISHED) to IPC_SLOT_BUSY. The sequence number
+ * is odd while the contents are written, so that readers can detect
+ * that their copy of the contents is torn.
+ */
+struct IpcSegmentSlot
+{
+    volatile int state;
+    volatile int sequence;
+
+    /** The process that published the handle */
+    int processId;
+
+    /** The ordinal of the device of the memory */
+    int device;
+
+    /** The size of the memory, in bytes */
+    jcuda_int64 size;
+
+    char name[IPC_NAME_LENGTH];
+    CUipcMemHandle handle;
+};
+
+
+/**
+ * A registry for IPC memory handles.<br />
+ * <br />
+ * Handles that are opened through the registry are deduplicated by the
+ * bytes of the handle and the current context: Opening a handle that is
+ * already open only increments a reference count. When the last
+ * reference is released, the handle is not closed immediately, but kept
+ * for re-use, until more than the given maximum number of released
+ * handles are kept, or the registry is trimmed.<br />
+ * <br />
+ * A registry may be attached to a named shared memory segment. Handles
+ * may then be published under a name, so that other processes on the
+ * same node can look them up and open them, without exchanging the
+ * handle bytes themself.
+ */
+class IpcRegistry
+{
+    public:
+
+        /**
+         * Creates a registry that keeps at most the given number of
+         * released handles open
+         */
+        IpcRegistry(int maxIdle);
+
+        /**
+         * Closes all handles that have been opened by this registry,
+         * unpublishes all handles that have been published by it,
+         * and detaches from the segment
+         */
+        ~IpcRegistry();
+
+        /**
+         * Attaches this registry to the shared memory segment with the
+         * given name, creating it with the given number of slots if it
+         * does not exist yet
+         */
+        CUresult attach(const char *segmentName, int slotCount);
+
+        /**
+         * Opens the given handle in the current context, or returns the
+         * pointer for the handle if it is already open in this context
+         */
+        CUresult open(const CUipcMemHandle &handle, unsigned int flags, CUdeviceptr *dptr);
+
+        /**
+         * Releases one reference to the pointer that was returned by open
+         */
+        CUresult release(CUdeviceptr dptr);
+
+        /**
+         * Closes all handles that have been opened in the given context,
+         * regardless of their references. This is called before the
+         * context is destroyed.
+         */
+        void removeContext(CUcontext context);
+
+        /**
+         * Closes all handles that are no longer referenced
+         */
+        CUresult trim();
+
+        /**
+         * Publishes the handle of the given memory under the given name,
+         * replacing any handle that was published under the same name
+         */
+        CUresult publish(const char *name, CUdeviceptr dptr, size_t size);
+
+        /**
+         * Removes the handle that was published under the given name
+         * by this process
+         */
+        CUresult unpublish(const char *name);
+
+        /**
+         * Looks up the handle that was published under the given name.
+         * Returns CUDA_ERROR_NOT_FOUND if there is no such handle.
+         */
+        CUresult lookup(const char *name, CUipcMemHandle *handle, size_t *size, int *device);
+
+        /**
+         * Looks up the handle that was published under the given
+         * name, and opens it like open
+         */
+        CUresult openPublished(const char *name, unsigned int flags, CUdeviceptr *dptr, size_t *size);
+
+        /**
+         * Obtains the number of handles that have actually been opened,
+         * and the number of opens that have been served from the cache
+         */
+        void getStatistics(jcuda_int64 *opened, jcuda_int64 *hits);
+
+    private:
+
+        /** The key of an opened handle */
+        struct Key
+        {
+            CUipcMemHandle handle;
+            CUcontext context;
+
+            bool operator<(const Key &other) const
+            {
+                if (context != other.context)
+                {
+                    return context < other.context;
+                }
+                return memcmp(handle.reserved, other.handle.reserved, CU_IPC_HANDLE_SIZE) < 0;
+            }
+        };
+
+        /** An opened handle */
+        struct Entry
+        {
+            Key key;
+            CUdeviceptr dptr;
+            int references;
+
+            /** Whether the handle is currently being opened */
+            bool opening;
+
+            /** The position in the idle list, if references is 0 */
+            std::list<Entry*>::iterator idlePosition;
+        };
+
+        int maxIdle;
+        Mutex mutex;
+
+        /** Signalled when an entry has been opened, or failed to open */
+        ConditionVariable openCompleted;
+
+        std::map<Key, Entry*> entries;
+        std::map<CUdeviceptr, Entry*> pointers;
+
+        /** The released entries, the least recently released first */
+        std::list<Entry*> idle;
+        int idleCount;
+
+        SharedMemory segment;
+        std::string segmentName;
+        IpcSegmentHeader *header;
+        IpcSegmentSlot *slots;
+
+        /** The index of the attachment of this registry in the header */
+        int attachment;
+
+        /** The names that have been published by this registry */
+        std::vector<std::string> publishedNames;
+
+        volatile jcuda_int64 openCount;
+        volatile jcuda_int64 hitCount;
+
+        CUresult close(Entry *entry);
+        IpcSegmentSlot* claimSlot(const char *name);
+        bool readSlot(IpcSegmentSlot *slot, IpcSegmentSlot *copy);
+        void reap();
+
+        IpcRegistry(const IpcRegistry&);
+        IpcRegistry& operator=(const IpcRegistry&);
+};
+
+
+#endif
@@ -27,6 +27,31 @@
 
 #include "JCudaDriver.hpp"
 #include "JCudaDriver_common.hpp"
+#include "AllocationRegistry.hpp"
+#include "BounceRing.hpp"
+#include "CompletionService.hpp"
+#include "HostArena.hpp"
+#include "IpcRegistry.hpp"
+#include "LinkCache.hpp"
+#include "MemoryGovernor.hpp"
+#include "ModuleLoader.hpp"
+#include "NumaPlacement.hpp"
+#include "Occupancy.hpp"
+#include "OperationGraph.hpp"
+#include "PeerRouter.hpp"
+#include "PitchPacker.hpp"
+#include "PriorityScheduler.hpp"
+#include "RangeProfiler.hpp"
+#include "RegistrationCache.hpp"
+#include "ContextTracker.hpp"
+#include "CopyRect.hpp"
+#include "DeviceSnapshot.hpp"
+#include "ResourcePools.hpp"
+#include "SymbolStaging.hpp"
+#include "TaskScheduler.hpp"
+#include "TransferEngine.hpp"
+#include <cstddef>
+#include <cstdio>
 #include <cstring>
 #include <string>
 
@@ -164,11 +189,387 @@ jfieldID CUDA_TEXTURE_DESC_mipmapLevelBias; // float
 jfieldID CUDA_TEXTURE_DESC_minMipmapLevelClamp; // float
 jfieldID CUDA_TEXTURE_DESC_maxMipmapLevelClamp; // float
 
+jfieldID CUmemHostArenaStatistics_reservedBytes; // long
+jfieldID CUmemHostArenaStatistics_usedBytes; // long
+jfieldID CUmemHostArenaStatistics_requestedBytes; // long
+jfieldID CUmemHostArenaStatistics_highWaterMark; // long
+jfieldID CUmemHostArenaStatistics_regionCount; // long
+jfieldID CUmemHostArenaStatistics_fragmentation; // float
+
+jfieldID CUtransferStatistics_transferCount; // long
+jfieldID CUtransferStatistics_bytes; // long
+jfieldID CUtransferStatistics_elapsedTime; // double
+jfieldID CUtransferStatistics_bandwidth; // double
+
+jfieldID CUdeviceSnapshot_buffer; // ByteBuffer
+
+// Field IDs for the CUmemcpyDescriptor class
+jfieldID CUmemcpyDescriptor_buffer; // ByteBuffer
+jfieldID CUmemcpyDescriptor_offsets; // int[]
+jfieldID CUmemcpyDescriptor_sizeTSize; // int
+
+jfieldID CUoccupancy_blockSize; // int
+jfieldID CUoccupancy_dynamicSharedMemBytes; // int
+jfieldID CUoccupancy_maxDynamicSharedMemBytes; // int
+jfieldID CUoccupancy_activeBlocksPerMultiprocessor; // int
+jfieldID CUoccupancy_activeWarpsPerMultiprocessor; // int
+jfieldID CUoccupancy_occupancy; // float
+jfieldID CUoccupancy_limitingFactor; // int
+jfieldID CUoccupancy_elapsedTime; // float
+
 
 
 jclass CUdevice_class;
 jmethodID CUdevice_constructor;
 
+jclass CUcontext_class;
+jmethodID CUcontext_constructor;
+
+jclass CUstream_class;
+jmethodID CUstream_constructor;
+
+jclass CUdeviceptr_class;
+
+jfieldID CUfunction_future; // CUmoduleFuture
+jfieldID CUfunction_name; // String
+
+jmethodID CUtaskCallback_call; // (ILjcuda/driver/CUcontext;Ljcuda/driver/CUstream;Ljava/lang/Object;)V
+
+jmethodID CUevictionCallback_evict; // (IJLjava/lang/Object;)J
+
+jmethodID EventFuture_complete; // (I)V
+
+jmethodID Buffer_capacity; // ()I
+
+// The buffer classes and their element sizes, for determining
+// the sizes of kernel parameters that are captured in graphs
+#define BUFFER_CLASS_COUNT 7
+jclass bufferClasses[BUFFER_CLASS_COUNT];
+size_t bufferElementSizes[BUFFER_CLASS_COUNT];
+
+// The VM, for attaching native worker threads
+JavaVM *globalJvm = NULL;
+
+/**
+ * Returns the JNIEnv of the calling thread, attaching the thread
+ * to the VM as a daemon thread if necessary
+ */
+JNIEnv* getTaskWorkerEnv()
+{
+    JNIEnv *env = NULL;
+    if (globalJvm->GetEnv((void **)&env, JNI_VERSION_1_4) == JNI_EDETACHED)
+    {
+        if (globalJvm->AttachCurrentThreadAsDaemon((void **)&env, NULL) != JNI_OK)
+        {
+            Logger::log(LOG_ERROR, "Could not attach task worker thread\n");
+            return NULL;
+        }
+    }
+    return env;
+}
+
+/**
+ * The exit function of the task worker threads
+ */
+void detachTaskWorker(void * /*argument*/)
+{
+    JNIEnv *env = NULL;
+    if (globalJvm->GetEnv((void **)&env, JNI_VERSION_1_4) == JNI_OK)
+    {
+        globalJvm->DetachCurrentThread();
+    }
+}
+
+/**
+ * The registry of all allocations that are made through the
+ * driver API bindings
+ */
+AllocationRegistry allocationRegistry;
+
+/**
+ * Records the given allocation in the allocationRegistry, for the
+ * device and the context that are current for the calling thread.
+ * The context and device are only queried if the registry is active.
+ */
+void registerAllocation(void *pointer, size_t size, int kind)
+{
+    if (!allocationRegistry.isActive())
+    {
+        return;
+    }
+    CUcontext context = NULL;
+    CUdevice device = -1;
+    if (cuCtxGetCurrent(&context) != CUDA_SUCCESS ||
+        cuCtxGetDevice(&device) != CUDA_SUCCESS)
+    {
+        device = -1;
+    }
+    allocationRegistry.add(pointer, size, kind, (int)device, context);
+}
+
+/**
+ * Returns the device of the context that is current for the calling
+ * thread, or -1 if there is no current context
+ */
+int getCurrentDevice()
+{
+    CUdevice device = -1;
+    if (cuCtxGetDevice(&device) != CUDA_SUCCESS)
+    {
+        return -1;
+    }
+    return (int)device;
+}
+
+/**
+ * Looks up the given pointer in the allocationRegistry, activating
+ * the registry if necessary. If it is not found, but the given Java
+ * pointer object refers to a buffer or an array, then the kind is
+ * set to ALLOCATION_KIND_PAGEABLE.
+ */
+void lookupAllocation(JNIEnv *env, jobject pointerObject, void *pointer, AllocationInfo *info)
+{
+    allocationRegistry.activate();
+    if (!allocationRegistry.lookup(pointer, info))
+    {
+        if (isPointerBackedByBuffer(env, pointerObject))
+        {
+            info->kind = ALLOCATION_KIND_PAGEABLE;
+        }
+    }
+}
+
+
+/**
+ * Resolves the native function of the given CUfunction object, as
+ * described for getNativeFunction. The caller must hold the monitor
+ * of the object.
+ */
+int resolveNativeFunction(JNIEnv *env, jobject function, CUfunction *nativeFunction)
+{
+    // Another thread may have resolved the function in the meantime
+    *nativeFunction = (CUfunction)getNativePointerValue(env, function);
+    if (*nativeFunction != NULL)
+    {
+        return CUDA_SUCCESS;
+    }
+    jobject future = env->GetObjectField(function, CUfunction_future);
+    if (future == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    ModuleFuture *nativeFuture = (ModuleFuture*)getNativePointerValue(env, future);
+    env->DeleteLocalRef(future);
+    if (nativeFuture == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    jstring name = (jstring)env->GetObjectField(function, CUfunction_name);
+    char *nativeName = convertString(env, name);
+    env->DeleteLocalRef(name);
+    if (nativeName == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_DEBUG, "Resolving function %s\n", nativeName);
+    CUresult result = nativeFuture->getFunction(nativeName, nativeFunction);
+    delete[] nativeName;
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    setNativePointerValue(env, function, (jlong)*nativeFunction);
+    env->SetObjectField(function, CUfunction_future, NULL);
+    env->SetObjectField(function, CUfunction_name, NULL);
+    return CUDA_SUCCESS;
+}
+
+/**
+ * Obtains the native function of the given CUfunction object. If the
+ * object was obtained with cuModuleFutureGetFunction and was not used
+ * yet, then the function is looked up in the module of its future,
+ * which waits until the module is loaded, and the object is updated
+ * to refer to the native function. If the object neither refers to
+ * a native function nor to a future, then CUDA_ERROR_INVALID_HANDLE
+ * is returned. This is used for all functions that receive a CUfunction.
+ */
+int getNativeFunction(JNIEnv *env, jobject function, CUfunction *nativeFunction)
+{
+    *nativeFunction = (CUfunction)getNativePointerValue(env, function);
+    if (*nativeFunction != NULL || function == NULL)
+    {
+        return CUDA_SUCCESS;
+    }
+
+    // The same object may be resolved by several threads at once, so
+    // the resolution is done while holding the monitor of the object
+    if (env->MonitorEnter(function) != JNI_OK)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    int result = resolveNativeFunction(env, function, nativeFunction);
+    if (env->MonitorExit(function) != JNI_OK)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    return result;
+}
+
+
+/**
+ * Obtains the address of the host memory that the given pointer refers
+ * to, for an operation that is captured in an OperationGraph. Since the
+ * memory is accessed when the graph is launched, only pointers to native
+ * memory (including direct buffers) are supported. For all other
+ * pointers, the address will be 0. Returns false if an error occurred.
+ */
+bool getCapturedHostAddress(JNIEnv *env, jobject pointerObject, CUdeviceptr *address)
+{
+    *address = 0;
+    if (!isPointerBackedByNativeMemory(env, pointerObject))
+    {
+        Logger::log(LOG_ERROR, "Only pointers to native host memory may be captured\n");
+        return true;
+    }
+    PointerData *pointerData = initPointerData(env, pointerObject);
+    if (pointerData == NULL)
+    {
+        return false;
+    }
+    *address = (CUdeviceptr)(size_t)pointerData->getPointer(env);
+    return releasePointerData(env, pointerData, JNI_ABORT);
+}
+
+/**
+ * Computes the size of the value that the given kernel parameter
+ * pointer refers to. This is the size of the array of pointers or
+ * the remaining size of the buffer that the pointer was created for.
+ * Returns false if the size can not be determined.
+ */
+bool getKernelParamSize(JNIEnv *env, jobject param, size_t *size)
+{
+    if (param == NULL)
+    {
+        return false;
+    }
+    jlong byteOffset = env->GetLongField(param, Pointer_byteOffset);
+    jobjectArray pointers = (jobjectArray)env->GetObjectField(param, Pointer_pointers);
+    if (pointers != NULL)
+    {
+        *size = (size_t)env->GetArrayLength(pointers) * sizeof(void*) - (size_t)byteOffset;
+        return true;
+    }
+    jobject buffer = env->GetObjectField(param, Pointer_buffer);
+    if (buffer == NULL)
+    {
+        return false;
+    }
+    jint capacity = env->CallIntMethod(buffer, Buffer_capacity);
+    if (env->ExceptionCheck())
+    {
+        return false;
+    }
+    for (int i=0; i<BUFFER_CLASS_COUNT; i++)
+    {
+        if (env->IsInstanceOf(buffer, bufferClasses[i]))
+        {
+            *size = (size_t)capacity * bufferElementSizes[i] - (size_t)byteOffset;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Returns whether the given kernel parameter pointer refers to a device
+ * pointer, i.e. whether it was created with Pointer.to(CUdeviceptr)
+ */
+bool isDevicePointerParam(JNIEnv *env, jobject param)
+{
+    if (env->GetLongField(param, Pointer_byteOffset) != 0)
+    {
+        return false;
+    }
+    jobjectArray pointers = (jobjectArray)env->GetObjectField(param, Pointer_pointers);
+    if (pointers == NULL || env->GetArrayLength(pointers) != 1)
+    {
+        return false;
+    }
+    jobject pointer = env->GetObjectArrayElement(pointers, 0);
+    bool result = pointer != NULL && env->IsInstanceOf(pointer, CUdeviceptr_class);
+    env->DeleteLocalRef(pointer);
+    return result;
+}
+
+/**
+ * Records a kernel launch in the given graph. The values of all kernel
+ * parameters are copied, so the kernelParams pointer must be a pointer
+ * to pointers that have been created for arrays or buffers. Parameters
+ * that have been created with Pointer.to(CUdeviceptr) are marked as
+ * device pointers, which may be changed with cuOpGraphRebindAddress.
+ */
+int captureLaunch(JNIEnv *env, OperationGraph *graph, CUfunction f,
+    unsigned int gridDimX, unsigned int gridDimY, unsigned int gridDimZ,
+    unsigned int blockDimX, unsigned int blockDimY, unsigned int blockDimZ,
+    unsigned int sharedMemBytes, CUstream stream, jobject kernelParams)
+{
+    jobjectArray params = NULL;
+    if (kernelParams != NULL)
+    {
+        params = (jobjectArray)env->GetObjectField(kernelParams, Pointer_pointers);
+        if (params == NULL)
+        {
+            Logger::log(LOG_ERROR, "The kernel parameters must be a pointer to pointers when capturing cuLaunchKernel\n");
+            return CUDA_ERROR_INVALID_VALUE;
+        }
+    }
+    int paramCount = params == NULL ? 0 : (int)env->GetArrayLength(params);
+    std::vector<void*> paramValues(paramCount, (void*)NULL);
+    std::vector<size_t> paramSizes(paramCount, 0);
+    std::vector<PointerData*> paramData(paramCount, (PointerData*)NULL);
+    std::vector<char> paramDevicePointers(paramCount, 0);
+    int result = CUDA_SUCCESS;
+    for (int i=0; i<paramCount && result == CUDA_SUCCESS; i++)
+    {
+        jobject param = env->GetObjectArrayElement(params, i);
+        if (!getKernelParamSize(env, param, &paramSizes[i]))
+        {
+            Logger::log(LOG_ERROR, "Could not determine the size of kernel parameter %d\n", i);
+            result = CUDA_ERROR_INVALID_VALUE;
+        }
+        else
+        {
+            paramData[i] = initPointerData(env, param);
+            if (paramData[i] == NULL)
+            {
+                result = JCUDA_INTERNAL_ERROR;
+            }
+            else
+            {
+                paramValues[i] = paramData[i]->getPointer(env);
+                paramDevicePointers[i] = isDevicePointerParam(env, param) ? 1 : 0;
+            }
+        }
+        env->DeleteLocalRef(param);
+    }
+    if (result == CUDA_SUCCESS)
+    {
+        graph->addLaunch(f, gridDimX, gridDimY, gridDimZ, blockDimX, blockDimY, blockDimZ,
+            sharedMemBytes, stream, paramCount,
+            paramCount == 0 ? NULL : &paramValues[0],
+            paramCount == 0 ? NULL : &paramSizes[0],
+            paramCount == 0 ? NULL : &paramDevicePointers[0]);
+    }
+    for (int i=0; i<paramCount; i++)
+    {
+        if (paramData[i] != NULL && !releasePointerData(env, paramData[i], JNI_ABORT))
+        {
+            result = JCUDA_INTERNAL_ERROR;
+        }
+    }
+    return result;
+}
+
 
 /**
  * Called when the library is loaded. Will initialize all
@@ -352,6 +753,43 @@ JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *jvm, void *reserved)
     if (!init(env, cls, CUDA_TEXTURE_DESC_minMipmapLevelClamp, "minMipmapLevelClamp", "F")) return JNI_ERR;
     if (!init(env, cls, CUDA_TEXTURE_DESC_maxMipmapLevelClamp, "maxMipmapLevelClamp", "F")) return JNI_ERR;
 
+    // Obtain the fieldIDs of the CUmemHostArenaStatistics class
+    if (!init(env, cls, "jcuda/driver/CUmemHostArenaStatistics")) return JNI_ERR;
+    if (!init(env, cls, CUmemHostArenaStatistics_reservedBytes,  "reservedBytes",  "J")) return JNI_ERR;
+    if (!init(env, cls, CUmemHostArenaStatistics_usedBytes,      "usedBytes",      "J")) return JNI_ERR;
+    if (!init(env, cls, CUmemHostArenaStatistics_requestedBytes, "requestedBytes", "J")) return JNI_ERR;
+    if (!init(env, cls, CUmemHostArenaStatistics_highWaterMark,  "highWaterMark",  "J")) return JNI_ERR;
+    if (!init(env, cls, CUmemHostArenaStatistics_regionCount,    "regionCount",    "J")) return JNI_ERR;
+    if (!init(env, cls, CUmemHostArenaStatistics_fragmentation,  "fragmentation",  "F")) return JNI_ERR;
+
+    // Obtain the fieldIDs of the CUtransferStatistics class
+    if (!init(env, cls, "jcuda/driver/CUtransferStatistics")) return JNI_ERR;
+    if (!init(env, cls, CUtransferStatistics_transferCount, "transferCount", "J")) return JNI_ERR;
+    if (!init(env, cls, CUtransferStatistics_bytes,         "bytes",         "J")) return JNI_ERR;
+    if (!init(env, cls, CUtransferStatistics_elapsedTime,   "elapsedTime",   "D")) return JNI_ERR;
+    if (!init(env, cls, CUtransferStatistics_bandwidth,     "bandwidth",     "D")) return JNI_ERR;
+
+    // Obtain the fieldID of the CUdeviceSnapshot class
+    if (!init(env, cls, "jcuda/driver/CUdeviceSnapshot")) return JNI_ERR;
+    if (!init(env, cls, CUdeviceSnapshot_buffer, "buffer", "Ljava/nio/ByteBuffer;")) return JNI_ERR;
+
+    // Obtain the fieldIDs of the CUmemcpyDescriptor class
+    if (!init(env, cls, "jcuda/driver/CUmemcpyDescriptor")) return JNI_ERR;
+    if (!init(env, cls, CUmemcpyDescriptor_buffer,    "buffer",    "Ljava/nio/ByteBuffer;")) return JNI_ERR;
+    if (!init(env, cls, CUmemcpyDescriptor_offsets,   "offsets",   "[I"                   )) return JNI_ERR;
+    if (!init(env, cls, CUmemcpyDescriptor_sizeTSize, "sizeTSize", "I"                    )) return JNI_ERR;
+
+    // Obtain the fieldIDs of the CUoccupancy class
+    if (!init(env, cls, "jcuda/driver/CUoccupancy")) return JNI_ERR;
+    if (!init(env, cls, CUoccupancy_blockSize,                     "blockSize",                     "I")) return JNI_ERR;
+    if (!init(env, cls, CUoccupancy_dynamicSharedMemBytes,         "dynamicSharedMemBytes",         "I")) return JNI_ERR;
+    if (!init(env, cls, CUoccupancy_maxDynamicSharedMemBytes,      "maxDynamicSharedMemBytes",      "I")) return JNI_ERR;
+    if (!init(env, cls, CUoccupancy_activeBlocksPerMultiprocessor, "activeBlocksPerMultiprocessor", "I")) return JNI_ERR;
+    if (!init(env, cls, CUoccupancy_activeWarpsPerMultiprocessor,  "activeWarpsPerMultiprocessor",  "I")) return JNI_ERR;
+    if (!init(env, cls, CUoccupancy_occupancy,                     "occupancy",                     "F")) return JNI_ERR;
+    if (!init(env, cls, CUoccupancy_limitingFactor,                "limitingFactor",                "I")) return JNI_ERR;
+    if (!init(env, cls, CUoccupancy_elapsedTime,                   "elapsedTime",                   "F")) return JNI_ERR;
+
 
     // Obtain the constructor of the CUdevice class
     if (!init(env, cls, "jcuda/driver/CUdevice")) return JNI_ERR;
@@ -363,6 +801,78 @@ JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *jvm, void *reserved)
     }
     if (!init(env, cls, CUdevice_constructor, "<init>", "()V")) return JNI_ERR;
 
+    // Obtain the constructor of the CUcontext class
+    if (!init(env, cls, "jcuda/driver/CUcontext")) return JNI_ERR;
+    CUcontext_class = (jclass)env->NewGlobalRef(cls);
+    if (CUcontext_class == NULL)
+    {
+        Logger::log(LOG_ERROR, "Failed to create reference to class CUcontext\n");
+        return JNI_ERR;
+    }
+    if (!init(env, cls, CUcontext_constructor, "<init>", "()V")) return JNI_ERR;
+
+    // Obtain the constructor of the CUstream class
+    if (!init(env, cls, "jcuda/driver/CUstream")) return JNI_ERR;
+    CUstream_class = (jclass)env->NewGlobalRef(cls);
+    if (CUstream_class == NULL)
+    {
+        Logger::log(LOG_ERROR, "Failed to create reference to class CUstream\n");
+        return JNI_ERR;
+    }
+    if (!init(env, cls, CUstream_constructor, "<init>", "()V")) return JNI_ERR;
+
+    // Obtain the CUdeviceptr class, for recognizing kernel parameters
+    // that are device pointers
+    if (!init(env, cls, "jcuda/driver/CUdeviceptr")) return JNI_ERR;
+    CUdeviceptr_class = (jclass)env->NewGlobalRef(cls);
+    if (CUdeviceptr_class == NULL)
+    {
+        Logger::log(LOG_ERROR, "Failed to create reference to class CUdeviceptr\n");
+        return JNI_ERR;
+    }
+
+    // Obtain the fields of CUfunction that refer to the future of a
+    // function that is looked up lazily
+    if (!init(env, cls, "jcuda/driver/CUfunction")) return JNI_ERR;
+    if (!init(env, cls, CUfunction_future, "future", "Ljcuda/driver/CUmoduleFuture;")) return JNI_ERR;
+    if (!init(env, cls, CUfunction_name,   "name",   "Ljava/lang/String;"           )) return JNI_ERR;
+
+    // Obtain the method of the CUtaskCallback interface
+    if (!init(env, cls, "jcuda/driver/CUtaskCallback")) return JNI_ERR;
+    if (!init(env, cls, CUtaskCallback_call, "call", "(ILjcuda/driver/CUcontext;Ljcuda/driver/CUstream;Ljava/lang/Object;)V")) return JNI_ERR;
+
+    // Obtain the method of the CUevictionCallback interface
+    if (!init(env, cls, "jcuda/driver/CUevictionCallback")) return JNI_ERR;
+    if (!init(env, cls, CUevictionCallback_evict, "evict", "(IJLjava/lang/Object;)J")) return JNI_ERR;
+
+    // Obtain the method that completes an EventFuture
+    if (!init(env, cls, "jcuda/EventFuture")) return JNI_ERR;
+    if (!init(env, cls, EventFuture_complete, "complete", "(I)V")) return JNI_ERR;
+
+    // Obtain the buffer classes and the capacity method
+    if (!init(env, cls, "java/nio/Buffer")) return JNI_ERR;
+    if (!init(env, cls, Buffer_capacity, "capacity", "()I")) return JNI_ERR;
+    const char *bufferClassNames[BUFFER_CLASS_COUNT] =
+    {
+        "java/nio/ByteBuffer", "java/nio/ShortBuffer", "java/nio/CharBuffer",
+        "java/nio/IntBuffer", "java/nio/FloatBuffer", "java/nio/LongBuffer",
+        "java/nio/DoubleBuffer"
+    };
+    size_t elementSizes[BUFFER_CLASS_COUNT] = { 1, 2, 2, 4, 4, 8, 8 };
+    for (int i=0; i<BUFFER_CLASS_COUNT; i++)
+    {
+        if (!init(env, cls, bufferClassNames[i])) return JNI_ERR;
+        bufferClasses[i] = (jclass)env->NewGlobalRef(cls);
+        if (bufferClasses[i] == NULL)
+        {
+            Logger::log(LOG_ERROR, "Failed to create reference to class %s\n", bufferClassNames[i]);
+            return JNI_ERR;
+        }
+        bufferElementSizes[i] = elementSizes[i];
+    }
+
+    globalJvm = jvm;
+
     return JNI_VERSION_1_4;
 }
 
@@ -386,6 +896,17 @@ JNIEXPORT void JNICALL Java_jcuda_driver_JCudaDriver_setLogLevel
     Logger::setLogLevel((LogLevel)logLevel);
 }
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    setContextTrackingEnabledNative
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_jcuda_driver_JCudaDriver_setContextTrackingEnabledNative
+  (JNIEnv *env, jclass cla, jboolean enabled)
+{
+    ContextTracker::setEnabled(enabled == JNI_TRUE);
+}
+
 
 
 
@@ -739,6 +1260,203 @@ bool releaseMemcpy3DPeerData(JNIEnv *env, Memcpy3DPeerData* &memcpyData)
 
 
 
+/**
+ * The kinds of the fields of a MemcpyDescriptor
+ */
+#define DESCRIPTOR_FIELD_SIZE   0
+#define DESCRIPTOR_FIELD_INT    1
+#define DESCRIPTOR_FIELD_HOST   2
+#define DESCRIPTOR_FIELD_DEVICE 3
+#define DESCRIPTOR_FIELD_HANDLE 4
+
+/**
+ * The offset and kind of a field of a MemcpyDescriptor. The order of
+ * the fields in the following tables is the order of the field
+ * indices in the Java classes.
+ */
+typedef struct MemcpyDescriptorField
+{
+    size_t offset;
+    int kind;
+} MemcpyDescriptorField;
+
+static const MemcpyDescriptorField memcpy2DDescriptorFields[] =
+{
+    { offsetof(CUDA_MEMCPY2D, srcXInBytes),   DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY2D, srcY),          DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY2D, srcMemoryType), DESCRIPTOR_FIELD_INT },
+    { offsetof(CUDA_MEMCPY2D, srcHost),       DESCRIPTOR_FIELD_HOST },
+    { offsetof(CUDA_MEMCPY2D, srcDevice),     DESCRIPTOR_FIELD_DEVICE },
+    { offsetof(CUDA_MEMCPY2D, srcArray),      DESCRIPTOR_FIELD_HANDLE },
+    { offsetof(CUDA_MEMCPY2D, srcPitch),      DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY2D, dstXInBytes),   DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY2D, dstY),          DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY2D, dstMemoryType), DESCRIPTOR_FIELD_INT },
+    { offsetof(CUDA_MEMCPY2D, dstHost),       DESCRIPTOR_FIELD_HOST },
+    { offsetof(CUDA_MEMCPY2D, dstDevice),     DESCRIPTOR_FIELD_DEVICE },
+    { offsetof(CUDA_MEMCPY2D, dstArray),      DESCRIPTOR_FIELD_HANDLE },
+    { offsetof(CUDA_MEMCPY2D, dstPitch),      DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY2D, WidthInBytes),  DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY2D, Height),        DESCRIPTOR_FIELD_SIZE }
+};
+
+static const MemcpyDescriptorField memcpy3DDescriptorFields[] =
+{
+    { offsetof(CUDA_MEMCPY3D, srcXInBytes),   DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D, srcY),          DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D, srcZ),          DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D, srcLOD),        DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D, srcMemoryType), DESCRIPTOR_FIELD_INT },
+    { offsetof(CUDA_MEMCPY3D, srcHost),       DESCRIPTOR_FIELD_HOST },
+    { offsetof(CUDA_MEMCPY3D, srcDevice),     DESCRIPTOR_FIELD_DEVICE },
+    { offsetof(CUDA_MEMCPY3D, srcArray),      DESCRIPTOR_FIELD_HANDLE },
+    { offsetof(CUDA_MEMCPY3D, srcPitch),      DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D, srcHeight),     DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D, dstXInBytes),   DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D, dstY),          DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D, dstZ),          DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D, dstLOD),        DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D, dstMemoryType), DESCRIPTOR_FIELD_INT },
+    { offsetof(CUDA_MEMCPY3D, dstHost),       DESCRIPTOR_FIELD_HOST },
+    { offsetof(CUDA_MEMCPY3D, dstDevice),     DESCRIPTOR_FIELD_DEVICE },
+    { offsetof(CUDA_MEMCPY3D, dstArray),      DESCRIPTOR_FIELD_HANDLE },
+    { offsetof(CUDA_MEMCPY3D, dstPitch),      DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D, dstHeight),     DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D, WidthInBytes),  DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D, Height),        DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D, Depth),         DESCRIPTOR_FIELD_SIZE }
+};
+
+static const MemcpyDescriptorField memcpy3DPeerDescriptorFields[] =
+{
+    { offsetof(CUDA_MEMCPY3D_PEER, srcXInBytes),   DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D_PEER, srcY),          DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D_PEER, srcZ),          DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D_PEER, srcLOD),        DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D_PEER, srcMemoryType), DESCRIPTOR_FIELD_INT },
+    { offsetof(CUDA_MEMCPY3D_PEER, srcHost),       DESCRIPTOR_FIELD_HOST },
+    { offsetof(CUDA_MEMCPY3D_PEER, srcDevice),     DESCRIPTOR_FIELD_DEVICE },
+    { offsetof(CUDA_MEMCPY3D_PEER, srcArray),      DESCRIPTOR_FIELD_HANDLE },
+    { offsetof(CUDA_MEMCPY3D_PEER, srcContext),    DESCRIPTOR_FIELD_HANDLE },
+    { offsetof(CUDA_MEMCPY3D_PEER, srcPitch),      DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D_PEER, srcHeight),     DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D_PEER, dstXInBytes),   DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D_PEER, dstY),          DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D_PEER, dstZ),          DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D_PEER, dstLOD),        DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D_PEER, dstMemoryType), DESCRIPTOR_FIELD_INT },
+    { offsetof(CUDA_MEMCPY3D_PEER, dstHost),       DESCRIPTOR_FIELD_HOST },
+    { offsetof(CUDA_MEMCPY3D_PEER, dstDevice),     DESCRIPTOR_FIELD_DEVICE },
+    { offsetof(CUDA_MEMCPY3D_PEER, dstArray),      DESCRIPTOR_FIELD_HANDLE },
+    { offsetof(CUDA_MEMCPY3D_PEER, dstContext),    DESCRIPTOR_FIELD_HANDLE },
+    { offsetof(CUDA_MEMCPY3D_PEER, dstPitch),      DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D_PEER, dstHeight),     DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D_PEER, WidthInBytes),  DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D_PEER, Height),        DESCRIPTOR_FIELD_SIZE },
+    { offsetof(CUDA_MEMCPY3D_PEER, Depth),         DESCRIPTOR_FIELD_SIZE }
+};
+
+/**
+ * Obtains the field table and the number of fields for the given
+ * MEMCPY_DESCRIPTOR_* type. Returns false if the type is not valid.
+ */
+bool getMemcpyDescriptorFields(int type, const MemcpyDescriptorField **fields, int *count)
+{
+    switch (type)
+    {
+        case MEMCPY_DESCRIPTOR_2D:
+            *fields = memcpy2DDescriptorFields;
+            *count = sizeof(memcpy2DDescriptorFields) / sizeof(MemcpyDescriptorField);
+            return true;
+
+        case MEMCPY_DESCRIPTOR_3D:
+            *fields = memcpy3DDescriptorFields;
+            *count = sizeof(memcpy3DDescriptorFields) / sizeof(MemcpyDescriptorField);
+            return true;
+
+        case MEMCPY_DESCRIPTOR_3D_PEER:
+            *fields = memcpy3DPeerDescriptorFields;
+            *count = sizeof(memcpy3DPeerDescriptorFields) / sizeof(MemcpyDescriptorField);
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Returns the size of the structure of a MemcpyDescriptor with
+ * the given type
+ */
+size_t getMemcpyDescriptorSize(int type)
+{
+    switch (type)
+    {
+        case MEMCPY_DESCRIPTOR_2D: return sizeof(CUDA_MEMCPY2D);
+        case MEMCPY_DESCRIPTOR_3D: return sizeof(CUDA_MEMCPY3D);
+        case MEMCPY_DESCRIPTOR_3D_PEER: return sizeof(CUDA_MEMCPY3D_PEER);
+    }
+    return 0;
+}
+
+/**
+ * Returns the MemcpyDescriptor of the given Java object if it has the
+ * given type, or NULL
+ */
+MemcpyDescriptor* getMemcpyDescriptor(JNIEnv *env, jobject descriptor, int type)
+{
+    MemcpyDescriptor *nativeDescriptor = (MemcpyDescriptor*)getNativePointerValue(env, descriptor);
+    if (nativeDescriptor == NULL || nativeDescriptor->type != type)
+    {
+        return NULL;
+    }
+    return nativeDescriptor;
+}
+
+/**
+ * Reads the given number of packed copy rectangles from the given array.
+ * For 2D copies, each rectangle consists of 6 values (srcXInBytes, srcY,
+ * dstXInBytes, dstY, WidthInBytes, Height), and for 3D copies of 9 values
+ * (srcXInBytes, srcY, srcZ, dstXInBytes, dstY, dstZ, WidthInBytes, Height,
+ * Depth). Returns false if the array is too small or an error occurred.
+ */
+bool readCopyRects(JNIEnv *env, jlongArray rects, int count, bool is3D, std::vector<CopyRect> &copyRects)
+{
+    // The count is compared to the number of complete rectangles in
+    // the array, because count * stride may overflow
+    int stride = is3D ? 9 : 6;
+    if (count < 0 || count > env->GetArrayLength(rects) / stride)
+    {
+        return false;
+    }
+    std::vector<jlong> values((size_t)count * stride + 1);
+    env->GetLongArrayRegion(rects, 0, (jsize)count * stride, &values[0]);
+    if (env->ExceptionCheck())
+    {
+        return false;
+    }
+    copyRects.resize(count);
+    for (int i=0; i<count; i++)
+    {
+        const jlong *v = &values[(size_t)i * stride];
+        CopyRect &r = copyRects[i];
+        if (is3D)
+        {
+            r.srcX = (size_t)v[0]; r.srcY = (size_t)v[1]; r.srcZ = (size_t)v[2];
+            r.dstX = (size_t)v[3]; r.dstY = (size_t)v[4]; r.dstZ = (size_t)v[5];
+            r.width = (size_t)v[6]; r.height = (size_t)v[7]; r.depth = (size_t)v[8];
+        }
+        else
+        {
+            r.srcX = (size_t)v[0]; r.srcY = (size_t)v[1]; r.srcZ = 0;
+            r.dstX = (size_t)v[2]; r.dstY = (size_t)v[3]; r.dstZ = 0;
+            r.width = (size_t)v[4]; r.height = (size_t)v[5]; r.depth = 1;
+        }
+    }
+    return true;
+}
+
+
+
+
 /**
  * Returns the native representation of the given Java object
  */
@@ -1461,58 +2179,4940 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuDeviceGetAttributeNative
 
 
 
+/**
+ * Obtains the number of devices
+ */
+static int getSnapshotDeviceCount(int *count)
+{
+    return cuDeviceGetCount(count);
+}
+
+/**
+ * Obtains the value of the given attribute of the given device
+ */
+static int getSnapshotAttribute(int *value, int attribute, int device)
+{
+    CUdevice nativeDevice;
+    int result = cuDeviceGet(&nativeDevice, device);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    return cuDeviceGetAttribute(value, (CUdevice_attribute)attribute, nativeDevice);
+}
+
+/**
+ * Obtains the total memory of the given device, in bytes
+ */
+static int getSnapshotTotalMem(size_t *bytes, int device)
+{
+    CUdevice nativeDevice;
+    int result = cuDeviceGet(&nativeDevice, device);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    return cuDeviceTotalMem(bytes, nativeDevice);
+}
+
+/**
+ * Obtains the name of the given device
+ */
+static int getSnapshotName(char *name, int length, int device)
+{
+    CUdevice nativeDevice;
+    int result = cuDeviceGet(&nativeDevice, device);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    return cuDeviceGetName(name, length, nativeDevice);
+}
+
+/**
+ * The functions that are used for creating the device snapshot
+ */
+DeviceSnapshotFunctions deviceSnapshotFunctions =
+{
+    &getSnapshotDeviceCount,
+    &getSnapshotAttribute,
+    &getSnapshotTotalMem,
+    &getSnapshotName
+};
+DeviceSnapshot deviceSnapshot(deviceSnapshotFunctions);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuDeviceGetSnapshotNative
+ * Signature: (Ljcuda/driver/CUdeviceSnapshot;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuDeviceGetSnapshotNative
+  (JNIEnv *env, jclass cls, jobject snapshot)
+{
+    if (snapshot == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'snapshot' is null for cuDeviceGetSnapshot");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuDeviceGetSnapshot\n");
+
+    void *data = NULL;
+    size_t size = 0;
+    int result = deviceSnapshot.get(&data, &size);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    jobject buffer = env->NewDirectByteBuffer(data, (jlong)size);
+    if (buffer == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    env->SetObjectField(snapshot, CUdeviceSnapshot_buffer, buffer);
+    return CUDA_SUCCESS;
+}
+
+
+
+
+
+
+
+/**
+ * Obtains the number of devices
+ */
+static int getPeerDeviceCount(int *count)
+{
+    return cuDeviceGetCount(count);
+}
+
+/**
+ * Obtains whether the given device can access the memory of the given
+ * peer device
+ */
+static int getPeerCanAccess(int *canAccess, int device, int peerDevice)
+{
+    CUdevice nativeDevice;
+    CUdevice nativePeerDevice;
+    int result = cuDeviceGet(&nativeDevice, device);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    result = cuDeviceGet(&nativePeerDevice, peerDevice);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    return cuDeviceCanAccessPeer(canAccess, nativeDevice, nativePeerDevice);
+}
+
+/**
+ * Obtains the PCI bus ID of the given device
+ */
+static int getPeerPCIBusId(char *busId, int length, int device)
+{
+    CUdevice nativeDevice;
+    int result = cuDeviceGet(&nativeDevice, device);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    return cuDeviceGetPCIBusId(busId, length, nativeDevice);
+}
+
+/**
+ * Enables the access of the context of the given endpoint to the
+ * memory of the context of the given peer. Access that is already
+ * enabled is not an error.
+ */
+static int enablePeerContextAccess(PeerEndpoint endpoint, PeerEndpoint peer)
+{
+    ContextScope scope((CUcontext)endpoint.context);
+    if (scope.getResult() != CUDA_SUCCESS) return scope.getResult();
+    int result = cuCtxEnablePeerAccess((CUcontext)peer.context, 0);
+    if (result == CUDA_ERROR_PEER_ACCESS_ALREADY_ENABLED)
+    {
+        return CUDA_SUCCESS;
+    }
+    return result;
+}
+
+/**
+ * Copies the given number of bytes directly between the memory of the
+ * given endpoints, asynchronously in the given stream if requested
+ */
+static int copyPeerDirect(void *dst, PeerEndpoint dstEndpoint, const void *src, PeerEndpoint srcEndpoint, size_t bytes, void *stream, bool async)
+{
+    if (async)
+    {
+        return cuMemcpyPeerAsync((CUdeviceptr)dst, (CUcontext)dstEndpoint.context,
+            (CUdeviceptr)src, (CUcontext)srcEndpoint.context, bytes, (CUstream)stream);
+    }
+    return cuMemcpyPeer((CUdeviceptr)dst, (CUcontext)dstEndpoint.context,
+        (CUdeviceptr)src, (CUcontext)srcEndpoint.context, bytes);
+}
+
+/**
+ * Allocates portable page-locked host memory, for copies that are
+ * staged through the host
+ */
+static int allocPeerHost(PeerEndpoint endpoint, void **pointer, size_t size)
+{
+    ContextScope scope((CUcontext)endpoint.context);
+    if (scope.getResult() != CUDA_SUCCESS) return scope.getResult();
+    return cuMemHostAlloc(pointer, size, CU_MEMHOSTALLOC_PORTABLE);
+}
+
+/**
+ * Frees host memory that was allocated with allocPeerHost
+ */
+static int freePeerHost(PeerEndpoint endpoint, void *pointer)
+{
+    ContextScope scope((CUcontext)endpoint.context);
+    if (scope.getResult() != CUDA_SUCCESS) return scope.getResult();
+    return cuMemFreeHost(pointer);
+}
+
+/**
+ * Creates a stream for the given endpoint
+ */
+static int createPeerStream(PeerEndpoint endpoint, void **stream)
+{
+    ContextScope scope((CUcontext)endpoint.context);
+    if (scope.getResult() != CUDA_SUCCESS) return scope.getResult();
+    return cuStreamCreate((CUstream*)stream, CU_STREAM_DEFAULT);
+}
+
+/**
+ * Destroys the given stream of the given endpoint
+ */
+static int destroyPeerStream(PeerEndpoint endpoint, void *stream)
+{
+    ContextScope scope((CUcontext)endpoint.context);
+    if (scope.getResult() != CUDA_SUCCESS) return scope.getResult();
+    return cuStreamDestroy((CUstream)stream);
+}
+
+/**
+ * Waits until all work in the given stream of the given endpoint is
+ * complete
+ */
+static int synchronizePeerStream(PeerEndpoint endpoint, void *stream)
+{
+    ContextScope scope((CUcontext)endpoint.context);
+    if (scope.getResult() != CUDA_SUCCESS) return scope.getResult();
+    return cuStreamSynchronize((CUstream)stream);
+}
+
+/**
+ * Waits until the given event has been reached
+ */
+static int synchronizePeerEvent(PeerEndpoint /*endpoint*/, void *event)
+{
+    return cuEventSynchronize((CUevent)event);
+}
+
+/**
+ * Creates an event without timing for the given endpoint
+ */
+static int createPeerEvent(PeerEndpoint endpoint, void **event)
+{
+    ContextScope scope((CUcontext)endpoint.context);
+    if (scope.getResult() != CUDA_SUCCESS) return scope.getResult();
+    return cuEventCreate((CUevent*)event, CU_EVENT_DISABLE_TIMING);
+}
+
+/**
+ * Destroys the given event of the given endpoint
+ */
+static int destroyPeerEvent(PeerEndpoint /*endpoint*/, void *event)
+{
+    return cuEventDestroy((CUevent)event);
+}
+
+/**
+ * Records the given event in the given stream of the given endpoint
+ */
+static int recordPeerEvent(PeerEndpoint endpoint, void *event, void *stream)
+{
+    ContextScope scope((CUcontext)endpoint.context);
+    if (scope.getResult() != CUDA_SUCCESS) return scope.getResult();
+    return cuEventRecord((CUevent)event, (CUstream)stream);
+}
+
+/**
+ * Lets the given stream of the given endpoint wait for the given event
+ */
+static int peerStreamWaitEvent(PeerEndpoint endpoint, void *stream, void *event)
+{
+    ContextScope scope((CUcontext)endpoint.context);
+    if (scope.getResult() != CUDA_SUCCESS) return scope.getResult();
+    return cuStreamWaitEvent((CUstream)stream, (CUevent)event, 0);
+}
+
+/**
+ * Copies the given number of bytes from device memory of the given
+ * endpoint into page-locked host memory, asynchronously in the given
+ * stream
+ */
+static int copyPeerDtoHAsync(PeerEndpoint endpoint, void *dst, const void *src, size_t bytes, void *stream)
+{
+    ContextScope scope((CUcontext)endpoint.context);
+    if (scope.getResult() != CUDA_SUCCESS) return scope.getResult();
+    return cuMemcpyDtoHAsync(dst, (CUdeviceptr)src, bytes, (CUstream)stream);
+}
+
+/**
+ * Copies the given number of bytes from page-locked host memory into
+ * device memory of the given endpoint, asynchronously in the given
+ * stream
+ */
+static int copyPeerHtoDAsync(PeerEndpoint endpoint, void *dst, const void *src, size_t bytes, void *stream)
+{
+    ContextScope scope((CUcontext)endpoint.context);
+    if (scope.getResult() != CUDA_SUCCESS) return scope.getResult();
+    return cuMemcpyHtoDAsync((CUdeviceptr)dst, src, bytes, (CUstream)stream);
+}
+
+/**
+ * The functions that are used by the peer router. The functions that
+ * receive an endpoint make the context of this endpoint current.
+ */
+PeerRouterFunctions peerRouterFunctions =
+{
+    &getPeerDeviceCount,
+    &getPeerCanAccess,
+    &getPeerPCIBusId,
+    &enablePeerContextAccess,
+    &copyPeerDirect,
+    &allocPeerHost,
+    &freePeerHost,
+    &createPeerStream,
+    &destroyPeerStream,
+    &synchronizePeerStream,
+    &synchronizePeerEvent,
+    &createPeerEvent,
+    &destroyPeerEvent,
+    &recordPeerEvent,
+    &peerStreamWaitEvent,
+    &copyPeerDtoHAsync,
+    &copyPeerHtoDAsync
+};
+PeerRouter peerRouter(peerRouterFunctions);
+
+/**
+ * Returns the endpoint of a peer copy for the given context
+ */
+static PeerEndpoint getPeerEndpoint(CUcontext context)
+{
+    PeerEndpoint endpoint;
+    endpoint.device = -1;
+    endpoint.context = context;
+    ContextScope scope(context);
+    CUdevice device;
+    if (scope.getResult() == CUDA_SUCCESS && cuCtxGetDevice(&device) == CUDA_SUCCESS)
+    {
+        endpoint.device = (int)device;
+    }
+    return endpoint;
+}
+
+
+/**
+ * Registers the given host memory, and obtains the device and the
+ * owner of the registration
+ */
+static int registerCachedHost(void *pointer, size_t size, int *device, void **owner)
+{
+    int result = cuMemHostRegister(pointer, size, CU_MEMHOSTREGISTER_PORTABLE);
+    if (result == CUDA_SUCCESS)
+    {
+        registerAllocation(pointer, size, ALLOCATION_KIND_HOST);
+        CUcontext context = NULL;
+        cuCtxGetCurrent(&context);
+        *owner = context;
+        *device = getCurrentDevice();
+    }
+    return result;
+}
+
+/**
+ * Unregisters host memory that was registered with registerCachedHost
+ */
+static int unregisterCachedHost(void *pointer)
+{
+    allocationRegistry.remove(pointer);
+    return cuMemHostUnregister(pointer);
+}
+
+/**
+ * Obtains the device and the owner of the events of the calling
+ * thread, which is the current context
+ */
+static int getRegistrationOwner(int *device, void **owner)
+{
+    CUcontext context = NULL;
+    int result = cuCtxGetCurrent(&context);
+    *owner = context;
+    *device = getCurrentDevice();
+    return result;
+}
+
+/**
+ * Creates an event without timing
+ */
+static int createRegistrationEvent(void **event)
+{
+    return cuEventCreate((CUevent*)event, CU_EVENT_DISABLE_TIMING);
+}
+
+/**
+ * Destroys the given event
+ */
+static int destroyRegistrationEvent(void *event)
+{
+    return cuEventDestroy((CUevent)event);
+}
+
+/**
+ * Records the given event in the given stream
+ */
+static int recordRegistrationEvent(void *event, void *stream)
+{
+    return cuEventRecord((CUevent)event, (CUstream)stream);
+}
+
+/**
+ * Queries whether the given event has been reached
+ */
+static int queryRegistrationEvent(void *event)
+{
+    return cuEventQuery((CUevent)event);
+}
+
+/**
+ * Waits until the given event has been reached
+ */
+static int synchronizeRegistrationEvent(void *event)
+{
+    return cuEventSynchronize((CUevent)event);
+}
+
+/**
+ * The functions for the registrationCache. The memory of the buffers
+ * is registered as portable memory, but the registration belongs to
+ * the context that is current when it is made.
+ */
+RegistrationCacheFunctions registrationCacheFunctions =
+{
+    &registerCachedHost,
+    &unregisterCachedHost,
+    &getRegistrationOwner,
+    &createRegistrationEvent,
+    &destroyRegistrationEvent,
+    &recordRegistrationEvent,
+    &queryRegistrationEvent,
+    &synchronizeRegistrationEvent
+};
+RegistrationCache registrationCache(registrationCacheFunctions, CUDA_ERROR_HOST_MEMORY_ALREADY_REGISTERED, CUDA_ERROR_NOT_READY);
+
+/**
+ * Obtains the current device
+ */
+static int getNumaCurrentDevice(int *device)
+{
+    CUdevice nativeDevice;
+    int result = cuCtxGetDevice(&nativeDevice);
+    *device = (int)nativeDevice;
+    return result;
+}
+
+/**
+ * Registers the given host memory with the given flags
+ */
+static int registerNumaHost(void *pointer, size_t size, unsigned int flags)
+{
+    return cuMemHostRegister(pointer, size, flags);
+}
+
+/**
+ * Unregisters host memory that was registered with registerNumaHost
+ */
+static int unregisterNumaHost(void *pointer)
+{
+    return cuMemHostUnregister(pointer);
+}
+
+/**
+ * The functions for the numaPlacement. The CU_MEMHOSTALLOC flags
+ * for portable and mapped memory have the same values as the
+ * respective CU_MEMHOSTREGISTER flags.
+ */
+NumaPlacementFunctions numaPlacementFunctions =
+{
+    &getNumaCurrentDevice,
+    &getPeerPCIBusId,
+    &registerNumaHost,
+    &unregisterNumaHost
+};
+NumaPlacement numaPlacement(numaPlacementFunctions);
+
+/**
+ * Obtains the owner of the slots of the calling thread, which is the
+ * current context
+ */
+static int getBounceOwner(void **owner)
+{
+    CUcontext context = NULL;
+    int result = cuCtxGetCurrent(&context);
+    *owner = context;
+    return result;
+}
+
+/**
+ * Allocates portable page-locked memory for a slot
+ */
+static int allocBounceHost(void **pointer, size_t size)
+{
+    return cuMemHostAlloc(pointer, size, CU_MEMHOSTALLOC_PORTABLE);
+}
+
+/**
+ * Frees the memory of a slot
+ */
+static int freeBounceHost(void *pointer)
+{
+    return cuMemFreeHost(pointer);
+}
+
+/**
+ * Creates an event without timing
+ */
+static int createBounceEvent(void **event)
+{
+    return cuEventCreate((CUevent*)event, CU_EVENT_DISABLE_TIMING);
+}
+
+/**
+ * Destroys the given event
+ */
+static int destroyBounceEvent(void *event)
+{
+    return cuEventDestroy((CUevent)event);
+}
+
+/**
+ * Records the given event in the given stream
+ */
+static int recordBounceEvent(void *event, void *stream)
+{
+    return cuEventRecord((CUevent)event, (CUstream)stream);
+}
+
+/**
+ * Queries whether the given event has been reached
+ */
+static int queryBounceEvent(void *event)
+{
+    return cuEventQuery((CUevent)event);
+}
+
+/**
+ * Waits until the given event has been reached
+ */
+static int synchronizeBounceEvent(void *event)
+{
+    return cuEventSynchronize((CUevent)event);
+}
+
+/**
+ * The functions for the bounceRing. The owner of the streams is the
+ * current context.
+ */
+BounceRingFunctions bounceRingFunctions =
+{
+    &getBounceOwner,
+    &allocBounceHost,
+    &freeBounceHost,
+    &createBounceEvent,
+    &destroyBounceEvent,
+    &recordBounceEvent,
+    &queryBounceEvent,
+    &synchronizeBounceEvent
+};
+BounceRing bounceRing(bounceRingFunctions, CUDA_ERROR_NOT_READY);
+
+/**
+ * The staging area for updates of module globals, which are flushed
+ * before each kernel launch in the same context
+ */
+SymbolStaging symbolStaging;
+
+/**
+ * Executes the remainder of a bounced copy, starting at the given offset,
+ * directly between the Java array and device memory. A copy into the
+ * array is completed before this returns, since the array may not be
+ * accessed after the call returned.
+ */
+static int executeRemainingCopy(JNIEnv *env, jobject host, CUdeviceptr device, size_t offset, size_t bytes, bool toDevice, CUstream stream)
+{
+    PointerData *hostPointerData = initPointerData(env, host);
+    if (hostPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    char *hostMemory = (char*)hostPointerData->getPointer(env) + offset;
+    int result = CUDA_SUCCESS;
+    if (toDevice)
+    {
+        result = cuMemcpyHtoDAsync(device + offset, hostMemory, bytes - offset, stream);
+        if (!releasePointerData(env, hostPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    }
+    else
+    {
+        result = cuMemcpyDtoHAsync(hostMemory, device + offset, bytes - offset, stream);
+        if (result == CUDA_SUCCESS)
+        {
+            result = cuStreamSynchronize(stream);
+        }
+        if (!releasePointerData(env, hostPointerData)) return JCUDA_INTERNAL_ERROR;
+    }
+    return result;
+}
+
+/**
+ * Executes the given asynchronous copy between host and device memory
+ * through the slots of the bounceRing, if the host memory is a Java
+ * array. Copies that are larger than one slot are split into chunks of
+ * the slot size. If no slot is available for a later chunk, then the
+ * remainder of the copy is executed directly. Returns whether the copy
+ * was handled, and stores the error code in the given result. If this
+ * returns false, the copy has to be executed directly.
+ */
+bool executeBouncedCopy(JNIEnv *env, jobject host, CUdeviceptr device, size_t bytes, bool toDevice, CUstream stream, int *result)
+{
+    size_t slotSize = bounceRing.getSlotSize();
+    size_t offset = 0;
+    while (offset < bytes)
+    {
+        size_t chunk = bytes - offset;
+        if (chunk > slotSize)
+        {
+            chunk = slotSize;
+        }
+        BounceSlot *slot = NULL;
+        if (!bounceRing.acquire(env, host, offset, stream, chunk, toDevice, &slot))
+        {
+            *result = JCUDA_INTERNAL_ERROR;
+            return true;
+        }
+        if (slot == NULL)
+        {
+            break;
+        }
+        int copyResult = CUDA_SUCCESS;
+        if (toDevice)
+        {
+            copyResult = cuMemcpyHtoDAsync(device + offset, slot->buffer, chunk, stream);
+        }
+        else
+        {
+            copyResult = cuMemcpyDtoHAsync(slot->buffer, device + offset, chunk, stream);
+        }
+        *result = bounceRing.commit(env, slot, stream, copyResult);
+        if (*result != CUDA_SUCCESS)
+        {
+            return true;
+        }
+        offset += chunk;
+    }
+    if (offset == 0)
+    {
+        return false;
+    }
+    if (offset < bytes)
+    {
+        *result = executeRemainingCopy(env, host, device, offset, bytes, toDevice, stream);
+    }
+    return true;
+}
+
+/**
+ * The packer for 2D and 3D copies between Java arrays and device
+ * memory. Its staging buffers are kept for each context, like the
+ * slots of the bounceRing.
+ */
+PitchPackerFunctions pitchPackerFunctions =
+{
+    &getBounceOwner,
+    &allocBounceHost,
+    &freeBounceHost
+};
+PitchPacker pitchPacker(pitchPackerFunctions);
+
+/**
+ * Returns whether the given 2D or 3D copy is a copy between a Java array
+ * and device memory or a CUDA array that should go through a staging
+ * buffer of the pitchPacker. Copies with a host pitch that is smaller
+ * than the width are left to CUDA, which reports the error. The given
+ * flag will store whether the copy is a copy to the device.
+ */
+bool isPackedCopy(JNIEnv *env, CUmemorytype srcMemoryType, jobject srcHost, size_t srcPitch, CUmemorytype dstMemoryType, jobject dstHost, size_t dstPitch, size_t width, size_t bytes, bool *toDevice)
+{
+    if (srcMemoryType == CU_MEMORYTYPE_HOST && dstMemoryType != CU_MEMORYTYPE_HOST)
+    {
+        *toDevice = true;
+        return srcPitch >= width && isPointerBackedByArray(env, srcHost) && pitchPacker.accepts(bytes);
+    }
+    if (dstMemoryType == CU_MEMORYTYPE_HOST && srcMemoryType != CU_MEMORYTYPE_HOST)
+    {
+        *toDevice = false;
+        return dstPitch >= width && isPointerBackedByArray(env, dstHost) && pitchPacker.accepts(bytes);
+    }
+    return false;
+}
+
+
+/**
+ * Executes the given 2D copy through a staging buffer of the
+ * pitchPacker, if it is a copy between a Java array and device
+ * memory. The rows of the array are only accessed while they are
+ * packed into or unpacked from the staging buffer, and the staging
+ * buffer is transferred with a single copy. If the host pitch is equal
+ * to the width, then the rows are contiguous, and are copied between
+ * the array and the staging buffer with a single memcpy instead of
+ * being packed. Returns whether the copy was handled, and stores the
+ * error code in the given result. If this returns false, the copy has
+ * to be executed directly.
+ */
+bool executePackedCopy2D(JNIEnv *env, Memcpy2DData *memcpyData, bool unaligned, int *result)
+{
+    CUDA_MEMCPY2D &mc = memcpyData->memcpy2d;
+    bool toDevice = false;
+    size_t bytes = mc.WidthInBytes * mc.Height;
+    if (!isPackedCopy(env, mc.srcMemoryType, memcpyData->srcHost, mc.srcPitch, mc.dstMemoryType, memcpyData->dstHost, mc.dstPitch, mc.WidthInBytes, bytes, &toDevice))
+    {
+        return false;
+    }
+    PitchStaging staging;
+    if (pitchPacker.acquire(bytes, &staging) != CUDA_SUCCESS)
+    {
+        return false;
+    }
+    Logger::log(LOG_TRACE, "Packing 2D copy of %ld bytes\n", (long)bytes);
+
+    CUDA_MEMCPY2D staged = mc;
+    if (toDevice)
+    {
+        const char *src = (const char*)mc.srcHost + mc.srcY * mc.srcPitch + mc.srcXInBytes;
+        if (mc.srcPitch == mc.WidthInBytes)
+        {
+            memcpy(staging.buffer, src, bytes);
+        }
+        else
+        {
+            pitchPacker.pack(staging.buffer, src, mc.srcPitch, mc.Height, mc.WidthInBytes, mc.Height, 1);
+        }
+        memcpyData->srcHostPointerData->releasePointer(env, JNI_ABORT);
+        staged.srcHost = staging.buffer;
+        staged.srcXInBytes = 0;
+        staged.srcY = 0;
+        staged.srcPitch = mc.WidthInBytes;
+    }
+    else
+    {
+        memcpyData->dstHostPointerData->releasePointer(env, JNI_ABORT);
+        staged.dstHost = staging.buffer;
+        staged.dstXInBytes = 0;
+        staged.dstY = 0;
+        staged.dstPitch = mc.WidthInBytes;
+    }
+    *result = unaligned ? cuMemcpy2DUnaligned(&staged) : cuMemcpy2D(&staged);
+    if (!toDevice && *result == CUDA_SUCCESS)
+    {
+        char *dst = (char*)memcpyData->dstHostPointerData->getPointer(env);
+        if (dst == NULL)
+        {
+            *result = JCUDA_INTERNAL_ERROR;
+        }
+        else
+        {
+            dst += mc.dstY * mc.dstPitch + mc.dstXInBytes;
+            if (mc.dstPitch == mc.WidthInBytes)
+            {
+                memcpy(dst, staging.buffer, bytes);
+            }
+            else
+            {
+                pitchPacker.unpack(dst, mc.dstPitch, mc.Height, staging.buffer, mc.WidthInBytes, mc.Height, 1);
+            }
+        }
+    }
+    pitchPacker.release(&staging);
+    return true;
+}
+
+/**
+ * Executes the given 3D copy through a staging buffer of the
+ * pitchPacker, if it is a copy between a Java array and device
+ * memory. The slices are only contiguous if, in addition to the pitch
+ * being equal to the width, the host height is equal to the height of
+ * the copy. See executePackedCopy2D.
+ */
+bool executePackedCopy3D(JNIEnv *env, Memcpy3DData *memcpyData, int *result)
+{
+    CUDA_MEMCPY3D &mc = memcpyData->memcpy3d;
+    bool toDevice = false;
+    size_t bytes = mc.WidthInBytes * mc.Height * mc.Depth;
+    if (!isPackedCopy(env, mc.srcMemoryType, memcpyData->srcHost, mc.srcPitch, mc.dstMemoryType, memcpyData->dstHost, mc.dstPitch, mc.WidthInBytes, bytes, &toDevice))
+    {
+        return false;
+    }
+    PitchStaging staging;
+    if (pitchPacker.acquire(bytes, &staging) != CUDA_SUCCESS)
+    {
+        return false;
+    }
+    Logger::log(LOG_TRACE, "Packing 3D copy of %ld bytes\n", (long)bytes);
+
+    CUDA_MEMCPY3D staged = mc;
+    if (toDevice)
+    {
+        const char *src = (const char*)mc.srcHost + (mc.srcZ * mc.srcHeight + mc.srcY) * mc.srcPitch + mc.srcXInBytes;
+        if (mc.srcPitch == mc.WidthInBytes && (mc.srcHeight == mc.Height || mc.Depth == 1))
+        {
+            memcpy(staging.buffer, src, bytes);
+        }
+        else
+        {
+            pitchPacker.pack(staging.buffer, src, mc.srcPitch, mc.srcHeight, mc.WidthInBytes, mc.Height, mc.Depth);
+        }
+        memcpyData->srcHostPointerData->releasePointer(env, JNI_ABORT);
+        staged.srcHost = staging.buffer;
+        staged.srcXInBytes = 0;
+        staged.srcY = 0;
+        staged.srcZ = 0;
+        staged.srcPitch = mc.WidthInBytes;
+        staged.srcHeight = mc.Height;
+    }
+    else
+    {
+        memcpyData->dstHostPointerData->releasePointer(env, JNI_ABORT);
+        staged.dstHost = staging.buffer;
+        staged.dstXInBytes = 0;
+        staged.dstY = 0;
+        staged.dstZ = 0;
+        staged.dstPitch = mc.WidthInBytes;
+        staged.dstHeight = mc.Height;
+    }
+    *result = cuMemcpy3D(&staged);
+    if (!toDevice && *result == CUDA_SUCCESS)
+    {
+        char *dst = (char*)memcpyData->dstHostPointerData->getPointer(env);
+        if (dst == NULL)
+        {
+            *result = JCUDA_INTERNAL_ERROR;
+        }
+        else
+        {
+            dst += (mc.dstZ * mc.dstHeight + mc.dstY) * mc.dstPitch + mc.dstXInBytes;
+            if (mc.dstPitch == mc.WidthInBytes && (mc.dstHeight == mc.Height || mc.Depth == 1))
+            {
+                memcpy(dst, staging.buffer, bytes);
+            }
+            else
+            {
+                pitchPacker.unpack(dst, mc.dstPitch, mc.dstHeight, staging.buffer, mc.WidthInBytes, mc.Height, mc.Depth);
+            }
+        }
+    }
+    pitchPacker.release(&staging);
+    return true;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCtxCreateNative
+ * Signature: (Ljcuda/driver/CUcontext;ILjcuda/driver/CUdevice;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxCreateNative
+  (JNIEnv *env, jclass cls, jobject pctx, jint flags, jobject dev)
+{
+    if (pctx == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pctx' is null for cuCtxCreate");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (dev == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dev' is null for cuCtxCreate");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuCtxCreate\n");
+
+    CUdevice nativeDev = (CUdevice)(intptr_t)getNativePointerValue(env, dev);
+    CUcontext nativePctx;
+    int result = cuCtxCreate(&nativePctx, (int)flags, nativeDev);
+    if (result == CUDA_SUCCESS)
+    {
+        ContextTracker::contextCreated(nativePctx);
+    }
+    setNativePointerValue(env, pctx, (jlong)nativePctx);
+
+    return result;
+}
+
+
+
+
+/**
+ * The service that completes the EventFutures. It is created when the
+ * first future is registered, and is never destroyed, because its
+ * thread calls into the VM.
+ */
+Mutex completionServiceMutex;
+CompletionService *completionService = NULL;
+
+/**
+ * The maximum time between two queries of a pending event
+ */
+#define COMPLETION_MAX_POLL_MICROS 1000
+
+/**
+ * The CompletionQueryFunction for events of the driver API. The context
+ * of the events is made current once for all of them.
+ */
+void queryCompletionEvents(void *context, void **events, int *results, int count)
+{
+    ContextScope scope((CUcontext)context);
+    for (int i=0; i<count; i++)
+    {
+        if (scope.getResult() != CUDA_SUCCESS)
+        {
+            results[i] = scope.getResult();
+        }
+        else
+        {
+            results[i] = cuEventQuery((CUevent)events[i]);
+        }
+    }
+}
+
+/**
+ * The CompletionBatchFunction that completes the EventFutures that
+ * are the user data of the given entries, and deletes the global
+ * references to them. The polling thread stays attached, so all
+ * batches are completed with the same JNIEnv. If the thread can not
+ * be attached, the entries are kept by the service and passed again.
+ */
+bool completeEventFutures(CompletionEntry *entries, int count)
+{
+    JNIEnv *env = getTaskWorkerEnv();
+    if (env == NULL)
+    {
+        return false;
+    }
+
+    // Complete the bounced copies into Java arrays before the futures,
+    // so that the listeners see the data of the completed copies
+    bounceRing.completeReady(env);
+    for (int i=0; i<count; i++)
+    {
+        jobject future = (jobject)entries[i].userData;
+        env->CallVoidMethod(future, EventFuture_complete, (jint)entries[i].result);
+        if (env->ExceptionCheck())
+        {
+            Logger::log(LOG_ERROR, "Exception in event future listener\n");
+            env->ExceptionDescribe();
+            env->ExceptionClear();
+        }
+        env->DeleteGlobalRef(future);
+    }
+    return true;
+}
+
+/**
+ * Returns the completion service, creating it if necessary
+ */
+CompletionService* getCompletionService()
+{
+    MutexLock lock(completionServiceMutex);
+    if (completionService == NULL)
+    {
+        completionService = new CompletionService(&queryCompletionEvents, CUDA_ERROR_NOT_READY,
+            &completeEventFutures, COMPLETION_MAX_POLL_MICROS, &detachTaskWorker);
+    }
+    return completionService;
+}
+
+/**
+ * Completes the pending EventFutures of the given context with
+ * CUDA_ERROR_INVALID_CONTEXT, before the context is destroyed
+ */
+void removeContextCompletions(CUcontext context)
+{
+    CompletionService *service = NULL;
+    {
+        MutexLock lock(completionServiceMutex);
+        service = completionService;
+    }
+    if (service != NULL)
+    {
+        service->removeContext(context, CUDA_ERROR_INVALID_CONTEXT);
+    }
+}
+
+/**
+ * The IPC registries that have been created and not destroyed yet,
+ * so that their handles can be closed when a context is destroyed
+ */
+Mutex ipcRegistriesMutex;
+std::vector<IpcRegistry*> ipcRegistries;
+
+/**
+ * Closes the handles that have been opened in the given context by
+ * any IPC registry, before the context is destroyed
+ */
+void removeContextIpcHandles(CUcontext context)
+{
+    MutexLock lock(ipcRegistriesMutex);
+    for (size_t i=0; i<ipcRegistries.size(); i++)
+    {
+        ipcRegistries[i]->removeContext(context);
+    }
+}
+
+
+
+/**
+ * Destroys or detaches the given context. This is shared by cuCtxDestroy
+ * and cuCtxDetach, so that the state that the extensions keep for the
+ * context is cleaned up in both cases. Since the usage count of a context
+ * can not be queried, detaching is treated like destroying the context.
+ */
+static int destroyContext(JNIEnv *env, CUcontext context, bool detach)
+{
+    // The resources that the extensions keep for the context have to
+    // be released while the context still exists, so the context is
+    // validated first. If destroying it fails nevertheless, then the
+    // staging buffers and pools are re-created when they are needed,
+    // but pending symbol updates and profiler ranges are discarded.
+    unsigned int version = 0;
+    int result = cuCtxGetApiVersion(context, &version);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    RangeProfiler::contextDestroyed(context);
+    removeContextCompletions(context);
+    removeContextIpcHandles(context);
+    PeerEndpoint endpoint = { -1, context };
+    peerRouter.removeEndpoint(endpoint);
+    bounceRing.removeOwner(env, context);
+    symbolStaging.removeContext(context);
+    pitchPacker.removeOwner(context);
+    result = detach ? cuCtxDetach(context) : cuCtxDestroy(context);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    ContextTracker::contextDestroyed(context);
+    allocationRegistry.removeOwner(context);
+    registrationCache.removeOwner(env, context);
+    MemoryGovernor::invalidate();
+    return result;
+}
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCtxDestroyNative
+ * Signature: (Ljcuda/driver/CUcontext;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxDestroyNative
+  (JNIEnv *env, jclass cls, jobject ctx)
+{
+    if (ctx == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ctx' is null for cuCtxDestroy");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuCtxDestroy\n");
+
+    CUcontext nativeCtx = (CUcontext)getNativePointerValue(env, ctx);
+    int result = destroyContext(env, nativeCtx, false);
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCtxAttachNative
+ * Signature: (Ljcuda/driver/CUcontext;I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxAttachNative
+  (JNIEnv *env, jclass cls, jobject pctx, jint flags)
+{
+    if (pctx == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pctx' is null for cuCtxAttach");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuCtxAttach\n");
+
+    CUcontext nativePctx = (CUcontext)getNativePointerValue(env, pctx);
+    int result = cuCtxAttach(&nativePctx, (unsigned int)flags);
+    ContextTracker::invalidate();
+    setNativePointerValue(env, pctx, (jlong)nativePctx);
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCtxDetachNative
+ * Signature: (Ljcuda/driver/CUcontext;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxDetachNative
+  (JNIEnv *env, jclass cls, jobject ctx)
+{
+    if (ctx == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ctx' is null for cuCtxDetach");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuCtxDetach\n");
+
+    CUcontext nativeCtx = (CUcontext)getNativePointerValue(env, ctx);
+    int result = destroyContext(env, nativeCtx, true);
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCtxPushCurrentNative
+ * Signature: (Ljcuda/driver/CUcontext;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxPushCurrentNative
+  (JNIEnv *env, jclass cls, jobject ctx)
+{
+    if (ctx == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ctx' is null for cuCtxPushCurrent");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuCtxPushCurrent\n");
+
+    CUcontext nativeCtx = (CUcontext)getNativePointerValue(env, ctx);
+    int result = ContextTracker::pushCurrent(nativeCtx);
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCtxPopCurrentNative
+ * Signature: (Ljcuda/driver/CUcontext;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxPopCurrentNative
+  (JNIEnv *env, jclass cls, jobject pctx)
+{
+    if (pctx == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pctx' is null for cuCtxPopCurrent");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuCtxPopCurrent\n");
+
+    CUcontext nativePctx = (CUcontext)getNativePointerValue(env, pctx);
+    int result = ContextTracker::popCurrent(&nativePctx);
+    setNativePointerValue(env, pctx, (jlong)nativePctx);
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCtxSetCurrentNative
+ * Signature: (Ljcuda/driver/CUcontext;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxSetCurrentNative
+  (JNIEnv *env, jclass cls, jobject ctx)
+{
+    if (ctx == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ctx' is null for cuCtxSetCurrent");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuCtxSetCurrent\n");
+
+    CUcontext nativeCtx = (CUcontext)getNativePointerValue(env, ctx);
+    int result = ContextTracker::setCurrent(nativeCtx);
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCtxGetCurrentNative
+ * Signature: (Ljcuda/driver/CUcontext;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxGetCurrentNative
+  (JNIEnv *env, jclass cls, jobject pctx)
+{
+    if (pctx == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pctx' is null for cuCtxGetCurrent");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuCtxGetCurrent\n");
+
+    CUcontext nativePctx;
+    int result = ContextTracker::getCurrent(&nativePctx);
+    setNativePointerValue(env, pctx, (jlong)nativePctx);
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCtxGetSwitchCountsNative
+ * Signature: ([J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxGetSwitchCountsNative
+  (JNIEnv *env, jclass cls, jlongArray performed, jlongArray elided)
+{
+    if (performed == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'performed' is null for cuCtxGetSwitchCounts");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (elided == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'elided' is null for cuCtxGetSwitchCounts");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuCtxGetSwitchCounts\n");
+
+    jcuda_int64 nativePerformed = 0;
+    jcuda_int64 nativeElided = 0;
+    ContextTracker::getSwitchCounts(&nativePerformed, &nativeElided);
+    if (!set(env, performed, 0, (jlong)nativePerformed)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, elided, 0, (jlong)nativeElided)) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCtxResetSwitchCountsNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxResetSwitchCountsNative
+  (JNIEnv *env, jclass cls)
+{
+    Logger::log(LOG_TRACE, "Executing cuCtxResetSwitchCounts\n");
+
+    ContextTracker::resetSwitchCounts();
+    return CUDA_SUCCESS;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCtxGetDeviceNative
+ * Signature: (Ljcuda/driver/CUdevice;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxGetDeviceNative
+  (JNIEnv *env, jclass cls, jobject device)
+{
+    if (device == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'device' is null for cuCtxGetDevice");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuCtxGetDevice\n");
+
+    CUdevice nativeDevice = (CUdevice)(intptr_t)getNativePointerValue(env, device);
+    int result = cuCtxGetDevice(&nativeDevice);
+    setNativePointerValue(env, device, (jlong)nativeDevice);
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCtxSynchronizeNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxSynchronizeNative
+  (JNIEnv *env, jclass cls)
+{
+    Logger::log(LOG_TRACE, "Executing cuCtxSynchronize\n");
+
+    int result = cuCtxSynchronize();
+    bounceRing.completeReady(env);
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleLoadNative
+ * Signature: (Ljcuda/driver/CUmodule;Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoadNative
+  (JNIEnv *env, jclass cls, jobject module, jstring fname)
+{
+    if (module == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'module' is null for cuModuleLoad");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (fname == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'fname' is null for cuModuleLoad");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuModuleLoad\n");
+
+    CUmodule nativeModule;
+    char *nativeFname = convertString(env, fname);
+    if (nativeFname == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    int result = cuModuleLoad(&nativeModule, nativeFname);
+    setNativePointerValue(env, module, (jlong)nativeModule);
+    delete[] nativeFname;
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleLoadDataNative
+ * Signature: (Ljcuda/driver/CUmodule;[B)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoadDataNative
+  (JNIEnv *env, jclass cls, jobject module, jbyteArray image)
+{
+    if (module == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'module' is null for cuModuleLoadData");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (image == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'image' is null for cuModuleLoadData");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuModuleLoadData\n");
+
+    CUmodule nativeModule = (CUmodule)getNativePointerValue(env, module);
+    void *nativeImage = env->GetPrimitiveArrayCritical(image, NULL);
+    int result = cuModuleLoadData(&nativeModule, nativeImage);
+    env->ReleasePrimitiveArrayCritical(image, nativeImage, JNI_ABORT);
+    setNativePointerValue(env, module, (jlong)nativeModule);
+    return result;
+}
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleLoadDataExNative
+ * Signature: (Ljcuda/driver/CUmodule;Ljcuda/Pointer;I[ILjcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoadDataExNative
+  (JNIEnv *env, jclass cls, jobject phMod, jobject p, jint numOptions, jintArray options, jobject optionValues)
+{
+    if (phMod == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phMod' is null for cuModuleLoadDataEx");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (p == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'p' is null for cuModuleLoadDataEx");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    // Although it should be possible to pass 'null' for these parameters
+    // when numOptions==0, the driver crashes when they are 'null', so
+    // this case is checked here as well.
+    if (options == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'options' is null for cuModuleLoadDataEx");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (optionValues == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'optionValues' is null for cuModuleLoadDataEx");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuModuleLoadDataEx\n");
+
+
+    CUjit_option *nativeOptions = NULL;
+    //if (options != NULL) // See notes above
+    {
+        jint *optionsElements = env->GetIntArrayElements(options, NULL);
+        if (optionsElements == NULL)
+        {
+            return JCUDA_INTERNAL_ERROR;
+        }
+
+        nativeOptions = new CUjit_option[numOptions];
+        for (int i=0; i<numOptions; i++)
+        {
+            nativeOptions[i] = (CUjit_option)optionsElements[i];
+        }
+        env->ReleaseIntArrayElements(options, optionsElements, JNI_ABORT);
+    }
+
+    CUmodule nativeModule;
+    PointerData *pPointerData = initPointerData(env, p);
+    if (pPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+    PointerData *optionValuesPointerData = NULL;
+    void **optionValuesPointer = NULL;
+    //if (optionValues != NULL) // See notes above
+    {
+        optionValuesPointerData = initPointerData(env, optionValues);
+        if (optionValuesPointerData == NULL)
+        {
+            return JCUDA_INTERNAL_ERROR;
+        }
+        optionValuesPointer = (void**)optionValuesPointerData->getPointer(env);
+    }
+
+    int result = cuModuleLoadDataEx(&nativeModule, (void*)pPointerData->getPointer(env), (unsigned int)numOptions, nativeOptions, optionValuesPointer);
+
+    delete[] nativeOptions;
+
+    setNativePointerValue(env, phMod, (jlong)nativeModule);
+    if (!releasePointerData(env, pPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    if (!releasePointerData(env, optionValuesPointerData, 0)) return JCUDA_INTERNAL_ERROR;
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleLoadDataJITNative
+ * Signature: (Ljcuda/driver/CUmodule;Ljcuda/Pointer;Ljcuda/driver/JITOptions;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoadDataJITNative
+  (JNIEnv *env, jclass cls, jobject phMod, jobject p, jobject jitOptions)
+{
+    if (phMod == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phMod' is null for cuModuleLoadDataJIT");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (p == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'p' is null for cuModuleLoadDataJIT");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuModuleLoadDataJIT\n");
+
+    CUmodule nativeModule;
+    PointerData *pPointerData = initPointerData(env, p);
+    if (pPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+	JITOptionsData *jitOptionsData = initJITOptionsData(env, jitOptions);
+	if (jitOptionsData == NULL)
+	{
+        return JCUDA_INTERNAL_ERROR;
+	}
+    int result = cuModuleLoadDataEx(&nativeModule, (void*)pPointerData->getPointer(env), (unsigned int)jitOptionsData->numOptions, jitOptionsData->options, jitOptionsData->optionValues);
+
+	if (!releaseJITOptionsData(env, jitOptionsData, jitOptions)) return JCUDA_INTERNAL_ERROR;
+    setNativePointerValue(env, phMod, (jlong)nativeModule);
+    if (!releasePointerData(env, pPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    return result;
+
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleLoadFatBinaryNative
+ * Signature: (Ljcuda/driver/CUmodule;[B)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoadFatBinaryNative
+  (JNIEnv *env, jclass cls, jobject module, jbyteArray fatCubin)
+{
+    if (module == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'module' is null for cuModuleLoadFatBinary");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (fatCubin == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'fatCubin' is null for cuModuleLoadFatBinary");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuModuleLoadFatBinary\n");
+
+    CUmodule nativeModule = (CUmodule)getNativePointerValue(env, module);
+    void *nativeFatCubin = env->GetPrimitiveArrayCritical(fatCubin, NULL);
+    int result = cuModuleLoadFatBinary(&nativeModule, nativeFatCubin);
+    env->ReleasePrimitiveArrayCritical(fatCubin, nativeFatCubin, JNI_ABORT);
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleUnloadNative
+ * Signature: (Ljcuda/driver/CUmodule;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleUnloadNative
+  (JNIEnv *env, jclass cls, jobject hmod)
+{
+    if (hmod == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hmod' is null for cuModuleUnload");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuModuleUnload\n");
+
+    CUmodule nativeHmod = (CUmodule)getNativePointerValue(env, hmod);
+    symbolStaging.removeModule(nativeHmod);
+    int result = cuModuleUnload(nativeHmod);
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleGetFunctionNative
+ * Signature: (Ljcuda/driver/CUfunction;Ljcuda/driver/CUmodule;Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleGetFunctionNative
+  (JNIEnv *env, jclass cls, jobject hfunc, jobject hmod, jstring name)
+{
+    if (hfunc == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuModuleGetFunction");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (hmod == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hmod' is null for cuModuleGetFunction");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (name == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'name' is null for cuModuleGetFunction");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuModuleGetFunction\n");
+
+    CUfunction nativeHfunc;
+    CUmodule nativeHmod = (CUmodule)getNativePointerValue(env, hmod);
+    char *nativeName = convertString(env, name);
+    if (nativeName == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    int result = cuModuleGetFunction(&nativeHfunc, nativeHmod, nativeName);
+    setNativePointerValue(env, hfunc, (jlong)nativeHfunc);
+    env->SetObjectField(hfunc, CUfunction_future, NULL);
+    env->SetObjectField(hfunc, CUfunction_name, NULL);
+    delete[] nativeName;
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleGetGlobalNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;[JLjcuda/driver/CUmodule;Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleGetGlobalNative
+  (JNIEnv *env, jclass cls, jobject dptr, jlongArray bytes, jobject hmod, jstring name)
+{
+    /* May be null
+    if (dptr == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuModuleGetGlobal");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    */
+    /* May be null
+    if (bytes == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'bytes' is null for cuModuleGetGlobal");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    */
+    if (hmod == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hmod' is null for cuModuleGetGlobal");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (name == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'name' is null for cuModuleGetGlobal");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuModuleGetGlobal\n");
+
+    CUdeviceptr nativeDptr = (CUdeviceptr)NULL;
+    size_t nativeBytes = 0;
+
+    CUmodule nativeHmod = (CUmodule)getNativePointerValue(env, hmod);
+
+    char *nativeName = convertString(env, name);
+    if (nativeName == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    int result = cuModuleGetGlobal(&nativeDptr, &nativeBytes, nativeHmod, nativeName);
+
+    setPointer(env, dptr, (jlong)nativeDptr);
+    if (!set(env, bytes, 0, nativeBytes)) return JCUDA_INTERNAL_ERROR;
+    delete[] nativeName;
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuSymbolUpdateStageNative
+ * Signature: (Ljcuda/driver/CUmodule;Ljava/lang/String;JLjcuda/Pointer;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuSymbolUpdateStageNative
+  (JNIEnv *env, jclass cls, jobject hmod, jstring name, jlong offset, jobject src, jlong bytes)
+{
+    if (hmod == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hmod' is null for cuSymbolUpdateStage");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (name == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'name' is null for cuSymbolUpdateStage");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (src == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'src' is null for cuSymbolUpdateStage");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuSymbolUpdateStage\n");
+
+    CUmodule nativeHmod = (CUmodule)getNativePointerValue(env, hmod);
+    char *nativeName = convertString(env, name);
+    if (nativeName == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    PointerData *srcPointerData = initPointerData(env, src);
+    if (srcPointerData == NULL)
+    {
+        delete[] nativeName;
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+    int result = symbolStaging.stage(nativeHmod, nativeName,
+        (size_t)offset, (void*)srcPointerData->getPointer(env), (size_t)bytes);
+
+    delete[] nativeName;
+    if (!releasePointerData(env, srcPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuSymbolUpdateFlushNative
+ * Signature: (Ljcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuSymbolUpdateFlushNative
+  (JNIEnv *env, jclass cls, jobject hStream)
+{
+    Logger::log(LOG_TRACE, "Executing cuSymbolUpdateFlush\n");
+
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    int result = symbolStaging.flush(nativeHStream);
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuSymbolUpdateGetStatisticsNative
+ * Signature: ([J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuSymbolUpdateGetStatisticsNative
+  (JNIEnv *env, jclass cls, jlongArray updates, jlongArray copies, jlongArray bytes)
+{
+    if (updates == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'updates' is null for cuSymbolUpdateGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (copies == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'copies' is null for cuSymbolUpdateGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (bytes == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'bytes' is null for cuSymbolUpdateGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuSymbolUpdateGetStatistics\n");
+
+    SymbolStagingStatistics statistics;
+    symbolStaging.getStatistics(&statistics);
+    if (!set(env, updates, 0, (jlong)statistics.updates)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, copies, 0, (jlong)statistics.copies)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, bytes, 0, (jlong)statistics.bytes)) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleGetTexRefNative
+ * Signature: (Ljcuda/driver/CUtexref;Ljcuda/driver/CUmodule;Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleGetTexRefNative
+  (JNIEnv *env, jclass cls, jobject pTexRef, jobject hmod, jstring name)
+{
+    if (pTexRef == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pTexRef' is null for cuModuleGetTexRef");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (hmod == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hmod' is null for cuModuleGetTexRef");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (name == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'name' is null for cuModuleGetTexRef");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuModuleGetTexRef\n");
+
+    CUtexref nativePTexRef = NULL;
+
+    CUmodule nativeHmod = (CUmodule)getNativePointerValue(env, hmod);
+
+    char *nativeName = convertString(env, name);
+    if (nativeName == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    int result = cuModuleGetTexRef(&nativePTexRef, nativeHmod, nativeName);
+
+    setNativePointerValue(env, pTexRef, (jlong)nativePTexRef);
+    delete[] nativeName;
+    return result;
+
+}
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleGetSurfRefNative
+ * Signature: (Ljcuda/driver/CUsurfref;Ljcuda/driver/CUmodule;Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleGetSurfRefNative
+  (JNIEnv *env, jclass cls, jobject pSurfRef, jobject hmod, jstring name)
+{
+    if (pSurfRef == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pSurfRef' is null for cuModuleGetSurfRef");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (hmod == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hmod' is null for cuModuleGetSurfRef");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (name == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'name' is null for cuModuleGetSurfRef");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuModuleGetSurfRef\n");
+
+    CUsurfref nativePSurfRef = NULL;
+
+    CUmodule nativeHmod = (CUmodule)getNativePointerValue(env, hmod);
+
+    char *nativeName = convertString(env, name);
+    if (nativeName == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    int result = cuModuleGetSurfRef(&nativePSurfRef, nativeHmod, nativeName);
+
+    setNativePointerValue(env, pSurfRef, (jlong)nativePSurfRef);
+    delete[] nativeName;
+    return result;
+
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuLinkCreateNative
+ * Signature: (Ljcuda/driver/JITOptions;Ljcuda/driver/CUlinkState;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkCreateNative
+  (JNIEnv *env, jclass cls, jobject jitOptions, jobject stateOut)
+{
+    if (stateOut == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'stateOut' is null for cuLinkCreate");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuLinkCreate\n");
+
+    CUlinkState nativeStateOut;
+	JITOptionsData *jitOptionsData = initJITOptionsData(env, jitOptions);
+	if (jitOptionsData == NULL)
+	{
+        return JCUDA_INTERNAL_ERROR;
+	}
+    int result = cuLinkCreate((unsigned int)jitOptionsData->numOptions, jitOptionsData->options, jitOptionsData->optionValues, &nativeStateOut);
+
+	if (!releaseJITOptionsData(env, jitOptionsData, jitOptions)) return JCUDA_INTERNAL_ERROR;
+    setNativePointerValue(env, stateOut, (jlong)nativeStateOut);
+	return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuLinkAddDataNative
+ * Signature: (Ljcuda/driver/CUlinkState;ILjcuda/Pointer;JLjava/lang/String;Ljcuda/driver/JITOptions;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkAddDataNative
+  (JNIEnv *env, jclass cls, jobject state, jint type, jobject data, jlong size, jstring name, jobject jitOptions)
+{
+    if (state == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'state' is null for cuLinkAddData");
+        return JCUDA_INTERNAL_ERROR;
+    }
+	// name and jitOptions may be null
+    
+	Logger::log(LOG_TRACE, "Executing cuLinkAddData\n");
+
+    CUlinkState nativeState = (CUlinkState)getNativePointerValue(env, state);
+    PointerData *dataPointerData = initPointerData(env, data);
+    if (dataPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    char *nativeName = convertString(env, name);
+
+	JITOptionsData *jitOptionsData = initJITOptionsData(env, jitOptions);
+	if (jitOptionsData == NULL)
+	{
+        return JCUDA_INTERNAL_ERROR;
+	}
+    
+	int result = cuLinkAddData(nativeState, (CUjitInputType)type, dataPointerData->getPointer(env), (size_t)size, nativeName, 
+		(unsigned int)jitOptionsData->numOptions, jitOptionsData->options, jitOptionsData->optionValues);
+
+    if (!releasePointerData(env, dataPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    delete[] nativeName;
+	if (!releaseJITOptionsData(env, jitOptionsData, jitOptions)) return JCUDA_INTERNAL_ERROR;
+	return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuLinkAddFileNative
+ * Signature: (Ljcuda/driver/CUlinkState;ILjava/lang/String;Ljcuda/driver/JITOptions;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkAddFileNative
+  (JNIEnv *env, jclass cls, jobject state, jint type, jstring path, jobject jitOptions)
+{
+    if (state == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'state' is null for cuLinkAddFile");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (path == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'state' is null for cuLinkAddFile");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    
+	Logger::log(LOG_TRACE, "Executing cuLinkAddFile\n");
+
+    CUlinkState nativeState = (CUlinkState)getNativePointerValue(env, state);
+    char *nativePath = convertString(env, path);
+
+	JITOptionsData *jitOptionsData = initJITOptionsData(env, jitOptions);
+	if (jitOptionsData == NULL)
+	{
+        return JCUDA_INTERNAL_ERROR;
+	}
+    
+	int result = cuLinkAddFile(nativeState, (CUjitInputType)type, nativePath, 
+		(unsigned int)jitOptionsData->numOptions, jitOptionsData->options, jitOptionsData->optionValues);
+
+    delete[] nativePath;
+	if (!releaseJITOptionsData(env, jitOptionsData, jitOptions)) return JCUDA_INTERNAL_ERROR;
+	return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuLinkCompleteNative
+ * Signature: (Ljcuda/driver/CUlinkState;Ljcuda/Pointer;[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkCompleteNative
+  (JNIEnv *env, jclass cls, jobject state, jobject cubinOut, jlongArray sizeOut)
+{
+    if (state == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'state' is null for cuLinkComplete");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (cubinOut == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'cubinOut' is null for cuLinkComplete");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    
+	Logger::log(LOG_TRACE, "Executing cuLinkComplete\n");
+
+    CUlinkState nativeState = (CUlinkState)getNativePointerValue(env, state);
+	void *nativeCubinOut;
+	size_t nativeSizeOut;
+    
+	int result = cuLinkComplete(nativeState, &nativeCubinOut, &nativeSizeOut);
+
+	setNativePointerValue(env, cubinOut, (jlong)nativeCubinOut);
+	if (sizeOut != NULL)
+	{
+		set(env, sizeOut, 0, nativeSizeOut);
+	}
+	return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuLinkDestroyNative
+ * Signature: (Ljcuda/driver/CUlinkState;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkDestroyNative
+  (JNIEnv *env, jclass cls, jobject state)
+{
+    if (state == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'state' is null for cuLinkDestroy");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    
+	Logger::log(LOG_TRACE, "Executing cuLinkDestroy\n");
+
+    CUlinkState nativeState = (CUlinkState)getNativePointerValue(env, state);
+    
+	int result = cuLinkDestroy(nativeState);
+	return result;
+}
+
+
+/**
+ * An input of a link that was created with cuCachedLinkCreate: A copy
+ * of the data, and a global reference to the JIT options, if any
+ */
+struct CachedLinkInput
+{
+    int type;
+    char *data;
+    size_t size;
+    char *name;
+    jobject jitOptions;
+};
+
+/**
+ * The state of a link that was created with cuCachedLinkCreate. The
+ * inputs are recorded, and only passed to the linker when the image
+ * is not found in the cache.
+ */
+struct CachedLink
+{
+    LinkCache *cache;
+    jobject jitOptions;
+    std::vector<CachedLinkInput> inputs;
+    LinkKeyBuilder keyBuilder;
+
+    /** The entry of the completed image, or NULL */
+    LinkCacheEntry *entry;
+};
+
+/**
+ * Adds the options of the given JITOptions object, which may be NULL,
+ * to the given key. Returns false if an error occurred.
+ */
+bool addJITOptionsToKey(JNIEnv *env, LinkKeyBuilder &keyBuilder, jobject jitOptions)
+{
+    JITOptionsData *jitOptionsData = initJITOptionsData(env, jitOptions);
+    if (jitOptionsData == NULL)
+    {
+        return false;
+    }
+    keyBuilder.addOptions(jitOptionsData->numOptions, jitOptionsData->options, jitOptionsData->optionValues);
+    return releaseJITOptionsData(env, jitOptionsData, jitOptions);
+}
+
+/**
+ * Records the given input for the given link. The data is owned
+ * by the link afterwards. Returns false if an error occurred.
+ */
+bool addCachedLinkInput(JNIEnv *env, CachedLink *link, int type, char *data, size_t size, char *name, jobject jitOptions)
+{
+    CachedLinkInput input;
+    input.type = type;
+    input.data = data;
+    input.size = size;
+    input.name = name;
+    input.jitOptions = NULL;
+    if (jitOptions != NULL)
+    {
+        input.jitOptions = env->NewGlobalRef(jitOptions);
+    }
+    link->inputs.push_back(input);
+    link->keyBuilder.addInput(type, data, size);
+    return addJITOptionsToKey(env, link->keyBuilder, jitOptions);
+}
+
+/**
+ * Passes the recorded inputs of the given link to the linker, and
+ * inserts the resulting image into the cache. The JIT options of the
+ * link and its inputs receive the outputs of the linker.
+ */
+CUresult linkCachedLink(JNIEnv *env, CachedLink *link, const LinkCacheKey &key)
+{
+    jcuda_int64 before = getNanoTime();
+    JITOptionsData *jitOptionsData = initJITOptionsData(env, link->jitOptions);
+    if (jitOptionsData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    CUlinkState state = NULL;
+    CUresult result = cuLinkCreate((unsigned int)jitOptionsData->numOptions,
+        jitOptionsData->options, jitOptionsData->optionValues, &state);
+    for (size_t i=0; i<link->inputs.size() && result == CUDA_SUCCESS; i++)
+    {
+        CachedLinkInput &input = link->inputs[i];
+        JITOptionsData *inputOptionsData = initJITOptionsData(env, input.jitOptions);
+        if (inputOptionsData == NULL)
+        {
+            cuLinkDestroy(state);
+            releaseJITOptionsData(env, jitOptionsData, link->jitOptions);
+            return JCUDA_INTERNAL_ERROR;
+        }
+        result = cuLinkAddData(state, (CUjitInputType)input.type, input.data, input.size, input.name,
+            (unsigned int)inputOptionsData->numOptions, inputOptionsData->options, inputOptionsData->optionValues);
+        if (!releaseJITOptionsData(env, inputOptionsData, input.jitOptions))
+        {
+            cuLinkDestroy(state);
+            releaseJITOptionsData(env, jitOptionsData, link->jitOptions);
+            return JCUDA_INTERNAL_ERROR;
+        }
+    }
+    if (result == CUDA_SUCCESS)
+    {
+        void *image = NULL;
+        size_t size = 0;
+        result = cuLinkComplete(state, &image, &size);
+        if (result == CUDA_SUCCESS)
+        {
+            link->entry = link->cache->insert(key, image, size, getNanoTime() - before);
+        }
+    }
+    if (state != NULL)
+    {
+        cuLinkDestroy(state);
+    }
+    if (!releaseJITOptionsData(env, jitOptionsData, link->jitOptions)) return JCUDA_INTERNAL_ERROR;
+    return result;
+}
+
+/**
+ * Reads the contents of the given file. Returns NULL if the file
+ * can not be read.
+ */
+char* readFile(const char *path, size_t *size)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (length < 0)
+    {
+        fclose(file);
+        return NULL;
+    }
+    char *data = new char[(size_t)length + 1];
+    if (fread(data, 1, (size_t)length, file) != (size_t)length)
+    {
+        fclose(file);
+        delete[] data;
+        return NULL;
+    }
+    fclose(file);
+    data[length] = 0;
+    *size = (size_t)length;
+    return data;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuLinkCacheCreateNative
+ * Signature: (Ljcuda/driver/CUlinkCache;Ljava/lang/String;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkCacheCreateNative
+  (JNIEnv *env, jclass cls, jobject cache, jstring directory, jlong maxBytes)
+{
+    if (cache == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'cache' is null for cuLinkCacheCreate");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuLinkCacheCreate\n");
+
+    if (maxBytes < 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    char *nativeDirectory = NULL;
+    if (directory != NULL)
+    {
+        nativeDirectory = convertString(env, directory);
+        if (nativeDirectory == NULL)
+        {
+            return JCUDA_INTERNAL_ERROR;
+        }
+    }
+    LinkCache *nativeCache = new LinkCache(nativeDirectory, (size_t)maxBytes);
+    delete[] nativeDirectory;
+    setNativePointerValue(env, cache, (jlong)nativeCache);
+    return CUDA_SUCCESS;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuLinkCacheDestroyNative
+ * Signature: (Ljcuda/driver/CUlinkCache;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkCacheDestroyNative
+  (JNIEnv *env, jclass cls, jobject cache)
+{
+    if (cache == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'cache' is null for cuLinkCacheDestroy");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuLinkCacheDestroy\n");
+
+    LinkCache *nativeCache = (LinkCache*)getNativePointerValue(env, cache);
+    if (nativeCache == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    delete nativeCache;
+    setNativePointerValue(env, cache, (jlong)0);
+    return CUDA_SUCCESS;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuLinkCacheGetStatisticsNative
+ * Signature: (Ljcuda/driver/CUlinkCache;[J[J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkCacheGetStatisticsNative
+  (JNIEnv *env, jclass cls, jobject cache, jlongArray hits, jlongArray diskHits, jlongArray misses, jlongArray savedTime)
+{
+    if (cache == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'cache' is null for cuLinkCacheGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (hits == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hits' is null for cuLinkCacheGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (diskHits == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'diskHits' is null for cuLinkCacheGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (misses == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'misses' is null for cuLinkCacheGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (savedTime == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'savedTime' is null for cuLinkCacheGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuLinkCacheGetStatistics\n");
+
+    LinkCache *nativeCache = (LinkCache*)getNativePointerValue(env, cache);
+    if (nativeCache == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    jcuda_int64 nativeHits = 0;
+    jcuda_int64 nativeDiskHits = 0;
+    jcuda_int64 nativeMisses = 0;
+    jcuda_int64 nativeSavedTime = 0;
+    nativeCache->getStatistics(&nativeHits, &nativeDiskHits, &nativeMisses, &nativeSavedTime);
+    if (!set(env, hits, 0, (jlong)nativeHits)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, diskHits, 0, (jlong)nativeDiskHits)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, misses, 0, (jlong)nativeMisses)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, savedTime, 0, (jlong)nativeSavedTime)) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCachedLinkCreateNative
+ * Signature: (Ljcuda/driver/CUlinkCache;Ljcuda/driver/JITOptions;Ljcuda/driver/CUcachedLinkState;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCachedLinkCreateNative
+  (JNIEnv *env, jclass cls, jobject cache, jobject jitOptions, jobject stateOut)
+{
+    if (cache == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'cache' is null for cuCachedLinkCreate");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (stateOut == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'stateOut' is null for cuCachedLinkCreate");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuCachedLinkCreate\n");
+
+    LinkCache *nativeCache = (LinkCache*)getNativePointerValue(env, cache);
+    if (nativeCache == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    CachedLink *link = new CachedLink();
+    link->cache = nativeCache;
+    link->jitOptions = NULL;
+    link->entry = NULL;
+    if (jitOptions != NULL)
+    {
+        link->jitOptions = env->NewGlobalRef(jitOptions);
+    }
+    if (!addJITOptionsToKey(env, link->keyBuilder, jitOptions))
+    {
+        if (link->jitOptions != NULL)
+        {
+            env->DeleteGlobalRef(link->jitOptions);
+        }
+        delete link;
+        return JCUDA_INTERNAL_ERROR;
+    }
+    setNativePointerValue(env, stateOut, (jlong)link);
+    return CUDA_SUCCESS;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCachedLinkAddDataNative
+ * Signature: (Ljcuda/driver/CUcachedLinkState;ILjcuda/Pointer;JLjava/lang/String;Ljcuda/driver/JITOptions;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCachedLinkAddDataNative
+  (JNIEnv *env, jclass cls, jobject state, jint type, jobject data, jlong size, jstring name, jobject jitOptions)
+{
+    if (state == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'state' is null for cuCachedLinkAddData");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (data == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'data' is null for cuCachedLinkAddData");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuCachedLinkAddData\n");
+
+    CachedLink *link = (CachedLink*)getNativePointerValue(env, state);
+    if (link == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    if (link->entry != NULL || size < 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    PointerData *dataPointerData = initPointerData(env, data);
+    if (dataPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    char *nativeData = new char[(size_t)size];
+    memcpy(nativeData, dataPointerData->getPointer(env), (size_t)size);
+    if (!releasePointerData(env, dataPointerData, JNI_ABORT))
+    {
+        delete[] nativeData;
+        return JCUDA_INTERNAL_ERROR;
+    }
+    char *nativeName = NULL;
+    if (name != NULL)
+    {
+        nativeName = convertString(env, name);
+    }
+    if (!addCachedLinkInput(env, link, (int)type, nativeData, (size_t)size, nativeName, jitOptions)) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCachedLinkAddFileNative
+ * Signature: (Ljcuda/driver/CUcachedLinkState;ILjava/lang/String;Ljcuda/driver/JITOptions;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCachedLinkAddFileNative
+  (JNIEnv *env, jclass cls, jobject state, jint type, jstring path, jobject jitOptions)
+{
+    if (state == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'state' is null for cuCachedLinkAddFile");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (path == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'path' is null for cuCachedLinkAddFile");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuCachedLinkAddFile\n");
+
+    CachedLink *link = (CachedLink*)getNativePointerValue(env, state);
+    if (link == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    if (link->entry != NULL)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    char *nativePath = convertString(env, path);
+    if (nativePath == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+    // The file is read here, so that its contents contribute to the
+    // key, and it is passed to the linker as data named by the path
+    size_t size = 0;
+    char *nativeData = readFile(nativePath, &size);
+    if (nativeData == NULL)
+    {
+        Logger::log(LOG_ERROR, "Could not read file %s\n", nativePath);
+        delete[] nativePath;
+        return CUDA_ERROR_FILE_NOT_FOUND;
+    }
+    if (type == CU_JIT_INPUT_PTX)
+    {
+        size++;
+    }
+    if (!addCachedLinkInput(env, link, (int)type, nativeData, size, nativePath, jitOptions)) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCachedLinkCompleteNative
+ * Signature: (Ljcuda/driver/CUcachedLinkState;Ljcuda/Pointer;[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCachedLinkCompleteNative
+  (JNIEnv *env, jclass cls, jobject state, jobject cubinOut, jlongArray sizeOut)
+{
+    if (state == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'state' is null for cuCachedLinkComplete");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (cubinOut == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'cubinOut' is null for cuCachedLinkComplete");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuCachedLinkComplete\n");
+
+    CachedLink *link = (CachedLink*)getNativePointerValue(env, state);
+    if (link == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    if (link->entry == NULL)
+    {
+        // The key includes the target of the current context, which
+        // is used when no target is given in the options
+        LinkKeyBuilder keyBuilder = link->keyBuilder;
+        CUdevice device;
+        int major = 0;
+        int minor = 0;
+        if (cuCtxGetDevice(&device) == CUDA_SUCCESS)
+        {
+            cuDeviceGetAttribute(&major, CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MAJOR, device);
+            cuDeviceGetAttribute(&minor, CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MINOR, device);
+        }
+        keyBuilder.addTarget(major, minor);
+        LinkCacheKey key = keyBuilder.getKey();
+        link->entry = link->cache->lookup(key);
+        if (link->entry == NULL)
+        {
+            Logger::log(LOG_DEBUG, "Linked image not found in cache, invoking linker\n");
+            int result = linkCachedLink(env, link, key);
+            if (result != CUDA_SUCCESS)
+            {
+                return result;
+            }
+        }
+    }
+    setNativePointerValue(env, cubinOut, (jlong)link->entry->image);
+    if (sizeOut != NULL)
+    {
+        if (!set(env, sizeOut, 0, (jlong)link->entry->size)) return JCUDA_INTERNAL_ERROR;
+    }
+    return CUDA_SUCCESS;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCachedLinkDestroyNative
+ * Signature: (Ljcuda/driver/CUcachedLinkState;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCachedLinkDestroyNative
+  (JNIEnv *env, jclass cls, jobject state)
+{
+    if (state == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'state' is null for cuCachedLinkDestroy");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuCachedLinkDestroy\n");
+
+    CachedLink *link = (CachedLink*)getNativePointerValue(env, state);
+    if (link == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    for (size_t i=0; i<link->inputs.size(); i++)
+    {
+        CachedLinkInput &input = link->inputs[i];
+        delete[] input.data;
+        delete[] input.name;
+        if (input.jitOptions != NULL)
+        {
+            env->DeleteGlobalRef(input.jitOptions);
+        }
+    }
+    if (link->jitOptions != NULL)
+    {
+        env->DeleteGlobalRef(link->jitOptions);
+    }
+    if (link->entry != NULL)
+    {
+        link->cache->release(link->entry);
+    }
+    delete link;
+    setNativePointerValue(env, state, (jlong)0);
+    return CUDA_SUCCESS;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemGetInfoNative
+ * Signature: ([J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemGetInfoNative
+  (JNIEnv *env, jclass cls, jlongArray free, jlongArray total)
+{
+    if (free == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'free' is null for cuMemGetInfo");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (total == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'total' is null for cuMemGetInfo");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemGetInfo\n");
+
+    size_t nativeFree = 0;
+    size_t nativeTotal = 0;
+    int result = cuMemGetInfo(&nativeFree, &nativeTotal);
+    if (!set(env, free, 0, nativeFree)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, total, 0, nativeTotal)) return JCUDA_INTERNAL_ERROR;
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostAllocNative
+ * Signature: (Ljcuda/Pointer;JI)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostAllocNative
+  (JNIEnv *env, jclass cls, jobject pp, jlong bytesize, jint Flags)
+{
+    if (pp == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pp' is null for cuMemHostAlloc");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemHostAlloc\n");
+
+    void *nativePp;
+    int result = CUDA_SUCCESS;
+    if (!numaPlacement.allocate(&nativePp, (size_t)bytesize, (unsigned int)Flags, &result))
+    {
+        result = cuMemHostAlloc(&nativePp, (size_t)bytesize, (unsigned int)Flags);
+    }
+    if (result == CUDA_SUCCESS)
+    {
+        registerAllocation(nativePp, (size_t)bytesize, ALLOCATION_KIND_HOST);
+        jobject object = env->NewDirectByteBuffer(nativePp, bytesize);
+        env->SetObjectField(pp, Pointer_buffer, object);
+        env->SetObjectField(pp, Pointer_pointers, NULL);
+        env->SetLongField(pp, Pointer_byteOffset, 0);
+        env->SetLongField(pp, NativePointerObject_nativePointer, (jlong)nativePp);
+    }
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostGetDevicePointerNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/Pointer;I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostGetDevicePointerNative
+  (JNIEnv *env, jclass cls, jobject ret, jobject p, jint Flags)
+{
+    if (ret == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ret' is null for cuMemHostGetDevicePointer");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (p == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'p' is null for cuMemHostGetDevicePointer");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemHostGetDevicePointer\n");
+
+    if (!isPointerBackedByNativeMemory(env, p))
+    {
+        ThrowByName(env, "java/lang/IllegalArgumentException",
+            "Pointer must point to a direct buffer or native memory");
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+    CUdeviceptr nativeRet;
+    PointerData *pPointerData = initPointerData(env, p);
+    if (pPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    int result = cuMemHostGetDevicePointer(&nativeRet, (void*)pPointerData->getPointer(env), (unsigned int)Flags);
+    setPointer(env, ret, (jlong)nativeRet);
+    if (!releasePointerData(env, pPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostGetFlagsNative
+ * Signature: ([ILjcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostGetFlagsNative
+  (JNIEnv *env, jclass cls, jintArray pFlags, jobject p)
+{
+    if (pFlags == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pFlags' is null for cuMemHostGetFlags");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (p == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'p' is null for cuMemHostGetFlags");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemHostGetFlags\n");
+
+    if (!isPointerBackedByNativeMemory(env, p))
+    {
+        ThrowByName(env, "java/lang/IllegalArgumentException",
+            "Pointer must point to a direct buffer or native memory");
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+    PointerData *pPointerData = initPointerData(env, p);
+    if (pPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+    unsigned int nativePFlags;
+    int result = cuMemHostGetFlags(&nativePFlags, (void*)pPointerData->getPointer(env));
+    if (!set(env, pFlags, 0, nativePFlags)) return JCUDA_INTERNAL_ERROR;
+    if (!releasePointerData(env, pPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuDeviceGetByPCIBusIdNative
+ * Signature: (Ljcuda/driver/CUdevice;Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuDeviceGetByPCIBusIdNative
+  (JNIEnv *env, jclass cls, jobject dev, jstring pciBusId)
+{
+    if (dev == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dev' is null for cuDeviceGetByPCIBusId");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (pciBusId == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pciBusId' is null for cuDeviceGetByPCIBusId");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuDeviceGetByPCIBusId\n");
+
+    char *nativePciBusId = convertString(env, pciBusId);
+
+    CUdevice nativeDev;
+    int result = cuDeviceGetByPCIBusId(&nativeDev, nativePciBusId);
+    setNativePointerValue(env, dev, (jlong)nativeDev);
+    delete[] nativePciBusId;
+
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuDeviceGetPCIBusIdNative
+ * Signature: ([Ljava/lang/String;ILjcuda/driver/CUdevice;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuDeviceGetPCIBusIdNative
+  (JNIEnv *env, jclass cls, jobjectArray pciBusId, jint len, jobject dev)
+{
+    if (pciBusId == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pciBusId' is null for cuDeviceGetPCIBusId");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (dev == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dev' is null for cuDeviceGetPCIBusId");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuDeviceGetPCIBusId\n");
+
+    char *nativePciBusId = new char[(int)len];
+    CUdevice nativeDev = (CUdevice)(intptr_t)getNativePointerValue(env, dev);
+    int result = cuDeviceGetPCIBusId(nativePciBusId, (int)len, nativeDev);
+
+    jstring pciBusIdElement = env->NewStringUTF(nativePciBusId);
+    if (pciBusIdElement == NULL)
+    {
+       ThrowByName(env, "java/lang/OutOfMemoryError", "Out of memory creating result string");
+       return JCUDA_INTERNAL_ERROR;
+    }
+    delete[] nativePciBusId;
+    env->SetObjectArrayElement(pciBusId, 0, pciBusIdElement);
+    if (env->ExceptionCheck())
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcGetEventHandleNative
+ * Signature: (Ljcuda/driver/CUipcEventHandle;Ljcuda/driver/CUevent;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcGetEventHandleNative
+  (JNIEnv *env, jclass cls, jobject pHandle, jobject event)
+{
+    if (pHandle == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pHandle' is null for cuIpcGetEventHandle");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (event == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'event' is null for cuIpcGetEventHandle");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuIpcGetEventHandle\n");
+
+    CUevent nativeEvent = (CUevent)getNativePointerValue(env, event);
+    CUipcEventHandle nativePHandle;
+
+    int result = cuIpcGetEventHandle(&nativePHandle, nativeEvent);
+    setCUipcEventHandle(env, pHandle, nativePHandle);
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcOpenEventHandleNative
+ * Signature: (Ljcuda/driver/CUevent;Ljcuda/driver/CUipcEventHandle;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcOpenEventHandleNative
+  (JNIEnv *env, jclass cls, jobject phEvent, jobject handle)
+{
+    if (phEvent == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phEvent' is null for cuIpcOpenEventHandle");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (handle == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'handle' is null for cuIpcOpenEventHandle");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuIpcOpenEventHandle\n");
+
+    CUevent nativePhEvent;
+    CUipcEventHandle nativeHandle = getCUipcEventHandle(env, handle);
+    int result = cuIpcOpenEventHandle(&nativePhEvent, nativeHandle);
+
+    setNativePointerValue(env, phEvent, (jlong)nativePhEvent);
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcGetMemHandleNative
+ * Signature: (Ljcuda/driver/CUipcMemHandle;Ljcuda/driver/CUdeviceptr;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcGetMemHandleNative
+  (JNIEnv *env, jclass cls, jobject pHandle, jobject dptr)
+{
+    if (pHandle == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pHandle' is null for cuIpcGetMemHandle");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (dptr == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuIpcGetMemHandle");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuIpcGetMemHandle\n");
+
+    CUipcMemHandle nativePHandle;
+    CUdeviceptr nativeDptr = (CUdeviceptr)getPointer(env, dptr);
+
+    int result = cuIpcGetMemHandle(&nativePHandle, nativeDptr);
+    setCUipcMemHandle(env, pHandle, nativePHandle);
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcOpenMemHandleNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUipcMemHandle;I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcOpenMemHandleNative
+  (JNIEnv *env, jclass cls, jobject pdptr, jobject handle, jint Flags)
+{
+    if (pdptr == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pdptr' is null for cuIpcOpenMemHandle");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (handle == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'handle' is null for cuIpcOpenMemHandle");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuIpcOpenMemHandle\n");
+
+    CUipcMemHandle nativeHandle = getCUipcMemHandle(env, handle);
+    CUdeviceptr nativePdptr = NULL;
+
+    int result = cuIpcOpenMemHandle(&nativePdptr, nativeHandle, (int)Flags);
+
+    setPointer(env, pdptr, (jlong)nativePdptr);
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcCloseMemHandleNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcCloseMemHandleNative
+  (JNIEnv *env, jclass cls, jobject dptr)
+{
+    if (dptr == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuIpcCloseMemHandle");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuIpcCloseMemHandle\n");
+
+    CUdeviceptr nativeDptr = (CUdeviceptr)getPointer(env, dptr);
+
+    int result = cuIpcCloseMemHandle(nativeDptr);
+    return result;
+}
+
+/**
+ * The EvictionFunction for IPC registries: Closes all handles
+ * that are no longer referenced
+ */
+size_t trimIpcRegistry(void *userData, int device, size_t bytes)
+{
+    IpcRegistry *registry = (IpcRegistry*)userData;
+    registry->trim();
+    return 0;
+}
+
+/**
+ * The EvictionMatchFunction that matches the given user data
+ */
+bool matchUserData(void *userData, void *argument)
+{
+    return userData == argument;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryCreateNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;Ljava/lang/String;II)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryCreateNative
+  (JNIEnv *env, jclass cls, jobject registry, jstring segmentName, jint slotCount, jint maxIdle)
+{
+    if (registry == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'registry' is null for cuIpcRegistryCreate");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuIpcRegistryCreate\n");
+
+    if (maxIdle < 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    IpcRegistry *nativeRegistry = new IpcRegistry((int)maxIdle);
+    if (segmentName != NULL)
+    {
+        char *nativeSegmentName = convertString(env, segmentName);
+        if (nativeSegmentName == NULL)
+        {
+            delete nativeRegistry;
+            return JCUDA_INTERNAL_ERROR;
+        }
+        CUresult result = nativeRegistry->attach(nativeSegmentName, (int)slotCount);
+        delete[] nativeSegmentName;
+        if (result != CUDA_SUCCESS)
+        {
+            delete nativeRegistry;
+            return result;
+        }
+    }
+    MemoryGovernor::addEvictionFunction(&trimIpcRegistry, NULL, nativeRegistry, -1, true);
+    {
+        MutexLock lock(ipcRegistriesMutex);
+        ipcRegistries.push_back(nativeRegistry);
+    }
+    setNativePointerValue(env, registry, (jlong)nativeRegistry);
+    return CUDA_SUCCESS;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryDestroyNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryDestroyNative
+  (JNIEnv *env, jclass cls, jobject registry)
+{
+    if (registry == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'registry' is null for cuIpcRegistryDestroy");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuIpcRegistryDestroy\n");
+
+    IpcRegistry *nativeRegistry = (IpcRegistry*)getNativePointerValue(env, registry);
+    if (nativeRegistry == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    MemoryGovernor::removeEvictionFunctions(&matchUserData, nativeRegistry);
+    {
+        MutexLock lock(ipcRegistriesMutex);
+        for (size_t i=0; i<ipcRegistries.size(); i++)
+        {
+            if (ipcRegistries[i] == nativeRegistry)
+            {
+                ipcRegistries.erase(ipcRegistries.begin() + i);
+                break;
+            }
+        }
+    }
+    delete nativeRegistry;
+    setNativePointerValue(env, registry, (jlong)0);
+    return CUDA_SUCCESS;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryOpenMemHandleNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUipcMemHandle;I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryOpenMemHandleNative
+  (JNIEnv *env, jclass cls, jobject registry, jobject pdptr, jobject handle, jint Flags)
+{
+    if (registry == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'registry' is null for cuIpcRegistryOpenMemHandle");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (pdptr == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pdptr' is null for cuIpcRegistryOpenMemHandle");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (handle == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'handle' is null for cuIpcRegistryOpenMemHandle");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuIpcRegistryOpenMemHandle\n");
+
+    IpcRegistry *nativeRegistry = (IpcRegistry*)getNativePointerValue(env, registry);
+    if (nativeRegistry == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    CUipcMemHandle nativeHandle = getCUipcMemHandle(env, handle);
+    CUdeviceptr nativePdptr = 0;
+    int result = nativeRegistry->open(nativeHandle, (unsigned int)Flags, &nativePdptr);
+    setPointer(env, pdptr, (jlong)nativePdptr);
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryCloseMemHandleNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;Ljcuda/driver/CUdeviceptr;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryCloseMemHandleNative
+  (JNIEnv *env, jclass cls, jobject registry, jobject dptr)
+{
+    if (registry == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'registry' is null for cuIpcRegistryCloseMemHandle");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (dptr == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuIpcRegistryCloseMemHandle");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuIpcRegistryCloseMemHandle\n");
+
+    IpcRegistry *nativeRegistry = (IpcRegistry*)getNativePointerValue(env, registry);
+    if (nativeRegistry == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    CUdeviceptr nativeDptr = (CUdeviceptr)getPointer(env, dptr);
+    return nativeRegistry->release(nativeDptr);
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryTrimNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryTrimNative
+  (JNIEnv *env, jclass cls, jobject registry)
+{
+    if (registry == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'registry' is null for cuIpcRegistryTrim");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuIpcRegistryTrim\n");
+
+    IpcRegistry *nativeRegistry = (IpcRegistry*)getNativePointerValue(env, registry);
+    if (nativeRegistry == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    return nativeRegistry->trim();
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryPublishNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;Ljava/lang/String;Ljcuda/driver/CUdeviceptr;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryPublishNative
+  (JNIEnv *env, jclass cls, jobject registry, jstring name, jobject dptr, jlong bytesize)
+{
+    if (registry == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'registry' is null for cuIpcRegistryPublish");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (name == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'name' is null for cuIpcRegistryPublish");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (dptr == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuIpcRegistryPublish");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuIpcRegistryPublish\n");
+
+    IpcRegistry *nativeRegistry = (IpcRegistry*)getNativePointerValue(env, registry);
+    if (nativeRegistry == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    char *nativeName = convertString(env, name);
+    if (nativeName == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    CUdeviceptr nativeDptr = (CUdeviceptr)getPointer(env, dptr);
+    int result = nativeRegistry->publish(nativeName, nativeDptr, (size_t)bytesize);
+    delete[] nativeName;
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryUnpublishNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryUnpublishNative
+  (JNIEnv *env, jclass cls, jobject registry, jstring name)
+{
+    if (registry == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'registry' is null for cuIpcRegistryUnpublish");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (name == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'name' is null for cuIpcRegistryUnpublish");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuIpcRegistryUnpublish\n");
+
+    IpcRegistry *nativeRegistry = (IpcRegistry*)getNativePointerValue(env, registry);
+    if (nativeRegistry == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    char *nativeName = convertString(env, name);
+    if (nativeName == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    int result = nativeRegistry->unpublish(nativeName);
+    delete[] nativeName;
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryOpenNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;Ljcuda/driver/CUdeviceptr;[JLjava/lang/String;I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryOpenNative
+  (JNIEnv *env, jclass cls, jobject registry, jobject pdptr, jlongArray bytesize, jstring name, jint Flags)
+{
+    if (registry == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'registry' is null for cuIpcRegistryOpen");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (pdptr == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pdptr' is null for cuIpcRegistryOpen");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (name == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'name' is null for cuIpcRegistryOpen");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuIpcRegistryOpen\n");
+
+    IpcRegistry *nativeRegistry = (IpcRegistry*)getNativePointerValue(env, registry);
+    if (nativeRegistry == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    char *nativeName = convertString(env, name);
+    if (nativeName == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    CUdeviceptr nativePdptr = 0;
+    size_t nativeBytesize = 0;
+    int result = nativeRegistry->openPublished(nativeName, (unsigned int)Flags, &nativePdptr, &nativeBytesize);
+    delete[] nativeName;
+    setPointer(env, pdptr, (jlong)nativePdptr);
+    if (bytesize != NULL)
+    {
+        if (!set(env, bytesize, 0, (jlong)nativeBytesize)) return JCUDA_INTERNAL_ERROR;
+    }
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryGetStatisticsNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryGetStatisticsNative
+  (JNIEnv *env, jclass cls, jobject registry, jlongArray opened, jlongArray hits)
+{
+    if (registry == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'registry' is null for cuIpcRegistryGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (opened == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'opened' is null for cuIpcRegistryGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (hits == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hits' is null for cuIpcRegistryGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuIpcRegistryGetStatistics\n");
+
+    IpcRegistry *nativeRegistry = (IpcRegistry*)getNativePointerValue(env, registry);
+    if (nativeRegistry == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    jcuda_int64 nativeOpened = 0;
+    jcuda_int64 nativeHits = 0;
+    nativeRegistry->getStatistics(&nativeOpened, &nativeHits);
+    if (!set(env, opened, 0, (jlong)nativeOpened)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, hits, 0, (jlong)nativeHits)) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
+}
+
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostRegisterNative
+ * Signature: (Ljcuda/Pointer;JI)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostRegisterNative
+  (JNIEnv *env, jclass cls, jobject p, jlong bytesize, jint Flags)
+{
+    if (p == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'p' is null for cuMemHostRegister");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemHostRegister\n");
+
+    if (!isPointerBackedByNativeMemory(env, p))
+    {
+        ThrowByName(env, "java/lang/IllegalArgumentException",
+            "Pointer must point to a direct buffer or native memory");
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+    PointerData *pPointerData = initPointerData(env, p);
+    if (pPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    void *nativeP = (void*)pPointerData->getPointer(env);
+    int result = cuMemHostRegister(nativeP, (size_t)bytesize, (unsigned int)Flags);
+    if (result == CUDA_SUCCESS)
+    {
+        registerAllocation(nativeP, (size_t)bytesize, ALLOCATION_KIND_HOST);
+    }
+    if (!releasePointerData(env, pPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostUnregisterNative
+ * Signature: (Ljcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostUnregisterNative
+  (JNIEnv *env, jclass cls, jobject p)
+{
+    if (p == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'p' is null for cuMemHostUnregister");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemHostUnregister\n");
+
+    PointerData *pPointerData = initPointerData(env, p);
+    if (pPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    void *nativeP = (void*)pPointerData->getPointer(env);
+    int result = cuMemHostUnregister(nativeP);
+    if (result == CUDA_SUCCESS)
+    {
+        allocationRegistry.remove(nativeP);
+    }
+    if (!releasePointerData(env, pPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRegistrationCacheEnableNative
+ * Signature: (IJ)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRegistrationCacheEnableNative
+  (JNIEnv *env, jclass cls, jint threshold, jlong budget)
+{
+    Logger::log(LOG_TRACE, "Executing cuRegistrationCacheEnable\n");
+
+    if (threshold < 1 || budget < 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    if (!registrationCache.enable(env, (int)threshold, (jcuda_int64)budget))
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    return CUDA_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRegistrationCacheDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRegistrationCacheDisableNative
+  (JNIEnv *env, jclass cls)
+{
+    Logger::log(LOG_TRACE, "Executing cuRegistrationCacheDisable\n");
+
+    registrationCache.disable(env);
+    return CUDA_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRegistrationCacheReleaseNative
+ * Signature: (Ljcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRegistrationCacheReleaseNative
+  (JNIEnv *env, jclass cls, jobject buffer)
+{
+    if (buffer == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'buffer' is null for cuRegistrationCacheRelease");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuRegistrationCacheRelease\n");
+
+    registrationCache.release(env, buffer);
+    return CUDA_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRegistrationCacheGetStatisticsNative
+ * Signature: ([J[J[J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRegistrationCacheGetStatisticsNative
+  (JNIEnv *env, jclass cls, jlongArray registeredCount, jlongArray registeredBytes, jlongArray hits, jlongArray misses, jlongArray evictions)
+{
+    if (registeredCount == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'registeredCount' is null for cuRegistrationCacheGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (registeredBytes == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'registeredBytes' is null for cuRegistrationCacheGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (hits == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hits' is null for cuRegistrationCacheGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (misses == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'misses' is null for cuRegistrationCacheGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (evictions == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'evictions' is null for cuRegistrationCacheGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuRegistrationCacheGetStatistics\n");
+
+    RegistrationCacheStatistics statistics;
+    registrationCache.getStatistics(&statistics);
+    if (!set(env, registeredCount, 0, (jlong)statistics.registeredCount)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, registeredBytes, 0, (jlong)statistics.registeredBytes)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, hits, 0, (jlong)statistics.hits)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, misses, 0, (jlong)statistics.misses)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, evictions, 0, (jlong)statistics.evictions)) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuBounceRingEnableNative
+ * Signature: (JI)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuBounceRingEnableNative
+  (JNIEnv *env, jclass cls, jlong slotSize, jint slotCount)
+{
+    Logger::log(LOG_TRACE, "Executing cuBounceRingEnable\n");
+
+    if (slotSize < 1 || slotCount < 1)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    bounceRing.enable(env, (size_t)slotSize, (int)slotCount);
+    return CUDA_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuBounceRingDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuBounceRingDisableNative
+  (JNIEnv *env, jclass cls)
+{
+    Logger::log(LOG_TRACE, "Executing cuBounceRingDisable\n");
+
+    bounceRing.disable(env);
+    return CUDA_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuBounceRingGetStatisticsNative
+ * Signature: ([J[J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuBounceRingGetStatisticsNative
+  (JNIEnv *env, jclass cls, jlongArray copies, jlongArray bytes, jlongArray waits, jlongArray pending)
+{
+    if (copies == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'copies' is null for cuBounceRingGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (bytes == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'bytes' is null for cuBounceRingGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (waits == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'waits' is null for cuBounceRingGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (pending == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pending' is null for cuBounceRingGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuBounceRingGetStatistics\n");
+
+    BounceRingStatistics statistics;
+    bounceRing.getStatistics(&statistics);
+    if (!set(env, copies, 0, (jlong)statistics.copies)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, bytes, 0, (jlong)statistics.bytes)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, waits, 0, (jlong)statistics.waits)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, pending, 0, (jlong)statistics.pending)) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPitchPackerEnableNative
+ * Signature: (IJ)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPitchPackerEnableNative
+  (JNIEnv *env, jclass cls, jint threadCount, jlong threshold)
+{
+    Logger::log(LOG_TRACE, "Executing cuPitchPackerEnable\n");
+
+    if (threshold < 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    if (!pitchPacker.enable((int)threadCount, (size_t)threshold))
+    {
+        return CUDA_ERROR_UNKNOWN;
+    }
+    return CUDA_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPitchPackerDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPitchPackerDisableNative
+  (JNIEnv *env, jclass cls)
+{
+    Logger::log(LOG_TRACE, "Executing cuPitchPackerDisable\n");
+
+    pitchPacker.disable();
+    return CUDA_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPitchPackerGetStatisticsNative
+ * Signature: ([J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPitchPackerGetStatisticsNative
+  (JNIEnv *env, jclass cls, jlongArray copies, jlongArray bytes, jlongArray nanos)
+{
+    if (copies == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'copies' is null for cuPitchPackerGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (bytes == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'bytes' is null for cuPitchPackerGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (nanos == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'nanos' is null for cuPitchPackerGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuPitchPackerGetStatistics\n");
+
+    PitchPackerStatistics statistics;
+    pitchPacker.getStatistics(&statistics);
+    if (!set(env, copies, 0, (jlong)statistics.copies)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, bytes, 0, (jlong)statistics.bytes)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, nanos, 0, (jlong)statistics.nanos)) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUdeviceptr;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyNative
+  (JNIEnv *env, jclass cls, jobject dst, jobject src, jlong ByteCount)
+{
+    if (dst == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dst' is null for cuMemcpy");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (src == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'src' is null for cuMemcpy");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpy\n");
+
+    CUdeviceptr nativeDst = (CUdeviceptr)getPointer(env, dst);
+    CUdeviceptr nativeSrc = (CUdeviceptr)getPointer(env, src);
+    int result = cuMemcpy(nativeDst, nativeSrc, (size_t)ByteCount);
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyAutoNative
+ * Signature: (Ljcuda/Pointer;Ljcuda/Pointer;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAutoNative
+  (JNIEnv *env, jclass cls, jobject dst, jobject src, jlong ByteCount)
+{
+    if (dst == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dst' is null for cuMemcpyAuto");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (src == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'src' is null for cuMemcpyAuto");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpyAuto of %ld bytes\n", (long)ByteCount);
+
+    // Obtain the destination and source pointers
+    PointerData *dstPointerData = initPointerData(env, dst);
+    if (dstPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    PointerData *srcPointerData = initPointerData(env, src);
+    if (srcPointerData == NULL)
+    {
+        releasePointerData(env, dstPointerData, JNI_ABORT);
+        return JCUDA_INTERNAL_ERROR;
+    }
+    void *nativeDst = dstPointerData->getPointer(env);
+    void *nativeSrc = srcPointerData->getPointer(env);
+    size_t nativeByteCount = (size_t)ByteCount;
+
+    AllocationInfo dstInfo;
+    AllocationInfo srcInfo;
+    lookupAllocation(env, dst, nativeDst, &dstInfo);
+    lookupAllocation(env, src, nativeSrc, &srcInfo);
+
+    int result = JCUDA_INTERNAL_ERROR;
+    CopyPath path = AllocationRegistry::selectCopyPath(dstInfo, srcInfo);
+    switch (path)
+    {
+        case COPY_PATH_HOST_TO_HOST:
+            Logger::log(LOG_DEBUGTRACE, "Copying %ld bytes from host to host\n", (long)ByteCount);
+            memcpy(nativeDst, nativeSrc, nativeByteCount);
+            result = CUDA_SUCCESS;
+            break;
+
+        case COPY_PATH_HOST_TO_DEVICE:
+            Logger::log(LOG_DEBUGTRACE, "Copying %ld bytes from host to device\n", (long)ByteCount);
+            result = cuMemcpyHtoD((CUdeviceptr)nativeDst, nativeSrc, nativeByteCount);
+            break;
+
+        case COPY_PATH_DEVICE_TO_HOST:
+            Logger::log(LOG_DEBUGTRACE, "Copying %ld bytes from device to host\n", (long)ByteCount);
+            result = cuMemcpyDtoH(nativeDst, (CUdeviceptr)nativeSrc, nativeByteCount);
+            break;
+
+        case COPY_PATH_DEVICE_TO_DEVICE:
+            Logger::log(LOG_DEBUGTRACE, "Copying %ld bytes from device to device\n", (long)ByteCount);
+            result = cuMemcpyDtoD((CUdeviceptr)nativeDst, (CUdeviceptr)nativeSrc, nativeByteCount);
+            break;
+
+        case COPY_PATH_PEER:
+            if (dstInfo.owner != NULL && srcInfo.owner != NULL)
+            {
+                Logger::log(LOG_DEBUGTRACE, "Copying %ld bytes from device %d to device %d\n", (long)ByteCount, srcInfo.device, dstInfo.device);
+                result = cuMemcpyPeer((CUdeviceptr)nativeDst, (CUcontext)dstInfo.owner,
+                    (CUdeviceptr)nativeSrc, (CUcontext)srcInfo.owner, nativeByteCount);
+                break;
+            }
+            // Fall through if the contexts are not known
+
+        default:
+            Logger::log(LOG_DEBUGTRACE, "Copying %ld bytes with unified addressing\n", (long)ByteCount);
+            result = cuMemcpy((CUdeviceptr)nativeDst, (CUdeviceptr)nativeSrc, nativeByteCount);
+            break;
+    }
+
+    // Release the pointer data
+    if (!releasePointerData(env, dstPointerData)) return JCUDA_INTERNAL_ERROR;
+    if (!releasePointerData(env, srcPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemRegistryLookupNative
+ * Signature: ([I[ILjcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemRegistryLookupNative
+  (JNIEnv *env, jclass cls, jintArray memoryType, jintArray device, jobject ptr)
+{
+    if (memoryType == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'memoryType' is null for cuMemRegistryLookup");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (device == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'device' is null for cuMemRegistryLookup");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (ptr == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ptr' is null for cuMemRegistryLookup");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemRegistryLookup\n");
+
+    void *nativePtr = getPointer(env, ptr);
+    AllocationInfo info;
+    allocationRegistry.activate();
+    allocationRegistry.lookup(nativePtr, &info);
+    if (!set(env, memoryType, 0, info.kind)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, device, 0, info.device)) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyPeerNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUcontext;Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUcontext;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyPeerNative
+  (JNIEnv *env, jclass cls, jobject dstDevice, jobject dstContext, jobject srcDevice, jobject srcContext, jlong ByteCount)
+{
+    if (dstDevice == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyPeer");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (dstContext == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstContext' is null for cuMemcpyPeer");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (srcDevice == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyPeer");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (srcContext == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstContext' is null for cuMemcpyPeer");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpyPeer\n");
+
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+    CUcontext nativeDstContext = (CUcontext)getNativePointerValue(env, dstContext);
+    CUdeviceptr nativeSrcDevice = (CUdeviceptr)getPointer(env, srcDevice);
+    CUcontext nativeSrcContext = (CUcontext)getNativePointerValue(env, srcContext);
+    if (peerRouter.isEnabled())
+    {
+        return peerRouter.copy((void*)nativeDstDevice, getPeerEndpoint(nativeDstContext),
+            (void*)nativeSrcDevice, getPeerEndpoint(nativeSrcContext), (size_t)ByteCount, NULL, false);
+    }
+    int result = cuMemcpyPeer(nativeDstDevice, nativeDstContext, nativeSrcDevice, nativeSrcContext, (size_t)ByteCount);
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyAsyncNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUdeviceptr;JLjcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAsyncNative
+  (JNIEnv *env, jclass cls, jobject dst, jobject src, jlong ByteCount, jobject hStream)
+{
+    if (dst == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dst' is null for cuMemcpyAsync");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (src == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'src' is null for cuMemcpyAsync");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpyAsync\n");
+
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+
+    CUdeviceptr nativeDst = (CUdeviceptr)getPointer(env, dst);
+    CUdeviceptr nativeSrc = (CUdeviceptr)getPointer(env, src);
+
+    OperationGraph *graph = OperationGraph::getCapturing();
+    if (graph != NULL)
+    {
+        graph->addMemcpy(OPERATION_MEMCPY, nativeDst, nativeSrc, (size_t)ByteCount, nativeHStream);
+        return CUDA_SUCCESS;
+    }
+
+    int result = cuMemcpyAsync(nativeDst, nativeSrc, (size_t)ByteCount, nativeHStream);
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyPeerAsyncNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUcontext;Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUcontext;JLjcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyPeerAsyncNative
+  (JNIEnv *env, jclass cls, jobject dstDevice, jobject dstContext, jobject srcDevice, jobject srcContext, jlong ByteCount, jobject hStream)
+{
+    if (dstDevice == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyPeerAsync");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (dstContext == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstContext' is null for cuMemcpyPeerAsync");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (srcDevice == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyPeerAsync");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (srcContext == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstContext' is null for cuMemcpyPeerAsync");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpyPeerAsync\n");
+
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+    CUcontext nativeDstContext = (CUcontext)getNativePointerValue(env, dstContext);
+    CUdeviceptr nativeSrcDevice = (CUdeviceptr)getPointer(env, srcDevice);
+    CUcontext nativeSrcContext = (CUcontext)getNativePointerValue(env, srcContext);
+    if (peerRouter.isEnabled())
+    {
+        return peerRouter.copy((void*)nativeDstDevice, getPeerEndpoint(nativeDstContext),
+            (void*)nativeSrcDevice, getPeerEndpoint(nativeSrcContext), (size_t)ByteCount, nativeHStream, true);
+    }
+    int result = cuMemcpyPeerAsync(nativeDstDevice, nativeDstContext, nativeSrcDevice, nativeSrcContext, (size_t)ByteCount, nativeHStream);
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPeerRouterEnableNative
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPeerRouterEnableNative
+  (JNIEnv *env, jclass cls, jlong chunkSize)
+{
+    Logger::log(LOG_TRACE, "Executing cuPeerRouterEnable\n");
+
+    if (chunkSize <= 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    return peerRouter.enable((size_t)chunkSize);
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPeerRouterDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPeerRouterDisableNative
+  (JNIEnv *env, jclass cls)
+{
+    Logger::log(LOG_TRACE, "Executing cuPeerRouterDisable\n");
+
+    peerRouter.disable();
+    return CUDA_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPeerRouterGetRouteNative
+ * Signature: ([III)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPeerRouterGetRouteNative
+  (JNIEnv *env, jclass cls, jintArray route, jint srcDevice, jint dstDevice)
+{
+    if (route == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'route' is null for cuPeerRouterGetRoute");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuPeerRouterGetRoute\n");
+
+    int nativeRoute = 0;
+    int result = peerRouter.getRoute((int)srcDevice, (int)dstDevice, &nativeRoute);
+    if (!set(env, route, 0, nativeRoute)) return JCUDA_INTERNAL_ERROR;
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPeerRouterGetStatisticsNative
+ * Signature: ([J[J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPeerRouterGetStatisticsNative
+  (JNIEnv *env, jclass cls, jlongArray directCount, jlongArray directBytes, jlongArray stagedCount, jlongArray stagedBytes)
+{
+    if (directCount == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'directCount' is null for cuPeerRouterGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (directBytes == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'directBytes' is null for cuPeerRouterGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (stagedCount == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'stagedCount' is null for cuPeerRouterGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (stagedBytes == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'stagedBytes' is null for cuPeerRouterGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuPeerRouterGetStatistics\n");
+
+    PeerRouterStatistics statistics;
+    peerRouter.getStatistics(&statistics);
+    if (!set(env, directCount, 0, (jlong)statistics.directCount)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, directBytes, 0, (jlong)statistics.directBytes)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, stagedCount, 0, (jlong)statistics.stagedCount)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, stagedBytes, 0, (jlong)statistics.stagedBytes)) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemAllocNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemAllocNative
+  (JNIEnv *env, jclass cls, jobject dptr, jlong bytesize)
+{
+    if (dptr == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuMemAlloc");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemAlloc of %ld bytes\n", (long)bytesize);
+
+    CUdeviceptr nativeDptr;
+    int device = MemoryGovernor::isEnabled() ? getCurrentDevice() : -1;
+    MemoryGovernor::beforeAllocation(device, (size_t)bytesize);
+    int result = cuMemAlloc(&nativeDptr, (size_t)bytesize);
+    if (result == CUDA_ERROR_OUT_OF_MEMORY && MemoryGovernor::allocationFailed(device, (size_t)bytesize))
+    {
+        result = cuMemAlloc(&nativeDptr, (size_t)bytesize);
+    }
+    if (result == CUDA_SUCCESS)
+    {
+        registerAllocation((void*)nativeDptr, (size_t)bytesize, ALLOCATION_KIND_DEVICE);
+        MemoryGovernor::allocated(device, (size_t)bytesize);
+    }
+    setPointer(env, dptr, (jlong)nativeDptr);
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemAllocPitchNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;[JJJI)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemAllocPitchNative
+  (JNIEnv *env, jclass cls, jobject dptr, jlongArray pPitch, jlong WidthInBytes, jlong Height, jint ElementSizeBytes)
+{
+    if (dptr == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuMemAllocPitch");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (pPitch == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pPitch' is null for cuMemAllocPitch");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemAllocPitch\n");
+
+    CUdeviceptr nativeDptr;
+    size_t nativePPitch;
+
+    int device = MemoryGovernor::isEnabled() ? getCurrentDevice() : -1;
+    MemoryGovernor::beforeAllocation(device, (size_t)WidthInBytes * (size_t)Height);
+    int result = cuMemAllocPitch(&nativeDptr, &nativePPitch, (size_t)WidthInBytes, (size_t)Height, (unsigned int)ElementSizeBytes);
+    if (result == CUDA_ERROR_OUT_OF_MEMORY && MemoryGovernor::allocationFailed(device, (size_t)WidthInBytes * (size_t)Height))
+    {
+        result = cuMemAllocPitch(&nativeDptr, &nativePPitch, (size_t)WidthInBytes, (size_t)Height, (unsigned int)ElementSizeBytes);
+    }
+    if (result == CUDA_SUCCESS)
+    {
+        registerAllocation((void*)nativeDptr, nativePPitch * (size_t)Height, ALLOCATION_KIND_DEVICE);
+        MemoryGovernor::allocated(device, nativePPitch * (size_t)Height);
+    }
+
+    setPointer(env, dptr, (jlong)nativeDptr);
+    if (!set(env, pPitch, 0, nativePPitch)) return JCUDA_INTERNAL_ERROR;
+
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemFreeNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemFreeNative
+  (JNIEnv *env, jclass cls, jobject dptr)
+{
+    if (dptr == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuMemFree");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemFree\n");
+
+    CUdeviceptr nativeDptr = (CUdeviceptr)getPointer(env, dptr);
+    int result = cuMemFree(nativeDptr);
+    if (result == CUDA_SUCCESS)
+    {
+        AllocationInfo info;
+        if (MemoryGovernor::isEnabled() &&
+            allocationRegistry.lookup((void*)nativeDptr, &info) && info.start == (char*)nativeDptr)
+        {
+            MemoryGovernor::freed(info.device, info.size);
+        }
+        allocationRegistry.remove((void*)nativeDptr);
+    }
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemGetAddressRangeNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;[JLjcuda/driver/CUdeviceptr;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemGetAddressRangeNative
+  (JNIEnv *env, jclass cls, jobject pbase, jlongArray psize, jobject dptr)
+{
+    /* May be null
+    if (pbase == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pbase' is null for cuMemGetAddressRange");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (psize == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'psize' is null for cuMemGetAddressRange");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    */
+    if (dptr == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuMemGetAddressRange");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemGetAddressRange\n");
+
+    CUdeviceptr nativeDptr = (CUdeviceptr)getPointer(env, dptr);
+
+    size_t nativePsize;
+    CUdeviceptr nativePbase;
+    int result = cuMemGetAddressRange(&nativePbase, &nativePsize, nativeDptr);
+
+    setPointer(env, pbase, nativePbase);
+    if (!set(env, psize, 0, nativePsize)) return JCUDA_INTERNAL_ERROR;
+
+    return result;
+}
+
+
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemAllocHostNative
+ * Signature: (Ljcuda/Pointer;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemAllocHostNative
+  (JNIEnv *env, jclass cls, jobject pp, jlong bytesize)
+{
+    if (pp == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pp' is null for cuMemAllocHost");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemAllocHost of %ld bytes\n", (size_t)bytesize);
+
+    void *nativePp;
+    int result = CUDA_SUCCESS;
+    if (!numaPlacement.allocate(&nativePp, (size_t)bytesize, 0, &result))
+    {
+        result = cuMemAllocHost(&nativePp, (size_t)bytesize);
+    }
+    if (result == CUDA_SUCCESS)
+    {
+        registerAllocation(nativePp, (size_t)bytesize, ALLOCATION_KIND_HOST);
+        jobject object = env->NewDirectByteBuffer(nativePp, bytesize);
+        env->SetObjectField(pp, Pointer_buffer, object);
+        env->SetObjectField(pp, Pointer_pointers, NULL);
+        env->SetLongField(pp, Pointer_byteOffset, 0);
+        env->SetLongField(pp, NativePointerObject_nativePointer, (jlong)nativePp);
+    }
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemFreeHostNative
+ * Signature: (Ljcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemFreeHostNative
+  (JNIEnv *env, jclass cls, jobject p)
+{
+    if (p == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'p' is null for cuMemFreeHost");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemFreeHost\n");
+
+    PointerData *pPointerData = initPointerData(env, p);
+    if (pPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    void *nativeP = (void*)pPointerData->getPointer(env);
+    int result = CUDA_SUCCESS;
+    if (!numaPlacement.free(nativeP, &result))
+    {
+        result = cuMemFreeHost(nativeP);
+    }
+    if (result == CUDA_SUCCESS)
+    {
+        allocationRegistry.remove(nativeP);
+    }
+    if (!releasePointerData(env, pPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostSetPlacementNative
+ * Signature: (I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostSetPlacementNative
+  (JNIEnv *env, jclass cls, jint mode)
+{
+    Logger::log(LOG_TRACE, "Executing cuMemHostSetPlacement\n");
+
+    if (mode != HOST_PLACEMENT_DEFAULT && mode != HOST_PLACEMENT_DEVICE)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    numaPlacement.setMode((int)mode);
+    return CUDA_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostGetNumaNodeNative
+ * Signature: ([ILjcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostGetNumaNodeNative
+  (JNIEnv *env, jclass cls, jintArray node, jobject p)
+{
+    if (node == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'node' is null for cuMemHostGetNumaNode");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (p == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'p' is null for cuMemHostGetNumaNode");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemHostGetNumaNode\n");
+
+    PointerData *pPointerData = initPointerData(env, p);
+    if (pPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    int nativeNode = numaPlacement.getMemoryNode((void*)pPointerData->getPointer(env));
+    if (!releasePointerData(env, pPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, node, 0, nativeNode)) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuDeviceGetHostNumaNodeNative
+ * Signature: ([ILjcuda/driver/CUdevice;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuDeviceGetHostNumaNodeNative
+  (JNIEnv *env, jclass cls, jintArray node, jobject dev)
+{
+    if (node == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'node' is null for cuDeviceGetHostNumaNode");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (dev == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dev' is null for cuDeviceGetHostNumaNode");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuDeviceGetHostNumaNode\n");
+
+    CUdevice nativeDev = (CUdevice)(intptr_t)getNativePointerValue(env, dev);
+    int nativeNode = numaPlacement.getDeviceNode((int)nativeDev);
+    if (!set(env, node, 0, nativeNode)) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
+}
+
+
+
+/**
+ * The HostArenaAllocFunction for arenas of the driver API
+ */
+static int driverHostArenaAlloc(void **pointer, size_t size, unsigned int flags)
+{
+    int result = cuMemHostAlloc(pointer, size, flags);
+    if (result == CUDA_SUCCESS)
+    {
+        registerAllocation(*pointer, size, ALLOCATION_KIND_HOST);
+    }
+    return result;
+}
+
+/**
+ * The HostArenaFreeFunction for arenas of the driver API
+ */
+static int driverHostArenaFree(void *pointer)
+{
+    allocationRegistry.remove(pointer);
+    return cuMemFreeHost(pointer);
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostArenaCreateNative
+ * Signature: (Ljcuda/driver/CUmemHostArena;JJI)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostArenaCreateNative
+  (JNIEnv *env, jclass cls, jobject arena, jlong regionSize, jlong alignment, jint Flags)
+{
+    if (arena == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'arena' is null for cuMemHostArenaCreate");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemHostArenaCreate\n");
+
+    if (regionSize <= 0 || alignment <= 0 || (alignment & (alignment - 1)) != 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    HostArena *nativeArena = new HostArena(&driverHostArenaAlloc, &driverHostArenaFree,
+        (size_t)regionSize, (size_t)alignment, (unsigned int)Flags);
+    if (nativeArena == NULL)
+    {
+        ThrowByName(env, "java/lang/OutOfMemoryError",
+            "Out of memory while creating host arena");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    setNativePointerValue(env, arena, (jlong)nativeArena);
+    return CUDA_SUCCESS;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostArenaDestroyNative
+ * Signature: (Ljcuda/driver/CUmemHostArena;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostArenaDestroyNative
+  (JNIEnv *env, jclass cls, jobject arena)
+{
+    if (arena == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'arena' is null for cuMemHostArenaDestroy");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemHostArenaDestroy\n");
+
+    HostArena *nativeArena = (HostArena*)getNativePointerValue(env, arena);
+    if (nativeArena == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    delete nativeArena;
+    setNativePointerValue(env, arena, 0);
+    return CUDA_SUCCESS;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostArenaAllocNative
+ * Signature: (Ljcuda/driver/CUmemHostArena;Ljcuda/Pointer;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostArenaAllocNative
+  (JNIEnv *env, jclass cls, jobject arena, jobject pp, jlong bytesize)
+{
+    if (arena == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'arena' is null for cuMemHostArenaAlloc");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (pp == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pp' is null for cuMemHostArenaAlloc");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemHostArenaAlloc\n");
+
+    HostArena *nativeArena = (HostArena*)getNativePointerValue(env, arena);
+    if (nativeArena == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    if (bytesize <= 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    void *nativePp;
+    int result = nativeArena->allocate(&nativePp, (size_t)bytesize);
+    if (result == CUDA_SUCCESS)
+    {
+        jobject object = env->NewDirectByteBuffer(nativePp, bytesize);
+        if (object == NULL)
+        {
+            nativeArena->free(nativePp, (size_t)bytesize);
+            return JCUDA_INTERNAL_ERROR;
+        }
+        env->SetObjectField(pp, Pointer_buffer, object);
+        env->SetObjectField(pp, Pointer_pointers, NULL);
+        env->SetLongField(pp, Pointer_byteOffset, 0);
+        env->SetLongField(pp, NativePointerObject_nativePointer, (jlong)nativePp);
+    }
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostArenaFreeNative
+ * Signature: (Ljcuda/driver/CUmemHostArena;Ljcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostArenaFreeNative
+  (JNIEnv *env, jclass cls, jobject arena, jobject p)
+{
+    if (arena == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'arena' is null for cuMemHostArenaFree");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (p == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'p' is null for cuMemHostArenaFree");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemHostArenaFree\n");
+
+    HostArena *nativeArena = (HostArena*)getNativePointerValue(env, arena);
+    if (nativeArena == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+
+    // The size of the block is the capacity of the buffer that
+    // was created in cuMemHostArenaAlloc
+    jobject buffer = env->GetObjectField(p, Pointer_buffer);
+    if (buffer == NULL || env->GetLongField(p, Pointer_byteOffset) != 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    void *nativeP = env->GetDirectBufferAddress(buffer);
+    jlong capacity = env->GetDirectBufferCapacity(buffer);
+    if (nativeP == NULL || capacity <= 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+
+    // Pointers that refer to other memory would corrupt the free lists
+    if (!nativeArena->owns(nativeP, (size_t)capacity))
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    nativeArena->free(nativeP, (size_t)capacity);
+
+    // Clear the pointer, so that freeing it twice is detected
+    env->SetObjectField(p, Pointer_buffer, NULL);
+    env->SetLongField(p, NativePointerObject_nativePointer, 0);
+    return CUDA_SUCCESS;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostArenaGetStatisticsNative
+ * Signature: (Ljcuda/driver/CUmemHostArena;Ljcuda/driver/CUmemHostArenaStatistics;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostArenaGetStatisticsNative
+  (JNIEnv *env, jclass cls, jobject arena, jobject statistics)
+{
+    if (arena == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'arena' is null for cuMemHostArenaGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (statistics == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'statistics' is null for cuMemHostArenaGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemHostArenaGetStatistics\n");
+
+    HostArena *nativeArena = (HostArena*)getNativePointerValue(env, arena);
+    if (nativeArena == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    HostArenaStatistics nativeStatistics;
+    nativeArena->getStatistics(&nativeStatistics);
+    env->SetLongField(statistics,  CUmemHostArenaStatistics_reservedBytes,  (jlong)nativeStatistics.reservedBytes);
+    env->SetLongField(statistics,  CUmemHostArenaStatistics_usedBytes,      (jlong)nativeStatistics.usedBytes);
+    env->SetLongField(statistics,  CUmemHostArenaStatistics_requestedBytes, (jlong)nativeStatistics.requestedBytes);
+    env->SetLongField(statistics,  CUmemHostArenaStatistics_highWaterMark,  (jlong)nativeStatistics.highWaterMark);
+    env->SetLongField(statistics,  CUmemHostArenaStatistics_regionCount,    (jlong)nativeStatistics.regionCount);
+    env->SetFloatField(statistics, CUmemHostArenaStatistics_fragmentation,  (jfloat)nativeStatistics.fragmentation);
+    return CUDA_SUCCESS;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyHtoDNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/Pointer;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyHtoDNative
+  (JNIEnv *env, jclass cls, jobject dstDevice, jobject srcHost, jlong ByteCount)
+{
+    if (dstDevice == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyHtoD");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (srcHost == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcHost' is null for cuMemcpyHtoD");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpyHtoD of %d bytes\n", (size_t)ByteCount);
+
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+    RegistrationTransfer transfer(registrationCache, env, srcHost);
+    PointerData *srcHostPointerData = initPointerData(env, srcHost);
+    if (srcHostPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+    int result = cuMemcpyHtoD(nativeDstDevice, (void*)srcHostPointerData->getPointer(env), (size_t)ByteCount);
+
+    if (!releasePointerData(env, srcHostPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyDtoHNative
+ * Signature: (Ljcuda/Pointer;Ljcuda/driver/CUdeviceptr;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDtoHNative
+  (JNIEnv *env, jclass cls, jobject dstHost, jobject srcDevice, jlong ByteCount)
+{
+    if (dstHost == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstHost' is null for cuMemcpyDtoH");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (srcDevice == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcDevice' is null for cuMemcpyDtoH");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpyDtoH of %d bytes\n", (size_t)ByteCount);
+
+    RegistrationTransfer transfer(registrationCache, env, dstHost);
+    PointerData *dstHostPointerData = initPointerData(env, dstHost);
+    if (dstHostPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    CUdeviceptr nativeSrcDevice = (CUdeviceptr)getPointer(env, srcDevice);
+	void *nativeDstHost = (void*)dstHostPointerData->getPointer(env);
+
+    int result = cuMemcpyDtoH(nativeDstHost, nativeSrcDevice, (size_t)ByteCount);
+
+    if (!releasePointerData(env, dstHostPointerData, 0)) return JCUDA_INTERNAL_ERROR;
+
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyDtoDNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUdeviceptr;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDtoDNative
+  (JNIEnv *env, jclass cls, jobject dstDevice, jobject srcDevice, jlong ByteCount)
+{
+    if (dstDevice == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyDtoD");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (srcDevice == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcDevice' is null for cuMemcpyDtoD");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpyDtoD of %d bytes\n", (size_t)ByteCount);
+
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+    CUdeviceptr nativeSrcDevice = (CUdeviceptr)getPointer(env, srcDevice);
+
+    int result = cuMemcpyDtoD(nativeDstDevice, nativeSrcDevice, (size_t)ByteCount);
+
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyDtoANative
+ * Signature: (Ljcuda/driver/CUarray;JLjcuda/driver/CUdeviceptr;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDtoANative
+  (JNIEnv *env, jclass cls, jobject dstArray, jlong dstIndex, jobject srcDevice, jlong ByteCount)
+{
+    if (dstArray == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstArray' is null for cuMemcpyDtoA");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (srcDevice == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcDevice' is null for cuMemcpyDtoA");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpyDtoA of %d bytes\n", (size_t)ByteCount);
+
+    CUarray nativeDstArray = (CUarray)getNativePointerValue(env, dstArray);
+    CUdeviceptr nativeSrcDevice = (CUdeviceptr)getPointer(env, srcDevice);
+
+    int result = cuMemcpyDtoA(nativeDstArray, (size_t)dstIndex, nativeSrcDevice, (size_t)ByteCount);
+
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyAtoDNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUarray;JJ)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAtoDNative
+  (JNIEnv *env, jclass cls, jobject dstDevice, jobject hSrc, jlong SrcIndex, jlong ByteCount)
+{
+    if (dstDevice == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyAtoD");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (hSrc == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hSrc' is null for cuMemcpyAtoD");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpyAtoD of %d bytes\n", (size_t)ByteCount);
+
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+    CUarray nativeHSrc = (CUarray)getNativePointerValue(env, hSrc);
+
+    int result = cuMemcpyAtoD(nativeDstDevice, nativeHSrc, (size_t)SrcIndex, (size_t)ByteCount);
+
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyHtoANative
+ * Signature: (Ljcuda/driver/CUarray;JLjcuda/Pointer;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyHtoANative
+  (JNIEnv *env, jclass cls, jobject dstArray, jlong dstIndex, jobject pSrc, jlong ByteCount)
+{
+    if (dstArray == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstArray' is null for cuMemcpyHtoA");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (pSrc == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pSrc' is null for cuMemcpyHtoA");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpyHtoA of %d bytes\n", (size_t)ByteCount);
+
+    CUarray nativeDstArray = (CUarray)getNativePointerValue(env, dstArray);
+
+    PointerData *pSrcPointerData = initPointerData(env, pSrc);
+    if (pSrcPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+    int result = cuMemcpyHtoA(nativeDstArray, (size_t)dstIndex, (void*)pSrcPointerData->getPointer(env), (size_t)ByteCount);
+
+    if (!releasePointerData(env, pSrcPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+
+    return result;
+}
+
+
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyAtoHNative
+ * Signature: (Ljcuda/Pointer;Ljcuda/driver/CUarray;JJ)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAtoHNative
+  (JNIEnv *env, jclass cls, jobject dstHost, jobject srcArray, jlong srcIndex, jlong ByteCount)
+{
+    if (dstHost == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstHost' is null for cuMemcpyAtoH");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (srcArray == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcArray' is null for cuMemcpyAtoH");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpyAtoH of %d bytes\n", (size_t)ByteCount);
+
+    PointerData *dstHostPointerData = initPointerData(env, dstHost);
+    if (dstHostPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    CUarray nativeSrcArray = (CUarray)getNativePointerValue(env, srcArray);
+
+    int result = cuMemcpyAtoH((void*)dstHostPointerData->getPointer(env), nativeSrcArray, (size_t)srcIndex, (size_t)ByteCount);
+
+    if (!releasePointerData(env, dstHostPointerData)) return JCUDA_INTERNAL_ERROR;
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyAtoANative
+ * Signature: (Ljcuda/driver/CUarray;JLjcuda/driver/CUarray;JJ)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAtoANative
+  (JNIEnv *env, jclass cls, jobject dstArray, jlong dstIndex, jobject srcArray, jlong srcIndex, jlong ByteCount)
+{
+    if (dstArray == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstArray' is null for cuMemcpyAtoA");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (srcArray == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcArray' is null for cuMemcpyAtoA");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpyAtoA of %d bytes\n", (size_t)ByteCount);
+
+    CUarray nativeDstArray = (CUarray)getNativePointerValue(env, dstArray);
+    CUarray nativeSrcArray = (CUarray)getNativePointerValue(env, srcArray);
+
+    int result = cuMemcpyAtoA(nativeDstArray, (size_t)dstIndex, nativeSrcArray, (size_t)srcIndex, (size_t)ByteCount);
+    return result;
+}
+
+
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpy2DNative
+ * Signature: (Ljcuda/driver/CUDA_MEMCPY2D;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy2DNative
+  (JNIEnv *env, jclass cls, jobject pCopy)
+{
+    if (pCopy == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy2D");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpy2D\n");
+
+    Memcpy2DData *memcpyData = initMemcpy2DData(env, pCopy);
+    if (memcpyData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+    int result = CUDA_SUCCESS;
+    if (!executePackedCopy2D(env, memcpyData, false, &result))
+    {
+        result = cuMemcpy2D(&memcpyData->memcpy2d);
+    }
+
+    if (!releaseMemcpy2DData(env, memcpyData)) return JCUDA_INTERNAL_ERROR;
+
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpy2DUnalignedNative
+ * Signature: (Ljcuda/driver/CUDA_MEMCPY2D;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy2DUnalignedNative
+  (JNIEnv *env, jclass cls, jobject pCopy)
+{
+    if (pCopy == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy2DUnaligned");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpy2DUnaligned\n");
+
+    Memcpy2DData *memcpyData = initMemcpy2DData(env, pCopy);
+    if (memcpyData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+    int result = CUDA_SUCCESS;
+    if (!executePackedCopy2D(env, memcpyData, true, &result))
+    {
+        result = cuMemcpy2DUnaligned(&memcpyData->memcpy2d);
+    }
+
+    if (!releaseMemcpy2DData(env, memcpyData)) return JCUDA_INTERNAL_ERROR;
+
+    return result;
+}
+
+
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpy3DNative
+ * Signature: (Ljcuda/driver/CUDA_MEMCPY3D;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DNative
+  (JNIEnv *env, jclass cls, jobject pCopy)
+{
+    if (pCopy == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy3D");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpy3D\n");
+
+    Memcpy3DData *memcpyData = initMemcpy3DData(env, pCopy);
+    if (memcpyData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+    /*
+    Logger::log(LOG_DEBUGTRACE, "Source X in bytes %d\n", memcpyData.memcpy3d.srcXInBytes);
+    Logger::log(LOG_DEBUGTRACE, "Source Y %d\n", memcpyData.memcpy3d.srcY);
+    Logger::log(LOG_DEBUGTRACE, "Source Z %d\n", memcpyData.memcpy3d.srcZ);
+    Logger::log(LOG_DEBUGTRACE, "Source LOD %d\n", memcpyData.memcpy3d.srcLOD);
+    Logger::log(LOG_DEBUGTRACE, "Source memory type %d\n", memcpyData.memcpy3d.srcMemoryType);
+    Logger::log(LOG_DEBUGTRACE, "Source host pointer %p\n", memcpyData.memcpy3d.srcHost);
+    Logger::log(LOG_DEBUGTRACE, "Source device pointer %p\n", memcpyData.memcpy3d.srcDevice);
+    Logger::log(LOG_DEBUGTRACE, "Source array reference %p\n", memcpyData.memcpy3d.srcArray);
+    Logger::log(LOG_DEBUGTRACE, "Source pitch %d\n", memcpyData.memcpy3d.srcPitch);
+    Logger::log(LOG_DEBUGTRACE, "Source height %d\n", memcpyData.memcpy3d.srcHeight);
+    Logger::log(LOG_DEBUGTRACE, "Destination X in bytes %d\n", memcpyData.memcpy3d.dstXInBytes);
+    Logger::log(LOG_DEBUGTRACE, "Destination Y %d\n", memcpyData.memcpy3d.dstY);
+    Logger::log(LOG_DEBUGTRACE, "Destination Z %d\n", memcpyData.memcpy3d.dstZ);
+    Logger::log(LOG_DEBUGTRACE, "Destination LOD %d\n", memcpyData.memcpy3d.dstLOD);
+    Logger::log(LOG_DEBUGTRACE, "Destination memory type %d\n", memcpyData.memcpy3d.dstMemoryType);
+    Logger::log(LOG_DEBUGTRACE, "Destination host pointer %p\n", memcpyData.memcpy3d.dstHost);
+    Logger::log(LOG_DEBUGTRACE, "Destination device pointer %p\n", memcpyData.memcpy3d.dstDevice);
+    Logger::log(LOG_DEBUGTRACE, "Destination array reference %p\n", memcpyData.memcpy3d.dstArray);
+    Logger::log(LOG_DEBUGTRACE, "Destination pitch  %d\n", memcpyData.memcpy3d.dstPitch);
+    Logger::log(LOG_DEBUGTRACE, "Destination height %d\n", memcpyData.memcpy3d.dstHeight);
+    Logger::log(LOG_DEBUGTRACE, "Width of 3D memory copy in bytes %d\n", memcpyData.memcpy3d.WidthInBytes);
+    Logger::log(LOG_DEBUGTRACE, "Height of 3D memory copy %d\n", memcpyData.memcpy3d.Height);
+    Logger::log(LOG_DEBUGTRACE, "Depth of 3D memory copy %d\n", memcpyData.memcpy3d.Depth);
+    */
+
+    int result = CUDA_SUCCESS;
+    if (!executePackedCopy3D(env, memcpyData, &result))
+    {
+        result = cuMemcpy3D(&memcpyData->memcpy3d);
+    }
+
+    if (!releaseMemcpy3DData(env, memcpyData)) return JCUDA_INTERNAL_ERROR;
+
+    return result;
+}
+
 
-
-
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuCtxCreateNative
- * Signature: (Ljcuda/driver/CUcontext;ILjcuda/driver/CUdevice;)I
+ * Method:    cuMemcpy3DPeerNative
+ * Signature: (Ljcuda/driver/CUDA_MEMCPY3D_PEER;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxCreateNative
-  (JNIEnv *env, jclass cls, jobject pctx, jint flags, jobject dev)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DPeerNative
+  (JNIEnv *env, jclass cls, jobject pCopy)
 {
-    if (pctx == NULL)
+    if (pCopy == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pctx' is null for cuCtxCreate");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy3DPeer");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (dev == NULL)
+    Logger::log(LOG_TRACE, "Executing cuMemcpy3DPeer\n");
+
+    Memcpy3DPeerData *memcpyData = initMemcpy3DPeerData(env, pCopy);
+    if (memcpyData == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dev' is null for cuCtxCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuCtxCreate\n");
 
-    CUdevice nativeDev = (CUdevice)(intptr_t)getNativePointerValue(env, dev);
-    CUcontext nativePctx;
-    int result = cuCtxCreate(&nativePctx, (int)flags, nativeDev);
-    setNativePointerValue(env, pctx, (jlong)nativePctx);
+    int result = cuMemcpy3DPeer(&memcpyData->memcpy3d);
+
+    if (!releaseMemcpy3DPeerData(env, memcpyData)) return JCUDA_INTERNAL_ERROR;
 
     return result;
 }
 
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpy3DPeerAsyncNative
+ * Signature: (Ljcuda/driver/CUDA_MEMCPY3D_PEER;Ljcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DPeerAsyncNative
+  (JNIEnv *env, jclass cls, jobject pCopy, jobject hStream)
+{
+    if (pCopy == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy3DPeerAsync");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpy3DPeerAsync\n");
+
+    Memcpy3DPeerData *memcpyData = initMemcpy3DPeerData(env, pCopy);
+    if (memcpyData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+
+    int result = cuMemcpy3DPeerAsync(&memcpyData->memcpy3d, nativeHStream);
+
+    if (!releaseMemcpy3DPeerData(env, memcpyData)) return JCUDA_INTERNAL_ERROR;
+
+    return result;
+}
+
 
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuCtxDestroyNative
- * Signature: (Ljcuda/driver/CUcontext;)I
+ * Method:    cuMemcpyHtoDAsyncNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/Pointer;JLjcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxDestroyNative
-  (JNIEnv *env, jclass cls, jobject ctx)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyHtoDAsyncNative
+  (JNIEnv *env, jclass cls, jobject dstDevice, jobject srcHost, jlong ByteCount, jobject hStream)
 {
-    if (ctx == NULL)
+    if (dstDevice == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ctx' is null for cuCtxDestroy");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyHtoDAsync");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuCtxDestroy\n");
+    if (srcHost == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcHost' is null for cuMemcpyHtoDAsync");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpyHtoDAsync of %d bytes\n", (size_t)ByteCount);
 
-    CUcontext nativeCtx = (CUcontext)getNativePointerValue(env, ctx);
-    int result = cuCtxDestroy(nativeCtx);
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+
+    OperationGraph *graph = OperationGraph::getCapturing();
+    if (graph != NULL)
+    {
+        CUdeviceptr nativeSrcHost = 0;
+        if (!getCapturedHostAddress(env, srcHost, &nativeSrcHost)) return JCUDA_INTERNAL_ERROR;
+        if (nativeSrcHost == 0) return CUDA_ERROR_INVALID_VALUE;
+        graph->addMemcpy(OPERATION_MEMCPY_HTOD, nativeDstDevice, nativeSrcHost, (size_t)ByteCount, nativeHStream);
+        return CUDA_SUCCESS;
+    }
+
+    RegistrationTransfer transfer(registrationCache, env, srcHost);
+    int result = JCUDA_INTERNAL_ERROR;
+    if (executeBouncedCopy(env, srcHost, nativeDstDevice, (size_t)ByteCount, true, nativeHStream, &result))
+    {
+        return result;
+    }
+    PointerData *srcHostPointerData = initPointerData(env, srcHost);
+    if (srcHostPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+    result = cuMemcpyHtoDAsync(nativeDstDevice, (void*)srcHostPointerData->getPointer(env), (size_t)ByteCount, nativeHStream);
+    transfer.issued(nativeHStream);
+
+    if (!releasePointerData(env, srcHostPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
     return result;
 }
 
@@ -1521,365 +7121,571 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxDestroyNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuCtxAttachNative
- * Signature: (Ljcuda/driver/CUcontext;I)I
+ * Method:    cuMemcpyDtoHAsyncNative
+ * Signature: (Ljcuda/Pointer;Ljcuda/driver/CUdeviceptr;JLjcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxAttachNative
-  (JNIEnv *env, jclass cls, jobject pctx, jint flags)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDtoHAsyncNative
+  (JNIEnv *env, jclass cls, jobject dstHost, jobject srcDevice, jlong ByteCount, jobject hStream)
 {
-    if (pctx == NULL)
+    if (dstHost == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pctx' is null for cuCtxAttach");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstHost' is null for cuMemcpyDtoHAsync");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuCtxAttach\n");
+    if (srcDevice == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcDevice' is null for cuMemcpyDtoHAsync");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    /* May be null
+    if (hStream == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuMemcpyDtoHAsync");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    */
+    Logger::log(LOG_TRACE, "Executing cuMemcpyDtoHAsync of %d bytes\n", (size_t)ByteCount);
+
+    OperationGraph *graph = OperationGraph::getCapturing();
+    if (graph != NULL)
+    {
+        CUdeviceptr nativeDstHost = 0;
+        if (!getCapturedHostAddress(env, dstHost, &nativeDstHost)) return JCUDA_INTERNAL_ERROR;
+        if (nativeDstHost == 0) return CUDA_ERROR_INVALID_VALUE;
+        graph->addMemcpy(OPERATION_MEMCPY_DTOH, nativeDstHost, (CUdeviceptr)getPointer(env, srcDevice),
+            (size_t)ByteCount, (CUstream)getNativePointerValue(env, hStream));
+        return CUDA_SUCCESS;
+    }
+
+    RegistrationTransfer transfer(registrationCache, env, dstHost);
+    CUdeviceptr nativeSrcDevice = (CUdeviceptr)getPointer(env, srcDevice);
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    int result = JCUDA_INTERNAL_ERROR;
+    if (executeBouncedCopy(env, dstHost, nativeSrcDevice, (size_t)ByteCount, false, nativeHStream, &result))
+    {
+        return result;
+    }
+    PointerData *dstHostPointerData = initPointerData(env, dstHost);
+    if (dstHostPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+    result = cuMemcpyDtoHAsync((void*)dstHostPointerData->getPointer(env), nativeSrcDevice, (size_t)ByteCount, nativeHStream);
+    transfer.issued(nativeHStream);
+
+    if (!releasePointerData(env, dstHostPointerData)) return JCUDA_INTERNAL_ERROR;
 
-    CUcontext nativePctx = (CUcontext)getNativePointerValue(env, pctx);
-    int result = cuCtxAttach(&nativePctx, (unsigned int)flags);
-    setNativePointerValue(env, pctx, (jlong)nativePctx);
     return result;
 }
 
 
 
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuCtxDetachNative
- * Signature: (Ljcuda/driver/CUcontext;)I
+ * Method:    cuTransferEngineCreateNative
+ * Signature: (Ljcuda/driver/CUtransferEngine;JI)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxDetachNative
-  (JNIEnv *env, jclass cls, jobject ctx)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferEngineCreateNative
+  (JNIEnv *env, jclass cls, jobject engine, jlong chunkSize, jint streamCount)
 {
-    if (ctx == NULL)
+    if (engine == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ctx' is null for cuCtxDetach");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'engine' is null for cuTransferEngineCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuCtxDetach\n");
+    Logger::log(LOG_TRACE, "Executing cuTransferEngineCreate\n");
 
-    CUcontext nativeCtx = (CUcontext)getNativePointerValue(env, ctx);
-    int result = cuCtxDetach(nativeCtx);
+    if (chunkSize <= 0 || streamCount <= 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    TransferEngine *nativeEngine = new TransferEngine((size_t)chunkSize, (int)streamCount);
+    int result = nativeEngine->init();
+    if (result != CUDA_SUCCESS)
+    {
+        delete nativeEngine;
+        return result;
+    }
+    setNativePointerValue(env, engine, (jlong)nativeEngine);
     return result;
 }
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTransferEngineDestroyNative
+ * Signature: (Ljcuda/driver/CUtransferEngine;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferEngineDestroyNative
+  (JNIEnv *env, jclass cls, jobject engine)
+{
+    if (engine == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'engine' is null for cuTransferEngineDestroy");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTransferEngineDestroy\n");
 
+    TransferEngine *nativeEngine = (TransferEngine*)getNativePointerValue(env, engine);
+    if (nativeEngine == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    delete nativeEngine;
+    setNativePointerValue(env, engine, 0);
+    return CUDA_SUCCESS;
+}
 
+/**
+ * Writes the given TransferStatistics into the given CUtransferStatistics
+ */
+void setCUtransferStatistics(JNIEnv *env, jobject statistics, TransferStatistics &nativeStatistics)
+{
+    env->SetLongField(statistics,   CUtransferStatistics_transferCount, (jlong)nativeStatistics.transferCount);
+    env->SetLongField(statistics,   CUtransferStatistics_bytes,         (jlong)nativeStatistics.bytes);
+    env->SetDoubleField(statistics, CUtransferStatistics_elapsedTime,   (jdouble)nativeStatistics.elapsedTime);
+    env->SetDoubleField(statistics, CUtransferStatistics_bandwidth,     (jdouble)nativeStatistics.bandwidth);
+}
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuCtxPushCurrentNative
- * Signature: (Ljcuda/driver/CUcontext;)I
+ * Method:    cuTransferEngineGetStatisticsNative
+ * Signature: (Ljcuda/driver/CUtransferEngine;Ljcuda/driver/CUtransferStatistics;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxPushCurrentNative
-  (JNIEnv *env, jclass cls, jobject ctx)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferEngineGetStatisticsNative
+  (JNIEnv *env, jclass cls, jobject engine, jobject statistics)
 {
-    if (ctx == NULL)
+    if (engine == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'engine' is null for cuTransferEngineGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (statistics == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'statistics' is null for cuTransferEngineGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTransferEngineGetStatistics\n");
+
+    TransferEngine *nativeEngine = (TransferEngine*)getNativePointerValue(env, engine);
+    if (nativeEngine == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    TransferStatistics nativeStatistics;
+    nativeEngine->getStatistics(&nativeStatistics);
+    setCUtransferStatistics(env, statistics, nativeStatistics);
+    return CUDA_SUCCESS;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTransferHtoDNative
+ * Signature: (Ljcuda/driver/CUtransferEngine;Ljcuda/driver/CUtransfer;Ljcuda/driver/CUdeviceptr;Ljcuda/Pointer;JLjcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferHtoDNative
+  (JNIEnv *env, jclass cls, jobject engine, jobject transfer, jobject dstDevice, jobject srcHost, jlong ByteCount, jobject hStream)
+{
+    if (engine == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'engine' is null for cuTransferHtoD");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (transfer == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'transfer' is null for cuTransferHtoD");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (dstDevice == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuTransferHtoD");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (srcHost == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcHost' is null for cuTransferHtoD");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTransferHtoD of %ld bytes\n", (long)ByteCount);
+
+    TransferEngine *nativeEngine = (TransferEngine*)getNativePointerValue(env, engine);
+    if (nativeEngine == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    if (ByteCount < 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+    PointerData *srcHostPointerData = initPointerData(env, srcHost);
+    if (srcHostPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+
+    // The host memory is only accessed by the engine while each
+    // chunk is copied, so an array is not pinned for the transfer
+    Transfer *nativeTransfer = NULL;
+    CUresult result = CUDA_SUCCESS;
+    bool accessible = nativeEngine->copyHtoD(env, nativeDstDevice, srcHostPointerData,
+        (size_t)ByteCount, nativeHStream, &nativeTransfer, &result);
+
+    if (!releasePointerData(env, srcHostPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    if (!accessible) return JCUDA_INTERNAL_ERROR;
+    if (result == CUDA_SUCCESS)
+    {
+        setNativePointerValue(env, transfer, (jlong)nativeTransfer);
+    }
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTransferDtoHNative
+ * Signature: (Ljcuda/driver/CUtransferEngine;Ljcuda/driver/CUtransfer;Ljcuda/Pointer;Ljcuda/driver/CUdeviceptr;JLjcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferDtoHNative
+  (JNIEnv *env, jclass cls, jobject engine, jobject transfer, jobject dstHost, jobject srcDevice, jlong ByteCount, jobject hStream)
+{
+    if (engine == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'engine' is null for cuTransferDtoH");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (transfer == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'transfer' is null for cuTransferDtoH");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (dstHost == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstHost' is null for cuTransferDtoH");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (srcDevice == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcDevice' is null for cuTransferDtoH");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTransferDtoH of %ld bytes\n", (long)ByteCount);
+
+    TransferEngine *nativeEngine = (TransferEngine*)getNativePointerValue(env, engine);
+    if (nativeEngine == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    if (ByteCount < 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    CUdeviceptr nativeSrcDevice = (CUdeviceptr)getPointer(env, srcDevice);
+    PointerData *dstHostPointerData = initPointerData(env, dstHost);
+    if (dstHostPointerData == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ctx' is null for cuCtxPushCurrent");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuCtxPushCurrent\n");
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
 
-    CUcontext nativeCtx = (CUcontext)getNativePointerValue(env, ctx);
-    int result = cuCtxPushCurrent(nativeCtx);
+    // The host memory is only accessed by the engine while each
+    // chunk is copied, so an array is not pinned for the transfer
+    Transfer *nativeTransfer = NULL;
+    CUresult result = CUDA_SUCCESS;
+    bool accessible = nativeEngine->copyDtoH(env, dstHostPointerData, nativeSrcDevice,
+        (size_t)ByteCount, nativeHStream, &nativeTransfer, &result);
+
+    if (!releasePointerData(env, dstHostPointerData)) return JCUDA_INTERNAL_ERROR;
+    if (!accessible) return JCUDA_INTERNAL_ERROR;
+    if (result == CUDA_SUCCESS)
+    {
+        setNativePointerValue(env, transfer, (jlong)nativeTransfer);
+    }
     return result;
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuCtxPopCurrentNative
- * Signature: (Ljcuda/driver/CUcontext;)I
+ * Method:    cuTransferGetChunkCountNative
+ * Signature: (Ljcuda/driver/CUtransfer;[I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxPopCurrentNative
-  (JNIEnv *env, jclass cls, jobject pctx)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferGetChunkCountNative
+  (JNIEnv *env, jclass cls, jobject transfer, jintArray count)
 {
-    if (pctx == NULL)
+    if (transfer == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pctx' is null for cuCtxPopCurrent");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'transfer' is null for cuTransferGetChunkCount");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuCtxPopCurrent\n");
+    if (count == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'count' is null for cuTransferGetChunkCount");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTransferGetChunkCount\n");
 
-    CUcontext nativePctx = (CUcontext)getNativePointerValue(env, pctx);
-    int result = cuCtxPopCurrent(&nativePctx);
-    setNativePointerValue(env, pctx, (jlong)nativePctx);
-    return result;
+    Transfer *nativeTransfer = (Transfer*)getNativePointerValue(env, transfer);
+    if (nativeTransfer == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    if (!set(env, count, 0, nativeTransfer->getChunkCount())) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
 }
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuCtxSetCurrentNative
- * Signature: (Ljcuda/driver/CUcontext;)I
+ * Method:    cuTransferGetChunkEventNative
+ * Signature: (Ljcuda/driver/CUtransfer;ILjcuda/driver/CUevent;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxSetCurrentNative
-  (JNIEnv *env, jclass cls, jobject ctx)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferGetChunkEventNative
+  (JNIEnv *env, jclass cls, jobject transfer, jint chunk, jobject event)
 {
-    if (ctx == NULL)
+    if (transfer == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ctx' is null for cuCtxSetCurrent");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'transfer' is null for cuTransferGetChunkEvent");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuCtxSetCurrent\n");
+    if (event == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'event' is null for cuTransferGetChunkEvent");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTransferGetChunkEvent\n");
 
-    CUcontext nativeCtx = (CUcontext)getNativePointerValue(env, ctx);
-    int result = cuCtxSetCurrent(nativeCtx);
-    return result;
+    Transfer *nativeTransfer = (Transfer*)getNativePointerValue(env, transfer);
+    if (nativeTransfer == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    CUevent nativeEvent = nativeTransfer->getChunkEvent((int)chunk);
+    if (nativeEvent == NULL)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    setNativePointerValue(env, event, (jlong)nativeEvent);
+    return CUDA_SUCCESS;
 }
 
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuCtxGetCurrentNative
- * Signature: (Ljcuda/driver/CUcontext;)I
+ * Method:    cuTransferStreamWaitNative
+ * Signature: (Ljcuda/driver/CUtransfer;Ljcuda/driver/CUstream;JJ)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxGetCurrentNative
-  (JNIEnv *env, jclass cls, jobject pctx)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferStreamWaitNative
+  (JNIEnv *env, jclass cls, jobject transfer, jobject hStream, jlong byteOffset, jlong ByteCount)
 {
-    if (pctx == NULL)
+    if (transfer == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pctx' is null for cuCtxGetCurrent");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'transfer' is null for cuTransferStreamWait");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuCtxGetCurrent\n");
+    Logger::log(LOG_TRACE, "Executing cuTransferStreamWait\n");
 
-    CUcontext nativePctx;
-    int result = cuCtxGetCurrent(&nativePctx);
-    setNativePointerValue(env, pctx, (jlong)nativePctx);
-    return result;
+    Transfer *nativeTransfer = (Transfer*)getNativePointerValue(env, transfer);
+    if (nativeTransfer == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    if (byteOffset < 0 || ByteCount < 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    return nativeTransfer->streamWait(nativeHStream, (size_t)byteOffset, (size_t)ByteCount);
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuCtxGetDeviceNative
- * Signature: (Ljcuda/driver/CUdevice;)I
+ * Method:    cuTransferQueryNative
+ * Signature: (Ljcuda/driver/CUtransfer;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxGetDeviceNative
-  (JNIEnv *env, jclass cls, jobject device)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferQueryNative
+  (JNIEnv *env, jclass cls, jobject transfer)
 {
-    if (device == NULL)
+    if (transfer == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'device' is null for cuCtxGetDevice");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'transfer' is null for cuTransferQuery");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuCtxGetDevice\n");
+    Logger::log(LOG_TRACE, "Executing cuTransferQuery\n");
 
-    CUdevice nativeDevice = (CUdevice)(intptr_t)getNativePointerValue(env, device);
-    int result = cuCtxGetDevice(&nativeDevice);
-    setNativePointerValue(env, device, (jlong)nativeDevice);
-    return result;
+    Transfer *nativeTransfer = (Transfer*)getNativePointerValue(env, transfer);
+    if (nativeTransfer == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    return nativeTransfer->query();
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuCtxSynchronizeNative
- * Signature: ()I
+ * Method:    cuTransferSynchronizeNative
+ * Signature: (Ljcuda/driver/CUtransfer;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxSynchronizeNative
-  (JNIEnv *env, jclass cls)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferSynchronizeNative
+  (JNIEnv *env, jclass cls, jobject transfer)
 {
-    Logger::log(LOG_TRACE, "Executing cuCtxSynchronize\n");
+    if (transfer == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'transfer' is null for cuTransferSynchronize");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTransferSynchronize\n");
 
-    return cuCtxSynchronize();
+    Transfer *nativeTransfer = (Transfer*)getNativePointerValue(env, transfer);
+    if (nativeTransfer == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    return nativeTransfer->synchronize();
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuModuleLoadNative
- * Signature: (Ljcuda/driver/CUmodule;Ljava/lang/String;)I
+ * Method:    cuTransferGetStatisticsNative
+ * Signature: (Ljcuda/driver/CUtransfer;Ljcuda/driver/CUtransferStatistics;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoadNative
-  (JNIEnv *env, jclass cls, jobject module, jstring fname)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferGetStatisticsNative
+  (JNIEnv *env, jclass cls, jobject transfer, jobject statistics)
 {
-    if (module == NULL)
+    if (transfer == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'module' is null for cuModuleLoad");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'transfer' is null for cuTransferGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (fname == NULL)
+    if (statistics == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'fname' is null for cuModuleLoad");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'statistics' is null for cuTransferGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuModuleLoad\n");
+    Logger::log(LOG_TRACE, "Executing cuTransferGetStatistics\n");
 
-    CUmodule nativeModule;
-    char *nativeFname = convertString(env, fname);
-    if (nativeFname == NULL)
+    Transfer *nativeTransfer = (Transfer*)getNativePointerValue(env, transfer);
+    if (nativeTransfer == NULL)
     {
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    TransferStatistics nativeStatistics;
+    int result = nativeTransfer->getStatistics(&nativeStatistics);
+    if (result == CUDA_SUCCESS)
+    {
+        setCUtransferStatistics(env, statistics, nativeStatistics);
     }
-    int result = cuModuleLoad(&nativeModule, nativeFname);
-    setNativePointerValue(env, module, (jlong)nativeModule);
-    delete[] nativeFname;
     return result;
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuModuleLoadDataNative
- * Signature: (Ljcuda/driver/CUmodule;[B)I
+ * Method:    cuTransferDestroyNative
+ * Signature: (Ljcuda/driver/CUtransfer;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoadDataNative
-  (JNIEnv *env, jclass cls, jobject module, jbyteArray image)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferDestroyNative
+  (JNIEnv *env, jclass cls, jobject transfer)
 {
-    if (module == NULL)
+    if (transfer == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'module' is null for cuModuleLoadData");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'transfer' is null for cuTransferDestroy");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (image == NULL)
+    Logger::log(LOG_TRACE, "Executing cuTransferDestroy\n");
+
+    Transfer *nativeTransfer = (Transfer*)getNativePointerValue(env, transfer);
+    if (nativeTransfer == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'image' is null for cuModuleLoadData");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_HANDLE;
     }
-    Logger::log(LOG_TRACE, "Executing cuModuleLoadData\n");
-
-    CUmodule nativeModule = (CUmodule)getNativePointerValue(env, module);
-    void *nativeImage = env->GetPrimitiveArrayCritical(image, NULL);
-    int result = cuModuleLoadData(&nativeModule, nativeImage);
-    env->ReleasePrimitiveArrayCritical(image, nativeImage, JNI_ABORT);
-    setNativePointerValue(env, module, (jlong)nativeModule);
-    return result;
+    nativeTransfer->getEngine()->releaseTransfer(nativeTransfer);
+    setNativePointerValue(env, transfer, 0);
+    return CUDA_SUCCESS;
 }
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuModuleLoadDataExNative
- * Signature: (Ljcuda/driver/CUmodule;Ljcuda/Pointer;I[ILjcuda/Pointer;)I
+ * Method:    cuMemcpyDtoDAsyncNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUdeviceptr;JLjcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoadDataExNative
-  (JNIEnv *env, jclass cls, jobject phMod, jobject p, jint numOptions, jintArray options, jobject optionValues)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDtoDAsyncNative
+  (JNIEnv *env, jclass cls, jobject dstDevice, jobject srcDevice, jlong ByteCount, jobject hStream)
 {
-    if (phMod == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phMod' is null for cuModuleLoadDataEx");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (p == NULL)
+    if (dstDevice == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'p' is null for cuModuleLoadDataEx");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyDtoDAsync");
         return JCUDA_INTERNAL_ERROR;
     }
-    // Although it should be possible to pass 'null' for these parameters
-    // when numOptions==0, the driver crashes when they are 'null', so
-    // this case is checked here as well.
-    if (options == NULL)
+    if (srcDevice == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'options' is null for cuModuleLoadDataEx");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcDevice' is null for cuMemcpyDtoDAsync");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (optionValues == NULL)
+    /* May be null
+    if (hStream == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'optionValues' is null for cuModuleLoadDataEx");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuMemcpyDtoDAsync");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuModuleLoadDataEx\n");
-
-
-    CUjit_option *nativeOptions = NULL;
-    //if (options != NULL) // See notes above
-    {
-        jint *optionsElements = env->GetIntArrayElements(options, NULL);
-        if (optionsElements == NULL)
-        {
-            return JCUDA_INTERNAL_ERROR;
-        }
-
-        nativeOptions = new CUjit_option[numOptions];
-        for (int i=0; i<numOptions; i++)
-        {
-            nativeOptions[i] = (CUjit_option)optionsElements[i];
-        }
-        env->ReleaseIntArrayElements(options, optionsElements, JNI_ABORT);
-    }
+    */
+    Logger::log(LOG_TRACE, "Executing cuMemcpyDtoDAsync of %d bytes\n", (size_t)ByteCount);
 
-    CUmodule nativeModule;
-    PointerData *pPointerData = initPointerData(env, p);
-    if (pPointerData == NULL)
-    {
-        return JCUDA_INTERNAL_ERROR;
-    }
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+    CUdeviceptr nativeSrcDevice = (CUdeviceptr)getPointer(env, srcDevice);
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
 
-    PointerData *optionValuesPointerData = NULL;
-    void **optionValuesPointer = NULL;
-    //if (optionValues != NULL) // See notes above
+    OperationGraph *graph = OperationGraph::getCapturing();
+    if (graph != NULL)
     {
-        optionValuesPointerData = initPointerData(env, optionValues);
-        if (optionValuesPointerData == NULL)
-        {
-            return JCUDA_INTERNAL_ERROR;
-        }
-        optionValuesPointer = (void**)optionValuesPointerData->getPointer(env);
+        graph->addMemcpy(OPERATION_MEMCPY_DTOD, nativeDstDevice, nativeSrcDevice, (size_t)ByteCount, nativeHStream);
+        return CUDA_SUCCESS;
     }
 
-    int result = cuModuleLoadDataEx(&nativeModule, (void*)pPointerData->getPointer(env), (unsigned int)numOptions, nativeOptions, optionValuesPointer);
-
-    delete[] nativeOptions;
+    int result = cuMemcpyDtoDAsync(nativeDstDevice, nativeSrcDevice, (size_t)ByteCount, nativeHStream);
 
-    setNativePointerValue(env, phMod, (jlong)nativeModule);
-    if (!releasePointerData(env, pPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
-    if (!releasePointerData(env, optionValuesPointerData, 0)) return JCUDA_INTERNAL_ERROR;
     return result;
 }
 
 
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuModuleLoadDataJITNative
- * Signature: (Ljcuda/driver/CUmodule;Ljcuda/Pointer;Ljcuda/driver/JITOptions;)I
+ * Method:    cuMemcpyHtoAAsyncNative
+ * Signature: (Ljcuda/driver/CUarray;JLjcuda/Pointer;JLjcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoadDataJITNative
-  (JNIEnv *env, jclass cls, jobject phMod, jobject p, jobject jitOptions)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyHtoAAsyncNative
+  (JNIEnv *env, jclass cls, jobject dstArray, jlong dstIndex, jobject pSrc, jlong ByteCount, jobject hStream)
 {
-    if (phMod == NULL)
+    if (dstArray == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phMod' is null for cuModuleLoadDataJIT");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstArray' is null for cuMemcpyHtoAAsync");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (p == NULL)
+    if (pSrc == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'p' is null for cuModuleLoadDataJIT");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pSrc' is null for cuMemcpyHtoAAsync");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuModuleLoadDataJIT\n");
-
-    CUmodule nativeModule;
-    PointerData *pPointerData = initPointerData(env, p);
-    if (pPointerData == NULL)
+    /* May be null
+    if (hStream == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuMemcpyHtoAAsync");
         return JCUDA_INTERNAL_ERROR;
     }
+    */
+    Logger::log(LOG_TRACE, "Executing cuMemcpyHtoAAsync of %d bytes\n", (size_t)ByteCount);
 
-	JITOptionsData *jitOptionsData = initJITOptionsData(env, jitOptions);
-	if (jitOptionsData == NULL)
-	{
+    CUarray nativeDstArray = (CUarray)getNativePointerValue(env, dstArray);
+
+    PointerData *pSrcPointerData = initPointerData(env, pSrc);
+    if (pSrcPointerData == NULL)
+    {
         return JCUDA_INTERNAL_ERROR;
-	}
-    int result = cuModuleLoadDataEx(&nativeModule, (void*)pPointerData->getPointer(env), (unsigned int)jitOptionsData->numOptions, jitOptionsData->options, jitOptionsData->optionValues);
+    }
+
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
 
-	if (!releaseJITOptionsData(env, jitOptionsData, jitOptions)) return JCUDA_INTERNAL_ERROR;
-    setNativePointerValue(env, phMod, (jlong)nativeModule);
-    if (!releasePointerData(env, pPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
-    return result;
+    int result = cuMemcpyHtoAAsync(nativeDstArray, (size_t)dstIndex, (void*)pSrcPointerData->getPointer(env), (size_t)ByteCount, nativeHStream);
 
+    if (!releasePointerData(env, pSrcPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    return result;
 }
 
 
@@ -1887,51 +7693,44 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoadDataJITNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuModuleLoadFatBinaryNative
- * Signature: (Ljcuda/driver/CUmodule;[B)I
+ * Method:    cuMemcpyAtoHAsyncNative
+ * Signature: (Ljcuda/Pointer;Ljcuda/driver/CUarray;JJLjcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoadFatBinaryNative
-  (JNIEnv *env, jclass cls, jobject module, jbyteArray fatCubin)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAtoHAsyncNative
+  (JNIEnv *env, jclass cls, jobject dstHost, jobject srcArray, jlong srcIndex, jlong ByteCount, jobject hStream)
 {
-    if (module == NULL)
+    if (dstHost == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'module' is null for cuModuleLoadFatBinary");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstHost' is null for cuMemcpyAtoHAsync");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (fatCubin == NULL)
+    if (srcArray == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'fatCubin' is null for cuModuleLoadFatBinary");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcArray' is null for cuMemcpyAtoHAsync");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuModuleLoadFatBinary\n");
-
-    CUmodule nativeModule = (CUmodule)getNativePointerValue(env, module);
-    void *nativeFatCubin = env->GetPrimitiveArrayCritical(fatCubin, NULL);
-    int result = cuModuleLoadFatBinary(&nativeModule, nativeFatCubin);
-    env->ReleasePrimitiveArrayCritical(fatCubin, nativeFatCubin, JNI_ABORT);
-    return result;
-}
-
-
-
+    /* May be null
+    if (hStream == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuMemcpyAtoHAsync");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    */
+    Logger::log(LOG_TRACE, "Executing cuMemcpyAtoH ofAsync %d bytes\n", (size_t)ByteCount);
 
-/*
- * Class:     jcuda_driver_JCudaDriver
- * Method:    cuModuleUnloadNative
- * Signature: (Ljcuda/driver/CUmodule;)I
- */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleUnloadNative
-  (JNIEnv *env, jclass cls, jobject hmod)
-{
-    if (hmod == NULL)
+    PointerData *dstPointerData = initPointerData(env, dstHost);
+    if (dstPointerData == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hmod' is null for cuModuleUnload");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuModuleUnload\n");
 
-    CUmodule nativeHmod = (CUmodule)getNativePointerValue(env, hmod);
-    int result = cuModuleUnload(nativeHmod);
+    CUarray nativeSrcArray = (CUarray)getNativePointerValue(env, srcArray);
+
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+
+    int result = cuMemcpyAtoHAsync((void*)dstPointerData->getPointer(env), nativeSrcArray, (size_t)srcIndex, (size_t)ByteCount, nativeHStream);
+
+    if (!releasePointerData(env, dstPointerData)) return JCUDA_INTERNAL_ERROR;
     return result;
 }
 
@@ -1940,39 +7739,38 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleUnloadNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuModuleGetFunctionNative
- * Signature: (Ljcuda/driver/CUfunction;Ljcuda/driver/CUmodule;Ljava/lang/String;)I
+ * Method:    cuMemcpy2DAsyncNative
+ * Signature: (Ljcuda/driver/CUDA_MEMCPY2D;Ljcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleGetFunctionNative
-  (JNIEnv *env, jclass cls, jobject hfunc, jobject hmod, jstring name)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy2DAsyncNative
+  (JNIEnv *env, jclass cls, jobject pCopy, jobject hStream)
 {
-    if (hfunc == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuModuleGetFunction");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (hmod == NULL)
+    if (pCopy == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hmod' is null for cuModuleGetFunction");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy2DAsync");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (name == NULL)
+    /* May be null
+    if (hStream == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'name' is null for cuModuleGetFunction");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuMemcpy2DAsync");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuModuleGetFunction\n");
+    */
+    Logger::log(LOG_TRACE, "Executing cuMemcpy2DAsync\n");
 
-    CUfunction nativeHfunc;
-    CUmodule nativeHmod = (CUmodule)getNativePointerValue(env, hmod);
-    char *nativeName = convertString(env, name);
-    if (nativeName == NULL)
+    Memcpy2DData *memcpyData = initMemcpy2DData(env, pCopy);
+    if (memcpyData == NULL)
     {
         return JCUDA_INTERNAL_ERROR;
     }
-    int result = cuModuleGetFunction(&nativeHfunc, nativeHmod, nativeName);
-    setNativePointerValue(env, hfunc, (jlong)nativeHfunc);
-    delete[] nativeName;
+
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+
+    int result = cuMemcpy2DAsync(&memcpyData->memcpy2d, nativeHStream);
+
+    if (!releaseMemcpy2DData(env, memcpyData)) return JCUDA_INTERNAL_ERROR;
+
     return result;
 }
 
@@ -1981,448 +7779,586 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleGetFunctionNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuModuleGetGlobalNative
- * Signature: (Ljcuda/driver/CUdeviceptr;[JLjcuda/driver/CUmodule;Ljava/lang/String;)I
+ * Method:    cuMemcpy3DAsyncNative
+ * Signature: (Ljcuda/driver/CUDA_MEMCPY3D;Ljcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleGetGlobalNative
-  (JNIEnv *env, jclass cls, jobject dptr, jlongArray bytes, jobject hmod, jstring name)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DAsyncNative
+  (JNIEnv *env, jclass cls, jobject pCopy, jobject hStream)
 {
-    /* May be null
-    if (dptr == NULL)
+    if (pCopy == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuModuleGetGlobal");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy3DAsync");
         return JCUDA_INTERNAL_ERROR;
     }
-    */
     /* May be null
-    if (bytes == NULL)
+    if (hStream == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'bytes' is null for cuModuleGetGlobal");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuMemcpy3DAsync");
         return JCUDA_INTERNAL_ERROR;
     }
     */
-    if (hmod == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hmod' is null for cuModuleGetGlobal");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (name == NULL)
+    Logger::log(LOG_TRACE, "Executing cuMemcpy3DAsync\n");
+
+
+    Memcpy3DData *memcpyData = initMemcpy3DData(env, pCopy);
+    if (memcpyData == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'name' is null for cuModuleGetGlobal");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuModuleGetGlobal\n");
 
-    CUdeviceptr nativeDptr = (CUdeviceptr)NULL;
-    size_t nativeBytes = 0;
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
 
-    CUmodule nativeHmod = (CUmodule)getNativePointerValue(env, hmod);
+    int result = cuMemcpy3DAsync(&memcpyData->memcpy3d, nativeHStream);
 
-    char *nativeName = convertString(env, name);
-    if (nativeName == NULL)
-    {
-        return JCUDA_INTERNAL_ERROR;
-    }
-    int result = cuModuleGetGlobal(&nativeDptr, &nativeBytes, nativeHmod, nativeName);
+    if (!releaseMemcpy3DData(env, memcpyData)) return JCUDA_INTERNAL_ERROR;
 
-    setPointer(env, dptr, (jlong)nativeDptr);
-    if (!set(env, bytes, 0, nativeBytes)) return JCUDA_INTERNAL_ERROR;
-    delete[] nativeName;
     return result;
 }
 
 
 
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuModuleGetTexRefNative
- * Signature: (Ljcuda/driver/CUtexref;Ljcuda/driver/CUmodule;Ljava/lang/String;)I
+ * Method:    cuMemcpyDescriptorCreateNative
+ * Signature: (Ljcuda/driver/CUmemcpyDescriptor;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleGetTexRefNative
-  (JNIEnv *env, jclass cls, jobject pTexRef, jobject hmod, jstring name)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDescriptorCreateNative
+  (JNIEnv *env, jclass cls, jobject descriptor, jint type)
 {
-    if (pTexRef == NULL)
+    if (descriptor == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pTexRef' is null for cuModuleGetTexRef");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'descriptor' is null for cuMemcpyDescriptorCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hmod == NULL)
+    Logger::log(LOG_TRACE, "Executing cuMemcpyDescriptorCreate\n");
+
+    const MemcpyDescriptorField *fields = NULL;
+    int fieldCount = 0;
+    if (!getMemcpyDescriptorFields((int)type, &fields, &fieldCount))
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hmod' is null for cuModuleGetTexRef");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_VALUE;
     }
-    if (name == NULL)
+    jintArray offsets = env->NewIntArray(fieldCount);
+    if (offsets == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'name' is null for cuModuleGetTexRef");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuModuleGetTexRef\n");
+    for (int i=0; i<fieldCount; i++)
+    {
+        if (!set(env, offsets, i, (jint)fields[i].offset)) return JCUDA_INTERNAL_ERROR;
+    }
 
-    CUtexref nativePTexRef = NULL;
+    MemcpyDescriptor *nativeDescriptor = new MemcpyDescriptor();
+    memset(nativeDescriptor, 0, sizeof(MemcpyDescriptor));
+    nativeDescriptor->type = (int)type;
+    jobject buffer = env->NewDirectByteBuffer(&nativeDescriptor->memcpy2d, (jlong)getMemcpyDescriptorSize((int)type));
+    if (buffer == NULL)
+    {
+        delete nativeDescriptor;
+        return JCUDA_INTERNAL_ERROR;
+    }
+    env->SetObjectField(descriptor, CUmemcpyDescriptor_buffer, buffer);
+    env->SetObjectField(descriptor, CUmemcpyDescriptor_offsets, offsets);
+    env->SetIntField(descriptor, CUmemcpyDescriptor_sizeTSize, (jint)sizeof(size_t));
+    setNativePointerValue(env, descriptor, (jlong)nativeDescriptor);
+    return CUDA_SUCCESS;
+}
 
-    CUmodule nativeHmod = (CUmodule)getNativePointerValue(env, hmod);
 
-    char *nativeName = convertString(env, name);
-    if (nativeName == NULL)
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyDescriptorDestroyNative
+ * Signature: (Ljcuda/driver/CUmemcpyDescriptor;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDescriptorDestroyNative
+  (JNIEnv *env, jclass cls, jobject descriptor)
+{
+    if (descriptor == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'descriptor' is null for cuMemcpyDescriptorDestroy");
         return JCUDA_INTERNAL_ERROR;
     }
-    int result = cuModuleGetTexRef(&nativePTexRef, nativeHmod, nativeName);
-
-    setNativePointerValue(env, pTexRef, (jlong)nativePTexRef);
-    delete[] nativeName;
-    return result;
+    Logger::log(LOG_TRACE, "Executing cuMemcpyDescriptorDestroy\n");
 
+    MemcpyDescriptor *nativeDescriptor = (MemcpyDescriptor*)getNativePointerValue(env, descriptor);
+    if (nativeDescriptor == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    env->SetObjectField(descriptor, CUmemcpyDescriptor_buffer, NULL);
+    setNativePointerValue(env, descriptor, (jlong)0);
+    delete nativeDescriptor;
+    return CUDA_SUCCESS;
 }
 
 
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuModuleGetSurfRefNative
- * Signature: (Ljcuda/driver/CUsurfref;Ljcuda/driver/CUmodule;Ljava/lang/String;)I
+ * Method:    cuMemcpyDescriptorSetPointerNative
+ * Signature: (Ljcuda/driver/CUmemcpyDescriptor;ILjcuda/NativePointerObject;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleGetSurfRefNative
-  (JNIEnv *env, jclass cls, jobject pSurfRef, jobject hmod, jstring name)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDescriptorSetPointerNative
+  (JNIEnv *env, jclass cls, jobject descriptor, jint field, jobject pointer)
 {
-    if (pSurfRef == NULL)
+    if (descriptor == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pSurfRef' is null for cuModuleGetSurfRef");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'descriptor' is null for cuMemcpyDescriptorSetPointer");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hmod == NULL)
+    Logger::log(LOG_TRACE, "Executing cuMemcpyDescriptorSetPointer\n");
+
+    MemcpyDescriptor *nativeDescriptor = (MemcpyDescriptor*)getNativePointerValue(env, descriptor);
+    if (nativeDescriptor == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hmod' is null for cuModuleGetSurfRef");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_HANDLE;
     }
-    if (name == NULL)
+    const MemcpyDescriptorField *fields = NULL;
+    int fieldCount = 0;
+    if (!getMemcpyDescriptorFields(nativeDescriptor->type, &fields, &fieldCount) ||
+        field < 0 || field >= fieldCount)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'name' is null for cuModuleGetSurfRef");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_VALUE;
     }
-    Logger::log(LOG_TRACE, "Executing cuModuleGetSurfRef\n");
+    char *target = (char*)&nativeDescriptor->memcpy2d + fields[field].offset;
+    switch (fields[field].kind)
+    {
+        case DESCRIPTOR_FIELD_HOST:
+        {
+            void *host = NULL;
+            if (pointer != NULL)
+            {
+                // The address is stored, and accessed in later copies,
+                // so it must not refer to a Java array
+                if (!isPointerBackedByNativeMemory(env, pointer))
+                {
+                    Logger::log(LOG_ERROR, "Only pointers to native host memory may be stored in a memcpy descriptor\n");
+                    return CUDA_ERROR_INVALID_VALUE;
+                }
+                PointerData *pointerData = initPointerData(env, pointer);
+                if (pointerData == NULL)
+                {
+                    return JCUDA_INTERNAL_ERROR;
+                }
+                host = pointerData->getPointer(env);
+                if (!releasePointerData(env, pointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+            }
+            memcpy(target, &host, sizeof(void*));
+            return CUDA_SUCCESS;
+        }
 
-    CUsurfref nativePSurfRef = NULL;
+        case DESCRIPTOR_FIELD_DEVICE:
+        {
+            CUdeviceptr device = (CUdeviceptr)getPointer(env, pointer);
+            memcpy(target, &device, sizeof(CUdeviceptr));
+            return CUDA_SUCCESS;
+        }
 
-    CUmodule nativeHmod = (CUmodule)getNativePointerValue(env, hmod);
+        case DESCRIPTOR_FIELD_HANDLE:
+        {
+            void *handle = getNativePointerValue(env, pointer);
+            memcpy(target, &handle, sizeof(void*));
+            return CUDA_SUCCESS;
+        }
+    }
+    return CUDA_ERROR_INVALID_VALUE;
+}
 
-    char *nativeName = convertString(env, name);
-    if (nativeName == NULL)
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpy2DDescriptorNative
+ * Signature: (Ljcuda/driver/CUmemcpy2DDescriptor;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy2DDescriptorNative
+  (JNIEnv *env, jclass cls, jobject pCopy)
+{
+    if (pCopy == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy2DDescriptor");
         return JCUDA_INTERNAL_ERROR;
     }
-    int result = cuModuleGetSurfRef(&nativePSurfRef, nativeHmod, nativeName);
+    Logger::log(LOG_TRACE, "Executing cuMemcpy2DDescriptor\n");
 
-    setNativePointerValue(env, pSurfRef, (jlong)nativePSurfRef);
-    delete[] nativeName;
+    MemcpyDescriptor *nativePCopy = getMemcpyDescriptor(env, pCopy, MEMCPY_DESCRIPTOR_2D);
+    if (nativePCopy == NULL)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    int result = cuMemcpy2D(&nativePCopy->memcpy2d);
     return result;
-
 }
 
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuLinkCreateNative
- * Signature: (Ljcuda/driver/JITOptions;Ljcuda/driver/CUlinkState;)I
+ * Method:    cuMemcpy2DUnalignedDescriptorNative
+ * Signature: (Ljcuda/driver/CUmemcpy2DDescriptor;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkCreateNative
-  (JNIEnv *env, jclass cls, jobject jitOptions, jobject stateOut)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy2DUnalignedDescriptorNative
+  (JNIEnv *env, jclass cls, jobject pCopy)
 {
-    if (stateOut == NULL)
+    if (pCopy == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'stateOut' is null for cuLinkCreate");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy2DUnalignedDescriptor");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuLinkCreate\n");
-
-    CUlinkState nativeStateOut;
-	JITOptionsData *jitOptionsData = initJITOptionsData(env, jitOptions);
-	if (jitOptionsData == NULL)
-	{
-        return JCUDA_INTERNAL_ERROR;
-	}
-    int result = cuLinkCreate((unsigned int)jitOptionsData->numOptions, jitOptionsData->options, jitOptionsData->optionValues, &nativeStateOut);
+    Logger::log(LOG_TRACE, "Executing cuMemcpy2DUnalignedDescriptor\n");
 
-	if (!releaseJITOptionsData(env, jitOptionsData, jitOptions)) return JCUDA_INTERNAL_ERROR;
-    setNativePointerValue(env, stateOut, (jlong)nativeStateOut);
-	return result;
+    MemcpyDescriptor *nativePCopy = getMemcpyDescriptor(env, pCopy, MEMCPY_DESCRIPTOR_2D);
+    if (nativePCopy == NULL)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    int result = cuMemcpy2DUnaligned(&nativePCopy->memcpy2d);
+    return result;
 }
 
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuLinkAddDataNative
- * Signature: (Ljcuda/driver/CUlinkState;ILjcuda/Pointer;JLjava/lang/String;Ljcuda/driver/JITOptions;)I
+ * Method:    cuMemcpy2DAsyncDescriptorNative
+ * Signature: (Ljcuda/driver/CUmemcpy2DDescriptor;Ljcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkAddDataNative
-  (JNIEnv *env, jclass cls, jobject state, jint type, jobject data, jlong size, jstring name, jobject jitOptions)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy2DAsyncDescriptorNative
+  (JNIEnv *env, jclass cls, jobject pCopy, jobject hStream)
 {
-    if (state == NULL)
+    if (pCopy == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'state' is null for cuLinkAddData");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy2DAsyncDescriptor");
         return JCUDA_INTERNAL_ERROR;
     }
-	// name and jitOptions may be null
-    
-	Logger::log(LOG_TRACE, "Executing cuLinkAddData\n");
+    Logger::log(LOG_TRACE, "Executing cuMemcpy2DAsyncDescriptor\n");
 
-    CUlinkState nativeState = (CUlinkState)getNativePointerValue(env, state);
-    PointerData *dataPointerData = initPointerData(env, data);
-    if (dataPointerData == NULL)
+    MemcpyDescriptor *nativePCopy = getMemcpyDescriptor(env, pCopy, MEMCPY_DESCRIPTOR_2D);
+    if (nativePCopy == NULL)
     {
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_VALUE;
     }
-    char *nativeName = convertString(env, name);
-
-	JITOptionsData *jitOptionsData = initJITOptionsData(env, jitOptions);
-	if (jitOptionsData == NULL)
-	{
-        return JCUDA_INTERNAL_ERROR;
-	}
-    
-	int result = cuLinkAddData(nativeState, (CUjitInputType)type, dataPointerData->getPointer(env), (size_t)size, nativeName, 
-		(unsigned int)jitOptionsData->numOptions, jitOptionsData->options, jitOptionsData->optionValues);
-
-    if (!releasePointerData(env, dataPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
-    delete[] nativeName;
-	if (!releaseJITOptionsData(env, jitOptionsData, jitOptions)) return JCUDA_INTERNAL_ERROR;
-	return result;
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    int result = cuMemcpy2DAsync(&nativePCopy->memcpy2d, nativeHStream);
+    return result;
 }
 
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuLinkAddFileNative
- * Signature: (Ljcuda/driver/CUlinkState;ILjava/lang/String;Ljcuda/driver/JITOptions;)I
+ * Method:    cuMemcpy3DDescriptorNative
+ * Signature: (Ljcuda/driver/CUmemcpy3DDescriptor;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkAddFileNative
-  (JNIEnv *env, jclass cls, jobject state, jint type, jstring path, jobject jitOptions)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DDescriptorNative
+  (JNIEnv *env, jclass cls, jobject pCopy)
 {
-    if (state == NULL)
+    if (pCopy == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'state' is null for cuLinkAddFile");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy3DDescriptor");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (path == NULL)
+    Logger::log(LOG_TRACE, "Executing cuMemcpy3DDescriptor\n");
+
+    MemcpyDescriptor *nativePCopy = getMemcpyDescriptor(env, pCopy, MEMCPY_DESCRIPTOR_3D);
+    if (nativePCopy == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'state' is null for cuLinkAddFile");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_VALUE;
     }
-    
-	Logger::log(LOG_TRACE, "Executing cuLinkAddFile\n");
+    int result = cuMemcpy3D(&nativePCopy->memcpy3d);
+    return result;
+}
 
-    CUlinkState nativeState = (CUlinkState)getNativePointerValue(env, state);
-    char *nativePath = convertString(env, path);
 
-	JITOptionsData *jitOptionsData = initJITOptionsData(env, jitOptions);
-	if (jitOptionsData == NULL)
-	{
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpy3DAsyncDescriptorNative
+ * Signature: (Ljcuda/driver/CUmemcpy3DDescriptor;Ljcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DAsyncDescriptorNative
+  (JNIEnv *env, jclass cls, jobject pCopy, jobject hStream)
+{
+    if (pCopy == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy3DAsyncDescriptor");
         return JCUDA_INTERNAL_ERROR;
-	}
-    
-	int result = cuLinkAddFile(nativeState, (CUjitInputType)type, nativePath, 
-		(unsigned int)jitOptionsData->numOptions, jitOptionsData->options, jitOptionsData->optionValues);
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpy3DAsyncDescriptor\n");
 
-    delete[] nativePath;
-	if (!releaseJITOptionsData(env, jitOptionsData, jitOptions)) return JCUDA_INTERNAL_ERROR;
-	return result;
+    MemcpyDescriptor *nativePCopy = getMemcpyDescriptor(env, pCopy, MEMCPY_DESCRIPTOR_3D);
+    if (nativePCopy == NULL)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    int result = cuMemcpy3DAsync(&nativePCopy->memcpy3d, nativeHStream);
+    return result;
 }
 
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuLinkCompleteNative
- * Signature: (Ljcuda/driver/CUlinkState;Ljcuda/Pointer;[J)I
+ * Method:    cuMemcpy3DPeerDescriptorNative
+ * Signature: (Ljcuda/driver/CUmemcpy3DPeerDescriptor;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkCompleteNative
-  (JNIEnv *env, jclass cls, jobject state, jobject cubinOut, jlongArray sizeOut)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DPeerDescriptorNative
+  (JNIEnv *env, jclass cls, jobject pCopy)
 {
-    if (state == NULL)
+    if (pCopy == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'state' is null for cuLinkComplete");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy3DPeerDescriptor");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (cubinOut == NULL)
+    Logger::log(LOG_TRACE, "Executing cuMemcpy3DPeerDescriptor\n");
+
+    MemcpyDescriptor *nativePCopy = getMemcpyDescriptor(env, pCopy, MEMCPY_DESCRIPTOR_3D_PEER);
+    if (nativePCopy == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'cubinOut' is null for cuLinkComplete");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_VALUE;
     }
-    
-	Logger::log(LOG_TRACE, "Executing cuLinkComplete\n");
-
-    CUlinkState nativeState = (CUlinkState)getNativePointerValue(env, state);
-	void *nativeCubinOut;
-	size_t nativeSizeOut;
-    
-	int result = cuLinkComplete(nativeState, &nativeCubinOut, &nativeSizeOut);
-
-	setNativePointerValue(env, cubinOut, (jlong)nativeCubinOut);
-	if (sizeOut != NULL)
-	{
-		set(env, sizeOut, 0, nativeSizeOut);
-	}
-	return result;
+    int result = cuMemcpy3DPeer(&nativePCopy->memcpy3dPeer);
+    return result;
 }
 
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuLinkDestroyNative
- * Signature: (Ljcuda/driver/CUlinkState;)I
+ * Method:    cuMemcpy3DPeerAsyncDescriptorNative
+ * Signature: (Ljcuda/driver/CUmemcpy3DPeerDescriptor;Ljcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkDestroyNative
-  (JNIEnv *env, jclass cls, jobject state)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DPeerAsyncDescriptorNative
+  (JNIEnv *env, jclass cls, jobject pCopy, jobject hStream)
 {
-    if (state == NULL)
+    if (pCopy == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'state' is null for cuLinkDestroy");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy3DPeerAsyncDescriptor");
         return JCUDA_INTERNAL_ERROR;
     }
-    
-	Logger::log(LOG_TRACE, "Executing cuLinkDestroy\n");
+    Logger::log(LOG_TRACE, "Executing cuMemcpy3DPeerAsyncDescriptor\n");
 
-    CUlinkState nativeState = (CUlinkState)getNativePointerValue(env, state);
-    
-	int result = cuLinkDestroy(nativeState);
-	return result;
+    MemcpyDescriptor *nativePCopy = getMemcpyDescriptor(env, pCopy, MEMCPY_DESCRIPTOR_3D_PEER);
+    if (nativePCopy == NULL)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    int result = cuMemcpy3DPeerAsync(&nativePCopy->memcpy3dPeer, nativeHStream);
+    return result;
 }
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemGetInfoNative
- * Signature: ([J[J)I
+ * Method:    cuMemcpy2DBatchAsyncNative
+ * Signature: (Ljcuda/driver/CUmemcpy2DDescriptor;[JILjcuda/driver/CUstream;[I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemGetInfoNative
-  (JNIEnv *env, jclass cls, jlongArray free, jlongArray total)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy2DBatchAsyncNative
+  (JNIEnv *env, jclass cls, jobject pCopy, jlongArray rects, jint count, jobject hStream, jintArray copies)
 {
-    if (free == NULL)
+    if (pCopy == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'free' is null for cuMemGetInfo");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy2DBatchAsync");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (total == NULL)
+    if (rects == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'total' is null for cuMemGetInfo");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'rects' is null for cuMemcpy2DBatchAsync");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemGetInfo\n");
+    Logger::log(LOG_TRACE, "Executing cuMemcpy2DBatchAsync\n");
 
-    size_t nativeFree = 0;
-    size_t nativeTotal = 0;
-    int result = cuMemGetInfo(&nativeFree, &nativeTotal);
-    if (!set(env, free, 0, nativeFree)) return JCUDA_INTERNAL_ERROR;
-    if (!set(env, total, 0, nativeTotal)) return JCUDA_INTERNAL_ERROR;
+    MemcpyDescriptor *nativePCopy = getMemcpyDescriptor(env, pCopy, MEMCPY_DESCRIPTOR_2D);
+    if (nativePCopy == NULL)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    std::vector<CopyRect> copyRects;
+    if (!readCopyRects(env, rects, (int)count, false, copyRects))
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    int copyCount = coalesceCopyRects(copyRects.empty() ? NULL : &copyRects[0], (int)count);
+    Logger::log(LOG_DEBUGTRACE, "Issuing %d copies for %d rectangles\n", copyCount, (int)count);
+
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    CUDA_MEMCPY2D mc = nativePCopy->memcpy2d;
+    int result = CUDA_SUCCESS;
+    for (int i=0; i<copyCount; i++)
+    {
+        const CopyRect &r = copyRects[i];
+        mc.srcXInBytes = r.srcX;
+        mc.srcY = r.srcY;
+        mc.dstXInBytes = r.dstX;
+        mc.dstY = r.dstY;
+        mc.WidthInBytes = r.width;
+        mc.Height = r.height;
+        result = cuMemcpy2DAsync(&mc, nativeHStream);
+        if (result != CUDA_SUCCESS)
+        {
+            break;
+        }
+    }
+    if (copies != NULL)
+    {
+        if (!set(env, copies, 0, copyCount)) return JCUDA_INTERNAL_ERROR;
+    }
     return result;
 }
 
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemHostAllocNative
- * Signature: (Ljcuda/Pointer;JI)I
+ * Method:    cuMemcpy3DBatchAsyncNative
+ * Signature: (Ljcuda/driver/CUmemcpy3DDescriptor;[JILjcuda/driver/CUstream;[I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostAllocNative
-  (JNIEnv *env, jclass cls, jobject pp, jlong bytesize, jint Flags)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DBatchAsyncNative
+  (JNIEnv *env, jclass cls, jobject pCopy, jlongArray rects, jint count, jobject hStream, jintArray copies)
 {
-    if (pp == NULL)
+    if (pCopy == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pp' is null for cuMemHostAlloc");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy3DBatchAsync");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemHostAlloc\n");
+    if (rects == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'rects' is null for cuMemcpy3DBatchAsync");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemcpy3DBatchAsync\n");
 
-    void *nativePp;
-    int result = cuMemHostAlloc(&nativePp, (size_t)bytesize, (unsigned int)Flags);
-    if (result == CUDA_SUCCESS)
+    MemcpyDescriptor *nativePCopy = getMemcpyDescriptor(env, pCopy, MEMCPY_DESCRIPTOR_3D);
+    if (nativePCopy == NULL)
     {
-        jobject object = env->NewDirectByteBuffer(nativePp, bytesize);
-        env->SetObjectField(pp, Pointer_buffer, object);
-        env->SetObjectField(pp, Pointer_pointers, NULL);
-        env->SetLongField(pp, Pointer_byteOffset, 0);
-        env->SetLongField(pp, NativePointerObject_nativePointer, (jlong)nativePp);
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    std::vector<CopyRect> copyRects;
+    if (!readCopyRects(env, rects, (int)count, true, copyRects))
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    int copyCount = coalesceCopyRects(copyRects.empty() ? NULL : &copyRects[0], (int)count);
+    Logger::log(LOG_DEBUGTRACE, "Issuing %d copies for %d rectangles\n", copyCount, (int)count);
+
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    CUDA_MEMCPY3D mc = nativePCopy->memcpy3d;
+    int result = CUDA_SUCCESS;
+    for (int i=0; i<copyCount; i++)
+    {
+        const CopyRect &r = copyRects[i];
+        mc.srcXInBytes = r.srcX;
+        mc.srcY = r.srcY;
+        mc.srcZ = r.srcZ;
+        mc.dstXInBytes = r.dstX;
+        mc.dstY = r.dstY;
+        mc.dstZ = r.dstZ;
+        mc.WidthInBytes = r.width;
+        mc.Height = r.height;
+        mc.Depth = r.depth;
+        result = cuMemcpy3DAsync(&mc, nativeHStream);
+        if (result != CUDA_SUCCESS)
+        {
+            break;
+        }
+    }
+    if (copies != NULL)
+    {
+        if (!set(env, copies, 0, copyCount)) return JCUDA_INTERNAL_ERROR;
     }
     return result;
 }
 
+
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemHostGetDevicePointerNative
- * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/Pointer;I)I
+ * Method:    cuMemsetD8Native
+ * Signature: (Ljcuda/driver/CUdeviceptr;BJ)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostGetDevicePointerNative
-  (JNIEnv *env, jclass cls, jobject ret, jobject p, jint Flags)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD8Native
+  (JNIEnv *env, jclass cls, jobject dstDevice, jbyte uc, jlong N)
 {
-    if (ret == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ret' is null for cuMemHostGetDevicePointer");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (p == NULL)
+    if (dstDevice == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'p' is null for cuMemHostGetDevicePointer");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD8");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemHostGetDevicePointer\n");
+    Logger::log(LOG_TRACE, "Executing cuMemsetD8\n");
 
-    if (!isPointerBackedByNativeMemory(env, p))
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+
+    int result = cuMemsetD8(nativeDstDevice, (unsigned char)uc, (size_t)N);
+
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemsetD16Native
+ * Signature: (Ljcuda/driver/CUdeviceptr;SJ)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD16Native
+  (JNIEnv *env, jclass cls, jobject dstDevice, jshort us, jlong N)
+{
+    if (dstDevice == NULL)
     {
-        ThrowByName(env, "java/lang/IllegalArgumentException",
-            "Pointer must point to a direct buffer or native memory");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD16");
         return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cuMemsetD16\n");
 
-    CUdeviceptr nativeRet;
-    PointerData *pPointerData = initPointerData(env, p);
-    if (pPointerData == NULL)
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+
+    int result = cuMemsetD16(nativeDstDevice, (unsigned short)us, (size_t)N);
+
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemsetD32Native
+ * Signature: (Ljcuda/driver/CUdeviceptr;IJ)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD32Native
+  (JNIEnv *env, jclass cls, jobject dstDevice, jint ui, jlong N)
+{
+    if (dstDevice == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD32");
         return JCUDA_INTERNAL_ERROR;
     }
-    int result = cuMemHostGetDevicePointer(&nativeRet, (void*)pPointerData->getPointer(env), (unsigned int)Flags);
-    setPointer(env, ret, (jlong)nativeRet);
-    if (!releasePointerData(env, pPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    Logger::log(LOG_TRACE, "Executing cuMemsetD32\n");
+
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+
+    int result = cuMemsetD32(nativeDstDevice, (unsigned int)ui, (size_t)N);
+
     return result;
 }
 
 
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemHostGetFlagsNative
- * Signature: ([ILjcuda/Pointer;)I
+ * Method:    cuMemsetD2D8Native
+ * Signature: (Ljcuda/driver/CUdeviceptr;JBJJ)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostGetFlagsNative
-  (JNIEnv *env, jclass cls, jintArray pFlags, jobject p)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD2D8Native
+  (JNIEnv *env, jclass cls, jobject dstDevice, jlong dstPitch, jbyte uc, jlong Width, jlong Height)
 {
-    if (pFlags == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pFlags' is null for cuMemHostGetFlags");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (p == NULL)
+    if (dstDevice == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'p' is null for cuMemHostGetFlags");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD2D8");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemHostGetFlags\n");
+    Logger::log(LOG_TRACE, "Executing cuMemsetD2D8\n");
 
-    if (!isPointerBackedByNativeMemory(env, p))
-    {
-        ThrowByName(env, "java/lang/IllegalArgumentException",
-            "Pointer must point to a direct buffer or native memory");
-        return JCUDA_INTERNAL_ERROR;
-    }
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
 
-    PointerData *pPointerData = initPointerData(env, p);
-    if (pPointerData == NULL)
-    {
-        return JCUDA_INTERNAL_ERROR;
-    }
+    int result = cuMemsetD2D8(nativeDstDevice, (size_t)dstPitch, (unsigned char)uc, (size_t)Width, (size_t)Height);
 
-    unsigned int nativePFlags;
-    int result = cuMemHostGetFlags(&nativePFlags, (void*)pPointerData->getPointer(env));
-    if (!set(env, pFlags, 0, nativePFlags)) return JCUDA_INTERNAL_ERROR;
-    if (!releasePointerData(env, pPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
     return result;
 }
 
@@ -2431,205 +8367,222 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostGetFlagsNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuDeviceGetByPCIBusIdNative
- * Signature: (Ljcuda/driver/CUdevice;Ljava/lang/String;)I
+ * Method:    cuMemsetD2D16Native
+ * Signature: (Ljcuda/driver/CUdeviceptr;JSJJ)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuDeviceGetByPCIBusIdNative
-  (JNIEnv *env, jclass cls, jobject dev, jstring pciBusId)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD2D16Native
+  (JNIEnv *env, jclass cls, jobject dstDevice, jlong dstPitch, jshort us, jlong Width, jlong Height)
 {
-    if (dev == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dev' is null for cuDeviceGetByPCIBusId");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (pciBusId == NULL)
+    if (dstDevice == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pciBusId' is null for cuDeviceGetByPCIBusId");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD2D16");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuDeviceGetByPCIBusId\n");
+    Logger::log(LOG_TRACE, "Executing cuMemsetD2D16\n");
 
-    char *nativePciBusId = convertString(env, pciBusId);
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
 
-    CUdevice nativeDev;
-    int result = cuDeviceGetByPCIBusId(&nativeDev, nativePciBusId);
-    setNativePointerValue(env, dev, (jlong)nativeDev);
-    delete[] nativePciBusId;
+    int result = cuMemsetD2D16(nativeDstDevice, (size_t)dstPitch, (unsigned short)us, (size_t)Width, (size_t)Height);
 
     return result;
 }
 
+
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuDeviceGetPCIBusIdNative
- * Signature: ([Ljava/lang/String;ILjcuda/driver/CUdevice;)I
+ * Method:    cuMemsetD2D32Native
+ * Signature: (Ljcuda/driver/CUdeviceptr;JIJJ)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuDeviceGetPCIBusIdNative
-  (JNIEnv *env, jclass cls, jobjectArray pciBusId, jint len, jobject dev)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD2D32Native
+  (JNIEnv *env, jclass cls, jobject dstDevice, jlong dstPitch, jint ui, jlong Width, jlong Height)
 {
-    if (pciBusId == NULL)
+    if (dstDevice == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pciBusId' is null for cuDeviceGetPCIBusId");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD2D32");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (dev == NULL)
+    Logger::log(LOG_TRACE, "Executing cuMemsetD2D32\n");
+
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+
+    int result = cuMemsetD2D32(nativeDstDevice, (size_t)dstPitch, (unsigned int)ui, (size_t)Width, (size_t)Height);
+
+    return result;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemsetD8AsyncNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;BJLjcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD8AsyncNative
+  (JNIEnv *env, jclass cls, jobject dstDevice, jbyte uc, jlong N, jobject hStream)
+{
+    if (dstDevice == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dev' is null for cuDeviceGetPCIBusId");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD8Async");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuDeviceGetPCIBusId\n");
+    Logger::log(LOG_TRACE, "Executing cuMemsetD8Async\n");
 
-    char *nativePciBusId = new char[(int)len];
-    CUdevice nativeDev = (CUdevice)(intptr_t)getNativePointerValue(env, dev);
-    int result = cuDeviceGetPCIBusId(nativePciBusId, (int)len, nativeDev);
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
 
-    jstring pciBusIdElement = env->NewStringUTF(nativePciBusId);
-    if (pciBusIdElement == NULL)
-    {
-       ThrowByName(env, "java/lang/OutOfMemoryError", "Out of memory creating result string");
-       return JCUDA_INTERNAL_ERROR;
-    }
-    delete[] nativePciBusId;
-    env->SetObjectArrayElement(pciBusId, 0, pciBusIdElement);
-    if (env->ExceptionCheck())
+    OperationGraph *graph = OperationGraph::getCapturing();
+    if (graph != NULL)
     {
-        return JCUDA_INTERNAL_ERROR;
+        graph->addMemset(OPERATION_MEMSET_D8, nativeDstDevice, (unsigned char)uc, (size_t)N, nativeHStream);
+        return CUDA_SUCCESS;
     }
+
+    int result = cuMemsetD8Async(nativeDstDevice, (unsigned char)uc, (size_t)N, nativeHStream);
+
     return result;
 }
 
 
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuIpcGetEventHandleNative
- * Signature: (Ljcuda/driver/CUipcEventHandle;Ljcuda/driver/CUevent;)I
+ * Method:    cuMemsetD16AsyncNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;SJLjcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcGetEventHandleNative
-  (JNIEnv *env, jclass cls, jobject pHandle, jobject event)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD16AsyncNative
+  (JNIEnv *env, jclass cls, jobject dstDevice, jshort us, jlong N, jobject hStream)
 {
-    if (pHandle == NULL)
+    if (dstDevice == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pHandle' is null for cuIpcGetEventHandle");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD16Async");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (event == NULL)
+    Logger::log(LOG_TRACE, "Executing cuMemsetD16Async\n");
+
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+
+    OperationGraph *graph = OperationGraph::getCapturing();
+    if (graph != NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'event' is null for cuIpcGetEventHandle");
-        return JCUDA_INTERNAL_ERROR;
+        graph->addMemset(OPERATION_MEMSET_D16, nativeDstDevice, (unsigned short)us, (size_t)N, nativeHStream);
+        return CUDA_SUCCESS;
     }
-    Logger::log(LOG_TRACE, "Executing cuIpcGetEventHandle\n");
 
-    CUevent nativeEvent = (CUevent)getNativePointerValue(env, event);
-    CUipcEventHandle nativePHandle;
+    int result = cuMemsetD16Async(nativeDstDevice, (unsigned short)us, (size_t)N, nativeHStream);
 
-    int result = cuIpcGetEventHandle(&nativePHandle, nativeEvent);
-    setCUipcEventHandle(env, pHandle, nativePHandle);
     return result;
 }
 
+
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuIpcOpenEventHandleNative
- * Signature: (Ljcuda/driver/CUevent;Ljcuda/driver/CUipcEventHandle;)I
+ * Method:    cuMemsetD32AsyncNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;IJLjcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcOpenEventHandleNative
-  (JNIEnv *env, jclass cls, jobject phEvent, jobject handle)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD32AsyncNative
+  (JNIEnv *env, jclass cls, jobject dstDevice, jint ui, jlong N, jobject hStream)
 {
-    if (phEvent == NULL)
+    if (dstDevice == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phEvent' is null for cuIpcOpenEventHandle");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD32Async");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (handle == NULL)
+    Logger::log(LOG_TRACE, "Executing cuMemsetD32Async\n");
+
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+
+    OperationGraph *graph = OperationGraph::getCapturing();
+    if (graph != NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'handle' is null for cuIpcOpenEventHandle");
-        return JCUDA_INTERNAL_ERROR;
+        graph->addMemset(OPERATION_MEMSET_D32, nativeDstDevice, (unsigned int)ui, (size_t)N, nativeHStream);
+        return CUDA_SUCCESS;
     }
-    Logger::log(LOG_TRACE, "Executing cuIpcOpenEventHandle\n");
 
-    CUevent nativePhEvent;
-    CUipcEventHandle nativeHandle = getCUipcEventHandle(env, handle);
-    int result = cuIpcOpenEventHandle(&nativePhEvent, nativeHandle);
+    int result = cuMemsetD32Async(nativeDstDevice, (unsigned int)ui, (size_t)N, nativeHStream);
 
-    setNativePointerValue(env, phEvent, (jlong)nativePhEvent);
     return result;
 }
 
+
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuIpcGetMemHandleNative
- * Signature: (Ljcuda/driver/CUipcMemHandle;Ljcuda/driver/CUdeviceptr;)I
+ * Method:    cuMemsetD2D8AsyncNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;JBJJLjcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcGetMemHandleNative
-  (JNIEnv *env, jclass cls, jobject pHandle, jobject dptr)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD2D8AsyncNative
+  (JNIEnv *env, jclass cls, jobject dstDevice, jlong dstPitch, jbyte uc, jlong Width, jlong Height, jobject hStream)
 {
-    if (pHandle == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pHandle' is null for cuIpcGetMemHandle");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (dptr == NULL)
+    if (dstDevice == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuIpcGetMemHandle");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD2D8Async");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuIpcGetMemHandle\n");
+    Logger::log(LOG_TRACE, "Executing cuMemsetD2D8Async\n");
 
-    CUipcMemHandle nativePHandle;
-    CUdeviceptr nativeDptr = (CUdeviceptr)getPointer(env, dptr);
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+
+    int result = cuMemsetD2D8Async(nativeDstDevice, (size_t)dstPitch, (unsigned char)uc, (size_t)Width, (size_t)Height, nativeHStream);
 
-    int result = cuIpcGetMemHandle(&nativePHandle, nativeDptr);
-    setCUipcMemHandle(env, pHandle, nativePHandle);
     return result;
 }
 
+
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuIpcOpenMemHandleNative
- * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUipcMemHandle;I)I
+ * Method:    cuMemsetD2D16AsyncNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;JSJJLjcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcOpenMemHandleNative
-  (JNIEnv *env, jclass cls, jobject pdptr, jobject handle, jint Flags)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD2D16AsyncNative
+  (JNIEnv *env, jclass cls, jobject dstDevice, jlong dstPitch, jshort us, jlong Width, jlong Height, jobject hStream)
 {
-    if (pdptr == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pdptr' is null for cuIpcOpenMemHandle");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (handle == NULL)
+    if (dstDevice == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'handle' is null for cuIpcOpenMemHandle");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD2D16Async");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuIpcOpenMemHandle\n");
+    Logger::log(LOG_TRACE, "Executing cuMemsetD2D16Async\n");
 
-    CUipcMemHandle nativeHandle = getCUipcMemHandle(env, handle);
-    CUdeviceptr nativePdptr = NULL;
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
 
-    int result = cuIpcOpenMemHandle(&nativePdptr, nativeHandle, (int)Flags);
+    int result = cuMemsetD2D16Async(nativeDstDevice, (size_t)dstPitch, (unsigned short)us, (size_t)Width, (size_t)Height, nativeHStream);
 
-    setPointer(env, pdptr, (jlong)nativePdptr);
     return result;
 }
 
+
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuIpcCloseMemHandleNative
- * Signature: (Ljcuda/driver/CUdeviceptr;)I
+ * Method:    cuMemsetD2D32AsyncNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;JIJJLjcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcCloseMemHandleNative
-  (JNIEnv *env, jclass cls, jobject dptr)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD2D32AsyncNative
+  (JNIEnv *env, jclass cls, jobject dstDevice, jlong dstPitch, jint ui, jlong Width, jlong Height, jobject hStream)
 {
-    if (dptr == NULL)
+    if (dstDevice == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuIpcCloseMemHandle");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD2D32Async");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuIpcCloseMemHandle\n");
+    Logger::log(LOG_TRACE, "Executing cuMemsetD2D32Async\n");
 
-    CUdeviceptr nativeDptr = (CUdeviceptr)getPointer(env, dptr);
+    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+
+    int result = cuMemsetD2D32Async(nativeDstDevice, (size_t)dstPitch, (unsigned int)ui, (size_t)Width, (size_t)Height, nativeHStream);
 
-    int result = cuIpcCloseMemHandle(nativeDptr);
     return result;
 }
 
@@ -2639,316 +8592,335 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcCloseMemHandleNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemHostRegisterNative
- * Signature: (Ljcuda/Pointer;JI)I
+ * Method:    cuLaunchKernelNative
+ * Signature: (Ljcuda/driver/CUfunction;IIIIIIILjcuda/driver/CUstream;Ljcuda/Pointer;Ljcuda/Pointer;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostRegisterNative
-  (JNIEnv *env, jclass cls, jobject p, jlong bytesize, jint Flags)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLaunchKernelNative
+  (JNIEnv *env, jclass cls, jobject f, jint gridDimX, jint gridDimY, jint gridDimZ, jint blockDimX, jint blockDimY, jint blockDimZ, jint sharedMemBytes, jobject hStream, jobject kernelParams, jobject extra)
 {
-    if (p == NULL)
+    if (f == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'p' is null for cuMemHostRegister");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'f' is null for cuLaunchKernel");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemHostRegister\n");
+    Logger::log(LOG_TRACE, "Executing cuLaunchKernel\n");
 
-    if (!isPointerBackedByNativeMemory(env, p))
+    CUfunction nativeF = NULL;
+    int resolveResult = getNativeFunction(env, f, &nativeF);
+    if (resolveResult != CUDA_SUCCESS)
     {
-        ThrowByName(env, "java/lang/IllegalArgumentException",
-            "Pointer must point to a direct buffer or native memory");
-        return JCUDA_INTERNAL_ERROR;
+        return resolveResult;
     }
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
 
-    PointerData *pPointerData = initPointerData(env, p);
-    if (pPointerData == NULL)
+    OperationGraph *graph = OperationGraph::getCapturing();
+    if (graph != NULL)
     {
-        return JCUDA_INTERNAL_ERROR;
+        if (extra != NULL)
+        {
+            Logger::log(LOG_ERROR, "The 'extra' parameter is not supported when capturing cuLaunchKernel\n");
+            return CUDA_ERROR_INVALID_VALUE;
+        }
+        return captureLaunch(env, graph, nativeF,
+            (unsigned int)gridDimX, (unsigned int)gridDimY, (unsigned int)gridDimZ,
+            (unsigned int)blockDimX, (unsigned int)blockDimY, (unsigned int)blockDimZ,
+            (unsigned int)sharedMemBytes, nativeHStream, kernelParams);
     }
-    int result = cuMemHostRegister((void*)pPointerData->getPointer(env), (size_t)bytesize, (unsigned int)Flags);
-    if (!releasePointerData(env, pPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
-    return result;
-}
 
-/*
- * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemHostUnregisterNative
- * Signature: (Ljcuda/Pointer;)I
- */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostUnregisterNative
-  (JNIEnv *env, jclass cls, jobject p)
-{
-    if (p == NULL)
+    // TODO: Verify if this (especially the treatment of 'extra') is correct!
+
+    int flushResult = symbolStaging.flush(nativeHStream);
+    if (flushResult != CUDA_SUCCESS)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'p' is null for cuMemHostUnregister");
-        return JCUDA_INTERNAL_ERROR;
+        return flushResult;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemHostUnregister\n");
 
-    PointerData *pPointerData = initPointerData(env, p);
-    if (pPointerData == NULL)
+    PointerData *kernelParamsPointerData = NULL;
+    void **nativeKernelParams = NULL;
+    if (kernelParams != NULL)
     {
-        return JCUDA_INTERNAL_ERROR;
+        kernelParamsPointerData = initPointerData(env, kernelParams);
+        if (kernelParamsPointerData == NULL)
+        {
+            return JCUDA_INTERNAL_ERROR;
+        }
+        nativeKernelParams = (void**)kernelParamsPointerData->getPointer(env);
     }
-    int result = cuMemHostUnregister((void*)pPointerData->getPointer(env));
-    if (!releasePointerData(env, pPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+
+    PointerData *extraPointerData = NULL;
+    void **nativeExtra = NULL;
+    if (extra != NULL)
+    {
+        extraPointerData = initPointerData(env, extra);
+        if (extraPointerData == NULL)
+        {
+            return JCUDA_INTERNAL_ERROR;
+        }
+        nativeExtra = (void**)extraPointerData->getPointer(env);
+    }
+
+    int result = cuLaunchKernel(
+        nativeF,
+        (unsigned int)gridDimX,
+        (unsigned int)gridDimY,
+        (unsigned int)gridDimZ,
+        (unsigned int)blockDimX,
+        (unsigned int)blockDimY,
+        (unsigned int)blockDimZ,
+        (unsigned int)sharedMemBytes,
+        nativeHStream,
+        nativeKernelParams,
+        nativeExtra);
+
+    if (!releasePointerData(env, kernelParamsPointerData, 0)) return JCUDA_INTERNAL_ERROR;
+    if (!releasePointerData(env, extraPointerData, 0)) return JCUDA_INTERNAL_ERROR;
+
     return result;
 }
 
 
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyNative
- * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUdeviceptr;J)I
+ * Method:    cuOpGraphCreateNative
+ * Signature: (Ljcuda/driver/CUopGraph;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyNative
-  (JNIEnv *env, jclass cls, jobject dst, jobject src, jlong ByteCount)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOpGraphCreateNative
+  (JNIEnv *env, jclass cls, jobject graph)
 {
-    if (dst == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dst' is null for cuMemcpy");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (src == NULL)
+    if (graph == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'src' is null for cuMemcpy");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'graph' is null for cuOpGraphCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemcpy\n");
+    Logger::log(LOG_TRACE, "Executing cuOpGraphCreate\n");
 
-    CUdeviceptr nativeDst = (CUdeviceptr)getPointer(env, dst);
-    CUdeviceptr nativeSrc = (CUdeviceptr)getPointer(env, src);
-    int result = cuMemcpy(nativeDst, nativeSrc, (size_t)ByteCount);
-    return result;
+    OperationGraph *nativeGraph = new OperationGraph();
+    setNativePointerValue(env, graph, (jlong)nativeGraph);
+    return CUDA_SUCCESS;
 }
 
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyPeerNative
- * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUcontext;Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUcontext;J)I
+ * Method:    cuOpGraphDestroyNative
+ * Signature: (Ljcuda/driver/CUopGraph;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyPeerNative
-  (JNIEnv *env, jclass cls, jobject dstDevice, jobject dstContext, jobject srcDevice, jobject srcContext, jlong ByteCount)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOpGraphDestroyNative
+  (JNIEnv *env, jclass cls, jobject graph)
 {
-    if (dstDevice == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyPeer");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (dstContext == NULL)
+    if (graph == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstContext' is null for cuMemcpyPeer");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'graph' is null for cuOpGraphDestroy");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (srcDevice == NULL)
+    Logger::log(LOG_TRACE, "Executing cuOpGraphDestroy\n");
+
+    OperationGraph *nativeGraph = (OperationGraph*)getNativePointerValue(env, graph);
+    if (nativeGraph == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyPeer");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_HANDLE;
     }
-    if (srcContext == NULL)
+
+    // The threads that are capturing into the graph refer to it
+    if (nativeGraph->isCapturing())
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstContext' is null for cuMemcpyPeer");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_VALUE;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemcpyPeer\n");
-
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
-    CUcontext nativeDstContext = (CUcontext)getNativePointerValue(env, dstContext);
-    CUdeviceptr nativeSrcDevice = (CUdeviceptr)getPointer(env, srcDevice);
-    CUcontext nativeSrcContext = (CUcontext)getNativePointerValue(env, srcContext);
-    int result = cuMemcpyPeer(nativeDstDevice, nativeDstContext, nativeSrcDevice, nativeSrcContext, (size_t)ByteCount);
-    return result;
+    delete nativeGraph;
+    setNativePointerValue(env, graph, (jlong)0);
+    return CUDA_SUCCESS;
 }
 
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyAsyncNative
- * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUdeviceptr;JLjcuda/driver/CUstream;)I
+ * Method:    cuOpGraphBeginCaptureNative
+ * Signature: (Ljcuda/driver/CUopGraph;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAsyncNative
-  (JNIEnv *env, jclass cls, jobject dst, jobject src, jlong ByteCount, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOpGraphBeginCaptureNative
+  (JNIEnv *env, jclass cls, jobject graph)
 {
-    if (dst == NULL)
+    if (graph == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dst' is null for cuMemcpyAsync");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'graph' is null for cuOpGraphBeginCapture");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (src == NULL)
+    Logger::log(LOG_TRACE, "Executing cuOpGraphBeginCapture\n");
+
+    OperationGraph *nativeGraph = (OperationGraph*)getNativePointerValue(env, graph);
+    if (nativeGraph == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'src' is null for cuMemcpyAsync");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_HANDLE;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemcpyAsync\n");
-
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
-
-    CUdeviceptr nativeDst = (CUdeviceptr)getPointer(env, dst);
-    CUdeviceptr nativeSrc = (CUdeviceptr)getPointer(env, src);
-    int result = cuMemcpyAsync(nativeDst, nativeSrc, (size_t)ByteCount, nativeHStream);
-    return result;
+    return nativeGraph->beginCapture();
 }
 
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyPeerAsyncNative
- * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUcontext;Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUcontext;JLjcuda/driver/CUstream;)I
+ * Method:    cuOpGraphEndCaptureNative
+ * Signature: (Ljcuda/driver/CUopGraph;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyPeerAsyncNative
-  (JNIEnv *env, jclass cls, jobject dstDevice, jobject dstContext, jobject srcDevice, jobject srcContext, jlong ByteCount, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOpGraphEndCaptureNative
+  (JNIEnv *env, jclass cls, jobject graph)
 {
-    if (dstDevice == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyPeerAsync");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (dstContext == NULL)
+    if (graph == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstContext' is null for cuMemcpyPeerAsync");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (srcDevice == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyPeerAsync");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'graph' is null for cuOpGraphEndCapture");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (srcContext == NULL)
+    Logger::log(LOG_TRACE, "Executing cuOpGraphEndCapture\n");
+
+    OperationGraph *nativeGraph = (OperationGraph*)getNativePointerValue(env, graph);
+    if (nativeGraph == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstContext' is null for cuMemcpyPeerAsync");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_HANDLE;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemcpyPeerAsync\n");
-
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
-
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
-    CUcontext nativeDstContext = (CUcontext)getNativePointerValue(env, dstContext);
-    CUdeviceptr nativeSrcDevice = (CUdeviceptr)getPointer(env, srcDevice);
-    CUcontext nativeSrcContext = (CUcontext)getNativePointerValue(env, srcContext);
-    int result = cuMemcpyPeerAsync(nativeDstDevice, nativeDstContext, nativeSrcDevice, nativeSrcContext, (size_t)ByteCount, nativeHStream);
-    return result;
+    return nativeGraph->endCapture();
 }
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemAllocNative
- * Signature: (Ljcuda/driver/CUdeviceptr;J)I
+ * Method:    cuOpGraphLaunchNative
+ * Signature: (Ljcuda/driver/CUopGraph;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemAllocNative
-  (JNIEnv *env, jclass cls, jobject dptr, jlong bytesize)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOpGraphLaunchNative
+  (JNIEnv *env, jclass cls, jobject graph)
 {
-    if (dptr == NULL)
+    if (graph == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuMemAlloc");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'graph' is null for cuOpGraphLaunch");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemAlloc of %ld bytes\n", (long)bytesize);
+    Logger::log(LOG_TRACE, "Executing cuOpGraphLaunch\n");
 
-    CUdeviceptr nativeDptr;
-    int result = cuMemAlloc(&nativeDptr, (size_t)bytesize);
-    setPointer(env, dptr, (jlong)nativeDptr);
-    return result;
+    OperationGraph *nativeGraph = (OperationGraph*)getNativePointerValue(env, graph);
+    if (nativeGraph == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    return nativeGraph->launch();
 }
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemAllocPitchNative
- * Signature: (Ljcuda/driver/CUdeviceptr;[JJJI)I
+ * Method:    cuOpGraphGetOperationCountNative
+ * Signature: (Ljcuda/driver/CUopGraph;[I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemAllocPitchNative
-  (JNIEnv *env, jclass cls, jobject dptr, jlongArray pPitch, jlong WidthInBytes, jlong Height, jint ElementSizeBytes)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOpGraphGetOperationCountNative
+  (JNIEnv *env, jclass cls, jobject graph, jintArray count)
 {
-    if (dptr == NULL)
+    if (graph == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuMemAllocPitch");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'graph' is null for cuOpGraphGetOperationCount");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (pPitch == NULL)
+    if (count == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pPitch' is null for cuMemAllocPitch");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'count' is null for cuOpGraphGetOperationCount");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemAllocPitch\n");
-
-    CUdeviceptr nativeDptr;
-    size_t nativePPitch;
-
-    int result = cuMemAllocPitch(&nativeDptr, &nativePPitch, (size_t)WidthInBytes, (size_t)Height, (unsigned int)ElementSizeBytes);
+    Logger::log(LOG_TRACE, "Executing cuOpGraphGetOperationCount\n");
 
-    setPointer(env, dptr, (jlong)nativeDptr);
-    if (!set(env, pPitch, 0, nativePPitch)) return JCUDA_INTERNAL_ERROR;
-
-    return result;
+    OperationGraph *nativeGraph = (OperationGraph*)getNativePointerValue(env, graph);
+    if (nativeGraph == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    if (!set(env, count, 0, nativeGraph->getOperationCount())) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
 }
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemFreeNative
- * Signature: (Ljcuda/driver/CUdeviceptr;)I
+ * Method:    cuOpGraphSetKernelParamNative
+ * Signature: (Ljcuda/driver/CUopGraph;IILjcuda/Pointer;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemFreeNative
-  (JNIEnv *env, jclass cls, jobject dptr)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOpGraphSetKernelParamNative
+  (JNIEnv *env, jclass cls, jobject graph, jint operation, jint param, jobject value)
 {
-    if (dptr == NULL)
+    if (graph == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'graph' is null for cuOpGraphSetKernelParam");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (value == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'value' is null for cuOpGraphSetKernelParam");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuOpGraphSetKernelParam\n");
+
+    OperationGraph *nativeGraph = (OperationGraph*)getNativePointerValue(env, graph);
+    if (nativeGraph == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    size_t capturedSize = 0;
+    int result = nativeGraph->getKernelParamSize((int)operation, (int)param, &capturedSize);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    size_t size = 0;
+    if (!getKernelParamSize(env, value, &size) || size < capturedSize)
+    {
+        Logger::log(LOG_ERROR, "The new value of kernel parameter %d must have at least %d bytes\n", (int)param, (int)capturedSize);
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    PointerData *valuePointerData = initPointerData(env, value);
+    if (valuePointerData == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuMemFree");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemFree\n");
-
-    CUdeviceptr nativeDptr = (CUdeviceptr)getPointer(env, dptr);
-    int result = cuMemFree(nativeDptr);
+    result = nativeGraph->setKernelParam((int)operation, (int)param, valuePointerData->getPointer(env));
+    if (!releasePointerData(env, valuePointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
     return result;
 }
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemGetAddressRangeNative
- * Signature: (Ljcuda/driver/CUdeviceptr;[JLjcuda/driver/CUdeviceptr;)I
+ * Method:    cuOpGraphRebindAddressNative
+ * Signature: (Ljcuda/driver/CUopGraph;Ljcuda/driver/CUdeviceptr;JLjcuda/driver/CUdeviceptr;[I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemGetAddressRangeNative
-  (JNIEnv *env, jclass cls, jobject pbase, jlongArray psize, jobject dptr)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOpGraphRebindAddressNative
+  (JNIEnv *env, jclass cls, jobject graph, jobject oldAddress, jlong size, jobject newAddress, jintArray count)
 {
-    /* May be null
-    if (pbase == NULL)
+    if (graph == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pbase' is null for cuMemGetAddressRange");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'graph' is null for cuOpGraphRebindAddress");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (psize == NULL)
+    if (oldAddress == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'psize' is null for cuMemGetAddressRange");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'oldAddress' is null for cuOpGraphRebindAddress");
         return JCUDA_INTERNAL_ERROR;
     }
-    */
-    if (dptr == NULL)
+    if (newAddress == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuMemGetAddressRange");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'newAddress' is null for cuOpGraphRebindAddress");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemGetAddressRange\n");
-
-    CUdeviceptr nativeDptr = (CUdeviceptr)getPointer(env, dptr);
-
-    size_t nativePsize;
-    CUdeviceptr nativePbase;
-    int result = cuMemGetAddressRange(&nativePbase, &nativePsize, nativeDptr);
-
-    setPointer(env, pbase, nativePbase);
-    if (!set(env, psize, 0, nativePsize)) return JCUDA_INTERNAL_ERROR;
+    Logger::log(LOG_TRACE, "Executing cuOpGraphRebindAddress\n");
 
-    return result;
+    OperationGraph *nativeGraph = (OperationGraph*)getNativePointerValue(env, graph);
+    if (nativeGraph == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    CUdeviceptr nativeOldAddress = (CUdeviceptr)getPointer(env, oldAddress);
+    CUdeviceptr nativeNewAddress = (CUdeviceptr)getPointer(env, newAddress);
+    int nativeCount = nativeGraph->rebindAddress(nativeOldAddress, (size_t)size, nativeNewAddress);
+    if (count != NULL)
+    {
+        if (!set(env, count, 0, nativeCount)) return JCUDA_INTERNAL_ERROR;
+    }
+    return CUDA_SUCCESS;
 }
 
 
@@ -2956,225 +8928,404 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemGetAddressRangeNative
 
 
 
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemAllocHostNative
- * Signature: (Ljcuda/Pointer;J)I
+ * Method:    cuFuncGetAttributeNative
+ * Signature: ([IILjcuda/driver/CUfunction;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemAllocHostNative
-  (JNIEnv *env, jclass cls, jobject pp, jlong bytesize)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuFuncGetAttributeNative
+  (JNIEnv *env, jclass cls, jintArray pi, jint attrib, jobject func)
 {
-    if (pp == NULL)
+    if (pi == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pp' is null for cuMemAllocHost");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pi' is null for cuFuncGetAttribute");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemAllocHost of %ld bytes\n", (size_t)bytesize);
+    if (func == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'func' is null for cuFuncGetAttribute");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuFuncGetAttribute\n");
 
-    void *nativePp;
-    int result = cuMemAllocHost(&nativePp, (size_t)bytesize);
-    if (result == CUDA_SUCCESS)
+    int nativePi;
+    CUfunction nativeFunc = NULL;
+    int resolveResult = getNativeFunction(env, func, &nativeFunc);
+    if (resolveResult != CUDA_SUCCESS)
     {
-        jobject object = env->NewDirectByteBuffer(nativePp, bytesize);
-        env->SetObjectField(pp, Pointer_buffer, object);
-        env->SetObjectField(pp, Pointer_pointers, NULL);
-        env->SetLongField(pp, Pointer_byteOffset, 0);
-        env->SetLongField(pp, NativePointerObject_nativePointer, (jlong)nativePp);
+        return resolveResult;
     }
+    CUfunction_attribute nativeAttrib = (CUfunction_attribute)attrib;
+    int result = cuFuncGetAttribute(&nativePi, nativeAttrib, nativeFunc);
+    if (!set(env, pi, 0, nativePi)) return JCUDA_INTERNAL_ERROR;
     return result;
 }
 
 
+
+/**
+ * Writes the given OccupancyResult into the given CUoccupancy object
+ */
+void setCUoccupancy(JNIEnv *env, jobject occupancy, const OccupancyResult &result)
+{
+    env->SetIntField(occupancy, CUoccupancy_blockSize, result.blockSize);
+    env->SetIntField(occupancy, CUoccupancy_dynamicSharedMemBytes, result.dynamicSharedMemBytes);
+    env->SetIntField(occupancy, CUoccupancy_maxDynamicSharedMemBytes, result.maxDynamicSharedMemBytes);
+    env->SetIntField(occupancy, CUoccupancy_activeBlocksPerMultiprocessor, result.activeBlocksPerMultiProcessor);
+    env->SetIntField(occupancy, CUoccupancy_activeWarpsPerMultiprocessor, result.activeWarpsPerMultiProcessor);
+    env->SetFloatField(occupancy, CUoccupancy_occupancy, result.occupancy);
+    env->SetIntField(occupancy, CUoccupancy_limitingFactor, result.limitingFactor);
+    env->SetFloatField(occupancy, CUoccupancy_elapsedTime, result.elapsedTime);
+}
+
+/**
+ * Obtains the occupancy related properties of the given device and
+ * attributes of the given function
+ */
+int getOccupancyInput(CUfunction function, CUdevice device,
+    OccupancyDeviceProperties *properties, OccupancyFunctionAttributes *attributes)
+{
+    int result = Occupancy::getDeviceProperties(device, properties);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    return Occupancy::getFunctionAttributes(function, attributes);
+}
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemFreeHostNative
- * Signature: (Ljcuda/Pointer;)I
+ * Method:    cuOccupancyCalculateNative
+ * Signature: (Ljcuda/driver/CUoccupancy;Ljcuda/driver/CUfunction;Ljcuda/driver/CUdevice;II)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemFreeHostNative
-  (JNIEnv *env, jclass cls, jobject p)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOccupancyCalculateNative
+  (JNIEnv *env, jclass cls, jobject occupancy, jobject f, jobject dev, jint blockSize, jint dynamicSharedMemBytes)
 {
-    if (p == NULL)
+    if (occupancy == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'p' is null for cuMemFreeHost");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'occupancy' is null for cuOccupancyCalculate");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemFreeHost\n");
-
-    PointerData *pPointerData = initPointerData(env, p);
-    if (pPointerData == NULL)
+    if (f == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'f' is null for cuOccupancyCalculate");
         return JCUDA_INTERNAL_ERROR;
     }
-    int result = cuMemFreeHost((void*)pPointerData->getPointer(env));
-    if (!releasePointerData(env, pPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
-    return result;
-}
-
+    if (dev == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dev' is null for cuOccupancyCalculate");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuOccupancyCalculate\n");
 
+    CUfunction nativeF = NULL;
+    int resolveResult = getNativeFunction(env, f, &nativeF);
+    if (resolveResult != CUDA_SUCCESS)
+    {
+        return resolveResult;
+    }
+    CUdevice nativeDev = (CUdevice)(intptr_t)getNativePointerValue(env, dev);
 
+    OccupancyDeviceProperties properties;
+    OccupancyFunctionAttributes attributes;
+    int result = getOccupancyInput(nativeF, nativeDev, &properties, &attributes);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    OccupancyResult nativeOccupancy;
+    Occupancy::calculate(properties, attributes, (int)blockSize, (int)dynamicSharedMemBytes, &nativeOccupancy);
+    setCUoccupancy(env, occupancy, nativeOccupancy);
+    return CUDA_SUCCESS;
+}
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyHtoDNative
- * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/Pointer;J)I
+ * Method:    cuOccupancyRecommendNative
+ * Signature: (Ljcuda/driver/CUoccupancy;Ljcuda/driver/CUfunction;Ljcuda/driver/CUdevice;III)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyHtoDNative
-  (JNIEnv *env, jclass cls, jobject dstDevice, jobject srcHost, jlong ByteCount)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOccupancyRecommendNative
+  (JNIEnv *env, jclass cls, jobject occupancy, jobject f, jobject dev, jint dynamicSharedMemBytes, jint dynamicSharedMemBytesPerThread, jint blockSizeLimit)
 {
-    if (dstDevice == NULL)
+    if (occupancy == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyHtoD");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'occupancy' is null for cuOccupancyRecommend");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (srcHost == NULL)
+    if (f == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcHost' is null for cuMemcpyHtoD");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'f' is null for cuOccupancyRecommend");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemcpyHtoD of %d bytes\n", (size_t)ByteCount);
-
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
-    PointerData *srcHostPointerData = initPointerData(env, srcHost);
-    if (srcHostPointerData == NULL)
+    if (dev == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dev' is null for cuOccupancyRecommend");
         return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cuOccupancyRecommend\n");
 
-    int result = cuMemcpyHtoD(nativeDstDevice, (void*)srcHostPointerData->getPointer(env), (size_t)ByteCount);
-
-    if (!releasePointerData(env, srcHostPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    CUfunction nativeF = NULL;
+    int resolveResult = getNativeFunction(env, f, &nativeF);
+    if (resolveResult != CUDA_SUCCESS)
+    {
+        return resolveResult;
+    }
+    CUdevice nativeDev = (CUdevice)(intptr_t)getNativePointerValue(env, dev);
 
-    return result;
+    OccupancyDeviceProperties properties;
+    OccupancyFunctionAttributes attributes;
+    int result = getOccupancyInput(nativeF, nativeDev, &properties, &attributes);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    OccupancyResult nativeOccupancy;
+    Occupancy::recommend(properties, attributes, (int)dynamicSharedMemBytes,
+        (int)dynamicSharedMemBytesPerThread, (int)blockSizeLimit, &nativeOccupancy);
+    setCUoccupancy(env, occupancy, nativeOccupancy);
+    return CUDA_SUCCESS;
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyDtoHNative
- * Signature: (Ljcuda/Pointer;Ljcuda/driver/CUdeviceptr;J)I
+ * Method:    cuOccupancyAutotuneNative
+ * Signature: (Ljcuda/driver/CUoccupancy;Ljcuda/driver/CUfunction;Ljava/lang/String;JILjcuda/driver/CUstream;Ljcuda/Pointer;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDtoHNative
-  (JNIEnv *env, jclass cls, jobject dstHost, jobject srcDevice, jlong ByteCount)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOccupancyAutotuneNative
+  (JNIEnv *env, jclass cls, jobject occupancy, jobject f, jstring key, jlong threadCount, jint dynamicSharedMemBytes, jobject hStream, jobject kernelParams, jint iterations)
 {
-    if (dstHost == NULL)
+    if (occupancy == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstHost' is null for cuMemcpyDtoH");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'occupancy' is null for cuOccupancyAutotune");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (srcDevice == NULL)
+    if (f == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcDevice' is null for cuMemcpyDtoH");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'f' is null for cuOccupancyAutotune");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemcpyDtoH of %d bytes\n", (size_t)ByteCount);
+    if (key == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'key' is null for cuOccupancyAutotune");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuOccupancyAutotune\n");
 
+    CUfunction nativeF = NULL;
+    int resolveResult = getNativeFunction(env, f, &nativeF);
+    if (resolveResult != CUDA_SUCCESS)
+    {
+        return resolveResult;
+    }
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
 
-    PointerData *dstHostPointerData = initPointerData(env, dstHost);
-    if (dstHostPointerData == NULL)
+    // The timed launches have to be executed, so they can not be
+    // captured, and they have to see the pending symbol updates
+    if (OperationGraph::getCapturing() != NULL)
+    {
+        Logger::log(LOG_ERROR, "cuOccupancyAutotune may not be called while capturing\n");
+        return CUDA_ERROR_NOT_PERMITTED;
+    }
+    int flushResult = symbolStaging.flush(nativeHStream);
+    if (flushResult != CUDA_SUCCESS)
+    {
+        return flushResult;
+    }
+    char *nativeKey = convertString(env, key);
+    if (nativeKey == NULL)
     {
         return JCUDA_INTERNAL_ERROR;
     }
-    CUdeviceptr nativeSrcDevice = (CUdeviceptr)getPointer(env, srcDevice);
-	void *nativeDstHost = (void*)dstHostPointerData->getPointer(env);
 
-    int result = cuMemcpyDtoH(nativeDstHost, nativeSrcDevice, (size_t)ByteCount);
+    PointerData *kernelParamsPointerData = NULL;
+    void **nativeKernelParams = NULL;
+    if (kernelParams != NULL)
+    {
+        kernelParamsPointerData = initPointerData(env, kernelParams);
+        if (kernelParamsPointerData == NULL)
+        {
+            delete[] nativeKey;
+            return JCUDA_INTERNAL_ERROR;
+        }
+        nativeKernelParams = (void**)kernelParamsPointerData->getPointer(env);
+    }
 
-    if (!releasePointerData(env, dstHostPointerData, 0)) return JCUDA_INTERNAL_ERROR;
+    OccupancyResult nativeOccupancy;
+    int result = Occupancy::autotune(nativeF, nativeKey, (size_t)threadCount,
+        (int)dynamicSharedMemBytes, nativeHStream, nativeKernelParams,
+        (int)iterations, &nativeOccupancy);
+    delete[] nativeKey;
 
+    if (!releasePointerData(env, kernelParamsPointerData, 0)) return JCUDA_INTERNAL_ERROR;
+    if (result == CUDA_SUCCESS)
+    {
+        setCUoccupancy(env, occupancy, nativeOccupancy);
+    }
     return result;
 }
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuOccupancySetCacheFileNative
+ * Signature: (Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOccupancySetCacheFileNative
+  (JNIEnv *env, jclass cls, jstring fileName)
+{
+    Logger::log(LOG_TRACE, "Executing cuOccupancySetCacheFile\n");
+
+    if (fileName == NULL)
+    {
+        Occupancy::setCacheFile(NULL);
+        return CUDA_SUCCESS;
+    }
+    char *nativeFileName = convertString(env, fileName);
+    if (nativeFileName == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    bool valid = Occupancy::setCacheFile(nativeFileName);
+    delete[] nativeFileName;
+    return valid ? CUDA_SUCCESS : CUDA_ERROR_INVALID_VALUE;
+}
 
 
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyDtoDNative
- * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUdeviceptr;J)I
+ * Method:    cuFuncSetBlockShapeNative
+ * Signature: (Ljcuda/driver/CUfunction;III)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDtoDNative
-  (JNIEnv *env, jclass cls, jobject dstDevice, jobject srcDevice, jlong ByteCount)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuFuncSetBlockShapeNative
+  (JNIEnv *env, jclass cls, jobject hfunc, jint x, jint y, jint z)
 {
-    if (dstDevice == NULL)
+    if (hfunc == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyDtoD");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuFuncSetBlockShape");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (srcDevice == NULL)
+    Logger::log(LOG_TRACE, "Executing cuFuncSetBlockShape (%d,%d,%d)\n", (int)x, (int)y, (int)z);
+
+    CUfunction nativeHfunc = NULL;
+    int resolveResult = getNativeFunction(env, hfunc, &nativeHfunc);
+    if (resolveResult != CUDA_SUCCESS)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcDevice' is null for cuMemcpyDtoD");
-        return JCUDA_INTERNAL_ERROR;
+        return resolveResult;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemcpyDtoD of %d bytes\n", (size_t)ByteCount);
+    int result = cuFuncSetBlockShape(nativeHfunc, (int)x, (int)y, (int)z);
+    return result;
+}
 
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
-    CUdeviceptr nativeSrcDevice = (CUdeviceptr)getPointer(env, srcDevice);
 
-    int result = cuMemcpyDtoD(nativeDstDevice, nativeSrcDevice, (size_t)ByteCount);
 
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuFuncSetSharedSizeNative
+ * Signature: (Ljcuda/driver/CUfunction;I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuFuncSetSharedSizeNative
+  (JNIEnv *env, jclass cls, jobject hfunc, jint bytes)
+{
+    if (hfunc == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuFuncSetSharedSize");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuFuncSetSharedSize to %d bytes\n", (unsigned int)bytes);
+
+    CUfunction nativeHfunc = NULL;
+    int resolveResult = getNativeFunction(env, hfunc, &nativeHfunc);
+    if (resolveResult != CUDA_SUCCESS)
+    {
+        return resolveResult;
+    }
+    int result = cuFuncSetSharedSize(nativeHfunc, (unsigned int)bytes);
     return result;
 }
 
 
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuFuncSetCacheConfigNative
+ * Signature: (Ljcuda/driver/CUfunction;I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuFuncSetCacheConfigNative
+  (JNIEnv *env, jclass cls, jobject hfunc, jint config)
+{
+    if (hfunc == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuFuncSetCacheConfig");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuFuncSetCacheConfig\n");
+
+    CUfunction nativeHfunc = NULL;
+    int resolveResult = getNativeFunction(env, hfunc, &nativeHfunc);
+    if (resolveResult != CUDA_SUCCESS)
+    {
+        return resolveResult;
+    }
+    int result = cuFuncSetCacheConfig(nativeHfunc, (CUfunc_cache)config);
+    return result;
+}
+
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyDtoANative
- * Signature: (Ljcuda/driver/CUarray;JLjcuda/driver/CUdeviceptr;J)I
+ * Method:    cuFuncSetSharedMemConfigNative
+ * Signature: (Ljcuda/driver/CUfunction;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDtoANative
-  (JNIEnv *env, jclass cls, jobject dstArray, jlong dstIndex, jobject srcDevice, jlong ByteCount)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuFuncSetSharedMemConfigNative
+  (JNIEnv *env, jclass cls, jobject hfunc, jint config)
 {
-    if (dstArray == NULL)
+    if (hfunc == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstArray' is null for cuMemcpyDtoA");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuFuncSetSharedMemConfig");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (srcDevice == NULL)
+    Logger::log(LOG_TRACE, "Executing cuFuncSetSharedMemConfig\n");
+
+    CUfunction nativeHfunc = NULL;
+    int resolveResult = getNativeFunction(env, hfunc, &nativeHfunc);
+    if (resolveResult != CUDA_SUCCESS)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcDevice' is null for cuMemcpyDtoA");
-        return JCUDA_INTERNAL_ERROR;
+        return resolveResult;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemcpyDtoA of %d bytes\n", (size_t)ByteCount);
-
-    CUarray nativeDstArray = (CUarray)getNativePointerValue(env, dstArray);
-    CUdeviceptr nativeSrcDevice = (CUdeviceptr)getPointer(env, srcDevice);
-
-    int result = cuMemcpyDtoA(nativeDstArray, (size_t)dstIndex, nativeSrcDevice, (size_t)ByteCount);
 
+    int result = cuFuncSetSharedMemConfig(nativeHfunc, (CUsharedconfig)config);
     return result;
 }
 
 
 
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyAtoDNative
- * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUarray;JJ)I
+ * Method:    cuArrayCreateNative
+ * Signature: (Ljcuda/driver/CUarray;Ljcuda/driver/CUDA_ARRAY_DESCRIPTOR;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAtoDNative
-  (JNIEnv *env, jclass cls, jobject dstDevice, jobject hSrc, jlong SrcIndex, jlong ByteCount)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuArrayCreateNative
+  (JNIEnv *env, jclass cls, jobject pHandle, jobject pAllocateArray)
 {
-    if (dstDevice == NULL)
+    if (pHandle == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyAtoD");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pHandle' is null for cuArrayCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hSrc == NULL)
+    if (pAllocateArray == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hSrc' is null for cuMemcpyAtoD");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pAllocateArray' is null for cuArrayCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemcpyAtoD of %d bytes\n", (size_t)ByteCount);
+    Logger::log(LOG_TRACE, "Executing cuArrayCreate\n");
 
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
-    CUarray nativeHSrc = (CUarray)getNativePointerValue(env, hSrc);
+    CUarray nativePHandle;
+    CUDA_ARRAY_DESCRIPTOR nativePAllocateArray = getCUDA_ARRAY_DESCRIPTOR(env, pAllocateArray);
 
-    int result = cuMemcpyAtoD(nativeDstDevice, nativeHSrc, (size_t)SrcIndex, (size_t)ByteCount);
+    int result = cuArrayCreate(&nativePHandle, &nativePAllocateArray);
+    setNativePointerValue(env, pHandle, (jlong)nativePHandle);
 
     return result;
 }
@@ -3184,35 +9335,30 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAtoDNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyHtoANative
- * Signature: (Ljcuda/driver/CUarray;JLjcuda/Pointer;J)I
+ * Method:    cuArrayGetDescriptorNative
+ * Signature: (Ljcuda/driver/CUDA_ARRAY_DESCRIPTOR;Ljcuda/driver/CUarray;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyHtoANative
-  (JNIEnv *env, jclass cls, jobject dstArray, jlong dstIndex, jobject pSrc, jlong ByteCount)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuArrayGetDescriptorNative
+  (JNIEnv *env, jclass cls, jobject pArrayDescriptor, jobject hArray)
 {
-    if (dstArray == NULL)
+    if (pArrayDescriptor == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstArray' is null for cuMemcpyHtoA");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pArrayDescriptor' is null for cuArrayGetDescriptor");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (pSrc == NULL)
+    if (hArray == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pSrc' is null for cuMemcpyHtoA");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hArray' is null for cuArrayGetDescriptor");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemcpyHtoA of %d bytes\n", (size_t)ByteCount);
-
-    CUarray nativeDstArray = (CUarray)getNativePointerValue(env, dstArray);
+    Logger::log(LOG_TRACE, "Executing cuArrayGetDescriptor\n");
 
-    PointerData *pSrcPointerData = initPointerData(env, pSrc);
-    if (pSrcPointerData == NULL)
-    {
-        return JCUDA_INTERNAL_ERROR;
-    }
+    CUDA_ARRAY_DESCRIPTOR nativePArrayDescriptor;
+    CUarray nativeHArray = (CUarray)getNativePointerValue(env, hArray);
 
-    int result = cuMemcpyHtoA(nativeDstArray, (size_t)dstIndex, (void*)pSrcPointerData->getPointer(env), (size_t)ByteCount);
+    int result = cuArrayGetDescriptor(&nativePArrayDescriptor, nativeHArray);
 
-    if (!releasePointerData(env, pSrcPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    setCUDA_ARRAY_DESCRIPTOR(env, pArrayDescriptor, nativePArrayDescriptor);
 
     return result;
 }
@@ -3220,38 +9366,23 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyHtoANative
 
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyAtoHNative
- * Signature: (Ljcuda/Pointer;Ljcuda/driver/CUarray;JJ)I
+ * Method:    cuArrayDestroyNative
+ * Signature: (Ljcuda/driver/CUarray;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAtoHNative
-  (JNIEnv *env, jclass cls, jobject dstHost, jobject srcArray, jlong srcIndex, jlong ByteCount)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuArrayDestroyNative
+  (JNIEnv *env, jclass cls, jobject hArray)
 {
-    if (dstHost == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstHost' is null for cuMemcpyAtoH");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (srcArray == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcArray' is null for cuMemcpyAtoH");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    Logger::log(LOG_TRACE, "Executing cuMemcpyAtoH of %d bytes\n", (size_t)ByteCount);
-
-    PointerData *dstHostPointerData = initPointerData(env, dstHost);
-    if (dstHostPointerData == NULL)
+    if (hArray == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hArray' is null for cuArrayDestroy");
         return JCUDA_INTERNAL_ERROR;
     }
-    CUarray nativeSrcArray = (CUarray)getNativePointerValue(env, srcArray);
-
-    int result = cuMemcpyAtoH((void*)dstHostPointerData->getPointer(env), nativeSrcArray, (size_t)srcIndex, (size_t)ByteCount);
+    Logger::log(LOG_TRACE, "Executing cuArrayDestroy\n");
 
-    if (!releasePointerData(env, dstHostPointerData)) return JCUDA_INTERNAL_ERROR;
+    CUarray nativeHArray = (CUarray)getNativePointerValue(env, hArray);
+    int result = cuArrayDestroy(nativeHArray);
     return result;
 }
 
@@ -3260,375 +9391,338 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAtoHNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyAtoANative
- * Signature: (Ljcuda/driver/CUarray;JLjcuda/driver/CUarray;JJ)I
+ * Method:    cuArray3DCreateNative
+ * Signature: (Ljcuda/driver/CUarray;Ljcuda/driver/CUDA_ARRAY3D_DESCRIPTOR;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAtoANative
-  (JNIEnv *env, jclass cls, jobject dstArray, jlong dstIndex, jobject srcArray, jlong srcIndex, jlong ByteCount)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuArray3DCreateNative
+  (JNIEnv *env, jclass cls, jobject pHandle, jobject pAllocateArray)
 {
-    if (dstArray == NULL)
+    if (pHandle == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstArray' is null for cuMemcpyAtoA");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pHandle' is null for cuArray3DCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (srcArray == NULL)
+    if (pAllocateArray == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcArray' is null for cuMemcpyAtoA");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pAllocateArray' is null for cuArray3DCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemcpyAtoA of %d bytes\n", (size_t)ByteCount);
+    Logger::log(LOG_TRACE, "Executing cuArray3DCreate\n");
 
-    CUarray nativeDstArray = (CUarray)getNativePointerValue(env, dstArray);
-    CUarray nativeSrcArray = (CUarray)getNativePointerValue(env, srcArray);
+    CUarray nativePHandle;
+    CUDA_ARRAY3D_DESCRIPTOR nativePAllocateArray = getCUDA_ARRAY3D_DESCRIPTOR(env, pAllocateArray);
+
+    int result = cuArray3DCreate(&nativePHandle, &nativePAllocateArray);
+    setNativePointerValue(env, pHandle, (jlong)nativePHandle);
 
-    int result = cuMemcpyAtoA(nativeDstArray, (size_t)dstIndex, nativeSrcArray, (size_t)srcIndex, (size_t)ByteCount);
     return result;
 }
 
 
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpy2DNative
- * Signature: (Ljcuda/driver/CUDA_MEMCPY2D;)I
+ * Method:    cuArray3DGetDescriptorNative
+ * Signature: (Ljcuda/driver/CUDA_ARRAY3D_DESCRIPTOR;Ljcuda/driver/CUarray;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy2DNative
-  (JNIEnv *env, jclass cls, jobject pCopy)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuArray3DGetDescriptorNative
+  (JNIEnv *env, jclass cls, jobject pArrayDescriptor, jobject hArray)
 {
-    if (pCopy == NULL)
+    if (pArrayDescriptor == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy2D");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pArrayDescriptor' is null for cuArray3DGetDescriptor");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemcpy2D\n");
-
-    Memcpy2DData *memcpyData = initMemcpy2DData(env, pCopy);
-    if (memcpyData == NULL)
+    if (hArray == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hArray' is null for cuArray3DGetDescriptor");
         return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cuArray3DGetDescriptor\n");
+
+    CUDA_ARRAY3D_DESCRIPTOR nativePArrayDescriptor;
+    CUarray nativeHArray = (CUarray)getNativePointerValue(env, hArray);
 
-    int result = cuMemcpy2D(&memcpyData->memcpy2d);
+    int result = cuArray3DGetDescriptor(&nativePArrayDescriptor, nativeHArray);
 
-    if (!releaseMemcpy2DData(env, memcpyData)) return JCUDA_INTERNAL_ERROR;
+    setCUDA_ARRAY3D_DESCRIPTOR(env, pArrayDescriptor, nativePArrayDescriptor);
 
     return result;
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpy2DUnalignedNative
- * Signature: (Ljcuda/driver/CUDA_MEMCPY2D;)I
+ * Method:    cuMipmappedArrayCreateNative
+ * Signature: (Ljcuda/driver/CUmipmappedArray;Ljcuda/driver/CUDA_ARRAY3D_DESCRIPTOR;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy2DUnalignedNative
-  (JNIEnv *env, jclass cls, jobject pCopy)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMipmappedArrayCreateNative
+  (JNIEnv *env, jclass cls, jobject pHandle, jobject pMipmappedArrayDesc, jint numMipmapLevels)
 {
-    if (pCopy == NULL)
+    if (pHandle == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy2DUnaligned");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pHandle' is null for cuMipmappedArrayCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemcpy2DUnaligned\n");
-
-    Memcpy2DData *memcpyData = initMemcpy2DData(env, pCopy);
-    if (memcpyData == NULL)
+    if (pMipmappedArrayDesc == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pMipmappedArrayDesc' is null for cuMipmappedArrayCreate");
         return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cuMipmappedArrayCreate\n");
 
-    int result = cuMemcpy2DUnaligned(&memcpyData->memcpy2d);
+	CUmipmappedArray nativePHandle;
 
-    if (!releaseMemcpy2DData(env, memcpyData)) return JCUDA_INTERNAL_ERROR;
+	CUDA_ARRAY3D_DESCRIPTOR nativePMipmappedArrayDesc = getCUDA_ARRAY3D_DESCRIPTOR(env, pMipmappedArrayDesc);
+	int result = cuMipmappedArrayCreate(&nativePHandle, &nativePMipmappedArrayDesc, (unsigned int)numMipmapLevels);
 
-    return result;
+	setNativePointerValue(env, pHandle, (jlong)nativePHandle);
+	return result;
 }
 
 
-
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpy3DNative
- * Signature: (Ljcuda/driver/CUDA_MEMCPY3D;)I
+ * Method:    cuMipmappedArrayGetLevelNative
+ * Signature: (Ljcuda/driver/CUarray;Ljcuda/driver/CUmipmappedArray;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DNative
-  (JNIEnv *env, jclass cls, jobject pCopy)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMipmappedArrayGetLevelNative
+  (JNIEnv *env, jclass cls, jobject pLevelArray, jobject hMipmappedArray, jint level)
 {
-    if (pCopy == NULL)
+    if (pLevelArray == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy3D");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pLevelArray' is null for cuMipmappedArrayGetLevel");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemcpy3D\n");
-
-    Memcpy3DData *memcpyData = initMemcpy3DData(env, pCopy);
-    if (memcpyData == NULL)
+    if (hMipmappedArray == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hMipmappedArray' is null for cuMipmappedArrayGetLevel");
         return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cuMipmappedArrayGetLevel\n");
 
-    /*
-    Logger::log(LOG_DEBUGTRACE, "Source X in bytes %d\n", memcpyData.memcpy3d.srcXInBytes);
-    Logger::log(LOG_DEBUGTRACE, "Source Y %d\n", memcpyData.memcpy3d.srcY);
-    Logger::log(LOG_DEBUGTRACE, "Source Z %d\n", memcpyData.memcpy3d.srcZ);
-    Logger::log(LOG_DEBUGTRACE, "Source LOD %d\n", memcpyData.memcpy3d.srcLOD);
-    Logger::log(LOG_DEBUGTRACE, "Source memory type %d\n", memcpyData.memcpy3d.srcMemoryType);
-    Logger::log(LOG_DEBUGTRACE, "Source host pointer %p\n", memcpyData.memcpy3d.srcHost);
-    Logger::log(LOG_DEBUGTRACE, "Source device pointer %p\n", memcpyData.memcpy3d.srcDevice);
-    Logger::log(LOG_DEBUGTRACE, "Source array reference %p\n", memcpyData.memcpy3d.srcArray);
-    Logger::log(LOG_DEBUGTRACE, "Source pitch %d\n", memcpyData.memcpy3d.srcPitch);
-    Logger::log(LOG_DEBUGTRACE, "Source height %d\n", memcpyData.memcpy3d.srcHeight);
-    Logger::log(LOG_DEBUGTRACE, "Destination X in bytes %d\n", memcpyData.memcpy3d.dstXInBytes);
-    Logger::log(LOG_DEBUGTRACE, "Destination Y %d\n", memcpyData.memcpy3d.dstY);
-    Logger::log(LOG_DEBUGTRACE, "Destination Z %d\n", memcpyData.memcpy3d.dstZ);
-    Logger::log(LOG_DEBUGTRACE, "Destination LOD %d\n", memcpyData.memcpy3d.dstLOD);
-    Logger::log(LOG_DEBUGTRACE, "Destination memory type %d\n", memcpyData.memcpy3d.dstMemoryType);
-    Logger::log(LOG_DEBUGTRACE, "Destination host pointer %p\n", memcpyData.memcpy3d.dstHost);
-    Logger::log(LOG_DEBUGTRACE, "Destination device pointer %p\n", memcpyData.memcpy3d.dstDevice);
-    Logger::log(LOG_DEBUGTRACE, "Destination array reference %p\n", memcpyData.memcpy3d.dstArray);
-    Logger::log(LOG_DEBUGTRACE, "Destination pitch  %d\n", memcpyData.memcpy3d.dstPitch);
-    Logger::log(LOG_DEBUGTRACE, "Destination height %d\n", memcpyData.memcpy3d.dstHeight);
-    Logger::log(LOG_DEBUGTRACE, "Width of 3D memory copy in bytes %d\n", memcpyData.memcpy3d.WidthInBytes);
-    Logger::log(LOG_DEBUGTRACE, "Height of 3D memory copy %d\n", memcpyData.memcpy3d.Height);
-    Logger::log(LOG_DEBUGTRACE, "Depth of 3D memory copy %d\n", memcpyData.memcpy3d.Depth);
-    */
+	CUarray nativePLevelArray;
+	CUmipmappedArray nativeHMipmappedArray = (CUmipmappedArray)getNativePointerValue(env, hMipmappedArray);
+	int result = cuMipmappedArrayGetLevel(&nativePLevelArray, nativeHMipmappedArray, (unsigned int)level);
 
-    int result = cuMemcpy3D(&memcpyData->memcpy3d);
+	setNativePointerValue(env, pLevelArray, (jlong)nativePLevelArray);
+	return result;
+}
 
-    if (!releaseMemcpy3DData(env, memcpyData)) return JCUDA_INTERNAL_ERROR;
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMipmappedArrayDestroyNative
+ * Signature: (Ljcuda/driver/CUmipmappedArray;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMipmappedArrayDestroyNative
+  (JNIEnv *env, jclass cls, jobject hMipmappedArray)
+{
+    if (hMipmappedArray == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hMipmappedArray' is null for cuMipmappedArrayDestroy");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMipmappedArrayGetLevel\n");
 
-    return result;
+	CUmipmappedArray nativeHMipmappedArray = (CUmipmappedArray)getNativePointerValue(env, hMipmappedArray);
+	int result = cuMipmappedArrayDestroy(nativeHMipmappedArray);
+	return result;
 }
 
 
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpy3DPeerNative
- * Signature: (Ljcuda/driver/CUDA_MEMCPY3D_PEER;)I
+ * Method:    cuTexRefCreateNative
+ * Signature: (Ljcuda/driver/CUtexref;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DPeerNative
-  (JNIEnv *env, jclass cls, jobject pCopy)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefCreateNative
+  (JNIEnv *env, jclass cls, jobject pTexRef)
 {
-    if (pCopy == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy3DPeer");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    Logger::log(LOG_TRACE, "Executing cuMemcpy3DPeer\n");
-
-    Memcpy3DPeerData *memcpyData = initMemcpy3DPeerData(env, pCopy);
-    if (memcpyData == NULL)
+    if (pTexRef == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pTexRef' is null for cuTexRefCreate");
         return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cuTexRefCreate\n");
 
-    int result = cuMemcpy3DPeer(&memcpyData->memcpy3d);
-
-    if (!releaseMemcpy3DPeerData(env, memcpyData)) return JCUDA_INTERNAL_ERROR;
-
+    CUtexref nativePTexRef;
+    int result = cuTexRefCreate(&nativePTexRef);
+    setNativePointerValue(env, pTexRef, (jlong)nativePTexRef);
     return result;
 }
 
 
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpy3DPeerAsyncNative
- * Signature: (Ljcuda/driver/CUDA_MEMCPY3D_PEER;Ljcuda/driver/CUstream;)I
+ * Method:    cuTexRefDestroyNative
+ * Signature: (Ljcuda/driver/CUtexref;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DPeerAsyncNative
-  (JNIEnv *env, jclass cls, jobject pCopy, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefDestroyNative
+  (JNIEnv *env, jclass cls, jobject hTexRef)
 {
-    if (pCopy == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy3DPeerAsync");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    Logger::log(LOG_TRACE, "Executing cuMemcpy3DPeerAsync\n");
-
-    Memcpy3DPeerData *memcpyData = initMemcpy3DPeerData(env, pCopy);
-    if (memcpyData == NULL)
+    if (hTexRef == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefDestroy");
         return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cuTexRefDestroy\n");
 
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
-
-    int result = cuMemcpy3DPeerAsync(&memcpyData->memcpy3d, nativeHStream);
-
-    if (!releaseMemcpy3DPeerData(env, memcpyData)) return JCUDA_INTERNAL_ERROR;
-
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+    int result = cuTexRefDestroy(nativeHTexRef);
     return result;
 }
 
 
 
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyHtoDAsyncNative
- * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/Pointer;JLjcuda/driver/CUstream;)I
+ * Method:    cuTexRefSetArrayNative
+ * Signature: (Ljcuda/driver/CUtexref;Ljcuda/driver/CUarray;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyHtoDAsyncNative
-  (JNIEnv *env, jclass cls, jobject dstDevice, jobject srcHost, jlong ByteCount, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetArrayNative
+  (JNIEnv *env, jclass cls, jobject hTexRef, jobject hArray, jint Flags)
 {
-    if (dstDevice == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyHtoDAsync");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (srcHost == NULL)
+    if (hTexRef == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcHost' is null for cuMemcpyHtoDAsync");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetArray");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemcpyHtoDAsync of %d bytes\n", (size_t)ByteCount);
-
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
-    PointerData *srcHostPointerData = initPointerData(env, srcHost);
-    if (srcHostPointerData == NULL)
+    if (hArray == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hArray' is null for cuTexRefSetArray");
         return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cuTexRefSetArray\n");
 
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
-
-    int result = cuMemcpyHtoDAsync(nativeDstDevice, (void*)srcHostPointerData->getPointer(env), (size_t)ByteCount, nativeHStream);
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+    CUarray nativeHArray = (CUarray)getNativePointerValue(env, hArray);
 
-    if (!releasePointerData(env, srcHostPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    int result = cuTexRefSetArray(nativeHTexRef, nativeHArray, (unsigned int)Flags);
     return result;
 }
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyDtoHAsyncNative
- * Signature: (Ljcuda/Pointer;Ljcuda/driver/CUdeviceptr;JLjcuda/driver/CUstream;)I
+ * Method:    cuTexRefSetMipmappedArrayNative
+ * Signature: (Ljcuda/driver/CUtexref;Ljcuda/driver/CUmipmappedArray;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDtoHAsyncNative
-  (JNIEnv *env, jclass cls, jobject dstHost, jobject srcDevice, jlong ByteCount, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetMipmappedArrayNative
+  (JNIEnv *env, jclass cls, jobject hTexRef, jobject hMipmappedArray, jint Flags)
 {
-    if (dstHost == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstHost' is null for cuMemcpyDtoHAsync");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (srcDevice == NULL)
+    if (hTexRef == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcDevice' is null for cuMemcpyDtoHAsync");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetMipmappedArray");
         return JCUDA_INTERNAL_ERROR;
     }
-    /* May be null
-    if (hStream == NULL)
+    if (hMipmappedArray == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuMemcpyDtoHAsync");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hMipmappedArray' is null for cuTexRefSetMipmappedArray");
         return JCUDA_INTERNAL_ERROR;
     }
-    */
-    Logger::log(LOG_TRACE, "Executing cuMemcpyDtoHAsync of %d bytes\n", (size_t)ByteCount);
+    Logger::log(LOG_TRACE, "Executing cuTexRefSetMipmappedArray\n");
 
-    PointerData *dstHostPointerData = initPointerData(env, dstHost);
-    if (dstHostPointerData == NULL)
-    {
-        return JCUDA_INTERNAL_ERROR;
-    }
-    CUdeviceptr nativeSrcDevice = (CUdeviceptr)getPointer(env, srcDevice);
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+	CUmipmappedArray nativeHMipmappedArray = (CUmipmappedArray)getNativePointerValue(env, hMipmappedArray);
+	int result = cuTexRefSetMipmappedArray(nativeHTexRef, nativeHMipmappedArray, (unsigned int)Flags);
+	return result;
 
-    int result = cuMemcpyDtoHAsync((void*)dstHostPointerData->getPointer(env), nativeSrcDevice, (size_t)ByteCount, nativeHStream);
+}
 
-    if (!releasePointerData(env, dstHostPointerData)) return JCUDA_INTERNAL_ERROR;
 
-    return result;
-}
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyDtoDAsyncNative
- * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUdeviceptr;JLjcuda/driver/CUstream;)I
+ * Method:    cuTexRefSetAddressNative
+ * Signature: ([JLjcuda/driver/CUtexref;Ljcuda/driver/CUdeviceptr;J)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDtoDAsyncNative
-  (JNIEnv *env, jclass cls, jobject dstDevice, jobject srcDevice, jlong ByteCount, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetAddressNative
+  (JNIEnv *env, jclass cls, jlongArray ByteOffset, jobject hTexRef, jobject dptr, jlong bytes)
 {
-    if (dstDevice == NULL)
+    if (ByteOffset == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemcpyDtoDAsync");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ByteOffset' is null for cuTexRefSetAddress");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (srcDevice == NULL)
+    if (hTexRef == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcDevice' is null for cuMemcpyDtoDAsync");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetAddress");
         return JCUDA_INTERNAL_ERROR;
     }
-    /* May be null
-    if (hStream == NULL)
+    if (dptr == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuMemcpyDtoDAsync");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuTexRefSetAddress");
         return JCUDA_INTERNAL_ERROR;
     }
-    */
-    Logger::log(LOG_TRACE, "Executing cuMemcpyDtoDAsync of %d bytes\n", (size_t)ByteCount);
+    Logger::log(LOG_TRACE, "Executing cuTexRefSetAddress\n");
 
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
-    CUdeviceptr nativeSrcDevice = (CUdeviceptr)getPointer(env, srcDevice);
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    size_t nativeByteOffset = 0;
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
 
-    int result = cuMemcpyDtoDAsync(nativeDstDevice, nativeSrcDevice, (size_t)ByteCount, nativeHStream);
+    CUdeviceptr nativeDptr = (CUdeviceptr)getPointer(env, dptr);
+    int result = cuTexRefSetAddress(&nativeByteOffset, nativeHTexRef, nativeDptr, (size_t)bytes);
 
+    if (!set(env, ByteOffset, 0, nativeByteOffset)) return JCUDA_INTERNAL_ERROR;
     return result;
 }
 
 
 
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyHtoAAsyncNative
- * Signature: (Ljcuda/driver/CUarray;JLjcuda/Pointer;JLjcuda/driver/CUstream;)I
+ * Method:    cuTexRefSetFormatNative
+ * Signature: (Ljcuda/driver/CUtexref;II)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyHtoAAsyncNative
-  (JNIEnv *env, jclass cls, jobject dstArray, jlong dstIndex, jobject pSrc, jlong ByteCount, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetFormatNative
+  (JNIEnv *env, jclass cls, jobject hTexRef, jint fmt, jint NumPackedComponents)
 {
-    if (dstArray == NULL)
+    if (hTexRef == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstArray' is null for cuMemcpyHtoAAsync");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetFormat");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (pSrc == NULL)
+    Logger::log(LOG_TRACE, "Executing cuTexRefSetFormat\n");
+
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+    int result = cuTexRefSetFormat(nativeHTexRef, (CUarray_format)fmt, (int)NumPackedComponents);
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTexRefSetAddress2DNative
+ * Signature: (Ljcuda/driver/CUtexref;Ljcuda/driver/CUDA_ARRAY_DESCRIPTOR;Ljcuda/driver/CUdeviceptr;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetAddress2DNative
+  (JNIEnv *env, jclass cls, jobject hTexRef, jobject desc, jobject dptr, jlong PitchInBytes)
+{
+    if (hTexRef == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pSrc' is null for cuMemcpyHtoAAsync");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetAddress2D");
         return JCUDA_INTERNAL_ERROR;
     }
-    /* May be null
-    if (hStream == NULL)
+    if (desc == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuMemcpyHtoAAsync");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'desc' is null for cuTexRefSetAddress2D");
         return JCUDA_INTERNAL_ERROR;
     }
-    */
-    Logger::log(LOG_TRACE, "Executing cuMemcpyHtoAAsync of %d bytes\n", (size_t)ByteCount);
-
-    CUarray nativeDstArray = (CUarray)getNativePointerValue(env, dstArray);
-
-    PointerData *pSrcPointerData = initPointerData(env, pSrc);
-    if (pSrcPointerData == NULL)
+    if (dptr == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuTexRefSetAddress2D");
         return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cuTexRefSetAddress2D\n");
 
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
-
-    int result = cuMemcpyHtoAAsync(nativeDstArray, (size_t)dstIndex, (void*)pSrcPointerData->getPointer(env), (size_t)ByteCount, nativeHStream);
-
-    if (!releasePointerData(env, pSrcPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+    CUDA_ARRAY_DESCRIPTOR nativeDesc = getCUDA_ARRAY_DESCRIPTOR(env, desc);
+    CUdeviceptr nativeDptr = (CUdeviceptr)getPointer(env, dptr);
+    int result = cuTexRefSetAddress2D(nativeHTexRef, &nativeDesc, nativeDptr, (size_t)PitchInBytes);
     return result;
 }
 
@@ -3637,44 +9731,21 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyHtoAAsyncNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyAtoHAsyncNative
- * Signature: (Ljcuda/Pointer;Ljcuda/driver/CUarray;JJLjcuda/driver/CUstream;)I
+ * Method:    cuTexRefSetAddressModeNative
+ * Signature: (Ljcuda/driver/CUtexref;II)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAtoHAsyncNative
-  (JNIEnv *env, jclass cls, jobject dstHost, jobject srcArray, jlong srcIndex, jlong ByteCount, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetAddressModeNative
+  (JNIEnv *env, jclass cls, jobject hTexRef, jint dim, jint am)
 {
-    if (dstHost == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstHost' is null for cuMemcpyAtoHAsync");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (srcArray == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'srcArray' is null for cuMemcpyAtoHAsync");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    /* May be null
-    if (hStream == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuMemcpyAtoHAsync");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    */
-    Logger::log(LOG_TRACE, "Executing cuMemcpyAtoH ofAsync %d bytes\n", (size_t)ByteCount);
-
-    PointerData *dstPointerData = initPointerData(env, dstHost);
-    if (dstPointerData == NULL)
+    if (hTexRef == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetAddressMode");
         return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cuTexRefSetAddressMode\n");
 
-    CUarray nativeSrcArray = (CUarray)getNativePointerValue(env, srcArray);
-
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
-
-    int result = cuMemcpyAtoHAsync((void*)dstPointerData->getPointer(env), nativeSrcArray, (size_t)srcIndex, (size_t)ByteCount, nativeHStream);
-
-    if (!releasePointerData(env, dstPointerData)) return JCUDA_INTERNAL_ERROR;
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+    int result = cuTexRefSetAddressMode(nativeHTexRef, (int)dim, (CUaddress_mode)am);
     return result;
 }
 
@@ -3683,129 +9754,103 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAtoHAsyncNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpy2DAsyncNative
- * Signature: (Ljcuda/driver/CUDA_MEMCPY2D;Ljcuda/driver/CUstream;)I
+ * Method:    cuTexRefSetFilterModeNative
+ * Signature: (Ljcuda/driver/CUtexref;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy2DAsyncNative
-  (JNIEnv *env, jclass cls, jobject pCopy, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetFilterModeNative
+  (JNIEnv *env, jclass cls, jobject hTexRef, jint fm)
 {
-    if (pCopy == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy2DAsync");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    /* May be null
-    if (hStream == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuMemcpy2DAsync");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    */
-    Logger::log(LOG_TRACE, "Executing cuMemcpy2DAsync\n");
-
-    Memcpy2DData *memcpyData = initMemcpy2DData(env, pCopy);
-    if (memcpyData == NULL)
+    if (hTexRef == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetFilterMode");
         return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cuTexRefSetFilterMode\n");
 
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
-
-    int result = cuMemcpy2DAsync(&memcpyData->memcpy2d, nativeHStream);
-
-    if (!releaseMemcpy2DData(env, memcpyData)) return JCUDA_INTERNAL_ERROR;
-
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+    int result = cuTexRefSetFilterMode(nativeHTexRef, (CUfilter_mode)fm);
     return result;
 }
 
 
 
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpy3DAsyncNative
- * Signature: (Ljcuda/driver/CUDA_MEMCPY3D;Ljcuda/driver/CUstream;)I
+ * Method:    cuTexRefSetMipmapFilterModeNative
+ * Signature: (Ljcuda/driver/CUtexref;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DAsyncNative
-  (JNIEnv *env, jclass cls, jobject pCopy, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetMipmapFilterModeNative
+  (JNIEnv *env, jclass cls, jobject hTexRef, jint fm)
 {
-    if (pCopy == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pCopy' is null for cuMemcpy3DAsync");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    /* May be null
-    if (hStream == NULL)
+    if (hTexRef == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuMemcpy3DAsync");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetMipmapFilterMode");
         return JCUDA_INTERNAL_ERROR;
     }
-    */
-    Logger::log(LOG_TRACE, "Executing cuMemcpy3DAsync\n");
+    Logger::log(LOG_TRACE, "Executing cuTexRefSetMipmapFilterMode\n");
 
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+    int result = cuTexRefSetMipmapFilterMode(nativeHTexRef, (CUfilter_mode)fm);
+    return result;
+}
 
-    Memcpy3DData *memcpyData = initMemcpy3DData(env, pCopy);
-    if (memcpyData == NULL)
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTexRefSetMipmapLevelBiasNative
+ * Signature: (Ljcuda/driver/CUtexref;F)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetMipmapLevelBiasNative
+  (JNIEnv *env, jclass cls, jobject hTexRef, jfloat bias)
+{
+    if (hTexRef == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetMipmapLevelBias");
         return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cuTexRefSetMipmapLevelBias\n");
 
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
-
-    int result = cuMemcpy3DAsync(&memcpyData->memcpy3d, nativeHStream);
-
-    if (!releaseMemcpy3DData(env, memcpyData)) return JCUDA_INTERNAL_ERROR;
-
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+    int result = cuTexRefSetMipmapLevelBias(nativeHTexRef, (float)bias);
     return result;
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemsetD8Native
- * Signature: (Ljcuda/driver/CUdeviceptr;BJ)I
+ * Method:    cuTexRefSetMipmapLevelClampNative
+ * Signature: (Ljcuda/driver/CUtexref;FF)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD8Native
-  (JNIEnv *env, jclass cls, jobject dstDevice, jbyte uc, jlong N)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetMipmapLevelClampNative
+  (JNIEnv *env, jclass cls, jobject hTexRef, jfloat minMipmapLevelClamp, jfloat maxMipmapLevelClamp)
 {
-    if (dstDevice == NULL)
+    if (hTexRef == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD8");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetMipmapLevelClamp");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemsetD8\n");
-
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
-
-    int result = cuMemsetD8(nativeDstDevice, (unsigned char)uc, (size_t)N);
+    Logger::log(LOG_TRACE, "Executing cuTexRefSetMipmapLevelClamp\n");
 
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+    int result = cuTexRefSetMipmapLevelClamp(nativeHTexRef, (float)minMipmapLevelClamp, (float)maxMipmapLevelClamp);
     return result;
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemsetD16Native
- * Signature: (Ljcuda/driver/CUdeviceptr;SJ)I
+ * Method:    cuTexRefSetMaxAnisotropyNative
+ * Signature: (Ljcuda/driver/CUtexref;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD16Native
-  (JNIEnv *env, jclass cls, jobject dstDevice, jshort us, jlong N)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetMaxAnisotropyNative
+  (JNIEnv *env, jclass cls, jobject hTexRef, jint maxAniso)
 {
-    if (dstDevice == NULL)
+    if (hTexRef == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD16");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetMaxAnisotropy");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemsetD16\n");
-
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
-
-    int result = cuMemsetD16(nativeDstDevice, (unsigned short)us, (size_t)N);
+    Logger::log(LOG_TRACE, "Executing cuTexRefSetMaxAnisotropy\n");
 
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+    int result = cuTexRefSetMaxAnisotropy(nativeHTexRef, (unsigned int)maxAniso);
     return result;
 }
 
@@ -3814,23 +9859,21 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD16Native
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemsetD32Native
- * Signature: (Ljcuda/driver/CUdeviceptr;IJ)I
+ * Method:    cuTexRefSetFlagsNative
+ * Signature: (Ljcuda/driver/CUtexref;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD32Native
-  (JNIEnv *env, jclass cls, jobject dstDevice, jint ui, jlong N)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetFlagsNative
+  (JNIEnv *env, jclass cls, jobject hTexRef, jint Flags)
 {
-    if (dstDevice == NULL)
+    if (hTexRef == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD32");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetFlags");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemsetD32\n");
-
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
-
-    int result = cuMemsetD32(nativeDstDevice, (unsigned int)ui, (size_t)N);
+    Logger::log(LOG_TRACE, "Executing cuTexRefSetFlags\n");
 
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+    int result = cuTexRefSetFlags(nativeHTexRef, (unsigned int)Flags);
     return result;
 }
 
@@ -3839,23 +9882,29 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD32Native
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemsetD2D8Native
- * Signature: (Ljcuda/driver/CUdeviceptr;JBJJ)I
+ * Method:    cuTexRefGetAddressNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUtexref;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD2D8Native
-  (JNIEnv *env, jclass cls, jobject dstDevice, jlong dstPitch, jbyte uc, jlong Width, jlong Height)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetAddressNative
+  (JNIEnv *env, jclass cls, jobject pdptr, jobject hTexRef)
 {
-    if (dstDevice == NULL)
+    if (pdptr == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD2D8");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pdptr' is null for cuTexRefGetAddress");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemsetD2D8\n");
-
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+    if (hTexRef == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetAddress");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTexRefGetAddress\n");
 
-    int result = cuMemsetD2D8(nativeDstDevice, (size_t)dstPitch, (unsigned char)uc, (size_t)Width, (size_t)Height);
+    CUdeviceptr nativePdptr;
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+    int result = cuTexRefGetAddress(&nativePdptr, nativeHTexRef);
 
+    setPointer(env, pdptr, nativePdptr);
     return result;
 }
 
@@ -3864,71 +9913,90 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD2D8Native
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemsetD2D16Native
- * Signature: (Ljcuda/driver/CUdeviceptr;JSJJ)I
+ * Method:    cuTexRefGetArrayNative
+ * Signature: (Ljcuda/driver/CUarray;Ljcuda/driver/CUtexref;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD2D16Native
-  (JNIEnv *env, jclass cls, jobject dstDevice, jlong dstPitch, jshort us, jlong Width, jlong Height)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetArrayNative
+  (JNIEnv *env, jclass cls, jobject phArray, jobject hTexRef)
 {
-    if (dstDevice == NULL)
+    if (phArray == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD2D16");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phArray' is null for cuTexRefGetArray");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemsetD2D16\n");
+    if (hTexRef == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetArray");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTexRefGetArray\n");
 
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+    CUarray nativePhArray;
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
 
-    int result = cuMemsetD2D16(nativeDstDevice, (size_t)dstPitch, (unsigned short)us, (size_t)Width, (size_t)Height);
+    int result = cuTexRefGetArray(&nativePhArray, nativeHTexRef);
 
+    setNativePointerValue(env, phArray, (jlong)nativePhArray);
     return result;
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemsetD2D32Native
- * Signature: (Ljcuda/driver/CUdeviceptr;JIJJ)I
+ * Method:    cuTexRefGetMipmappedArrayNative
+ * Signature: (Ljcuda/driver/CUmipmappedArray;Ljcuda/driver/CUtexref;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD2D32Native
-  (JNIEnv *env, jclass cls, jobject dstDevice, jlong dstPitch, jint ui, jlong Width, jlong Height)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetMipmappedArrayNative
+  (JNIEnv *env, jclass cls, jobject phMipmappedArray, jobject hTexRef)
 {
-    if (dstDevice == NULL)
+    if (phMipmappedArray == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD2D32");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phMipmappedArray' is null for cuTexRefGetMipmappedArray");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemsetD2D32\n");
+    if (hTexRef == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetMipmappedArray");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTexRefGetMipmappedArray\n");
 
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+	CUmipmappedArray nativePhMipmappedArray;
 
-    int result = cuMemsetD2D32(nativeDstDevice, (size_t)dstPitch, (unsigned int)ui, (size_t)Width, (size_t)Height);
+	int result = cuTexRefGetMipmappedArray(&nativePhMipmappedArray, nativeHTexRef);
 
-    return result;
+	setNativePointerValue(env, phMipmappedArray, (jlong)nativePhMipmappedArray);
+	return result;
 }
 
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemsetD8AsyncNative
- * Signature: (Ljcuda/driver/CUdeviceptr;BJLjcuda/driver/CUstream;)I
+ * Method:    cuTexRefGetAddressModeNative
+ * Signature: ([ILjcuda/driver/CUtexref;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD8AsyncNative
-  (JNIEnv *env, jclass cls, jobject dstDevice, jbyte uc, jlong N, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetAddressModeNative
+  (JNIEnv *env, jclass cls, jintArray pam, jobject hTexRef, jint dim)
 {
-    if (dstDevice == NULL)
+    if (pam == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pam' is null for cuTexRefGetAddressMode");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (hTexRef == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD8Async");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetAddressMode");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemsetD8Async\n");
+    Logger::log(LOG_TRACE, "Executing cuTexRefGetAddressMode\n");
 
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    CUaddress_mode nativePam;
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
 
-    int result = cuMemsetD8Async(nativeDstDevice, (unsigned char)uc, (size_t)N, nativeHStream);
+    int result = cuTexRefGetAddressMode(&nativePam, nativeHTexRef, (int)dim);
 
+    if (!set(env, pam, 0, nativePam)) return JCUDA_INTERNAL_ERROR;
     return result;
 }
 
@@ -3937,24 +10005,30 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD8AsyncNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemsetD16AsyncNative
- * Signature: (Ljcuda/driver/CUdeviceptr;SJLjcuda/driver/CUstream;)I
+ * Method:    cuTexRefGetFilterModeNative
+ * Signature: ([ILjcuda/driver/CUtexref;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD16AsyncNative
-  (JNIEnv *env, jclass cls, jobject dstDevice, jshort us, jlong N, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetFilterModeNative
+  (JNIEnv *env, jclass cls, jintArray pfm, jobject hTexRef)
 {
-    if (dstDevice == NULL)
+    if (pfm == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD16Async");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pfm' is null for cuTexRefGetFilterMode");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemsetD16Async\n");
+    if (hTexRef == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetFilterMode");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTexRefGetFilterMode\n");
 
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    CUfilter_mode nativePfm;
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
 
-    int result = cuMemsetD16Async(nativeDstDevice, (unsigned short)us, (size_t)N, nativeHStream);
+    int result = cuTexRefGetFilterMode(&nativePfm, nativeHTexRef);
 
+    if (!set(env, pfm, 0, nativePfm)) return JCUDA_INTERNAL_ERROR;
     return result;
 }
 
@@ -3963,412 +10037,500 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD16AsyncNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemsetD32AsyncNative
- * Signature: (Ljcuda/driver/CUdeviceptr;IJLjcuda/driver/CUstream;)I
+ * Method:    cuTexRefGetFormatNative
+ * Signature: ([I[ILjcuda/driver/CUtexref;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD32AsyncNative
-  (JNIEnv *env, jclass cls, jobject dstDevice, jint ui, jlong N, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetFormatNative
+  (JNIEnv *env, jclass cls, jintArray pFormat, jintArray pNumChannels, jobject hTexRef)
 {
-    if (dstDevice == NULL)
+    if (pFormat == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD32Async");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pFormat' is null for cuTexRefGetFormat");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemsetD32Async\n");
+    if (pNumChannels == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pNumChannels' is null for cuTexRefGetFormat");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (hTexRef == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetFormat");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTexRefGetFormat\n");
 
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    CUarray_format nativePFormat;
+    int nativePNumChannels;
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
 
-    int result = cuMemsetD32Async(nativeDstDevice, (unsigned int)ui, (size_t)N, nativeHStream);
+    int result = cuTexRefGetFormat(&nativePFormat, &nativePNumChannels, nativeHTexRef);
 
+    if (!set(env, pFormat, 0, nativePFormat)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, pNumChannels, 0, nativePNumChannels)) return JCUDA_INTERNAL_ERROR;
     return result;
 }
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemsetD2D8AsyncNative
- * Signature: (Ljcuda/driver/CUdeviceptr;JBJJLjcuda/driver/CUstream;)I
+ * Method:    cuTexRefGetMipmapFilterModeNative
+ * Signature: ([ILjcuda/driver/CUtexref;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD2D8AsyncNative
-  (JNIEnv *env, jclass cls, jobject dstDevice, jlong dstPitch, jbyte uc, jlong Width, jlong Height, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetMipmapFilterModeNative
+  (JNIEnv *env, jclass cls, jintArray pfm, jobject hTexRef)
 {
-    if (dstDevice == NULL)
+    if (pfm == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD2D8Async");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pfm' is null for cuTexRefGetMipmapFilterMode");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemsetD2D8Async\n");
-
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    if (hTexRef == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetMipmapFilterMode");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTexRefGetMipmapFilterMode\n");
 
-    int result = cuMemsetD2D8Async(nativeDstDevice, (size_t)dstPitch, (unsigned char)uc, (size_t)Width, (size_t)Height, nativeHStream);
+    CUfilter_mode  nativePfm;
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
 
-    return result;
+	int result = cuTexRefGetMipmapFilterMode(&nativePfm, nativeHTexRef);
+	
+	if (!set(env, pfm, 0, (jint)nativePfm)) return JCUDA_INTERNAL_ERROR;
+	return result;
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemsetD2D16AsyncNative
- * Signature: (Ljcuda/driver/CUdeviceptr;JSJJLjcuda/driver/CUstream;)I
+ * Method:    cuTexRefGetMipmapLevelBiasNative
+ * Signature: ([FLjcuda/driver/CUtexref;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD2D16AsyncNative
-  (JNIEnv *env, jclass cls, jobject dstDevice, jlong dstPitch, jshort us, jlong Width, jlong Height, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetMipmapLevelBiasNative
+  (JNIEnv *env, jclass cls, jfloatArray pbias, jobject hTexRef)
 {
-    if (dstDevice == NULL)
+    if (pbias == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD2D16Async");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pbias' is null for cuTexRefGetMipmapLevelBias");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemsetD2D16Async\n");
-
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    if (hTexRef == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetMipmapLevelBias");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTexRefGetMipmapLevelBias\n");
 
-    int result = cuMemsetD2D16Async(nativeDstDevice, (size_t)dstPitch, (unsigned short)us, (size_t)Width, (size_t)Height, nativeHStream);
+    float nativePbias;
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
 
-    return result;
+	int result = cuTexRefGetMipmapLevelBias(&nativePbias, nativeHTexRef);
+	
+	if (!set(env, pbias, 0, (jfloat)nativePbias)) return JCUDA_INTERNAL_ERROR;
+	return result;
 }
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTexRefGetMipmapLevelClampNative
+ * Signature: ([F[FLjcuda/driver/CUtexref;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetMipmapLevelClampNative
+  (JNIEnv *env, jclass cls, jfloatArray pminMipmapLevelClamp, jfloatArray pmaxMipmapLevelClamp, jobject hTexRef)
+{
+    if (pminMipmapLevelClamp == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pminMipmapLevelClamp' is null for cuTexRefGetMipmapLevelClamp");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (pmaxMipmapLevelClamp == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pmaxMipmapLevelClamp' is null for cuTexRefGetMipmapLevelClamp");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (hTexRef == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetMipmapLevelClamp");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTexRefGetMipmapLevelClamp\n");
 
+    float nativePminMipmapLevelClamp;
+    float nativePmaxMipmapLevelClamp;
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
 
+	int result = cuTexRefGetMipmapLevelClamp(&nativePminMipmapLevelClamp, &nativePmaxMipmapLevelClamp, nativeHTexRef);
+	
+	if (!set(env, pminMipmapLevelClamp, 0, (jfloat)nativePminMipmapLevelClamp)) return JCUDA_INTERNAL_ERROR;
+	if (!set(env, pmaxMipmapLevelClamp, 0, (jfloat)nativePmaxMipmapLevelClamp)) return JCUDA_INTERNAL_ERROR;
+	return result;
+}
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemsetD2D32AsyncNative
- * Signature: (Ljcuda/driver/CUdeviceptr;JIJJLjcuda/driver/CUstream;)I
+ * Method:    cuTexRefGetMaxAnisotropyNative
+ * Signature: ([ILjcuda/driver/CUtexref;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD2D32AsyncNative
-  (JNIEnv *env, jclass cls, jobject dstDevice, jlong dstPitch, jint ui, jlong Width, jlong Height, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetMaxAnisotropyNative
+  (JNIEnv *env, jclass cls, jintArray pMaxAniso, jobject hTexRef)
 {
-    if (dstDevice == NULL)
+    if (pMaxAniso == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dstDevice' is null for cuMemsetD2D32Async");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pMaxAniso' is null for cuTexRefGetMaxAnisotropy");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemsetD2D32Async\n");
-
-    CUdeviceptr nativeDstDevice = (CUdeviceptr)getPointer(env, dstDevice);
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    if (hTexRef == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetMaxAnisotropy");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTexRefGetMaxAnisotropy\n");
 
-    int result = cuMemsetD2D32Async(nativeDstDevice, (size_t)dstPitch, (unsigned int)ui, (size_t)Width, (size_t)Height, nativeHStream);
+    int nativePmaxAniso;
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
 
-    return result;
+	int result = cuTexRefGetMaxAnisotropy(&nativePmaxAniso, nativeHTexRef);
+	
+	if (!set(env, pMaxAniso, 0, (jint)nativePmaxAniso)) return JCUDA_INTERNAL_ERROR;
+	return result;
 }
 
 
 
 
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuLaunchKernelNative
- * Signature: (Ljcuda/driver/CUfunction;IIIIIIILjcuda/driver/CUstream;Ljcuda/Pointer;Ljcuda/Pointer;)I
+ * Method:    cuTexRefGetFlagsNative
+ * Signature: ([ILjcuda/driver/CUtexref;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLaunchKernelNative
-  (JNIEnv *env, jclass cls, jobject f, jint gridDimX, jint gridDimY, jint gridDimZ, jint blockDimX, jint blockDimY, jint blockDimZ, jint sharedMemBytes, jobject hStream, jobject kernelParams, jobject extra)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetFlagsNative
+  (JNIEnv *env, jclass cls, jintArray pFlags, jobject hTexRef)
 {
-    if (f == NULL)
+    if (pFlags == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'f' is null for cuLaunchKernel");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pFlags' is null for cuTexRefGetFlags");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuLaunchKernel\n");
-
-    CUfunction nativeF = (CUfunction)getNativePointerValue(env, f);
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
-
-    // TODO: Verify if this (especially the treatment of 'extra') is correct!
-
-    PointerData *kernelParamsPointerData = NULL;
-    void **nativeKernelParams = NULL;
-    if (kernelParams != NULL)
-    {
-        kernelParamsPointerData = initPointerData(env, kernelParams);
-        if (kernelParamsPointerData == NULL)
-        {
-            return JCUDA_INTERNAL_ERROR;
-        }
-        nativeKernelParams = (void**)kernelParamsPointerData->getPointer(env);
-    }
-
-    PointerData *extraPointerData = NULL;
-    void **nativeExtra = NULL;
-    if (extra != NULL)
+    if (hTexRef == NULL)
     {
-        extraPointerData = initPointerData(env, extra);
-        if (extraPointerData == NULL)
-        {
-            return JCUDA_INTERNAL_ERROR;
-        }
-        nativeExtra = (void**)extraPointerData->getPointer(env);
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetFlags");
+        return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cuTexRefGetFlags\n");
 
-    int result = cuLaunchKernel(
-        nativeF,
-        (unsigned int)gridDimX,
-        (unsigned int)gridDimY,
-        (unsigned int)gridDimZ,
-        (unsigned int)blockDimX,
-        (unsigned int)blockDimY,
-        (unsigned int)blockDimZ,
-        (unsigned int)sharedMemBytes,
-        nativeHStream,
-        nativeKernelParams,
-        nativeExtra);
-
-    if (!releasePointerData(env, kernelParamsPointerData, 0)) return JCUDA_INTERNAL_ERROR;
-    if (!releasePointerData(env, extraPointerData, 0)) return JCUDA_INTERNAL_ERROR;
+    unsigned int nativePFlags;
+    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+
+    int result = cuTexRefGetFlags(&nativePFlags, nativeHTexRef);
 
+    if (!set(env, pFlags, 0, nativePFlags)) return JCUDA_INTERNAL_ERROR;
     return result;
 }
 
 
 
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuSurfRefSetArrayNative
+ * Signature: (Ljcuda/driver/CUsurfref;Ljcuda/driver/CUarray;I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuSurfRefSetArrayNative
+  (JNIEnv *env, jclass cls, jobject hSurfRef, jobject hArray, jint Flags)
+{
+    if (hSurfRef == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hSurfRef' is null for cuSurfRefSetArray");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (hArray == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hArray' is null for cuSurfRefSetArray");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuSurfRefSetArray\n");
 
+    CUsurfref nativeHSurfRef = (CUsurfref)getNativePointerValue(env, hSurfRef);
+    CUarray nativeHArray = (CUarray)getNativePointerValue(env, hArray);
 
+    int result = cuSurfRefSetArray(nativeHSurfRef, nativeHArray, (unsigned int)Flags);
+    return result;
+}
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuFuncGetAttributeNative
- * Signature: ([IILjcuda/driver/CUfunction;)I
+ * Method:    cuSurfRefGetArrayNative
+ * Signature: (Ljcuda/driver/CUarray;Ljcuda/driver/CUsurfref;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuFuncGetAttributeNative
-  (JNIEnv *env, jclass cls, jintArray pi, jint attrib, jobject func)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuSurfRefGetArrayNative
+  (JNIEnv *env, jclass cls, jobject phArray, jobject hSurfRef)
 {
-    if (pi == NULL)
+    if (phArray == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pi' is null for cuFuncGetAttribute");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phArray' is null for cuSurfRefGetArray");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (func == NULL)
+    if (hSurfRef == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'func' is null for cuFuncGetAttribute");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hSurfRef' is null for cuSurfRefGetArray");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuFuncGetAttribute\n");
+    Logger::log(LOG_TRACE, "Executing cuSurfRefGetArray\n");
 
-    int nativePi;
-    CUfunction nativeFunc = (CUfunction)getNativePointerValue(env, func);
-    CUfunction_attribute nativeAttrib = (CUfunction_attribute)attrib;
-    int result = cuFuncGetAttribute(&nativePi, nativeAttrib, nativeFunc);
-    if (!set(env, pi, 0, nativePi)) return JCUDA_INTERNAL_ERROR;
-    return result;
-}
+    CUarray nativePhArray;
+    CUsurfref nativeHSurfRef = (CUsurfref)getNativePointerValue(env, hSurfRef);
 
+    int result = cuSurfRefGetArray(&nativePhArray, nativeHSurfRef);
 
+    setNativePointerValue(env, phArray, (jlong)nativePhArray);
+    return result;
+}
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuFuncSetBlockShapeNative
- * Signature: (Ljcuda/driver/CUfunction;III)I
+ * Method:    cuTexObjectCreateNative
+ * Signature: (Ljcuda/driver/CUtexObject;Ljcuda/driver/CUDA_RESOURCE_DESC;Ljcuda/driver/CUDA_TEXTURE_DESC;Ljcuda/driver/CUDA_RESOURCE_VIEW_DESC;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuFuncSetBlockShapeNative
-  (JNIEnv *env, jclass cls, jobject hfunc, jint x, jint y, jint z)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexObjectCreateNative
+  (JNIEnv *env, jclass cls, jobject pTexObject, jobject pResDesc, jobject pTexDesc, jobject pResViewDesc)
 {
-    if (hfunc == NULL)
+    if (pTexObject == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuFuncSetBlockShape");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pTexObject' is null for cuTexObjectCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuFuncSetBlockShape (%d,%d,%d)\n", (int)x, (int)y, (int)z);
+    if (pResDesc == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pResDesc' is null for cuTexObjectCreate");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (pTexDesc == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pTexDesc' is null for cuTexObjectCreate");
+        return JCUDA_INTERNAL_ERROR;
+    }
+	// pResViewDesc may be NULL
 
-    CUfunction nativeHfunc = (CUfunction)getNativePointerValue(env, hfunc);
-    int result = cuFuncSetBlockShape(nativeHfunc, (int)x, (int)y, (int)z);
-    return result;
-}
+    Logger::log(LOG_TRACE, "Executing cuTexObjectCreate\n");
 
+    CUtexObject *nativePTexObject = NULL;
+    CUDA_RESOURCE_DESC nativePResDesc = getCUDA_RESOURCE_DESC(env, pResDesc);
+    CUDA_TEXTURE_DESC nativePTexDesc = getCUDA_TEXTURE_DESC(env, pTexDesc);
+    CUDA_RESOURCE_VIEW_DESC nativePResViewDesc;
+    CUDA_RESOURCE_VIEW_DESC *nativePResViewDescPointer = NULL;
+    if (pResViewDesc != NULL)
+    {
+        nativePResViewDesc = getCUDA_RESOURCE_VIEW_DESC(env, pResViewDesc);
+        nativePResViewDescPointer = &nativePResViewDesc;
+    }
+    
+    int result = cuTexObjectCreate(nativePTexObject, &nativePResDesc, &nativePTexDesc, nativePResViewDescPointer);
 
+    setNativePointerValue(env, pTexObject, (jlong)nativePTexObject);
+    return result;
+}
 
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuFuncSetSharedSizeNative
- * Signature: (Ljcuda/driver/CUfunction;I)I
+ * Method:    cuTexObjectDestroyNative
+ * Signature: (Ljcuda/driver/CUtexObject;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuFuncSetSharedSizeNative
-  (JNIEnv *env, jclass cls, jobject hfunc, jint bytes)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexObjectDestroyNative
+  (JNIEnv *env, jclass cls, jobject texObject)
 {
-    if (hfunc == NULL)
+    if (texObject == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuFuncSetSharedSize");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'texObject' is null for cuTexObjectDestroy");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuFuncSetSharedSize to %d bytes\n", (unsigned int)bytes);
 
-    CUfunction nativeHfunc = (CUfunction)getNativePointerValue(env, hfunc);
-    int result = cuFuncSetSharedSize(nativeHfunc, (unsigned int)bytes);
-    return result;
-}
+    Logger::log(LOG_TRACE, "Executing cuTexObjectDestroy\n");
+
+    CUtexObject nativeTexObject = (CUtexObject)getNativePointerValue(env, texObject);
 
+	int result = cuTexObjectDestroy(nativeTexObject);
 
+    return result;
+}
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuFuncSetCacheConfigNative
- * Signature: (Ljcuda/driver/CUfunction;I)I
+ * Method:    cuTexObjectGetResourceDescNative
+ * Signature: (Ljcuda/driver/CUDA_RESOURCE_DESC;Ljcuda/driver/CUtexObject;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuFuncSetCacheConfigNative
-  (JNIEnv *env, jclass cls, jobject hfunc, jint config)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexObjectGetResourceDescNative
+  (JNIEnv *env, jclass cls, jobject pResDesc, jobject texObject)
 {
-    if (hfunc == NULL)
+    if (pResDesc == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuFuncSetCacheConfig");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pResDesc' is null for cuTexObjectGetResourceDesc");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (texObject == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'texObject' is null for cuTexObjectGetResourceDesc");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuFuncSetCacheConfig\n");
 
-    CUfunction nativeHfunc = (CUfunction)getNativePointerValue(env, hfunc);
-    int result = cuFuncSetCacheConfig(nativeHfunc, (CUfunc_cache)config);
+    Logger::log(LOG_TRACE, "Executing cuTexObjectGetResourceDesc\n");
+
+	CUDA_RESOURCE_DESC nativePResDesc;
+    CUtexObject nativeTexObject = (CUtexObject)getNativePointerValue(env, texObject);
+	int result = cuTexObjectGetResourceDesc(&nativePResDesc, nativeTexObject);
+
+	setCUDA_RESOURCE_DESC(env, pResDesc, nativePResDesc);
+
     return result;
 }
 
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuFuncSetSharedMemConfigNative
- * Signature: (Ljcuda/driver/CUfunction;I)I
+ * Method:    cuTexObjectGetTextureDescNative
+ * Signature: (Ljcuda/driver/CUDA_TEXTURE_DESC;Ljcuda/driver/CUtexObject;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuFuncSetSharedMemConfigNative
-  (JNIEnv *env, jclass cls, jobject hfunc, jint config)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexObjectGetTextureDescNative
+  (JNIEnv *env, jclass cls, jobject pTexDesc, jobject texObject)
 {
-    if (hfunc == NULL)
+    if (pTexDesc == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuFuncSetSharedMemConfig");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pTexDesc' is null for cuTexObjectGetTextureDesc");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (texObject == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'texObject' is null for cuTexObjectGetTextureDesc");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuFuncSetSharedMemConfig\n");
 
-    CUfunction nativeHfunc = (CUfunction)getNativePointerValue(env, hfunc);
+    Logger::log(LOG_TRACE, "Executing cuTexObjectGetTextureDesc\n");
 
-    int result = cuFuncSetSharedMemConfig(nativeHfunc, (CUsharedconfig)config);
-    return result;
-}
+	CUDA_TEXTURE_DESC nativePTexDesc;
+    CUtexObject nativeTexObject = (CUtexObject)getNativePointerValue(env, texObject);
+	int result = cuTexObjectGetTextureDesc(&nativePTexDesc, nativeTexObject);
 
+	setCUDA_TEXTURE_DESC(env, pTexDesc, nativePTexDesc);
 
+    return result;
+}
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuArrayCreateNative
- * Signature: (Ljcuda/driver/CUarray;Ljcuda/driver/CUDA_ARRAY_DESCRIPTOR;)I
+ * Method:    cuTexObjectGetResourceViewDescNative
+ * Signature: (Ljcuda/driver/CUDA_RESOURCE_VIEW_DESC;Ljcuda/driver/CUtexObject;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuArrayCreateNative
-  (JNIEnv *env, jclass cls, jobject pHandle, jobject pAllocateArray)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexObjectGetResourceViewDescNative
+  (JNIEnv *env, jclass cls, jobject pResViewDesc, jobject texObject)
 {
-    if (pHandle == NULL)
+    if (pResViewDesc == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pHandle' is null for cuArrayCreate");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pResViewDesc' is null for cuTexObjectGetResourceViewDesc");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (pAllocateArray == NULL)
+    if (texObject == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pAllocateArray' is null for cuArrayCreate");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'texObject' is null for cuTexObjectGetResourceViewDesc");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuArrayCreate\n");
 
-    CUarray nativePHandle;
-    CUDA_ARRAY_DESCRIPTOR nativePAllocateArray = getCUDA_ARRAY_DESCRIPTOR(env, pAllocateArray);
+    Logger::log(LOG_TRACE, "Executing cuTexObjectGetResourceViewDesc\n");
 
-    int result = cuArrayCreate(&nativePHandle, &nativePAllocateArray);
-    setNativePointerValue(env, pHandle, (jlong)nativePHandle);
+	CUDA_RESOURCE_VIEW_DESC nativePResViewDesc;
+    CUtexObject nativeTexObject = (CUtexObject)getNativePointerValue(env, texObject);
+	int result = cuTexObjectGetResourceViewDesc(&nativePResViewDesc, nativeTexObject);
+
+	setCUDA_RESOURCE_VIEW_DESC(env, pResViewDesc, nativePResViewDesc);
 
     return result;
 }
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuArrayGetDescriptorNative
- * Signature: (Ljcuda/driver/CUDA_ARRAY_DESCRIPTOR;Ljcuda/driver/CUarray;)I
+ * Method:    cuSurfObjectCreateNative
+ * Signature: (Ljcuda/driver/CUsurfObject;Ljcuda/driver/CUDA_RESOURCE_DESC;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuArrayGetDescriptorNative
-  (JNIEnv *env, jclass cls, jobject pArrayDescriptor, jobject hArray)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuSurfObjectCreateNative
+  (JNIEnv *env, jclass cls, jobject pSurfObject, jobject pResDesc)
 {
-    if (pArrayDescriptor == NULL)
+    if (pSurfObject == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pArrayDescriptor' is null for cuArrayGetDescriptor");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pSurfObject' is null for cuSurfObjectCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hArray == NULL)
+    if (pResDesc == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hArray' is null for cuArrayGetDescriptor");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pResDesc' is null for cuSurfObjectCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuArrayGetDescriptor\n");
 
-    CUDA_ARRAY_DESCRIPTOR nativePArrayDescriptor;
-    CUarray nativeHArray = (CUarray)getNativePointerValue(env, hArray);
+    Logger::log(LOG_TRACE, "Executing cuSurfObjectCreate\n");
 
-    int result = cuArrayGetDescriptor(&nativePArrayDescriptor, nativeHArray);
+    CUsurfObject *nativePSurfObject = NULL;
+	CUDA_RESOURCE_DESC nativePResDesc = getCUDA_RESOURCE_DESC(env, pResDesc);
 
-    setCUDA_ARRAY_DESCRIPTOR(env, pArrayDescriptor, nativePArrayDescriptor);
+	int result = cuSurfObjectCreate(nativePSurfObject, &nativePResDesc);
+
+	setNativePointerValue(env, pSurfObject, (jlong)nativePSurfObject);
 
     return result;
 }
-
-
-
+	  
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuArrayDestroyNative
- * Signature: (Ljcuda/driver/CUarray;)I
+ * Method:    cuSurfObjectDestroyNative
+ * Signature: (Ljcuda/driver/CUsurfObject;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuArrayDestroyNative
-  (JNIEnv *env, jclass cls, jobject hArray)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuSurfObjectDestroyNative
+  (JNIEnv *env, jclass cls, jobject surfObject)
 {
-    if (hArray == NULL)
+    if (surfObject == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hArray' is null for cuArrayDestroy");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pSurfObject' is null for cuSurfObjectDestroy");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuArrayDestroy\n");
 
-    CUarray nativeHArray = (CUarray)getNativePointerValue(env, hArray);
-    int result = cuArrayDestroy(nativeHArray);
-    return result;
-}
+    Logger::log(LOG_TRACE, "Executing cuSurfObjectDestroy\n");
+
+	CUsurfObject nativeSurfObject = (CUsurfObject)getNativePointerValue(env, surfObject);
 
+	int result = cuSurfObjectDestroy(nativeSurfObject);
 
+    return result;
+}
 
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuArray3DCreateNative
- * Signature: (Ljcuda/driver/CUarray;Ljcuda/driver/CUDA_ARRAY3D_DESCRIPTOR;)I
+ * Method:    cuSurfObjectGetResourceDescNative
+ * Signature: (Ljcuda/driver/CUDA_RESOURCE_DESC;Ljcuda/driver/CUsurfObject;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuArray3DCreateNative
-  (JNIEnv *env, jclass cls, jobject pHandle, jobject pAllocateArray)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuSurfObjectGetResourceDescNative
+  (JNIEnv *env, jclass cls, jobject pResDesc, jobject surfObject)
 {
-    if (pHandle == NULL)
+    if (pResDesc == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pHandle' is null for cuArray3DCreate");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pResDesc' is null for cuSurfObjectGetResourceDesc");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (pAllocateArray == NULL)
+    if (surfObject == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pAllocateArray' is null for cuArray3DCreate");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'surfObject' is null for cuSurfObjectGetResourceDesc");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuArray3DCreate\n");
 
-    CUarray nativePHandle;
-    CUDA_ARRAY3D_DESCRIPTOR nativePAllocateArray = getCUDA_ARRAY3D_DESCRIPTOR(env, pAllocateArray);
+    Logger::log(LOG_TRACE, "Executing cuSurfObjectGetResourceDesc\n");
 
-    int result = cuArray3DCreate(&nativePHandle, &nativePAllocateArray);
-    setNativePointerValue(env, pHandle, (jlong)nativePHandle);
+	CUDA_RESOURCE_DESC nativePResDesc;
+	CUsurfObject nativeSurfObject = (CUsurfObject)getNativePointerValue(env, surfObject);
+
+	int result = cuSurfObjectGetResourceDesc(&nativePResDesc, nativeSurfObject);
+
+	setCUDA_RESOURCE_DESC(env, pResDesc, nativePResDesc);
 
     return result;
+
 }
 
 
@@ -4376,155 +10538,205 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuArray3DCreateNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuArray3DGetDescriptorNative
- * Signature: (Ljcuda/driver/CUDA_ARRAY3D_DESCRIPTOR;Ljcuda/driver/CUarray;)I
+ * Method:    cuDeviceCanAccessPeerNative
+ * Signature: ([ILjcuda/driver/CUdevice;Ljcuda/driver/CUdevice;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuArray3DGetDescriptorNative
-  (JNIEnv *env, jclass cls, jobject pArrayDescriptor, jobject hArray)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuDeviceCanAccessPeerNative
+  (JNIEnv *env, jclass cls, jintArray canAccessPeer, jobject dev, jobject peerDev)
 {
-    if (pArrayDescriptor == NULL)
+    if (dev == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pArrayDescriptor' is null for cuArray3DGetDescriptor");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dev' is null for cuDeviceCanAccessPeer");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hArray == NULL)
+    if (peerDev == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hArray' is null for cuArray3DGetDescriptor");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerDev' is null for cuDeviceCanAccessPeer");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuArray3DGetDescriptor\n");
-
-    CUDA_ARRAY3D_DESCRIPTOR nativePArrayDescriptor;
-    CUarray nativeHArray = (CUarray)getNativePointerValue(env, hArray);
+    Logger::log(LOG_TRACE, "Executing cuDeviceCanAccessPeer\n");
 
-    int result = cuArray3DGetDescriptor(&nativePArrayDescriptor, nativeHArray);
+    CUdevice nativeDev = (CUdevice)(intptr_t)getNativePointerValue(env, dev);
+    CUdevice nativePeerDev = (CUdevice)(intptr_t)getNativePointerValue(env, peerDev);
+    int nativeCanAccessPeer;
 
-    setCUDA_ARRAY3D_DESCRIPTOR(env, pArrayDescriptor, nativePArrayDescriptor);
+    int result = cuDeviceCanAccessPeer(&nativeCanAccessPeer, nativeDev, nativePeerDev);
 
+    if (!set(env, canAccessPeer, 0, nativeCanAccessPeer)) return JCUDA_INTERNAL_ERROR;
     return result;
 }
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMipmappedArrayCreateNative
- * Signature: (Ljcuda/driver/CUmipmappedArray;Ljcuda/driver/CUDA_ARRAY3D_DESCRIPTOR;I)I
+ * Method:    cuCtxEnablePeerAccessNative
+ * Signature: (Ljcuda/driver/CUcontext;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMipmappedArrayCreateNative
-  (JNIEnv *env, jclass cls, jobject pHandle, jobject pMipmappedArrayDesc, jint numMipmapLevels)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxEnablePeerAccessNative
+  (JNIEnv *env, jclass cls, jobject peerContext, jint Flags)
 {
-    if (pHandle == NULL)
+    if (peerContext == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pHandle' is null for cuMipmappedArrayCreate");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerContext' is null for cuCtxEnablePeerAccess");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (pMipmappedArrayDesc == NULL)
+    Logger::log(LOG_TRACE, "Executing cuCtxEnablePeerAccess\n");
+
+    CUcontext nativePeerContext = (CUcontext)getNativePointerValue(env, peerContext);
+    int result = cuCtxEnablePeerAccess(nativePeerContext, (unsigned int)Flags);
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCtxDisablePeerAccessNative
+ * Signature: (Ljcuda/driver/CUcontext;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxDisablePeerAccessNative
+  (JNIEnv *env, jclass cls, jobject peerContext)
+{
+    if (peerContext == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pMipmappedArrayDesc' is null for cuMipmappedArrayCreate");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerContext' is null for cuCtxDisablePeerAccess");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMipmappedArrayCreate\n");
-
-	CUmipmappedArray nativePHandle;
-
-	CUDA_ARRAY3D_DESCRIPTOR nativePMipmappedArrayDesc = getCUDA_ARRAY3D_DESCRIPTOR(env, pMipmappedArrayDesc);
-	int result = cuMipmappedArrayCreate(&nativePHandle, &nativePMipmappedArrayDesc, (unsigned int)numMipmapLevels);
+    Logger::log(LOG_TRACE, "Executing cuCtxDisablePeerAccess\n");
 
-	setNativePointerValue(env, pHandle, (jlong)nativePHandle);
-	return result;
+    CUcontext nativePeerContext = (CUcontext)getNativePointerValue(env, peerContext);
+    int result = cuCtxDisablePeerAccess(nativePeerContext);
+    return result;
 }
 
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMipmappedArrayGetLevelNative
- * Signature: (Ljcuda/driver/CUarray;Ljcuda/driver/CUmipmappedArray;I)I
+ * Method:    cuMemPeerRegisterNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUcontext;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMipmappedArrayGetLevelNative
-  (JNIEnv *env, jclass cls, jobject pLevelArray, jobject hMipmappedArray, jint level)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemPeerRegisterNative
+  (JNIEnv *env, jclass cls, jobject peerPointer, jobject peerContext, jint Flags)
 {
-    if (pLevelArray == NULL)
+    if (peerPointer == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pLevelArray' is null for cuMipmappedArrayGetLevel");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerPointer' is null for cuMemPeerRegister");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hMipmappedArray == NULL)
+    if (peerContext == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hMipmappedArray' is null for cuMipmappedArrayGetLevel");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerContext' is null for cuMemPeerRegister");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMipmappedArrayGetLevel\n");
-
-	CUarray nativePLevelArray;
-	CUmipmappedArray nativeHMipmappedArray = (CUmipmappedArray)getNativePointerValue(env, hMipmappedArray);
-	int result = cuMipmappedArrayGetLevel(&nativePLevelArray, nativeHMipmappedArray, (unsigned int)level);
+    Logger::log(LOG_TRACE, "Executing cuMemPeerRegister\n");
 
-	setNativePointerValue(env, pLevelArray, (jlong)nativePLevelArray);
-	return result;
+    return CUDA_SUCCESS;
+    /* Removed in CUDA 4.0RC2
+    CUdeviceptr nativePeerPointer = (CUdeviceptr)getPointer(env, peerPointer);
+    CUcontext nativePeerContext = (CUcontext)getNativePointerValue(env, peerContext);
+    int result = cuMemPeerRegister(nativePeerPointer, nativePeerContext, (unsigned int)Flags);
+    return result;
+    */
 }
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMipmappedArrayDestroyNative
- * Signature: (Ljcuda/driver/CUmipmappedArray;)I
+ * Method:    cuMemPeerUnregisterNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUcontext;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMipmappedArrayDestroyNative
-  (JNIEnv *env, jclass cls, jobject hMipmappedArray)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemPeerUnregisterNative
+  (JNIEnv *env, jclass cls, jobject peerPointer, jobject peerContext)
 {
-    if (hMipmappedArray == NULL)
+    if (peerPointer == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hMipmappedArray' is null for cuMipmappedArrayDestroy");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerPointer' is null for cuMemPeerUnregister");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMipmappedArrayGetLevel\n");
+    if (peerContext == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerContext' is null for cuMemPeerUnregister");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemPeerUnregister\n");
 
-	CUmipmappedArray nativeHMipmappedArray = (CUmipmappedArray)getNativePointerValue(env, hMipmappedArray);
-	int result = cuMipmappedArrayDestroy(nativeHMipmappedArray);
-	return result;
+    return CUDA_SUCCESS;
+    /* Removed in CUDA 4.0RC2
+    CUdeviceptr nativePeerPointer = (CUdeviceptr)getPointer(env, peerPointer);
+    CUcontext nativePeerContext = (CUcontext)getNativePointerValue(env, peerContext);
+    int result = cuMemPeerUnregister(nativePeerPointer, nativePeerContext);
+    return result;
+    */
 }
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefCreateNative
- * Signature: (Ljcuda/driver/CUtexref;)I
+ * Method:    cuMemPeerGetDevicePointerNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUcontext;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefCreateNative
-  (JNIEnv *env, jclass cls, jobject pTexRef)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemPeerGetDevicePointerNative
+  (JNIEnv *env, jclass cls, jobject pdptr, jobject peerPointer, jobject peerContext, jint Flags)
 {
-    if (pTexRef == NULL)
+    if (pdptr == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pTexRef' is null for cuTexRefCreate");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pdptr' is null for cuMemPeerGetDevicePointer");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefCreate\n");
+    if (peerPointer == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerPointer' is null for cuMemPeerGetDevicePointer");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (peerContext == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerContext' is null for cuMemPeerGetDevicePointer");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemPeerGetDevicePointer\n");
 
-    CUtexref nativePTexRef;
-    int result = cuTexRefCreate(&nativePTexRef);
-    setNativePointerValue(env, pTexRef, (jlong)nativePTexRef);
+    return CUDA_SUCCESS;
+    /* Removed in CUDA 4.0RC2
+    CUdeviceptr nativePeerPointer = (CUdeviceptr)getPointer(env, peerPointer);
+    CUcontext nativePeerContext = (CUcontext)getNativePointerValue(env, peerContext);
+    CUdeviceptr nativePdptr = NULL;
+    int result = cuMemPeerGetDevicePointer(&nativePdptr, nativePeerPointer, nativePeerContext, (unsigned int)Flags);
+    setPointer(env, pdptr, (jlong)nativePdptr);
     return result;
+    */
 }
 
 
 
 
+
+
+
+
+
+
+
+
+
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefDestroyNative
- * Signature: (Ljcuda/driver/CUtexref;)I
+ * Method:    cuParamSetSizeNative
+ * Signature: (Ljcuda/driver/CUfunction;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefDestroyNative
-  (JNIEnv *env, jclass cls, jobject hTexRef)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuParamSetSizeNative
+  (JNIEnv *env, jclass cls, jobject hfunc, jint numbytes)
 {
-    if (hTexRef == NULL)
+    if (hfunc == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefDestroy");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuParamSetSize");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefDestroy\n");
+    Logger::log(LOG_TRACE, "Executing cuParamSetSize\n");
 
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-    int result = cuTexRefDestroy(nativeHTexRef);
+    CUfunction nativeHfunc = NULL;
+    int resolveResult = getNativeFunction(env, hfunc, &nativeHfunc);
+    if (resolveResult != CUDA_SUCCESS)
+    {
+        return resolveResult;
+    }
+    int result = cuParamSetSize(nativeHfunc, (unsigned int)numbytes);
     return result;
 }
 
@@ -4533,93 +10745,97 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefDestroyNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefSetArrayNative
- * Signature: (Ljcuda/driver/CUtexref;Ljcuda/driver/CUarray;I)I
+ * Method:    cuParamSetiNative
+ * Signature: (Ljcuda/driver/CUfunction;II)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetArrayNative
-  (JNIEnv *env, jclass cls, jobject hTexRef, jobject hArray, jint Flags)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuParamSetiNative
+  (JNIEnv *env, jclass cls, jobject hfunc, jint offset, jint value)
 {
-    if (hTexRef == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetArray");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (hArray == NULL)
+    if (hfunc == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hArray' is null for cuTexRefSetArray");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuParamSeti");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefSetArray\n");
-
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-    CUarray nativeHArray = (CUarray)getNativePointerValue(env, hArray);
+    Logger::log(LOG_TRACE, "Executing cuParamSeti\n");
 
-    int result = cuTexRefSetArray(nativeHTexRef, nativeHArray, (unsigned int)Flags);
+    CUfunction nativeHfunc = NULL;
+    int resolveResult = getNativeFunction(env, hfunc, &nativeHfunc);
+    if (resolveResult != CUDA_SUCCESS)
+    {
+        return resolveResult;
+    }
+    int result = cuParamSeti(nativeHfunc, (int)offset, (unsigned int)value);
     return result;
 }
 
 
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefSetMipmappedArrayNative
- * Signature: (Ljcuda/driver/CUtexref;Ljcuda/driver/CUmipmappedArray;I)I
+ * Method:    cuParamSetfNative
+ * Signature: (Ljcuda/driver/CUfunction;IF)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetMipmappedArrayNative
-  (JNIEnv *env, jclass cls, jobject hTexRef, jobject hMipmappedArray, jint Flags)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuParamSetfNative
+  (JNIEnv *env, jclass cls, jobject hfunc, jint offset, jfloat value)
 {
-    if (hTexRef == NULL)
+    if (hfunc == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetMipmappedArray");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuParamSetf");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hMipmappedArray == NULL)
+    Logger::log(LOG_TRACE, "Executing cuParamSetf\n");
+
+    CUfunction nativeHfunc = NULL;
+    int resolveResult = getNativeFunction(env, hfunc, &nativeHfunc);
+    if (resolveResult != CUDA_SUCCESS)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hMipmappedArray' is null for cuTexRefSetMipmappedArray");
-        return JCUDA_INTERNAL_ERROR;
+        return resolveResult;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefSetMipmappedArray\n");
-
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-	CUmipmappedArray nativeHMipmappedArray = (CUmipmappedArray)getNativePointerValue(env, hMipmappedArray);
-	int result = cuTexRefSetMipmappedArray(nativeHTexRef, nativeHMipmappedArray, (unsigned int)Flags);
-	return result;
-
+    int result = cuParamSetf(nativeHfunc, (int)offset, (float)value);
+    return result;
 }
 
 
 
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefSetAddressNative
- * Signature: ([JLjcuda/driver/CUtexref;Ljcuda/driver/CUdeviceptr;J)I
+ * Method:    cuParamSetvNative
+ * Signature: (Ljcuda/driver/CUfunction;ILjcuda/Pointer;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetAddressNative
-  (JNIEnv *env, jclass cls, jlongArray ByteOffset, jobject hTexRef, jobject dptr, jlong bytes)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuParamSetvNative
+  (JNIEnv *env, jclass cls, jobject hfunc, jint offset, jobject ptr, jint numbytes)
 {
-    if (ByteOffset == NULL)
+    if (hfunc == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ByteOffset' is null for cuTexRefSetAddress");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuParamSetv");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hTexRef == NULL)
+    if (ptr == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetAddress");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ptr' is null for cuParamSetv");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (dptr == NULL)
+    Logger::log(LOG_TRACE, "Executing cuParamSetv\n");
+
+    CUfunction nativeHfunc = NULL;
+    int resolveResult = getNativeFunction(env, hfunc, &nativeHfunc);
+    if (resolveResult != CUDA_SUCCESS)
+    {
+        return resolveResult;
+    }
+
+    PointerData *ptrPointerData = initPointerData(env, ptr);
+    if (ptrPointerData == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuTexRefSetAddress");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefSetAddress\n");
 
-    size_t nativeByteOffset = 0;
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+    int result = cuParamSetv(nativeHfunc, (int)offset, (void*)ptrPointerData->getPointer(env), (unsigned int)numbytes);
 
-    CUdeviceptr nativeDptr = (CUdeviceptr)getPointer(env, dptr);
-    int result = cuTexRefSetAddress(&nativeByteOffset, nativeHTexRef, nativeDptr, (size_t)bytes);
+    if (!releasePointerData(env, ptrPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
 
-    if (!set(env, ByteOffset, 0, nativeByteOffset)) return JCUDA_INTERNAL_ERROR;
     return result;
 }
 
@@ -4628,54 +10844,66 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetAddressNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefSetFormatNative
- * Signature: (Ljcuda/driver/CUtexref;II)I
+ * Method:    cuParamSetTexRefNative
+ * Signature: (Ljcuda/driver/CUfunction;ILjcuda/driver/CUtexref;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetFormatNative
-  (JNIEnv *env, jclass cls, jobject hTexRef, jint fmt, jint NumPackedComponents)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuParamSetTexRefNative
+  (JNIEnv *env, jclass cls, jobject hfunc, jint texunit, jobject hTexRef)
 {
+    if (hfunc == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuParamSetTexRef");
+        return JCUDA_INTERNAL_ERROR;
+    }
     if (hTexRef == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetFormat");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuParamSetTexRef");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefSetFormat\n");
+    Logger::log(LOG_TRACE, "Executing cuParamSetTexRef\n");
 
+    CUfunction nativeHfunc = NULL;
+    int resolveResult = getNativeFunction(env, hfunc, &nativeHfunc);
+    if (resolveResult != CUDA_SUCCESS)
+    {
+        return resolveResult;
+    }
     CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-    int result = cuTexRefSetFormat(nativeHTexRef, (CUarray_format)fmt, (int)NumPackedComponents);
+
+    int result = cuParamSetTexRef(nativeHfunc, (int)texunit, nativeHTexRef);
     return result;
 }
 
 
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefSetAddress2DNative
- * Signature: (Ljcuda/driver/CUtexref;Ljcuda/driver/CUDA_ARRAY_DESCRIPTOR;Ljcuda/driver/CUdeviceptr;J)I
+ * Method:    cuLaunchNative
+ * Signature: (Ljcuda/driver/CUfunction;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetAddress2DNative
-  (JNIEnv *env, jclass cls, jobject hTexRef, jobject desc, jobject dptr, jlong PitchInBytes)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLaunchNative
+  (JNIEnv *env, jclass cls, jobject f)
 {
-    if (hTexRef == NULL)
+    if (f == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetAddress2D");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'f' is null for cuLaunch");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (desc == NULL)
+    Logger::log(LOG_TRACE, "Executing cuLaunch\n");
+
+    CUfunction nativeF = NULL;
+    int resolveResult = getNativeFunction(env, f, &nativeF);
+    if (resolveResult != CUDA_SUCCESS)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'desc' is null for cuTexRefSetAddress2D");
-        return JCUDA_INTERNAL_ERROR;
+        return resolveResult;
     }
-    if (dptr == NULL)
+    int result = symbolStaging.flush((CUstream)NULL);
+    if (result != CUDA_SUCCESS)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dptr' is null for cuTexRefSetAddress2D");
-        return JCUDA_INTERNAL_ERROR;
+        return result;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefSetAddress2D\n");
-
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-    CUDA_ARRAY_DESCRIPTOR nativeDesc = getCUDA_ARRAY_DESCRIPTOR(env, desc);
-    CUdeviceptr nativeDptr = (CUdeviceptr)getPointer(env, dptr);
-    int result = cuTexRefSetAddress2D(nativeHTexRef, &nativeDesc, nativeDptr, (size_t)PitchInBytes);
+    result = cuLaunch(nativeF);
     return result;
 }
 
@@ -4684,21 +10912,31 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetAddress2DNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefSetAddressModeNative
- * Signature: (Ljcuda/driver/CUtexref;II)I
+ * Method:    cuLaunchGridNative
+ * Signature: (Ljcuda/driver/CUfunction;II)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetAddressModeNative
-  (JNIEnv *env, jclass cls, jobject hTexRef, jint dim, jint am)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLaunchGridNative
+  (JNIEnv *env, jclass cls, jobject f, jint grid_width, jint grid_height)
 {
-    if (hTexRef == NULL)
+    if (f == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetAddressMode");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'f' is null for cuLaunchGrid");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefSetAddressMode\n");
+    Logger::log(LOG_TRACE, "Executing cuLaunchGrid\n");
 
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-    int result = cuTexRefSetAddressMode(nativeHTexRef, (int)dim, (CUaddress_mode)am);
+    CUfunction nativeF = NULL;
+    int resolveResult = getNativeFunction(env, f, &nativeF);
+    if (resolveResult != CUDA_SUCCESS)
+    {
+        return resolveResult;
+    }
+    int result = symbolStaging.flush((CUstream)NULL);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    result = cuLaunchGrid(nativeF, (int)grid_width, (int)grid_height);
     return result;
 }
 
@@ -4707,103 +10945,154 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetAddressModeNativ
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefSetFilterModeNative
- * Signature: (Ljcuda/driver/CUtexref;I)I
+ * Method:    cuLaunchGridAsyncNative
+ * Signature: (Ljcuda/driver/CUfunction;IILjcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetFilterModeNative
-  (JNIEnv *env, jclass cls, jobject hTexRef, jint fm)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLaunchGridAsyncNative
+  (JNIEnv *env, jclass cls, jobject f, jint grid_width, jint grid_height, jobject hStream)
 {
-    if (hTexRef == NULL)
+    if (f == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetFilterMode");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'f' is null for cuLaunchGridAsync");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefSetFilterMode\n");
+    /* May be null
+    if (hStream == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuLaunchGridAsync");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    */
+    Logger::log(LOG_TRACE, "Executing cuLaunchGridAsync\n");
 
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-    int result = cuTexRefSetFilterMode(nativeHTexRef, (CUfilter_mode)fm);
+    CUfunction nativeF = NULL;
+    int resolveResult = getNativeFunction(env, f, &nativeF);
+    if (resolveResult != CUDA_SUCCESS)
+    {
+        return resolveResult;
+    }
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    int result = symbolStaging.flush(nativeHStream);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    result = cuLaunchGridAsync(nativeF, (int)grid_width, (int)grid_height, nativeHStream);
     return result;
+
 }
 
 
 
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefSetMipmapFilterModeNative
- * Signature: (Ljcuda/driver/CUtexref;I)I
+ * Method:    cuEventCreateNative
+ * Signature: (Ljcuda/driver/CUevent;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetMipmapFilterModeNative
-  (JNIEnv *env, jclass cls, jobject hTexRef, jint fm)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventCreateNative
+  (JNIEnv *env, jclass cls, jobject phEvent, jint Flags)
 {
-    if (hTexRef == NULL)
+    if (phEvent == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetMipmapFilterMode");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phEvent' is null for cuEventCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefSetMipmapFilterMode\n");
+    Logger::log(LOG_TRACE, "Executing cuEventCreate\n");
 
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-    int result = cuTexRefSetMipmapFilterMode(nativeHTexRef, (CUfilter_mode)fm);
+    CUevent nativePhEvent;
+    int result = cuEventCreate(&nativePhEvent, Flags);
+    setNativePointerValue(env, phEvent, (jlong)nativePhEvent);
     return result;
 }
 
+
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefSetMipmapLevelBiasNative
- * Signature: (Ljcuda/driver/CUtexref;F)I
+ * Method:    cuEventRecordNative
+ * Signature: (Ljcuda/driver/CUevent;Ljcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetMipmapLevelBiasNative
-  (JNIEnv *env, jclass cls, jobject hTexRef, jfloat bias)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventRecordNative
+  (JNIEnv *env, jclass cls, jobject hEvent, jobject hStream)
 {
-    if (hTexRef == NULL)
+    if (hEvent == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetMipmapLevelBias");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hEvent' is null for cuEventRecord");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefSetMipmapLevelBias\n");
+    /* May be null
+    if (hStream == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuEventRecord");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    */
+    Logger::log(LOG_TRACE, "Executing cuEventRecord\n");
 
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-    int result = cuTexRefSetMipmapLevelBias(nativeHTexRef, (float)bias);
+    CUevent nativeHEvent = (CUevent)getNativePointerValue(env, hEvent);
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+
+    OperationGraph *graph = OperationGraph::getCapturing();
+    if (graph != NULL)
+    {
+        graph->addEventRecord(nativeHEvent, nativeHStream);
+        return CUDA_SUCCESS;
+    }
+
+    int result = cuEventRecord(nativeHEvent, nativeHStream);
     return result;
 }
 
+
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefSetMipmapLevelClampNative
- * Signature: (Ljcuda/driver/CUtexref;FF)I
+ * Method:    cuEventQueryNative
+ * Signature: (Ljcuda/driver/CUevent;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetMipmapLevelClampNative
-  (JNIEnv *env, jclass cls, jobject hTexRef, jfloat minMipmapLevelClamp, jfloat maxMipmapLevelClamp)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventQueryNative
+  (JNIEnv *env, jclass cls, jobject hEvent)
 {
-    if (hTexRef == NULL)
+    if (hEvent == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetMipmapLevelClamp");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hEvent' is null for cuEventQuery");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefSetMipmapLevelClamp\n");
+    Logger::log(LOG_TRACE, "Executing cuEventQuery\n");
 
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-    int result = cuTexRefSetMipmapLevelClamp(nativeHTexRef, (float)minMipmapLevelClamp, (float)maxMipmapLevelClamp);
+    CUevent nativeHEvent = (CUevent)getNativePointerValue(env, hEvent);
+    int result = cuEventQuery(nativeHEvent);
+    if (result == CUDA_SUCCESS)
+    {
+        bounceRing.completeReady(env);
+    }
     return result;
 }
 
+
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefSetMaxAnisotropyNative
- * Signature: (Ljcuda/driver/CUtexref;I)I
+ * Method:    cuEventSynchronizeNative
+ * Signature: (Ljcuda/driver/CUevent;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetMaxAnisotropyNative
-  (JNIEnv *env, jclass cls, jobject hTexRef, jint maxAniso)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventSynchronizeNative
+  (JNIEnv *env, jclass cls, jobject hEvent)
 {
-    if (hTexRef == NULL)
+    if (hEvent == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetMaxAnisotropy");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hEvent' is null for cuEventSynchronize");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefSetMaxAnisotropy\n");
+    Logger::log(LOG_TRACE, "Executing cuEventSynchronize\n");
 
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-    int result = cuTexRefSetMaxAnisotropy(nativeHTexRef, (unsigned int)maxAniso);
+    CUevent nativeHEvent = (CUevent)getNativePointerValue(env, hEvent);
+    int result = cuEventSynchronize(nativeHEvent);
+    bounceRing.completeReady(env);
     return result;
 }
 
@@ -4812,177 +11101,212 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetMaxAnisotropyNat
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefSetFlagsNative
- * Signature: (Ljcuda/driver/CUtexref;I)I
+ * Method:    cuEventDestroyNative
+ * Signature: (Ljcuda/driver/CUevent;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefSetFlagsNative
-  (JNIEnv *env, jclass cls, jobject hTexRef, jint Flags)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventDestroyNative
+  (JNIEnv *env, jclass cls, jobject hEvent)
 {
-    if (hTexRef == NULL)
+    if (hEvent == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefSetFlags");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hEvent' is null for cuEventDestroy");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefSetFlags\n");
+    Logger::log(LOG_TRACE, "Executing cuEventDestroy\n");
 
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-    int result = cuTexRefSetFlags(nativeHTexRef, (unsigned int)Flags);
+    CUevent nativeHEvent = (CUevent)getNativePointerValue(env, hEvent);
+    int result = cuEventDestroy(nativeHEvent);
     return result;
 }
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefGetAddressNative
- * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUtexref;)I
+ * Method:    cuEventPoolCreateNative
+ * Signature: (Ljcuda/driver/CUeventPool;II)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetAddressNative
-  (JNIEnv *env, jclass cls, jobject pdptr, jobject hTexRef)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventPoolCreateNative
+  (JNIEnv *env, jclass cls, jobject pool, jint Flags, jint capacity)
 {
-    if (pdptr == NULL)
+    if (pool == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pdptr' is null for cuTexRefGetAddress");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pool' is null for cuEventPoolCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hTexRef == NULL)
+    Logger::log(LOG_TRACE, "Executing cuEventPoolCreate\n");
+
+    if (capacity < 0)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetAddress");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_VALUE;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefGetAddress\n");
-
-    CUdeviceptr nativePdptr;
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-    int result = cuTexRefGetAddress(&nativePdptr, nativeHTexRef);
-
-    setPointer(env, pdptr, nativePdptr);
-    return result;
+    EventPool *nativePool = new EventPool((unsigned int)Flags, (int)capacity);
+    setNativePointerValue(env, pool, (jlong)nativePool);
+    return CUDA_SUCCESS;
 }
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuEventPoolDestroyNative
+ * Signature: (Ljcuda/driver/CUeventPool;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventPoolDestroyNative
+  (JNIEnv *env, jclass cls, jobject pool)
+{
+    if (pool == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pool' is null for cuEventPoolDestroy");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuEventPoolDestroy\n");
 
-
+    EventPool *nativePool = (EventPool*)getNativePointerValue(env, pool);
+    if (nativePool == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    delete nativePool;
+    setNativePointerValue(env, pool, 0);
+    return CUDA_SUCCESS;
+}
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefGetArrayNative
- * Signature: (Ljcuda/driver/CUarray;Ljcuda/driver/CUtexref;)I
+ * Method:    cuEventPoolAcquireNative
+ * Signature: (Ljcuda/driver/CUeventPool;Ljcuda/driver/CUevent;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetArrayNative
-  (JNIEnv *env, jclass cls, jobject phArray, jobject hTexRef)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventPoolAcquireNative
+  (JNIEnv *env, jclass cls, jobject pool, jobject phEvent)
 {
-    if (phArray == NULL)
+    if (pool == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phArray' is null for cuTexRefGetArray");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pool' is null for cuEventPoolAcquire");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hTexRef == NULL)
+    if (phEvent == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetArray");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phEvent' is null for cuEventPoolAcquire");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefGetArray\n");
-
-    CUarray nativePhArray;
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-
-    int result = cuTexRefGetArray(&nativePhArray, nativeHTexRef);
+    Logger::log(LOG_TRACE, "Executing cuEventPoolAcquire\n");
 
-    setNativePointerValue(env, phArray, (jlong)nativePhArray);
+    EventPool *nativePool = (EventPool*)getNativePointerValue(env, pool);
+    if (nativePool == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    CUevent nativePhEvent = NULL;
+    int result = nativePool->acquire(&nativePhEvent);
+    if (result == CUDA_SUCCESS)
+    {
+        setNativePointerValue(env, phEvent, (jlong)nativePhEvent);
+    }
     return result;
 }
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefGetMipmappedArrayNative
- * Signature: (Ljcuda/driver/CUmipmappedArray;Ljcuda/driver/CUtexref;)I
+ * Method:    cuEventPoolReleaseNative
+ * Signature: (Ljcuda/driver/CUeventPool;Ljcuda/driver/CUevent;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetMipmappedArrayNative
-  (JNIEnv *env, jclass cls, jobject phMipmappedArray, jobject hTexRef)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventPoolReleaseNative
+  (JNIEnv *env, jclass cls, jobject pool, jobject hEvent)
 {
-    if (phMipmappedArray == NULL)
+    if (pool == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phMipmappedArray' is null for cuTexRefGetMipmappedArray");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pool' is null for cuEventPoolRelease");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hTexRef == NULL)
+    if (hEvent == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetMipmappedArray");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hEvent' is null for cuEventPoolRelease");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefGetMipmappedArray\n");
-
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-	CUmipmappedArray nativePhMipmappedArray;
-
-	int result = cuTexRefGetMipmappedArray(&nativePhMipmappedArray, nativeHTexRef);
+    Logger::log(LOG_TRACE, "Executing cuEventPoolRelease\n");
 
-	setNativePointerValue(env, phMipmappedArray, (jlong)nativePhMipmappedArray);
-	return result;
+    EventPool *nativePool = (EventPool*)getNativePointerValue(env, pool);
+    if (nativePool == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    CUevent nativeHEvent = (CUevent)getNativePointerValue(env, hEvent);
+    return nativePool->release(nativeHEvent);
 }
 
 
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefGetAddressModeNative
- * Signature: ([ILjcuda/driver/CUtexref;I)I
+ * Method:    cuEventRegisterFutureNative
+ * Signature: (Ljcuda/EventFuture;Ljcuda/driver/CUevent;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetAddressModeNative
-  (JNIEnv *env, jclass cls, jintArray pam, jobject hTexRef, jint dim)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventRegisterFutureNative
+  (JNIEnv *env, jclass cls, jobject future, jobject hEvent)
 {
-    if (pam == NULL)
+    if (future == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pam' is null for cuTexRefGetAddressMode");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'future' is null for cuEventRegisterFuture");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hTexRef == NULL)
+    if (hEvent == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetAddressMode");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hEvent' is null for cuEventRegisterFuture");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefGetAddressMode\n");
-
-    CUaddress_mode nativePam;
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-
-    int result = cuTexRefGetAddressMode(&nativePam, nativeHTexRef, (int)dim);
+    Logger::log(LOG_TRACE, "Executing cuEventRegisterFuture\n");
 
-    if (!set(env, pam, 0, nativePam)) return JCUDA_INTERNAL_ERROR;
-    return result;
+    CUevent nativeHEvent = (CUevent)getNativePointerValue(env, hEvent);
+    CUcontext context = NULL;
+    int result = ContextTracker::getCurrent(&context);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    jobject globalFuture = env->NewGlobalRef(future);
+    if (globalFuture == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (!getCompletionService()->add(context, nativeHEvent, globalFuture))
+    {
+        env->DeleteGlobalRef(globalFuture);
+        return CUDA_ERROR_UNKNOWN;
+    }
+    return CUDA_SUCCESS;
 }
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefGetFilterModeNative
- * Signature: ([ILjcuda/driver/CUtexref;)I
+ * Method:    cuEventFutureGetStatisticsNative
+ * Signature: ([J[J[J)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetFilterModeNative
-  (JNIEnv *env, jclass cls, jintArray pfm, jobject hTexRef)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventFutureGetStatisticsNative
+  (JNIEnv *env, jclass cls, jlongArray pending, jlongArray completed, jlongArray batches)
 {
-    if (pfm == NULL)
+    if (pending == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pfm' is null for cuTexRefGetFilterMode");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pending' is null for cuEventFutureGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hTexRef == NULL)
+    if (completed == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetFilterMode");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'completed' is null for cuEventFutureGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefGetFilterMode\n");
-
-    CUfilter_mode nativePfm;
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-
-    int result = cuTexRefGetFilterMode(&nativePfm, nativeHTexRef);
+    if (batches == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'batches' is null for cuEventFutureGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuEventFutureGetStatistics\n");
 
-    if (!set(env, pfm, 0, nativePfm)) return JCUDA_INTERNAL_ERROR;
-    return result;
+    jcuda_int64 nativePending = 0;
+    jcuda_int64 nativeCompleted = 0;
+    jcuda_int64 nativeBatches = 0;
+    getCompletionService()->getStatistics(&nativePending, &nativeCompleted, &nativeBatches);
+    if (!set(env, pending, 0, (jlong)nativePending)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, completed, 0, (jlong)nativeCompleted)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, batches, 0, (jlong)nativeBatches)) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
 }
 
 
@@ -4990,194 +11314,220 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetFilterModeNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefGetFormatNative
- * Signature: ([I[ILjcuda/driver/CUtexref;)I
+ * Method:    cuEventElapsedTimeNative
+ * Signature: ([FLjcuda/driver/CUevent;Ljcuda/driver/CUevent;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetFormatNative
-  (JNIEnv *env, jclass cls, jintArray pFormat, jintArray pNumChannels, jobject hTexRef)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventElapsedTimeNative
+  (JNIEnv *env, jclass cls, jfloatArray pMilliseconds, jobject hStart, jobject hEnd)
 {
-    if (pFormat == NULL)
+    if (pMilliseconds == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pFormat' is null for cuTexRefGetFormat");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pMilliseconds' is null for cuEventElapsedTime");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (pNumChannels == NULL)
+    if (hStart == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pNumChannels' is null for cuTexRefGetFormat");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStart' is null for cuEventElapsedTime");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hTexRef == NULL)
+    if (hEnd == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetFormat");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hEnd' is null for cuEventElapsedTime");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefGetFormat\n");
-
-    CUarray_format nativePFormat;
-    int nativePNumChannels;
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-
-    int result = cuTexRefGetFormat(&nativePFormat, &nativePNumChannels, nativeHTexRef);
+    Logger::log(LOG_TRACE, "Executing cuEventElapsedTime\n");
 
-    if (!set(env, pFormat, 0, nativePFormat)) return JCUDA_INTERNAL_ERROR;
-    if (!set(env, pNumChannels, 0, nativePNumChannels)) return JCUDA_INTERNAL_ERROR;
+    CUevent nativeHStart = (CUevent)getNativePointerValue(env, hStart);
+    CUevent nativeHEnd   = (CUevent)getNativePointerValue(env, hEnd  );
+    float nativePMilliseconds;
+    int result = cuEventElapsedTime(&nativePMilliseconds, nativeHStart, nativeHEnd);
+    if (!set(env, pMilliseconds, 0, nativePMilliseconds)) return JCUDA_INTERNAL_ERROR;
     return result;
 }
 
 
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefGetMipmapFilterModeNative
- * Signature: ([ILjcuda/driver/CUtexref;)I
+ * Method:    cuPointerGetAttributeNative
+ * Signature: (Ljcuda/Pointer;ILjcuda/driver/CUdeviceptr;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetMipmapFilterModeNative
-  (JNIEnv *env, jclass cls, jintArray pfm, jobject hTexRef)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPointerGetAttributeNative
+  (JNIEnv *env, jclass cls, jobject data, jint attribute, jobject ptr)
 {
-    if (pfm == NULL)
+    if (data == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pfm' is null for cuTexRefGetMipmapFilterMode");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'data' is null for cuPointerGetAttribute");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hTexRef == NULL)
+    if (ptr == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetMipmapFilterMode");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ptr' is null for cuPointerGetAttribute");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefGetMipmapFilterMode\n");
+    Logger::log(LOG_TRACE, "Executing cuPointerGetAttribute\n");
 
-    CUfilter_mode  nativePfm;
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+    PointerData *dataPointerData = initPointerData(env, data);
+    if (dataPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    CUdeviceptr nativePtr = (CUdeviceptr)getPointer(env, ptr);
 
-	int result = cuTexRefGetMipmapFilterMode(&nativePfm, nativeHTexRef);
-	
-	if (!set(env, pfm, 0, (jint)nativePfm)) return JCUDA_INTERNAL_ERROR;
-	return result;
+    void *dataPointer = (void*)dataPointerData->getPointer(env);
+    int result = cuPointerGetAttribute(dataPointer, (CUpointer_attribute)attribute, nativePtr);
+
+    // XXX TEST XXX
+    /*
+    int result = CUDA_SUCCESS;
+    if (attribute == CU_POINTER_ATTRIBUTE_CONTEXT)
+    {
+        CUcontext *testContext = (CUcontext*)dataPointer;
+        *testContext = (CUcontext)0x0000CAFE;
+    }
+    else if (attribute == CU_POINTER_ATTRIBUTE_MEMORY_TYPE)
+    {
+        unsigned int *testMemoryType = (unsigned int*)dataPointer;
+        *testMemoryType = CU_MEMORYTYPE_UNIFIED;
+    }
+    else if (attribute == CU_POINTER_ATTRIBUTE_DEVICE_POINTER)
+    {
+        CUdeviceptr *testDevicePtr = (CUdeviceptr*)dataPointer;
+        *testDevicePtr = nativePtr;
+    }
+    else if (attribute == CU_POINTER_ATTRIBUTE_HOST_POINTER)
+    {
+        void **testHostPtr = (void**)dataPointer;
+        *testHostPtr = (void*)0x0000BABE;
+    }
+    */
+    // TODO: For CU_POINTER_ATTRIBUTE_HOST_POINTER it might be
+    // necessary (or at least desirable) to set the "buffer"
+    // of the Pointer to be a DirectByteBuffer backed by the
+    // host memory.
+
+    if (!releasePointerData(env, dataPointerData, 0)) return JCUDA_INTERNAL_ERROR;
+    return result;
 }
 
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefGetMipmapLevelBiasNative
- * Signature: ([FLjcuda/driver/CUtexref;)I
+ * Method:    cuStreamCreateNative
+ * Signature: (Ljcuda/driver/CUstream;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetMipmapLevelBiasNative
-  (JNIEnv *env, jclass cls, jfloatArray pbias, jobject hTexRef)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamCreateNative
+  (JNIEnv *env, jclass cls, jobject phStream, jint Flags)
 {
-    if (pbias == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pbias' is null for cuTexRefGetMipmapLevelBias");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (hTexRef == NULL)
+    if (phStream == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetMipmapLevelBias");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phStream' is null for cuStreamCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefGetMipmapLevelBias\n");
+    Logger::log(LOG_TRACE, "Executing cuStreamCreate\n");
 
-    float nativePbias;
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+    CUstream nativePhStream;
+    int result = cuStreamCreate(&nativePhStream, Flags);
+    setNativePointerValue(env, phStream, (jlong)nativePhStream);
 
-	int result = cuTexRefGetMipmapLevelBias(&nativePbias, nativeHTexRef);
-	
-	if (!set(env, pbias, 0, (jfloat)nativePbias)) return JCUDA_INTERNAL_ERROR;
-	return result;
+    return result;
 }
 
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefGetMipmapLevelClampNative
- * Signature: ([F[FLjcuda/driver/CUtexref;)I
+ * Method:    cuStreamCreateWithPriorityNative
+ * Signature: (Ljcuda/driver/CUstream;II)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetMipmapLevelClampNative
-  (JNIEnv *env, jclass cls, jfloatArray pminMipmapLevelClamp, jfloatArray pmaxMipmapLevelClamp, jobject hTexRef)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamCreateWithPriorityNative
+  (JNIEnv *env, jclass cls, jobject phStream, jint flags, jint priority)
 {
-    if (pminMipmapLevelClamp == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pminMipmapLevelClamp' is null for cuTexRefGetMipmapLevelClamp");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (pmaxMipmapLevelClamp == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pmaxMipmapLevelClamp' is null for cuTexRefGetMipmapLevelClamp");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (hTexRef == NULL)
+	// XXX Function is not available in CUDA 5.5
+	ThrowByName(env, "java/lang/UnsupportedOperaionException", 
+		"Function cuStreamCreateWithPriority is not available in CUDA 5.5");
+	return JCUDA_INTERNAL_ERROR;
+/*
+    if (phStream == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetMipmapLevelClamp");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phStream' is null for cuStreamCreateWithPriority");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefGetMipmapLevelClamp\n");
+    Logger::log(LOG_TRACE, "Executing cuStreamCreateWithPriority\n");
 
-    float nativePminMipmapLevelClamp;
-    float nativePmaxMipmapLevelClamp;
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+    CUstream nativePhStream;
+    int result = cuStreamCreateWithPriority(&nativePhStream, (unsigned int)flags, (int)priority);
+    setNativePointerValue(env, phStream, (jlong)nativePhStream);
 
-	int result = cuTexRefGetMipmapLevelClamp(&nativePminMipmapLevelClamp, &nativePmaxMipmapLevelClamp, nativeHTexRef);
-	
-	if (!set(env, pminMipmapLevelClamp, 0, (jfloat)nativePminMipmapLevelClamp)) return JCUDA_INTERNAL_ERROR;
-	if (!set(env, pmaxMipmapLevelClamp, 0, (jfloat)nativePmaxMipmapLevelClamp)) return JCUDA_INTERNAL_ERROR;
-	return result;
+    return result;
+*/
 }
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefGetMaxAnisotropyNative
- * Signature: ([ILjcuda/driver/CUtexref;)I
+ * Method:    cuStreamGetPriorityNative
+ * Signature: (Ljcuda/driver/CUstream;[I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetMaxAnisotropyNative
-  (JNIEnv *env, jclass cls, jintArray pMaxAniso, jobject hTexRef)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamGetPriorityNative
+  (JNIEnv *env, jclass cls, jobject hStream, jintArray priority)
 {
-    if (pMaxAniso == NULL)
+	// XXX Function is not available in CUDA 5.5
+	ThrowByName(env, "java/lang/UnsupportedOperaionException", 
+		"Function cuStreamGetPriority is not available in CUDA 5.5");
+	return JCUDA_INTERNAL_ERROR;
+/*
+    if (hStream == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pMaxAniso' is null for cuTexRefGetMaxAnisotropy");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuStreamGetPriority");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hTexRef == NULL)
+    if (priority == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetMaxAnisotropy");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'priority' is null for cuStreamGetPriority");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefGetMaxAnisotropy\n");
-
-    int nativePmaxAniso;
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
+    Logger::log(LOG_TRACE, "Executing cuStreamGetPriority\n");
 
-	int result = cuTexRefGetMaxAnisotropy(&nativePmaxAniso, nativeHTexRef);
-	
-	if (!set(env, pMaxAniso, 0, (jint)nativePmaxAniso)) return JCUDA_INTERNAL_ERROR;
-	return result;
+	CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+	int nativePriority;
+    int result = cuStreamGetPriority(nativeHStream, &nativePriority);
+    if (!set(env, priority, 0, nativePriority)) return JCUDA_INTERNAL_ERROR;
+    return result;
+*/
 }
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexRefGetFlagsNative
- * Signature: ([ILjcuda/driver/CUtexref;)I
+ * Method:    cuStreamGetFlagsNative
+ * Signature: (Ljcuda/driver/CUstream;[I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetFlagsNative
-  (JNIEnv *env, jclass cls, jintArray pFlags, jobject hTexRef)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamGetFlagsNative
+  (JNIEnv *env, jclass cls, jobject hStream, jintArray flags)
 {
-    if (pFlags == NULL)
+	// XXX Function is not available in CUDA 5.5
+	ThrowByName(env, "java/lang/UnsupportedOperaionException", 
+		"Function cuStreamGetFlags is not available in CUDA 5.5");
+	return JCUDA_INTERNAL_ERROR;
+/*
+    if (hStream == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pFlags' is null for cuTexRefGetFlags");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuStreamGetFlags");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hTexRef == NULL)
+    if (flags == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuTexRefGetFlags");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'flags' is null for cuStreamGetFlags");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuTexRefGetFlags\n");
-
-    unsigned int nativePFlags;
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-
-    int result = cuTexRefGetFlags(&nativePFlags, nativeHTexRef);
+    Logger::log(LOG_TRACE, "Executing cuStreamGetFlags\n");
 
-    if (!set(env, pFlags, 0, nativePFlags)) return JCUDA_INTERNAL_ERROR;
+	CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+	unsigned int nativeFlags;
+    int result = cuStreamGetFlags(nativeHStream, &nativeFlags);
+    if (!set(env, flags, 0, nativeFlags)) return JCUDA_INTERNAL_ERROR;
     return result;
+*/
 }
 
 
@@ -5185,1162 +11535,1409 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexRefGetFlagsNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuSurfRefSetArrayNative
- * Signature: (Ljcuda/driver/CUsurfref;Ljcuda/driver/CUarray;I)I
+ * Method:    cuStreamWaitEventNative
+ * Signature: (Ljcuda/driver/CUstream;Ljcuda/driver/CUevent;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuSurfRefSetArrayNative
-  (JNIEnv *env, jclass cls, jobject hSurfRef, jobject hArray, jint Flags)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamWaitEventNative
+  (JNIEnv *env, jclass cls, jobject hStream, jobject hEvent, jint Flags)
 {
-    if (hSurfRef == NULL)
+    /* May be null
+    if (hStream == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hSurfRef' is null for cuSurfRefSetArray");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuStreamWaitEvent");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hArray == NULL)
+    */
+    if (hEvent == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hArray' is null for cuSurfRefSetArray");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hEvent' is null for cuStreamWaitEvent");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuSurfRefSetArray\n");
+    Logger::log(LOG_TRACE, "Executing cuStreamWaitEvent\n");
 
-    CUsurfref nativeHSurfRef = (CUsurfref)getNativePointerValue(env, hSurfRef);
-    CUarray nativeHArray = (CUarray)getNativePointerValue(env, hArray);
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    CUevent nativeHEvent = (CUevent)getNativePointerValue(env, hEvent);
+
+    OperationGraph *graph = OperationGraph::getCapturing();
+    if (graph != NULL)
+    {
+        graph->addStreamWaitEvent(nativeHStream, nativeHEvent, (unsigned int)Flags);
+        return CUDA_SUCCESS;
+    }
+
+    int result = cuStreamWaitEvent(nativeHStream, nativeHEvent, (unsigned int)Flags);
 
-    int result = cuSurfRefSetArray(nativeHSurfRef, nativeHArray, (unsigned int)Flags);
     return result;
 }
 
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuSurfRefGetArrayNative
- * Signature: (Ljcuda/driver/CUarray;Ljcuda/driver/CUsurfref;)I
+ * Method:    cuStreamAddCallbackNative
+ * Signature: (Ljcuda/driver/CUstream;Ljcuda/driver/CUstreamCallback;Ljava/lang/Object;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuSurfRefGetArrayNative
-  (JNIEnv *env, jclass cls, jobject phArray, jobject hSurfRef)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamAddCallbackNative
+  (JNIEnv *env, jclass cls, jobject hStream, jobject callback, jobject userData, jint flags)
 {
-    if (phArray == NULL)
+    ThrowByName(env, "java/lang/UnsupportedOperationException", "cuStreamAddCallback is not yet supported");
+    return JCUDA_INTERNAL_ERROR;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuStreamQueryNative
+ * Signature: (Ljcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamQueryNative
+  (JNIEnv *env, jclass cls, jobject hStream)
+{
+    /* May be null
+    if (hStream == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phArray' is null for cuSurfRefGetArray");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuStreamQuery");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hSurfRef == NULL)
+    */
+    Logger::log(LOG_TRACE, "Executing cuStreamQuery\n");
+
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    int result = cuStreamQuery(nativeHStream);
+    if (result == CUDA_SUCCESS)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hSurfRef' is null for cuSurfRefGetArray");
-        return JCUDA_INTERNAL_ERROR;
+        bounceRing.completeReady(env);
     }
-    Logger::log(LOG_TRACE, "Executing cuSurfRefGetArray\n");
+    return result;
+}
 
-    CUarray nativePhArray;
-    CUsurfref nativeHSurfRef = (CUsurfref)getNativePointerValue(env, hSurfRef);
 
-    int result = cuSurfRefGetArray(&nativePhArray, nativeHSurfRef);
 
-    setNativePointerValue(env, phArray, (jlong)nativePhArray);
-    return result;
-}
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexObjectCreateNative
- * Signature: (Ljcuda/driver/CUtexObject;Ljcuda/driver/CUDA_RESOURCE_DESC;Ljcuda/driver/CUDA_TEXTURE_DESC;Ljcuda/driver/CUDA_RESOURCE_VIEW_DESC;)I
+ * Method:    cuStreamSynchronizeNative
+ * Signature: (Ljcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexObjectCreateNative
-  (JNIEnv *env, jclass cls, jobject pTexObject, jobject pResDesc, jobject pTexDesc, jobject pResViewDesc)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamSynchronizeNative
+  (JNIEnv *env, jclass cls, jobject hStream)
 {
-    if (pTexObject == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pTexObject' is null for cuTexObjectCreate");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (pResDesc == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pResDesc' is null for cuTexObjectCreate");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (pTexDesc == NULL)
+    /* May be null
+    if (hStream == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pTexDesc' is null for cuTexObjectCreate");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuStreamSynchronize");
         return JCUDA_INTERNAL_ERROR;
     }
-	// pResViewDesc may be NULL
-
-    Logger::log(LOG_TRACE, "Executing cuTexObjectCreate\n");
-
-    CUtexObject *nativePTexObject = NULL;
-    CUDA_RESOURCE_DESC nativePResDesc = getCUDA_RESOURCE_DESC(env, pResDesc);
-    CUDA_TEXTURE_DESC nativePTexDesc = getCUDA_TEXTURE_DESC(env, pTexDesc);
-    CUDA_RESOURCE_VIEW_DESC nativePResViewDesc;
-    CUDA_RESOURCE_VIEW_DESC *nativePResViewDescPointer = NULL;
-    if (pResViewDesc != NULL)
-    {
-        nativePResViewDesc = getCUDA_RESOURCE_VIEW_DESC(env, pResViewDesc);
-        nativePResViewDescPointer = &nativePResViewDesc;
-    }
-    
-    int result = cuTexObjectCreate(nativePTexObject, &nativePResDesc, &nativePTexDesc, nativePResViewDescPointer);
+    */
+    Logger::log(LOG_TRACE, "Executing cuStreamSynchronize\n");
 
-    setNativePointerValue(env, pTexObject, (jlong)nativePTexObject);
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    int result = cuStreamSynchronize(nativeHStream);
+    bounceRing.completeReady(env);
     return result;
 }
 
 
+
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexObjectDestroyNative
- * Signature: (Ljcuda/driver/CUtexObject;)I
+ * Method:    cuStreamDestroyNative
+ * Signature: (Ljcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexObjectDestroyNative
-  (JNIEnv *env, jclass cls, jobject texObject)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamDestroyNative
+  (JNIEnv *env, jclass cls, jobject hStream)
 {
-    if (texObject == NULL)
+    /* May be null
+    if (hStream == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'texObject' is null for cuTexObjectDestroy");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuStreamDestroy");
         return JCUDA_INTERNAL_ERROR;
     }
+    */
+    Logger::log(LOG_TRACE, "Executing cuStreamDestroy\n");
 
-    Logger::log(LOG_TRACE, "Executing cuTexObjectDestroy\n");
-
-    CUtexObject nativeTexObject = (CUtexObject)getNativePointerValue(env, texObject);
-
-	int result = cuTexObjectDestroy(nativeTexObject);
-
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    bounceRing.removeStream(env, nativeHStream);
+    int result = cuStreamDestroy(nativeHStream);
     return result;
 }
 
+
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexObjectGetResourceDescNative
- * Signature: (Ljcuda/driver/CUDA_RESOURCE_DESC;Ljcuda/driver/CUtexObject;)I
+ * Method:    cuStreamPoolCreateNative
+ * Signature: (Ljcuda/driver/CUstreamPool;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexObjectGetResourceDescNative
-  (JNIEnv *env, jclass cls, jobject pResDesc, jobject texObject)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamPoolCreateNative
+  (JNIEnv *env, jclass cls, jobject pool, jint capacity)
 {
-    if (pResDesc == NULL)
+    if (pool == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pResDesc' is null for cuTexObjectGetResourceDesc");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pool' is null for cuStreamPoolCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (texObject == NULL)
+    Logger::log(LOG_TRACE, "Executing cuStreamPoolCreate\n");
+
+    if (capacity < 0)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'texObject' is null for cuTexObjectGetResourceDesc");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_VALUE;
     }
-
-    Logger::log(LOG_TRACE, "Executing cuTexObjectGetResourceDesc\n");
-
-	CUDA_RESOURCE_DESC nativePResDesc;
-    CUtexObject nativeTexObject = (CUtexObject)getNativePointerValue(env, texObject);
-	int result = cuTexObjectGetResourceDesc(&nativePResDesc, nativeTexObject);
-
-	setCUDA_RESOURCE_DESC(env, pResDesc, nativePResDesc);
-
-    return result;
+    int leastPriority = 0;
+    int greatestPriority = 0;
+    int result = cuCtxGetStreamPriorityRange(&leastPriority, &greatestPriority);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    StreamPool *nativePool = new StreamPool(leastPriority, greatestPriority, (int)capacity);
+    setNativePointerValue(env, pool, (jlong)nativePool);
+    return CUDA_SUCCESS;
 }
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexObjectGetTextureDescNative
- * Signature: (Ljcuda/driver/CUDA_TEXTURE_DESC;Ljcuda/driver/CUtexObject;)I
+ * Method:    cuStreamPoolDestroyNative
+ * Signature: (Ljcuda/driver/CUstreamPool;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexObjectGetTextureDescNative
-  (JNIEnv *env, jclass cls, jobject pTexDesc, jobject texObject)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamPoolDestroyNative
+  (JNIEnv *env, jclass cls, jobject pool)
 {
-    if (pTexDesc == NULL)
+    if (pool == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pTexDesc' is null for cuTexObjectGetTextureDesc");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pool' is null for cuStreamPoolDestroy");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (texObject == NULL)
+    Logger::log(LOG_TRACE, "Executing cuStreamPoolDestroy\n");
+
+    StreamPool *nativePool = (StreamPool*)getNativePointerValue(env, pool);
+    if (nativePool == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'texObject' is null for cuTexObjectGetTextureDesc");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_HANDLE;
     }
-
-    Logger::log(LOG_TRACE, "Executing cuTexObjectGetTextureDesc\n");
-
-	CUDA_TEXTURE_DESC nativePTexDesc;
-    CUtexObject nativeTexObject = (CUtexObject)getNativePointerValue(env, texObject);
-	int result = cuTexObjectGetTextureDesc(&nativePTexDesc, nativeTexObject);
-
-	setCUDA_TEXTURE_DESC(env, pTexDesc, nativePTexDesc);
-
-    return result;
+    delete nativePool;
+    setNativePointerValue(env, pool, 0);
+    return CUDA_SUCCESS;
 }
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuTexObjectGetResourceViewDescNative
- * Signature: (Ljcuda/driver/CUDA_RESOURCE_VIEW_DESC;Ljcuda/driver/CUtexObject;)I
+ * Method:    cuStreamPoolAcquireNative
+ * Signature: (Ljcuda/driver/CUstreamPool;Ljcuda/driver/CUstream;II)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTexObjectGetResourceViewDescNative
-  (JNIEnv *env, jclass cls, jobject pResViewDesc, jobject texObject)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamPoolAcquireNative
+  (JNIEnv *env, jclass cls, jobject pool, jobject phStream, jint Flags, jint priority)
 {
-    if (pResViewDesc == NULL)
+    if (pool == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pResViewDesc' is null for cuTexObjectGetResourceViewDesc");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pool' is null for cuStreamPoolAcquire");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (texObject == NULL)
+    if (phStream == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'texObject' is null for cuTexObjectGetResourceViewDesc");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phStream' is null for cuStreamPoolAcquire");
         return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cuStreamPoolAcquire\n");
 
-    Logger::log(LOG_TRACE, "Executing cuTexObjectGetResourceViewDesc\n");
-
-	CUDA_RESOURCE_VIEW_DESC nativePResViewDesc;
-    CUtexObject nativeTexObject = (CUtexObject)getNativePointerValue(env, texObject);
-	int result = cuTexObjectGetResourceViewDesc(&nativePResViewDesc, nativeTexObject);
-
-	setCUDA_RESOURCE_VIEW_DESC(env, pResViewDesc, nativePResViewDesc);
-
+    StreamPool *nativePool = (StreamPool*)getNativePointerValue(env, pool);
+    if (nativePool == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    CUstream nativePhStream = NULL;
+    int result = nativePool->acquire(&nativePhStream, (unsigned int)Flags, (int)priority);
+    if (result == CUDA_SUCCESS)
+    {
+        setNativePointerValue(env, phStream, (jlong)nativePhStream);
+    }
     return result;
 }
 
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuSurfObjectCreateNative
- * Signature: (Ljcuda/driver/CUsurfObject;Ljcuda/driver/CUDA_RESOURCE_DESC;)I
+ * Method:    cuStreamPoolReleaseNative
+ * Signature: (Ljcuda/driver/CUstreamPool;Ljcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuSurfObjectCreateNative
-  (JNIEnv *env, jclass cls, jobject pSurfObject, jobject pResDesc)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamPoolReleaseNative
+  (JNIEnv *env, jclass cls, jobject pool, jobject hStream)
 {
-    if (pSurfObject == NULL)
+    if (pool == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pSurfObject' is null for cuSurfObjectCreate");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pool' is null for cuStreamPoolRelease");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (pResDesc == NULL)
+    if (hStream == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pResDesc' is null for cuSurfObjectCreate");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuStreamPoolRelease");
         return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cuStreamPoolRelease\n");
 
-    Logger::log(LOG_TRACE, "Executing cuSurfObjectCreate\n");
+    StreamPool *nativePool = (StreamPool*)getNativePointerValue(env, pool);
+    if (nativePool == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    return nativePool->release(nativeHStream);
+}
 
-    CUsurfObject *nativePSurfObject = NULL;
-	CUDA_RESOURCE_DESC nativePResDesc = getCUDA_RESOURCE_DESC(env, pResDesc);
 
-	int result = cuSurfObjectCreate(nativePSurfObject, &nativePResDesc);
 
-	setNativePointerValue(env, pSurfObject, (jlong)nativePSurfObject);
 
-    return result;
-}
-	  
+/**
+ * The data of a task that was submitted with cuTaskSchedulerSubmit:
+ * Global references to the callback and the user object
+ */
+struct TaskCallbackData
+{
+    jobject callback;
+    jobject userData;
+};
 
-/*
- * Class:     jcuda_driver_JCudaDriver
- * Method:    cuSurfObjectDestroyNative
- * Signature: (Ljcuda/driver/CUsurfObject;)I
+/**
+ * The TaskFunction for callbacks: Calls the CUtaskCallback with
+ * new CUcontext and CUstream objects for the given handles
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuSurfObjectDestroyNative
-  (JNIEnv *env, jclass cls, jobject surfObject)
+CUresult runTaskCallback(void *userData, int device, CUcontext context, CUstream stream)
 {
-    if (surfObject == NULL)
+    JNIEnv *env = getTaskWorkerEnv();
+    if (env == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pSurfObject' is null for cuSurfObjectDestroy");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_UNKNOWN;
     }
+    TaskCallbackData *data = (TaskCallbackData*)userData;
+    jobject javaContext = env->NewObject(CUcontext_class, CUcontext_constructor);
+    jobject javaStream = env->NewObject(CUstream_class, CUstream_constructor);
+    if (javaContext == NULL || javaStream == NULL)
+    {
+        env->ExceptionClear();
+        return CUDA_ERROR_OUT_OF_MEMORY;
+    }
+    setNativePointerValue(env, javaContext, (jlong)context);
+    setNativePointerValue(env, javaStream, (jlong)stream);
+    env->CallVoidMethod(data->callback, CUtaskCallback_call,
+        (jint)device, javaContext, javaStream, data->userData);
 
-    Logger::log(LOG_TRACE, "Executing cuSurfObjectDestroy\n");
-
-	CUsurfObject nativeSurfObject = (CUsurfObject)getNativePointerValue(env, surfObject);
-
-	int result = cuSurfObjectDestroy(nativeSurfObject);
+    // The worker thread stays attached, so the local
+    // references have to be deleted explicitly
+    env->DeleteLocalRef(javaContext);
+    env->DeleteLocalRef(javaStream);
+    if (env->ExceptionCheck())
+    {
+        Logger::log(LOG_ERROR, "Exception in task callback\n");
+        env->ExceptionDescribe();
+        env->ExceptionClear();
+        return CUDA_ERROR_UNKNOWN;
+    }
+    return CUDA_SUCCESS;
+}
 
-    return result;
+/**
+ * The TaskCleanupFunction for callbacks
+ */
+void deleteTaskCallback(void *userData)
+{
+    TaskCallbackData *data = (TaskCallbackData*)userData;
+    JNIEnv *env = getTaskWorkerEnv();
+    if (env != NULL)
+    {
+        env->DeleteGlobalRef(data->callback);
+        if (data->userData != NULL)
+        {
+            env->DeleteGlobalRef(data->userData);
+        }
+    }
+    delete data;
 }
 
+/**
+ * The ContextDestroyFunction of the task and priority schedulers:
+ * Destroys the given context like cuCtxDestroy, releasing all
+ * associated resources
+ */
+CUresult destroyTaskContext(CUcontext context)
+{
+    JNIEnv *env = getTaskWorkerEnv();
+    if (env == NULL)
+    {
+        return cuCtxDestroy(context);
+    }
+    return (CUresult)destroyContext(env, context, false);
+}
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuSurfObjectGetResourceDescNative
- * Signature: (Ljcuda/driver/CUDA_RESOURCE_DESC;Ljcuda/driver/CUsurfObject;)I
+ * Method:    cuTaskSchedulerCreateNative
+ * Signature: (Ljcuda/driver/CUtaskScheduler;II)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuSurfObjectGetResourceDescNative
-  (JNIEnv *env, jclass cls, jobject pResDesc, jobject surfObject)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskSchedulerCreateNative
+  (JNIEnv *env, jclass cls, jobject scheduler, jint Flags, jint streamsPerDevice)
 {
-    if (pResDesc == NULL)
+    if (scheduler == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pResDesc' is null for cuSurfObjectGetResourceDesc");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'scheduler' is null for cuTaskSchedulerCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (surfObject == NULL)
+    Logger::log(LOG_TRACE, "Executing cuTaskSchedulerCreate\n");
+
+    if (streamsPerDevice <= 0)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'surfObject' is null for cuSurfObjectGetResourceDesc");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_VALUE;
     }
-
-    Logger::log(LOG_TRACE, "Executing cuSurfObjectGetResourceDesc\n");
-
-	CUDA_RESOURCE_DESC nativePResDesc;
-	CUsurfObject nativeSurfObject = (CUsurfObject)getNativePointerValue(env, surfObject);
-
-	int result = cuSurfObjectGetResourceDesc(&nativePResDesc, nativeSurfObject);
-
-	setCUDA_RESOURCE_DESC(env, pResDesc, nativePResDesc);
-
-    return result;
-
+    TaskScheduler *nativeScheduler = new TaskScheduler((unsigned int)Flags, (int)streamsPerDevice,
+        &detachTaskWorker, &destroyTaskContext);
+    CUresult result = nativeScheduler->init();
+    if (result != CUDA_SUCCESS)
+    {
+        delete nativeScheduler;
+        return result;
+    }
+    setNativePointerValue(env, scheduler, (jlong)nativeScheduler);
+    return CUDA_SUCCESS;
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuDeviceCanAccessPeerNative
- * Signature: ([ILjcuda/driver/CUdevice;Ljcuda/driver/CUdevice;)I
+ * Method:    cuTaskSchedulerDestroyNative
+ * Signature: (Ljcuda/driver/CUtaskScheduler;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuDeviceCanAccessPeerNative
-  (JNIEnv *env, jclass cls, jintArray canAccessPeer, jobject dev, jobject peerDev)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskSchedulerDestroyNative
+  (JNIEnv *env, jclass cls, jobject scheduler)
 {
-    if (dev == NULL)
+    if (scheduler == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dev' is null for cuDeviceCanAccessPeer");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'scheduler' is null for cuTaskSchedulerDestroy");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (peerDev == NULL)
+    Logger::log(LOG_TRACE, "Executing cuTaskSchedulerDestroy\n");
+
+    TaskScheduler *nativeScheduler = (TaskScheduler*)getNativePointerValue(env, scheduler);
+    if (nativeScheduler == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerDev' is null for cuDeviceCanAccessPeer");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_HANDLE;
     }
-    Logger::log(LOG_TRACE, "Executing cuDeviceCanAccessPeer\n");
-
-    CUdevice nativeDev = (CUdevice)(intptr_t)getNativePointerValue(env, dev);
-    CUdevice nativePeerDev = (CUdevice)(intptr_t)getNativePointerValue(env, peerDev);
-    int nativeCanAccessPeer;
-
-    int result = cuDeviceCanAccessPeer(&nativeCanAccessPeer, nativeDev, nativePeerDev);
 
-    if (!set(env, canAccessPeer, 0, nativeCanAccessPeer)) return JCUDA_INTERNAL_ERROR;
-    return result;
+    // The destructor joins the worker threads, so it would wait
+    // forever when it was called from within a task
+    if (nativeScheduler->isWorkerThread())
+    {
+        return CUDA_ERROR_NOT_PERMITTED;
+    }
+    delete nativeScheduler;
+    setNativePointerValue(env, scheduler, (jlong)0);
+    return CUDA_SUCCESS;
 }
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuCtxEnablePeerAccessNative
- * Signature: (Ljcuda/driver/CUcontext;I)I
+ * Method:    cuTaskSchedulerGetDeviceCountNative
+ * Signature: (Ljcuda/driver/CUtaskScheduler;[I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxEnablePeerAccessNative
-  (JNIEnv *env, jclass cls, jobject peerContext, jint Flags)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskSchedulerGetDeviceCountNative
+  (JNIEnv *env, jclass cls, jobject scheduler, jintArray count)
 {
-    if (peerContext == NULL)
+    if (scheduler == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerContext' is null for cuCtxEnablePeerAccess");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'scheduler' is null for cuTaskSchedulerGetDeviceCount");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuCtxEnablePeerAccess\n");
+    if (count == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'count' is null for cuTaskSchedulerGetDeviceCount");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTaskSchedulerGetDeviceCount\n");
 
-    CUcontext nativePeerContext = (CUcontext)getNativePointerValue(env, peerContext);
-    int result = cuCtxEnablePeerAccess(nativePeerContext, (unsigned int)Flags);
-    return result;
+    TaskScheduler *nativeScheduler = (TaskScheduler*)getNativePointerValue(env, scheduler);
+    if (nativeScheduler == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    if (!set(env, count, 0, (jint)nativeScheduler->getDeviceCount())) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
 }
 
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuCtxDisablePeerAccessNative
- * Signature: (Ljcuda/driver/CUcontext;)I
+ * Method:    cuTaskSchedulerGetContextNative
+ * Signature: (Ljcuda/driver/CUtaskScheduler;ILjcuda/driver/CUcontext;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxDisablePeerAccessNative
-  (JNIEnv *env, jclass cls, jobject peerContext)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskSchedulerGetContextNative
+  (JNIEnv *env, jclass cls, jobject scheduler, jint device, jobject pctx)
 {
-    if (peerContext == NULL)
+    if (scheduler == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerContext' is null for cuCtxDisablePeerAccess");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'scheduler' is null for cuTaskSchedulerGetContext");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuCtxDisablePeerAccess\n");
+    if (pctx == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pctx' is null for cuTaskSchedulerGetContext");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTaskSchedulerGetContext\n");
 
-    CUcontext nativePeerContext = (CUcontext)getNativePointerValue(env, peerContext);
-    int result = cuCtxDisablePeerAccess(nativePeerContext);
-    return result;
+    TaskScheduler *nativeScheduler = (TaskScheduler*)getNativePointerValue(env, scheduler);
+    if (nativeScheduler == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    CUcontext nativePctx = nativeScheduler->getContext((int)device);
+    if (nativePctx == NULL)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    setNativePointerValue(env, pctx, (jlong)nativePctx);
+    return CUDA_SUCCESS;
 }
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemPeerRegisterNative
- * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUcontext;I)I
+ * Method:    cuTaskSchedulerSubmitNative
+ * Signature: (Ljcuda/driver/CUtaskScheduler;Ljcuda/driver/CUtask;Ljcuda/driver/CUtaskCallback;Ljava/lang/Object;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemPeerRegisterNative
-  (JNIEnv *env, jclass cls, jobject peerPointer, jobject peerContext, jint Flags)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskSchedulerSubmitNative
+  (JNIEnv *env, jclass cls, jobject scheduler, jobject task, jobject callback, jobject userData, jint device)
 {
-    if (peerPointer == NULL)
+    if (scheduler == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerPointer' is null for cuMemPeerRegister");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'scheduler' is null for cuTaskSchedulerSubmit");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (peerContext == NULL)
+    if (callback == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerContext' is null for cuMemPeerRegister");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'callback' is null for cuTaskSchedulerSubmit");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemPeerRegister\n");
+    Logger::log(LOG_TRACE, "Executing cuTaskSchedulerSubmit\n");
 
+    TaskScheduler *nativeScheduler = (TaskScheduler*)getNativePointerValue(env, scheduler);
+    if (nativeScheduler == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    TaskCallbackData *data = new TaskCallbackData();
+    data->callback = env->NewGlobalRef(callback);
+    data->userData = NULL;
+    if (userData != NULL)
+    {
+        data->userData = env->NewGlobalRef(userData);
+    }
+    SchedulerTask *nativeTask = NULL;
+    CUresult result = nativeScheduler->submit(&runTaskCallback, &deleteTaskCallback,
+        data, (int)device, task == NULL ? NULL : &nativeTask);
+    if (result != CUDA_SUCCESS)
+    {
+        deleteTaskCallback(data);
+        return result;
+    }
+    if (task != NULL)
+    {
+        setNativePointerValue(env, task, (jlong)nativeTask);
+    }
     return CUDA_SUCCESS;
-    /* Removed in CUDA 4.0RC2
-    CUdeviceptr nativePeerPointer = (CUdeviceptr)getPointer(env, peerPointer);
-    CUcontext nativePeerContext = (CUcontext)getNativePointerValue(env, peerContext);
-    int result = cuMemPeerRegister(nativePeerPointer, nativePeerContext, (unsigned int)Flags);
-    return result;
-    */
 }
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemPeerUnregisterNative
- * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUcontext;)I
+ * Method:    cuTaskSchedulerSynchronizeNative
+ * Signature: (Ljcuda/driver/CUtaskScheduler;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemPeerUnregisterNative
-  (JNIEnv *env, jclass cls, jobject peerPointer, jobject peerContext)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskSchedulerSynchronizeNative
+  (JNIEnv *env, jclass cls, jobject scheduler)
 {
-    if (peerPointer == NULL)
+    if (scheduler == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerPointer' is null for cuMemPeerUnregister");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'scheduler' is null for cuTaskSchedulerSynchronize");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (peerContext == NULL)
+    Logger::log(LOG_TRACE, "Executing cuTaskSchedulerSynchronize\n");
+
+    TaskScheduler *nativeScheduler = (TaskScheduler*)getNativePointerValue(env, scheduler);
+    if (nativeScheduler == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerContext' is null for cuMemPeerUnregister");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_HANDLE;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemPeerUnregister\n");
-
-    return CUDA_SUCCESS;
-    /* Removed in CUDA 4.0RC2
-    CUdeviceptr nativePeerPointer = (CUdeviceptr)getPointer(env, peerPointer);
-    CUcontext nativePeerContext = (CUcontext)getNativePointerValue(env, peerContext);
-    int result = cuMemPeerUnregister(nativePeerPointer, nativePeerContext);
-    return result;
-    */
+    return nativeScheduler->synchronize();
 }
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemPeerGetDevicePointerNative
- * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUcontext;I)I
+ * Method:    cuTaskSchedulerGetStatisticsNative
+ * Signature: (Ljcuda/driver/CUtaskScheduler;I[J[J)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemPeerGetDevicePointerNative
-  (JNIEnv *env, jclass cls, jobject pdptr, jobject peerPointer, jobject peerContext, jint Flags)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskSchedulerGetStatisticsNative
+  (JNIEnv *env, jclass cls, jobject scheduler, jint device, jlongArray executed, jlongArray stolen)
 {
-    if (pdptr == NULL)
+    if (scheduler == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pdptr' is null for cuMemPeerGetDevicePointer");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'scheduler' is null for cuTaskSchedulerGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (peerPointer == NULL)
+    if (executed == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerPointer' is null for cuMemPeerGetDevicePointer");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'executed' is null for cuTaskSchedulerGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (peerContext == NULL)
+    if (stolen == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'peerContext' is null for cuMemPeerGetDevicePointer");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'stolen' is null for cuTaskSchedulerGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuMemPeerGetDevicePointer\n");
+    Logger::log(LOG_TRACE, "Executing cuTaskSchedulerGetStatistics\n");
 
+    TaskScheduler *nativeScheduler = (TaskScheduler*)getNativePointerValue(env, scheduler);
+    if (nativeScheduler == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    jcuda_int64 nativeExecuted = 0;
+    jcuda_int64 nativeStolen = 0;
+    CUresult result = nativeScheduler->getStatistics((int)device, &nativeExecuted, &nativeStolen);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    if (!set(env, executed, 0, (jlong)nativeExecuted)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, stolen, 0, (jlong)nativeStolen)) return JCUDA_INTERNAL_ERROR;
     return CUDA_SUCCESS;
-    /* Removed in CUDA 4.0RC2
-    CUdeviceptr nativePeerPointer = (CUdeviceptr)getPointer(env, peerPointer);
-    CUcontext nativePeerContext = (CUcontext)getNativePointerValue(env, peerContext);
-    CUdeviceptr nativePdptr = NULL;
-    int result = cuMemPeerGetDevicePointer(&nativePdptr, nativePeerPointer, nativePeerContext, (unsigned int)Flags);
-    setPointer(env, pdptr, (jlong)nativePdptr);
-    return result;
-    */
 }
 
 
-
-
-
-
-
-
-
-
-
-
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuParamSetSizeNative
- * Signature: (Ljcuda/driver/CUfunction;I)I
+ * Method:    cuPrioritySchedulerCreateNative
+ * Signature: (Ljcuda/driver/CUpriorityScheduler;IIII)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuParamSetSizeNative
-  (JNIEnv *env, jclass cls, jobject hfunc, jint numbytes)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPrioritySchedulerCreateNative
+  (JNIEnv *env, jclass cls, jobject scheduler, jint Flags, jint criticalStreams, jint batchStreams, jint maxBatchInFlight)
 {
-    if (hfunc == NULL)
+    if (scheduler == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuParamSetSize");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'scheduler' is null for cuPrioritySchedulerCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuParamSetSize\n");
+    Logger::log(LOG_TRACE, "Executing cuPrioritySchedulerCreate\n");
 
-    CUfunction nativeHfunc = (CUfunction)getNativePointerValue(env, hfunc);
-    int result = cuParamSetSize(nativeHfunc, (unsigned int)numbytes);
-    return result;
+    if (criticalStreams <= 0 || batchStreams <= 0 || maxBatchInFlight <= 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    PriorityScheduler *nativeScheduler = new PriorityScheduler((unsigned int)Flags,
+        (int)criticalStreams, (int)batchStreams, (int)maxBatchInFlight,
+        &detachTaskWorker, &destroyTaskContext);
+    CUresult result = nativeScheduler->init();
+    if (result != CUDA_SUCCESS)
+    {
+        delete nativeScheduler;
+        return result;
+    }
+    setNativePointerValue(env, scheduler, (jlong)nativeScheduler);
+    return CUDA_SUCCESS;
 }
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuParamSetiNative
- * Signature: (Ljcuda/driver/CUfunction;II)I
+ * Method:    cuPrioritySchedulerDestroyNative
+ * Signature: (Ljcuda/driver/CUpriorityScheduler;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuParamSetiNative
-  (JNIEnv *env, jclass cls, jobject hfunc, jint offset, jint value)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPrioritySchedulerDestroyNative
+  (JNIEnv *env, jclass cls, jobject scheduler)
 {
-    if (hfunc == NULL)
+    if (scheduler == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuParamSeti");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'scheduler' is null for cuPrioritySchedulerDestroy");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuParamSeti\n");
-
-    CUfunction nativeHfunc = (CUfunction)getNativePointerValue(env, hfunc);
-    int result = cuParamSeti(nativeHfunc, (int)offset, (unsigned int)value);
-    return result;
-}
-
-
-
+    Logger::log(LOG_TRACE, "Executing cuPrioritySchedulerDestroy\n");
 
-/*
- * Class:     jcuda_driver_JCudaDriver
- * Method:    cuParamSetfNative
- * Signature: (Ljcuda/driver/CUfunction;IF)I
- */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuParamSetfNative
-  (JNIEnv *env, jclass cls, jobject hfunc, jint offset, jfloat value)
-{
-    if (hfunc == NULL)
+    PriorityScheduler *nativeScheduler = (PriorityScheduler*)getNativePointerValue(env, scheduler);
+    if (nativeScheduler == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuParamSetf");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_HANDLE;
     }
-    Logger::log(LOG_TRACE, "Executing cuParamSetf\n");
 
-    CUfunction nativeHfunc = (CUfunction)getNativePointerValue(env, hfunc);
-    int result = cuParamSetf(nativeHfunc, (int)offset, (float)value);
-    return result;
+    // The destructor joins the worker threads, so it would wait
+    // forever when it was called from within a task
+    if (nativeScheduler->isWorkerThread())
+    {
+        return CUDA_ERROR_NOT_PERMITTED;
+    }
+    delete nativeScheduler;
+    setNativePointerValue(env, scheduler, (jlong)0);
+    return CUDA_SUCCESS;
 }
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuParamSetvNative
- * Signature: (Ljcuda/driver/CUfunction;ILjcuda/Pointer;I)I
+ * Method:    cuPrioritySchedulerGetDeviceCountNative
+ * Signature: (Ljcuda/driver/CUpriorityScheduler;[I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuParamSetvNative
-  (JNIEnv *env, jclass cls, jobject hfunc, jint offset, jobject ptr, jint numbytes)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPrioritySchedulerGetDeviceCountNative
+  (JNIEnv *env, jclass cls, jobject scheduler, jintArray count)
 {
-    if (hfunc == NULL)
+    if (scheduler == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuParamSetv");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'scheduler' is null for cuPrioritySchedulerGetDeviceCount");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (ptr == NULL)
+    if (count == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ptr' is null for cuParamSetv");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'count' is null for cuPrioritySchedulerGetDeviceCount");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuParamSetv\n");
-
-    CUfunction nativeHfunc = (CUfunction)getNativePointerValue(env, hfunc);
+    Logger::log(LOG_TRACE, "Executing cuPrioritySchedulerGetDeviceCount\n");
 
-    PointerData *ptrPointerData = initPointerData(env, ptr);
-    if (ptrPointerData == NULL)
+    PriorityScheduler *nativeScheduler = (PriorityScheduler*)getNativePointerValue(env, scheduler);
+    if (nativeScheduler == NULL)
     {
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_HANDLE;
     }
-
-    int result = cuParamSetv(nativeHfunc, (int)offset, (void*)ptrPointerData->getPointer(env), (unsigned int)numbytes);
-
-    if (!releasePointerData(env, ptrPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
-
-    return result;
+    if (!set(env, count, 0, nativeScheduler->getDeviceCount())) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
 }
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuParamSetTexRefNative
- * Signature: (Ljcuda/driver/CUfunction;ILjcuda/driver/CUtexref;)I
+ * Method:    cuPrioritySchedulerGetContextNative
+ * Signature: (Ljcuda/driver/CUpriorityScheduler;ILjcuda/driver/CUcontext;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuParamSetTexRefNative
-  (JNIEnv *env, jclass cls, jobject hfunc, jint texunit, jobject hTexRef)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPrioritySchedulerGetContextNative
+  (JNIEnv *env, jclass cls, jobject scheduler, jint device, jobject pctx)
 {
-    if (hfunc == NULL)
+    if (scheduler == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuParamSetTexRef");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'scheduler' is null for cuPrioritySchedulerGetContext");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hTexRef == NULL)
+    if (pctx == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hTexRef' is null for cuParamSetTexRef");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pctx' is null for cuPrioritySchedulerGetContext");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuParamSetTexRef\n");
+    Logger::log(LOG_TRACE, "Executing cuPrioritySchedulerGetContext\n");
 
-    CUfunction nativeHfunc = (CUfunction)getNativePointerValue(env, hfunc);
-    CUtexref nativeHTexRef = (CUtexref)getNativePointerValue(env, hTexRef);
-
-    int result = cuParamSetTexRef(nativeHfunc, (int)texunit, nativeHTexRef);
-    return result;
+    PriorityScheduler *nativeScheduler = (PriorityScheduler*)getNativePointerValue(env, scheduler);
+    if (nativeScheduler == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    CUcontext nativeContext = nativeScheduler->getContext((int)device);
+    if (nativeContext == NULL)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    setNativePointerValue(env, pctx, (jlong)nativeContext);
+    return CUDA_SUCCESS;
 }
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuLaunchNative
- * Signature: (Ljcuda/driver/CUfunction;)I
+ * Method:    cuPrioritySchedulerSubmitNative
+ * Signature: (Ljcuda/driver/CUpriorityScheduler;Ljcuda/driver/CUtask;Ljcuda/driver/CUtaskCallback;Ljava/lang/Object;II)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLaunchNative
-  (JNIEnv *env, jclass cls, jobject f)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPrioritySchedulerSubmitNative
+  (JNIEnv *env, jclass cls, jobject scheduler, jobject task, jobject callback, jobject userData, jint device, jint latencyClass)
 {
-    if (f == NULL)
+    if (scheduler == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'f' is null for cuLaunch");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'scheduler' is null for cuPrioritySchedulerSubmit");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuLaunch\n");
+    if (callback == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'callback' is null for cuPrioritySchedulerSubmit");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuPrioritySchedulerSubmit\n");
 
-    CUfunction nativeF = (CUfunction)getNativePointerValue(env, f);
-    int result = cuLaunch(nativeF);
-    return result;
+    PriorityScheduler *nativeScheduler = (PriorityScheduler*)getNativePointerValue(env, scheduler);
+    if (nativeScheduler == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    TaskCallbackData *data = new TaskCallbackData();
+    data->callback = env->NewGlobalRef(callback);
+    data->userData = NULL;
+    if (userData != NULL)
+    {
+        data->userData = env->NewGlobalRef(userData);
+    }
+    SchedulerTask *nativeTask = NULL;
+    CUresult result = nativeScheduler->submit(&runTaskCallback, &deleteTaskCallback,
+        data, (int)device, (int)latencyClass, task == NULL ? NULL : &nativeTask);
+    if (result != CUDA_SUCCESS)
+    {
+        deleteTaskCallback(data);
+        return result;
+    }
+    if (task != NULL)
+    {
+        setNativePointerValue(env, task, (jlong)nativeTask);
+    }
+    return CUDA_SUCCESS;
 }
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuLaunchGridNative
- * Signature: (Ljcuda/driver/CUfunction;II)I
+ * Method:    cuPrioritySchedulerSynchronizeNative
+ * Signature: (Ljcuda/driver/CUpriorityScheduler;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLaunchGridNative
-  (JNIEnv *env, jclass cls, jobject f, jint grid_width, jint grid_height)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPrioritySchedulerSynchronizeNative
+  (JNIEnv *env, jclass cls, jobject scheduler)
 {
-    if (f == NULL)
+    if (scheduler == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'f' is null for cuLaunchGrid");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'scheduler' is null for cuPrioritySchedulerSynchronize");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuLaunchGrid\n");
+    Logger::log(LOG_TRACE, "Executing cuPrioritySchedulerSynchronize\n");
 
-    CUfunction nativeF = (CUfunction)getNativePointerValue(env, f);
-    int result = cuLaunchGrid(nativeF, (int)grid_width, (int)grid_height);
-    return result;
+    PriorityScheduler *nativeScheduler = (PriorityScheduler*)getNativePointerValue(env, scheduler);
+    if (nativeScheduler == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    return nativeScheduler->synchronize();
 }
 
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuLaunchGridAsyncNative
- * Signature: (Ljcuda/driver/CUfunction;IILjcuda/driver/CUstream;)I
+ * Method:    cuPrioritySchedulerGetStatisticsNative
+ * Signature: (Ljcuda/driver/CUpriorityScheduler;I[J[J[J)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLaunchGridAsyncNative
-  (JNIEnv *env, jclass cls, jobject f, jint grid_width, jint grid_height, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPrioritySchedulerGetStatisticsNative
+  (JNIEnv *env, jclass cls, jobject scheduler, jint latencyClass, jlongArray launched, jlongArray totalQueueDelay, jlongArray maxQueueDelay)
 {
-    if (f == NULL)
+    if (scheduler == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'f' is null for cuLaunchGridAsync");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'scheduler' is null for cuPrioritySchedulerGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    /* May be null
-    if (hStream == NULL)
+    if (launched == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuLaunchGridAsync");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'launched' is null for cuPrioritySchedulerGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    */
-    Logger::log(LOG_TRACE, "Executing cuLaunchGridAsync\n");
-
-    CUfunction nativeF = (CUfunction)getNativePointerValue(env, f);
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
-    int result = cuLaunchGridAsync(nativeF, (int)grid_width, (int)grid_height, nativeHStream);
-    return result;
+    if (totalQueueDelay == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'totalQueueDelay' is null for cuPrioritySchedulerGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (maxQueueDelay == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'maxQueueDelay' is null for cuPrioritySchedulerGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuPrioritySchedulerGetStatistics\n");
 
+    PriorityScheduler *nativeScheduler = (PriorityScheduler*)getNativePointerValue(env, scheduler);
+    if (nativeScheduler == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    jcuda_int64 nativeLaunched = 0;
+    jcuda_int64 nativeTotalQueueDelay = 0;
+    jcuda_int64 nativeMaxQueueDelay = 0;
+    CUresult result = nativeScheduler->getStatistics((int)latencyClass,
+        &nativeLaunched, &nativeTotalQueueDelay, &nativeMaxQueueDelay);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    if (!set(env, launched, 0, (jlong)nativeLaunched)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, totalQueueDelay, 0, (jlong)nativeTotalQueueDelay)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, maxQueueDelay, 0, (jlong)nativeMaxQueueDelay)) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
 }
 
 
+/**
+ * The data of an eviction callback that was added with
+ * cuMemGovernorAddEvictionCallback: Global references to the
+ * callback and the user object
+ */
+struct EvictionCallbackData
+{
+    jobject callback;
+    jobject userData;
+};
 
-
-/*
- * Class:     jcuda_driver_JCudaDriver
- * Method:    cuEventCreateNative
- * Signature: (Ljcuda/driver/CUevent;I)I
+/**
+ * The EvictionFunction for callbacks: Calls the CUevictionCallback on
+ * the thread that is about to allocate memory. This may be a native
+ * worker thread, which is then attached to the VM.
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventCreateNative
-  (JNIEnv *env, jclass cls, jobject phEvent, jint Flags)
+size_t runEvictionCallback(void *userData, int device, size_t bytes)
 {
-    if (phEvent == NULL)
+    JNIEnv *env = getTaskWorkerEnv();
+    if (env == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phEvent' is null for cuEventCreate");
-        return JCUDA_INTERNAL_ERROR;
+        return 0;
     }
-    Logger::log(LOG_TRACE, "Executing cuEventCreate\n");
+    EvictionCallbackData *data = (EvictionCallbackData*)userData;
+    jlong released = env->CallLongMethod(data->callback, CUevictionCallback_evict,
+        (jint)device, (jlong)bytes, data->userData);
+    if (env->ExceptionCheck())
+    {
+        Logger::log(LOG_ERROR, "Exception in eviction callback\n");
+        env->ExceptionDescribe();
+        env->ExceptionClear();
+        return 0;
+    }
+    return released > 0 ? (size_t)released : 0;
+}
 
-    CUevent nativePhEvent;
-    int result = cuEventCreate(&nativePhEvent, Flags);
-    setNativePointerValue(env, phEvent, (jlong)nativePhEvent);
-    return result;
+/**
+ * The EvictionCleanupFunction for callbacks
+ */
+void deleteEvictionCallback(void *userData)
+{
+    EvictionCallbackData *data = (EvictionCallbackData*)userData;
+    JNIEnv *env = getTaskWorkerEnv();
+    if (env != NULL)
+    {
+        env->DeleteGlobalRef(data->callback);
+        if (data->userData != NULL)
+        {
+            env->DeleteGlobalRef(data->userData);
+        }
+    }
+    delete data;
 }
 
-
-
+/**
+ * The EvictionMatchFunction for callbacks, matching the callback
+ * object that is given as the argument
+ */
+bool matchEvictionCallback(void *userData, void *argument)
+{
+    EvictionCallbackData *data = (EvictionCallbackData*)userData;
+    JNIEnv *env = getTaskWorkerEnv();
+    return env != NULL && env->IsSameObject(data->callback, (jobject)argument);
+}
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuEventRecordNative
- * Signature: (Ljcuda/driver/CUevent;Ljcuda/driver/CUstream;)I
+ * Method:    cuMemGovernorEnableNative
+ * Signature: (JJJII)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventRecordNative
-  (JNIEnv *env, jclass cls, jobject hEvent, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemGovernorEnableNative
+  (JNIEnv *env, jclass cls, jlong lowWatermark, jlong criticalWatermark, jlong largeAllocationSize, jint pollIntervalMs, jint throttleTimeoutMs)
 {
-    if (hEvent == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hEvent' is null for cuEventRecord");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    /* May be null
-    if (hStream == NULL)
+    Logger::log(LOG_TRACE, "Executing cuMemGovernorEnable\n");
+
+    if (lowWatermark < 0 || criticalWatermark < 0 || criticalWatermark > lowWatermark ||
+        largeAllocationSize < 0 || pollIntervalMs < 0 || throttleTimeoutMs < 0)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuEventRecord");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_VALUE;
     }
-    */
-    Logger::log(LOG_TRACE, "Executing cuEventRecord\n");
 
-    CUevent nativeHEvent = (CUevent)getNativePointerValue(env, hEvent);
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
-    int result = cuEventRecord(nativeHEvent, nativeHStream);
-    return result;
+    // The sizes of freed allocations are looked up in the registry
+    allocationRegistry.activate();
+    MemoryGovernor::enable((size_t)lowWatermark, (size_t)criticalWatermark,
+        (size_t)largeAllocationSize, (int)pollIntervalMs, (int)throttleTimeoutMs);
+    return CUDA_SUCCESS;
 }
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemGovernorDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemGovernorDisableNative
+  (JNIEnv *env, jclass cls)
+{
+    Logger::log(LOG_TRACE, "Executing cuMemGovernorDisable\n");
 
-
+    MemoryGovernor::disable();
+    return CUDA_SUCCESS;
+}
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuEventQueryNative
- * Signature: (Ljcuda/driver/CUevent;)I
+ * Method:    cuMemGovernorAddEvictionCallbackNative
+ * Signature: (Ljcuda/driver/CUevictionCallback;Ljava/lang/Object;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventQueryNative
-  (JNIEnv *env, jclass cls, jobject hEvent)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemGovernorAddEvictionCallbackNative
+  (JNIEnv *env, jclass cls, jobject callback, jobject userData, jint device)
 {
-    if (hEvent == NULL)
+    if (callback == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hEvent' is null for cuEventQuery");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'callback' is null for cuMemGovernorAddEvictionCallback");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuEventQuery\n");
+    Logger::log(LOG_TRACE, "Executing cuMemGovernorAddEvictionCallback\n");
 
-    CUevent nativeHEvent = (CUevent)getNativePointerValue(env, hEvent);
-    int result = cuEventQuery(nativeHEvent);
-    return result;
+    if (device < -1)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    EvictionCallbackData *data = new EvictionCallbackData();
+    data->callback = env->NewGlobalRef(callback);
+    data->userData = NULL;
+    if (userData != NULL)
+    {
+        data->userData = env->NewGlobalRef(userData);
+    }
+    MemoryGovernor::addEvictionFunction(&runEvictionCallback, &deleteEvictionCallback, data, (int)device, false);
+    return CUDA_SUCCESS;
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuEventSynchronizeNative
- * Signature: (Ljcuda/driver/CUevent;)I
+ * Method:    cuMemGovernorRemoveEvictionCallbackNative
+ * Signature: (Ljcuda/driver/CUevictionCallback;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventSynchronizeNative
-  (JNIEnv *env, jclass cls, jobject hEvent)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemGovernorRemoveEvictionCallbackNative
+  (JNIEnv *env, jclass cls, jobject callback)
 {
-    if (hEvent == NULL)
+    if (callback == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hEvent' is null for cuEventSynchronize");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'callback' is null for cuMemGovernorRemoveEvictionCallback");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuEventSynchronize\n");
+    Logger::log(LOG_TRACE, "Executing cuMemGovernorRemoveEvictionCallback\n");
 
-    CUevent nativeHEvent = (CUevent)getNativePointerValue(env, hEvent);
-    int result = cuEventSynchronize(nativeHEvent);
-    return result;
+    int removed = MemoryGovernor::removeEvictionFunctions(&matchEvictionCallback, callback);
+    if (removed == 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    return CUDA_SUCCESS;
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuEventDestroyNative
- * Signature: (Ljcuda/driver/CUevent;)I
+ * Method:    cuMemGovernorGetStatisticsNative
+ * Signature: (I[J[J[J[J)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventDestroyNative
-  (JNIEnv *env, jclass cls, jobject hEvent)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemGovernorGetStatisticsNative
+  (JNIEnv *env, jclass cls, jint device, jlongArray allocated, jlongArray free, jlongArray evicted, jlongArray throttled)
 {
-    if (hEvent == NULL)
+    if (allocated == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hEvent' is null for cuEventDestroy");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'allocated' is null for cuMemGovernorGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuEventDestroy\n");
+    if (free == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'free' is null for cuMemGovernorGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (evicted == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'evicted' is null for cuMemGovernorGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (throttled == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'throttled' is null for cuMemGovernorGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuMemGovernorGetStatistics\n");
 
-    CUevent nativeHEvent = (CUevent)getNativePointerValue(env, hEvent);
-    int result = cuEventDestroy(nativeHEvent);
-    return result;
+    MemoryGovernorStatistics statistics;
+    if (!MemoryGovernor::getStatistics((int)device, &statistics))
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    if (!set(env, allocated, 0, (jlong)statistics.allocatedBytes)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, free, 0, (jlong)statistics.freeBytes)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, evicted, 0, (jlong)statistics.evictedBytes)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, throttled, 0, (jlong)statistics.throttledAllocations)) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuEventElapsedTimeNative
- * Signature: ([FLjcuda/driver/CUevent;Ljcuda/driver/CUevent;)I
+ * Method:    cuModuleLoaderCreateNative
+ * Signature: (Ljcuda/driver/CUmoduleLoader;Ljcuda/driver/CUcontext;I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventElapsedTimeNative
-  (JNIEnv *env, jclass cls, jfloatArray pMilliseconds, jobject hStart, jobject hEnd)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoaderCreateNative
+  (JNIEnv *env, jclass cls, jobject loader, jobject ctx, jint threadCount)
 {
-    if (pMilliseconds == NULL)
+    if (loader == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pMilliseconds' is null for cuEventElapsedTime");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'loader' is null for cuModuleLoaderCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hStart == NULL)
+    if (ctx == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStart' is null for cuEventElapsedTime");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ctx' is null for cuModuleLoaderCreate");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (hEnd == NULL)
+    Logger::log(LOG_TRACE, "Executing cuModuleLoaderCreate\n");
+
+    CUcontext nativeCtx = (CUcontext)getNativePointerValue(env, ctx);
+    ModuleLoader *nativeLoader = new ModuleLoader(nativeCtx, (int)threadCount, &detachTaskWorker);
+    CUresult result = nativeLoader->init();
+    if (result != CUDA_SUCCESS)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hEnd' is null for cuEventElapsedTime");
-        return JCUDA_INTERNAL_ERROR;
+        delete nativeLoader;
+        return result;
     }
-    Logger::log(LOG_TRACE, "Executing cuEventElapsedTime\n");
-
-    CUevent nativeHStart = (CUevent)getNativePointerValue(env, hStart);
-    CUevent nativeHEnd   = (CUevent)getNativePointerValue(env, hEnd  );
-    float nativePMilliseconds;
-    int result = cuEventElapsedTime(&nativePMilliseconds, nativeHStart, nativeHEnd);
-    if (!set(env, pMilliseconds, 0, nativePMilliseconds)) return JCUDA_INTERNAL_ERROR;
-    return result;
+    setNativePointerValue(env, loader, (jlong)nativeLoader);
+    return CUDA_SUCCESS;
 }
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleLoaderDestroyNative
+ * Signature: (Ljcuda/driver/CUmoduleLoader;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoaderDestroyNative
+  (JNIEnv *env, jclass cls, jobject loader)
+{
+    if (loader == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'loader' is null for cuModuleLoaderDestroy");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuModuleLoaderDestroy\n");
 
+    ModuleLoader *nativeLoader = (ModuleLoader*)getNativePointerValue(env, loader);
+    if (nativeLoader == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    delete nativeLoader;
+    setNativePointerValue(env, loader, (jlong)0);
+    return CUDA_SUCCESS;
+}
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuPointerGetAttributeNative
- * Signature: (Ljcuda/Pointer;ILjcuda/driver/CUdeviceptr;)I
+ * Method:    cuModuleLoaderLoadDataNative
+ * Signature: (Ljcuda/driver/CUmoduleLoader;Ljcuda/driver/CUmoduleFuture;[B)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPointerGetAttributeNative
-  (JNIEnv *env, jclass cls, jobject data, jint attribute, jobject ptr)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoaderLoadDataNative
+  (JNIEnv *env, jclass cls, jobject loader, jobject future, jbyteArray image)
 {
-    if (data == NULL)
+    if (loader == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'data' is null for cuPointerGetAttribute");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'loader' is null for cuModuleLoaderLoadData");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (ptr == NULL)
+    if (future == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ptr' is null for cuPointerGetAttribute");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'future' is null for cuModuleLoaderLoadData");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuPointerGetAttribute\n");
-
-    PointerData *dataPointerData = initPointerData(env, data);
-    if (dataPointerData == NULL)
+    if (image == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'image' is null for cuModuleLoaderLoadData");
         return JCUDA_INTERNAL_ERROR;
     }
-    CUdeviceptr nativePtr = (CUdeviceptr)getPointer(env, ptr);
-
-    void *dataPointer = (void*)dataPointerData->getPointer(env);
-    int result = cuPointerGetAttribute(dataPointer, (CUpointer_attribute)attribute, nativePtr);
+    Logger::log(LOG_TRACE, "Executing cuModuleLoaderLoadData\n");
 
-    // XXX TEST XXX
-    /*
-    int result = CUDA_SUCCESS;
-    if (attribute == CU_POINTER_ATTRIBUTE_CONTEXT)
+    ModuleLoader *nativeLoader = (ModuleLoader*)getNativePointerValue(env, loader);
+    if (nativeLoader == NULL)
     {
-        CUcontext *testContext = (CUcontext*)dataPointer;
-        *testContext = (CUcontext)0x0000CAFE;
+        return CUDA_ERROR_INVALID_HANDLE;
     }
-    else if (attribute == CU_POINTER_ATTRIBUTE_MEMORY_TYPE)
+    jsize size = env->GetArrayLength(image);
+    void *nativeImage = env->GetPrimitiveArrayCritical(image, NULL);
+    if (nativeImage == NULL)
     {
-        unsigned int *testMemoryType = (unsigned int*)dataPointer;
-        *testMemoryType = CU_MEMORYTYPE_UNIFIED;
+        return JCUDA_INTERNAL_ERROR;
     }
-    else if (attribute == CU_POINTER_ATTRIBUTE_DEVICE_POINTER)
+    ModuleFuture *nativeFuture = NULL;
+    CUresult result = nativeLoader->load(nativeImage, (size_t)size, &nativeFuture);
+    env->ReleasePrimitiveArrayCritical(image, nativeImage, JNI_ABORT);
+    if (result != CUDA_SUCCESS)
     {
-        CUdeviceptr *testDevicePtr = (CUdeviceptr*)dataPointer;
-        *testDevicePtr = nativePtr;
+        return result;
     }
-    else if (attribute == CU_POINTER_ATTRIBUTE_HOST_POINTER)
+    setNativePointerValue(env, future, (jlong)nativeFuture);
+    return CUDA_SUCCESS;
+}
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleLoaderSynchronizeNative
+ * Signature: (Ljcuda/driver/CUmoduleLoader;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoaderSynchronizeNative
+  (JNIEnv *env, jclass cls, jobject loader)
+{
+    if (loader == NULL)
     {
-        void **testHostPtr = (void**)dataPointer;
-        *testHostPtr = (void*)0x0000BABE;
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'loader' is null for cuModuleLoaderSynchronize");
+        return JCUDA_INTERNAL_ERROR;
     }
-    */
-    // TODO: For CU_POINTER_ATTRIBUTE_HOST_POINTER it might be
-    // necessary (or at least desirable) to set the "buffer"
-    // of the Pointer to be a DirectByteBuffer backed by the
-    // host memory.
+    Logger::log(LOG_TRACE, "Executing cuModuleLoaderSynchronize\n");
 
-    if (!releasePointerData(env, dataPointerData, 0)) return JCUDA_INTERNAL_ERROR;
-    return result;
+    ModuleLoader *nativeLoader = (ModuleLoader*)getNativePointerValue(env, loader);
+    if (nativeLoader == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    nativeLoader->synchronize();
+    return CUDA_SUCCESS;
 }
 
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuStreamCreateNative
- * Signature: (Ljcuda/driver/CUstream;I)I
+ * Method:    cuModuleFutureQueryNative
+ * Signature: (Ljcuda/driver/CUmoduleFuture;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamCreateNative
-  (JNIEnv *env, jclass cls, jobject phStream, jint Flags)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleFutureQueryNative
+  (JNIEnv *env, jclass cls, jobject future)
 {
-    if (phStream == NULL)
+    if (future == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phStream' is null for cuStreamCreate");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'future' is null for cuModuleFutureQuery");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuStreamCreate\n");
-
-    CUstream nativePhStream;
-    int result = cuStreamCreate(&nativePhStream, Flags);
-    setNativePointerValue(env, phStream, (jlong)nativePhStream);
+    Logger::log(LOG_TRACE, "Executing cuModuleFutureQuery\n");
 
-    return result;
+    ModuleFuture *nativeFuture = (ModuleFuture*)getNativePointerValue(env, future);
+    if (nativeFuture == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    return nativeFuture->query();
 }
 
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuStreamCreateWithPriorityNative
- * Signature: (Ljcuda/driver/CUstream;II)I
+ * Method:    cuModuleFutureGetModuleNative
+ * Signature: (Ljcuda/driver/CUmoduleFuture;Ljcuda/driver/CUmodule;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamCreateWithPriorityNative
-  (JNIEnv *env, jclass cls, jobject phStream, jint flags, jint priority)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleFutureGetModuleNative
+  (JNIEnv *env, jclass cls, jobject future, jobject module)
 {
-	// XXX Function is not available in CUDA 5.5
-	ThrowByName(env, "java/lang/UnsupportedOperaionException", 
-		"Function cuStreamCreateWithPriority is not available in CUDA 5.5");
-	return JCUDA_INTERNAL_ERROR;
-/*
-    if (phStream == NULL)
+    if (future == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'phStream' is null for cuStreamCreateWithPriority");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'future' is null for cuModuleFutureGetModule");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuStreamCreateWithPriority\n");
-
-    CUstream nativePhStream;
-    int result = cuStreamCreateWithPriority(&nativePhStream, (unsigned int)flags, (int)priority);
-    setNativePointerValue(env, phStream, (jlong)nativePhStream);
+    if (module == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'module' is null for cuModuleFutureGetModule");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuModuleFutureGetModule\n");
 
+    ModuleFuture *nativeFuture = (ModuleFuture*)getNativePointerValue(env, future);
+    if (nativeFuture == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    CUmodule nativeModule = NULL;
+    CUresult result = nativeFuture->get(&nativeModule);
+    setNativePointerValue(env, module, (jlong)nativeModule);
     return result;
-*/
 }
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuStreamGetPriorityNative
- * Signature: (Ljcuda/driver/CUstream;[I)I
+ * Method:    cuModuleFutureGetFunctionNative
+ * Signature: (Ljcuda/driver/CUmoduleFuture;Ljcuda/driver/CUfunction;Ljava/lang/String;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamGetPriorityNative
-  (JNIEnv *env, jclass cls, jobject hStream, jintArray priority)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleFutureGetFunctionNative
+  (JNIEnv *env, jclass cls, jobject future, jobject hfunc, jstring name)
 {
-	// XXX Function is not available in CUDA 5.5
-	ThrowByName(env, "java/lang/UnsupportedOperaionException", 
-		"Function cuStreamGetPriority is not available in CUDA 5.5");
-	return JCUDA_INTERNAL_ERROR;
-/*
-    if (hStream == NULL)
+    if (future == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuStreamGetPriority");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'future' is null for cuModuleFutureGetFunction");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (priority == NULL)
+    if (hfunc == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'priority' is null for cuStreamGetPriority");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hfunc' is null for cuModuleFutureGetFunction");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuStreamGetPriority\n");
-
-	CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
-	int nativePriority;
-    int result = cuStreamGetPriority(nativeHStream, &nativePriority);
-    if (!set(env, priority, 0, nativePriority)) return JCUDA_INTERNAL_ERROR;
-    return result;
-*/
-}
+    if (name == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'name' is null for cuModuleFutureGetFunction");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuModuleFutureGetFunction\n");
 
+    ModuleFuture *nativeFuture = (ModuleFuture*)getNativePointerValue(env, future);
+    if (nativeFuture == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+
+    // The function is looked up by getNativeFunction when it is used
+    setNativePointerValue(env, hfunc, (jlong)0);
+    env->SetObjectField(hfunc, CUfunction_future, future);
+    env->SetObjectField(hfunc, CUfunction_name, name);
+    return CUDA_SUCCESS;
+}
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuStreamGetFlagsNative
- * Signature: (Ljcuda/driver/CUstream;[I)I
+ * Method:    cuModuleFutureGetErrorLogNative
+ * Signature: (Ljcuda/driver/CUmoduleFuture;[Ljava/lang/String;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamGetFlagsNative
-  (JNIEnv *env, jclass cls, jobject hStream, jintArray flags)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleFutureGetErrorLogNative
+  (JNIEnv *env, jclass cls, jobject future, jobjectArray log)
 {
-	// XXX Function is not available in CUDA 5.5
-	ThrowByName(env, "java/lang/UnsupportedOperaionException", 
-		"Function cuStreamGetFlags is not available in CUDA 5.5");
-	return JCUDA_INTERNAL_ERROR;
-/*
-    if (hStream == NULL)
+    if (future == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuStreamGetFlags");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'future' is null for cuModuleFutureGetErrorLog");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (flags == NULL)
+    if (log == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'flags' is null for cuStreamGetFlags");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'log' is null for cuModuleFutureGetErrorLog");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cuStreamGetFlags\n");
+    Logger::log(LOG_TRACE, "Executing cuModuleFutureGetErrorLog\n");
 
-	CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
-	unsigned int nativeFlags;
-    int result = cuStreamGetFlags(nativeHStream, &nativeFlags);
-    if (!set(env, flags, 0, nativeFlags)) return JCUDA_INTERNAL_ERROR;
-    return result;
-*/
+    ModuleFuture *nativeFuture = (ModuleFuture*)getNativePointerValue(env, future);
+    if (nativeFuture == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    jstring logElement = env->NewStringUTF(nativeFuture->getErrorLog());
+    if (logElement == NULL)
+    {
+        ThrowByName(env, "java/lang/OutOfMemoryError", "Out of memory creating result string");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    env->SetObjectArrayElement(log, 0, logElement);
+    if (env->ExceptionCheck())
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    return CUDA_SUCCESS;
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuStreamWaitEventNative
- * Signature: (Ljcuda/driver/CUstream;Ljcuda/driver/CUevent;I)I
+ * Method:    cuModuleFutureDestroyNative
+ * Signature: (Ljcuda/driver/CUmoduleFuture;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamWaitEventNative
-  (JNIEnv *env, jclass cls, jobject hStream, jobject hEvent, jint Flags)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleFutureDestroyNative
+  (JNIEnv *env, jclass cls, jobject future)
 {
-    /* May be null
-    if (hStream == NULL)
+    if (future == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuStreamWaitEvent");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'future' is null for cuModuleFutureDestroy");
         return JCUDA_INTERNAL_ERROR;
     }
-    */
-    if (hEvent == NULL)
+    Logger::log(LOG_TRACE, "Executing cuModuleFutureDestroy\n");
+
+    ModuleFuture *nativeFuture = (ModuleFuture*)getNativePointerValue(env, future);
+    if (nativeFuture == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hEvent' is null for cuStreamWaitEvent");
-        return JCUDA_INTERNAL_ERROR;
+        return CUDA_ERROR_INVALID_HANDLE;
     }
-    Logger::log(LOG_TRACE, "Executing cuStreamWaitEvent\n");
-
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
-    CUevent nativeHEvent = (CUevent)getNativePointerValue(env, hEvent);
-    int result = cuStreamWaitEvent(nativeHStream, nativeHEvent, (unsigned int)Flags);
-
-    return result;
+    nativeFuture->release();
+    setNativePointerValue(env, future, (jlong)0);
+    return CUDA_SUCCESS;
 }
 
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuStreamAddCallbackNative
- * Signature: (Ljcuda/driver/CUstream;Ljcuda/driver/CUstreamCallback;Ljava/lang/Object;I)I
+ * Method:    cuTaskQueryNative
+ * Signature: (Ljcuda/driver/CUtask;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamAddCallbackNative
-  (JNIEnv *env, jclass cls, jobject hStream, jobject callback, jobject userData, jint flags)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskQueryNative
+  (JNIEnv *env, jclass cls, jobject task)
 {
-    ThrowByName(env, "java/lang/UnsupportedOperationException", "cuStreamAddCallback is not yet supported");
-    return JCUDA_INTERNAL_ERROR;
-}
+    if (task == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'task' is null for cuTaskQuery");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTaskQuery\n");
 
+    SchedulerTask *nativeTask = (SchedulerTask*)getNativePointerValue(env, task);
+    if (nativeTask == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    return nativeTask->query();
+}
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuStreamQueryNative
- * Signature: (Ljcuda/driver/CUstream;)I
+ * Method:    cuTaskSynchronizeNative
+ * Signature: (Ljcuda/driver/CUtask;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamQueryNative
-  (JNIEnv *env, jclass cls, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskSynchronizeNative
+  (JNIEnv *env, jclass cls, jobject task)
 {
-    /* May be null
-    if (hStream == NULL)
+    if (task == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuStreamQuery");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'task' is null for cuTaskSynchronize");
         return JCUDA_INTERNAL_ERROR;
     }
-    */
-    Logger::log(LOG_TRACE, "Executing cuStreamQuery\n");
+    Logger::log(LOG_TRACE, "Executing cuTaskSynchronize\n");
 
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
-    int result = cuStreamQuery(nativeHStream);
-    return result;
+    SchedulerTask *nativeTask = (SchedulerTask*)getNativePointerValue(env, task);
+    if (nativeTask == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    return nativeTask->synchronize();
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuStreamSynchronizeNative
- * Signature: (Ljcuda/driver/CUstream;)I
+ * Method:    cuTaskGetDeviceNative
+ * Signature: (Ljcuda/driver/CUtask;[I)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamSynchronizeNative
-  (JNIEnv *env, jclass cls, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskGetDeviceNative
+  (JNIEnv *env, jclass cls, jobject task, jintArray device)
 {
-    /* May be null
-    if (hStream == NULL)
+    if (task == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuStreamSynchronize");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'task' is null for cuTaskGetDevice");
         return JCUDA_INTERNAL_ERROR;
     }
-    */
-    Logger::log(LOG_TRACE, "Executing cuStreamSynchronize\n");
+    if (device == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'device' is null for cuTaskGetDevice");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuTaskGetDevice\n");
 
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
-    int result = cuStreamSynchronize(nativeHStream);
-    return result;
+    SchedulerTask *nativeTask = (SchedulerTask*)getNativePointerValue(env, task);
+    if (nativeTask == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    if (!set(env, device, 0, (jint)nativeTask->getDevice())) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
 }
 
-
-
-
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuStreamDestroyNative
- * Signature: (Ljcuda/driver/CUstream;)I
+ * Method:    cuTaskDestroyNative
+ * Signature: (Ljcuda/driver/CUtask;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamDestroyNative
-  (JNIEnv *env, jclass cls, jobject hStream)
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskDestroyNative
+  (JNIEnv *env, jclass cls, jobject task)
 {
-    /* May be null
-    if (hStream == NULL)
+    if (task == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hStream' is null for cuStreamDestroy");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'task' is null for cuTaskDestroy");
         return JCUDA_INTERNAL_ERROR;
     }
-    */
-    Logger::log(LOG_TRACE, "Executing cuStreamDestroy\n");
+    Logger::log(LOG_TRACE, "Executing cuTaskDestroy\n");
 
-    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
-    int result = cuStreamDestroy(nativeHStream);
-    return result;
+    SchedulerTask *nativeTask = (SchedulerTask*)getNativePointerValue(env, task);
+    if (nativeTask == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    nativeTask->release();
+    setNativePointerValue(env, task, (jlong)0);
+    return CUDA_SUCCESS;
 }
 
 
@@ -6411,6 +13008,10 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuGLCtxCreateNative
     CUdevice nativeDevice = (CUdevice)(intptr_t)getNativePointerValue(env, device);
     CUcontext nativePCtx;
     int result = cuGLCtxCreate(&nativePCtx, (unsigned int)Flags, nativeDevice);
+    if (result == CUDA_SUCCESS)
+    {
+        ContextTracker::contextCreated(nativePCtx);
+    }
     setNativePointerValue(env, pCtx, (jlong)nativePCtx);
 
     return result;
@@ -7110,4 +13711,195 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuProfilerStopNative
 }
 
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRangeProfilerEnableNative
+ * Signature: (I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRangeProfilerEnableNative
+  (JNIEnv *env, jclass cls, jint pollIntervalMicros)
+{
+    Logger::log(LOG_TRACE, "Executing cuRangeProfilerEnable\n");
+
+    if (pollIntervalMicros < 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    return RangeProfiler::enable((int)pollIntervalMicros);
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRangeProfilerDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRangeProfilerDisableNative
+  (JNIEnv *env, jclass cls)
+{
+    Logger::log(LOG_TRACE, "Executing cuRangeProfilerDisable\n");
+
+    RangeProfiler::disable();
+    return CUDA_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRangePushNative
+ * Signature: (Ljava/lang/String;Ljcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRangePushNative
+  (JNIEnv *env, jclass cls, jstring name, jobject hStream)
+{
+    if (name == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'name' is null for cuRangePush");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuRangePush\n");
+
+    char *nativeName = convertString(env, name);
+    if (nativeName == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    CUstream nativeHStream = (CUstream)getNativePointerValue(env, hStream);
+    int result = RangeProfiler::push(nativeName, nativeHStream);
+    delete[] nativeName;
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRangePopNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRangePopNative
+  (JNIEnv *env, jclass cls)
+{
+    Logger::log(LOG_TRACE, "Executing cuRangePop\n");
+
+    return RangeProfiler::pop();
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRangeGetCountNative
+ * Signature: ([I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRangeGetCountNative
+  (JNIEnv *env, jclass cls, jintArray count)
+{
+    if (count == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'count' is null for cuRangeGetCount");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuRangeGetCount\n");
+
+    if (!set(env, count, 0, RangeProfiler::getRangeCount())) return JCUDA_INTERNAL_ERROR;
+    return CUDA_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRangeGetStatisticsNative
+ * Signature: (I[Ljava/lang/String;[J[D[F[F[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRangeGetStatisticsNative
+  (JNIEnv *env, jclass cls, jint index, jobjectArray name, jlongArray count, jdoubleArray totalTime, jfloatArray minTime, jfloatArray maxTime, jlongArray histogram)
+{
+    if (name == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'name' is null for cuRangeGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (count == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'count' is null for cuRangeGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (totalTime == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'totalTime' is null for cuRangeGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (minTime == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'minTime' is null for cuRangeGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (maxTime == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'maxTime' is null for cuRangeGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (histogram == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'histogram' is null for cuRangeGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cuRangeGetStatistics\n");
+
+    char path[1024];
+    RangeStatistics statistics;
+    if (!RangeProfiler::getStatistics((int)index, path, sizeof(path), &statistics))
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    jstring nameElement = env->NewStringUTF(path);
+    if (nameElement == NULL)
+    {
+        ThrowByName(env, "java/lang/OutOfMemoryError", "Out of memory creating result string");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    env->SetObjectArrayElement(name, 0, nameElement);
+    if (env->ExceptionCheck())
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (!set(env, count, 0, (jlong)statistics.count)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, totalTime, 0, (jdouble)statistics.totalTime)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, minTime, 0, (jfloat)statistics.minTime)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, maxTime, 0, (jfloat)statistics.maxTime)) return JCUDA_INTERNAL_ERROR;
+
+    // Copy as many bins as fit into the given array
+    jlong bins[RANGE_HISTOGRAM_BINS];
+    jsize binCount = env->GetArrayLength(histogram);
+    if (binCount > RANGE_HISTOGRAM_BINS)
+    {
+        binCount = RANGE_HISTOGRAM_BINS;
+    }
+    for (jsize i=0; i<binCount; i++)
+    {
+        bins[i] = (jlong)statistics.histogram[i];
+    }
+    env->SetLongArrayRegion(histogram, 0, binCount, bins);
+    if (env->ExceptionCheck())
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    return CUDA_SUCCESS;
+}
+
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRangeResetNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRangeResetNative
+  (JNIEnv *env, jclass cls)
+{
+    Logger::log(LOG_TRACE, "Executing cuRangeReset\n");
+
+    RangeProfiler::reset();
+    return CUDA_SUCCESS;
+}
+
+
 
@@ -80,6 +80,14 @@ extern "C" {
 JNIEXPORT void JNICALL Java_jcuda_driver_JCudaDriver_setLogLevel
   (JNIEnv *, jclass, jint);
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    setContextTrackingEnabledNative
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_jcuda_driver_JCudaDriver_setContextTrackingEnabledNative
+  (JNIEnv *, jclass, jboolean);
+
 /*
  * Class:     jcuda_driver_JCudaDriver
  * Method:    cuModuleLoadDataJITNative
@@ -152,6 +160,14 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuDeviceGetPropertiesNative
 JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuDeviceGetAttributeNative
   (JNIEnv *, jclass, jintArray, jint, jobject);
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuDeviceGetSnapshotNative
+ * Signature: (Ljcuda/driver/CUdeviceSnapshot;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuDeviceGetSnapshotNative
+  (JNIEnv *, jclass, jobject);
+
 /*
  * Class:     jcuda_driver_JCudaDriver
  * Method:    cuDriverGetVersionNative
@@ -224,6 +240,22 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxSetCurrentNative
 JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxGetCurrentNative
   (JNIEnv *, jclass, jobject);
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCtxGetSwitchCountsNative
+ * Signature: ([J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxGetSwitchCountsNative
+  (JNIEnv *, jclass, jlongArray, jlongArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCtxResetSwitchCountsNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxResetSwitchCountsNative
+  (JNIEnv *, jclass);
+
 /*
  * Class:     jcuda_driver_JCudaDriver
  * Method:    cuCtxGetDeviceNative
@@ -296,6 +328,30 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleGetFunctionNative
 JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleGetGlobalNative
   (JNIEnv *, jclass, jobject, jlongArray, jobject, jstring);
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuSymbolUpdateStageNative
+ * Signature: (Ljcuda/driver/CUmodule;Ljava/lang/String;JLjcuda/Pointer;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuSymbolUpdateStageNative
+  (JNIEnv *, jclass, jobject, jstring, jlong, jobject, jlong);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuSymbolUpdateFlushNative
+ * Signature: (Ljcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuSymbolUpdateFlushNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuSymbolUpdateGetStatisticsNative
+ * Signature: ([J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuSymbolUpdateGetStatisticsNative
+  (JNIEnv *, jclass, jlongArray, jlongArray, jlongArray);
+
 /*
  * Class:     jcuda_driver_JCudaDriver
  * Method:    cuModuleGetTexRefNative
@@ -352,6 +408,70 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkCompleteNative
 JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkDestroyNative
   (JNIEnv *, jclass, jobject);
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuLinkCacheCreateNative
+ * Signature: (Ljcuda/driver/CUlinkCache;Ljava/lang/String;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkCacheCreateNative
+  (JNIEnv *, jclass, jobject, jstring, jlong);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuLinkCacheDestroyNative
+ * Signature: (Ljcuda/driver/CUlinkCache;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkCacheDestroyNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuLinkCacheGetStatisticsNative
+ * Signature: (Ljcuda/driver/CUlinkCache;[J[J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLinkCacheGetStatisticsNative
+  (JNIEnv *, jclass, jobject, jlongArray, jlongArray, jlongArray, jlongArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCachedLinkCreateNative
+ * Signature: (Ljcuda/driver/CUlinkCache;Ljcuda/driver/JITOptions;Ljcuda/driver/CUcachedLinkState;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCachedLinkCreateNative
+  (JNIEnv *, jclass, jobject, jobject, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCachedLinkAddDataNative
+ * Signature: (Ljcuda/driver/CUcachedLinkState;ILjcuda/Pointer;JLjava/lang/String;Ljcuda/driver/JITOptions;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCachedLinkAddDataNative
+  (JNIEnv *, jclass, jobject, jint, jobject, jlong, jstring, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCachedLinkAddFileNative
+ * Signature: (Ljcuda/driver/CUcachedLinkState;ILjava/lang/String;Ljcuda/driver/JITOptions;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCachedLinkAddFileNative
+  (JNIEnv *, jclass, jobject, jint, jstring, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCachedLinkCompleteNative
+ * Signature: (Ljcuda/driver/CUcachedLinkState;Ljcuda/Pointer;[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCachedLinkCompleteNative
+  (JNIEnv *, jclass, jobject, jobject, jlongArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuCachedLinkDestroyNative
+ * Signature: (Ljcuda/driver/CUcachedLinkState;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCachedLinkDestroyNative
+  (JNIEnv *, jclass, jobject);
+
 /*
  * Class:     jcuda_driver_JCudaDriver
  * Method:    cuMemGetInfoNative
@@ -440,6 +560,78 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcOpenMemHandleNative
 JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcCloseMemHandleNative
   (JNIEnv *, jclass, jobject);
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryCreateNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;Ljava/lang/String;II)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryCreateNative
+  (JNIEnv *, jclass, jobject, jstring, jint, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryDestroyNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryDestroyNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryOpenMemHandleNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUipcMemHandle;I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryOpenMemHandleNative
+  (JNIEnv *, jclass, jobject, jobject, jobject, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryCloseMemHandleNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;Ljcuda/driver/CUdeviceptr;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryCloseMemHandleNative
+  (JNIEnv *, jclass, jobject, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryTrimNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryTrimNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryPublishNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;Ljava/lang/String;Ljcuda/driver/CUdeviceptr;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryPublishNative
+  (JNIEnv *, jclass, jobject, jstring, jobject, jlong);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryUnpublishNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryUnpublishNative
+  (JNIEnv *, jclass, jobject, jstring);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryOpenNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;Ljcuda/driver/CUdeviceptr;[JLjava/lang/String;I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryOpenNative
+  (JNIEnv *, jclass, jobject, jobject, jlongArray, jstring, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuIpcRegistryGetStatisticsNative
+ * Signature: (Ljcuda/driver/CUipcRegistry;[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuIpcRegistryGetStatisticsNative
+  (JNIEnv *, jclass, jobject, jlongArray, jlongArray);
+
 /*
  * Class:     jcuda_driver_JCudaDriver
  * Method:    cuMemHostRegisterNative
@@ -456,6 +648,86 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostRegisterNative
 JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostUnregisterNative
   (JNIEnv *, jclass, jobject);
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRegistrationCacheEnableNative
+ * Signature: (IJ)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRegistrationCacheEnableNative
+  (JNIEnv *, jclass, jint, jlong);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRegistrationCacheDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRegistrationCacheDisableNative
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRegistrationCacheReleaseNative
+ * Signature: (Ljcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRegistrationCacheReleaseNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRegistrationCacheGetStatisticsNative
+ * Signature: ([J[J[J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRegistrationCacheGetStatisticsNative
+  (JNIEnv *, jclass, jlongArray, jlongArray, jlongArray, jlongArray, jlongArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuBounceRingEnableNative
+ * Signature: (JI)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuBounceRingEnableNative
+  (JNIEnv *, jclass, jlong, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuBounceRingDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuBounceRingDisableNative
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuBounceRingGetStatisticsNative
+ * Signature: ([J[J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuBounceRingGetStatisticsNative
+  (JNIEnv *, jclass, jlongArray, jlongArray, jlongArray, jlongArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPitchPackerEnableNative
+ * Signature: (IJ)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPitchPackerEnableNative
+  (JNIEnv *, jclass, jint, jlong);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPitchPackerDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPitchPackerDisableNative
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPitchPackerGetStatisticsNative
+ * Signature: ([J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPitchPackerGetStatisticsNative
+  (JNIEnv *, jclass, jlongArray, jlongArray, jlongArray);
+
 /*
  * Class:     jcuda_driver_JCudaDriver
  * Method:    cuMemcpyNative
@@ -464,6 +736,22 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostUnregisterNative
 JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyNative
   (JNIEnv *, jclass, jobject, jobject, jlong);
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyAutoNative
+ * Signature: (Ljcuda/Pointer;Ljcuda/Pointer;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAutoNative
+  (JNIEnv *, jclass, jobject, jobject, jlong);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemRegistryLookupNative
+ * Signature: ([I[ILjcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemRegistryLookupNative
+  (JNIEnv *, jclass, jintArray, jintArray, jobject);
+
 /*
  * Class:     jcuda_driver_JCudaDriver
  * Method:    cuMemcpyPeerNative
@@ -520,6 +808,70 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemAllocHostNative
 JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemFreeHostNative
   (JNIEnv *, jclass, jobject);
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostSetPlacementNative
+ * Signature: (I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostSetPlacementNative
+  (JNIEnv *, jclass, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostGetNumaNodeNative
+ * Signature: ([ILjcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostGetNumaNodeNative
+  (JNIEnv *, jclass, jintArray, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuDeviceGetHostNumaNodeNative
+ * Signature: ([ILjcuda/driver/CUdevice;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuDeviceGetHostNumaNodeNative
+  (JNIEnv *, jclass, jintArray, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostArenaCreateNative
+ * Signature: (Ljcuda/driver/CUmemHostArena;JJI)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostArenaCreateNative
+  (JNIEnv *, jclass, jobject, jlong, jlong, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostArenaDestroyNative
+ * Signature: (Ljcuda/driver/CUmemHostArena;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostArenaDestroyNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostArenaAllocNative
+ * Signature: (Ljcuda/driver/CUmemHostArena;Ljcuda/Pointer;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostArenaAllocNative
+  (JNIEnv *, jclass, jobject, jobject, jlong);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostArenaFreeNative
+ * Signature: (Ljcuda/driver/CUmemHostArena;Ljcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostArenaFreeNative
+  (JNIEnv *, jclass, jobject, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemHostArenaGetStatisticsNative
+ * Signature: (Ljcuda/driver/CUmemHostArena;Ljcuda/driver/CUmemHostArenaStatistics;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemHostArenaGetStatisticsNative
+  (JNIEnv *, jclass, jobject, jobject);
+
 /*
  * Class:     jcuda_driver_JCudaDriver
  * Method:    cuMemcpyHtoDNative
@@ -632,6 +984,38 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAsyncNative
 JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyPeerAsyncNative
   (JNIEnv *, jclass, jobject, jobject, jobject, jobject, jlong, jobject);
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPeerRouterEnableNative
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPeerRouterEnableNative
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPeerRouterDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPeerRouterDisableNative
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPeerRouterGetRouteNative
+ * Signature: ([III)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPeerRouterGetRouteNative
+  (JNIEnv *, jclass, jintArray, jint, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPeerRouterGetStatisticsNative
+ * Signature: ([J[J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPeerRouterGetStatisticsNative
+  (JNIEnv *, jclass, jlongArray, jlongArray, jlongArray, jlongArray);
+
 /*
  * Class:     jcuda_driver_JCudaDriver
  * Method:    cuMemcpyHtoDAsyncNative
@@ -650,44 +1034,236 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDtoHAsyncNative
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyDtoDAsyncNative
- * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUdeviceptr;JLjcuda/driver/CUstream;)I
+ * Method:    cuTransferEngineCreateNative
+ * Signature: (Ljcuda/driver/CUtransferEngine;JI)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDtoDAsyncNative
-  (JNIEnv *, jclass, jobject, jobject, jlong, jobject);
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferEngineCreateNative
+  (JNIEnv *, jclass, jobject, jlong, jint);
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyHtoAAsyncNative
- * Signature: (Ljcuda/driver/CUarray;JLjcuda/Pointer;JLjcuda/driver/CUstream;)I
+ * Method:    cuTransferEngineDestroyNative
+ * Signature: (Ljcuda/driver/CUtransferEngine;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyHtoAAsyncNative
-  (JNIEnv *, jclass, jobject, jlong, jobject, jlong, jobject);
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferEngineDestroyNative
+  (JNIEnv *, jclass, jobject);
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpyAtoHAsyncNative
- * Signature: (Ljcuda/Pointer;Ljcuda/driver/CUarray;JJLjcuda/driver/CUstream;)I
+ * Method:    cuTransferEngineGetStatisticsNative
+ * Signature: (Ljcuda/driver/CUtransferEngine;Ljcuda/driver/CUtransferStatistics;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAtoHAsyncNative
-  (JNIEnv *, jclass, jobject, jobject, jlong, jlong, jobject);
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferEngineGetStatisticsNative
+  (JNIEnv *, jclass, jobject, jobject);
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpy2DAsyncNative
- * Signature: (Ljcuda/driver/CUDA_MEMCPY2D;Ljcuda/driver/CUstream;)I
+ * Method:    cuTransferHtoDNative
+ * Signature: (Ljcuda/driver/CUtransferEngine;Ljcuda/driver/CUtransfer;Ljcuda/driver/CUdeviceptr;Ljcuda/Pointer;JLjcuda/driver/CUstream;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy2DAsyncNative
-  (JNIEnv *, jclass, jobject, jobject);
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferHtoDNative
+  (JNIEnv *, jclass, jobject, jobject, jobject, jobject, jlong, jobject);
 
 /*
  * Class:     jcuda_driver_JCudaDriver
- * Method:    cuMemcpy3DAsyncNative
+ * Method:    cuTransferDtoHNative
+ * Signature: (Ljcuda/driver/CUtransferEngine;Ljcuda/driver/CUtransfer;Ljcuda/Pointer;Ljcuda/driver/CUdeviceptr;JLjcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferDtoHNative
+  (JNIEnv *, jclass, jobject, jobject, jobject, jobject, jlong, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTransferGetChunkCountNative
+ * Signature: (Ljcuda/driver/CUtransfer;[I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferGetChunkCountNative
+  (JNIEnv *, jclass, jobject, jintArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTransferGetChunkEventNative
+ * Signature: (Ljcuda/driver/CUtransfer;ILjcuda/driver/CUevent;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferGetChunkEventNative
+  (JNIEnv *, jclass, jobject, jint, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTransferStreamWaitNative
+ * Signature: (Ljcuda/driver/CUtransfer;Ljcuda/driver/CUstream;JJ)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferStreamWaitNative
+  (JNIEnv *, jclass, jobject, jobject, jlong, jlong);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTransferQueryNative
+ * Signature: (Ljcuda/driver/CUtransfer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferQueryNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTransferSynchronizeNative
+ * Signature: (Ljcuda/driver/CUtransfer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferSynchronizeNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTransferGetStatisticsNative
+ * Signature: (Ljcuda/driver/CUtransfer;Ljcuda/driver/CUtransferStatistics;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferGetStatisticsNative
+  (JNIEnv *, jclass, jobject, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTransferDestroyNative
+ * Signature: (Ljcuda/driver/CUtransfer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTransferDestroyNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyDtoDAsyncNative
+ * Signature: (Ljcuda/driver/CUdeviceptr;Ljcuda/driver/CUdeviceptr;JLjcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDtoDAsyncNative
+  (JNIEnv *, jclass, jobject, jobject, jlong, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyHtoAAsyncNative
+ * Signature: (Ljcuda/driver/CUarray;JLjcuda/Pointer;JLjcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyHtoAAsyncNative
+  (JNIEnv *, jclass, jobject, jlong, jobject, jlong, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyAtoHAsyncNative
+ * Signature: (Ljcuda/Pointer;Ljcuda/driver/CUarray;JJLjcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyAtoHAsyncNative
+  (JNIEnv *, jclass, jobject, jobject, jlong, jlong, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpy2DAsyncNative
+ * Signature: (Ljcuda/driver/CUDA_MEMCPY2D;Ljcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy2DAsyncNative
+  (JNIEnv *, jclass, jobject, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpy3DAsyncNative
  * Signature: (Ljcuda/driver/CUDA_MEMCPY3D;Ljcuda/driver/CUstream;)I
  */
 JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DAsyncNative
   (JNIEnv *, jclass, jobject, jobject);
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyDescriptorCreateNative
+ * Signature: (Ljcuda/driver/CUmemcpyDescriptor;I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDescriptorCreateNative
+  (JNIEnv *, jclass, jobject, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyDescriptorDestroyNative
+ * Signature: (Ljcuda/driver/CUmemcpyDescriptor;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDescriptorDestroyNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpyDescriptorSetPointerNative
+ * Signature: (Ljcuda/driver/CUmemcpyDescriptor;ILjcuda/NativePointerObject;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpyDescriptorSetPointerNative
+  (JNIEnv *, jclass, jobject, jint, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpy2DDescriptorNative
+ * Signature: (Ljcuda/driver/CUmemcpy2DDescriptor;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy2DDescriptorNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpy2DUnalignedDescriptorNative
+ * Signature: (Ljcuda/driver/CUmemcpy2DDescriptor;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy2DUnalignedDescriptorNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpy2DAsyncDescriptorNative
+ * Signature: (Ljcuda/driver/CUmemcpy2DDescriptor;Ljcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy2DAsyncDescriptorNative
+  (JNIEnv *, jclass, jobject, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpy3DDescriptorNative
+ * Signature: (Ljcuda/driver/CUmemcpy3DDescriptor;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DDescriptorNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpy3DAsyncDescriptorNative
+ * Signature: (Ljcuda/driver/CUmemcpy3DDescriptor;Ljcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DAsyncDescriptorNative
+  (JNIEnv *, jclass, jobject, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpy3DPeerDescriptorNative
+ * Signature: (Ljcuda/driver/CUmemcpy3DPeerDescriptor;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DPeerDescriptorNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpy3DPeerAsyncDescriptorNative
+ * Signature: (Ljcuda/driver/CUmemcpy3DPeerDescriptor;Ljcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DPeerAsyncDescriptorNative
+  (JNIEnv *, jclass, jobject, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpy2DBatchAsyncNative
+ * Signature: (Ljcuda/driver/CUmemcpy2DDescriptor;[JILjcuda/driver/CUstream;[I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy2DBatchAsyncNative
+  (JNIEnv *, jclass, jobject, jlongArray, jint, jobject, jintArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemcpy3DBatchAsyncNative
+ * Signature: (Ljcuda/driver/CUmemcpy3DDescriptor;[JILjcuda/driver/CUstream;[I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemcpy3DBatchAsyncNative
+  (JNIEnv *, jclass, jobject, jlongArray, jint, jobject, jintArray);
+
 /*
  * Class:     jcuda_driver_JCudaDriver
  * Method:    cuMemcpy3DPeerAsyncNative
@@ -800,6 +1376,38 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemsetD2D32AsyncNative
 JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuFuncGetAttributeNative
   (JNIEnv *, jclass, jintArray, jint, jobject);
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuOccupancyCalculateNative
+ * Signature: (Ljcuda/driver/CUoccupancy;Ljcuda/driver/CUfunction;Ljcuda/driver/CUdevice;II)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOccupancyCalculateNative
+  (JNIEnv *, jclass, jobject, jobject, jobject, jint, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuOccupancyRecommendNative
+ * Signature: (Ljcuda/driver/CUoccupancy;Ljcuda/driver/CUfunction;Ljcuda/driver/CUdevice;III)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOccupancyRecommendNative
+  (JNIEnv *, jclass, jobject, jobject, jobject, jint, jint, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuOccupancyAutotuneNative
+ * Signature: (Ljcuda/driver/CUoccupancy;Ljcuda/driver/CUfunction;Ljava/lang/String;JILjcuda/driver/CUstream;Ljcuda/Pointer;I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOccupancyAutotuneNative
+  (JNIEnv *, jclass, jobject, jobject, jstring, jlong, jint, jobject, jobject, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuOccupancySetCacheFileNative
+ * Signature: (Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOccupancySetCacheFileNative
+  (JNIEnv *, jclass, jstring);
+
 /*
  * Class:     jcuda_driver_JCudaDriver
  * Method:    cuFuncSetBlockShapeNative
@@ -1304,6 +1912,54 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventSynchronizeNative
 JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventDestroyNative
   (JNIEnv *, jclass, jobject);
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuEventPoolCreateNative
+ * Signature: (Ljcuda/driver/CUeventPool;II)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventPoolCreateNative
+  (JNIEnv *, jclass, jobject, jint, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuEventPoolDestroyNative
+ * Signature: (Ljcuda/driver/CUeventPool;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventPoolDestroyNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuEventPoolAcquireNative
+ * Signature: (Ljcuda/driver/CUeventPool;Ljcuda/driver/CUevent;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventPoolAcquireNative
+  (JNIEnv *, jclass, jobject, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuEventPoolReleaseNative
+ * Signature: (Ljcuda/driver/CUeventPool;Ljcuda/driver/CUevent;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventPoolReleaseNative
+  (JNIEnv *, jclass, jobject, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuEventRegisterFutureNative
+ * Signature: (Ljcuda/EventFuture;Ljcuda/driver/CUevent;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventRegisterFutureNative
+  (JNIEnv *, jclass, jobject, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuEventFutureGetStatisticsNative
+ * Signature: ([J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuEventFutureGetStatisticsNative
+  (JNIEnv *, jclass, jlongArray, jlongArray, jlongArray);
+
 /*
  * Class:     jcuda_driver_JCudaDriver
  * Method:    cuEventElapsedTimeNative
@@ -1392,6 +2048,294 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamSynchronizeNative
 JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamDestroyNative
   (JNIEnv *, jclass, jobject);
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuStreamPoolCreateNative
+ * Signature: (Ljcuda/driver/CUstreamPool;I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamPoolCreateNative
+  (JNIEnv *, jclass, jobject, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuStreamPoolDestroyNative
+ * Signature: (Ljcuda/driver/CUstreamPool;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamPoolDestroyNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuStreamPoolAcquireNative
+ * Signature: (Ljcuda/driver/CUstreamPool;Ljcuda/driver/CUstream;II)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamPoolAcquireNative
+  (JNIEnv *, jclass, jobject, jobject, jint, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuStreamPoolReleaseNative
+ * Signature: (Ljcuda/driver/CUstreamPool;Ljcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuStreamPoolReleaseNative
+  (JNIEnv *, jclass, jobject, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTaskSchedulerCreateNative
+ * Signature: (Ljcuda/driver/CUtaskScheduler;II)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskSchedulerCreateNative
+  (JNIEnv *, jclass, jobject, jint, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTaskSchedulerDestroyNative
+ * Signature: (Ljcuda/driver/CUtaskScheduler;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskSchedulerDestroyNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTaskSchedulerGetDeviceCountNative
+ * Signature: (Ljcuda/driver/CUtaskScheduler;[I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskSchedulerGetDeviceCountNative
+  (JNIEnv *, jclass, jobject, jintArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTaskSchedulerGetContextNative
+ * Signature: (Ljcuda/driver/CUtaskScheduler;ILjcuda/driver/CUcontext;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskSchedulerGetContextNative
+  (JNIEnv *, jclass, jobject, jint, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTaskSchedulerSubmitNative
+ * Signature: (Ljcuda/driver/CUtaskScheduler;Ljcuda/driver/CUtask;Ljcuda/driver/CUtaskCallback;Ljava/lang/Object;I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskSchedulerSubmitNative
+  (JNIEnv *, jclass, jobject, jobject, jobject, jobject, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTaskSchedulerSynchronizeNative
+ * Signature: (Ljcuda/driver/CUtaskScheduler;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskSchedulerSynchronizeNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTaskSchedulerGetStatisticsNative
+ * Signature: (Ljcuda/driver/CUtaskScheduler;I[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskSchedulerGetStatisticsNative
+  (JNIEnv *, jclass, jobject, jint, jlongArray, jlongArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPrioritySchedulerCreateNative
+ * Signature: (Ljcuda/driver/CUpriorityScheduler;IIII)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPrioritySchedulerCreateNative
+  (JNIEnv *, jclass, jobject, jint, jint, jint, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPrioritySchedulerDestroyNative
+ * Signature: (Ljcuda/driver/CUpriorityScheduler;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPrioritySchedulerDestroyNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPrioritySchedulerGetDeviceCountNative
+ * Signature: (Ljcuda/driver/CUpriorityScheduler;[I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPrioritySchedulerGetDeviceCountNative
+  (JNIEnv *, jclass, jobject, jintArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPrioritySchedulerGetContextNative
+ * Signature: (Ljcuda/driver/CUpriorityScheduler;ILjcuda/driver/CUcontext;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPrioritySchedulerGetContextNative
+  (JNIEnv *, jclass, jobject, jint, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPrioritySchedulerSubmitNative
+ * Signature: (Ljcuda/driver/CUpriorityScheduler;Ljcuda/driver/CUtask;Ljcuda/driver/CUtaskCallback;Ljava/lang/Object;II)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPrioritySchedulerSubmitNative
+  (JNIEnv *, jclass, jobject, jobject, jobject, jobject, jint, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPrioritySchedulerSynchronizeNative
+ * Signature: (Ljcuda/driver/CUpriorityScheduler;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPrioritySchedulerSynchronizeNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuPrioritySchedulerGetStatisticsNative
+ * Signature: (Ljcuda/driver/CUpriorityScheduler;I[J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuPrioritySchedulerGetStatisticsNative
+  (JNIEnv *, jclass, jobject, jint, jlongArray, jlongArray, jlongArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemGovernorEnableNative
+ * Signature: (JJJII)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemGovernorEnableNative
+  (JNIEnv *, jclass, jlong, jlong, jlong, jint, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemGovernorDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemGovernorDisableNative
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemGovernorAddEvictionCallbackNative
+ * Signature: (Ljcuda/driver/CUevictionCallback;Ljava/lang/Object;I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemGovernorAddEvictionCallbackNative
+  (JNIEnv *, jclass, jobject, jobject, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemGovernorRemoveEvictionCallbackNative
+ * Signature: (Ljcuda/driver/CUevictionCallback;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemGovernorRemoveEvictionCallbackNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuMemGovernorGetStatisticsNative
+ * Signature: (I[J[J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuMemGovernorGetStatisticsNative
+  (JNIEnv *, jclass, jint, jlongArray, jlongArray, jlongArray, jlongArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleLoaderCreateNative
+ * Signature: (Ljcuda/driver/CUmoduleLoader;Ljcuda/driver/CUcontext;I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoaderCreateNative
+  (JNIEnv *, jclass, jobject, jobject, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleLoaderDestroyNative
+ * Signature: (Ljcuda/driver/CUmoduleLoader;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoaderDestroyNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleLoaderLoadDataNative
+ * Signature: (Ljcuda/driver/CUmoduleLoader;Ljcuda/driver/CUmoduleFuture;[B)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoaderLoadDataNative
+  (JNIEnv *, jclass, jobject, jobject, jbyteArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleLoaderSynchronizeNative
+ * Signature: (Ljcuda/driver/CUmoduleLoader;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleLoaderSynchronizeNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleFutureQueryNative
+ * Signature: (Ljcuda/driver/CUmoduleFuture;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleFutureQueryNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleFutureGetModuleNative
+ * Signature: (Ljcuda/driver/CUmoduleFuture;Ljcuda/driver/CUmodule;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleFutureGetModuleNative
+  (JNIEnv *, jclass, jobject, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleFutureGetFunctionNative
+ * Signature: (Ljcuda/driver/CUmoduleFuture;Ljcuda/driver/CUfunction;Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleFutureGetFunctionNative
+  (JNIEnv *, jclass, jobject, jobject, jstring);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleFutureGetErrorLogNative
+ * Signature: (Ljcuda/driver/CUmoduleFuture;[Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleFutureGetErrorLogNative
+  (JNIEnv *, jclass, jobject, jobjectArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuModuleFutureDestroyNative
+ * Signature: (Ljcuda/driver/CUmoduleFuture;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuModuleFutureDestroyNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTaskQueryNative
+ * Signature: (Ljcuda/driver/CUtask;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskQueryNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTaskSynchronizeNative
+ * Signature: (Ljcuda/driver/CUtask;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskSynchronizeNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTaskGetDeviceNative
+ * Signature: (Ljcuda/driver/CUtask;[I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskGetDeviceNative
+  (JNIEnv *, jclass, jobject, jintArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuTaskDestroyNative
+ * Signature: (Ljcuda/driver/CUtask;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuTaskDestroyNative
+  (JNIEnv *, jclass, jobject);
+
 /*
  * Class:     jcuda_driver_JCudaDriver
  * Method:    cuGLInitNative
@@ -1608,6 +2552,70 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuCtxGetStreamPriorityRange
 JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuLaunchKernelNative
   (JNIEnv *, jclass, jobject, jint, jint, jint, jint, jint, jint, jint, jobject, jobject, jobject);
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuOpGraphCreateNative
+ * Signature: (Ljcuda/driver/CUopGraph;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOpGraphCreateNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuOpGraphDestroyNative
+ * Signature: (Ljcuda/driver/CUopGraph;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOpGraphDestroyNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuOpGraphBeginCaptureNative
+ * Signature: (Ljcuda/driver/CUopGraph;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOpGraphBeginCaptureNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuOpGraphEndCaptureNative
+ * Signature: (Ljcuda/driver/CUopGraph;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOpGraphEndCaptureNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuOpGraphLaunchNative
+ * Signature: (Ljcuda/driver/CUopGraph;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOpGraphLaunchNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuOpGraphGetOperationCountNative
+ * Signature: (Ljcuda/driver/CUopGraph;[I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOpGraphGetOperationCountNative
+  (JNIEnv *, jclass, jobject, jintArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuOpGraphSetKernelParamNative
+ * Signature: (Ljcuda/driver/CUopGraph;IILjcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOpGraphSetKernelParamNative
+  (JNIEnv *, jclass, jobject, jint, jint, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuOpGraphRebindAddressNative
+ * Signature: (Ljcuda/driver/CUopGraph;Ljcuda/driver/CUdeviceptr;JLjcuda/driver/CUdeviceptr;[I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuOpGraphRebindAddressNative
+  (JNIEnv *, jclass, jobject, jobject, jlong, jobject, jintArray);
+
 /*
  * Class:     jcuda_driver_JCudaDriver
  * Method:    cuCtxGetLimitNative
@@ -1640,6 +2648,62 @@ JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuProfilerStartNative
 JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuProfilerStopNative
   (JNIEnv *, jclass);
 
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRangeProfilerEnableNative
+ * Signature: (I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRangeProfilerEnableNative
+  (JNIEnv *, jclass, jint);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRangeProfilerDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRangeProfilerDisableNative
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRangePushNative
+ * Signature: (Ljava/lang/String;Ljcuda/driver/CUstream;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRangePushNative
+  (JNIEnv *, jclass, jstring, jobject);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRangePopNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRangePopNative
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRangeGetCountNative
+ * Signature: ([I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRangeGetCountNative
+  (JNIEnv *, jclass, jintArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRangeGetStatisticsNative
+ * Signature: (I[Ljava/lang/String;[J[D[F[F[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRangeGetStatisticsNative
+  (JNIEnv *, jclass, jint, jobjectArray, jlongArray, jdoubleArray, jfloatArray, jfloatArray, jlongArray);
+
+/*
+ * Class:     jcuda_driver_JCudaDriver
+ * Method:    cuRangeResetNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_driver_JCudaDriver_cuRangeResetNative
+  (JNIEnv *, jclass);
+
 #ifdef __cplusplus
 }
 #endif
@@ -128,6 +128,34 @@ typedef struct Memcpy3DPeerData
 
 } Memcpy3DPeerData;
 
+
+/**
+ * The types of MemcpyDescriptors
+ */
+#define MEMCPY_DESCRIPTOR_2D      0
+#define MEMCPY_DESCRIPTOR_3D      1
+#define MEMCPY_DESCRIPTOR_3D_PEER 2
+
+/**
+ * The native state of a CUmemcpyDescriptor. The structure that is
+ * selected by the type is exposed to Java as a direct buffer, so
+ * that the fields may be written without JNI calls, and the copy
+ * functions can pass it to CUDA as it is.
+ */
+typedef struct MemcpyDescriptor
+{
+    /** The MEMCPY_DESCRIPTOR_* type */
+    int type;
+
+    union
+    {
+        CUDA_MEMCPY2D memcpy2d;
+        CUDA_MEMCPY3D memcpy3d;
+        CUDA_MEMCPY3D_PEER memcpy3dPeer;
+    };
+
+} MemcpyDescriptor;
+
 /**
  * A structure storing the native representation of a java
  * JITOptions object
@@ -0,0 +1,459 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "LinkCache.hpp"
+#include "Logger.hpp"
+#include "SharedMemory.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define snprintf _snprintf
+#endif
+
+
+//=== LinkKeyBuilder =========================================================
+
+static inline unsigned long long rotl64(unsigned long long x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline unsigned long long fmix64(unsigned long long k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+LinkCacheKey LinkKeyBuilder::hash(const void *data, size_t size, unsigned int seed)
+{
+    const unsigned char *bytes = (const unsigned char*)data;
+    const size_t blockCount = size / 16;
+    const unsigned long long c1 = 0x87c37b91114253d5ULL;
+    const unsigned long long c2 = 0x4cf5ad432745937fULL;
+    unsigned long long h1 = seed;
+    unsigned long long h2 = seed;
+
+    for (size_t i=0; i<blockCount; i++)
+    {
+        unsigned long long k1;
+        unsigned long long k2;
+        memcpy(&k1, bytes + i * 16, 8);
+        memcpy(&k2, bytes + i * 16 + 8, 8);
+
+        k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+        h1 = rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+        k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2; // Fall through
+        h2 = rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    const unsigned char *tail = bytes + blockCount * 16;
+    unsigned long long k1 = 0;
+    unsigned long long k2 = 0;
+    switch (size & 15)
+    {
+        case 15: k2 ^= (unsigned long long)tail[14] << 48; // Fall through
+        case 14: k2 ^= (unsigned long long)tail[13] << 40; // Fall through
+        case 13: k2 ^= (unsigned long long)tail[12] << 32; // Fall through
+        case 12: k2 ^= (unsigned long long)tail[11] << 24; // Fall through
+        case 11: k2 ^= (unsigned long long)tail[10] << 16; // Fall through
+        case 10: k2 ^= (unsigned long long)tail[ 9] << 8; // Fall through
+        case  9: k2 ^= (unsigned long long)tail[ 8];
+                 k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2; // Fall through
+        case  8: k1 ^= (unsigned long long)tail[ 7] << 56; // Fall through
+        case  7: k1 ^= (unsigned long long)tail[ 6] << 48; // Fall through
+        case  6: k1 ^= (unsigned long long)tail[ 5] << 40; // Fall through
+        case  5: k1 ^= (unsigned long long)tail[ 4] << 32; // Fall through
+        case  4: k1 ^= (unsigned long long)tail[ 3] << 24; // Fall through
+        case  3: k1 ^= (unsigned long long)tail[ 2] << 16; // Fall through
+        case  2: k1 ^= (unsigned long long)tail[ 1] << 8; // Fall through
+        case  1: k1 ^= (unsigned long long)tail[ 0];
+                 k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+    }
+
+    h1 ^= (unsigned long long)size;
+    h2 ^= (unsigned long long)size;
+    h1 += h2;
+    h2 += h1;
+    h1 = fmix64(h1);
+    h2 = fmix64(h2);
+    h1 += h2;
+    h2 += h1;
+
+    LinkCacheKey key;
+    key.h1 = h1;
+    key.h2 = h2;
+    return key;
+}
+
+LinkKeyBuilder::LinkKeyBuilder()
+{
+}
+
+void LinkKeyBuilder::append(const void *data, size_t size)
+{
+    const char *bytes = (const char*)data;
+    sequence.insert(sequence.end(), bytes, bytes + size);
+}
+
+void LinkKeyBuilder::addInput(int type, const void *data, size_t size)
+{
+    LinkCacheKey contentKey = hash(data, size, 0);
+    append(&type, sizeof(int));
+    append(&contentKey, sizeof(LinkCacheKey));
+}
+
+void LinkKeyBuilder::addOptions(int numOptions, const CUjit_option *options, void **optionValues)
+{
+    for (int i=0; i<numOptions; i++)
+    {
+        switch (options[i])
+        {
+            case CU_JIT_WALL_TIME:
+            case CU_JIT_INFO_LOG_BUFFER:
+            case CU_JIT_INFO_LOG_BUFFER_SIZE_BYTES:
+            case CU_JIT_ERROR_LOG_BUFFER:
+            case CU_JIT_ERROR_LOG_BUFFER_SIZE_BYTES:
+            case CU_JIT_LOG_VERBOSE:
+                break;
+
+            default:
+            {
+                int option = (int)options[i];
+                jcuda_int64 value = (jcuda_int64)(size_t)optionValues[i];
+                append(&option, sizeof(int));
+                append(&value, sizeof(jcuda_int64));
+            }
+        }
+    }
+
+    // Separate the options from the following inputs
+    int separator = -1;
+    append(&separator, sizeof(int));
+}
+
+void LinkKeyBuilder::addTarget(int major, int minor)
+{
+    append(&major, sizeof(int));
+    append(&minor, sizeof(int));
+}
+
+LinkCacheKey LinkKeyBuilder::getKey() const
+{
+    if (sequence.empty())
+    {
+        return hash(NULL, 0, 1);
+    }
+    return hash(&sequence[0], sequence.size(), 1);
+}
+
+
+//=== LinkCache ==============================================================
+
+LinkCache::LinkCache(const char *directory, size_t maxBytes)
+{
+    if (directory != NULL)
+    {
+        this->directory = directory;
+    }
+    this->maxBytes = maxBytes;
+    totalBytes = 0;
+    hits = 0;
+    diskHits = 0;
+    misses = 0;
+    savedTime = 0;
+}
+
+LinkCache::~LinkCache()
+{
+    std::map<LinkCacheKey, LinkCacheEntry*>::iterator it;
+    for (it = entries.begin(); it != entries.end(); ++it)
+    {
+        delete[] it->second->image;
+        delete it->second;
+    }
+}
+
+LinkCacheEntry* LinkCache::lookup(const LinkCacheKey &key)
+{
+    jcuda_int64 before = getNanoTime();
+    {
+        MutexLock lock(mutex);
+        std::map<LinkCacheKey, LinkCacheEntry*>::iterator it = entries.find(key);
+        if (it != entries.end())
+        {
+            LinkCacheEntry *entry = it->second;
+            entry->references++;
+            touch(entry);
+            hits++;
+            savedTime += entry->linkTime - (getNanoTime() - before);
+            return entry;
+        }
+    }
+    if (directory.empty())
+    {
+        MutexLock lock(mutex);
+        misses++;
+        return NULL;
+    }
+
+    // Read the file without holding the lock. If another thread
+    // added the same image in the meantime, its entry is used.
+    LinkCacheEntry *diskEntry = read(key);
+    MutexLock lock(mutex);
+    if (diskEntry == NULL)
+    {
+        misses++;
+        return NULL;
+    }
+    LinkCacheEntry *entry = add(key, diskEntry->image, diskEntry->size, diskEntry->linkTime);
+    if (entry->image != diskEntry->image)
+    {
+        delete[] diskEntry->image;
+    }
+    delete diskEntry;
+    diskHits++;
+    savedTime += entry->linkTime - (getNanoTime() - before);
+    return entry;
+}
+
+LinkCacheEntry* LinkCache::insert(const LinkCacheKey &key, const void *image, size_t size, jcuda_int64 linkTime)
+{
+    char *imageCopy = new char[size];
+    memcpy(imageCopy, image, size);
+    LinkCacheEntry *entry = NULL;
+    {
+        MutexLock lock(mutex);
+        entry = add(key, imageCopy, size, linkTime);
+    }
+    if (entry->image != imageCopy)
+    {
+        delete[] imageCopy;
+    }
+    else if (!directory.empty())
+    {
+        write(entry);
+    }
+    return entry;
+}
+
+void LinkCache::release(LinkCacheEntry *entry)
+{
+    MutexLock lock(mutex);
+    entry->references--;
+    evict();
+}
+
+void LinkCache::getStatistics(jcuda_int64 *hits, jcuda_int64 *diskHits,
+    jcuda_int64 *misses, jcuda_int64 *savedTime)
+{
+    MutexLock lock(mutex);
+    *hits = this->hits;
+    *diskHits = this->diskHits;
+    *misses = this->misses;
+    *savedTime = this->savedTime;
+}
+
+/**
+ * Adds an entry with the given image, which is owned by the cache
+ * afterwards, unless an entry with the given key already exists.
+ * Returns the entry for the key, which is in use by the caller.
+ * The mutex must be locked.
+ */
+LinkCacheEntry* LinkCache::add(const LinkCacheKey &key, char *image, size_t size, jcuda_int64 linkTime)
+{
+    std::map<LinkCacheKey, LinkCacheEntry*>::iterator it = entries.find(key);
+    if (it != entries.end())
+    {
+        it->second->references++;
+        touch(it->second);
+        return it->second;
+    }
+    LinkCacheEntry *entry = new LinkCacheEntry();
+    entry->key = key;
+    entry->image = image;
+    entry->size = size;
+    entry->linkTime = linkTime;
+    entry->references = 1;
+    entries[key] = entry;
+    recentlyUsed.push_front(entry);
+    totalBytes += size;
+    evict();
+    return entry;
+}
+
+/**
+ * Moves the given entry to the front of the LRU list. The mutex must
+ * be locked.
+ */
+void LinkCache::touch(LinkCacheEntry *entry)
+{
+    recentlyUsed.remove(entry);
+    recentlyUsed.push_front(entry);
+}
+
+/**
+ * Deletes the least recently used entries that are not in use, until
+ * the total size is not larger than the maximum. The mutex must be
+ * locked.
+ */
+void LinkCache::evict()
+{
+    std::list<LinkCacheEntry*>::iterator it = recentlyUsed.end();
+    while (totalBytes > maxBytes && it != recentlyUsed.begin())
+    {
+        --it;
+        LinkCacheEntry *entry = *it;
+        if (entry->references == 0)
+        {
+            Logger::log(LOG_DEBUG, "Evicting linked image of %ld bytes\n", (long)entry->size);
+            totalBytes -= entry->size;
+            entries.erase(entry->key);
+            it = recentlyUsed.erase(it);
+            delete[] entry->image;
+            delete entry;
+        }
+    }
+}
+
+/**
+ * Returns the path of the file for the given key
+ */
+std::string LinkCache::getPath(const LinkCacheKey &key)
+{
+    char name[64];
+    snprintf(name, sizeof(name), "%016llx%016llx.cubin", key.h1, key.h2);
+    std::string path = directory;
+    char last = path[path.length() - 1];
+    if (last != '/' && last != '\\')
+    {
+        path += "/";
+    }
+    return path + name;
+}
+
+/**
+ * Returns the number of bytes between the current position and the
+ * end of the given file, or -1 if it can not be determined
+ */
+static jcuda_int64 getRemainingLength(FILE *file)
+{
+    long position = ftell(file);
+    if (position < 0 || fseek(file, 0, SEEK_END) != 0)
+    {
+        return -1;
+    }
+    long length = ftell(file);
+    if (fseek(file, position, SEEK_SET) != 0 || length < position)
+    {
+        return -1;
+    }
+    return (jcuda_int64)(length - position);
+}
+
+/**
+ * Reads the entry for the given key from its file. Returns NULL if
+ * there is no valid file for the key. The size of the image is checked
+ * against the length of the file before the image is allocated, so
+ * that a corrupted file can not cause a huge allocation.
+ */
+LinkCacheEntry* LinkCache::read(const LinkCacheKey &key)
+{
+    std::string path = getPath(key);
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file == NULL)
+    {
+        return NULL;
+    }
+    int header[2] = { 0, 0 };
+    jcuda_int64 values[2] = { 0, 0 };
+    LinkCacheEntry *entry = NULL;
+    if (fread(header, sizeof(int), 2, file) == 2 &&
+        header[0] == LINK_CACHE_FILE_MAGIC && header[1] == LINK_CACHE_FILE_VERSION &&
+        fread(values, sizeof(jcuda_int64), 2, file) == 2 && values[1] > 0 &&
+        values[1] <= getRemainingLength(file))
+    {
+        size_t size = (size_t)values[1];
+        char *image = new char[size];
+        if (fread(image, 1, size, file) == size)
+        {
+            entry = new LinkCacheEntry();
+            entry->key = key;
+            entry->image = image;
+            entry->size = size;
+            entry->linkTime = values[0];
+            entry->references = 0;
+        }
+        else
+        {
+            delete[] image;
+        }
+    }
+    fclose(file);
+    if (entry == NULL)
+    {
+        Logger::log(LOG_WARNING, "Ignoring invalid link cache file %s\n", path.c_str());
+    }
+    return entry;
+}
+
+/**
+ * Writes the given entry into its file. The file is written under a
+ * temporary name and then renamed, so that other processes never see
+ * a partially written file. The temporary name contains the process ID
+ * and the address of the entry, so that it is unique among all
+ * processes that share the cache directory.
+ */
+void LinkCache::write(LinkCacheEntry *entry)
+{
+    std::string path = getPath(entry->key);
+    char suffix[64];
+    snprintf(suffix, sizeof(suffix), ".%d.%p.tmp", SharedMemory::getProcessId(), (void*)entry);
+    std::string temporaryPath = path + suffix;
+    FILE *file = fopen(temporaryPath.c_str(), "wb");
+    if (file == NULL)
+    {
+        Logger::log(LOG_WARNING, "Could not write link cache file %s\n", temporaryPath.c_str());
+        return;
+    }
+    int header[2] = { LINK_CACHE_FILE_MAGIC, LINK_CACHE_FILE_VERSION };
+    jcuda_int64 values[2] = { entry->linkTime, (jcuda_int64)entry->size };
+    bool written =
+        fwrite(header, sizeof(int), 2, file) == 2 &&
+        fwrite(values, sizeof(jcuda_int64), 2, file) == 2 &&
+        fwrite(entry->image, 1, entry->size, file) == entry->size;
+    fclose(file);
+    if (!written || rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+        remove(temporaryPath.c_str());
+    }
+}
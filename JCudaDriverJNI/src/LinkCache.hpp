@@ -0,0 +1,199 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef LINKCACHE
+#define LINKCACHE
+
+#include <cuda.h>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+#include "Threading.hpp"
+
+/** The magic number at the start of the files of a LinkCache */
+#define LINK_CACHE_FILE_MAGIC 0x4A434C43
+
+#define LINK_CACHE_FILE_VERSION 1
+
+
+/**
+ * A 128 bit hash that identifies the inputs and options of a link
+ */
+struct LinkCacheKey
+{
+    unsigned long long h1;
+    unsigned long long h2;
+
+    bool operator<(const LinkCacheKey &other) const
+    {
+        return h1 < other.h1 || (h1 == other.h1 && h2 < other.h2);
+    }
+};
+
+
+/**
+ * Computes the key of a link from the sequence of its inputs and
+ * options. The contents of each input are hashed with MurmurHash3,
+ * and the key is the hash of the sequence of these hashes, the input
+ * types, and the options.
+ */
+class LinkKeyBuilder
+{
+    public:
+        LinkKeyBuilder();
+
+        /**
+         * Adds an input with the given type and contents
+         */
+        void addInput(int type, const void *data, size_t size);
+
+        /**
+         * Adds the given JIT options. Options that only affect the
+         * logs or the reported wall time are ignored.
+         */
+        void addOptions(int numOptions, const CUjit_option *options, void **optionValues);
+
+        /**
+         * Adds the compute capability that the image is linked for
+         */
+        void addTarget(int major, int minor);
+
+        /**
+         * Returns the key for everything that has been added
+         */
+        LinkCacheKey getKey() const;
+
+        /**
+         * Computes the MurmurHash3 (x64, 128 bit) of the given data
+         */
+        static LinkCacheKey hash(const void *data, size_t size, unsigned int seed);
+
+    private:
+        std::vector<char> sequence;
+
+        void append(const void *data, size_t size);
+};
+
+
+/**
+ * A linked image in a LinkCache
+ */
+struct LinkCacheEntry
+{
+    LinkCacheKey key;
+    char *image;
+    size_t size;
+
+    /** The time that the linker needed for the image, in nanoseconds */
+    jcuda_int64 linkTime;
+
+    /** The number of users of the image, guarded by the cache mutex */
+    int references;
+};
+
+
+/**
+ * A content-addressed cache for the images that are created by the
+ * linker. The images are identified by a LinkCacheKey. The cache keeps
+ * the images in memory, up to the given number of bytes, and evicts the
+ * least recently used images that are not in use. If a directory is
+ * given, then each image is also written into a file in this directory,
+ * so that the image may be found by later processes.
+ */
+class LinkCache
+{
+    public:
+
+        /**
+         * Creates a cache that keeps at most the given number of bytes
+         * in memory, and stores the images in the given directory, if
+         * it is not NULL
+         */
+        LinkCache(const char *directory, size_t maxBytes);
+
+        /**
+         * Deletes all images from memory. No entry may be in use.
+         */
+        ~LinkCache();
+
+        /**
+         * Looks up the image for the given key in memory, and then in
+         * the directory. If it is found, the returned entry is in use
+         * until it is released. Otherwise, NULL is returned.
+         */
+        LinkCacheEntry* lookup(const LinkCacheKey &key);
+
+        /**
+         * Inserts a copy of the given image that the linker created for
+         * the given key in the given time. The returned entry is in use
+         * until it is released.
+         */
+        LinkCacheEntry* insert(const LinkCacheKey &key, const void *image, size_t size, jcuda_int64 linkTime);
+
+        /**
+         * Releases the given entry that was returned by lookup or insert
+         */
+        void release(LinkCacheEntry *entry);
+
+        /**
+         * Obtains the number of lookups that have been answered from
+         * memory and from the directory, the number of lookups that
+         * failed, and the time that was saved by not invoking the
+         * linker, in nanoseconds
+         */
+        void getStatistics(jcuda_int64 *hits, jcuda_int64 *diskHits,
+            jcuda_int64 *misses, jcuda_int64 *savedTime);
+
+    private:
+        std::string directory;
+        size_t maxBytes;
+
+        /** The entries and the LRU order, guarded by the mutex */
+        Mutex mutex;
+        std::map<LinkCacheKey, LinkCacheEntry*> entries;
+        std::list<LinkCacheEntry*> recentlyUsed;
+        size_t totalBytes;
+
+        jcuda_int64 hits;
+        jcuda_int64 diskHits;
+        jcuda_int64 misses;
+        jcuda_int64 savedTime;
+
+        LinkCacheEntry* add(const LinkCacheKey &key, char *image, size_t size, jcuda_int64 linkTime);
+        void touch(LinkCacheEntry *entry);
+        void evict();
+        std::string getPath(const LinkCacheKey &key);
+        LinkCacheEntry* read(const LinkCacheKey &key);
+        void write(LinkCacheEntry *entry);
+
+        LinkCache(const LinkCache&);
+        LinkCache& operator=(const LinkCache&);
+};
+
+
+#endif
@@ -0,0 +1,426 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "MemoryGovernor.hpp"
+#include "Logger.hpp"
+
+#include <cstring>
+#include <map>
+#include <vector>
+
+/**
+ * An eviction function that was added to the governor. The entry is
+ * referenced by the list of the governor, and by each thread that is
+ * currently relieving the pressure with a snapshot of this list.
+ */
+struct EvictionEntry
+{
+    EvictionFunction function;
+    EvictionCleanupFunction cleanup;
+    void *userData;
+    int device;
+    bool cache;
+    int references;
+};
+
+/**
+ * The state of one device
+ */
+struct DeviceMemoryState
+{
+    /** Whether freeBytes holds a value that was queried */
+    bool known;
+
+    /** The time of the last query, in nanoseconds */
+    jcuda_int64 pollTime;
+
+    /** Whether a thread is currently relieving the pressure */
+    bool relieving;
+
+    MemoryGovernorStatistics statistics;
+};
+
+static Mutex mutex;
+static ConditionVariable condition;
+
+static volatile int enabledFlag = 0;
+static size_t lowWatermark = 0;
+static size_t criticalWatermark = 0;
+static size_t largeAllocationSize = 0;
+static jcuda_int64 pollInterval = 0;
+static int throttleTimeoutMs = 0;
+
+static std::vector<EvictionEntry*> entries;
+static std::map<int, DeviceMemoryState> states;
+
+/** The number of threads that currently call eviction functions */
+static int relievingThreads = 0;
+
+/**
+ * Whether the calling thread currently calls eviction functions.
+ * Allocations and frees that are made by eviction functions are
+ * tracked, but not governed.
+ */
+static JCUDA_THREAD_LOCAL bool evicting = false;
+
+
+/**
+ * Returns the state of the given device. The mutex must be locked.
+ */
+static DeviceMemoryState& getState(int device)
+{
+    std::map<int, DeviceMemoryState>::iterator it = states.find(device);
+    if (it == states.end())
+    {
+        DeviceMemoryState state;
+        memset(&state, 0, sizeof(DeviceMemoryState));
+        it = states.insert(std::make_pair(device, state)).first;
+    }
+    return it->second;
+}
+
+/**
+ * Queries the free memory of the current context, if the state is not
+ * known, the poll interval elapsed, or the update is forced. The mutex
+ * must be locked, and the context of the device must be current.
+ */
+static void poll(DeviceMemoryState &state, bool force)
+{
+    jcuda_int64 now = getNanoTime();
+    if (state.known && !force && now - state.pollTime < pollInterval)
+    {
+        return;
+    }
+    size_t freeBytes = 0;
+    size_t totalBytes = 0;
+    if (cuMemGetInfo(&freeBytes, &totalBytes) == CUDA_SUCCESS)
+    {
+        state.statistics.freeBytes = (jcuda_int64)freeBytes;
+        state.known = true;
+        state.pollTime = now;
+    }
+}
+
+/**
+ * Returns how many bytes would remain free after an allocation of
+ * the given size, or 0 if the allocation exceeds the free memory
+ */
+static size_t getRemaining(DeviceMemoryState &state, size_t size)
+{
+    jcuda_int64 remaining = state.statistics.freeBytes - (jcuda_int64)size;
+    return remaining > 0 ? (size_t)remaining : 0;
+}
+
+/**
+ * Releases one reference to each of the given entries, and cleans
+ * up the entries that are no longer referenced. The mutex must not
+ * be locked.
+ */
+static void releaseEntries(std::vector<EvictionEntry*> &released)
+{
+    std::vector<EvictionEntry*> unused;
+    {
+        MutexLock lock(mutex);
+        for (size_t i=0; i<released.size(); i++)
+        {
+            EvictionEntry *entry = released[i];
+            entry->references--;
+            if (entry->references == 0)
+            {
+                unused.push_back(entry);
+            }
+        }
+        condition.broadcast();
+    }
+    for (size_t i=0; i<unused.size(); i++)
+    {
+        EvictionEntry *entry = unused[i];
+        if (entry->cleanup != NULL)
+        {
+            entry->cleanup(entry->userData);
+        }
+        delete entry;
+    }
+}
+
+/**
+ * Calls the eviction functions for the given device until the given
+ * number of bytes has been released. The mutex must be locked when
+ * this is called, and it will be locked when this returns, but it is
+ * unlocked while the functions are called.
+ */
+static void relieve(int device, size_t bytes)
+{
+    DeviceMemoryState &state = getState(device);
+    if (state.relieving || evicting)
+    {
+        return;
+    }
+    Logger::log(LOG_DEBUG, "Relieving memory pressure on device %d for %ld bytes\n", device, (long)bytes);
+
+    state.relieving = true;
+    relievingThreads++;
+    std::vector<EvictionEntry*> snapshot;
+    for (int pass=0; pass<2; pass++)
+    {
+        for (size_t i=0; i<entries.size(); i++)
+        {
+            EvictionEntry *entry = entries[i];
+            bool cachePass = (pass == 0);
+            if (entry->cache == cachePass && (entry->device == -1 || entry->device == device))
+            {
+                entry->references++;
+                snapshot.push_back(entry);
+            }
+        }
+    }
+    mutex.unlock();
+
+    evicting = true;
+    size_t released = 0;
+    for (size_t i=0; i<snapshot.size(); i++)
+    {
+        EvictionEntry *entry = snapshot[i];
+        if (!entry->cache && released >= bytes)
+        {
+            break;
+        }
+        released += entry->function(entry->userData, device, bytes - (released < bytes ? released : bytes));
+    }
+    evicting = false;
+    releaseEntries(snapshot);
+
+    mutex.lock();
+    relievingThreads--;
+    state.relieving = false;
+    state.statistics.evictedBytes += (jcuda_int64)released;
+    poll(state, true);
+    condition.broadcast();
+}
+
+
+void MemoryGovernor::enable(size_t low, size_t critical,
+    size_t largeSize, int pollIntervalMs, int timeoutMs)
+{
+    MutexLock lock(mutex);
+    lowWatermark = low;
+    criticalWatermark = critical;
+    largeAllocationSize = largeSize;
+    pollInterval = (jcuda_int64)pollIntervalMs * 1000000;
+    throttleTimeoutMs = timeoutMs;
+    for (std::map<int, DeviceMemoryState>::iterator it = states.begin(); it != states.end(); ++it)
+    {
+        it->second.known = false;
+    }
+    atomicCompareAndSwap(&enabledFlag, 0, 1);
+}
+
+void MemoryGovernor::disable()
+{
+    MutexLock lock(mutex);
+    atomicCompareAndSwap(&enabledFlag, 1, 0);
+    condition.broadcast();
+}
+
+bool MemoryGovernor::isEnabled()
+{
+    return atomicLoad(&enabledFlag) != 0;
+}
+
+void MemoryGovernor::addEvictionFunction(EvictionFunction function,
+    EvictionCleanupFunction cleanup, void *userData, int device, bool cache)
+{
+    EvictionEntry *entry = new EvictionEntry();
+    entry->function = function;
+    entry->cleanup = cleanup;
+    entry->userData = userData;
+    entry->device = device;
+    entry->cache = cache;
+    entry->references = 1;
+
+    MutexLock lock(mutex);
+    entries.push_back(entry);
+}
+
+int MemoryGovernor::removeEvictionFunctions(EvictionMatchFunction match, void *argument)
+{
+    std::vector<EvictionEntry*> removed;
+    {
+        MutexLock lock(mutex);
+        std::vector<EvictionEntry*>::iterator it = entries.begin();
+        while (it != entries.end())
+        {
+            if (match((*it)->userData, argument))
+            {
+                removed.push_back(*it);
+                it = entries.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        // Wait until the removed entries are only referenced by the
+        // list, and possibly by the snapshot of the calling thread
+        int ownReferences = evicting ? 1 : 0;
+        bool inUse = true;
+        while (inUse)
+        {
+            inUse = false;
+            for (size_t i=0; i<removed.size(); i++)
+            {
+                if (removed[i]->references > 1 + ownReferences)
+                {
+                    inUse = true;
+                }
+            }
+            if (inUse)
+            {
+                condition.wait(mutex);
+            }
+        }
+    }
+    releaseEntries(removed);
+    return (int)removed.size();
+}
+
+void MemoryGovernor::beforeAllocation(int device, size_t size)
+{
+    if (!isEnabled() || evicting || device < 0)
+    {
+        return;
+    }
+    MutexLock lock(mutex);
+    DeviceMemoryState &state = getState(device);
+    poll(state, false);
+    if (!state.known)
+    {
+        return;
+    }
+    if (getRemaining(state, size) < lowWatermark)
+    {
+        relieve(device, lowWatermark - getRemaining(state, size));
+    }
+    if (size < largeAllocationSize || getRemaining(state, size) >= criticalWatermark)
+    {
+        return;
+    }
+
+    Logger::log(LOG_DEBUG, "Throttling allocation of %ld bytes on device %d\n", (long)size, device);
+    state.statistics.throttledAllocations++;
+    jcuda_int64 deadline = getNanoTime() + (jcuda_int64)throttleTimeoutMs * 1000000;
+    while (isEnabled() && getRemaining(state, size) < criticalWatermark)
+    {
+        jcuda_int64 remainingMs = (deadline - getNanoTime()) / 1000000;
+        if (remainingMs <= 0)
+        {
+            break;
+        }
+        condition.wait(mutex, (long)remainingMs);
+        poll(state, false);
+    }
+}
+
+bool MemoryGovernor::allocationFailed(int device, size_t size)
+{
+    if (!isEnabled() || evicting || device < 0)
+    {
+        return false;
+    }
+    MutexLock lock(mutex);
+    DeviceMemoryState &state = getState(device);
+
+    // If another thread is relieving the pressure, wait for it, and
+    // only relieve it here if this did not release enough memory
+    while (state.relieving)
+    {
+        condition.wait(mutex);
+    }
+    poll(state, true);
+    if (getRemaining(state, size) < lowWatermark)
+    {
+        relieve(device, size + lowWatermark - getRemaining(state, size));
+    }
+    return true;
+}
+
+void MemoryGovernor::allocated(int device, size_t size)
+{
+    if (!isEnabled() || device < 0)
+    {
+        return;
+    }
+    MutexLock lock(mutex);
+    DeviceMemoryState &state = getState(device);
+    state.statistics.allocatedBytes += (jcuda_int64)size;
+    state.statistics.freeBytes -= (jcuda_int64)size;
+    if (state.statistics.freeBytes < 0)
+    {
+        state.statistics.freeBytes = 0;
+    }
+}
+
+void MemoryGovernor::freed(int device, size_t size)
+{
+    if (!isEnabled() || device < 0)
+    {
+        return;
+    }
+    MutexLock lock(mutex);
+    DeviceMemoryState &state = getState(device);
+
+    // The memory may have been allocated while the governor was disabled
+    state.statistics.allocatedBytes -= (jcuda_int64)size;
+    if (state.statistics.allocatedBytes < 0)
+    {
+        state.statistics.allocatedBytes = 0;
+    }
+    state.statistics.freeBytes += (jcuda_int64)size;
+    condition.broadcast();
+}
+
+void MemoryGovernor::invalidate()
+{
+    MutexLock lock(mutex);
+    for (std::map<int, DeviceMemoryState>::iterator it = states.begin(); it != states.end(); ++it)
+    {
+        it->second.known = false;
+    }
+}
+
+bool MemoryGovernor::getStatistics(int device, MemoryGovernorStatistics *statistics)
+{
+    MutexLock lock(mutex);
+    std::map<int, DeviceMemoryState>::iterator it = states.find(device);
+    if (it == states.end())
+    {
+        return false;
+    }
+    *statistics = it->second.statistics;
+    return true;
+}
@@ -0,0 +1,180 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MEMORYGOVERNOR
+#define MEMORYGOVERNOR
+
+#include <cuda.h>
+#include "Threading.hpp"
+
+/**
+ * The type of the functions that are called by the MemoryGovernor to
+ * release memory of the given device. The function should try to
+ * release at least the given number of bytes, and return the number
+ * of bytes that have actually been released (or 0 if this is not
+ * known).
+ */
+typedef size_t (*EvictionFunction)(void *userData, int device, size_t bytes);
+
+/**
+ * The type of the function that is called when an EvictionFunction
+ * has been removed and is no longer used
+ */
+typedef void (*EvictionCleanupFunction)(void *userData);
+
+/**
+ * The type of the function that is used for selecting the
+ * EvictionFunctions that should be removed from the MemoryGovernor
+ */
+typedef bool (*EvictionMatchFunction)(void *userData, void *argument);
+
+
+/**
+ * Statistics about the memory of one device, as seen by the
+ * MemoryGovernor
+ */
+struct MemoryGovernorStatistics
+{
+    /** The number of bytes that are allocated through the bindings */
+    jcuda_int64 allocatedBytes;
+
+    /**
+     * The estimated number of free bytes: The result of the last
+     * cuMemGetInfo call, updated with the allocations and frees
+     * since then
+     */
+    jcuda_int64 freeBytes;
+
+    /** The number of bytes that eviction functions reported as released */
+    jcuda_int64 evictedBytes;
+
+    /** The number of allocations that had to wait for free memory */
+    jcuda_int64 throttledAllocations;
+};
+
+
+/**
+ * A governor for the device memory that is allocated through the
+ * bindings. The governor tracks the allocations and frees of each
+ * device, and queries the actual amount of free memory with
+ * cuMemGetInfo, at most once per poll interval.<br />
+ * <br />
+ * When an allocation would let the free memory of a device fall below
+ * the low watermark, the governor relieves the pressure before the
+ * allocation is made: It first calls the eviction functions that have
+ * been registered for caches of the bindings, and then the eviction
+ * functions that have been registered by the application, until enough
+ * memory was released. The idle handles of IPC registries are the only
+ * cache of the bindings that holds device memory. The other caches
+ * (host arenas, staging buffers and registered host memory) only hold
+ * host memory, and are not trimmed.
+ * Only one thread relieves the pressure on a device at a time.<br />
+ * <br />
+ * Large allocations that would let the free memory fall below the
+ * critical watermark are throttled: They wait until other threads
+ * have freed enough memory, or until the throttle timeout elapsed.
+ * When an allocation fails with CUDA_ERROR_OUT_OF_MEMORY, the governor
+ * relieves the pressure for the requested size, so that the allocation
+ * may be retried once, without synchronizing or freeing everything.
+ * <br />
+ * The governor is disabled by default. Allocations and frees are only
+ * tracked while it is enabled, so that they do not have to lock the
+ * governor otherwise. The number of allocated bytes thus only covers
+ * the allocations that have been made while the governor was enabled.
+ */
+class MemoryGovernor
+{
+    public:
+
+        /**
+         * Enables the governor with the given thresholds, in bytes,
+         * and the given intervals, in milliseconds
+         */
+        static void enable(size_t lowWatermark, size_t criticalWatermark,
+            size_t largeAllocationSize, int pollIntervalMs, int throttleTimeoutMs);
+
+        static void disable();
+
+        static bool isEnabled();
+
+        /**
+         * Adds the given eviction function for the given device, or for
+         * all devices if the device is -1. Functions for caches of the
+         * bindings are called before all others, and are always called
+         * when the pressure is relieved.
+         */
+        static void addEvictionFunction(EvictionFunction function,
+            EvictionCleanupFunction cleanup, void *userData, int device, bool cache);
+
+        /**
+         * Removes all eviction functions whose user data is accepted by
+         * the given match function, and returns their number. This waits
+         * until the removed functions are no longer executed by other
+         * threads. The cleanup functions are called when the functions
+         * are no longer used.
+         */
+        static int removeEvictionFunctions(EvictionMatchFunction match, void *argument);
+
+        /**
+         * Called before an allocation of the given size is made on the
+         * given device. This may relieve the pressure, or wait for
+         * free memory, as described above.
+         */
+        static void beforeAllocation(int device, size_t size);
+
+        /**
+         * Called when an allocation of the given size failed with
+         * CUDA_ERROR_OUT_OF_MEMORY. Relieves the pressure, and returns
+         * whether the allocation should be retried.
+         */
+        static bool allocationFailed(int device, size_t size);
+
+        /**
+         * Records an allocation or free of the given size, if the
+         * governor is enabled
+         */
+        static void allocated(int device, size_t size);
+        static void freed(int device, size_t size);
+
+        /**
+         * Forces a query of the free memory before the next allocation
+         * on any device, e.g. after a context has been destroyed
+         */
+        static void invalidate();
+
+        /**
+         * Obtains the statistics for the given device. Returns false if
+         * no allocations have been made on this device.
+         */
+        static bool getStatistics(int device, MemoryGovernorStatistics *statistics);
+
+    private:
+        MemoryGovernor();
+};
+
+
+#endif
@@ -0,0 +1,267 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ModuleLoader.hpp"
+#include "ContextTracker.hpp"
+#include "Logger.hpp"
+
+#include <string.h>
+
+
+//=== ModuleFuture ===========================================================
+
+ModuleFuture::ModuleFuture(char *image, int references)
+{
+    this->image = image;
+    this->references = references;
+    completed = false;
+    result = CUDA_SUCCESS;
+    module = NULL;
+    errorLog[0] = 0;
+}
+
+ModuleFuture::~ModuleFuture()
+{
+    delete[] image;
+}
+
+void ModuleFuture::waitForCompletion()
+{
+    while (!completed)
+    {
+        condition.wait(mutex);
+    }
+}
+
+CUresult ModuleFuture::query()
+{
+    MutexLock lock(mutex);
+    if (!completed)
+    {
+        return CUDA_ERROR_NOT_READY;
+    }
+    return result;
+}
+
+CUresult ModuleFuture::get(CUmodule *module)
+{
+    MutexLock lock(mutex);
+    waitForCompletion();
+    *module = this->module;
+    return result;
+}
+
+CUresult ModuleFuture::getFunction(const char *name, CUfunction *function)
+{
+    MutexLock lock(mutex);
+    waitForCompletion();
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    std::map<std::string, CUfunction>::iterator it = functions.find(name);
+    if (it != functions.end())
+    {
+        *function = it->second;
+        return CUDA_SUCCESS;
+    }
+    CUresult getResult = cuModuleGetFunction(function, module, name);
+    if (getResult == CUDA_SUCCESS)
+    {
+        functions[name] = *function;
+    }
+    return getResult;
+}
+
+const char* ModuleFuture::getErrorLog()
+{
+    MutexLock lock(mutex);
+    waitForCompletion();
+    return errorLog;
+}
+
+void ModuleFuture::retain()
+{
+    atomicAdd(&references, 1);
+}
+
+void ModuleFuture::release()
+{
+    if (atomicAdd(&references, -1) == 0)
+    {
+        delete this;
+    }
+}
+
+
+//=== ModuleLoader ===========================================================
+
+ModuleLoader::ModuleLoader(CUcontext context, int threadCount, ThreadFunction workerExit)
+{
+    this->context = context;
+    this->workerExit = workerExit;
+    if (threadCount <= 0)
+    {
+        threadCount = Thread::getProcessorCount();
+    }
+    for (int i=0; i<threadCount; i++)
+    {
+        threads.push_back(new Thread());
+    }
+    pendingLoads = 0;
+    stopping = false;
+}
+
+ModuleLoader::~ModuleLoader()
+{
+    {
+        MutexLock lock(mutex);
+        stopping = true;
+        condition.broadcast();
+    }
+    for (size_t i=0; i<threads.size(); i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+}
+
+CUresult ModuleLoader::init()
+{
+    for (size_t i=0; i<threads.size(); i++)
+    {
+        if (!threads[i]->start(&ModuleLoader::runWorker, this))
+        {
+            return CUDA_ERROR_UNKNOWN;
+        }
+    }
+    return CUDA_SUCCESS;
+}
+
+CUresult ModuleLoader::load(const void *image, size_t size, ModuleFuture **future)
+{
+    // The image is terminated with a 0, so that PTX images
+    // that are not terminated may be passed as well
+    char *imageCopy = new char[size + 1];
+    memcpy(imageCopy, image, size);
+    imageCopy[size] = 0;
+
+    // One reference for the caller, and one for the worker
+    ModuleFuture *newFuture = new ModuleFuture(imageCopy, 2);
+    *future = newFuture;
+
+    MutexLock lock(mutex);
+    queue.push_back(newFuture);
+    pendingLoads++;
+    condition.signal();
+    return CUDA_SUCCESS;
+}
+
+void ModuleLoader::synchronize()
+{
+    MutexLock lock(mutex);
+    while (pendingLoads > 0)
+    {
+        condition.wait(mutex);
+    }
+}
+
+void ModuleLoader::runWorker(void *loader)
+{
+    ModuleLoader *moduleLoader = (ModuleLoader*)loader;
+    moduleLoader->work();
+    if (moduleLoader->workerExit != NULL)
+    {
+        moduleLoader->workerExit(NULL);
+    }
+}
+
+/**
+ * The main loop of a worker: Takes the futures from the queue and
+ * loads their modules, until the loader is stopped and the queue
+ * is empty
+ */
+void ModuleLoader::work()
+{
+    ContextTracker::setCurrent(context);
+    while (true)
+    {
+        ModuleFuture *future = NULL;
+        {
+            MutexLock lock(mutex);
+            while (queue.empty() && !stopping)
+            {
+                condition.wait(mutex);
+            }
+            if (queue.empty())
+            {
+                break;
+            }
+            future = queue.front();
+            queue.pop_front();
+        }
+        loadModule(future);
+        future->release();
+
+        MutexLock lock(mutex);
+        pendingLoads--;
+        condition.broadcast();
+    }
+    ContextTracker::setCurrent(NULL);
+}
+
+/**
+ * Loads the module of the given future, and completes the future
+ */
+void ModuleLoader::loadModule(ModuleFuture *future)
+{
+    char errorLog[MODULE_ERROR_LOG_SIZE];
+    errorLog[0] = 0;
+    CUjit_option options[2];
+    void *optionValues[2];
+    options[0] = CU_JIT_ERROR_LOG_BUFFER;
+    optionValues[0] = (void*)errorLog;
+    options[1] = CU_JIT_ERROR_LOG_BUFFER_SIZE_BYTES;
+    optionValues[1] = (void*)(size_t)MODULE_ERROR_LOG_SIZE;
+
+    jcuda_int64 before = getNanoTime();
+    CUmodule module = NULL;
+    CUresult result = cuModuleLoadDataEx(&module, future->image, 2, options, optionValues);
+    jcuda_int64 after = getNanoTime();
+    Logger::log(LOG_DEBUG, "Loaded module in %ld microseconds, result %d\n",
+        (long)((after - before) / 1000), (int)result);
+
+    MutexLock lock(future->mutex);
+    delete[] future->image;
+    future->image = NULL;
+    future->module = module;
+    future->result = result;
+    memcpy(future->errorLog, errorLog, MODULE_ERROR_LOG_SIZE);
+    future->errorLog[MODULE_ERROR_LOG_SIZE - 1] = 0;
+    future->completed = true;
+    future->condition.broadcast();
+}
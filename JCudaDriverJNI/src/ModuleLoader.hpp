@@ -0,0 +1,181 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MODULELOADER
+#define MODULELOADER
+
+#include <cuda.h>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+#include "Threading.hpp"
+
+/** The size of the buffer for the JIT error log of a module */
+#define MODULE_ERROR_LOG_SIZE 4096
+
+
+class ModuleLoader;
+
+/**
+ * The result of loading a module with a ModuleLoader
+ */
+class ModuleFuture
+{
+    public:
+
+        /**
+         * Returns CUDA_ERROR_NOT_READY if the module is not loaded
+         * yet, and otherwise the result of cuModuleLoadDataEx
+         */
+        CUresult query();
+
+        /**
+         * Waits until the module is loaded, and returns the result
+         * of cuModuleLoadDataEx and the module
+         */
+        CUresult get(CUmodule *module);
+
+        /**
+         * Waits until the module is loaded, and returns the function
+         * with the given name. Functions are only looked up once.
+         */
+        CUresult getFunction(const char *name, CUfunction *function);
+
+        /**
+         * Waits until the module is loaded, and returns the JIT error
+         * log. The log remains valid until this future is deleted.
+         */
+        const char* getErrorLog();
+
+        /**
+         * Adds a reference to this future
+         */
+        void retain();
+
+        /**
+         * Releases one reference to this future. The future is deleted
+         * when it is complete and all references have been released.
+         * The module is not unloaded.
+         */
+        void release();
+
+    private:
+        friend class ModuleLoader;
+
+        ModuleFuture(char *image, int references);
+        ~ModuleFuture();
+
+        /** The copy of the image, which is deleted after loading */
+        char *image;
+
+        volatile int references;
+
+        /** The completion state, guarded by the mutex */
+        Mutex mutex;
+        ConditionVariable condition;
+        bool completed;
+        CUresult result;
+        CUmodule module;
+        char errorLog[MODULE_ERROR_LOG_SIZE];
+
+        /** The functions that have been looked up, guarded by the mutex */
+        std::map<std::string, CUfunction> functions;
+
+        void waitForCompletion();
+
+        ModuleFuture(const ModuleFuture&);
+        ModuleFuture& operator=(const ModuleFuture&);
+};
+
+
+/**
+ * A service that loads modules concurrently. It has a pool of worker
+ * threads, which all make the same context current, and load the
+ * modules that have been queued with cuModuleLoadDataEx. Since most of
+ * the time of loading a PTX module is spent in the JIT compiler, the
+ * total time for loading many modules is approximately the time for
+ * loading the largest ones, and not the sum of all of them.
+ */
+class ModuleLoader
+{
+    public:
+
+        /**
+         * Creates a new loader that loads modules into the given context
+         * with the given number of worker threads. If the number is not
+         * positive, one thread per processor is used. The given exit
+         * function, if not NULL, is called by each worker thread before
+         * it terminates. The loader has to be initialized with init()
+         * before it can be used.
+         */
+        ModuleLoader(CUcontext context, int threadCount, ThreadFunction workerExit);
+
+        /**
+         * Destroys this loader, after all queued modules have been loaded
+         */
+        ~ModuleLoader();
+
+        /**
+         * Starts the worker threads
+         */
+        CUresult init();
+
+        /**
+         * Queues the given image for loading. The image is copied. The
+         * given future pointer will receive a reference to the future,
+         * which has to be released.
+         */
+        CUresult load(const void *image, size_t size, ModuleFuture **future);
+
+        /**
+         * Waits until all queued modules have been loaded
+         */
+        void synchronize();
+
+    private:
+        CUcontext context;
+        ThreadFunction workerExit;
+        std::vector<Thread*> threads;
+
+        /** The queue and the worker state, guarded by the mutex */
+        Mutex mutex;
+        ConditionVariable condition;
+        std::deque<ModuleFuture*> queue;
+        int pendingLoads;
+        bool stopping;
+
+        static void runWorker(void *loader);
+        void work();
+        void loadModule(ModuleFuture *future);
+
+        ModuleLoader(const ModuleLoader&);
+        ModuleLoader& operator=(const ModuleLoader&);
+};
+
+
+#endif
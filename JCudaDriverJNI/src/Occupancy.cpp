@@ -0,0 +1,577 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "Occupancy.hpp"
+#include "Logger.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+Mutex Occupancy::cacheMutex;
+std::map<Occupancy::CacheKey, Occupancy::CacheEntry> Occupancy::cache;
+std::string Occupancy::cacheFileName;
+
+
+/**
+ * Device attributes that are not available in all CUDA versions,
+ * and that are only used when the driver supports them
+ */
+#define OCCUPANCY_ATTRIBUTE_MAX_SHARED_MEMORY_PER_MULTIPROCESSOR ((CUdevice_attribute)81)
+#define OCCUPANCY_ATTRIBUTE_MAX_REGISTERS_PER_MULTIPROCESSOR     ((CUdevice_attribute)82)
+#define OCCUPANCY_ATTRIBUTE_MAX_BLOCKS_PER_MULTIPROCESSOR        ((CUdevice_attribute)106)
+
+
+/**
+ * Rounds the given value up to a multiple of the given unit
+ */
+static int ceilTo(int value, int unit)
+{
+    return ((value + unit - 1) / unit) * unit;
+}
+
+/**
+ * Rounds the given value down to a multiple of the given unit
+ */
+static int floorTo(int value, int unit)
+{
+    return (value / unit) * unit;
+}
+
+/**
+ * Initializes the properties that depend on the compute capability
+ * and can not be queried in all CUDA versions, following the tables
+ * of the CUDA occupancy calculator
+ */
+static void initArchitectureProperties(OccupancyDeviceProperties *p)
+{
+    int cc = p->major * 10 + p->minor;
+    p->regAllocationPerWarp = true;
+    p->warpAllocationGranularity = 4;
+    p->regAllocationUnitSize = 256;
+    p->sharedMemAllocationUnitSize = 256;
+    p->regsPerMultiProcessor = 65536;
+    if (cc < 12)
+    {
+        p->maxBlocksPerMultiProcessor = 8;
+        p->regsPerMultiProcessor = 8192;
+        p->regAllocationPerWarp = false;
+        p->warpAllocationGranularity = 2;
+        p->sharedMemPerMultiProcessor = 16384;
+        p->sharedMemAllocationUnitSize = 512;
+    }
+    else if (cc < 20)
+    {
+        p->maxBlocksPerMultiProcessor = 8;
+        p->regsPerMultiProcessor = 16384;
+        p->regAllocationUnitSize = 512;
+        p->regAllocationPerWarp = false;
+        p->warpAllocationGranularity = 2;
+        p->sharedMemPerMultiProcessor = 16384;
+        p->sharedMemAllocationUnitSize = 512;
+    }
+    else if (cc < 30)
+    {
+        p->maxBlocksPerMultiProcessor = 8;
+        p->regsPerMultiProcessor = 32768;
+        p->regAllocationUnitSize = 64;
+        p->warpAllocationGranularity = 2;
+        p->sharedMemPerMultiProcessor = 49152;
+        p->sharedMemAllocationUnitSize = 128;
+    }
+    else if (cc < 50)
+    {
+        p->maxBlocksPerMultiProcessor = 16;
+        p->regsPerMultiProcessor = (cc == 37) ? 131072 : 65536;
+        p->sharedMemPerMultiProcessor = (cc == 37) ? 114688 : 49152;
+    }
+    else if (cc < 70)
+    {
+        p->maxBlocksPerMultiProcessor = 32;
+        p->sharedMemPerMultiProcessor = (cc == 52 || cc == 61) ? 98304 : 65536;
+    }
+    else if (cc < 80)
+    {
+        p->maxBlocksPerMultiProcessor = (cc == 75) ? 16 : 32;
+        p->sharedMemPerMultiProcessor = (cc == 75) ? 65536 : 98304;
+    }
+    else if (cc < 90)
+    {
+        p->maxBlocksPerMultiProcessor = (cc == 80) ? 32 : (cc == 89 ? 24 : 16);
+        p->sharedMemPerMultiProcessor = (cc == 80) ? 167936 : 102400;
+    }
+    else
+    {
+        p->maxBlocksPerMultiProcessor = 32;
+        p->sharedMemPerMultiProcessor = 233472;
+    }
+}
+
+
+CUresult Occupancy::getDeviceProperties(CUdevice device, OccupancyDeviceProperties *p)
+{
+    CUresult result = CUDA_SUCCESS;
+    memset(p, 0, sizeof(OccupancyDeviceProperties));
+
+    struct
+    {
+        int *value;
+        CUdevice_attribute attribute;
+    } queries[] =
+    {
+        { &p->major,                       CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MAJOR },
+        { &p->minor,                       CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MINOR },
+        { &p->multiProcessorCount,         CU_DEVICE_ATTRIBUTE_MULTIPROCESSOR_COUNT },
+        { &p->warpSize,                    CU_DEVICE_ATTRIBUTE_WARP_SIZE },
+        { &p->maxThreadsPerBlock,          CU_DEVICE_ATTRIBUTE_MAX_THREADS_PER_BLOCK },
+        { &p->maxThreadsPerMultiProcessor, CU_DEVICE_ATTRIBUTE_MAX_THREADS_PER_MULTIPROCESSOR },
+        { &p->maxRegsPerBlock,             CU_DEVICE_ATTRIBUTE_MAX_REGISTERS_PER_BLOCK },
+        { &p->maxSharedMemPerBlock,        CU_DEVICE_ATTRIBUTE_MAX_SHARED_MEMORY_PER_BLOCK },
+    };
+    int queryCount = (int)(sizeof(queries) / sizeof(queries[0]));
+    for (int i=0; i<queryCount; i++)
+    {
+        result = cuDeviceGetAttribute(queries[i].value, queries[i].attribute, device);
+        if (result != CUDA_SUCCESS)
+        {
+            return result;
+        }
+    }
+    result = cuDeviceGetName(p->name, (int)sizeof(p->name), device);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    if (cuDeviceGetPCIBusId(p->pciBusId, (int)sizeof(p->pciBusId), device) != CUDA_SUCCESS)
+    {
+        p->pciBusId[0] = 0;
+    }
+    initArchitectureProperties(p);
+
+    // Prefer the values that are reported by newer drivers
+    int value = 0;
+    if (cuDeviceGetAttribute(&value, OCCUPANCY_ATTRIBUTE_MAX_SHARED_MEMORY_PER_MULTIPROCESSOR, device) == CUDA_SUCCESS && value > 0)
+    {
+        p->sharedMemPerMultiProcessor = value;
+    }
+    if (cuDeviceGetAttribute(&value, OCCUPANCY_ATTRIBUTE_MAX_REGISTERS_PER_MULTIPROCESSOR, device) == CUDA_SUCCESS && value > 0)
+    {
+        p->regsPerMultiProcessor = value;
+    }
+    if (cuDeviceGetAttribute(&value, OCCUPANCY_ATTRIBUTE_MAX_BLOCKS_PER_MULTIPROCESSOR, device) == CUDA_SUCCESS && value > 0)
+    {
+        p->maxBlocksPerMultiProcessor = value;
+    }
+    return CUDA_SUCCESS;
+}
+
+
+CUresult Occupancy::getFunctionAttributes(CUfunction function, OccupancyFunctionAttributes *attributes)
+{
+    CUresult result = cuFuncGetAttribute(&attributes->numRegs, CU_FUNC_ATTRIBUTE_NUM_REGS, function);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    result = cuFuncGetAttribute(&attributes->sharedSizeBytes, CU_FUNC_ATTRIBUTE_SHARED_SIZE_BYTES, function);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    return cuFuncGetAttribute(&attributes->maxThreadsPerBlock, CU_FUNC_ATTRIBUTE_MAX_THREADS_PER_BLOCK, function);
+}
+
+
+void Occupancy::calculate(const OccupancyDeviceProperties &p,
+    const OccupancyFunctionAttributes &a,
+    int blockSize, int dynamicSharedMemBytes, OccupancyResult *result)
+{
+    memset(result, 0, sizeof(OccupancyResult));
+    result->blockSize = blockSize;
+    result->dynamicSharedMemBytes = dynamicSharedMemBytes;
+
+    int maxBlockSize = p.maxThreadsPerBlock;
+    if (a.maxThreadsPerBlock > 0 && a.maxThreadsPerBlock < maxBlockSize)
+    {
+        maxBlockSize = a.maxThreadsPerBlock;
+    }
+    int sharedMemPerBlock = ceilTo(a.sharedSizeBytes + dynamicSharedMemBytes, p.sharedMemAllocationUnitSize);
+    if (blockSize <= 0 || blockSize > maxBlockSize || p.warpSize <= 0)
+    {
+        result->limitingFactor = OCCUPANCY_LIMIT_BLOCK_SIZE;
+        return;
+    }
+    if (a.sharedSizeBytes + dynamicSharedMemBytes > p.maxSharedMemPerBlock)
+    {
+        result->limitingFactor = OCCUPANCY_LIMIT_SHARED_MEMORY;
+        return;
+    }
+
+    int maxWarpsPerMultiProcessor = p.maxThreadsPerMultiProcessor / p.warpSize;
+    int warpsPerBlock = (blockSize + p.warpSize - 1) / p.warpSize;
+
+    // The limit imposed by the number of warps and blocks
+    int limitWarps = maxWarpsPerMultiProcessor / warpsPerBlock;
+    int limitBlocks = p.maxBlocksPerMultiProcessor;
+
+    // The limit imposed by the registers
+    int limitRegisters = limitBlocks;
+    if (a.numRegs > 0)
+    {
+        if (p.regAllocationPerWarp)
+        {
+            int regsPerWarp = ceilTo(a.numRegs * p.warpSize, p.regAllocationUnitSize);
+            if (regsPerWarp * warpsPerBlock > p.maxRegsPerBlock)
+            {
+                limitRegisters = 0;
+            }
+            else
+            {
+                int warps = floorTo(p.regsPerMultiProcessor / regsPerWarp, p.warpAllocationGranularity);
+                limitRegisters = warps / warpsPerBlock;
+            }
+        }
+        else
+        {
+            int regsPerBlock = ceilTo(ceilTo(warpsPerBlock, p.warpAllocationGranularity) * a.numRegs * p.warpSize, p.regAllocationUnitSize);
+            limitRegisters = p.regsPerMultiProcessor / regsPerBlock;
+        }
+    }
+
+    // The limit imposed by the shared memory
+    int limitSharedMem = limitBlocks;
+    if (sharedMemPerBlock > 0)
+    {
+        limitSharedMem = p.sharedMemPerMultiProcessor / sharedMemPerBlock;
+    }
+
+    int active = limitWarps;
+    result->limitingFactor = OCCUPANCY_LIMIT_WARPS;
+    if (limitBlocks < active)
+    {
+        active = limitBlocks;
+        result->limitingFactor = OCCUPANCY_LIMIT_BLOCKS;
+    }
+    if (limitRegisters < active)
+    {
+        active = limitRegisters;
+        result->limitingFactor = OCCUPANCY_LIMIT_REGISTERS;
+    }
+    if (limitSharedMem < active)
+    {
+        active = limitSharedMem;
+        result->limitingFactor = OCCUPANCY_LIMIT_SHARED_MEMORY;
+    }
+
+    result->activeBlocksPerMultiProcessor = active;
+    result->activeWarpsPerMultiProcessor = active * warpsPerBlock;
+    if (maxWarpsPerMultiProcessor > 0)
+    {
+        result->occupancy = (float)result->activeWarpsPerMultiProcessor / maxWarpsPerMultiProcessor;
+    }
+
+    // The dynamic shared memory that may be used by each of the
+    // active blocks, without reducing their number
+    if (active > 0)
+    {
+        int sharedMem = floorTo(p.sharedMemPerMultiProcessor / active, p.sharedMemAllocationUnitSize);
+        if (sharedMem > p.maxSharedMemPerBlock)
+        {
+            sharedMem = p.maxSharedMemPerBlock;
+        }
+        int maxDynamic = sharedMem - a.sharedSizeBytes;
+        result->maxDynamicSharedMemBytes = maxDynamic > 0 ? maxDynamic : 0;
+    }
+}
+
+
+void Occupancy::recommend(const OccupancyDeviceProperties &p,
+    const OccupancyFunctionAttributes &a,
+    int dynamicSharedMemBytes, int dynamicSharedMemBytesPerThread,
+    int blockSizeLimit, OccupancyResult *result)
+{
+    int maxBlockSize = p.maxThreadsPerBlock;
+    if (a.maxThreadsPerBlock > 0 && a.maxThreadsPerBlock < maxBlockSize)
+    {
+        maxBlockSize = a.maxThreadsPerBlock;
+    }
+    if (blockSizeLimit > 0 && blockSizeLimit < maxBlockSize)
+    {
+        maxBlockSize = blockSizeLimit;
+    }
+    int granularity = p.warpSize > 0 ? p.warpSize : 32;
+
+    OccupancyResult candidate;
+    bool found = false;
+    for (int blockSize = floorTo(maxBlockSize, granularity); blockSize > 0; blockSize -= granularity)
+    {
+        int sharedMem = dynamicSharedMemBytes + blockSize * dynamicSharedMemBytesPerThread;
+        calculate(p, a, blockSize, sharedMem, &candidate);
+        if (!found || candidate.occupancy > result->occupancy)
+        {
+            *result = candidate;
+            found = true;
+        }
+    }
+    if (!found)
+    {
+        calculate(p, a, maxBlockSize, dynamicSharedMemBytes + maxBlockSize * dynamicSharedMemBytesPerThread, result);
+    }
+}
+
+
+/**
+ * FNV-1a hash of the given string, followed by the bytes of the
+ * given launch parameters
+ */
+jcuda_int64 Occupancy::hash(const char *key, size_t threadCount, int dynamicSharedMemBytes)
+{
+    unsigned long long h = 14695981039346656037ULL;
+    for (const unsigned char *c = (const unsigned char*)key; *c != 0; c++)
+    {
+        h ^= *c;
+        h *= 1099511628211ULL;
+    }
+    unsigned long long parameters[2] =
+    {
+        (unsigned long long)threadCount,
+        (unsigned long long)(unsigned int)dynamicSharedMemBytes
+    };
+    for (int i=0; i<2; i++)
+    {
+        for (int b=0; b<8; b++)
+        {
+            h ^= (parameters[i] >> (8 * b)) & 0xFF;
+            h *= 1099511628211ULL;
+        }
+    }
+    return (jcuda_int64)h;
+}
+
+
+/**
+ * Stores the given entry in the cache, and appends it to the cache
+ * file, if there is one. The cacheMutex must be held by the caller.
+ */
+void Occupancy::store(const CacheKey &key, const CacheEntry &entry)
+{
+    cache[key] = entry;
+    if (cacheFileName.empty())
+    {
+        return;
+    }
+    FILE *file = fopen(cacheFileName.c_str(), "a");
+    if (file == NULL)
+    {
+        Logger::log(LOG_ERROR, "Could not write autotuning result to %s\n", cacheFileName.c_str());
+        return;
+    }
+    fprintf(file, "%016llx\t%d\t%d\t%g\t%s\n", (unsigned long long)key.second,
+        entry.blockSize, entry.dynamicSharedMemBytes, entry.elapsedTime, key.first.c_str());
+    fclose(file);
+}
+
+
+bool Occupancy::setCacheFile(const char *fileName)
+{
+    MutexLock lock(cacheMutex);
+    if (fileName == NULL)
+    {
+        cacheFileName.clear();
+        return true;
+    }
+    cacheFileName = fileName;
+    FILE *file = fopen(fileName, "r");
+    if (file == NULL)
+    {
+        return true;
+    }
+
+    // Each line contains the hash, the block size, the dynamic shared
+    // memory, the elapsed time and the device (the PCI bus ID and the
+    // name). Later entries replace earlier ones.
+    char line[512];
+    bool valid = true;
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        unsigned long long h = 0;
+        CacheEntry entry;
+        int offset = 0;
+        if (sscanf(line, "%llx\t%d\t%d\t%g\t%n", &h, &entry.blockSize,
+            &entry.dynamicSharedMemBytes, &entry.elapsedTime, &offset) < 4 || offset == 0)
+        {
+            valid = false;
+            continue;
+        }
+        std::string name(line + offset);
+        while (!name.empty() && (name[name.size()-1] == '\n' || name[name.size()-1] == '\r'))
+        {
+            name.erase(name.size()-1);
+        }
+        cache[CacheKey(name, (jcuda_int64)h)] = entry;
+    }
+    fclose(file);
+    return valid;
+}
+
+
+CUresult Occupancy::autotune(CUfunction function, const char *key, size_t threadCount,
+    int dynamicSharedMemBytes, CUstream stream, void **kernelParams,
+    int iterations, OccupancyResult *result)
+{
+    CUdevice device;
+    CUresult error = cuCtxGetDevice(&device);
+    if (error != CUDA_SUCCESS)
+    {
+        return error;
+    }
+    OccupancyDeviceProperties properties;
+    error = getDeviceProperties(device, &properties);
+    if (error != CUDA_SUCCESS)
+    {
+        return error;
+    }
+    OccupancyFunctionAttributes attributes;
+    error = getFunctionAttributes(function, &attributes);
+    if (error != CUDA_SUCCESS)
+    {
+        return error;
+    }
+
+    std::string deviceId = std::string(properties.pciBusId) + " " + properties.name;
+    CacheKey cacheKey(deviceId, hash(key, threadCount, dynamicSharedMemBytes));
+    {
+        MutexLock lock(cacheMutex);
+        std::map<CacheKey, CacheEntry>::iterator it = cache.find(cacheKey);
+        if (it != cache.end())
+        {
+            calculate(properties, attributes, it->second.blockSize, it->second.dynamicSharedMemBytes, result);
+            result->elapsedTime = it->second.elapsedTime;
+            return CUDA_SUCCESS;
+        }
+    }
+
+    OccupancyResult best;
+    recommend(properties, attributes, dynamicSharedMemBytes, 0, 0, &best);
+    if (best.activeBlocksPerMultiProcessor == 0)
+    {
+        *result = best;
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    if (iterations < 1)
+    {
+        iterations = 1;
+    }
+
+    CUevent start = NULL;
+    CUevent stop = NULL;
+    error = cuEventCreate(&start, CU_EVENT_DEFAULT);
+    if (error != CUDA_SUCCESS)
+    {
+        return error;
+    }
+    error = cuEventCreate(&stop, CU_EVENT_DEFAULT);
+    if (error != CUDA_SUCCESS)
+    {
+        cuEventDestroy(start);
+        return error;
+    }
+
+    // Time all block sizes that achieve at least half of the best
+    // occupancy, including the ones that are larger than the block
+    // size with the best occupancy. Block sizes that can not be
+    // launched are skipped. Any other error (e.g. a failure during
+    // the execution) is sticky, so autotuning is stopped.
+    int maxBlockSize = properties.maxThreadsPerBlock;
+    if (attributes.maxThreadsPerBlock > 0 && attributes.maxThreadsPerBlock < maxBlockSize)
+    {
+        maxBlockSize = attributes.maxThreadsPerBlock;
+    }
+    CUresult lastError = CUDA_SUCCESS;
+    bool timed = false;
+    OccupancyResult candidate;
+    for (int blockSize = floorTo(maxBlockSize, properties.warpSize); blockSize > 0; blockSize -= properties.warpSize)
+    {
+        calculate(properties, attributes, blockSize, dynamicSharedMemBytes, &candidate);
+        if (candidate.occupancy * 2 < best.occupancy)
+        {
+            continue;
+        }
+        unsigned int gridSize = (unsigned int)((threadCount + blockSize - 1) / blockSize);
+        if (gridSize == 0)
+        {
+            gridSize = 1;
+        }
+
+        // One launch for warming up, and then the timed launches
+        error = cuLaunchKernel(function, gridSize, 1, 1, blockSize, 1, 1,
+            dynamicSharedMemBytes, stream, kernelParams, NULL);
+        if (error == CUDA_ERROR_LAUNCH_OUT_OF_RESOURCES || error == CUDA_ERROR_INVALID_VALUE)
+        {
+            Logger::log(LOG_DEBUG, "Autotuning %s: Block size %d can not be launched, error %d\n", key, blockSize, error);
+            lastError = error;
+            continue;
+        }
+        if (error == CUDA_SUCCESS) error = cuEventRecord(start, stream);
+        for (int i=0; i<iterations && error == CUDA_SUCCESS; i++)
+        {
+            error = cuLaunchKernel(function, gridSize, 1, 1, blockSize, 1, 1,
+                dynamicSharedMemBytes, stream, kernelParams, NULL);
+        }
+        if (error == CUDA_SUCCESS) error = cuEventRecord(stop, stream);
+        if (error == CUDA_SUCCESS) error = cuEventSynchronize(stop);
+        float milliseconds = 0;
+        if (error == CUDA_SUCCESS) error = cuEventElapsedTime(&milliseconds, start, stop);
+        if (error != CUDA_SUCCESS)
+        {
+            Logger::log(LOG_ERROR, "Autotuning %s: Block size %d failed with %d\n", key, blockSize, error);
+            timed = false;
+            lastError = error;
+            break;
+        }
+        candidate.elapsedTime = milliseconds / iterations;
+        Logger::log(LOG_DEBUG, "Autotuning %s: Block size %d took %f ms\n", key, blockSize, candidate.elapsedTime);
+        if (!timed || candidate.elapsedTime < result->elapsedTime)
+        {
+            *result = candidate;
+            timed = true;
+        }
+    }
+    cuEventDestroy(start);
+    cuEventDestroy(stop);
+    if (!timed)
+    {
+        return lastError;
+    }
+
+    CacheEntry entry;
+    entry.blockSize = result->blockSize;
+    entry.dynamicSharedMemBytes = result->dynamicSharedMemBytes;
+    entry.elapsedTime = result->elapsedTime;
+    MutexLock lock(cacheMutex);
+    store(cacheKey, entry);
+    return CUDA_SUCCESS;
+}
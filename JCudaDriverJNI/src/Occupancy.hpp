@@ -0,0 +1,224 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef OCCUPANCY
+#define OCCUPANCY
+
+#include <cuda.h>
+#include <map>
+#include <string>
+#include "Threading.hpp"
+
+/**
+ * The factors that may limit the number of active blocks
+ * per multiprocessor
+ */
+#define OCCUPANCY_LIMIT_NONE          0
+#define OCCUPANCY_LIMIT_BLOCK_SIZE    1
+#define OCCUPANCY_LIMIT_WARPS         2
+#define OCCUPANCY_LIMIT_BLOCKS        3
+#define OCCUPANCY_LIMIT_REGISTERS     4
+#define OCCUPANCY_LIMIT_SHARED_MEMORY 5
+
+
+/**
+ * The properties of a device that determine the occupancy. Some of
+ * them are queried as device attributes, and the others are taken
+ * from tables for the compute capability of the device.
+ */
+struct OccupancyDeviceProperties
+{
+    int major;
+    int minor;
+    int multiProcessorCount;
+    int warpSize;
+    int maxThreadsPerBlock;
+    int maxThreadsPerMultiProcessor;
+    int maxBlocksPerMultiProcessor;
+    int regsPerMultiProcessor;
+    int maxRegsPerBlock;
+    int regAllocationUnitSize;
+    bool regAllocationPerWarp;
+    int warpAllocationGranularity;
+    int sharedMemPerMultiProcessor;
+    int maxSharedMemPerBlock;
+    int sharedMemAllocationUnitSize;
+
+    /** The name of the device */
+    char name[256];
+
+    /**
+     * The PCI bus ID of the device, or an empty string if it is not
+     * known. Together with the name, it identifies the device for
+     * autotuning results.
+     */
+    char pciBusId[32];
+};
+
+/**
+ * The attributes of a function that determine the occupancy
+ */
+struct OccupancyFunctionAttributes
+{
+    int numRegs;
+    int sharedSizeBytes;
+    int maxThreadsPerBlock;
+};
+
+/**
+ * The occupancy for one launch configuration
+ */
+struct OccupancyResult
+{
+    /** The number of threads per block */
+    int blockSize;
+
+    /** The number of bytes of dynamic shared memory per block */
+    int dynamicSharedMemBytes;
+
+    /**
+     * The maximum number of bytes of dynamic shared memory per block
+     * that may be used without reducing the number of active blocks
+     */
+    int maxDynamicSharedMemBytes;
+
+    /** The number of active blocks per multiprocessor */
+    int activeBlocksPerMultiProcessor;
+
+    /** The number of active warps per multiprocessor */
+    int activeWarpsPerMultiProcessor;
+
+    /** The ratio of active warps to the maximum number of warps */
+    float occupancy;
+
+    /** The OCCUPANCY_LIMIT that limits the number of active blocks */
+    int limitingFactor;
+
+    /**
+     * The time of one launch with this configuration, in milliseconds,
+     * if it was determined by autotuning, or 0.0 otherwise
+     */
+    float elapsedTime;
+};
+
+
+/**
+ * Occupancy calculations for functions, mirroring the CUDA occupancy
+ * calculator, and an autotuner that times candidate configurations.
+ */
+class Occupancy
+{
+    public:
+
+        /**
+         * Obtains the occupancy related properties of the given device
+         */
+        static CUresult getDeviceProperties(CUdevice device, OccupancyDeviceProperties *properties);
+
+        /**
+         * Obtains the occupancy related attributes of the given function
+         */
+        static CUresult getFunctionAttributes(CUfunction function, OccupancyFunctionAttributes *attributes);
+
+        /**
+         * Computes the occupancy for launching a function with the given
+         * attributes on a device with the given properties, with the
+         * given block size and dynamic shared memory
+         */
+        static void calculate(const OccupancyDeviceProperties &properties,
+            const OccupancyFunctionAttributes &attributes,
+            int blockSize, int dynamicSharedMemBytes, OccupancyResult *result);
+
+        /**
+         * Computes the block size that achieves the highest occupancy.
+         * The dynamic shared memory for a block size is given as
+         * dynamicSharedMemBytes + blockSize * dynamicSharedMemBytesPerThread.
+         * If blockSizeLimit is positive, then only block sizes up to this
+         * limit are considered. Among block sizes with the same occupancy,
+         * the largest one is chosen.
+         */
+        static void recommend(const OccupancyDeviceProperties &properties,
+            const OccupancyFunctionAttributes &attributes,
+            int dynamicSharedMemBytes, int dynamicSharedMemBytesPerThread,
+            int blockSizeLimit, OccupancyResult *result);
+
+        /**
+         * Determines the fastest block size for launching the given
+         * function in the current context, for a one-dimensional problem
+         * with the given number of threads. If a result for the given
+         * key, thread count and dynamic shared memory is cached for the
+         * current device (identified by its PCI bus ID and name), then
+         * it is returned without launching the function. Otherwise, all
+         * block sizes that achieve at least half of the best occupancy
+         * are timed with the given number of launches each, and the
+         * winner is stored in the cache.<br />
+         * <br />
+         * The kernel parameters are passed to cuLaunchKernel unmodified,
+         * so the function is executed repeatedly on the buffers of the
+         * caller, which should be scratch buffers unless the function is
+         * idempotent. Block sizes that can not be launched are skipped,
+         * but autotuning stops at the first other error, because errors
+         * during the execution leave the context unusable.
+         */
+        static CUresult autotune(CUfunction function, const char *key, size_t threadCount,
+            int dynamicSharedMemBytes, CUstream stream, void **kernelParams,
+            int iterations, OccupancyResult *result);
+
+        /**
+         * Sets the file that autotuning results are persisted in. Existing
+         * results are read from the file, and new results are appended
+         * to it. Passing NULL disables persisting the results. Returns
+         * whether the file could be read (or did not exist yet).
+         */
+        static bool setCacheFile(const char *fileName);
+
+    private:
+
+        /** An autotuning result that is stored in the cache */
+        struct CacheEntry
+        {
+            int blockSize;
+            int dynamicSharedMemBytes;
+            float elapsedTime;
+        };
+
+        /**
+         * The key of a cache entry: The PCI bus ID and name of the
+         * device, and the hash of the key and the launch parameters
+         */
+        typedef std::pair<std::string, jcuda_int64> CacheKey;
+
+        static Mutex cacheMutex;
+        static std::map<CacheKey, CacheEntry> cache;
+        static std::string cacheFileName;
+
+        static jcuda_int64 hash(const char *key, size_t threadCount, int dynamicSharedMemBytes);
+        static void store(const CacheKey &key, const CacheEntry &entry);
+};
+
+
+#endif
@@ -0,0 +1,345 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "OperationGraph.hpp"
+
+#include <cstring>
+
+JCUDA_THREAD_LOCAL OperationGraph *OperationGraph::capturing = NULL;
+
+/**
+ * The alignment of the kernel parameter values inside the
+ * parameter data of an operation
+ */
+#define PARAM_ALIGNMENT 8
+
+
+OperationGraph::OperationGraph()
+{
+    capturingThreads = 0;
+}
+
+OperationGraph::~OperationGraph()
+{
+    for (size_t i=0; i<operations.size(); i++)
+    {
+        delete operations[i];
+    }
+}
+
+OperationGraph* OperationGraph::getCapturing()
+{
+    return capturing;
+}
+
+CUresult OperationGraph::beginCapture()
+{
+    if (capturing != NULL)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    capturing = this;
+    MutexLock lock(mutex);
+    capturingThreads++;
+    return CUDA_SUCCESS;
+}
+
+CUresult OperationGraph::endCapture()
+{
+    if (capturing != this)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    capturing = NULL;
+    MutexLock lock(mutex);
+    capturingThreads--;
+    return CUDA_SUCCESS;
+}
+
+bool OperationGraph::isCapturing()
+{
+    MutexLock lock(mutex);
+    return capturingThreads > 0;
+}
+
+
+OperationGraph::Operation* OperationGraph::createOperation(int type, CUstream stream)
+{
+    Operation *operation = new Operation();
+    operation->type = type;
+    operation->stream = stream;
+    operation->event = NULL;
+    operation->flags = 0;
+    operation->function = NULL;
+    for (int i=0; i<3; i++)
+    {
+        operation->gridDim[i] = 1;
+        operation->blockDim[i] = 1;
+    }
+    operation->sharedMemBytes = 0;
+    operation->dst = 0;
+    operation->src = 0;
+    operation->size = 0;
+    operation->value = 0;
+    return operation;
+}
+
+
+void OperationGraph::addLaunch(CUfunction function,
+    unsigned int gridDimX, unsigned int gridDimY, unsigned int gridDimZ,
+    unsigned int blockDimX, unsigned int blockDimY, unsigned int blockDimZ,
+    unsigned int sharedMemBytes, CUstream stream,
+    int paramCount, void **paramValues, size_t *paramSizes, const char *paramDevicePointers)
+{
+    Operation *operation = createOperation(OPERATION_LAUNCH, stream);
+    operation->function = function;
+    operation->gridDim[0] = gridDimX;
+    operation->gridDim[1] = gridDimY;
+    operation->gridDim[2] = gridDimZ;
+    operation->blockDim[0] = blockDimX;
+    operation->blockDim[1] = blockDimY;
+    operation->blockDim[2] = blockDimZ;
+    operation->sharedMemBytes = sharedMemBytes;
+
+    // Copy the parameter values into one block of memory, each
+    // of them aligned, and collect the pointers to them
+    size_t total = 0;
+    for (int i=0; i<paramCount; i++)
+    {
+        operation->paramOffsets.push_back(total);
+        operation->paramSizes.push_back(paramSizes[i]);
+        total += (paramSizes[i] + PARAM_ALIGNMENT - 1) / PARAM_ALIGNMENT * PARAM_ALIGNMENT;
+    }
+    operation->paramData.resize(total > 0 ? total : 1);
+    for (int i=0; i<paramCount; i++)
+    {
+        char *target = &operation->paramData[0] + operation->paramOffsets[i];
+        memcpy(target, paramValues[i], paramSizes[i]);
+        operation->paramPointers.push_back(target);
+        operation->paramDevicePointers.push_back(paramDevicePointers[i]);
+    }
+
+    MutexLock lock(mutex);
+    operations.push_back(operation);
+}
+
+void OperationGraph::addMemcpy(int type, CUdeviceptr dst, CUdeviceptr src, size_t byteCount, CUstream stream)
+{
+    Operation *operation = createOperation(type, stream);
+    operation->dst = dst;
+    operation->src = src;
+    operation->size = byteCount;
+    MutexLock lock(mutex);
+    operations.push_back(operation);
+}
+
+void OperationGraph::addMemset(int type, CUdeviceptr dst, unsigned int value, size_t count, CUstream stream)
+{
+    Operation *operation = createOperation(type, stream);
+    operation->dst = dst;
+    operation->value = value;
+    operation->size = count;
+    MutexLock lock(mutex);
+    operations.push_back(operation);
+}
+
+void OperationGraph::addEventRecord(CUevent event, CUstream stream)
+{
+    Operation *operation = createOperation(OPERATION_EVENT_RECORD, stream);
+    operation->event = event;
+    MutexLock lock(mutex);
+    operations.push_back(operation);
+}
+
+void OperationGraph::addStreamWaitEvent(CUstream stream, CUevent event, unsigned int flags)
+{
+    Operation *operation = createOperation(OPERATION_STREAM_WAIT_EVENT, stream);
+    operation->event = event;
+    operation->flags = flags;
+    MutexLock lock(mutex);
+    operations.push_back(operation);
+}
+
+int OperationGraph::getOperationCount()
+{
+    MutexLock lock(mutex);
+    return (int)operations.size();
+}
+
+
+CUresult OperationGraph::execute(Operation *o)
+{
+    switch (o->type)
+    {
+        case OPERATION_LAUNCH:
+            return cuLaunchKernel(o->function,
+                o->gridDim[0], o->gridDim[1], o->gridDim[2],
+                o->blockDim[0], o->blockDim[1], o->blockDim[2],
+                o->sharedMemBytes, o->stream,
+                o->paramPointers.empty() ? NULL : &o->paramPointers[0], NULL);
+
+        case OPERATION_MEMCPY:
+            return cuMemcpyAsync(o->dst, o->src, o->size, o->stream);
+
+        case OPERATION_MEMCPY_HTOD:
+            return cuMemcpyHtoDAsync(o->dst, (const void*)(size_t)o->src, o->size, o->stream);
+
+        case OPERATION_MEMCPY_DTOH:
+            return cuMemcpyDtoHAsync((void*)(size_t)o->dst, o->src, o->size, o->stream);
+
+        case OPERATION_MEMCPY_DTOD:
+            return cuMemcpyDtoDAsync(o->dst, o->src, o->size, o->stream);
+
+        case OPERATION_MEMSET_D8:
+            return cuMemsetD8Async(o->dst, (unsigned char)o->value, o->size, o->stream);
+
+        case OPERATION_MEMSET_D16:
+            return cuMemsetD16Async(o->dst, (unsigned short)o->value, o->size, o->stream);
+
+        case OPERATION_MEMSET_D32:
+            return cuMemsetD32Async(o->dst, o->value, o->size, o->stream);
+
+        case OPERATION_EVENT_RECORD:
+            return cuEventRecord(o->event, o->stream);
+
+        case OPERATION_STREAM_WAIT_EVENT:
+            return cuStreamWaitEvent(o->stream, o->event, o->flags);
+    }
+    return CUDA_ERROR_INVALID_VALUE;
+}
+
+CUresult OperationGraph::launch()
+{
+    MutexLock lock(mutex);
+    for (size_t i=0; i<operations.size(); i++)
+    {
+        CUresult result = execute(operations[i]);
+        if (result != CUDA_SUCCESS)
+        {
+            return result;
+        }
+    }
+    return CUDA_SUCCESS;
+}
+
+
+CUresult OperationGraph::getKernelParamSize(int operation, int param, size_t *size)
+{
+    MutexLock lock(mutex);
+    if (operation < 0 || operation >= (int)operations.size())
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    Operation *o = operations[operation];
+    if (o->type != OPERATION_LAUNCH || param < 0 || param >= (int)o->paramSizes.size())
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    *size = o->paramSizes[param];
+    return CUDA_SUCCESS;
+}
+
+CUresult OperationGraph::setKernelParam(int operation, int param, const void *value)
+{
+    MutexLock lock(mutex);
+    if (operation < 0 || operation >= (int)operations.size())
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    Operation *o = operations[operation];
+    if (o->type != OPERATION_LAUNCH || param < 0 || param >= (int)o->paramSizes.size())
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    memcpy(o->paramPointers[param], value, o->paramSizes[param]);
+    return CUDA_SUCCESS;
+}
+
+
+/**
+ * Replaces the given address if it is in the range that starts at the
+ * old address, and returns whether it was replaced
+ */
+bool OperationGraph::rebind(CUdeviceptr &address, CUdeviceptr oldAddress, size_t size, CUdeviceptr newAddress)
+{
+    if (address >= oldAddress && address < oldAddress + size)
+    {
+        address = newAddress + (address - oldAddress);
+        return true;
+    }
+    return false;
+}
+
+int OperationGraph::rebindAddress(CUdeviceptr oldAddress, size_t size, CUdeviceptr newAddress)
+{
+    MutexLock lock(mutex);
+    int count = 0;
+    for (size_t i=0; i<operations.size(); i++)
+    {
+        Operation *o = operations[i];
+        switch (o->type)
+        {
+            case OPERATION_LAUNCH:
+                for (size_t p=0; p<o->paramSizes.size(); p++)
+                {
+                    if (o->paramDevicePointers[p] && o->paramSizes[p] == sizeof(CUdeviceptr))
+                    {
+                        CUdeviceptr address;
+                        memcpy(&address, o->paramPointers[p], sizeof(CUdeviceptr));
+                        if (rebind(address, oldAddress, size, newAddress))
+                        {
+                            memcpy(o->paramPointers[p], &address, sizeof(CUdeviceptr));
+                            count++;
+                        }
+                    }
+                }
+                break;
+
+            case OPERATION_MEMCPY:
+            case OPERATION_MEMCPY_DTOD:
+                if (rebind(o->src, oldAddress, size, newAddress)) count++;
+                if (rebind(o->dst, oldAddress, size, newAddress)) count++;
+                break;
+
+            // The host addresses of these copies are not rebound
+            case OPERATION_MEMCPY_HTOD:
+                if (rebind(o->dst, oldAddress, size, newAddress)) count++;
+                break;
+
+            case OPERATION_MEMCPY_DTOH:
+                if (rebind(o->src, oldAddress, size, newAddress)) count++;
+                break;
+
+            case OPERATION_MEMSET_D8:
+            case OPERATION_MEMSET_D16:
+            case OPERATION_MEMSET_D32:
+                if (rebind(o->dst, oldAddress, size, newAddress)) count++;
+                break;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,212 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef OPERATIONGRAPH
+#define OPERATIONGRAPH
+
+#include <cuda.h>
+#include <vector>
+#include "Threading.hpp"
+
+/**
+ * The types of the operations in an OperationGraph
+ */
+#define OPERATION_LAUNCH             0
+#define OPERATION_MEMCPY             1
+#define OPERATION_MEMCPY_HTOD        2
+#define OPERATION_MEMCPY_DTOH        3
+#define OPERATION_MEMCPY_DTOD        4
+#define OPERATION_MEMSET_D8          5
+#define OPERATION_MEMSET_D16         6
+#define OPERATION_MEMSET_D32         7
+#define OPERATION_EVENT_RECORD       8
+#define OPERATION_STREAM_WAIT_EVENT  9
+
+
+/**
+ * A sequence of asynchronous driver operations that has been recorded
+ * once, and may be replayed with a single call. The addresses and the
+ * kernel parameters of the operations may be changed between replays.
+ * <br />
+ * Operations are recorded by the driver API bindings while the calling
+ * thread is capturing into a graph: Instead of being executed, they
+ * are added to the graph.
+ */
+class OperationGraph
+{
+    public:
+        OperationGraph();
+
+        /**
+         * Destroys this graph. The graph must not be captured into by
+         * any thread (see isCapturing).
+         */
+        ~OperationGraph();
+
+        /**
+         * Returns the graph that the calling thread is currently
+         * capturing into, or NULL
+         */
+        static OperationGraph* getCapturing();
+
+        /**
+         * Starts capturing into this graph on the calling thread.
+         * Returns CUDA_ERROR_INVALID_VALUE if the calling thread
+         * is already capturing.
+         */
+        CUresult beginCapture();
+
+        /**
+         * Stops capturing into this graph on the calling thread.
+         * Returns CUDA_ERROR_INVALID_VALUE if the calling thread
+         * is not capturing into this graph.
+         */
+        CUresult endCapture();
+
+        /**
+         * Returns whether any thread is currently capturing into
+         * this graph
+         */
+        bool isCapturing();
+
+        /**
+         * Adds a kernel launch. The parameter values are copied. The
+         * parameters for which paramDevicePointers is nonzero are device
+         * pointers, which may be changed with rebindAddress.
+         */
+        void addLaunch(CUfunction function,
+            unsigned int gridDimX, unsigned int gridDimY, unsigned int gridDimZ,
+            unsigned int blockDimX, unsigned int blockDimY, unsigned int blockDimZ,
+            unsigned int sharedMemBytes, CUstream stream,
+            int paramCount, void **paramValues, size_t *paramSizes, const char *paramDevicePointers);
+
+        /**
+         * Adds a copy of the given OPERATION_MEMCPY* type. Host addresses
+         * are given as CUdeviceptr values.
+         */
+        void addMemcpy(int type, CUdeviceptr dst, CUdeviceptr src, size_t byteCount, CUstream stream);
+
+        /**
+         * Adds a memset of the given OPERATION_MEMSET* type, for the
+         * given number of elements
+         */
+        void addMemset(int type, CUdeviceptr dst, unsigned int value, size_t count, CUstream stream);
+
+        /**
+         * Adds recording the given event in the given stream
+         */
+        void addEventRecord(CUevent event, CUstream stream);
+
+        /**
+         * Adds letting the given stream wait for the given event
+         */
+        void addStreamWaitEvent(CUstream stream, CUevent event, unsigned int flags);
+
+        /**
+         * Returns the number of operations in this graph
+         */
+        int getOperationCount();
+
+        /**
+         * Issues all operations of this graph, in the order in which
+         * they have been recorded. Returns the error of the first
+         * operation that failed, if any.
+         */
+        CUresult launch();
+
+        /**
+         * Obtains the size of the given parameter of the given launch
+         * operation. Returns CUDA_ERROR_INVALID_VALUE if the operation
+         * is not a launch, or the indices are not valid.
+         */
+        CUresult getKernelParamSize(int operation, int param, size_t *size);
+
+        /**
+         * Sets the value of the given parameter of the given launch
+         * operation, copying as many bytes as the parameter had when
+         * it was recorded. Returns CUDA_ERROR_INVALID_VALUE if the
+         * operation is not a launch, or the indices are not valid.
+         */
+        CUresult setKernelParam(int operation, int param, const void *value);
+
+        /**
+         * Replaces all device addresses in the range [oldAddress,
+         * oldAddress+size) by the corresponding addresses in the range
+         * that starts at the new address. This affects the device
+         * addresses of copies and memsets, and the kernel parameters
+         * that have been marked as device pointers. Host addresses are
+         * not changed. Returns the number of addresses that have been
+         * replaced.
+         */
+        int rebindAddress(CUdeviceptr oldAddress, size_t size, CUdeviceptr newAddress);
+
+    private:
+
+        /** A single recorded operation */
+        struct Operation
+        {
+            int type;
+            CUstream stream;
+            CUevent event;
+            unsigned int flags;
+
+            CUfunction function;
+            unsigned int gridDim[3];
+            unsigned int blockDim[3];
+            unsigned int sharedMemBytes;
+            std::vector<char> paramData;
+            std::vector<size_t> paramOffsets;
+            std::vector<size_t> paramSizes;
+            std::vector<void*> paramPointers;
+            std::vector<char> paramDevicePointers;
+
+            CUdeviceptr dst;
+            CUdeviceptr src;
+            size_t size;
+            unsigned int value;
+        };
+
+        /** Guards the operations */
+        Mutex mutex;
+
+        std::vector<Operation*> operations;
+
+        /** The number of threads that are capturing into this graph */
+        int capturingThreads;
+
+        Operation* createOperation(int type, CUstream stream);
+        CUresult execute(Operation *operation);
+        static bool rebind(CUdeviceptr &address, CUdeviceptr oldAddress, size_t size, CUdeviceptr newAddress);
+
+        static JCUDA_THREAD_LOCAL OperationGraph *capturing;
+
+        OperationGraph(const OperationGraph&);
+        OperationGraph& operator=(const OperationGraph&);
+};
+
+
+#endif
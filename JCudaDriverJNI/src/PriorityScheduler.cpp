@@ -0,0 +1,221 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PriorityScheduler.hpp"
+
+PriorityScheduler::PriorityScheduler(unsigned int contextFlags, int criticalStreams, int batchStreams,
+    int maxBatchInFlight, ThreadFunction workerExit, ContextDestroyFunction contextDestroy)
+    : DeviceScheduler(contextFlags, workerExit, contextDestroy)
+{
+    this->streamCounts[LATENCY_CLASS_CRITICAL] = criticalStreams;
+    this->streamCounts[LATENCY_CLASS_BATCH] = batchStreams;
+    this->maxBatchInFlight = maxBatchInFlight;
+    for (int i=0; i<LATENCY_CLASS_COUNT; i++)
+    {
+        statistics[i].launched = 0;
+        statistics[i].totalQueueDelay = 0;
+        statistics[i].maxQueueDelay = 0;
+    }
+}
+
+PriorityScheduler::~PriorityScheduler()
+{
+    shutdown();
+}
+
+SchedulerDevice* PriorityScheduler::createDevice()
+{
+    return new Device();
+}
+
+/**
+ * Creates the streams of both latency classes for the given device,
+ * whose context must be current. On devices that do not support
+ * stream priorities, the priority range is empty, so all streams have
+ * the same priority, and the latency classes are only separated by
+ * launching latency-critical tasks first and limiting the batch
+ * tasks that are in flight.
+ */
+CUresult PriorityScheduler::createStreams(SchedulerDevice *device)
+{
+    Device *d = (Device*)device;
+    int leastPriority = 0;
+    int greatestPriority = 0;
+    CUresult result = cuCtxGetStreamPriorityRange(&leastPriority, &greatestPriority);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    for (int c=0; c<LATENCY_CLASS_COUNT; c++)
+    {
+        StreamPool &pool = d->pools[c];
+        for (int s=0; s<streamCounts[c]; s++)
+        {
+            CUstream stream;
+            int priority = (c == LATENCY_CLASS_CRITICAL) ? greatestPriority : leastPriority;
+            result = cuStreamCreateWithPriority(&stream, CU_STREAM_NON_BLOCKING, priority);
+            if (result != CUDA_SUCCESS)
+            {
+                return result;
+            }
+            pool.streams.push_back(stream);
+            pool.running.push_back(NULL);
+        }
+    }
+    return result;
+}
+
+CUresult PriorityScheduler::submit(TaskFunction function, TaskCleanupFunction cleanup,
+    void *userData, int device, int latencyClass, SchedulerTask **task)
+{
+    if (!started)
+    {
+        return CUDA_ERROR_NOT_INITIALIZED;
+    }
+    if (function == NULL || device < -1 || device >= (int)devices.size() ||
+        latencyClass < 0 || latencyClass >= LATENCY_CLASS_COUNT)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    SchedulerTask *schedulerTask =
+        createTask(function, cleanup, userData, task == NULL ? 1 : 2);
+    Device *target = (Device*)assign(device);
+    {
+        MutexLock lock(mutex);
+        pendingTasks++;
+    }
+    {
+        MutexLock lock(target->queueMutex);
+        QueuedTask queuedTask;
+        queuedTask.task = schedulerTask;
+        queuedTask.submitTime = getNanoTime();
+        target->pools[latencyClass].queue.push_back(queuedTask);
+    }
+    {
+        MutexLock lock(mutex);
+        workAvailable.broadcast();
+    }
+    if (task != NULL)
+    {
+        *task = schedulerTask;
+    }
+    return CUDA_SUCCESS;
+}
+
+CUresult PriorityScheduler::getStatistics(int latencyClass, jcuda_int64 *launched,
+    jcuda_int64 *totalQueueDelay, jcuda_int64 *maxQueueDelay)
+{
+    if (latencyClass < 0 || latencyClass >= LATENCY_CLASS_COUNT)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    Statistics &s = statistics[latencyClass];
+    *launched = atomicLoad(&s.launched);
+    *totalQueueDelay = atomicLoad(&s.totalQueueDelay);
+    *maxQueueDelay = atomicLoad(&s.maxQueueDelay);
+    return CUDA_SUCCESS;
+}
+
+/**
+ * Completes the tasks whose events have been reached, launches
+ * latency-critical tasks in all free streams of their pool, and then
+ * launches batch tasks as long as their limit is not reached
+ */
+bool PriorityScheduler::schedule(SchedulerDevice *device, int *runningCount)
+{
+    Device *d = (Device*)device;
+    *runningCount =
+        poll(d, d->pools[LATENCY_CLASS_CRITICAL].running) +
+        poll(d, d->pools[LATENCY_CLASS_BATCH].running);
+    bool launched = fill(d, LATENCY_CLASS_CRITICAL, streamCounts[LATENCY_CLASS_CRITICAL]);
+    launched |= fill(d, LATENCY_CLASS_BATCH, maxBatchInFlight);
+    return launched;
+}
+
+bool PriorityScheduler::hasQueuedTasks(SchedulerDevice *device)
+{
+    Device *d = (Device*)device;
+    MutexLock lock(d->queueMutex);
+    for (int c=0; c<LATENCY_CLASS_COUNT; c++)
+    {
+        if (!d->pools[c].queue.empty())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Launches queued tasks of the given latency class in the free streams
+ * of its pool, until the given number of tasks of this class is running
+ * on the device. Returns whether any task was launched.
+ */
+bool PriorityScheduler::fill(Device *device, int latencyClass, int limit)
+{
+    StreamPool &pool = device->pools[latencyClass];
+    int runningCount = 0;
+    for (size_t slot=0; slot<pool.running.size(); slot++)
+    {
+        if (pool.running[slot] != NULL)
+        {
+            runningCount++;
+        }
+    }
+    bool launched = false;
+    for (size_t slot=0; slot<pool.running.size() && runningCount < limit; slot++)
+    {
+        if (pool.running[slot] != NULL)
+        {
+            continue;
+        }
+        QueuedTask queuedTask;
+        {
+            MutexLock lock(device->queueMutex);
+            if (pool.queue.empty())
+            {
+                break;
+            }
+            queuedTask = pool.queue.front();
+            pool.queue.pop_front();
+        }
+
+        jcuda_int64 delay = getNanoTime() - queuedTask.submitTime;
+        Statistics &s = statistics[latencyClass];
+        atomicAdd(&s.launched, 1);
+        atomicAdd(&s.totalQueueDelay, delay);
+        atomicMax(&s.maxQueueDelay, delay);
+
+        if (launch(device, pool.streams[slot], queuedTask.task))
+        {
+            pool.running[slot] = queuedTask.task;
+            runningCount++;
+        }
+        launched = true;
+    }
+    return launched;
+}
@@ -0,0 +1,159 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PRIORITYSCHEDULER
+#define PRIORITYSCHEDULER
+
+#include <cuda.h>
+#include <deque>
+#include <vector>
+#include "Threading.hpp"
+#include "DeviceScheduler.hpp"
+
+/**
+ * The latency classes of tasks in a PriorityScheduler
+ */
+#define LATENCY_CLASS_CRITICAL 0
+#define LATENCY_CLASS_BATCH    1
+#define LATENCY_CLASS_COUNT    2
+
+
+/**
+ * A scheduler that separates latency-critical work from batch work.
+ * For each device, the scheduler creates a context, a pool of streams
+ * with the greatest priority for latency-critical tasks, a pool of
+ * streams with the least priority for batch tasks, and a worker thread
+ * that launches one task per stream at a time.<br />
+ * <br />
+ * Latency-critical tasks are always launched first. The number of batch
+ * tasks that are in flight on one device is limited, so that the work
+ * queues of the device are never filled with so much batch work that
+ * a latency-critical task has to wait for it, even though its stream
+ * has a higher priority.<br />
+ * <br />
+ * For each latency class, the scheduler records the time that tasks
+ * spent in the queue before they have been launched.<br />
+ * <br />
+ * Tasks are SchedulerTask objects, like those of a TaskScheduler.
+ * The task function must leave the context of the device current
+ * when it returns.
+ */
+class PriorityScheduler : public DeviceScheduler
+{
+    public:
+
+        /**
+         * Creates a new scheduler that creates contexts with the given
+         * flags, the given number of streams for each latency class per
+         * device, and allows the given number of batch tasks to be in
+         * flight on each device. The given exit function, if not NULL,
+         * is called by each worker thread before it terminates. The
+         * given destroy function, if not NULL, is used for destroying
+         * the contexts. The scheduler has to be initialized with init()
+         * before it can be used.
+         */
+        PriorityScheduler(unsigned int contextFlags, int criticalStreams, int batchStreams,
+            int maxBatchInFlight, ThreadFunction workerExit, ContextDestroyFunction contextDestroy);
+
+        /**
+         * Destroys this scheduler, after waiting for all tasks. The
+         * contexts of the scheduler are destroyed. This must not be
+         * called from a worker thread, see isWorkerThread().
+         */
+        ~PriorityScheduler();
+
+        /**
+         * Submits a task with the given LATENCY_CLASS. If the given device
+         * is -1, the task is assigned to the device with the fewest queued
+         * and running tasks. If the given task pointer is not NULL, it will
+         * receive a reference to the task, which has to be released.
+         */
+        CUresult submit(TaskFunction function, TaskCleanupFunction cleanup,
+            void *userData, int device, int latencyClass, SchedulerTask **task);
+
+        /**
+         * Obtains the number of tasks of the given latency class that
+         * have been launched, and the total and maximum time, in
+         * nanoseconds, that they spent in the queue
+         */
+        CUresult getStatistics(int latencyClass, jcuda_int64 *launched,
+            jcuda_int64 *totalQueueDelay, jcuda_int64 *maxQueueDelay);
+
+    protected:
+        SchedulerDevice* createDevice();
+        CUresult createStreams(SchedulerDevice *device);
+        bool schedule(SchedulerDevice *device, int *runningCount);
+        bool hasQueuedTasks(SchedulerDevice *device);
+
+    private:
+
+        /** A task in a queue, with the time when it was submitted */
+        struct QueuedTask
+        {
+            SchedulerTask *task;
+            jcuda_int64 submitTime;
+        };
+
+        /** The streams of one latency class of a device */
+        struct StreamPool
+        {
+            std::vector<CUstream> streams;
+
+            /** The task that is executed in each stream, or NULL */
+            std::vector<SchedulerTask*> running;
+
+            /** The tasks of this latency class, guarded by the queueMutex */
+            std::deque<QueuedTask> queue;
+        };
+
+        /** The state of one device */
+        struct Device : public SchedulerDevice
+        {
+            StreamPool pools[LATENCY_CLASS_COUNT];
+        };
+
+        /** The statistics of one latency class */
+        struct Statistics
+        {
+            volatile jcuda_int64 launched;
+            volatile jcuda_int64 totalQueueDelay;
+            volatile jcuda_int64 maxQueueDelay;
+        };
+
+        unsigned int contextFlags;
+        int streamCounts[LATENCY_CLASS_COUNT];
+        int maxBatchInFlight;
+        Statistics statistics[LATENCY_CLASS_COUNT];
+
+        bool fill(Device *device, int latencyClass, int limit);
+
+        PriorityScheduler(const PriorityScheduler&);
+        PriorityScheduler& operator=(const PriorityScheduler&);
+};
+
+
+#endif
@@ -0,0 +1,478 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "RangeProfiler.hpp"
+#include "ContextTracker.hpp"
+#include "ResourcePools.hpp"
+#include "Logger.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <string.h>
+
+/** The capacity of the event pool of each context */
+#define RANGE_EVENT_POOL_CAPACITY 256
+
+/**
+ * A range that has been pushed. After it has been popped, it is
+ * pending until the background thread resolved its time.
+ */
+struct RangeRecord
+{
+    std::string path;
+    CUcontext context;
+    CUstream stream;
+    CUevent start;
+    CUevent end;
+};
+
+/**
+ * The thread local stack of open ranges. An entry is NULL if the
+ * range was pushed while the profiler was disabled.
+ */
+struct RangeStack
+{
+    int depth;
+    int overflow;
+    RangeRecord *records[RANGE_MAX_DEPTH];
+};
+
+static JCUDA_THREAD_LOCAL RangeStack stack;
+
+/**
+ * The event pool of the context that the calling thread pushed its last
+ * range in, so that the mutex does not have to be locked for each push.
+ * The pool is only valid while the pool generation did not change.
+ */
+struct PoolCache
+{
+    CUcontext context;
+    EventPool *pool;
+    int generation;
+};
+
+static JCUDA_THREAD_LOCAL PoolCache poolCache;
+
+/** Incremented whenever a pool is deleted */
+static volatile int poolGeneration = 1;
+
+static volatile int enabledFlag = 0;
+
+/** The state that is shared with the background thread */
+static Mutex mutex;
+static ConditionVariable condition;
+static Thread resolver;
+static long pollInterval = 0;
+static bool stopping = false;
+static bool resolving = false;
+
+static std::map<CUcontext, EventPool*> pools;
+static std::vector<RangeRecord*> pending;
+static std::map<std::string, RangeStatistics> statistics;
+
+
+/**
+ * Returns the event pool for the given context, creating it if
+ * necessary. The mutex must be locked.
+ */
+static EventPool* getPool(CUcontext context)
+{
+    std::map<CUcontext, EventPool*>::iterator it = pools.find(context);
+    if (it != pools.end())
+    {
+        return it->second;
+    }
+    EventPool *pool = new EventPool(0, RANGE_EVENT_POOL_CAPACITY);
+    pools[context] = pool;
+    return pool;
+}
+
+/**
+ * Returns the event pool for the given context, or NULL if there
+ * is none. The mutex must be locked.
+ */
+static EventPool* findPool(CUcontext context)
+{
+    std::map<CUcontext, EventPool*>::iterator it = pools.find(context);
+    if (it == pools.end())
+    {
+        return NULL;
+    }
+    return it->second;
+}
+
+/**
+ * Returns the event pool for the given context, using the pool cache
+ * of the calling thread if it is still valid. The mutex must not be
+ * locked.
+ */
+static EventPool* getThreadPool(CUcontext context)
+{
+    int generation = atomicLoad(&poolGeneration);
+    if (poolCache.pool != NULL && poolCache.context == context && poolCache.generation == generation)
+    {
+        return poolCache.pool;
+    }
+    MutexLock lock(mutex);
+    poolCache.context = context;
+    poolCache.pool = getPool(context);
+    poolCache.generation = generation;
+    return poolCache.pool;
+}
+
+/**
+ * Returns the events of the given record to the pool of its context,
+ * if it still exists, and deletes the record. The mutex must be locked.
+ */
+static void deleteRecord(RangeRecord *record)
+{
+    EventPool *pool = findPool(record->context);
+    if (pool != NULL)
+    {
+        if (record->start != NULL)
+        {
+            pool->release(record->start);
+        }
+        if (record->end != NULL)
+        {
+            pool->release(record->end);
+        }
+    }
+    delete record;
+}
+
+/**
+ * Adds the given time to the statistics of the given path. The
+ * mutex must be locked.
+ */
+static void aggregate(const std::string &path, float milliseconds)
+{
+    std::map<std::string, RangeStatistics>::iterator it = statistics.find(path);
+    if (it == statistics.end())
+    {
+        RangeStatistics empty;
+        memset(&empty, 0, sizeof(RangeStatistics));
+        empty.minTime = milliseconds;
+        empty.maxTime = milliseconds;
+        it = statistics.insert(std::make_pair(path, empty)).first;
+    }
+    RangeStatistics &s = it->second;
+    s.count++;
+    s.totalTime += milliseconds;
+    if (milliseconds < s.minTime)
+    {
+        s.minTime = milliseconds;
+    }
+    if (milliseconds > s.maxTime)
+    {
+        s.maxTime = milliseconds;
+    }
+    jcuda_int64 micros = (jcuda_int64)(milliseconds * 1000.0f);
+    int bin = 0;
+    while (micros >= 2 && bin < RANGE_HISTOGRAM_BINS - 1)
+    {
+        micros >>= 1;
+        bin++;
+    }
+    s.histogram[bin]++;
+}
+
+/**
+ * Tries to resolve the time of the given record. Returns false if
+ * the end event has not been reached yet.
+ */
+static bool resolve(RangeRecord *record, float *milliseconds, CUresult *result)
+{
+    ContextScope scope(record->context);
+    *result = scope.getResult();
+    if (*result != CUDA_SUCCESS)
+    {
+        return true;
+    }
+    *result = cuEventQuery(record->end);
+    if (*result == CUDA_ERROR_NOT_READY)
+    {
+        return false;
+    }
+    if (*result == CUDA_SUCCESS)
+    {
+        *result = cuEventElapsedTime(milliseconds, record->start, record->end);
+    }
+    return true;
+}
+
+/**
+ * The main loop of the background thread: Resolves the pending
+ * records whose end events have been reached, and waits for the
+ * poll interval.
+ */
+void RangeProfiler::runResolver(void * /*argument*/)
+{
+    MutexLock lock(mutex);
+    while (true)
+    {
+        bool stop = stopping;
+        std::vector<RangeRecord*> records;
+        records.swap(pending);
+        resolving = true;
+        mutex.unlock();
+
+        std::vector<RangeRecord*> unresolved;
+        std::vector<RangeRecord*> resolved;
+        std::vector<float> times;
+        for (size_t i=0; i<records.size(); i++)
+        {
+            RangeRecord *record = records[i];
+            float milliseconds = 0;
+            CUresult result = CUDA_SUCCESS;
+            if (!resolve(record, &milliseconds, &result))
+            {
+                unresolved.push_back(record);
+                continue;
+            }
+            if (result != CUDA_SUCCESS)
+            {
+                Logger::log(LOG_DEBUG, "Could not resolve range %s: %d\n", record->path.c_str(), (int)result);
+                milliseconds = -1;
+            }
+            resolved.push_back(record);
+            times.push_back(milliseconds);
+        }
+
+        mutex.lock();
+        resolving = false;
+        for (size_t i=0; i<resolved.size(); i++)
+        {
+            if (times[i] >= 0)
+            {
+                aggregate(resolved[i]->path, times[i]);
+            }
+            deleteRecord(resolved[i]);
+        }
+        if (stop)
+        {
+            // Records that are still pending are dropped. Their events
+            // may be released, because recording an event again
+            // replaces the previous record.
+            for (size_t i=0; i<unresolved.size(); i++)
+            {
+                deleteRecord(unresolved[i]);
+            }
+            condition.broadcast();
+            break;
+        }
+        pending.insert(pending.end(), unresolved.begin(), unresolved.end());
+        condition.broadcast();
+        condition.wait(mutex, pollInterval / 1000 + 1);
+    }
+}
+
+CUresult RangeProfiler::enable(int pollIntervalMicros)
+{
+    MutexLock lock(mutex);
+    if (resolver.isRunning())
+    {
+        return CUDA_SUCCESS;
+    }
+    pollInterval = pollIntervalMicros;
+    stopping = false;
+    if (!resolver.start(&RangeProfiler::runResolver, NULL))
+    {
+        return CUDA_ERROR_UNKNOWN;
+    }
+    atomicCompareAndSwap(&enabledFlag, 0, 1);
+    return CUDA_SUCCESS;
+}
+
+void RangeProfiler::disable()
+{
+    {
+        MutexLock lock(mutex);
+        if (!resolver.isRunning())
+        {
+            return;
+        }
+        atomicCompareAndSwap(&enabledFlag, 1, 0);
+        stopping = true;
+        condition.broadcast();
+    }
+    resolver.join();
+}
+
+CUresult RangeProfiler::push(const char *name, CUstream stream)
+{
+    if (stack.overflow > 0 || stack.depth == RANGE_MAX_DEPTH)
+    {
+        // Ranges beyond the maximum depth are not recorded
+        stack.overflow++;
+        return CUDA_SUCCESS;
+    }
+    RangeRecord *record = NULL;
+    if (atomicLoad(&enabledFlag) != 0)
+    {
+        CUcontext context = NULL;
+        CUresult result = cuCtxGetCurrent(&context);
+        if (result != CUDA_SUCCESS)
+        {
+            return result;
+        }
+        record = new RangeRecord();
+        record->path = name;
+        if (stack.depth > 0 && stack.records[stack.depth - 1] != NULL)
+        {
+            record->path = stack.records[stack.depth - 1]->path + "/" + name;
+        }
+        record->context = context;
+        record->stream = stream;
+        record->start = NULL;
+        record->end = NULL;
+
+        // The events are acquired and recorded without locking the
+        // mutex. The pool itself is lock-free.
+        EventPool *pool = getThreadPool(context);
+        result = pool->acquire(&record->start);
+        if (result == CUDA_SUCCESS)
+        {
+            result = pool->acquire(&record->end);
+        }
+        if (result == CUDA_SUCCESS)
+        {
+            result = cuEventRecord(record->start, stream);
+        }
+        if (result != CUDA_SUCCESS)
+        {
+            MutexLock lock(mutex);
+            deleteRecord(record);
+            return result;
+        }
+    }
+    stack.records[stack.depth] = record;
+    stack.depth++;
+    return CUDA_SUCCESS;
+}
+
+CUresult RangeProfiler::pop()
+{
+    if (stack.overflow > 0)
+    {
+        stack.overflow--;
+        return CUDA_SUCCESS;
+    }
+    if (stack.depth == 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    stack.depth--;
+    RangeRecord *record = stack.records[stack.depth];
+    if (record == NULL)
+    {
+        return CUDA_SUCCESS;
+    }
+
+    // The event is recorded without locking the mutex, which is only
+    // locked for handing the record to the background thread
+    CUresult result = cuEventRecord(record->end, record->stream);
+    MutexLock lock(mutex);
+    if (findPool(record->context) == NULL)
+    {
+        // The context was destroyed while the range was open
+        delete record;
+        return CUDA_ERROR_INVALID_CONTEXT;
+    }
+    if (result != CUDA_SUCCESS || !resolver.isRunning())
+    {
+        deleteRecord(record);
+        return result;
+    }
+    pending.push_back(record);
+    return CUDA_SUCCESS;
+}
+
+int RangeProfiler::getRangeCount()
+{
+    MutexLock lock(mutex);
+    return (int)statistics.size();
+}
+
+bool RangeProfiler::getStatistics(int index, char *path, size_t pathSize, RangeStatistics *rangeStatistics)
+{
+    MutexLock lock(mutex);
+    if (index < 0 || index >= (int)statistics.size() || pathSize == 0)
+    {
+        return false;
+    }
+    std::map<std::string, RangeStatistics>::iterator it = statistics.begin();
+    for (int i=0; i<index; i++)
+    {
+        ++it;
+    }
+    size_t length = it->first.length();
+    if (length >= pathSize)
+    {
+        length = pathSize - 1;
+    }
+    memcpy(path, it->first.c_str(), length);
+    path[length] = 0;
+    *rangeStatistics = it->second;
+    return true;
+}
+
+void RangeProfiler::reset()
+{
+    MutexLock lock(mutex);
+    statistics.clear();
+}
+
+void RangeProfiler::contextDestroyed(CUcontext context)
+{
+    MutexLock lock(mutex);
+    while (resolving)
+    {
+        condition.wait(mutex);
+    }
+    std::vector<RangeRecord*>::iterator it = pending.begin();
+    while (it != pending.end())
+    {
+        if ((*it)->context == context)
+        {
+            deleteRecord(*it);
+            it = pending.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    std::map<CUcontext, EventPool*>::iterator poolIt = pools.find(context);
+    if (poolIt != pools.end())
+    {
+        delete poolIt->second;
+        pools.erase(poolIt);
+        atomicAdd(&poolGeneration, 1);
+    }
+}
@@ -0,0 +1,139 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RANGEPROFILER
+#define RANGEPROFILER
+
+#include <cuda.h>
+#include "Threading.hpp"
+
+/** The maximum nesting depth of ranges on one thread */
+#define RANGE_MAX_DEPTH 64
+
+/**
+ * The number of bins of the histogram of a range. Bin i counts the
+ * times in [2^i, 2^(i+1)) microseconds, except for the first bin,
+ * which also counts shorter times, and the last bin, which also
+ * counts longer times.
+ */
+#define RANGE_HISTOGRAM_BINS 24
+
+
+/**
+ * The aggregated GPU times of one range
+ */
+struct RangeStatistics
+{
+    /** The number of times that have been resolved */
+    jcuda_int64 count;
+
+    /** The total, minimum and maximum time, in milliseconds */
+    double totalTime;
+    float minTime;
+    float maxTime;
+
+    jcuda_int64 histogram[RANGE_HISTOGRAM_BINS];
+};
+
+
+/**
+ * A profiler for named, nestable ranges of GPU work. When a range is
+ * pushed, an event from a pool is recorded in the given stream, and
+ * when it is popped, a second event is recorded in the same stream.
+ * The events are handed to a background thread, which polls them with
+ * cuEventQuery, and aggregates the elapsed times in a histogram for
+ * each range. Nothing is synchronized, so the profiler may be enabled
+ * permanently. The ranges are kept in a stack for each thread, and the
+ * events are acquired and recorded without locking the profiler, which
+ * is only locked briefly when a popped range is handed to the
+ * background thread.<br />
+ * <br />
+ * Ranges are identified by their path: The names of the enclosing
+ * ranges of the same thread and the name of the range, separated
+ * by '/'.<br />
+ * <br />
+ * The profiler is disabled by default. Pushing and popping ranges
+ * is a no-op while it is disabled.
+ */
+class RangeProfiler
+{
+    public:
+
+        /**
+         * Enables the profiler, starting the background thread, which
+         * polls the pending events in the given interval
+         */
+        static CUresult enable(int pollIntervalMicros);
+
+        /**
+         * Disables the profiler. The background thread resolves the
+         * times of the events that are already complete, and stops.
+         */
+        static void disable();
+
+        /**
+         * Records the start of a range with the given name in the
+         * given stream, in the current context
+         */
+        static CUresult push(const char *name, CUstream stream);
+
+        /**
+         * Records the end of the innermost range of the calling thread
+         */
+        static CUresult pop();
+
+        /**
+         * Returns the number of ranges that have statistics
+         */
+        static int getRangeCount();
+
+        /**
+         * Obtains the path and the statistics of the range with the
+         * given index, in the order of the paths. The path is copied
+         * into the given buffer. Returns false if the index is invalid.
+         */
+        static bool getStatistics(int index, char *path, size_t pathSize, RangeStatistics *statistics);
+
+        /**
+         * Removes all statistics
+         */
+        static void reset();
+
+        /**
+         * Releases the events of the given context, which is about
+         * to be destroyed
+         */
+        static void contextDestroyed(CUcontext context);
+
+    private:
+        RangeProfiler();
+
+        static void runResolver(void *argument);
+};
+
+
+#endif
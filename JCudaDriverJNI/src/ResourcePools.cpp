@@ -0,0 +1,176 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ResourcePools.hpp"
+
+
+//=== EventPool ==============================================================
+
+EventPool::EventPool(unsigned int flags, int capacity) : idle(capacity)
+{
+    this->flags = flags;
+}
+
+EventPool::~EventPool()
+{
+    void *event = NULL;
+    while ((event = idle.pop()) != NULL)
+    {
+        cuEventDestroy((CUevent)event);
+    }
+}
+
+unsigned int EventPool::getFlags()
+{
+    return flags;
+}
+
+CUresult EventPool::acquire(CUevent *event)
+{
+    void *pooled = idle.pop();
+    if (pooled != NULL)
+    {
+        *event = (CUevent)pooled;
+        return CUDA_SUCCESS;
+    }
+    return cuEventCreate(event, flags);
+}
+
+CUresult EventPool::release(CUevent event)
+{
+    if (event == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+    if (idle.push(event))
+    {
+        return CUDA_SUCCESS;
+    }
+    return cuEventDestroy(event);
+}
+
+
+//=== StreamPool =============================================================
+
+StreamPool::StreamPool(int leastPriority, int greatestPriority, int capacity)
+{
+    this->leastPriority = leastPriority;
+    this->greatestPriority = greatestPriority;
+
+    // Greater priorities are smaller numbers. There is one stack for
+    // each priority, for CU_STREAM_DEFAULT and CU_STREAM_NON_BLOCKING.
+    int levels = leastPriority - greatestPriority + 1;
+    for (int i=0; i<2 * levels; i++)
+    {
+        idle.push_back(new LockFreeStack(capacity));
+    }
+}
+
+StreamPool::~StreamPool()
+{
+    for (size_t i=0; i<idle.size(); i++)
+    {
+        void *stream = NULL;
+        while ((stream = idle[i]->pop()) != NULL)
+        {
+            cuStreamDestroy((CUstream)stream);
+        }
+        delete idle[i];
+    }
+}
+
+/**
+ * Returns the index of the stack for streams with the given flags and
+ * priority, after clamping the priority, or -1 if the flags are invalid
+ */
+int StreamPool::getIndex(unsigned int flags, int priority)
+{
+    if (flags != CU_STREAM_DEFAULT && flags != CU_STREAM_NON_BLOCKING)
+    {
+        return -1;
+    }
+    if (priority > leastPriority)
+    {
+        priority = leastPriority;
+    }
+    if (priority < greatestPriority)
+    {
+        priority = greatestPriority;
+    }
+    int levels = leastPriority - greatestPriority + 1;
+    int flagsIndex = (flags == CU_STREAM_NON_BLOCKING) ? 1 : 0;
+    return flagsIndex * levels + (leastPriority - priority);
+}
+
+CUresult StreamPool::acquire(CUstream *stream, unsigned int flags, int priority)
+{
+    int index = getIndex(flags, priority);
+    if (index < 0)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    void *pooled = idle[index]->pop();
+    if (pooled != NULL)
+    {
+        *stream = (CUstream)pooled;
+        return CUDA_SUCCESS;
+    }
+    if (priority == 0)
+    {
+        return cuStreamCreate(stream, flags);
+    }
+    return cuStreamCreateWithPriority(stream, flags, priority);
+}
+
+CUresult StreamPool::release(CUstream stream)
+{
+    if (stream == NULL)
+    {
+        return CUDA_ERROR_INVALID_HANDLE;
+    }
+
+    // The stream is pushed to the stack for the flags and priority
+    // that it actually has
+    unsigned int flags = 0;
+    CUresult result = cuStreamGetFlags(stream, &flags);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    int priority = 0;
+    result = cuStreamGetPriority(stream, &priority);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    int index = getIndex(flags, priority);
+    if (index >= 0 && idle[index]->push(stream))
+    {
+        return CUDA_SUCCESS;
+    }
+    return cuStreamDestroy(stream);
+}
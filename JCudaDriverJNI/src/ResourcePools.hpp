@@ -0,0 +1,115 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RESOURCEPOOLS
+#define RESOURCEPOOLS
+
+#include <cuda.h>
+#include <vector>
+#include "LockFreeStack.hpp"
+
+/**
+ * A pool of events that have been created with the same flags.<br />
+ * <br />
+ * Acquiring an event pops an idle event from a lock-free stack, and
+ * only creates a new event if the pool is empty. Releasing an event
+ * pushes it back, and only destroys it if the pool is full. Events
+ * may be released while they are still pending: Recording them again
+ * after they have been acquired replaces the previous record.<br />
+ * <br />
+ * The events belong to the context that was current when they were
+ * created, so a pool should only be used with one context.
+ */
+class EventPool
+{
+    public:
+        EventPool(unsigned int flags, int capacity);
+
+        /**
+         * Destroys this pool and all idle events
+         */
+        ~EventPool();
+
+        CUresult acquire(CUevent *event);
+        CUresult release(CUevent event);
+
+        unsigned int getFlags();
+
+    private:
+        unsigned int flags;
+        LockFreeStack idle;
+
+        EventPool(const EventPool&);
+        EventPool& operator=(const EventPool&);
+};
+
+
+/**
+ * A pool of streams. It works like the EventPool, but keeps a separate
+ * lock-free stack of idle streams for each combination of flags and
+ * priority. The priorities are clamped to the range of the device, as
+ * by cuStreamCreateWithPriority, so that there is one stack for each
+ * priority that the streams can actually have. Released streams are
+ * pushed to the stack for their flags and priority. Streams may be
+ * released while they still have pending work, but this work will then
+ * precede the work of the next user of the stream.
+ */
+class StreamPool
+{
+    public:
+
+        /**
+         * Creates a pool that keeps up to the given number of idle
+         * streams for each combination of flags and priority. The
+         * priorities are the ones between the given least and greatest
+         * priority, as reported by cuCtxGetStreamPriorityRange.
+         */
+        StreamPool(int leastPriority, int greatestPriority, int capacity);
+
+        /**
+         * Destroys this pool and all idle streams
+         */
+        ~StreamPool();
+
+        CUresult acquire(CUstream *stream, unsigned int flags, int priority);
+        CUresult release(CUstream stream);
+
+    private:
+        int leastPriority;
+        int greatestPriority;
+
+        /** The stacks of idle streams, by flags and priority */
+        std::vector<LockFreeStack*> idle;
+
+        int getIndex(unsigned int flags, int priority);
+
+        StreamPool(const StreamPool&);
+        StreamPool& operator=(const StreamPool&);
+};
+
+
+#endif
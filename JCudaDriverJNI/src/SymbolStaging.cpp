@@ -0,0 +1,474 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "SymbolStaging.hpp"
+#include "Logger.hpp"
+
+#include <cstring>
+
+/**
+ * The maximum number of page-locked buffers of one context
+ */
+#define SYMBOL_STAGING_MAX_BUFFERS 4
+
+SymbolStaging::SymbolStaging()
+{
+    pendingContexts = 0;
+    flushingContexts = 0;
+    updateCount = 0;
+    copyCount = 0;
+    byteCount = 0;
+}
+
+SymbolStaging::~SymbolStaging()
+{
+    std::map<CUcontext, SymbolUpdates*>::iterator it;
+    for (it = updates.begin(); it != updates.end(); ++it)
+    {
+        delete it->second;
+    }
+}
+
+CUresult SymbolStaging::stage(CUmodule module, const char *name, size_t offset, const void *data, size_t bytes)
+{
+    CUcontext context = NULL;
+    CUresult result = cuCtxGetCurrent(&context);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    if (context == NULL)
+    {
+        return CUDA_ERROR_INVALID_CONTEXT;
+    }
+
+    MutexLock lock(mutex);
+    CUdeviceptr address = 0;
+    size_t size = 0;
+    result = lookup(module, name, &address, &size);
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    if (offset > size || bytes > size - offset)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    if (bytes == 0)
+    {
+        return CUDA_SUCCESS;
+    }
+
+    SymbolUpdates *contextUpdates = NULL;
+    std::map<CUcontext, SymbolUpdates*>::iterator it = updates.find(context);
+    if (it != updates.end())
+    {
+        contextUpdates = it->second;
+    }
+    else
+    {
+        contextUpdates = new SymbolUpdates();
+        contextUpdates->event = NULL;
+        contextUpdates->flushing = false;
+        updates[context] = contextUpdates;
+    }
+    if (contextUpdates->ranges.empty())
+    {
+        atomicAdd(&pendingContexts, 1);
+    }
+    merge(contextUpdates, module, address, address + offset, (const char*)data, bytes);
+    updateCount++;
+    return CUDA_SUCCESS;
+}
+
+CUresult SymbolStaging::flush(CUstream stream)
+{
+    if (atomicLoad(&pendingContexts) == 0 && atomicLoad(&flushingContexts) == 0)
+    {
+        return CUDA_SUCCESS;
+    }
+    CUcontext context = NULL;
+    CUresult result = cuCtxGetCurrent(&context);
+    if (result != CUDA_SUCCESS || context == NULL)
+    {
+        return result;
+    }
+
+    MutexLock lock(mutex);
+    std::map<CUcontext, SymbolUpdates*>::iterator it = updates.find(context);
+    if (it == updates.end())
+    {
+        return CUDA_SUCCESS;
+    }
+    SymbolUpdates *contextUpdates = it->second;
+    std::map<CUdeviceptr, SymbolRange> &ranges = contextUpdates->ranges;
+
+    // The copies of the last flush may have been issued in another
+    // stream, and have to be complete before the next launch, and
+    // before the copies of this flush
+    result = order(contextUpdates, stream);
+    if (result != CUDA_SUCCESS || ranges.empty())
+    {
+        return result;
+    }
+
+    size_t total = 0;
+    std::map<CUdeviceptr, SymbolRange>::iterator r;
+    for (r = ranges.begin(); r != ranges.end(); ++r)
+    {
+        total += r->second.data.size();
+    }
+
+    SymbolFlushBuffer *flushBuffer = NULL;
+    if (contextUpdates->event == NULL)
+    {
+        result = cuEventCreate(&contextUpdates->event, CU_EVENT_DISABLE_TIMING);
+    }
+    if (result == CUDA_SUCCESS)
+    {
+        result = acquireBuffer(contextUpdates, total, &flushBuffer);
+    }
+
+    // The ranges are discarded even if the flush fails, so that a
+    // failed update is not repeated before each following launch
+    if (result == CUDA_SUCCESS)
+    {
+        char *current = flushBuffer != NULL ? flushBuffer->buffer : NULL;
+        for (r = ranges.begin(); r != ranges.end() && result == CUDA_SUCCESS; ++r)
+        {
+            size_t bytes = r->second.data.size();
+            const char *source = &r->second.data[0];
+            if (current != NULL)
+            {
+                memcpy(current, source, bytes);
+                source = current;
+                current += bytes;
+            }
+            result = cuMemcpyHtoDAsync(r->first, source, bytes, stream);
+            copyCount++;
+            byteCount += bytes;
+        }
+
+        // The buffer may be read by the copies that have been issued,
+        // even if a later copy failed
+        if (flushBuffer != NULL)
+        {
+            CUresult recordResult = cuEventRecord(flushBuffer->event, stream);
+            if (result == CUDA_SUCCESS)
+            {
+                result = recordResult;
+            }
+        }
+        if (result == CUDA_SUCCESS)
+        {
+            result = cuEventRecord(contextUpdates->event, stream);
+        }
+        if (result == CUDA_SUCCESS)
+        {
+            contextUpdates->orderedStreams.clear();
+            contextUpdates->orderedStreams.insert(stream);
+            if (!contextUpdates->flushing)
+            {
+                contextUpdates->flushing = true;
+                atomicAdd(&flushingContexts, 1);
+            }
+        }
+    }
+    if (result != CUDA_SUCCESS)
+    {
+        Logger::log(LOG_ERROR, "Could not flush %d symbol updates, error %d\n",
+            (int)ranges.size(), result);
+    }
+    ranges.clear();
+    atomicAdd(&pendingContexts, -1);
+    return result;
+}
+
+void SymbolStaging::removeModule(CUmodule module)
+{
+    MutexLock lock(mutex);
+    std::map<std::pair<CUmodule, std::string>, std::pair<CUdeviceptr, size_t> >::iterator it = globals.begin();
+    while (it != globals.end())
+    {
+        if (it->first.first == module)
+        {
+            globals.erase(it++);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    // The pending updates would otherwise be flushed into the memory
+    // of the globals after it was released
+    std::map<CUcontext, SymbolUpdates*>::iterator u;
+    for (u = updates.begin(); u != updates.end(); ++u)
+    {
+        std::map<CUdeviceptr, SymbolRange> &ranges = u->second->ranges;
+        if (ranges.empty())
+        {
+            continue;
+        }
+        std::map<CUdeviceptr, SymbolRange>::iterator r = ranges.begin();
+        while (r != ranges.end())
+        {
+            if (r->second.module == module)
+            {
+                ranges.erase(r++);
+            }
+            else
+            {
+                ++r;
+            }
+        }
+        if (ranges.empty())
+        {
+            atomicAdd(&pendingContexts, -1);
+        }
+    }
+}
+
+void SymbolStaging::removeContext(CUcontext context)
+{
+    MutexLock lock(mutex);
+    std::map<CUcontext, SymbolUpdates*>::iterator it = updates.find(context);
+    if (it == updates.end())
+    {
+        return;
+    }
+    SymbolUpdates *contextUpdates = it->second;
+    if (!contextUpdates->ranges.empty())
+    {
+        atomicAdd(&pendingContexts, -1);
+    }
+    if (contextUpdates->flushing)
+    {
+        atomicAdd(&flushingContexts, -1);
+    }
+    if (contextUpdates->event != NULL)
+    {
+        cuEventSynchronize(contextUpdates->event);
+        cuEventDestroy(contextUpdates->event);
+    }
+    for (size_t i=0; i<contextUpdates->buffers.size(); i++)
+    {
+        cuEventDestroy(contextUpdates->buffers[i].event);
+        cuMemFreeHost(contextUpdates->buffers[i].buffer);
+    }
+    delete contextUpdates;
+    updates.erase(it);
+}
+
+void SymbolStaging::getStatistics(SymbolStagingStatistics *statistics)
+{
+    MutexLock lock(mutex);
+    statistics->updates = updateCount;
+    statistics->copies = copyCount;
+    statistics->bytes = byteCount;
+}
+
+/**
+ * Obtains the address and size of the global with the given name in the
+ * given module, looking it up if it is not known yet. To be called
+ * while holding the mutex.
+ */
+CUresult SymbolStaging::lookup(CUmodule module, const char *name, CUdeviceptr *address, size_t *size)
+{
+    std::pair<CUmodule, std::string> key(module, name);
+    std::map<std::pair<CUmodule, std::string>, std::pair<CUdeviceptr, size_t> >::iterator it = globals.find(key);
+    if (it != globals.end())
+    {
+        *address = it->second.first;
+        *size = it->second.second;
+        return CUDA_SUCCESS;
+    }
+    CUresult result = cuModuleGetGlobal(address, size, module, name);
+    if (result == CUDA_SUCCESS)
+    {
+        globals[key] = std::make_pair(*address, *size);
+    }
+    return result;
+}
+
+/**
+ * Makes the given stream wait for the copies of the last flush of the
+ * given updates, unless it is already ordered after them, or they are
+ * known to be complete. To be called while holding the mutex.
+ */
+CUresult SymbolStaging::order(SymbolUpdates *contextUpdates, CUstream stream)
+{
+    if (!contextUpdates->flushing || contextUpdates->orderedStreams.count(stream) != 0)
+    {
+        return CUDA_SUCCESS;
+    }
+    CUresult result = cuEventQuery(contextUpdates->event);
+    if (result == CUDA_SUCCESS)
+    {
+        contextUpdates->flushing = false;
+        contextUpdates->orderedStreams.clear();
+        atomicAdd(&flushingContexts, -1);
+        return CUDA_SUCCESS;
+    }
+    if (result != CUDA_ERROR_NOT_READY)
+    {
+        return result;
+    }
+    result = cuStreamWaitEvent(stream, contextUpdates->event, 0);
+    if (result == CUDA_SUCCESS)
+    {
+        contextUpdates->orderedStreams.insert(stream);
+    }
+    return result;
+}
+
+/**
+ * Obtains a page-locked buffer of at least the given size for the given
+ * updates, whose previous copies are complete, creating a new buffer if
+ * all buffers are in use. The buffer is NULL if the maximum number of
+ * buffers is in use, or if no page-locked buffer could be allocated,
+ * so that the ranges have to be copied from pageable memory. To be
+ * called while holding the mutex.
+ */
+CUresult SymbolStaging::acquireBuffer(SymbolUpdates *contextUpdates, size_t size, SymbolFlushBuffer **flushBuffer)
+{
+    *flushBuffer = NULL;
+    std::vector<SymbolFlushBuffer> &buffers = contextUpdates->buffers;
+    for (size_t i=0; i<buffers.size(); i++)
+    {
+        CUresult result = cuEventQuery(buffers[i].event);
+        if (result == CUDA_ERROR_NOT_READY)
+        {
+            continue;
+        }
+        if (result == CUDA_SUCCESS && buffers[i].size < size)
+        {
+            cuMemFreeHost(buffers[i].buffer);
+            buffers[i].buffer = NULL;
+            buffers[i].size = 2 * size;
+            result = cuMemHostAlloc((void**)&buffers[i].buffer, buffers[i].size, 0);
+        }
+        if (result != CUDA_SUCCESS)
+        {
+            Logger::log(LOG_DEBUG, "Could not reuse symbol staging buffer, error %d\n", result);
+            if (buffers[i].buffer != NULL)
+            {
+                cuMemFreeHost(buffers[i].buffer);
+            }
+            cuEventDestroy(buffers[i].event);
+            buffers.erase(buffers.begin() + i);
+            return CUDA_SUCCESS;
+        }
+        *flushBuffer = &buffers[i];
+        return CUDA_SUCCESS;
+    }
+    if (buffers.size() >= SYMBOL_STAGING_MAX_BUFFERS)
+    {
+        return CUDA_SUCCESS;
+    }
+
+    SymbolFlushBuffer created;
+    created.buffer = NULL;
+    created.size = 2 * size;
+    created.event = NULL;
+    CUresult result = cuMemHostAlloc((void**)&created.buffer, created.size, 0);
+    if (result == CUDA_SUCCESS)
+    {
+        result = cuEventCreate(&created.event, CU_EVENT_DISABLE_TIMING);
+    }
+    if (result != CUDA_SUCCESS)
+    {
+        Logger::log(LOG_DEBUG, "Could not create symbol staging buffer of %ld bytes, error %d\n",
+            (long)created.size, result);
+        if (created.buffer != NULL)
+        {
+            cuMemFreeHost(created.buffer);
+        }
+        return CUDA_SUCCESS;
+    }
+    buffers.push_back(created);
+    *flushBuffer = &buffers.back();
+    return CUDA_SUCCESS;
+}
+
+/**
+ * Merges the given update of the global with the given module and
+ * address into the ranges of the given updates. All ranges of the same
+ * global that overlap the update or are adjacent to it are combined
+ * into one range, where the update overwrites the previous contents.
+ * Ranges of different globals are never combined, so that the ranges
+ * of one module can be discarded when it is unloaded. To be called
+ * while holding the mutex.
+ */
+void SymbolStaging::merge(SymbolUpdates *contextUpdates, CUmodule module, CUdeviceptr global,
+    CUdeviceptr address, const char *data, size_t bytes)
+{
+    std::map<CUdeviceptr, SymbolRange> &ranges = contextUpdates->ranges;
+    CUdeviceptr start = address;
+    CUdeviceptr end = address + bytes;
+
+    // Find the first range of the global that ends at or after the
+    // start of the update
+    std::map<CUdeviceptr, SymbolRange>::iterator first = ranges.upper_bound(address);
+    if (first != ranges.begin())
+    {
+        std::map<CUdeviceptr, SymbolRange>::iterator previous = first;
+        --previous;
+        if (previous->second.global == global &&
+            previous->first + previous->second.data.size() >= address)
+        {
+            first = previous;
+        }
+    }
+    std::map<CUdeviceptr, SymbolRange>::iterator last = first;
+    while (last != ranges.end() && last->second.global == global && last->first <= end)
+    {
+        CUdeviceptr rangeEnd = last->first + last->second.data.size();
+        if (last->first < start)
+        {
+            start = last->first;
+        }
+        if (rangeEnd > end)
+        {
+            end = rangeEnd;
+        }
+        ++last;
+    }
+
+    std::vector<char> merged((size_t)(end - start));
+    std::map<CUdeviceptr, SymbolRange>::iterator it;
+    for (it = first; it != last; ++it)
+    {
+        memcpy(&merged[(size_t)(it->first - start)], &it->second.data[0], it->second.data.size());
+    }
+    memcpy(&merged[(size_t)(address - start)], data, bytes);
+    ranges.erase(first, last);
+    SymbolRange &range = ranges[start];
+    range.module = module;
+    range.global = global;
+    range.data.swap(merged);
+}
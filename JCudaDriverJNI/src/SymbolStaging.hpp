@@ -0,0 +1,207 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef SYMBOLSTAGING
+#define SYMBOLSTAGING
+
+#include <cuda.h>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Threading.hpp"
+
+/**
+ * Statistics about the updates of a SymbolStaging
+ */
+struct SymbolStagingStatistics
+{
+    /** The number of updates that have been staged */
+    jcuda_int64 updates;
+
+    /** The number of copies that the updates have been flushed with */
+    jcuda_int64 copies;
+
+    /** The number of bytes that have been flushed */
+    jcuda_int64 bytes;
+};
+
+
+/**
+ * A page-locked buffer that updates are flushed from, and the event
+ * that is recorded after the copies from the buffer
+ */
+struct SymbolFlushBuffer
+{
+    char *buffer;
+    size_t size;
+    CUevent event;
+};
+
+
+/**
+ * A merged range of pending updates of one global
+ */
+struct SymbolRange
+{
+    /** The module of the global, and the device address of the global */
+    CUmodule module;
+    CUdeviceptr global;
+
+    /** The contents of the range */
+    std::vector<char> data;
+};
+
+
+/**
+ * The pending updates of one context
+ */
+struct SymbolUpdates
+{
+    /** The merged ranges of pending updates, by their device address */
+    std::map<CUdeviceptr, SymbolRange> ranges;
+
+    /**
+     * The page-locked buffers that the ranges are flushed from. A
+     * buffer is only reused when the copies from it are complete.
+     */
+    std::vector<SymbolFlushBuffer> buffers;
+
+    /** The event that is recorded after the copies of the last flush */
+    CUevent event;
+
+    /**
+     * Whether the copies of the last flush may still be pending, and
+     * the streams that are known to be ordered after them
+     */
+    bool flushing;
+    std::set<CUstream> orderedStreams;
+};
+
+
+/**
+ * A staging area for updates of global variables of modules, e.g.
+ * __constant__ parameters that are set before each launch.<br />
+ * <br />
+ * The address and size of each global are looked up once with
+ * cuModuleGetGlobal. The updates are copied into host memory, and
+ * the updates of each context are merged into ranges of adjacent
+ * addresses of the same global, where later updates overwrite earlier
+ * ones. When the
+ * updates are flushed, the ranges are packed into a page-locked buffer,
+ * and each range is copied with one asynchronous copy. Updates are
+ * flushed before a kernel is launched in the same context, or
+ * explicitly.<br />
+ * <br />
+ * The copies are issued in the stream of the flush, and an event is
+ * recorded after them. Until this event is known to be complete, each
+ * other stream of the context waits for it with cuStreamWaitEvent
+ * before its next launch. A flush never waits for earlier copies: If
+ * all page-locked buffers of the context are still in use, or if no
+ * page-locked buffer can be created, then the ranges are copied from
+ * pageable memory, which the driver stages before the copy call
+ * returns.
+ */
+class SymbolStaging
+{
+    public:
+
+        SymbolStaging();
+
+        /**
+         * Destroys this staging. The page-locked buffers are not
+         * released, since their contexts may no longer exist.
+         */
+        ~SymbolStaging();
+
+        /**
+         * Stages an update of the given number of bytes at the given
+         * offset of the global with the given name in the given module,
+         * in the current context
+         */
+        CUresult stage(CUmodule module, const char *name, size_t offset, const void *data, size_t bytes);
+
+        /**
+         * Flushes the pending updates of the current context, as
+         * asynchronous copies in the given stream. If there are no
+         * pending updates, then the given stream is only ordered after
+         * the copies of the last flush.
+         */
+        CUresult flush(CUstream stream);
+
+        /**
+         * Removes the globals of the given module, and discards the
+         * pending updates of these globals in all contexts, e.g. before
+         * the module is unloaded
+         */
+        void removeModule(CUmodule module);
+
+        /**
+         * Discards the pending updates of the given context and releases
+         * its buffer, e.g. before the context is destroyed
+         */
+        void removeContext(CUcontext context);
+
+        /**
+         * Returns the statistics of this staging
+         */
+        void getStatistics(SymbolStagingStatistics *statistics);
+
+    private:
+
+        /** Guards all members */
+        Mutex mutex;
+
+        /** The known globals, as device address and size */
+        std::map<std::pair<CUmodule, std::string>, std::pair<CUdeviceptr, size_t> > globals;
+
+        /** The pending updates, by context */
+        std::map<CUcontext, SymbolUpdates*> updates;
+
+        /** The number of contexts with pending updates */
+        volatile int pendingContexts;
+
+        /** The number of contexts whose last flush may be pending */
+        volatile int flushingContexts;
+
+        jcuda_int64 updateCount;
+        jcuda_int64 copyCount;
+        jcuda_int64 byteCount;
+
+        CUresult lookup(CUmodule module, const char *name, CUdeviceptr *address, size_t *size);
+        CUresult order(SymbolUpdates *contextUpdates, CUstream stream);
+        CUresult acquireBuffer(SymbolUpdates *contextUpdates, size_t size, SymbolFlushBuffer **flushBuffer);
+        void merge(SymbolUpdates *contextUpdates, CUmodule module, CUdeviceptr global,
+            CUdeviceptr address, const char *data, size_t bytes);
+
+        SymbolStaging(const SymbolStaging&);
+        SymbolStaging& operator=(const SymbolStaging&);
+};
+
+
+#endif
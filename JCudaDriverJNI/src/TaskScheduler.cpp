@@ -0,0 +1,235 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "TaskScheduler.hpp"
+
+TaskScheduler::TaskScheduler(unsigned int contextFlags, int streamsPerDevice,
+    ThreadFunction workerExit, ContextDestroyFunction contextDestroy)
+    : DeviceScheduler(contextFlags, workerExit, contextDestroy)
+{
+    this->streamsPerDevice = streamsPerDevice;
+    queuedTasks = 0;
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    shutdown();
+}
+
+SchedulerDevice* TaskScheduler::createDevice()
+{
+    Device *device = new Device();
+    device->boundCount = 0;
+    device->stolen = 0;
+    return device;
+}
+
+CUresult TaskScheduler::createStreams(SchedulerDevice *device)
+{
+    Device *d = (Device*)device;
+    for (int s=0; s<streamsPerDevice; s++)
+    {
+        CUstream stream;
+        CUresult result = cuStreamCreate(&stream, CU_STREAM_NON_BLOCKING);
+        if (result != CUDA_SUCCESS)
+        {
+            return result;
+        }
+        d->streams.push_back(stream);
+        d->running.push_back(NULL);
+    }
+    return CUDA_SUCCESS;
+}
+
+CUresult TaskScheduler::submit(TaskFunction function, TaskCleanupFunction cleanup,
+    void *userData, int device, SchedulerTask **task)
+{
+    if (!started)
+    {
+        return CUDA_ERROR_NOT_INITIALIZED;
+    }
+    if (function == NULL || device < -1 || device >= (int)devices.size())
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    SchedulerTask *schedulerTask =
+        createTask(function, cleanup, userData, task == NULL ? 1 : 2);
+    Device *target = (Device*)assign(device);
+
+    // The counters are incremented before the task is published, so
+    // that a worker that takes the task can not decrement them first
+    {
+        MutexLock lock(mutex);
+        pendingTasks++;
+        if (device >= 0)
+        {
+            atomicAdd(&target->boundCount, 1);
+        }
+        else
+        {
+            atomicAdd(&queuedTasks, 1);
+        }
+    }
+    {
+        MutexLock lock(target->queueMutex);
+        if (device >= 0)
+        {
+            target->boundQueue.push_back(schedulerTask);
+        }
+        else
+        {
+            target->queue.push_back(schedulerTask);
+        }
+    }
+    {
+        MutexLock lock(mutex);
+        workAvailable.broadcast();
+    }
+    if (task != NULL)
+    {
+        *task = schedulerTask;
+    }
+    return CUDA_SUCCESS;
+}
+
+CUresult TaskScheduler::getStatistics(int device, jcuda_int64 *executed, jcuda_int64 *stolen)
+{
+    if (device < 0 || device >= (int)devices.size())
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    Device *d = (Device*)devices[device];
+    *executed = atomicLoad(&d->executed);
+    *stolen = atomicLoad(&d->stolen);
+    return CUDA_SUCCESS;
+}
+
+/**
+ * Completes the tasks whose events have been reached, and launches
+ * new tasks in all streams that became free
+ */
+bool TaskScheduler::schedule(SchedulerDevice *device, int *runningCount)
+{
+    Device *d = (Device*)device;
+    *runningCount = poll(d, d->running);
+    bool launched = false;
+    for (size_t slot=0; slot<d->running.size(); slot++)
+    {
+        if (d->running[slot] != NULL)
+        {
+            continue;
+        }
+        SchedulerTask *task = take(d);
+        if (task == NULL)
+        {
+            break;
+        }
+        if (launch(d, d->streams[slot], task))
+        {
+            d->running[slot] = task;
+            (*runningCount)++;
+        }
+        launched = true;
+    }
+    return launched;
+}
+
+bool TaskScheduler::hasQueuedTasks(SchedulerDevice *device)
+{
+    Device *d = (Device*)device;
+    return atomicLoad(&queuedTasks) > 0 || atomicLoad(&d->boundCount) > 0;
+}
+
+/**
+ * Takes the next task for the given device: A task that is bound to
+ * the device, a task from its own deque, or a stolen one
+ */
+SchedulerTask* TaskScheduler::take(Device *device)
+{
+    {
+        MutexLock lock(device->queueMutex);
+        if (!device->boundQueue.empty())
+        {
+            SchedulerTask *task = device->boundQueue.front();
+            device->boundQueue.pop_front();
+            atomicAdd(&device->boundCount, -1);
+            return task;
+        }
+        if (!device->queue.empty())
+        {
+            SchedulerTask *task = device->queue.front();
+            device->queue.pop_front();
+            atomicAdd(&queuedTasks, -1);
+            return task;
+        }
+    }
+    return steal(device);
+}
+
+/**
+ * Steals a task from the back of the deque of the most loaded
+ * other device, or returns NULL if there is no task to steal
+ */
+SchedulerTask* TaskScheduler::steal(Device *thief)
+{
+    if (atomicLoad(&queuedTasks) <= 0)
+    {
+        return NULL;
+    }
+    int n = (int)devices.size();
+    Device *victim = NULL;
+    for (int i=1; i<n; i++)
+    {
+        Device *candidate = (Device*)devices[(thief->index + i) % n];
+        if (victim == NULL || atomicLoad(&candidate->load) > atomicLoad(&victim->load))
+        {
+            victim = candidate;
+        }
+    }
+
+    // Try the most loaded device first, and then all others
+    for (int i=0; i<n; i++)
+    {
+        Device *candidate = (i == 0) ? victim : (Device*)devices[(thief->index + i) % n];
+        if (candidate == NULL || candidate == thief)
+        {
+            continue;
+        }
+        MutexLock lock(candidate->queueMutex);
+        if (!candidate->queue.empty())
+        {
+            SchedulerTask *task = candidate->queue.back();
+            candidate->queue.pop_back();
+            atomicAdd(&queuedTasks, -1);
+            atomicAdd(&candidate->load, -1);
+            atomicAdd(&thief->load, 1);
+            atomicAdd(&thief->stolen, 1);
+            return task;
+        }
+    }
+    return NULL;
+}
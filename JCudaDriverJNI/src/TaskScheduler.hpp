@@ -0,0 +1,132 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TASKSCHEDULER
+#define TASKSCHEDULER
+
+#include <cuda.h>
+#include <deque>
+#include <vector>
+#include "Threading.hpp"
+#include "DeviceScheduler.hpp"
+
+/**
+ * A scheduler that distributes tasks over all devices. For each device,
+ * the scheduler creates a context, a set of streams, and a worker thread
+ * that launches one task per stream at a time.<br />
+ * <br />
+ * Each device has a deque of tasks. A task that is not bound to a
+ * device is put into the deque of the device with the lowest load. A
+ * worker takes tasks from the front of its own deque, and when this
+ * deque is empty, it steals from the back of the deques of the other
+ * devices. So faster devices automatically execute more tasks. Tasks
+ * that are bound to a device are never stolen.<br />
+ * <br />
+ * The completion of a task is detected with an event that is recorded
+ * in its stream after the task function returned. The task function
+ * must leave the context of the device current when it returns.
+ */
+class TaskScheduler : public DeviceScheduler
+{
+    public:
+
+        /**
+         * Creates a new scheduler that creates contexts with the given
+         * flags and the given number of streams per device. The given
+         * exit function, if not NULL, is called by each worker thread
+         * before it terminates. The given destroy function, if not
+         * NULL, is used for destroying the contexts. The scheduler has
+         * to be initialized with init() before it can be used.
+         */
+        TaskScheduler(unsigned int contextFlags, int streamsPerDevice,
+            ThreadFunction workerExit, ContextDestroyFunction contextDestroy);
+
+        /**
+         * Destroys this scheduler, after waiting for all tasks. The
+         * contexts of the scheduler are destroyed. This must not be
+         * called from a worker thread, see isWorkerThread().
+         */
+        ~TaskScheduler();
+
+        /**
+         * Submits a task. If the given device is -1, the task may be
+         * executed on any device. Otherwise, it is executed on the
+         * given device. If the given task pointer is not NULL, it will
+         * receive a reference to the task, which has to be released.
+         */
+        CUresult submit(TaskFunction function, TaskCleanupFunction cleanup,
+            void *userData, int device, SchedulerTask **task);
+
+        /**
+         * Obtains the number of tasks that have been executed on the
+         * given device, and how many of them have been stolen from
+         * the deques of other devices
+         */
+        CUresult getStatistics(int device, jcuda_int64 *executed, jcuda_int64 *stolen);
+
+    protected:
+        SchedulerDevice* createDevice();
+        CUresult createStreams(SchedulerDevice *device);
+        bool schedule(SchedulerDevice *device, int *runningCount);
+        bool hasQueuedTasks(SchedulerDevice *device);
+
+    private:
+
+        /** The state of one device */
+        struct Device : public SchedulerDevice
+        {
+            std::vector<CUstream> streams;
+
+            /** The task that is executed in each stream, or NULL */
+            std::vector<SchedulerTask*> running;
+
+            /** The tasks that may be stolen, guarded by the queueMutex */
+            std::deque<SchedulerTask*> queue;
+
+            /** The tasks that are bound to this device */
+            std::deque<SchedulerTask*> boundQueue;
+
+            /** The number of tasks in the boundQueue */
+            volatile int boundCount;
+
+            volatile jcuda_int64 stolen;
+        };
+
+        int streamsPerDevice;
+
+        /** The number of tasks that may be stolen, in all deques */
+        volatile int queuedTasks;
+
+        SchedulerTask* take(Device *device);
+        SchedulerTask* steal(Device *thief);
+
+        TaskScheduler(const TaskScheduler&);
+        TaskScheduler& operator=(const TaskScheduler&);
+};
+
+
+#endif
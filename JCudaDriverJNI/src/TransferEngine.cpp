@@ -0,0 +1,750 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "TransferEngine.hpp"
+#include "Logger.hpp"
+#include <cstring>
+#include <deque>
+#include <utility>
+
+
+//=== Transfer ===============================================================
+
+Transfer::Transfer(TransferEngine *engine, size_t bytes, size_t chunkSize)
+{
+    this->engine = engine;
+    this->bytes = bytes;
+    this->chunkSize = chunkSize;
+    chunkCount = (int)((bytes + chunkSize - 1) / chunkSize);
+    startEvent = NULL;
+    completed = false;
+    elapsedTime = 0.0;
+}
+
+Transfer::~Transfer()
+{
+}
+
+TransferEngine* Transfer::getEngine()
+{
+    return engine;
+}
+
+int Transfer::getChunkCount()
+{
+    return chunkCount;
+}
+
+CUevent Transfer::getChunkEvent(int chunk)
+{
+    if (chunk < 0 || chunk >= chunkCount)
+    {
+        return NULL;
+    }
+    return chunkEvents[chunk];
+}
+
+CUresult Transfer::streamWait(CUstream stream, size_t byteOffset, size_t byteCount)
+{
+    if (byteCount == 0)
+    {
+        return CUDA_SUCCESS;
+    }
+    if (byteOffset >= bytes || byteCount > bytes - byteOffset)
+    {
+        return CUDA_ERROR_INVALID_VALUE;
+    }
+    int first = (int)(byteOffset / chunkSize);
+    int last = (int)((byteOffset + byteCount - 1) / chunkSize);
+
+    // The chunks are assigned to the streams of the engine round-robin,
+    // and the chunks in one stream complete in order. So it is
+    // sufficient to wait for the last chunk of the range in each stream.
+    int lowest = last - engine->streamCount + 1;
+    if (lowest < first)
+    {
+        lowest = first;
+    }
+    for (int i=last; i>=lowest; i--)
+    {
+        CUresult result = cuStreamWaitEvent(stream, chunkEvents[i], 0);
+        if (result != CUDA_SUCCESS)
+        {
+            return result;
+        }
+    }
+    return CUDA_SUCCESS;
+}
+
+CUresult Transfer::query()
+{
+    return complete();
+}
+
+CUresult Transfer::synchronize()
+{
+    for (size_t i=0; i<endEvents.size(); i++)
+    {
+        CUresult result = cuEventSynchronize(endEvents[i]);
+        if (result != CUDA_SUCCESS)
+        {
+            return result;
+        }
+    }
+    return complete();
+}
+
+CUresult Transfer::getStatistics(TransferStatistics *statistics)
+{
+    CUresult result = complete();
+    if (result != CUDA_SUCCESS)
+    {
+        return result;
+    }
+    statistics->transferCount = 1;
+    statistics->bytes = (jcuda_int64)bytes;
+    statistics->elapsedTime = elapsedTime;
+    statistics->bandwidth = 0.0;
+    if (elapsedTime > 0.0)
+    {
+        statistics->bandwidth = (double)bytes / (elapsedTime / 1000.0);
+    }
+    return CUDA_SUCCESS;
+}
+
+/**
+ * Checks whether all chunks of this transfer have been transferred,
+ * and if so, computes the elapsed time and adds this transfer to the
+ * statistics of the engine (once). Returns CUDA_ERROR_NOT_READY if
+ * the transfer is not complete yet.
+ */
+CUresult Transfer::complete()
+{
+    if (completed)
+    {
+        return CUDA_SUCCESS;
+    }
+    float maxElapsed = 0.0f;
+    for (size_t i=0; i<endEvents.size(); i++)
+    {
+        CUresult result = cuEventQuery(endEvents[i]);
+        if (result != CUDA_SUCCESS)
+        {
+            return result;
+        }
+        float elapsed = 0.0f;
+        result = cuEventElapsedTime(&elapsed, startEvent, endEvents[i]);
+        if (result != CUDA_SUCCESS)
+        {
+            return result;
+        }
+        if (elapsed > maxElapsed)
+        {
+            maxElapsed = elapsed;
+        }
+    }
+    engine->recordCompletion(this, (double)maxElapsed);
+    return CUDA_SUCCESS;
+}
+
+
+//=== TransferEngine =========================================================
+
+TransferEngine::TransferEngine(size_t chunkSize, int streamCount)
+{
+    this->chunkSize = chunkSize;
+    this->streamCount = streamCount;
+    transferCount = 0;
+    transferredBytes = 0;
+    elapsedTime = 0.0;
+    nextStaging = 0;
+}
+
+TransferEngine::~TransferEngine()
+{
+    for (size_t i=0; i<streams.size(); i++)
+    {
+        cuStreamSynchronize(streams[i]);
+        cuStreamDestroy(streams[i]);
+    }
+    for (size_t i=0; i<retiredTransfers.size(); i++)
+    {
+        destroyTransfer(retiredTransfers[i]);
+    }
+    for (size_t i=0; i<stagingBuffers.size(); i++)
+    {
+        cuMemFreeHost(stagingBuffers[i]);
+    }
+    for (size_t i=0; i<stagingEvents.size(); i++)
+    {
+        cuEventDestroy(stagingEvents[i]);
+    }
+    for (size_t i=0; i<freeEvents.size(); i++)
+    {
+        cuEventDestroy(freeEvents[i]);
+    }
+    for (size_t i=0; i<freeTimingEvents.size(); i++)
+    {
+        cuEventDestroy(freeTimingEvents[i]);
+    }
+}
+
+CUresult TransferEngine::init()
+{
+    MutexLock lock(mutex);
+    for (int i=0; i<streamCount; i++)
+    {
+        CUstream stream = NULL;
+        CUresult result = cuStreamCreate(&stream, CU_STREAM_NON_BLOCKING);
+        if (result != CUDA_SUCCESS)
+        {
+            return result;
+        }
+        streams.push_back(stream);
+    }
+
+    // Two staging buffers per stream, so that the host may fill one
+    // while the other one is being transferred
+    int stagingCount = 2 * streamCount;
+    for (int i=0; i<stagingCount; i++)
+    {
+        void *buffer = NULL;
+        CUresult result = cuMemHostAlloc(&buffer, chunkSize, 0);
+        if (result != CUDA_SUCCESS)
+        {
+            return result;
+        }
+        stagingBuffers.push_back(buffer);
+
+        CUevent event = NULL;
+        result = cuEventCreate(&event, CU_EVENT_DISABLE_TIMING);
+        if (result != CUDA_SUCCESS)
+        {
+            return result;
+        }
+        stagingEvents.push_back(event);
+        stagingUsed.push_back(false);
+    }
+    Logger::log(LOG_DEBUG, "Initialized transfer engine with %d streams and chunk size %ld\n",
+        streamCount, (long)chunkSize);
+    return CUDA_SUCCESS;
+}
+
+
+bool TransferEngine::copyHtoD(JNIEnv *env, CUdeviceptr dst, PointerData *src, size_t bytes, CUstream stream, Transfer **transfer, CUresult *result)
+{
+    Transfer *t = NULL;
+    *result = createTransfer(bytes, stream, &t);
+    if (*result != CUDA_SUCCESS)
+    {
+        return true;
+    }
+
+    // Page-locked host memory remains accessible for the whole
+    // transfer. Other host memory is only accessed while a chunk
+    // is copied into a staging buffer.
+    char *host = (char*)src->getPointer(env);
+    if (host == NULL)
+    {
+        abortTransfer(t);
+        return false;
+    }
+    unsigned int hostFlags = 0;
+    bool pinned = (cuMemHostGetFlags(&hostFlags, host) == CUDA_SUCCESS);
+    if (!pinned)
+    {
+        src->releasePointer(env, JNI_ABORT);
+    }
+    Logger::log(LOG_DEBUGTRACE, "Transfer of %ld bytes from %s host memory to device in %d chunks\n",
+        (long)bytes, (pinned ? "page-locked" : "pageable"), t->chunkCount);
+
+    bool accessible = true;
+    for (int i=0; i<t->chunkCount; i++)
+    {
+        size_t offset = (size_t)i * chunkSize;
+        size_t size = bytes - offset < chunkSize ? bytes - offset : chunkSize;
+        CUstream s = streams[i % streamCount];
+        if (pinned)
+        {
+            *result = cuMemcpyHtoDAsync(dst + offset, host + offset, size, s);
+        }
+        else
+        {
+            int b = -1;
+            *result = acquireStaging(true, &b);
+            if (*result != CUDA_SUCCESS)
+            {
+                break;
+            }
+            host = (char*)src->getPointer(env);
+            if (host == NULL)
+            {
+                releaseStaging(b);
+                accessible = false;
+                break;
+            }
+            memcpy(stagingBuffers[b], host + offset, size);
+            src->releasePointer(env, JNI_ABORT);
+            *result = cuMemcpyHtoDAsync(dst + offset, stagingBuffers[b], size, s);
+            if (*result == CUDA_SUCCESS)
+            {
+                *result = cuEventRecord(stagingEvents[b], s);
+            }
+            releaseStaging(b);
+        }
+        if (*result != CUDA_SUCCESS)
+        {
+            break;
+        }
+        *result = cuEventRecord(t->chunkEvents[i], s);
+        if (*result != CUDA_SUCCESS)
+        {
+            break;
+        }
+    }
+    if (pinned)
+    {
+        src->releasePointer(env, JNI_ABORT);
+    }
+    if (accessible && *result == CUDA_SUCCESS)
+    {
+        *result = finishTransfer(t);
+    }
+    if (!accessible || *result != CUDA_SUCCESS)
+    {
+        abortTransfer(t);
+        return accessible;
+    }
+    *transfer = t;
+    return true;
+}
+
+
+bool TransferEngine::copyDtoH(JNIEnv *env, PointerData *dst, CUdeviceptr src, size_t bytes, CUstream stream, Transfer **transfer, CUresult *result)
+{
+    Transfer *t = NULL;
+    *result = createTransfer(bytes, stream, &t);
+    if (*result != CUDA_SUCCESS)
+    {
+        return true;
+    }
+
+    // Page-locked host memory remains accessible for the whole
+    // transfer. Other host memory is only accessed while a chunk
+    // is copied out of a staging buffer.
+    char *host = (char*)dst->getPointer(env);
+    if (host == NULL)
+    {
+        abortTransfer(t);
+        return false;
+    }
+    unsigned int hostFlags = 0;
+    bool pinned = (cuMemHostGetFlags(&hostFlags, host) == CUDA_SUCCESS);
+    if (!pinned)
+    {
+        dst->releasePointer(env, JNI_ABORT);
+    }
+    Logger::log(LOG_DEBUGTRACE, "Transfer of %ld bytes from device to %s host memory in %d chunks\n",
+        (long)bytes, (pinned ? "page-locked" : "pageable"), t->chunkCount);
+
+    // For pageable memory, the staging buffers that are held by this
+    // transfer, and the chunks that are transferred into them, in the
+    // order of the chunks
+    std::deque<std::pair<int, int> > staged;
+
+    bool accessible = true;
+    for (int i=0; i<t->chunkCount; i++)
+    {
+        size_t offset = (size_t)i * chunkSize;
+        size_t size = bytes - offset < chunkSize ? bytes - offset : chunkSize;
+        CUstream s = streams[i % streamCount];
+        if (pinned)
+        {
+            *result = cuMemcpyDtoHAsync(host + offset, src + offset, size, s);
+        }
+        else
+        {
+            // Only wait for another thread to release a buffer if this
+            // transfer does not hold any buffer. Otherwise, the oldest
+            // buffer of this transfer is drained and re-used.
+            int b = -1;
+            *result = acquireStaging(staged.empty(), &b);
+            if (*result == CUDA_ERROR_NOT_READY)
+            {
+                b = staged.front().first;
+                accessible = drainStaging(env, b, staged.front().second, dst, bytes, result);
+                staged.pop_front();
+                if (!accessible || *result != CUDA_SUCCESS)
+                {
+                    releaseStaging(b);
+                }
+            }
+            if (!accessible || *result != CUDA_SUCCESS)
+            {
+                break;
+            }
+            staged.push_back(std::make_pair(b, i));
+            *result = cuMemcpyDtoHAsync(stagingBuffers[b], src + offset, size, s);
+            if (*result == CUDA_SUCCESS)
+            {
+                *result = cuEventRecord(stagingEvents[b], s);
+            }
+        }
+        if (*result != CUDA_SUCCESS)
+        {
+            break;
+        }
+        *result = cuEventRecord(t->chunkEvents[i], s);
+        if (*result != CUDA_SUCCESS)
+        {
+            break;
+        }
+    }
+    if (pinned)
+    {
+        dst->releasePointer(env, 0);
+    }
+    if (accessible && *result == CUDA_SUCCESS)
+    {
+        *result = finishTransfer(t);
+    }
+
+    // Copy the chunks that are still in the staging buffers, in order
+    while (!staged.empty())
+    {
+        if (accessible && *result == CUDA_SUCCESS)
+        {
+            accessible = drainStaging(env, staged.front().first, staged.front().second, dst, bytes, result);
+        }
+        else
+        {
+            // The copies into the buffer have to be finished before
+            // it may be used by another thread
+            cuEventSynchronize(stagingEvents[staged.front().first]);
+        }
+        releaseStaging(staged.front().first);
+        staged.pop_front();
+    }
+    if (!accessible || *result != CUDA_SUCCESS)
+    {
+        abortTransfer(t);
+        return accessible;
+    }
+    *transfer = t;
+    return true;
+}
+
+
+void TransferEngine::releaseTransfer(Transfer *transfer)
+{
+    CUresult result = transfer->complete();
+
+    // The events of a transfer that is still pending may not be
+    // re-used yet, so the transfer is retired until it is complete
+    MutexLock lock(mutex);
+    if (result == CUDA_ERROR_NOT_READY)
+    {
+        retiredTransfers.push_back(transfer);
+        return;
+    }
+    destroyTransfer(transfer);
+}
+
+
+void TransferEngine::getStatistics(TransferStatistics *statistics)
+{
+    MutexLock lock(mutex);
+    statistics->transferCount = transferCount;
+    statistics->bytes = transferredBytes;
+    statistics->elapsedTime = elapsedTime;
+    statistics->bandwidth = 0.0;
+    if (elapsedTime > 0.0)
+    {
+        statistics->bandwidth = (double)transferredBytes / (elapsedTime / 1000.0);
+    }
+}
+
+
+/**
+ * Creates a new transfer for the given number of bytes, with all
+ * required events, and records the start event. If the given stream
+ * is not NULL, the start event is recorded in this stream. All streams
+ * of the engine that are used for the transfer wait for the start event.
+ */
+CUresult TransferEngine::createTransfer(size_t bytes, CUstream stream, Transfer **transfer)
+{
+    Transfer *t = new Transfer(this, bytes, chunkSize);
+    CUresult result = CUDA_SUCCESS;
+    int usedStreams = t->chunkCount < streamCount ? t->chunkCount : streamCount;
+    {
+        MutexLock lock(mutex);
+        reclaimTransfers();
+        for (int i=0; i<t->chunkCount && result == CUDA_SUCCESS; i++)
+        {
+            CUevent event = NULL;
+            result = obtainEvent(false, &event);
+            if (result == CUDA_SUCCESS)
+            {
+                t->chunkEvents.push_back(event);
+            }
+        }
+        if (result == CUDA_SUCCESS)
+        {
+            result = obtainEvent(true, &t->startEvent);
+        }
+        for (int i=0; i<usedStreams && result == CUDA_SUCCESS; i++)
+        {
+            CUevent event = NULL;
+            result = obtainEvent(true, &event);
+            if (result == CUDA_SUCCESS)
+            {
+                t->endEvents.push_back(event);
+            }
+        }
+    }
+    if (result == CUDA_SUCCESS)
+    {
+        CUstream startStream = stream != NULL ? stream : streams[0];
+        result = cuEventRecord(t->startEvent, startStream);
+        for (int i=0; i<usedStreams && result == CUDA_SUCCESS; i++)
+        {
+            if (streams[i] != startStream)
+            {
+                result = cuStreamWaitEvent(streams[i], t->startEvent, 0);
+            }
+        }
+    }
+    if (result != CUDA_SUCCESS)
+    {
+        abortTransfer(t);
+        return result;
+    }
+    *transfer = t;
+    return CUDA_SUCCESS;
+}
+
+/**
+ * Records the end events of the given transfer in all streams that
+ * have been used for the transfer
+ */
+CUresult TransferEngine::finishTransfer(Transfer *transfer)
+{
+    for (size_t i=0; i<transfer->endEvents.size(); i++)
+    {
+        CUresult result = cuEventRecord(transfer->endEvents[i], streams[i]);
+        if (result != CUDA_SUCCESS)
+        {
+            return result;
+        }
+    }
+    return CUDA_SUCCESS;
+}
+
+/**
+ * Cleans up after an error during the given transfer: Waits until
+ * all parts of the transfer that have been issued are finished, and
+ * destroys the transfer.
+ */
+void TransferEngine::abortTransfer(Transfer *transfer)
+{
+    for (size_t i=0; i<streams.size(); i++)
+    {
+        cuStreamSynchronize(streams[i]);
+    }
+    MutexLock lock(mutex);
+    destroyTransfer(transfer);
+}
+
+/**
+ * Returns the events of the given transfer to the pools of this
+ * engine, and deletes the transfer. The transfer must be complete.
+ * Must be called while holding the mutex.
+ */
+void TransferEngine::destroyTransfer(Transfer *transfer)
+{
+    for (size_t i=0; i<transfer->chunkEvents.size(); i++)
+    {
+        freeEvents.push_back(transfer->chunkEvents[i]);
+    }
+    for (size_t i=0; i<transfer->endEvents.size(); i++)
+    {
+        freeTimingEvents.push_back(transfer->endEvents[i]);
+    }
+    if (transfer->startEvent != NULL)
+    {
+        freeTimingEvents.push_back(transfer->startEvent);
+    }
+    delete transfer;
+}
+
+/**
+ * Destroys all retired transfers that are complete, so that their
+ * events may be re-used. The end events are recorded after all other
+ * events of a transfer, so it is sufficient to query them. Must be
+ * called while holding the mutex.
+ */
+void TransferEngine::reclaimTransfers()
+{
+    size_t n = 0;
+    for (size_t i=0; i<retiredTransfers.size(); i++)
+    {
+        Transfer *transfer = retiredTransfers[i];
+        CUresult result = CUDA_SUCCESS;
+        for (size_t j=0; j<transfer->endEvents.size() && result == CUDA_SUCCESS; j++)
+        {
+            result = cuEventQuery(transfer->endEvents[j]);
+        }
+        if (result == CUDA_ERROR_NOT_READY)
+        {
+            retiredTransfers[n++] = transfer;
+        }
+        else
+        {
+            destroyTransfer(transfer);
+        }
+    }
+    retiredTransfers.resize(n);
+}
+
+/**
+ * Obtains an event from the pool of this engine, or creates a new one.
+ * Must be called while holding the mutex.
+ */
+CUresult TransferEngine::obtainEvent(bool timing, CUevent *event)
+{
+    std::vector<CUevent> &pool = timing ? freeTimingEvents : freeEvents;
+    if (!pool.empty())
+    {
+        *event = pool.back();
+        pool.pop_back();
+        return CUDA_SUCCESS;
+    }
+    return cuEventCreate(event, timing ? CU_EVENT_DEFAULT : CU_EVENT_DISABLE_TIMING);
+}
+
+/**
+ * Obtains a staging buffer that is not used by another thread, and
+ * waits until the last transfer that used it is finished. The mutex
+ * is only held while the buffer is chosen, not while waiting. If all
+ * buffers are in use, then this either waits until another thread
+ * releases one, or returns CUDA_ERROR_NOT_READY, depending on the
+ * given flag.
+ */
+CUresult TransferEngine::acquireStaging(bool wait, int *buffer)
+{
+    int b = -1;
+    {
+        MutexLock lock(mutex);
+        int stagingCount = (int)stagingBuffers.size();
+        while (true)
+        {
+            for (int i=0; i<stagingCount && b < 0; i++)
+            {
+                int candidate = (nextStaging + i) % stagingCount;
+                if (!stagingUsed[candidate])
+                {
+                    b = candidate;
+                }
+            }
+            if (b >= 0)
+            {
+                break;
+            }
+            if (!wait)
+            {
+                return CUDA_ERROR_NOT_READY;
+            }
+            stagingCondition.wait(mutex);
+        }
+        stagingUsed[b] = true;
+        nextStaging = (b + 1) % stagingCount;
+    }
+    CUresult result = cuEventSynchronize(stagingEvents[b]);
+    if (result != CUDA_SUCCESS)
+    {
+        releaseStaging(b);
+        return result;
+    }
+    *buffer = b;
+    return CUDA_SUCCESS;
+}
+
+/**
+ * Returns the given staging buffer, so that it may be used by other
+ * threads. The event of the buffer must have been recorded after the
+ * last copy that uses it.
+ */
+void TransferEngine::releaseStaging(int buffer)
+{
+    MutexLock lock(mutex);
+    stagingUsed[buffer] = false;
+    stagingCondition.signal();
+}
+
+/**
+ * Waits until the transfer of the given chunk of a device-to-host
+ * transfer into the given staging buffer is finished, and copies
+ * it into the given host memory. The host memory is only accessed
+ * while the chunk is copied. The error code is stored in the given
+ * result. Returns false if the host memory could not be accessed.
+ */
+bool TransferEngine::drainStaging(JNIEnv *env, int buffer, int chunk, PointerData *dst, size_t bytes, CUresult *result)
+{
+    *result = cuEventSynchronize(stagingEvents[buffer]);
+    if (*result != CUDA_SUCCESS)
+    {
+        return true;
+    }
+    char *host = (char*)dst->getPointer(env);
+    if (host == NULL)
+    {
+        return false;
+    }
+    size_t offset = (size_t)chunk * chunkSize;
+    size_t size = bytes - offset < chunkSize ? bytes - offset : chunkSize;
+    memcpy(host + offset, stagingBuffers[buffer], size);
+    dst->releasePointer(env, 0);
+    return true;
+}
+
+/**
+ * Marks the given transfer as completed, with the given elapsed time,
+ * and adds it to the statistics, unless this was already done.
+ */
+void TransferEngine::recordCompletion(Transfer *transfer, double elapsed)
+{
+    MutexLock lock(mutex);
+    if (transfer->completed)
+    {
+        return;
+    }
+    transfer->completed = true;
+    transfer->elapsedTime = elapsed;
+    transferCount++;
+    transferredBytes += (jcuda_int64)transfer->bytes;
+    elapsedTime += elapsed;
+}
@@ -0,0 +1,267 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TRANSFERENGINE
+#define TRANSFERENGINE
+
+#include <cuda.h>
+#include <jni.h>
+#include <vector>
+#include "Logger.hpp"
+#include "PointerUtils.hpp"
+#include "Threading.hpp"
+
+/**
+ * Statistics about one transfer, or about all transfers of an engine
+ */
+struct TransferStatistics
+{
+    /** The number of transfers */
+    jcuda_int64 transferCount;
+
+    /** The number of bytes that have been transferred */
+    jcuda_int64 bytes;
+
+    /** The time that the transfers took on the device, in milliseconds */
+    double elapsedTime;
+
+    /** The achieved bandwidth, in bytes per second */
+    double bandwidth;
+};
+
+
+class TransferEngine;
+
+/**
+ * A single transfer that was issued by a TransferEngine. The transfer
+ * is split into chunks, and an event is recorded after each chunk, so
+ * that consumers may wait for the part of the data that they need.
+ */
+class Transfer
+{
+    public:
+
+        /**
+         * Returns the engine that issued this transfer
+         */
+        TransferEngine* getEngine();
+
+        /**
+         * Returns the number of chunks of this transfer
+         */
+        int getChunkCount();
+
+        /**
+         * Returns the event that is recorded after the given chunk
+         * has been transferred, or NULL if the index is invalid
+         */
+        CUevent getChunkEvent(int chunk);
+
+        /**
+         * Lets the given stream wait until all chunks that contain the
+         * given range of bytes have been transferred
+         */
+        CUresult streamWait(CUstream stream, size_t byteOffset, size_t byteCount);
+
+        /**
+         * Returns CUDA_SUCCESS if all chunks have been transferred,
+         * and CUDA_ERROR_NOT_READY otherwise
+         */
+        CUresult query();
+
+        /**
+         * Waits until all chunks have been transferred
+         */
+        CUresult synchronize();
+
+        /**
+         * Obtains the statistics of this transfer. Returns
+         * CUDA_ERROR_NOT_READY if the transfer is not complete yet.
+         */
+        CUresult getStatistics(TransferStatistics *statistics);
+
+    private:
+        friend class TransferEngine;
+
+        Transfer(TransferEngine *engine, size_t bytes, size_t chunkSize);
+        ~Transfer();
+
+        CUresult complete();
+
+        TransferEngine *engine;
+        size_t bytes;
+        size_t chunkSize;
+        int chunkCount;
+
+        /** The events that are recorded after each chunk */
+        std::vector<CUevent> chunkEvents;
+
+        /** The timing event that is recorded before the first chunk */
+        CUevent startEvent;
+
+        /** The timing events recorded after the last chunk on each stream */
+        std::vector<CUevent> endEvents;
+
+        /** Whether the transfer is complete and the timing is known */
+        bool completed;
+        double elapsedTime;
+
+        Transfer(const Transfer&);
+        Transfer& operator=(const Transfer&);
+};
+
+
+/**
+ * An engine for transfers of large memory blocks between the host and
+ * the device. Each transfer is split into chunks that are distributed
+ * over a set of streams. Host memory that is not page-locked is copied
+ * through a ring of page-locked staging buffers, so that copying on the
+ * host overlaps with the transfers of the previous chunks. Page-locked
+ * host memory is transferred directly. Host memory that is not
+ * page-locked is only accessed while a chunk is copied from or into
+ * a staging buffer, so that a Java array is not pinned for the whole
+ * transfer.<br />
+ * <br />
+ * Transfers may be issued from several threads. The staging buffers
+ * are shared between the threads, and a thread only holds the mutex
+ * of the engine while choosing a buffer, but not while waiting for
+ * a buffer to become available. The streams, events and
+ * staging buffers belong to the context that was current when the
+ * engine was initialized, and this context must be current when the
+ * engine is used.
+ */
+class TransferEngine
+{
+    public:
+
+        /**
+         * Creates a new engine that transfers chunks of the given size
+         * using the given number of streams. The engine has to be
+         * initialized with init() before it can be used.
+         */
+        TransferEngine(size_t chunkSize, int streamCount);
+
+        /**
+         * Destroys this engine, after waiting for all pending transfers.
+         * Transfers that have not been released become invalid.
+         */
+        ~TransferEngine();
+
+        /**
+         * Creates the streams, events and staging buffers of this engine
+         */
+        CUresult init();
+
+        /**
+         * Copies the given number of bytes from the given host memory
+         * to the given device memory. If the host memory is not
+         * page-locked, then it may be re-used when this call returns.
+         * If the given stream is not NULL, then the transfer starts
+         * after all preceding work in this stream has been completed.
+         * The error code is stored in the given result. Returns false
+         * if the host memory could not be accessed, with a pending
+         * Java exception.
+         */
+        bool copyHtoD(JNIEnv *env, CUdeviceptr dst, PointerData *src, size_t bytes, CUstream stream, Transfer **transfer, CUresult *result);
+
+        /**
+         * Copies the given number of bytes from the given device memory
+         * to the given host memory. If the host memory is not
+         * page-locked, then this call returns when the data has been
+         * written into the host memory. If the given stream is not NULL,
+         * then the transfer starts after all preceding work in this
+         * stream has been completed. The error code is stored in the
+         * given result. Returns false if the host memory could not be
+         * accessed, with a pending Java exception.
+         */
+        bool copyDtoH(JNIEnv *env, PointerData *dst, CUdeviceptr src, size_t bytes, CUstream stream, Transfer **transfer, CUresult *result);
+
+        /**
+         * Releases the given transfer. If the transfer is not complete
+         * yet, then its chunks are still transferred, but the transfer
+         * will not be contained in the statistics, and its events are
+         * only re-used after the transfer is complete.
+         */
+        void releaseTransfer(Transfer *transfer);
+
+        /**
+         * Returns the cumulative statistics of all completed transfers
+         */
+        void getStatistics(TransferStatistics *statistics);
+
+    private:
+        friend class Transfer;
+
+        size_t chunkSize;
+        int streamCount;
+
+        /**
+         * Guards the members below. The streams and staging buffers are
+         * not modified after init().
+         */
+        Mutex mutex;
+
+        std::vector<CUstream> streams;
+
+        /** The ring of staging buffers, and the events recorded after their last use */
+        std::vector<void*> stagingBuffers;
+        std::vector<CUevent> stagingEvents;
+
+        /** Whether a staging buffer is currently used by a thread */
+        std::vector<bool> stagingUsed;
+        int nextStaging;
+        ConditionVariable stagingCondition;
+
+        /** Transfers that have been released before they were complete */
+        std::vector<Transfer*> retiredTransfers;
+
+        /** Unused events for chunks, and for timing */
+        std::vector<CUevent> freeEvents;
+        std::vector<CUevent> freeTimingEvents;
+
+        /** Cumulative statistics */
+        jcuda_int64 transferCount;
+        jcuda_int64 transferredBytes;
+        double elapsedTime;
+
+        CUresult createTransfer(size_t bytes, CUstream stream, Transfer **transfer);
+        CUresult finishTransfer(Transfer *transfer);
+        void abortTransfer(Transfer *transfer);
+        void destroyTransfer(Transfer *transfer);
+        CUresult obtainEvent(bool timing, CUevent *event);
+        void reclaimTransfers();
+        CUresult acquireStaging(bool wait, int *buffer);
+        void releaseStaging(int buffer);
+        bool drainStaging(JNIEnv *env, int buffer, int chunk, PointerData *dst, size_t bytes, CUresult *result);
+        void recordCompletion(Transfer *transfer, double elapsed);
+
+        TransferEngine(const TransferEngine&);
+        TransferEngine& operator=(const TransferEngine&);
+};
+
+
+#endif
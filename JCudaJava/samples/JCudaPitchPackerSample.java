@@ -0,0 +1,179 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+import static jcuda.runtime.JCuda.*;
+import static jcuda.runtime.cudaMemcpyKind.*;
+
+import java.util.Arrays;
+import java.util.Locale;
+
+import jcuda.Pointer;
+import jcuda.Sizeof;
+import jcuda.runtime.JCuda;
+
+/**
+ * A sample that compares the time of 2D copies between a padded Java
+ * array and pitched device memory, with and without the pitch packer
+ * of {@link JCuda#cudaPitchPackerEnable}. The copies are executed with
+ * {@link JCuda#cudaMemcpy2D}, and the results are verified after each
+ * run.<br />
+ * <br />
+ * The width, height and number of runs may be given as command line
+ * arguments.
+ */
+public class JCudaPitchPackerSample
+{
+    /**
+     * The number of padding elements at the end of each row of the
+     * host array
+     */
+    private static final int PADDING = 16;
+
+    /**
+     * Entry point of this sample
+     *
+     * @param args The optional width, height and number of runs
+     */
+    public static void main(String args[])
+    {
+        int width = args.length > 0 ? Integer.parseInt(args[0]) : 1000;
+        int height = args.length > 1 ? Integer.parseInt(args[1]) : 4000;
+        int runs = args.length > 2 ? Integer.parseInt(args[2]) : 10;
+
+        JCuda.setExceptionsEnabled(true);
+
+        // Create the padded host data and the pitched device memory
+        int hostPitchElements = width + PADDING;
+        float hostInput[] = new float[hostPitchElements * height];
+        for (int i = 0; i < hostInput.length; i++)
+        {
+            hostInput[i] = i;
+        }
+        float hostOutput[] = new float[hostInput.length];
+        long widthBytes = (long)width * Sizeof.FLOAT;
+        long hostPitch = (long)hostPitchElements * Sizeof.FLOAT;
+        Pointer deviceData = new Pointer();
+        long devicePitch[] = { 0 };
+        cudaMallocPitch(deviceData, devicePitch, widthBytes, height);
+
+        System.out.println("Copying " + width + "x" + height +
+            " floats, " + runs + " runs");
+
+        // Warm up, then run the copies without and with the packer
+        runCopies(deviceData, devicePitch[0], hostInput, hostOutput,
+            hostPitch, widthBytes, height, 1);
+        long directNanos = runCopies(deviceData, devicePitch[0],
+            hostInput, hostOutput, hostPitch, widthBytes, height, runs);
+        verify(hostInput, hostOutput, width, hostPitchElements, height);
+
+        cudaPitchPackerEnable(0, 0);
+        runCopies(deviceData, devicePitch[0], hostInput, hostOutput,
+            hostPitch, widthBytes, height, 1);
+        long packedNanos = runCopies(deviceData, devicePitch[0],
+            hostInput, hostOutput, hostPitch, widthBytes, height, runs);
+        verify(hostInput, hostOutput, width, hostPitchElements, height);
+
+        long copies[] = { 0 };
+        long bytes[] = { 0 };
+        long nanos[] = { 0 };
+        cudaPitchPackerGetStatistics(copies, bytes, nanos);
+        cudaPitchPackerDisable();
+
+        System.out.println(String.format(Locale.ENGLISH,
+            "Without packer: %8.3f ms per run", directNanos / 1e6 / runs));
+        System.out.println(String.format(Locale.ENGLISH,
+            "With packer:    %8.3f ms per run", packedNanos / 1e6 / runs));
+        System.out.println(String.format(Locale.ENGLISH,
+            "Packer: %d copies, %d bytes, %.3f ms packing",
+            copies[0], bytes[0], nanos[0] / 1e6));
+
+        cudaFree(deviceData);
+    }
+
+    /**
+     * Copies the given input to the device and back into the given
+     * output the given number of times, and returns the time that
+     * this took, in nanoseconds
+     *
+     * @param deviceData The device memory
+     * @param devicePitch The pitch of the device memory
+     * @param hostInput The host input
+     * @param hostOutput The host output
+     * @param hostPitch The pitch of the host memory, in bytes
+     * @param widthBytes The width of the copies, in bytes
+     * @param height The height of the copies
+     * @param runs The number of runs
+     * @return The duration, in nanoseconds
+     */
+    private static long runCopies(Pointer deviceData, long devicePitch,
+        float hostInput[], float hostOutput[], long hostPitch,
+        long widthBytes, int height, int runs)
+    {
+        cudaDeviceSynchronize();
+        long before = System.nanoTime();
+        for (int i = 0; i < runs; i++)
+        {
+            cudaMemcpy2D(deviceData, devicePitch, Pointer.to(hostInput),
+                hostPitch, widthBytes, height, cudaMemcpyHostToDevice);
+            cudaMemcpy2D(Pointer.to(hostOutput), hostPitch, deviceData,
+                devicePitch, widthBytes, height, cudaMemcpyDeviceToHost);
+        }
+        cudaDeviceSynchronize();
+        return System.nanoTime() - before;
+    }
+
+    /**
+     * Verifies that the rows of the given output are equal to the
+     * rows of the given input, and clears the output
+     *
+     * @param hostInput The host input
+     * @param hostOutput The host output
+     * @param width The width of the rows, in elements
+     * @param hostPitchElements The pitch of the rows, in elements
+     * @param height The number of rows
+     * @throws IllegalStateException If the output is not correct
+     */
+    private static void verify(float hostInput[], float hostOutput[],
+        int width, int hostPitchElements, int height)
+    {
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                int index = y * hostPitchElements + x;
+                if (hostInput[index] != hostOutput[index])
+                {
+                    throw new IllegalStateException(
+                        "Mismatch at (" + x + "," + y + "): Expected " +
+                        hostInput[index] + ", but found " +
+                        hostOutput[index]);
+                }
+            }
+        }
+        Arrays.fill(hostOutput, 0.0f);
+    }
+}
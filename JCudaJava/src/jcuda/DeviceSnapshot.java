@@ -0,0 +1,249 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+package jcuda;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+/**
+ * Base class for the snapshots of the attributes, the total memory and
+ * the name of all devices, for the driver and the runtime API. The
+ * snapshot is created once in native code, when it is first requested,
+ * and is afterwards shared by all callers, so that querying device
+ * properties does not require one native call per attribute.<br />
+ * <br />
+ * The data is available as a read-only direct buffer in native byte
+ * order. It starts with a header of {@link #HEADER_SIZE} bytes,
+ * consisting of 4 ints:
+ * <pre>
+ *   0: The version of the layout (currently 1)
+ *   4: The number of devices
+ *   8: The number of attributes per device ({@link #ATTRIBUTE_COUNT})
+ *  12: The number of bytes per device record
+ * </pre>
+ * It is followed by one record for each device, with the offsets
+ * being relative to the start of the record:
+ * <pre>
+ *   0: The total memory of the device, in bytes, as a long
+ *   8: The name of the device, as a 0-terminated string of at most
+ *      {@link #NAME_LENGTH} bytes
+ * 264: The values of the attributes 0 to {@link #ATTRIBUTE_COUNT}-1,
+ *      as ints. The value of an attribute that could not be queried is 0.
+ * </pre>
+ * <br />
+ * <u>Note:</u> This is not a CUDA type, but a JCuda-specific extension.
+ *
+ * @see jcuda.driver.CUdeviceSnapshot
+ * @see jcuda.runtime.cudaDeviceSnapshot
+ */
+public abstract class DeviceSnapshot
+{
+    /**
+     * The size of the header, in bytes
+     */
+    public static final int HEADER_SIZE = 16;
+
+    /**
+     * The offset of the total memory inside a device record
+     */
+    public static final int TOTAL_MEM_OFFSET = 0;
+
+    /**
+     * The offset of the name inside a device record
+     */
+    public static final int NAME_OFFSET = 8;
+
+    /**
+     * The maximum length of the name, including the terminating 0
+     */
+    public static final int NAME_LENGTH = 256;
+
+    /**
+     * The offset of the attribute values inside a device record
+     */
+    public static final int ATTRIBUTES_OFFSET = 264;
+
+    /**
+     * The number of attributes that are stored for each device
+     */
+    public static final int ATTRIBUTE_COUNT = 128;
+
+    /**
+     * The buffer that is set in native code
+     */
+    private ByteBuffer buffer;
+
+    /**
+     * The read-only view on the buffer, in native byte order. It is
+     * created when it is first needed. Threads that see it as null
+     * create equivalent views, so no lock is required.
+     */
+    private volatile ByteBuffer view;
+
+    /**
+     * Creates a new, uninitialized DeviceSnapshot
+     */
+    protected DeviceSnapshot()
+    {
+    }
+
+    /**
+     * Returns a read-only buffer containing the data of this snapshot,
+     * in native byte order, or <code>null</code> if this snapshot was
+     * not initialized yet. The position and limit of the returned
+     * buffer may be modified by the caller.
+     *
+     * @return The buffer
+     */
+    public ByteBuffer getBuffer()
+    {
+        ByteBuffer v = getView();
+        if (v == null)
+        {
+            return null;
+        }
+        return v.duplicate().order(ByteOrder.nativeOrder());
+    }
+
+    /**
+     * Returns the number of devices in this snapshot
+     *
+     * @return The number of devices
+     */
+    public int getDeviceCount()
+    {
+        ByteBuffer v = getView();
+        if (v == null)
+        {
+            return 0;
+        }
+        return v.getInt(4);
+    }
+
+    /**
+     * Returns the value of the given attribute of the given device
+     *
+     * @param device The device
+     * @param attribute The attribute
+     * @return The attribute value
+     * @throws IllegalArgumentException If the device or the attribute
+     * is not valid
+     */
+    public int getAttribute(int device, int attribute)
+    {
+        if (attribute < 0 || attribute >= ATTRIBUTE_COUNT)
+        {
+            throw new IllegalArgumentException(
+                "Invalid attribute: "+attribute);
+        }
+        ByteBuffer v = getView();
+        return v.getInt(
+            recordOffset(v, device) + ATTRIBUTES_OFFSET + attribute * 4);
+    }
+
+    /**
+     * Returns the total memory of the given device, in bytes
+     *
+     * @param device The device
+     * @return The total memory
+     * @throws IllegalArgumentException If the device is not valid
+     */
+    public long getTotalMem(int device)
+    {
+        ByteBuffer v = getView();
+        return v.getLong(recordOffset(v, device) + TOTAL_MEM_OFFSET);
+    }
+
+    /**
+     * Returns the name of the given device
+     *
+     * @param device The device
+     * @return The name
+     * @throws IllegalArgumentException If the device is not valid
+     */
+    public String getName(int device)
+    {
+        ByteBuffer v = getView();
+        int offset = recordOffset(v, device) + NAME_OFFSET;
+        byte bytes[] = new byte[NAME_LENGTH];
+        int length = 0;
+        while (length < NAME_LENGTH)
+        {
+            byte b = v.get(offset + length);
+            if (b == 0)
+            {
+                break;
+            }
+            bytes[length] = b;
+            length++;
+        }
+        return new String(bytes, 0, length);
+    }
+
+    /**
+     * Returns the offset of the record for the given device in the
+     * given view
+     *
+     * @param v The view
+     * @param device The device
+     * @return The offset
+     * @throws IllegalArgumentException If the device is not valid
+     */
+    private static int recordOffset(ByteBuffer v, int device)
+    {
+        if (v == null || device < 0 || device >= v.getInt(4))
+        {
+            throw new IllegalArgumentException(
+                "Invalid device: "+device);
+        }
+        int recordSize = v.getInt(12);
+        return HEADER_SIZE + device * recordSize;
+    }
+
+    /**
+     * Returns the read-only view on the buffer, creating it if
+     * necessary
+     *
+     * @return The view, or <code>null</code>
+     */
+    private ByteBuffer getView()
+    {
+        ByteBuffer v = view;
+        if (v == null)
+        {
+            ByteBuffer b = buffer;
+            if (b == null)
+            {
+                return null;
+            }
+            v = b.asReadOnlyBuffer().order(ByteOrder.nativeOrder());
+            view = v;
+        }
+        return v;
+    }
+}
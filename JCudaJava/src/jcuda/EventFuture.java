@@ -0,0 +1,265 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+package jcuda;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.Executor;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.ThreadFactory;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.TimeoutException;
+
+/**
+ * A future that is completed when a recorded event has been completed
+ * on the device. It is obtained by registering an event with
+ * {@link jcuda.driver.JCudaDriver#cuEventRegisterFuture} or
+ * {@link jcuda.runtime.JCuda#cudaEventRegisterFuture}. The completion
+ * is detected by a single native thread that polls all registered
+ * events, so no thread has to block while waiting for the device.
+ * Listeners are not called by this thread, but by an executor, so
+ * that a slow listener does not delay the completion of other
+ * futures.<br />
+ * <br />
+ * The result of the future is the result of the event query that
+ * detected the completion: CUDA_SUCCESS / cudaSuccess, or an error
+ * code. The future can not be cancelled.<br />
+ * <br />
+ * <u>Note:</u> This is not a CUDA type, but a JCuda-specific extension.
+ */
+public final class EventFuture implements Future<Integer>
+{
+    /**
+     * The executor that calls the listeners for which no executor
+     * was given. It uses daemon threads, which are created on demand
+     * and terminate when they have been idle for a while.
+     */
+    private static final ExecutorService LISTENER_EXECUTOR =
+        Executors.newCachedThreadPool(new ThreadFactory()
+        {
+            public Thread newThread(Runnable runnable)
+            {
+                Thread thread =
+                    new Thread(runnable, "JCuda EventFuture listener");
+                thread.setDaemon(true);
+                return thread;
+            }
+        });
+
+    /**
+     * A listener and the executor that it is called with
+     */
+    private static final class Registration
+    {
+        final EventFutureListener listener;
+        final Executor executor;
+
+        Registration(EventFutureListener listener, Executor executor)
+        {
+            this.listener = listener;
+            this.executor = executor;
+        }
+    }
+
+    /**
+     * Whether the event has been completed
+     */
+    private boolean done = false;
+
+    /**
+     * The result of the event query
+     */
+    private int result = 0;
+
+    /**
+     * The listeners that are informed about the completion
+     */
+    private List<Registration> registrations = null;
+
+    /**
+     * Creates a new future, which may be registered for one event
+     */
+    public EventFuture()
+    {
+    }
+
+    /**
+     * Adds the given listener, which will be informed when the event
+     * has been completed. The listener is called by a shared pool of
+     * daemon threads, so it does not delay the completion of other
+     * futures. If the event has already been completed, then the
+     * listener is passed to this pool immediately.
+     *
+     * @param listener The listener
+     */
+    public void addListener(EventFutureListener listener)
+    {
+        addListener(listener, LISTENER_EXECUTOR);
+    }
+
+    /**
+     * Adds the given listener, which will be informed when the event
+     * has been completed, by a task that is passed to the given
+     * executor. The executor should not block, because it is called
+     * by the native polling thread. If the event has already been
+     * completed, then the task is passed to the executor immediately.
+     *
+     * @param listener The listener
+     * @param executor The executor
+     */
+    public void addListener(EventFutureListener listener, Executor executor)
+    {
+        if (listener == null)
+        {
+            throw new NullPointerException("The listener is null");
+        }
+        if (executor == null)
+        {
+            throw new NullPointerException("The executor is null");
+        }
+        Registration registration = new Registration(listener, executor);
+        int currentResult;
+        synchronized (this)
+        {
+            if (!done)
+            {
+                if (registrations == null)
+                {
+                    registrations = new ArrayList<Registration>();
+                }
+                registrations.add(registration);
+                return;
+            }
+            currentResult = result;
+        }
+        dispatch(registration, currentResult);
+    }
+
+    /**
+     * Returns <code>false</code>: Work on the device can not be cancelled.
+     */
+    public boolean cancel(boolean mayInterruptIfRunning)
+    {
+        return false;
+    }
+
+    /**
+     * Returns <code>false</code>: Work on the device can not be cancelled.
+     */
+    public boolean isCancelled()
+    {
+        return false;
+    }
+
+    public synchronized boolean isDone()
+    {
+        return done;
+    }
+
+    public synchronized Integer get() throws InterruptedException
+    {
+        while (!done)
+        {
+            wait();
+        }
+        return result;
+    }
+
+    public synchronized Integer get(long timeout, TimeUnit unit)
+        throws InterruptedException, TimeoutException
+    {
+        long remainingNanos = unit.toNanos(timeout);
+        long deadline = System.nanoTime() + remainingNanos;
+        while (!done)
+        {
+            if (remainingNanos <= 0)
+            {
+                throw new TimeoutException();
+            }
+            TimeUnit.NANOSECONDS.timedWait(this, remainingNanos);
+            remainingNanos = deadline - System.nanoTime();
+        }
+        return result;
+    }
+
+    /**
+     * Called by the native polling thread when the event has been
+     * completed, with the result of the event query
+     *
+     * @param result The result
+     */
+    private void complete(int result)
+    {
+        List<Registration> currentRegistrations;
+        synchronized (this)
+        {
+            this.done = true;
+            this.result = result;
+            currentRegistrations = registrations;
+            registrations = null;
+            notifyAll();
+        }
+        if (currentRegistrations != null)
+        {
+            for (Registration registration : currentRegistrations)
+            {
+                dispatch(registration, result);
+            }
+        }
+    }
+
+    /**
+     * Passes a task to the executor of the given registration, which
+     * informs its listener about the given result
+     *
+     * @param registration The registration
+     * @param result The result
+     */
+    private void dispatch(final Registration registration, final int result)
+    {
+        final EventFuture future = this;
+        registration.executor.execute(new Runnable()
+        {
+            public void run()
+            {
+                registration.listener.completed(future, result);
+            }
+        });
+    }
+
+    @Override
+    public String toString()
+    {
+        synchronized (this)
+        {
+            return "EventFuture["+(done ? "result="+result : "pending")+"]";
+        }
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+package jcuda.driver;
+
+/**
+ * Interface for callbacks that release device memory when the memory
+ * governor detects memory pressure, e.g. by dropping entries of an
+ * application-level cache.<br />
+ * <br />
+ * <u>Note:</u> This is not a CUDA type, but a JCuda-specific extension.
+ *
+ * @see JCudaDriver#cuMemGovernorAddEvictionCallback(CUevictionCallback, Object, int)
+ */
+public interface CUevictionCallback
+{
+    /**
+     * The function that will be called by the thread that is about to
+     * allocate memory on the given device, while the context of this
+     * device is current. The implementation should try to release at
+     * least the given number of bytes of device memory. Memory that is
+     * allocated in this method is not subject to the memory governor.
+     *
+     * @param device The device whose memory should be released
+     * @param bytes The number of bytes that should be released
+     * @param userData User parameter provided at registration.
+     * @return The number of bytes that have been released, or 0
+     * if this is not known
+     */
+    long evict(int device, long bytes, Object userData);
+}
@@ -42,6 +42,20 @@ import jcuda.NativePointerObject;
  */
 public class CUfunction extends NativePointerObject
 {
+    /**
+     * The future of the module that this function is looked up in when
+     * it is first used, if it was obtained with
+     * {@link JCudaDriver#cuModuleFutureGetFunction} and was not used
+     * yet. This is set and cleared by the native code.
+     */
+    private CUmoduleFuture future;
+
+    /**
+     * The name of the function that is looked up in the module of the
+     * future. This is set and cleared by the native code.
+     */
+    private String name;
+
     /**
      * Creates a new, uninitialized CUfunction
      */
@@ -0,0 +1,73 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+package jcuda.driver;
+
+/**
+ * The placement modes for page-locked host memory.<br />
+ * <br />
+ * <u>Note:</u> This is not a CUDA type, but a JCuda-specific extension.
+ *
+ * @see jcuda.driver.JCudaDriver#cuMemHostSetPlacement
+ */
+public class CUhostPlacement
+{
+    /**
+     * The memory is allocated by the driver
+     */
+    public static final int CU_HOST_PLACEMENT_DEFAULT = 0;
+
+    /**
+     * The memory is allocated on the NUMA node of the device
+     * of the current context
+     */
+    public static final int CU_HOST_PLACEMENT_DEVICE = 1;
+
+    /**
+     * Returns the String identifying the given CUhostPlacement
+     *
+     * @param n The CUhostPlacement
+     * @return The String identifying the given CUhostPlacement
+     */
+    public static String stringFor(int n)
+    {
+        switch (n)
+        {
+            case CU_HOST_PLACEMENT_DEFAULT: return "CU_HOST_PLACEMENT_DEFAULT";
+            case CU_HOST_PLACEMENT_DEVICE: return "CU_HOST_PLACEMENT_DEVICE";
+        }
+        return "INVALID CUhostPlacement: "+n;
+    }
+
+    /**
+     * Private constructor to prevent instantiation.
+     */
+    private CUhostPlacement()
+    {
+    }
+
+}
@@ -0,0 +1,66 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+package jcuda.driver;
+
+import jcuda.NativePointerObject;
+
+/**
+ * A registry for IPC memory handles, which deduplicates opened handles
+ * and allows publishing handles to other processes on the same node
+ * via a shared memory segment.<br />
+ * <br />
+ * <u>Note:</u> This is not a CUDA type, but a JCuda-specific extension.
+ *
+ * @see jcuda.driver.JCudaDriver#cuIpcRegistryCreate
+ * @see jcuda.driver.JCudaDriver#cuIpcRegistryOpenMemHandle
+ * @see jcuda.driver.JCudaDriver#cuIpcRegistryPublish
+ * @see jcuda.driver.JCudaDriver#cuIpcRegistryOpen
+ * @see jcuda.driver.JCudaDriver#cuIpcRegistryDestroy
+ */
+public class CUipcRegistry extends NativePointerObject
+{
+    /**
+     * Creates a new, uninitialized CUipcRegistry
+     */
+    public CUipcRegistry()
+    {
+    }
+
+    /**
+     * Returns a String representation of this object.
+     *
+     * @return A String representation of this object.
+     */
+    @Override
+    public String toString()
+    {
+        return "CUipcRegistry["+
+            "nativePointer=0x"+Long.toHexString(getNativePointer())+"]";
+    }
+
+}
@@ -0,0 +1,620 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+package jcuda.driver;
+
+import jcuda.Pointer;
+
+/**
+ * A descriptor for 3D memory copies, with the same fields as a
+ * {@link CUDA_MEMCPY3D}. Other than a CUDA_MEMCPY3D, the fields of this
+ * descriptor are stored in a native structure that is passed to CUDA
+ * as it is. Setting the numeric fields does not involve any native
+ * call, and the copy functions do not have to read the fields with
+ * JNI calls. This makes it cheap to issue many copies that differ
+ * only in a few fields, e.g. the offsets of tiles in an image.<br />
+ * <br />
+ * The pointer fields are set with a native call, and store the
+ * address that the pointer refers to at the time of the call. Host
+ * pointers must therefore refer to native memory, e.g. page-locked
+ * memory or a direct buffer.<br />
+ * <br />
+ * The descriptor has to be initialized with
+ * {@link JCudaDriver#cuMemcpyDescriptorCreate}, and must be
+ * destroyed with {@link JCudaDriver#cuMemcpyDescriptorDestroy}.<br />
+ * <br />
+ * <u>Note:</u> This is not a CUDA type, but a JCuda-specific extension.
+ */
+public class CUmemcpy3DDescriptor extends CUmemcpyDescriptor
+{
+    /**
+     * The index of the field for the source X offset, in bytes
+     */
+    public static final int SRC_X_IN_BYTES = 0;
+
+    /**
+     * The index of the field for the source Y offset
+     */
+    public static final int SRC_Y = 1;
+
+    /**
+     * The index of the field for the source Z offset
+     */
+    public static final int SRC_Z = 2;
+
+    /**
+     * The index of the field for the source level of detail
+     */
+    public static final int SRC_LOD = 3;
+
+    /**
+     * The index of the field for the source memory type (CUmemorytype)
+     */
+    public static final int SRC_MEMORY_TYPE = 4;
+
+    /**
+     * The index of the field for the source host pointer
+     */
+    public static final int SRC_HOST = 5;
+
+    /**
+     * The index of the field for the source device pointer
+     */
+    public static final int SRC_DEVICE = 6;
+
+    /**
+     * The index of the field for the source array
+     */
+    public static final int SRC_ARRAY = 7;
+
+    /**
+     * The index of the field for the source pitch, in bytes
+     */
+    public static final int SRC_PITCH = 8;
+
+    /**
+     * The index of the field for the source height
+     */
+    public static final int SRC_HEIGHT = 9;
+
+    /**
+     * The index of the field for the destination X offset, in bytes
+     */
+    public static final int DST_X_IN_BYTES = 10;
+
+    /**
+     * The index of the field for the destination Y offset
+     */
+    public static final int DST_Y = 11;
+
+    /**
+     * The index of the field for the destination Z offset
+     */
+    public static final int DST_Z = 12;
+
+    /**
+     * The index of the field for the destination level of detail
+     */
+    public static final int DST_LOD = 13;
+
+    /**
+     * The index of the field for the destination memory type (CUmemorytype)
+     */
+    public static final int DST_MEMORY_TYPE = 14;
+
+    /**
+     * The index of the field for the destination host pointer
+     */
+    public static final int DST_HOST = 15;
+
+    /**
+     * The index of the field for the destination device pointer
+     */
+    public static final int DST_DEVICE = 16;
+
+    /**
+     * The index of the field for the destination array
+     */
+    public static final int DST_ARRAY = 17;
+
+    /**
+     * The index of the field for the destination pitch, in bytes
+     */
+    public static final int DST_PITCH = 18;
+
+    /**
+     * The index of the field for the destination height
+     */
+    public static final int DST_HEIGHT = 19;
+
+    /**
+     * The index of the field for the width of the copy, in bytes
+     */
+    public static final int WIDTH_IN_BYTES = 20;
+
+    /**
+     * The index of the field for the height of the copy
+     */
+    public static final int HEIGHT = 21;
+
+    /**
+     * The index of the field for the depth of the copy
+     */
+    public static final int DEPTH = 22;
+
+    /**
+     * Creates a new, uninitialized CUmemcpy3DDescriptor
+     */
+    public CUmemcpy3DDescriptor()
+    {
+    }
+
+    @Override
+    int getDescriptorType()
+    {
+        return MEMCPY_3D;
+    }
+
+    /**
+     * Set the source X offset, in bytes
+     *
+     * @param srcXInBytes The value
+     */
+    public void setSrcXInBytes(long srcXInBytes)
+    {
+        putSize(SRC_X_IN_BYTES, srcXInBytes);
+    }
+
+    /**
+     * Returns the source X offset, in bytes
+     *
+     * @return The value
+     */
+    public long getSrcXInBytes()
+    {
+        return getSize(SRC_X_IN_BYTES);
+    }
+
+    /**
+     * Set the source Y offset
+     *
+     * @param srcY The value
+     */
+    public void setSrcY(long srcY)
+    {
+        putSize(SRC_Y, srcY);
+    }
+
+    /**
+     * Returns the source Y offset
+     *
+     * @return The value
+     */
+    public long getSrcY()
+    {
+        return getSize(SRC_Y);
+    }
+
+    /**
+     * Set the source Z offset
+     *
+     * @param srcZ The value
+     */
+    public void setSrcZ(long srcZ)
+    {
+        putSize(SRC_Z, srcZ);
+    }
+
+    /**
+     * Returns the source Z offset
+     *
+     * @return The value
+     */
+    public long getSrcZ()
+    {
+        return getSize(SRC_Z);
+    }
+
+    /**
+     * Set the source level of detail
+     *
+     * @param srcLOD The value
+     */
+    public void setSrcLOD(long srcLOD)
+    {
+        putSize(SRC_LOD, srcLOD);
+    }
+
+    /**
+     * Returns the source level of detail
+     *
+     * @return The value
+     */
+    public long getSrcLOD()
+    {
+        return getSize(SRC_LOD);
+    }
+
+    /**
+     * Set the source memory type (CUmemorytype)
+     *
+     * @param srcMemoryType The value
+     */
+    public void setSrcMemoryType(int srcMemoryType)
+    {
+        putInt(SRC_MEMORY_TYPE, srcMemoryType);
+    }
+
+    /**
+     * Returns the source memory type (CUmemorytype)
+     *
+     * @return The value
+     */
+    public int getSrcMemoryType()
+    {
+        return getInt(SRC_MEMORY_TYPE);
+    }
+
+    /**
+     * Set the source host pointer. This stores the address that the given
+     * object refers to, and requires a native call.
+     *
+     * @param srcHost The value. May be <code>null</code>.
+     */
+    public void setSrcHost(Pointer srcHost)
+    {
+        JCudaDriver.cuMemcpyDescriptorSetPointer(this, SRC_HOST, srcHost);
+    }
+
+    /**
+     * Set the source device pointer. This stores the address that the given
+     * object refers to, and requires a native call.
+     *
+     * @param srcDevice The value. May be <code>null</code>.
+     */
+    public void setSrcDevice(CUdeviceptr srcDevice)
+    {
+        JCudaDriver.cuMemcpyDescriptorSetPointer(this, SRC_DEVICE, srcDevice);
+    }
+
+    /**
+     * Set the source array. This stores the address that the given
+     * object refers to, and requires a native call.
+     *
+     * @param srcArray The value. May be <code>null</code>.
+     */
+    public void setSrcArray(CUarray srcArray)
+    {
+        JCudaDriver.cuMemcpyDescriptorSetPointer(this, SRC_ARRAY, srcArray);
+    }
+
+    /**
+     * Set the source pitch, in bytes
+     *
+     * @param srcPitch The value
+     */
+    public void setSrcPitch(long srcPitch)
+    {
+        putSize(SRC_PITCH, srcPitch);
+    }
+
+    /**
+     * Returns the source pitch, in bytes
+     *
+     * @return The value
+     */
+    public long getSrcPitch()
+    {
+        return getSize(SRC_PITCH);
+    }
+
+    /**
+     * Set the source height
+     *
+     * @param srcHeight The value
+     */
+    public void setSrcHeight(long srcHeight)
+    {
+        putSize(SRC_HEIGHT, srcHeight);
+    }
+
+    /**
+     * Returns the source height
+     *
+     * @return The value
+     */
+    public long getSrcHeight()
+    {
+        return getSize(SRC_HEIGHT);
+    }
+
+    /**
+     * Set the destination X offset, in bytes
+     *
+     * @param dstXInBytes The value
+     */
+    public void setDstXInBytes(long dstXInBytes)
+    {
+        putSize(DST_X_IN_BYTES, dstXInBytes);
+    }
+
+    /**
+     * Returns the destination X offset, in bytes
+     *
+     * @return The value
+     */
+    public long getDstXInBytes()
+    {
+        return getSize(DST_X_IN_BYTES);
+    }
+
+    /**
+     * Set the destination Y offset
+     *
+     * @param dstY The value
+     */
+    public void setDstY(long dstY)
+    {
+        putSize(DST_Y, dstY);
+    }
+
+    /**
+     * Returns the destination Y offset
+     *
+     * @return The value
+     */
+    public long getDstY()
+    {
+        return getSize(DST_Y);
+    }
+
+    /**
+     * Set the destination Z offset
+     *
+     * @param dstZ The value
+     */
+    public void setDstZ(long dstZ)
+    {
+        putSize(DST_Z, dstZ);
+    }
+
+    /**
+     * Returns the destination Z offset
+     *
+     * @return The value
+     */
+    public long getDstZ()
+    {
+        return getSize(DST_Z);
+    }
+
+    /**
+     * Set the destination level of detail
+     *
+     * @param dstLOD The value
+     */
+    public void setDstLOD(long dstLOD)
+    {
+        putSize(DST_LOD, dstLOD);
+    }
+
+    /**
+     * Returns the destination level of detail
+     *
+     * @return The value
+     */
+    public long getDstLOD()
+    {
+        return getSize(DST_LOD);
+    }
+
+    /**
+     * Set the destination memory type (CUmemorytype)
+     *
+     * @param dstMemoryType The value
+     */
+    public void setDstMemoryType(int dstMemoryType)
+    {
+        putInt(DST_MEMORY_TYPE, dstMemoryType);
+    }
+
+    /**
+     * Returns the destination memory type (CUmemorytype)
+     *
+     * @return The value
+     */
+    public int getDstMemoryType()
+    {
+        return getInt(DST_MEMORY_TYPE);
+    }
+
+    /**
+     * Set the destination host pointer. This stores the address that the given
+     * object refers to, and requires a native call.
+     *
+     * @param dstHost The value. May be <code>null</code>.
+     */
+    public void setDstHost(Pointer dstHost)
+    {
+        JCudaDriver.cuMemcpyDescriptorSetPointer(this, DST_HOST, dstHost);
+    }
+
+    /**
+     * Set the destination device pointer. This stores the address that the given
+     * object refers to, and requires a native call.
+     *
+     * @param dstDevice The value. May be <code>null</code>.
+     */
+    public void setDstDevice(CUdeviceptr dstDevice)
+    {
+        JCudaDriver.cuMemcpyDescriptorSetPointer(this, DST_DEVICE, dstDevice);
+    }
+
+    /**
+     * Set the destination array. This stores the address that the given
+     * object refers to, and requires a native call.
+     *
+     * @param dstArray The value. May be <code>null</code>.
+     */
+    public void setDstArray(CUarray dstArray)
+    {
+        JCudaDriver.cuMemcpyDescriptorSetPointer(this, DST_ARRAY, dstArray);
+    }
+
+    /**
+     * Set the destination pitch, in bytes
+     *
+     * @param dstPitch The value
+     */
+    public void setDstPitch(long dstPitch)
+    {
+        putSize(DST_PITCH, dstPitch);
+    }
+
+    /**
+     * Returns the destination pitch, in bytes
+     *
+     * @return The value
+     */
+    public long getDstPitch()
+    {
+        return getSize(DST_PITCH);
+    }
+
+    /**
+     * Set the destination height
+     *
+     * @param dstHeight The value
+     */
+    public void setDstHeight(long dstHeight)
+    {
+        putSize(DST_HEIGHT, dstHeight);
+    }
+
+    /**
+     * Returns the destination height
+     *
+     * @return The value
+     */
+    public long getDstHeight()
+    {
+        return getSize(DST_HEIGHT);
+    }
+
+    /**
+     * Set the width of the copy, in bytes
+     *
+     * @param WidthInBytes The value
+     */
+    public void setWidthInBytes(long WidthInBytes)
+    {
+        putSize(WIDTH_IN_BYTES, WidthInBytes);
+    }
+
+    /**
+     * Returns the width of the copy, in bytes
+     *
+     * @return The value
+     */
+    public long getWidthInBytes()
+    {
+        return getSize(WIDTH_IN_BYTES);
+    }
+
+    /**
+     * Set the height of the copy
+     *
+     * @param Height The value
+     */
+    public void setHeight(long Height)
+    {
+        putSize(HEIGHT, Height);
+    }
+
+    /**
+     * Returns the height of the copy
+     *
+     * @return The value
+     */
+    public long getHeight()
+    {
+        return getSize(HEIGHT);
+    }
+
+    /**
+     * Set the depth of the copy
+     *
+     * @param Depth The value
+     */
+    public void setDepth(long Depth)
+    {
+        putSize(DEPTH, Depth);
+    }
+
+    /**
+     * Returns the depth of the copy
+     *
+     * @return The value
+     */
+    public long getDepth()
+    {
+        return getSize(DEPTH);
+    }
+
+    /**
+     * Returns a String representation of this object.
+     *
+     * @return A String representation of this object.
+     */
+    @Override
+    public String toString()
+    {
+        if (!isInitialized())
+        {
+            return "CUmemcpy3DDescriptor[uninitialized]";
+        }
+        return "CUmemcpy3DDescriptor["+
+            "srcXInBytes="+getSrcXInBytes()+","+
+            "srcY="+getSrcY()+","+
+            "srcZ="+getSrcZ()+","+
+            "srcLOD="+getSrcLOD()+","+
+            "srcMemoryType="+CUmemorytype.stringFor(getSrcMemoryType())+","+
+            "srcPitch="+getSrcPitch()+","+
+            "srcHeight="+getSrcHeight()+","+
+            "dstXInBytes="+getDstXInBytes()+","+
+            "dstY="+getDstY()+","+
+            "dstZ="+getDstZ()+","+
+            "dstLOD="+getDstLOD()+","+
+            "dstMemoryType="+CUmemorytype.stringFor(getDstMemoryType())+","+
+            "dstPitch="+getDstPitch()+","+
+            "dstHeight="+getDstHeight()+","+
+            "WidthInBytes="+getWidthInBytes()+","+
+            "Height="+getHeight()+","+
+            "Depth="+getDepth()+"]";
+    }
+
+}
@@ -0,0 +1,187 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+package jcuda.driver;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+import jcuda.NativePointerObject;
+
+/**
+ * Base class for memory copy descriptors whose fields are stored in
+ * a native structure. The structure is accessed via a direct buffer
+ * that is created in native code, together with the offsets of the
+ * fields, so that the fields may be read and written without native
+ * calls.<br />
+ * <br />
+ * <u>Note:</u> This is not a CUDA type, but a JCuda-specific extension.
+ *
+ * @see jcuda.driver.CUmemcpy2DDescriptor
+ * @see jcuda.driver.CUmemcpy3DDescriptor
+ * @see jcuda.driver.CUmemcpy3DPeerDescriptor
+ * @see jcuda.driver.JCudaDriver#cuMemcpyDescriptorCreate
+ * @see jcuda.driver.JCudaDriver#cuMemcpyDescriptorDestroy
+ */
+public abstract class CUmemcpyDescriptor extends NativePointerObject
+{
+    /**
+     * The type of a {@link CUmemcpy2DDescriptor}
+     */
+    static final int MEMCPY_2D = 0;
+
+    /**
+     * The type of a {@link CUmemcpy3DDescriptor}
+     */
+    static final int MEMCPY_3D = 1;
+
+    /**
+     * The type of a {@link CUmemcpy3DPeerDescriptor}
+     */
+    static final int MEMCPY_3D_PEER = 2;
+
+    /**
+     * The buffer for the native structure, which is set in native code
+     */
+    private ByteBuffer buffer;
+
+    /**
+     * The byte offsets of the fields in the native structure, which
+     * are set in native code
+     */
+    private int offsets[];
+
+    /**
+     * The size of a size_t value, which is set in native code
+     */
+    private int sizeTSize;
+
+    /**
+     * Creates a new, uninitialized CUmemcpyDescriptor
+     */
+    CUmemcpyDescriptor()
+    {
+    }
+
+    /**
+     * Returns the type of this descriptor, which determines the
+     * native structure
+     *
+     * @return The type
+     */
+    abstract int getDescriptorType();
+
+    /**
+     * Returns whether this descriptor has been initialized
+     * and not been destroyed yet
+     *
+     * @return Whether this descriptor is initialized
+     */
+    public boolean isInitialized()
+    {
+        return buffer != null;
+    }
+
+    /**
+     * Returns the buffer for the native structure, in native byte order
+     *
+     * @return The buffer
+     * @throws IllegalStateException If this descriptor is not initialized
+     */
+    private ByteBuffer getBuffer()
+    {
+        ByteBuffer b = buffer;
+        if (b == null)
+        {
+            throw new IllegalStateException(
+                "The descriptor has not been initialized");
+        }
+        if (b.order() != ByteOrder.nativeOrder())
+        {
+            b.order(ByteOrder.nativeOrder());
+        }
+        return b;
+    }
+
+    /**
+     * Set the size_t field with the given index
+     *
+     * @param field The field index
+     * @param value The value
+     */
+    void putSize(int field, long value)
+    {
+        ByteBuffer b = getBuffer();
+        if (sizeTSize == 8)
+        {
+            b.putLong(offsets[field], value);
+        }
+        else
+        {
+            b.putInt(offsets[field], (int)value);
+        }
+    }
+
+    /**
+     * Returns the value of the size_t field with the given index
+     *
+     * @param field The field index
+     * @return The value
+     */
+    long getSize(int field)
+    {
+        ByteBuffer b = getBuffer();
+        if (sizeTSize == 8)
+        {
+            return b.getLong(offsets[field]);
+        }
+        return b.getInt(offsets[field]) & 0xFFFFFFFFL;
+    }
+
+    /**
+     * Set the int field with the given index
+     *
+     * @param field The field index
+     * @param value The value
+     */
+    void putInt(int field, int value)
+    {
+        getBuffer().putInt(offsets[field], value);
+    }
+
+    /**
+     * Returns the value of the int field with the given index
+     *
+     * @param field The field index
+     * @return The value
+     */
+    int getInt(int field)
+    {
+        return getBuffer().getInt(offsets[field]);
+    }
+
+}
@@ -0,0 +1,161 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+package jcuda.driver;
+
+/**
+ * The occupancy for a launch configuration of a function, as computed
+ * by {@link JCudaDriver#cuOccupancyCalculate},
+ * {@link JCudaDriver#cuOccupancyRecommend} or
+ * {@link JCudaDriver#cuOccupancyAutotune}.<br />
+ * <br />
+ * <u>Note:</u> This is not a CUDA type, but a JCuda-specific extension.
+ */
+public class CUoccupancy
+{
+    /**
+     * The limiting factor is not known
+     */
+    public static final int LIMIT_NONE = 0;
+
+    /**
+     * The block size exceeds the limits of the device or the function
+     */
+    public static final int LIMIT_BLOCK_SIZE = 1;
+
+    /**
+     * The number of active blocks is limited by the number of warps
+     * per multiprocessor
+     */
+    public static final int LIMIT_WARPS = 2;
+
+    /**
+     * The number of active blocks is limited by the number of blocks
+     * per multiprocessor
+     */
+    public static final int LIMIT_BLOCKS = 3;
+
+    /**
+     * The number of active blocks is limited by the registers
+     */
+    public static final int LIMIT_REGISTERS = 4;
+
+    /**
+     * The number of active blocks is limited by the shared memory
+     */
+    public static final int LIMIT_SHARED_MEMORY = 5;
+
+    /**
+     * The number of threads per block
+     */
+    public int blockSize;
+
+    /**
+     * The number of bytes of dynamic shared memory per block
+     */
+    public int dynamicSharedMemBytes;
+
+    /**
+     * The number of bytes of dynamic shared memory that each block
+     * may use without reducing the number of active blocks
+     */
+    public int maxDynamicSharedMemBytes;
+
+    /**
+     * The number of active blocks per multiprocessor
+     */
+    public int activeBlocksPerMultiprocessor;
+
+    /**
+     * The number of active warps per multiprocessor
+     */
+    public int activeWarpsPerMultiprocessor;
+
+    /**
+     * The ratio of active warps to the maximum number of warps
+     * per multiprocessor
+     */
+    public float occupancy;
+
+    /**
+     * The factor that limits the number of active blocks, one of
+     * the LIMIT_* constants
+     */
+    public int limitingFactor;
+
+    /**
+     * The time of one launch with this configuration, in milliseconds,
+     * if it was determined by autotuning, or 0.0 otherwise
+     */
+    public float elapsedTime;
+
+    /**
+     * Creates a new, uninitialized CUoccupancy
+     */
+    public CUoccupancy()
+    {
+    }
+
+    /**
+     * Returns the String identifying the given limiting factor
+     *
+     * @param n The limiting factor
+     * @return The String identifying the given limiting factor
+     */
+    public static String stringForLimit(int n)
+    {
+        switch (n)
+        {
+            case LIMIT_NONE: return "LIMIT_NONE";
+            case LIMIT_BLOCK_SIZE: return "LIMIT_BLOCK_SIZE";
+            case LIMIT_WARPS: return "LIMIT_WARPS";
+            case LIMIT_BLOCKS: return "LIMIT_BLOCKS";
+            case LIMIT_REGISTERS: return "LIMIT_REGISTERS";
+            case LIMIT_SHARED_MEMORY: return "LIMIT_SHARED_MEMORY";
+        }
+        return "INVALID LIMIT: "+n;
+    }
+
+    /**
+     * Returns a String representation of this object.
+     *
+     * @return A String representation of this object.
+     */
+    @Override
+    public String toString()
+    {
+        return "CUoccupancy["+
+            "blockSize="+blockSize+","+
+            "dynamicSharedMemBytes="+dynamicSharedMemBytes+","+
+            "maxDynamicSharedMemBytes="+maxDynamicSharedMemBytes+","+
+            "activeBlocksPerMultiprocessor="+activeBlocksPerMultiprocessor+","+
+            "activeWarpsPerMultiprocessor="+activeWarpsPerMultiprocessor+","+
+            "occupancy="+occupancy+","+
+            "limitingFactor="+stringForLimit(limitingFactor)+","+
+            "elapsedTime="+elapsedTime+"]";
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+package jcuda.driver;
+
+import jcuda.NativePointerObject;
+
+/**
+ * A scheduler that separates latency-critical work from batch work.
+ * For each device, it keeps a pool of high-priority streams for
+ * latency-critical tasks and a pool of low-priority streams for batch
+ * tasks, and limits the number of batch tasks that are in flight.<br />
+ * <br />
+ * <u>Note:</u> This is not a CUDA type, but a JCuda-specific extension.
+ *
+ * @see jcuda.driver.JCudaDriver#cuPrioritySchedulerCreate
+ * @see jcuda.driver.JCudaDriver#cuPrioritySchedulerSubmit
+ * @see jcuda.driver.JCudaDriver#cuPrioritySchedulerGetStatistics
+ * @see jcuda.driver.JCudaDriver#cuPrioritySchedulerDestroy
+ */
+public class CUpriorityScheduler extends NativePointerObject
+{
+    /**
+     * The latency class for latency-critical tasks, which are executed
+     * in high-priority streams, before any queued batch task
+     */
+    public static final int LATENCY_CRITICAL = 0;
+
+    /**
+     * The latency class for batch tasks, which are executed in
+     * low-priority streams
+     */
+    public static final int LATENCY_BATCH = 1;
+
+    /**
+     * Returns the String identifying the given latency class
+     *
+     * @param n The latency class
+     * @return The String identifying the given latency class
+     */
+    public static String stringForLatencyClass(int n)
+    {
+        switch (n)
+        {
+            case LATENCY_CRITICAL: return "LATENCY_CRITICAL";
+            case LATENCY_BATCH: return "LATENCY_BATCH";
+        }
+        return "INVALID LATENCY CLASS: "+n;
+    }
+
+    /**
+     * Creates a new, uninitialized CUpriorityScheduler
+     */
+    public CUpriorityScheduler()
+    {
+    }
+
+    /**
+     * Returns a String representation of this object.
+     *
+     * @return A String representation of this object.
+     */
+    @Override
+    public String toString()
+    {
+        return "CUpriorityScheduler["+
+            "nativePointer=0x"+Long.toHexString(getNativePointer())+"]";
+    }
+
+}
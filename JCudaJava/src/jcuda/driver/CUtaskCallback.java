@@ -0,0 +1,53 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+package jcuda.driver;
+
+/**
+ * Interface for tasks that are executed by a CUtaskScheduler.<br />
+ * <br />
+ * <u>Note:</u> This is not a CUDA type, but a JCuda-specific extension.
+ *
+ * @see JCudaDriver#cuTaskSchedulerSubmit(CUtaskScheduler, CUtask, CUtaskCallback, Object, int)
+ */
+public interface CUtaskCallback
+{
+    /**
+     * The function that will be called by the worker thread of the
+     * device that executes the task. The given context is current
+     * when this method is called, and has to be current when it
+     * returns. The work of the task should be enqueued asynchronously
+     * in the given stream. The task is complete when all work that
+     * was enqueued in the stream until this method returns is done.
+     *
+     * @param device The index of the device that executes the task
+     * @param context The context of the device
+     * @param stream The stream for the work of the task
+     * @param userData User parameter provided at submission.
+     */
+    void call(int device, CUcontext context, CUstream stream, Object userData);
+}
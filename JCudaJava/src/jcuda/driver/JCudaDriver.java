@@ -244,6 +244,38 @@ public class JCudaDriver
     private static native void setLogLevel(int logLevel);
 
 
+    /**
+     * Enables or disables the elision of redundant context switches.
+     * By default, every call to cuCtxSetCurrent, cuCtxPushCurrent and
+     * cuCtxPopCurrent is passed to the driver. If tracking is enabled,
+     * a thread local record of the current context is kept, and calls
+     * that would make the context current that already is current are
+     * skipped. A push that was skipped causes the matching pop to be
+     * skipped as well.<br />
+     * <br />
+     * The record is invalidated when a context is destroyed or
+     * detached. Changes of the current context that are not done
+     * via this class (for example, by the runtime API) can not be
+     * detected. Tracking should thus only be enabled when all context
+     * handling of the application is done via JCudaDriver.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param enabled Whether context tracking is enabled
+     *
+     * @see JCudaDriver#cuCtxGetSwitchCounts
+     * @see JCudaDriver#cuCtxRunWith
+     */
+    public static void setContextTrackingEnabled(boolean enabled)
+    {
+        setContextTrackingEnabledNative(enabled);
+    }
+
+    private static native void setContextTrackingEnabledNative(boolean enabled);
+
+
     /**
      * Enables or disables exceptions. By default, the methods of this class
      * only return the CUresult error code from the underlying CUDA function.
@@ -1152,6 +1184,33 @@ public class JCudaDriver
     private static native int cuDeviceGetAttributeNative(int pi[], int attrib, CUdevice dev);
 
 
+    /**
+     * Obtains a snapshot of the attributes, the total memory and the
+     * name of all devices. The snapshot is created once, when this
+     * function is first called, and the same data is returned for all
+     * subsequent calls. This allows querying all device properties
+     * without one native call per attribute. The layout of the data
+     * is described in the {@link CUdeviceSnapshot} class.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param snapshot The snapshot that will be initialized
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuDeviceGetAttribute
+     * @see JCudaDriver#cuDeviceTotalMem
+     * @see JCudaDriver#cuDeviceGetName
+     */
+    public static int cuDeviceGetSnapshot(CUdeviceSnapshot snapshot)
+    {
+        return checkResult(cuDeviceGetSnapshotNative(snapshot));
+    }
+    private static native int cuDeviceGetSnapshotNative(CUdeviceSnapshot snapshot);
+
+
     /**
      * Returns the CUDA driver version.
      * 
@@ -1707,6 +1766,98 @@ public class JCudaDriver
     private static native int cuCtxGetCurrentNative(CUcontext pctx);
 
 
+    /**
+     * Returns the number of context switches that have been passed to
+     * the driver, and the number of redundant switches that have been
+     * elided, summed over all threads, since the counts have been reset.
+     * Switches are only elided when context tracking is enabled.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param performed Returned number of performed switches
+     * @param elided Returned number of elided switches
+     *
+     * @return CUDA_SUCCESS
+     *
+     * @see JCudaDriver#setContextTrackingEnabled
+     * @see JCudaDriver#cuCtxResetSwitchCounts
+     */
+    public static int cuCtxGetSwitchCounts(long performed[], long elided[])
+    {
+        return checkResult(cuCtxGetSwitchCountsNative(performed, elided));
+    }
+
+    private static native int cuCtxGetSwitchCountsNative(long performed[], long elided[]);
+
+
+    /**
+     * Resets the counts of performed and elided context switches.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @return CUDA_SUCCESS
+     *
+     * @see JCudaDriver#cuCtxGetSwitchCounts
+     */
+    public static int cuCtxResetSwitchCounts()
+    {
+        return checkResult(cuCtxResetSwitchCountsNative());
+    }
+
+    private static native int cuCtxResetSwitchCountsNative();
+
+
+    /**
+     * Executes the given runnable with the given context being current.
+     * The context is pushed on the context stack of the calling thread,
+     * the runnable is executed, and the context is popped again, even
+     * if the runnable throws an exception. If the context is already
+     * current and context tracking is enabled, the push and the pop
+     * are elided.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param ctx The context
+     * @param runnable The runnable to execute
+     *
+     * @return The result of pushing the context, or of popping it if
+     * the push succeeded. The runnable is not executed if the push
+     * failed.
+     *
+     * @see JCudaDriver#cuCtxPushCurrent
+     * @see JCudaDriver#cuCtxPopCurrent
+     * @see JCudaDriver#setContextTrackingEnabled
+     */
+    public static int cuCtxRunWith(CUcontext ctx, Runnable runnable)
+    {
+        if (runnable == null)
+        {
+            throw new NullPointerException(
+                "Parameter 'runnable' is null for cuCtxRunWith");
+        }
+        int result = cuCtxPushCurrent(ctx);
+        if (result != CUresult.CUDA_SUCCESS)
+        {
+            return result;
+        }
+        try
+        {
+            runnable.run();
+        }
+        finally
+        {
+            result = cuCtxPopCurrent(new CUcontext());
+        }
+        return result;
+    }
+
+
     /**
      * Returns the device ID for the current context.
      * 
@@ -2284,6 +2435,110 @@ public class JCudaDriver
     private static native int cuModuleGetGlobalNative(CUdeviceptr dptr, long bytes[], CUmodule hmod, String name);
 
 
+    /**
+     * Stages an update of a global variable of a module, e.g. of a
+     * __constant__ parameter. The given number of bytes are copied from
+     * the given host memory when this call returns, and written at the
+     * given offset of the global with the given name when the updates
+     * are flushed.<br />
+     * <br />
+     * The address and size of each global are looked up only once with
+     * {@link JCudaDriver#cuModuleGetGlobal}. The staged updates of the
+     * current context are merged into ranges of adjacent addresses of
+     * the same global, where later updates overwrite earlier ones. The
+     * pending updates are flushed, with one asynchronous copy for each
+     * range, before the next kernel of the current context is launched
+     * with {@link JCudaDriver#cuLaunchKernel} or one of the legacy
+     * launch functions, in the stream of the launch, or explicitly with
+     * {@link JCudaDriver#cuSymbolUpdateFlush}. Launches that are
+     * captured into an operation graph do not flush the updates.<br />
+     * <br />
+     * Launches in other streams of the context wait for the copies of
+     * the last flush, until these copies are known to be complete.
+     * A flush does not block the calling thread.<br />
+     * <br />
+     * The globals of a module are forgotten, and their pending updates
+     * are discarded, in {@link JCudaDriver#cuModuleUnload}. The pending
+     * updates of a context are discarded in
+     * {@link JCudaDriver#cuCtxDestroy}. If no page-locked staging
+     * buffer can be allocated, then the updates are copied from
+     * pageable memory.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param hmod The module
+     * @param name The name of the global
+     * @param offset The offset inside the global, in bytes
+     * @param src The host memory to copy from
+     * @param bytes The number of bytes to copy
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED,
+     * CUDA_ERROR_NOT_INITIALIZED, CUDA_ERROR_INVALID_CONTEXT,
+     * CUDA_ERROR_INVALID_VALUE, CUDA_ERROR_NOT_FOUND
+     *
+     * @see JCudaDriver#cuSymbolUpdateFlush
+     * @see JCudaDriver#cuSymbolUpdateGetStatistics
+     * @see JCudaDriver#cuModuleGetGlobal
+     */
+    public static int cuSymbolUpdateStage(CUmodule hmod, String name, long offset, Pointer src, long bytes)
+    {
+        return checkResult(cuSymbolUpdateStageNative(hmod, name, offset, src, bytes));
+    }
+    private static native int cuSymbolUpdateStageNative(CUmodule hmod, String name, long offset, Pointer src, long bytes);
+
+
+    /**
+     * Flushes the pending updates of globals of the current context
+     * that have been staged with
+     * {@link JCudaDriver#cuSymbolUpdateStage}, as asynchronous copies
+     * in the given stream. The updates are discarded if the copies can
+     * not be issued.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param hStream The stream for the copies
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED,
+     * CUDA_ERROR_NOT_INITIALIZED, CUDA_ERROR_INVALID_CONTEXT,
+     * CUDA_ERROR_INVALID_VALUE, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuSymbolUpdateStage
+     */
+    public static int cuSymbolUpdateFlush(CUstream hStream)
+    {
+        return checkResult(cuSymbolUpdateFlushNative(hStream));
+    }
+    private static native int cuSymbolUpdateFlushNative(CUstream hStream);
+
+
+    /**
+     * Returns the statistics of the staged updates of globals: The
+     * number of updates that have been staged, and the number of
+     * copies and bytes that they have been flushed with.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param updates Will store the number of staged updates
+     * @param copies Will store the number of copies
+     * @param bytes Will store the number of copied bytes
+     *
+     * @return CUDA_SUCCESS
+     *
+     * @see JCudaDriver#cuSymbolUpdateStage
+     */
+    public static int cuSymbolUpdateGetStatistics(long updates[], long copies[], long bytes[])
+    {
+        return checkResult(cuSymbolUpdateGetStatisticsNative(updates, copies, bytes));
+    }
+    private static native int cuSymbolUpdateGetStatisticsNative(long updates[], long copies[], long bytes[]);
+
+
     /**
      * Returns a handle to a texture reference.
      * 
@@ -2418,6 +2673,213 @@ public class JCudaDriver
         return checkResult(cuLinkDestroyNative(state));
     }
     private static native int cuLinkDestroyNative(CUlinkState state);
+
+
+    /**
+     * Creates a cache for the images that are created by the linker.
+     * The cache keeps at most the given number of bytes of images in
+     * memory, and evicts the least recently used images that are not
+     * in use. If the given directory is not <code>null</code>, then
+     * the images are also stored as files in this directory, so that
+     * they may be found by later processes.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param cache Returned cache
+     * @param directory The directory for the images. May be <code>null</code>.
+     * @param maxBytes The maximum number of bytes kept in memory
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuCachedLinkCreate
+     * @see JCudaDriver#cuLinkCacheDestroy
+     */
+    public static int cuLinkCacheCreate(CUlinkCache cache, String directory, long maxBytes)
+    {
+        return checkResult(cuLinkCacheCreateNative(cache, directory, maxBytes));
+    }
+    private static native int cuLinkCacheCreateNative(CUlinkCache cache, String directory, long maxBytes);
+
+
+    /**
+     * Destroys the given cache. All links that have been created
+     * with this cache have to be destroyed before.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param cache The cache
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     */
+    public static int cuLinkCacheDestroy(CUlinkCache cache)
+    {
+        return checkResult(cuLinkCacheDestroyNative(cache));
+    }
+    private static native int cuLinkCacheDestroyNative(CUlinkCache cache);
+
+
+    /**
+     * Obtains the statistics of the given cache: The number of images
+     * that have been found in memory, the number of images that have
+     * been found in the directory, the number of images that had to be
+     * linked, and the total time that was saved by not invoking the
+     * linker, in nanoseconds. The saved time is computed from the time
+     * that the linker originally needed for each image.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param cache The cache
+     * @param hits Returned number of images found in memory
+     * @param diskHits Returned number of images found in the directory
+     * @param misses Returned number of images that had to be linked
+     * @param savedTime Returned saved time, in nanoseconds
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     */
+    public static int cuLinkCacheGetStatistics(CUlinkCache cache, long hits[], long diskHits[], long misses[], long savedTime[])
+    {
+        return checkResult(cuLinkCacheGetStatisticsNative(cache, hits, diskHits, misses, savedTime));
+    }
+    private static native int cuLinkCacheGetStatisticsNative(CUlinkCache cache, long hits[], long diskHits[], long misses[], long savedTime[]);
+
+
+    /**
+     * Creates a link that uses the given cache. This corresponds to
+     * {@link JCudaDriver#cuLinkCreate}, but the inputs that are added
+     * to the link are only recorded. When the link is completed, the
+     * image is looked up in the cache, with a key that consists of the
+     * hashes of the inputs, their types, the JIT options of the link
+     * and of the inputs, and the compute capability of the current
+     * context. The linker is only invoked if the image is not found.
+     * <br />
+     * <br />
+     * The given JIT options, and the JIT options of the inputs, must
+     * not be modified until the link is completed. Options that only
+     * affect the logs are not part of the key. The logs are only
+     * written when the linker is invoked.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param cache The cache
+     * @param jitOptions The JIT options. May be <code>null</code>.
+     * @param stateOut Returned link state
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuCachedLinkAddData
+     * @see JCudaDriver#cuCachedLinkAddFile
+     * @see JCudaDriver#cuCachedLinkComplete
+     * @see JCudaDriver#cuCachedLinkDestroy
+     */
+    public static int cuCachedLinkCreate(CUlinkCache cache, JITOptions jitOptions, CUcachedLinkState stateOut)
+    {
+        return checkResult(cuCachedLinkCreateNative(cache, jitOptions, stateOut));
+    }
+    private static native int cuCachedLinkCreateNative(CUlinkCache cache, JITOptions jitOptions, CUcachedLinkState stateOut);
+
+
+    /**
+     * Adds an input to the given link. This corresponds to
+     * {@link JCudaDriver#cuLinkAddData}. The data is copied.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param state The link state
+     * @param type The CUjitInputType of the input
+     * @param data The input data
+     * @param size The size of the input data, in bytes
+     * @param name The name of the input, for log messages. May be
+     * <code>null</code>.
+     * @param jitOptions The JIT options for the input. May be
+     * <code>null</code>.
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_INVALID_VALUE
+     */
+    public static int cuCachedLinkAddData(CUcachedLinkState state, int type, Pointer data, long size, String name, JITOptions jitOptions)
+    {
+        return checkResult(cuCachedLinkAddDataNative(state, type, data, size, name, jitOptions));
+    }
+    private static native int cuCachedLinkAddDataNative(CUcachedLinkState state, int type, Pointer data, long size, String name, JITOptions jitOptions);
+
+
+    /**
+     * Adds the contents of the given file as an input to the given link.
+     * This corresponds to {@link JCudaDriver#cuLinkAddFile}. The file is
+     * read immediately, so that its contents are part of the key.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param state The link state
+     * @param type The CUjitInputType of the input
+     * @param path The path of the file
+     * @param jitOptions The JIT options for the input. May be
+     * <code>null</code>.
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_INVALID_VALUE, CUDA_ERROR_FILE_NOT_FOUND
+     */
+    public static int cuCachedLinkAddFile(CUcachedLinkState state, int type, String path, JITOptions jitOptions)
+    {
+        return checkResult(cuCachedLinkAddFileNative(state, type, path, jitOptions));
+    }
+    private static native int cuCachedLinkAddFileNative(CUcachedLinkState state, int type, String path, JITOptions jitOptions);
+
+
+    /**
+     * Completes the given link. This corresponds to
+     * {@link JCudaDriver#cuLinkComplete}. The returned image is owned
+     * by the cache, and remains valid until the link is destroyed.
+     * No more inputs may be added afterwards.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param state The link state
+     * @param cubinOut Returned pointer to the linked image
+     * @param sizeOut Returned size of the linked image. May be
+     * <code>null</code>.
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE, or the error
+     * from the linker
+     */
+    public static int cuCachedLinkComplete(CUcachedLinkState state, Pointer cubinOut, long sizeOut[])
+    {
+        return checkResult(cuCachedLinkCompleteNative(state, cubinOut, sizeOut));
+    }
+    private static native int cuCachedLinkCompleteNative(CUcachedLinkState state, Pointer cubinOut, long sizeOut[]);
+
+
+    /**
+     * Destroys the given link. The image that was returned by
+     * {@link JCudaDriver#cuCachedLinkComplete} becomes invalid.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param state The link state
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     */
+    public static int cuCachedLinkDestroy(CUcachedLinkState state)
+    {
+        return checkResult(cuCachedLinkDestroyNative(state));
+    }
+    private static native int cuCachedLinkDestroyNative(CUcachedLinkState state);
     
     
 
@@ -3131,74 +3593,319 @@ public class JCudaDriver
     private static native int cuIpcCloseMemHandleNative(CUdeviceptr dptr);
 
 
+    /**
+     * Creates a registry for IPC memory handles. Handles that are opened
+     * through the registry are deduplicated: Opening a handle that is
+     * already open in the current context only increments a reference
+     * count. When the last reference is released with
+     * {@link JCudaDriver#cuIpcRegistryCloseMemHandle}, the handle is kept
+     * open for re-use, until more than the given maximum number of
+     * released handles are kept open, or the registry is trimmed. All
+     * handles that have been opened in a context are closed when the
+     * context is destroyed.<br />
+     * <br />
+     * If the given segment name is not <code>null</code>, the registry
+     * is attached to the shared memory segment with this name, which is
+     * created with the given number of slots if it does not exist yet.
+     * Handles may then be published under a name with
+     * {@link JCudaDriver#cuIpcRegistryPublish}, and other processes on
+     * the same node that attached a registry to the same segment may
+     * open them with {@link JCudaDriver#cuIpcRegistryOpen}. At most 64
+     * registries may be attached to one segment. The attachments and
+     * the published handles of processes that terminated without
+     * destroying their registries are reclaimed by other
+     * registries.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param registry Returned registry
+     * @param segmentName The name of the shared memory segment. May be
+     * <code>null</code>.
+     * @param slotCount The number of slots for a new segment, which is
+     * the maximum number of handles that may be published on the node
+     * @param maxIdle The maximum number of released handles to keep open
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE,
+     * CUDA_ERROR_OPERATING_SYSTEM, CUDA_ERROR_OUT_OF_MEMORY
+     *
+     * @see JCudaDriver#cuIpcRegistryDestroy
+     */
+    public static int cuIpcRegistryCreate(CUipcRegistry registry, String segmentName, int slotCount, int maxIdle)
+    {
+        return checkResult(cuIpcRegistryCreateNative(registry, segmentName, slotCount, maxIdle));
+    }
+    private static native int cuIpcRegistryCreateNative(CUipcRegistry registry, String segmentName, int slotCount, int maxIdle);
 
 
     /**
-     * Registers an existing host memory range for use by CUDA.
-     * 
-     * <pre>
-     * CUresult cuMemHostRegister (
-     *      void* p,
-     *      size_t bytesize,
-     *      unsigned int  Flags )
-     * </pre>
-     * <div>
-     *   <p>Registers an existing host memory range
-     *     for use by CUDA.  Page-locks the memory range specified by <tt>p</tt>
-     *     and <tt>bytesize</tt> and maps it for the device(s) as specified by
-     *     <tt>Flags</tt>. This memory range also is added to the same tracking
-     *     mechanism as cuMemHostAlloc to automatically accelerate calls to
-     *     functions such as cuMemcpyHtoD(). Since the memory can be accessed
-     *     directly by the device, it can be read or written with much higher
-     *     bandwidth than pageable
-     *     memory that has not been registered.
-     *     Page-locking excessive amounts of memory may degrade system performance,
-     *     since it reduces
-     *     the amount of memory available to the
-     *     system for paging. As a result, this function is best used sparingly
-     *     to register staging
-     *     areas for data exchange between host and
-     *     device.
-     *   </p>
-     *   <p>This function has limited support on
-     *     Mac OS X. OS 10.7 or higher is required.
-     *   </p>
-     *   <p>The <tt>Flags</tt> parameter enables
-     *     different options to be specified that affect the allocation, as
-     *     follows.
-     *   </p>
-     *   <ul>
-     *     <li>
-     *       <p>CU_MEMHOSTREGISTER_PORTABLE:
-     *         The memory returned by this call will be considered as pinned memory
-     *         by all CUDA contexts, not just the one that performed
-     *         the allocation.
-     *       </p>
-     *     </li>
-     *   </ul>
-     *   </p>
-     *   <ul>
-     *     <li>
-     *       <p>CU_MEMHOSTREGISTER_DEVICEMAP:
-     *         Maps the allocation into the CUDA address space. The device pointer to
-     *         the memory may be obtained by calling cuMemHostGetDevicePointer(). This
-     *         feature is available only on GPUs with compute capability greater than
-     *         or equal to 1.1.
-     *       </p>
-     *     </li>
-     *   </ul>
-     *   </p>
-     *   <p>All of these flags are orthogonal to
-     *     one another: a developer may page-lock memory that is portable or
-     *     mapped with no restrictions.
-     *   </p>
-     *   <p>The CUDA context must have been created
-     *     with the CU_CTX_MAP_HOST flag in order for the CU_MEMHOSTREGISTER_DEVICEMAP
-     *     flag to have any effect.
-     *   </p>
-     *   <p>The CU_MEMHOSTREGISTER_DEVICEMAP flag
-     *     may be specified on CUDA contexts for devices that do not support
-     *     mapped pinned memory. The failure is deferred to cuMemHostGetDevicePointer()
+     * Destroys the given registry. All handles that have been published
+     * through the registry are unpublished, and all handles that have been
+     * opened through the registry are closed, even if they are still
+     * referenced. The shared memory segment is removed when the last
+     * registry that was attached to it is destroyed.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param registry The registry
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuIpcRegistryCreate
+     */
+    public static int cuIpcRegistryDestroy(CUipcRegistry registry)
+    {
+        return checkResult(cuIpcRegistryDestroyNative(registry));
+    }
+    private static native int cuIpcRegistryDestroyNative(CUipcRegistry registry);
+
+
+    /**
+     * Opens the given IPC memory handle in the current context, like
+     * {@link JCudaDriver#cuIpcOpenMemHandle}. If the handle is already
+     * open in the current context, the existing pointer is returned
+     * and its reference count is incremented.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param registry The registry
+     * @param pdptr Returned device pointer
+     * @param handle The IPC memory handle
+     * @param Flags The flags for cuIpcOpenMemHandle
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_TOO_MANY_PEERS,
+     * CUDA_ERROR_MAP_FAILED
+     *
+     * @see JCudaDriver#cuIpcRegistryCloseMemHandle
+     */
+    public static int cuIpcRegistryOpenMemHandle(CUipcRegistry registry, CUdeviceptr pdptr, CUipcMemHandle handle, int Flags)
+    {
+        return checkResult(cuIpcRegistryOpenMemHandleNative(registry, pdptr, handle, Flags));
+    }
+    private static native int cuIpcRegistryOpenMemHandleNative(CUipcRegistry registry, CUdeviceptr pdptr, CUipcMemHandle handle, int Flags);
+
+
+    /**
+     * Releases one reference to the given pointer, which must have been
+     * obtained from the given registry. The handle is not closed
+     * immediately when its last reference is released, but kept open
+     * for re-use, as described in {@link JCudaDriver#cuIpcRegistryCreate}.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param registry The registry
+     * @param dptr The device pointer
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuIpcRegistryTrim
+     */
+    public static int cuIpcRegistryCloseMemHandle(CUipcRegistry registry, CUdeviceptr dptr)
+    {
+        return checkResult(cuIpcRegistryCloseMemHandleNative(registry, dptr));
+    }
+    private static native int cuIpcRegistryCloseMemHandleNative(CUipcRegistry registry, CUdeviceptr dptr);
+
+
+    /**
+     * Closes all handles of the given registry that are no longer
+     * referenced.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param registry The registry
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     */
+    public static int cuIpcRegistryTrim(CUipcRegistry registry)
+    {
+        return checkResult(cuIpcRegistryTrimNative(registry));
+    }
+    private static native int cuIpcRegistryTrimNative(CUipcRegistry registry);
+
+
+    /**
+     * Publishes the IPC memory handle of the given device memory under
+     * the given name in the shared memory segment of the given registry,
+     * replacing any handle that was published under the same name. The
+     * name may have at most 63 bytes.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param registry The registry
+     * @param name The name
+     * @param dptr The device memory
+     * @param bytesize The size of the memory, for the consumers
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_INVALID_VALUE, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_OUT_OF_MEMORY
+     *
+     * @see JCudaDriver#cuIpcRegistryUnpublish
+     * @see JCudaDriver#cuIpcRegistryOpen
+     */
+    public static int cuIpcRegistryPublish(CUipcRegistry registry, String name, CUdeviceptr dptr, long bytesize)
+    {
+        return checkResult(cuIpcRegistryPublishNative(registry, name, dptr, bytesize));
+    }
+    private static native int cuIpcRegistryPublishNative(CUipcRegistry registry, String name, CUdeviceptr dptr, long bytesize);
+
+
+    /**
+     * Removes the handle that was published under the given name by
+     * this process.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param registry The registry
+     * @param name The name
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_NOT_INITIALIZED, CUDA_ERROR_NOT_FOUND
+     *
+     * @see JCudaDriver#cuIpcRegistryPublish
+     */
+    public static int cuIpcRegistryUnpublish(CUipcRegistry registry, String name)
+    {
+        return checkResult(cuIpcRegistryUnpublishNative(registry, name));
+    }
+    private static native int cuIpcRegistryUnpublishNative(CUipcRegistry registry, String name);
+
+
+    /**
+     * Looks up the handle that was published under the given name, and
+     * opens it in the current context as described in
+     * {@link JCudaDriver#cuIpcRegistryOpenMemHandle}. The returned pointer
+     * has to be released with {@link JCudaDriver#cuIpcRegistryCloseMemHandle}.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param registry The registry
+     * @param pdptr Returned device pointer
+     * @param bytesize Returned size of the memory. May be <code>null</code>.
+     * @param name The name
+     * @param Flags The flags for cuIpcOpenMemHandle
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_NOT_INITIALIZED, CUDA_ERROR_NOT_FOUND,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_MAP_FAILED
+     *
+     * @see JCudaDriver#cuIpcRegistryPublish
+     */
+    public static int cuIpcRegistryOpen(CUipcRegistry registry, CUdeviceptr pdptr, long bytesize[], String name, int Flags)
+    {
+        return checkResult(cuIpcRegistryOpenNative(registry, pdptr, bytesize, name, Flags));
+    }
+    private static native int cuIpcRegistryOpenNative(CUipcRegistry registry, CUdeviceptr pdptr, long bytesize[], String name, int Flags);
+
+
+    /**
+     * Returns the number of handles that have actually been opened by
+     * the given registry, and the number of opens that have been served
+     * by handles that were already open.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param registry The registry
+     * @param opened Returned number of opened handles
+     * @param hits Returned number of cache hits
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     */
+    public static int cuIpcRegistryGetStatistics(CUipcRegistry registry, long opened[], long hits[])
+    {
+        return checkResult(cuIpcRegistryGetStatisticsNative(registry, opened, hits));
+    }
+    private static native int cuIpcRegistryGetStatisticsNative(CUipcRegistry registry, long opened[], long hits[]);
+
+
+
+
+    /**
+     * Registers an existing host memory range for use by CUDA.
+     * 
+     * <pre>
+     * CUresult cuMemHostRegister (
+     *      void* p,
+     *      size_t bytesize,
+     *      unsigned int  Flags )
+     * </pre>
+     * <div>
+     *   <p>Registers an existing host memory range
+     *     for use by CUDA.  Page-locks the memory range specified by <tt>p</tt>
+     *     and <tt>bytesize</tt> and maps it for the device(s) as specified by
+     *     <tt>Flags</tt>. This memory range also is added to the same tracking
+     *     mechanism as cuMemHostAlloc to automatically accelerate calls to
+     *     functions such as cuMemcpyHtoD(). Since the memory can be accessed
+     *     directly by the device, it can be read or written with much higher
+     *     bandwidth than pageable
+     *     memory that has not been registered.
+     *     Page-locking excessive amounts of memory may degrade system performance,
+     *     since it reduces
+     *     the amount of memory available to the
+     *     system for paging. As a result, this function is best used sparingly
+     *     to register staging
+     *     areas for data exchange between host and
+     *     device.
+     *   </p>
+     *   <p>This function has limited support on
+     *     Mac OS X. OS 10.7 or higher is required.
+     *   </p>
+     *   <p>The <tt>Flags</tt> parameter enables
+     *     different options to be specified that affect the allocation, as
+     *     follows.
+     *   </p>
+     *   <ul>
+     *     <li>
+     *       <p>CU_MEMHOSTREGISTER_PORTABLE:
+     *         The memory returned by this call will be considered as pinned memory
+     *         by all CUDA contexts, not just the one that performed
+     *         the allocation.
+     *       </p>
+     *     </li>
+     *   </ul>
+     *   </p>
+     *   <ul>
+     *     <li>
+     *       <p>CU_MEMHOSTREGISTER_DEVICEMAP:
+     *         Maps the allocation into the CUDA address space. The device pointer to
+     *         the memory may be obtained by calling cuMemHostGetDevicePointer(). This
+     *         feature is available only on GPUs with compute capability greater than
+     *         or equal to 1.1.
+     *       </p>
+     *     </li>
+     *   </ul>
+     *   </p>
+     *   <p>All of these flags are orthogonal to
+     *     one another: a developer may page-lock memory that is portable or
+     *     mapped with no restrictions.
+     *   </p>
+     *   <p>The CUDA context must have been created
+     *     with the CU_CTX_MAP_HOST flag in order for the CU_MEMHOSTREGISTER_DEVICEMAP
+     *     flag to have any effect.
+     *   </p>
+     *   <p>The CU_MEMHOSTREGISTER_DEVICEMAP flag
+     *     may be specified on CUDA contexts for devices that do not support
+     *     mapped pinned memory. The failure is deferred to cuMemHostGetDevicePointer()
      *     because the memory may be mapped into other CUDA contexts via the
      *     CU_MEMHOSTREGISTER_PORTABLE flag.
      *   </p>
@@ -3276,6 +3983,306 @@ public class JCudaDriver
     private static native int cuMemHostUnregisterNative(Pointer p);
 
 
+    /**
+     * Enables the registration cache for direct ByteBuffers. The
+     * transfers between host and device memory with
+     * {@link JCudaDriver#cuMemcpyHtoD}, {@link JCudaDriver#cuMemcpyDtoH}
+     * and their asynchronous versions are counted for each direct
+     * ByteBuffer. When a buffer has been used for the given number of
+     * transfers, its memory is registered as page-locked memory, as if
+     * with {@link JCudaDriver#cuMemHostRegister}, so that the following
+     * transfers may use the full bandwidth, and asynchronous transfers
+     * do not have to be staged synchronously.<br />
+     * <br />
+     * The total size of the registered buffers does not exceed the
+     * given budget. When another buffer has to be registered, the
+     * least recently used buffers are evicted. An evicted buffer is
+     * unregistered as soon as the asynchronous transfers that used
+     * it are complete, without synchronizing the context, and the
+     * other buffer is registered with one of its next transfers.<br />
+     * <br />
+     * A registered buffer can not be garbage collected until it has
+     * been unregistered. Buffers whose memory is freed explicitly
+     * should be released with {@link JCudaDriver#cuRegistrationCacheRelease} before.<br />
+     * <br />
+     * If the cache is already enabled, then its parameters are updated.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param threshold The number of transfers after which a buffer
+     * is registered
+     * @param budget The maximum number of bytes that are registered
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuRegistrationCacheDisable
+     * @see JCudaDriver#cuRegistrationCacheGetStatistics
+     */
+    public static int cuRegistrationCacheEnable(int threshold, long budget)
+    {
+        return checkResult(cuRegistrationCacheEnableNative(threshold, budget));
+    }
+    private static native int cuRegistrationCacheEnableNative(int threshold, long budget);
+
+
+    /**
+     * Disables the registration cache, and unregisters all buffers that
+     * have been registered by the cache, after the pending asynchronous
+     * transfers from or to these buffers are complete.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @return CUDA_SUCCESS
+     *
+     * @see JCudaDriver#cuRegistrationCacheEnable
+     */
+    public static int cuRegistrationCacheDisable()
+    {
+        return checkResult(cuRegistrationCacheDisableNative());
+    }
+    private static native int cuRegistrationCacheDisableNative();
+
+
+    /**
+     * Unregisters the direct ByteBuffer that the given pointer refers
+     * to, if it has been registered by the registration cache, after
+     * the pending asynchronous transfers from or to the buffer are
+     * complete. This should be called before the memory of the buffer
+     * is freed.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param buffer The pointer to the direct ByteBuffer
+     *
+     * @return CUDA_SUCCESS
+     *
+     * @see JCudaDriver#cuRegistrationCacheEnable
+     */
+    public static int cuRegistrationCacheRelease(Pointer buffer)
+    {
+        return checkResult(cuRegistrationCacheReleaseNative(buffer));
+    }
+    private static native int cuRegistrationCacheReleaseNative(Pointer buffer);
+
+
+    /**
+     * Returns the statistics of the registration cache: The number of
+     * buffers and bytes that are currently registered, the number of
+     * transfers that did and did not use a registered buffer, and the
+     * number of buffers that have been unregistered to meet the budget.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param registeredCount Will store the number of registered buffers
+     * @param registeredBytes Will store the number of registered bytes
+     * @param hits Will store the number of transfers that used a
+     * registered buffer
+     * @param misses Will store the number of transfers that used a
+     * buffer that was not registered
+     * @param evictions Will store the number of evicted buffers
+     *
+     * @return CUDA_SUCCESS
+     */
+    public static int cuRegistrationCacheGetStatistics(long registeredCount[], long registeredBytes[], long hits[], long misses[], long evictions[])
+    {
+        return checkResult(cuRegistrationCacheGetStatisticsNative(registeredCount, registeredBytes, hits, misses, evictions));
+    }
+    private static native int cuRegistrationCacheGetStatisticsNative(long registeredCount[], long registeredBytes[], long hits[], long misses[], long evictions[]);
+
+
+    /**
+     * Enables the bounce ring for asynchronous copies between Java
+     * arrays and device memory with
+     * {@link JCudaDriver#cuMemcpyHtoDAsync} and
+     * {@link JCudaDriver#cuMemcpyDtoHAsync}. Each stream gets up to the
+     * given number of page-locked slots of the given size, which are
+     * used in turn:<br />
+     * <br />
+     * For a copy from a Java array, the array is copied into the next
+     * slot, and the copy from this slot is enqueued, so that the array
+     * may be modified as soon as the call returns. For a copy into a
+     * Java array, the copy into the next slot is enqueued, and the slot
+     * is copied into the array when the copy is known to be complete:
+     * When the stream, context or event is synchronized with
+     * {@link JCudaDriver#cuStreamSynchronize},
+     * {@link JCudaDriver#cuCtxSynchronize} or
+     * {@link JCudaDriver#cuEventSynchronize}, or found to be complete
+     * with {@link JCudaDriver#cuStreamQuery} or
+     * {@link JCudaDriver#cuEventQuery}, or when an event future is
+     * completed. The array must not be accessed before that, as usual
+     * for asynchronous copies.<br />
+     * <br />
+     * Only the synchronization functions of the driver API complete
+     * the copies into Java arrays. Synchronizing with the runtime API,
+     * for example with cudaDeviceSynchronize, does not complete
+     * them.<br />
+     * <br />
+     * The calling thread only waits when all slots of the stream are
+     * still used by pending copies. Copies that are larger than one slot
+     * are split into chunks of the slot size. If no slot is available
+     * for a chunk, then the remaining chunks are copied directly, and
+     * a copy into a Java array then waits until the stream is complete.
+     * The slots of a stream are released by
+     * {@link JCudaDriver#cuStreamDestroy} and
+     * {@link JCudaDriver#cuCtxDestroy}.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param slotSize The size of each slot, in bytes
+     * @param slotCount The maximum number of slots for each stream
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuBounceRingDisable
+     * @see JCudaDriver#cuBounceRingGetStatistics
+     */
+    public static int cuBounceRingEnable(long slotSize, int slotCount)
+    {
+        return checkResult(cuBounceRingEnableNative(slotSize, slotCount));
+    }
+    private static native int cuBounceRingEnableNative(long slotSize, int slotCount);
+
+
+    /**
+     * Disables the bounce ring. The pending copies are completed, and
+     * all slots are released.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @return CUDA_SUCCESS
+     *
+     * @see JCudaDriver#cuBounceRingEnable
+     */
+    public static int cuBounceRingDisable()
+    {
+        return checkResult(cuBounceRingDisableNative());
+    }
+    private static native int cuBounceRingDisableNative();
+
+
+    /**
+     * Returns the statistics of the bounce ring: The number of copies
+     * and bytes that went through a slot, the number of times that a
+     * thread had to wait for a slot, and the number of copies into Java
+     * arrays that have not been completed yet.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param copies Will store the number of bounced copies
+     * @param bytes Will store the number of bounced bytes
+     * @param waits Will store the number of waits for a slot
+     * @param pending Will store the number of pending copies into arrays
+     *
+     * @return CUDA_SUCCESS
+     *
+     * @see JCudaDriver#cuBounceRingEnable
+     */
+    public static int cuBounceRingGetStatistics(long copies[], long bytes[], long waits[], long pending[])
+    {
+        return checkResult(cuBounceRingGetStatisticsNative(copies, bytes, waits, pending));
+    }
+    private static native int cuBounceRingGetStatisticsNative(long copies[], long bytes[], long waits[], long pending[]);
+
+
+    /**
+     * Enables the pitch packer for 2D and 3D copies between Java arrays
+     * and device memory, with {@link JCudaDriver#cuMemcpy2D},
+     * {@link JCudaDriver#cuMemcpy2DUnaligned} and
+     * {@link JCudaDriver#cuMemcpy3D}. Instead of passing the pitched
+     * rows of the array to CUDA, which copies them from pageable memory,
+     * the rows are packed into a contiguous page-locked staging buffer,
+     * which is then transferred with a single copy. For copies into Java
+     * arrays, the staging buffer is unpacked into the rows of the array.
+     * The array is only accessed while it is packed or unpacked, and not
+     * during the transfer.<br />
+     * <br />
+     * The rows are copied by the calling thread and a pool of worker
+     * threads, and are written into the staging buffer with non-temporal
+     * SSE2 stores where available. Copies that are smaller than the
+     * given threshold are executed directly. The staging buffers are
+     * released by {@link JCudaDriver#cuCtxDestroy}.<br />
+     * <br />
+     * The time that is spent for packing and unpacking is reported by
+     * {@link JCudaDriver#cuPitchPackerGetStatistics}, so that it may be
+     * compared to the time of the copies without the packer.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param threadCount The number of threads, including the calling
+     * thread, or 0 to use the number of processors
+     * @param threshold The minimum size of packed copies, in bytes
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE, CUDA_ERROR_UNKNOWN
+     *
+     * @see JCudaDriver#cuPitchPackerDisable
+     * @see JCudaDriver#cuPitchPackerGetStatistics
+     */
+    public static int cuPitchPackerEnable(int threadCount, long threshold)
+    {
+        return checkResult(cuPitchPackerEnableNative(threadCount, threshold));
+    }
+    private static native int cuPitchPackerEnableNative(int threadCount, long threshold);
+
+
+    /**
+     * Disables the pitch packer, stops its worker threads, and releases
+     * all staging buffers.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @return CUDA_SUCCESS
+     *
+     * @see JCudaDriver#cuPitchPackerEnable
+     */
+    public static int cuPitchPackerDisable()
+    {
+        return checkResult(cuPitchPackerDisableNative());
+    }
+    private static native int cuPitchPackerDisableNative();
+
+
+    /**
+     * Returns the statistics of the pitch packer: The number of copies
+     * and bytes that have been packed or unpacked, and the time that
+     * was spent for packing and unpacking, in nanoseconds.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param copies Will store the number of packed copies
+     * @param bytes Will store the number of packed bytes
+     * @param nanos Will store the time for packing, in nanoseconds
+     *
+     * @return CUDA_SUCCESS
+     *
+     * @see JCudaDriver#cuPitchPackerEnable
+     */
+    public static int cuPitchPackerGetStatistics(long copies[], long bytes[], long nanos[])
+    {
+        return checkResult(cuPitchPackerGetStatisticsNative(copies, bytes, nanos));
+    }
+    private static native int cuPitchPackerGetStatisticsNative(long copies[], long bytes[], long nanos[]);
+
+
     /**
      * Copies memory.
      * 
@@ -3358,6 +4365,81 @@ public class JCudaDriver
     private static native int cuMemcpyNative(CUdeviceptr dst, CUdeviceptr src, long ByteCount);
 
 
+    /**
+     * Copies data between two memory regions, determining the direction
+     * of the copy automatically.<br />
+     * <br />
+     * All allocations that are made through JCuda (with cuMemAlloc,
+     * cuMemAllocPitch, cuMemAllocHost, cuMemHostAlloc, cuMemHostRegister
+     * and the host arenas) are recorded natively, together with their
+     * kind and the device of the context that was current when they were
+     * made. This function looks up the given pointers in this record, and
+     * uses the appropriate copy function (cuMemcpyHtoD, cuMemcpyDtoH,
+     * cuMemcpyDtoD or cuMemcpyPeer). Copies between Java arrays or
+     * buffers that are not page-locked are done with a plain memcpy.
+     * When one of the pointers is not known (e.g. because the memory was
+     * allocated by another library), then cuMemcpy is used, which
+     * requires unified virtual addressing.<br />
+     * <br />
+     * The allocations are only recorded after the record has been used
+     * for the first time, by this function, by
+     * {@link #cuMemRegistryLookup} or by the memory governor, so that
+     * allocations do not pay for it otherwise. Allocations that have
+     * been made before are not known. The record only contains the
+     * allocations of the driver API bindings. The allocations of the
+     * runtime API bindings are recorded separately.<br />
+     * <br />
+     * Other than for cuMemcpy, the pointers may refer to Java arrays
+     * or buffers.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param dst Destination pointer
+     * @param src Source pointer
+     * @param ByteCount Size of memory copy in bytes
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuMemcpy
+     * @see JCudaDriver#cuMemRegistryLookup
+     */
+    public static int cuMemcpyAuto(Pointer dst, Pointer src, long ByteCount)
+    {
+        return checkResult(cuMemcpyAutoNative(dst, src, ByteCount));
+    }
+    private static native int cuMemcpyAutoNative(Pointer dst, Pointer src, long ByteCount);
+
+
+    /**
+     * Looks up the given pointer in the record of the allocations that
+     * have been made through JCuda (see {@link #cuMemcpyAuto}). The
+     * memory type will be set to the {@link CUmemorytype} of the
+     * allocation that contains the pointer, or to 0 if the pointer is
+     * not contained in any known allocation. The device will be set to
+     * the device of the context that was current when the allocation
+     * was made, or to -1 if it is not known.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param memoryType Will store the memory type
+     * @param device Will store the device
+     * @param ptr The pointer to look up
+     * @return CUDA_SUCCESS
+     *
+     * @see JCudaDriver#cuMemcpyAuto
+     * @see JCudaDriver#cuPointerGetAttribute
+     */
+    public static int cuMemRegistryLookup(int memoryType[], int device[], Pointer ptr)
+    {
+        return checkResult(cuMemRegistryLookupNative(memoryType, device, ptr));
+    }
+    private static native int cuMemRegistryLookupNative(int memoryType[], int device[], Pointer ptr);
+
+
     /**
      * Copies device memory between two contexts.
      * 
@@ -3927,6 +5009,233 @@ public class JCudaDriver
     private static native int cuMemFreeHostNative(Pointer p);
 
 
+    /**
+     * Sets the placement mode for page-locked host memory that is
+     * allocated with {@link JCudaDriver#cuMemHostAlloc} and
+     * {@link JCudaDriver#cuMemAllocHost}, as one of the
+     * {@link CUhostPlacement} constants.<br />
+     * <br />
+     * With CU_HOST_PLACEMENT_DEVICE, the memory is allocated on the NUMA
+     * node that the device of the current context is attached to, as
+     * reported by {@link JCudaDriver#cuDeviceGetHostNumaNode}, and then
+     * page-locked. Memory that should be write-combined, and memory
+     * for devices whose node is not known, is allocated as usual. The
+     * memory has to be freed with {@link JCudaDriver#cuMemFreeHost}.
+     * Currently, this placement is only supported on Linux.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param mode The CUhostPlacement mode
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuMemHostGetNumaNode
+     */
+    public static int cuMemHostSetPlacement(int mode)
+    {
+        return checkResult(cuMemHostSetPlacementNative(mode));
+    }
+    private static native int cuMemHostSetPlacementNative(int mode);
+
+
+    /**
+     * Returns the NUMA node that the given host memory is located on,
+     * or -1 if this is not known, e.g. because the platform does not
+     * support NUMA, or the memory was not accessed yet.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param node Will store the NUMA node
+     * @param p The host memory
+     *
+     * @return CUDA_SUCCESS
+     *
+     * @see JCudaDriver#cuMemHostSetPlacement
+     */
+    public static int cuMemHostGetNumaNode(int node[], Pointer p)
+    {
+        return checkResult(cuMemHostGetNumaNodeNative(node, p));
+    }
+    private static native int cuMemHostGetNumaNodeNative(int node[], Pointer p);
+
+
+    /**
+     * Returns the NUMA node that the given device is attached to, as
+     * read from the numa_node entry of its PCI bus ID in the sysfs
+     * tree, or -1 if this is not known.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param node Will store the NUMA node
+     * @param dev The device
+     *
+     * @return CUDA_SUCCESS
+     *
+     * @see JCudaDriver#cuMemHostSetPlacement
+     */
+    public static int cuDeviceGetHostNumaNode(int node[], CUdevice dev)
+    {
+        return checkResult(cuDeviceGetHostNumaNodeNative(node, dev));
+    }
+    private static native int cuDeviceGetHostNumaNodeNative(int node[], CUdevice dev);
+
+
+    /**
+     * Creates a new arena for page-locked host memory.<br />
+     * <br />
+     * The arena allocates regions of the given size with
+     * {@link JCudaDriver#cuMemHostAlloc(Pointer, long, int)}, using the
+     * given flags, and hands out slices of these regions that are
+     * aligned to the given alignment. Allocating and freeing a slice
+     * does not involve any call to the driver, except for when the
+     * arena has to allocate a new region. Each thread keeps a small
+     * cache of freed slices, so that allocating and freeing slices
+     * from multiple threads does not cause contention.<br />
+     * <br />
+     * Requests are rounded up to one of the internal size classes. The
+     * largest size class is a quarter of the region size. Larger requests
+     * receive a dedicated allocation, which is released when the slice
+     * is freed.<br />
+     * <br />
+     * The regions are allocated in the current context. Unless the
+     * CU_MEMHOSTALLOC_PORTABLE flag is given, the slices are only
+     * considered as page-locked memory by this context.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param arena Returned arena
+     * @param regionSize The size of the regions, in bytes
+     * @param alignment The alignment of the slices, which must be a
+     * power of two
+     * @param Flags The flags for cuMemHostAlloc
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuMemHostArenaAlloc
+     * @see JCudaDriver#cuMemHostArenaFree
+     * @see JCudaDriver#cuMemHostArenaGetStatistics
+     * @see JCudaDriver#cuMemHostArenaDestroy
+     */
+    public static int cuMemHostArenaCreate(CUmemHostArena arena, long regionSize, long alignment, int Flags)
+    {
+        return checkResult(cuMemHostArenaCreateNative(arena, regionSize, alignment, Flags));
+    }
+    private static native int cuMemHostArenaCreateNative(CUmemHostArena arena, long regionSize, long alignment, int Flags);
+
+
+    /**
+     * Destroys the given arena, and releases all regions of page-locked
+     * memory that are held by the arena. All slices that have been
+     * allocated from this arena become invalid.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param arena The arena to destroy
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuMemHostArenaCreate
+     */
+    public static int cuMemHostArenaDestroy(CUmemHostArena arena)
+    {
+        return checkResult(cuMemHostArenaDestroyNative(arena));
+    }
+    private static native int cuMemHostArenaDestroyNative(CUmemHostArena arena);
+
+
+    /**
+     * Allocates a slice of page-locked host memory from the given arena.
+     * The given pointer will afterwards point to the slice, and
+     * {@link Pointer#getByteBuffer(long, long)} may be used to access
+     * the memory, just as for memory that was allocated with
+     * {@link JCudaDriver#cuMemHostAlloc(Pointer, long, int)}.<br />
+     * <br />
+     * The slice must be freed with
+     * {@link JCudaDriver#cuMemHostArenaFree(CUmemHostArena, Pointer)},
+     * passing in the same pointer object.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param arena The arena
+     * @param pp Returned host pointer to page-locked memory
+     * @param bytesize Requested allocation size in bytes
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE, CUDA_ERROR_INVALID_VALUE,
+     * or the error code of cuMemHostAlloc when a new region could not
+     * be allocated
+     *
+     * @see JCudaDriver#cuMemHostArenaCreate
+     * @see JCudaDriver#cuMemHostArenaFree
+     */
+    public static int cuMemHostArenaAlloc(CUmemHostArena arena, Pointer pp, long bytesize)
+    {
+        return checkResult(cuMemHostArenaAllocNative(arena, pp, bytesize));
+    }
+    private static native int cuMemHostArenaAllocNative(CUmemHostArena arena, Pointer pp, long bytesize);
+
+
+    /**
+     * Returns the given slice to the given arena. The pointer must have
+     * been obtained with
+     * {@link JCudaDriver#cuMemHostArenaAlloc(CUmemHostArena, Pointer, long)}
+     * from the same arena. Afterwards, the pointer is cleared, so
+     * that freeing it again, or freeing a pointer that was not
+     * obtained from the arena, fails with an error instead of
+     * corrupting the arena.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param arena The arena
+     * @param p The pointer to the slice
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuMemHostArenaCreate
+     * @see JCudaDriver#cuMemHostArenaAlloc
+     */
+    public static int cuMemHostArenaFree(CUmemHostArena arena, Pointer p)
+    {
+        return checkResult(cuMemHostArenaFreeNative(arena, p));
+    }
+    private static native int cuMemHostArenaFreeNative(CUmemHostArena arena, Pointer p);
+
+
+    /**
+     * Writes the current statistics of the given arena, including its
+     * high-water mark and fragmentation, into the given object.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param arena The arena
+     * @param statistics Returned statistics
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuMemHostArenaCreate
+     */
+    public static int cuMemHostArenaGetStatistics(CUmemHostArena arena, CUmemHostArenaStatistics statistics)
+    {
+        return checkResult(cuMemHostArenaGetStatisticsNative(arena, statistics));
+    }
+    private static native int cuMemHostArenaGetStatisticsNative(CUmemHostArena arena, CUmemHostArenaStatistics statistics);
+
+
     /**
      * Copies memory from Host to Device.
      * 
@@ -5439,6 +6748,101 @@ public class JCudaDriver
     private static native int cuMemcpyPeerAsyncNative(CUdeviceptr dstDevice, CUcontext dstContext, CUdeviceptr srcDevice, CUcontext srcContext, long ByteCount, CUstream hStream);
 
 
+    /**
+     * Enables the routing of copies between devices with
+     * {@link JCudaDriver#cuMemcpyPeer} and {@link JCudaDriver#cuMemcpyPeerAsync}.
+     * When it is enabled for the first time, the topology is discovered:
+     * Which devices may access each other, and their PCI bus IDs. Peer
+     * access between two devices is enabled when the first copy between
+     * them is made. Copies between devices that can not access each
+     * other are split into chunks of the given size, and staged through
+     * two page-locked buffers, so that the transfers out of the source
+     * device overlap with the transfers into the destination device.<br />
+     * <br />
+     * For an asynchronous copy that is staged, the given stream must
+     * belong to the destination context.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param chunkSize The size of the chunks of staged copies, in bytes
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE,
+     * CUDA_ERROR_NOT_INITIALIZED
+     *
+     * @see JCudaDriver#cuPeerRouterGetRoute
+     */
+    public static int cuPeerRouterEnable(long chunkSize)
+    {
+        return checkResult(cuPeerRouterEnableNative(chunkSize));
+    }
+    private static native int cuPeerRouterEnableNative(long chunkSize);
+
+
+    /**
+     * Disables the routing of copies between devices, after all staged
+     * copies have been completed, and releases the staging buffers.
+     * Peer access that has been enabled remains enabled.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @return CUDA_SUCCESS
+     */
+    public static int cuPeerRouterDisable()
+    {
+        return checkResult(cuPeerRouterDisableNative());
+    }
+    private static native int cuPeerRouterDisableNative();
+
+
+    /**
+     * Returns the route that is taken for copies from the given source
+     * device to the given destination device, as one of the
+     * {@link CUpeerRoute} constants.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param route Will store the route
+     * @param srcDevice The source device ordinal
+     * @param dstDevice The destination device ordinal
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_NOT_INITIALIZED
+     */
+    public static int cuPeerRouterGetRoute(int route[], int srcDevice, int dstDevice)
+    {
+        return checkResult(cuPeerRouterGetRouteNative(route, srcDevice, dstDevice));
+    }
+    private static native int cuPeerRouterGetRouteNative(int route[], int srcDevice, int dstDevice);
+
+
+    /**
+     * Returns the number of copies and bytes that have been routed
+     * while the router was enabled, directly or staged through host
+     * memory.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param directCount Will store the number of direct copies
+     * @param directBytes Will store the number of bytes of direct copies
+     * @param stagedCount Will store the number of staged copies
+     * @param stagedBytes Will store the number of bytes of staged copies
+     *
+     * @return CUDA_SUCCESS
+     */
+    public static int cuPeerRouterGetStatistics(long directCount[], long directBytes[], long stagedCount[], long stagedBytes[])
+    {
+        return checkResult(cuPeerRouterGetStatisticsNative(directCount, directBytes, stagedCount, stagedBytes));
+    }
+    private static native int cuPeerRouterGetStatisticsNative(long directCount[], long directBytes[], long stagedCount[], long stagedBytes[]);
+
+
     /**
      * Copies memory from Host to Device.
      * 
@@ -5618,100 +7022,432 @@ public class JCudaDriver
 
     private static native int cuMemcpyDtoHAsyncNative(Pointer dstHost,CUdeviceptr srcDevice, long ByteCount, CUstream hStream);
 
+
     /**
-     * Copies memory from Device to Device.
-     * 
-     * <pre>
-     * CUresult cuMemcpyDtoDAsync (
-     *      CUdeviceptr dstDevice,
-     *      CUdeviceptr srcDevice,
-     *      size_t ByteCount,
-     *      CUstream hStream )
-     * </pre>
-     * <div>
-     *   <p>Copies memory from Device to Device. 
-     *     Copies from device memory to device memory. <tt>dstDevice</tt> and
-     *     <tt>srcDevice</tt> are the base pointers of the destination and
-     *     source, respectively. <tt>ByteCount</tt> specifies the number of bytes
-     *     to copy. Note that this function is asynchronous and can optionally be
-     *     associated to a stream
-     *     by passing a non-zero <tt>hStream</tt>
-     *     argument
-     *   </p>
-     *   <div>
-     *     <span>Note:</span>
-     *     <p>Note that this
-     *       function may also return error codes from previous, asynchronous
-     *       launches.
-     *     </p>
-     *   </div>
-     *   </p>
-     * </div>
-     * 
-     * @param dstDevice Destination device pointer
-     * @param srcDevice Source device pointer
-     * @param ByteCount Size of memory copy in bytes
-     * @param hStream Stream identifier
-     * 
-     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
-     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE
-     * 
-     * @see JCudaDriver#cuArray3DCreate
-     * @see JCudaDriver#cuArray3DGetDescriptor
-     * @see JCudaDriver#cuArrayCreate
-     * @see JCudaDriver#cuArrayDestroy
-     * @see JCudaDriver#cuArrayGetDescriptor
-     * @see JCudaDriver#cuMemAlloc
-     * @see JCudaDriver#cuMemAllocHost
-     * @see JCudaDriver#cuMemAllocPitch
-     * @see JCudaDriver#cuMemcpy2D
-     * @see JCudaDriver#cuMemcpy2DAsync
-     * @see JCudaDriver#cuMemcpy2DUnaligned
-     * @see JCudaDriver#cuMemcpy3D
-     * @see JCudaDriver#cuMemcpy3DAsync
-     * @see JCudaDriver#cuMemcpyAtoA
-     * @see JCudaDriver#cuMemcpyAtoD
-     * @see JCudaDriver#cuMemcpyAtoH
-     * @see JCudaDriver#cuMemcpyAtoHAsync
-     * @see JCudaDriver#cuMemcpyDtoA
-     * @see JCudaDriver#cuMemcpyDtoD
-     * @see JCudaDriver#cuMemcpyDtoH
-     * @see JCudaDriver#cuMemcpyDtoHAsync
-     * @see JCudaDriver#cuMemcpyHtoA
-     * @see JCudaDriver#cuMemcpyHtoAAsync
-     * @see JCudaDriver#cuMemcpyHtoD
-     * @see JCudaDriver#cuMemcpyHtoDAsync
-     * @see JCudaDriver#cuMemFree
-     * @see JCudaDriver#cuMemFreeHost
-     * @see JCudaDriver#cuMemGetAddressRange
-     * @see JCudaDriver#cuMemGetInfo
-     * @see JCudaDriver#cuMemHostAlloc
-     * @see JCudaDriver#cuMemHostGetDevicePointer
-     * @see JCudaDriver#cuMemsetD2D8
-     * @see JCudaDriver#cuMemsetD2D8Async
-     * @see JCudaDriver#cuMemsetD2D16
-     * @see JCudaDriver#cuMemsetD2D16Async
-     * @see JCudaDriver#cuMemsetD2D32
-     * @see JCudaDriver#cuMemsetD2D32Async
-     * @see JCudaDriver#cuMemsetD8
-     * @see JCudaDriver#cuMemsetD8Async
-     * @see JCudaDriver#cuMemsetD16
-     * @see JCudaDriver#cuMemsetD16Async
-     * @see JCudaDriver#cuMemsetD32
-     * @see JCudaDriver#cuMemsetD32Async
-     */    
-    public static int cuMemcpyDtoDAsync(CUdeviceptr dstDevice,CUdeviceptr srcDevice, long ByteCount, CUstream hStream)
+     * Creates a new transfer engine for large transfers between the
+     * host and the device.<br />
+     * <br />
+     * The engine splits each transfer into chunks of the given size,
+     * and distributes the chunks over the given number of streams. An
+     * event is recorded after each chunk, so that kernels that consume
+     * the first chunks may start while later chunks are still being
+     * transferred (see
+     * {@link JCudaDriver#cuTransferStreamWait(CUtransfer, CUstream, long, long)}).
+     * Pageable host memory (including Java arrays) is copied through a
+     * ring of page-locked staging buffers of the chunk size, two for each
+     * stream, so that copying the data on the host overlaps with the
+     * transfers of the previous chunks. Page-locked host memory is
+     * transferred directly.<br />
+     * <br />
+     * The streams and staging buffers are created in the current context,
+     * which must be current whenever the engine is used. Transfers may
+     * be issued by several threads, which share the staging buffers.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param engine Returned engine
+     * @param chunkSize The size of the chunks, in bytes
+     * @param streamCount The number of streams
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE, CUDA_ERROR_INVALID_CONTEXT,
+     * CUDA_ERROR_OUT_OF_MEMORY
+     *
+     * @see JCudaDriver#cuTransferHtoD
+     * @see JCudaDriver#cuTransferDtoH
+     * @see JCudaDriver#cuTransferEngineGetStatistics
+     * @see JCudaDriver#cuTransferEngineDestroy
+     */
+    public static int cuTransferEngineCreate(CUtransferEngine engine, long chunkSize, int streamCount)
     {
-        return checkResult(cuMemcpyDtoDAsyncNative(dstDevice, srcDevice, ByteCount, hStream));
+        return checkResult(cuTransferEngineCreateNative(engine, chunkSize, streamCount));
     }
+    private static native int cuTransferEngineCreateNative(CUtransferEngine engine, long chunkSize, int streamCount);
 
-    private static native int cuMemcpyDtoDAsyncNative(CUdeviceptr dstDevice,CUdeviceptr srcDevice, long ByteCount, CUstream hStream);
+
+    /**
+     * Destroys the given transfer engine, after waiting for all pending
+     * transfers. Transfers of this engine that have not been destroyed
+     * become invalid.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param engine The engine to destroy
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuTransferEngineCreate
+     */
+    public static int cuTransferEngineDestroy(CUtransferEngine engine)
+    {
+        return checkResult(cuTransferEngineDestroyNative(engine));
+    }
+    private static native int cuTransferEngineDestroyNative(CUtransferEngine engine);
 
 
     /**
-     * Copies memory from Host to Array.
-     * 
-     * <pre>
+     * Obtains the cumulative statistics of all completed transfers of
+     * the given engine, including the achieved bandwidth. A transfer is
+     * counted as completed when its completion has been observed with
+     * {@link JCudaDriver#cuTransferQuery}, {@link JCudaDriver#cuTransferSynchronize},
+     * {@link JCudaDriver#cuTransferGetStatistics} or
+     * {@link JCudaDriver#cuTransferDestroy}.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param engine The engine
+     * @param statistics Returned statistics
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuTransferEngineCreate
+     */
+    public static int cuTransferEngineGetStatistics(CUtransferEngine engine, CUtransferStatistics statistics)
+    {
+        return checkResult(cuTransferEngineGetStatisticsNative(engine, statistics));
+    }
+    private static native int cuTransferEngineGetStatisticsNative(CUtransferEngine engine, CUtransferStatistics statistics);
+
+
+    /**
+     * Copies memory from the host to the device, using the given
+     * transfer engine.<br />
+     * <br />
+     * If the host memory is page-locked, then the transfer is
+     * asynchronous, and the host memory must not be modified until
+     * the transfer is complete. Otherwise, the host memory may be
+     * re-used when this call returns, but the last chunks may still
+     * be in flight.<br />
+     * <br />
+     * If the given stream is not <code>null</code>, then the transfer
+     * starts after all preceding work in this stream is complete.<br />
+     * <br />
+     * The returned transfer must be destroyed with
+     * {@link JCudaDriver#cuTransferDestroy(CUtransfer)}.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param engine The engine
+     * @param transfer Returned transfer
+     * @param dstDevice Destination device pointer
+     * @param srcHost Source host pointer
+     * @param ByteCount Size of memory copy in bytes
+     * @param hStream The stream to wait for, or <code>null</code>
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuTransferStreamWait
+     * @see JCudaDriver#cuTransferSynchronize
+     * @see JCudaDriver#cuTransferDestroy
+     */
+    public static int cuTransferHtoD(CUtransferEngine engine, CUtransfer transfer, CUdeviceptr dstDevice, Pointer srcHost, long ByteCount, CUstream hStream)
+    {
+        return checkResult(cuTransferHtoDNative(engine, transfer, dstDevice, srcHost, ByteCount, hStream));
+    }
+    private static native int cuTransferHtoDNative(CUtransferEngine engine, CUtransfer transfer, CUdeviceptr dstDevice, Pointer srcHost, long ByteCount, CUstream hStream);
+
+
+    /**
+     * Copies memory from the device to the host, using the given
+     * transfer engine.<br />
+     * <br />
+     * If the host memory is page-locked, then the transfer is
+     * asynchronous, and the host memory may only be read after the
+     * respective chunks have been transferred. Otherwise, this call
+     * returns when all data has been written into the host memory.<br />
+     * <br />
+     * If the given stream is not <code>null</code>, then the transfer
+     * starts after all preceding work in this stream is complete.<br />
+     * <br />
+     * The returned transfer must be destroyed with
+     * {@link JCudaDriver#cuTransferDestroy(CUtransfer)}.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param engine The engine
+     * @param transfer Returned transfer
+     * @param dstHost Destination host pointer
+     * @param srcDevice Source device pointer
+     * @param ByteCount Size of memory copy in bytes
+     * @param hStream The stream to wait for, or <code>null</code>
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuTransferSynchronize
+     * @see JCudaDriver#cuTransferDestroy
+     */
+    public static int cuTransferDtoH(CUtransferEngine engine, CUtransfer transfer, Pointer dstHost, CUdeviceptr srcDevice, long ByteCount, CUstream hStream)
+    {
+        return checkResult(cuTransferDtoHNative(engine, transfer, dstHost, srcDevice, ByteCount, hStream));
+    }
+    private static native int cuTransferDtoHNative(CUtransferEngine engine, CUtransfer transfer, Pointer dstHost, CUdeviceptr srcDevice, long ByteCount, CUstream hStream);
+
+
+    /**
+     * Returns the number of chunks of the given transfer in
+     * <code>count[0]</code>.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param transfer The transfer
+     * @param count Returned number of chunks
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuTransferGetChunkEvent
+     */
+    public static int cuTransferGetChunkCount(CUtransfer transfer, int count[])
+    {
+        return checkResult(cuTransferGetChunkCountNative(transfer, count));
+    }
+    private static native int cuTransferGetChunkCountNative(CUtransfer transfer, int count[]);
+
+
+    /**
+     * Returns the event that is recorded after the given chunk of the
+     * given transfer has been transferred. The event is owned by the
+     * transfer, and may not be used after the transfer was destroyed.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param transfer The transfer
+     * @param chunk The index of the chunk
+     * @param event Returned event
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuTransferGetChunkCount
+     * @see JCudaDriver#cuStreamWaitEvent
+     */
+    public static int cuTransferGetChunkEvent(CUtransfer transfer, int chunk, CUevent event)
+    {
+        return checkResult(cuTransferGetChunkEventNative(transfer, chunk, event));
+    }
+    private static native int cuTransferGetChunkEventNative(CUtransfer transfer, int chunk, CUevent event);
+
+
+    /**
+     * Makes all future work submitted to the given stream wait until
+     * the given range of bytes of the given transfer has been
+     * transferred. The range is relative to the start of the
+     * transfer.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param transfer The transfer
+     * @param hStream The stream that should wait
+     * @param byteOffset The offset of the range, in bytes
+     * @param ByteCount The size of the range, in bytes
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuTransferHtoD
+     */
+    public static int cuTransferStreamWait(CUtransfer transfer, CUstream hStream, long byteOffset, long ByteCount)
+    {
+        return checkResult(cuTransferStreamWaitNative(transfer, hStream, byteOffset, ByteCount));
+    }
+    private static native int cuTransferStreamWaitNative(CUtransfer transfer, CUstream hStream, long byteOffset, long ByteCount);
+
+
+    /**
+     * Returns CUDA_SUCCESS if all chunks of the given transfer have been
+     * transferred, and CUDA_ERROR_NOT_READY otherwise.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param transfer The transfer
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_NOT_READY, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuTransferSynchronize
+     */
+    public static int cuTransferQuery(CUtransfer transfer)
+    {
+        return checkResult(cuTransferQueryNative(transfer));
+    }
+    private static native int cuTransferQueryNative(CUtransfer transfer);
+
+
+    /**
+     * Waits until all chunks of the given transfer have been
+     * transferred.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param transfer The transfer
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuTransferQuery
+     */
+    public static int cuTransferSynchronize(CUtransfer transfer)
+    {
+        return checkResult(cuTransferSynchronizeNative(transfer));
+    }
+    private static native int cuTransferSynchronizeNative(CUtransfer transfer);
+
+
+    /**
+     * Obtains the statistics of the given transfer, including the time
+     * that it took on the device and the achieved bandwidth. Returns
+     * CUDA_ERROR_NOT_READY if the transfer is not complete yet.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param transfer The transfer
+     * @param statistics Returned statistics
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_NOT_READY, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuTransferEngineGetStatistics
+     */
+    public static int cuTransferGetStatistics(CUtransfer transfer, CUtransferStatistics statistics)
+    {
+        return checkResult(cuTransferGetStatisticsNative(transfer, statistics));
+    }
+    private static native int cuTransferGetStatisticsNative(CUtransfer transfer, CUtransferStatistics statistics);
+
+
+    /**
+     * Destroys the given transfer. If the transfer is not complete yet,
+     * then the remaining chunks are still transferred, but the transfer
+     * is not contained in the statistics of the engine.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param transfer The transfer
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuTransferHtoD
+     * @see JCudaDriver#cuTransferDtoH
+     */
+    public static int cuTransferDestroy(CUtransfer transfer)
+    {
+        return checkResult(cuTransferDestroyNative(transfer));
+    }
+    private static native int cuTransferDestroyNative(CUtransfer transfer);
+
+    /**
+     * Copies memory from Device to Device.
+     * 
+     * <pre>
+     * CUresult cuMemcpyDtoDAsync (
+     *      CUdeviceptr dstDevice,
+     *      CUdeviceptr srcDevice,
+     *      size_t ByteCount,
+     *      CUstream hStream )
+     * </pre>
+     * <div>
+     *   <p>Copies memory from Device to Device. 
+     *     Copies from device memory to device memory. <tt>dstDevice</tt> and
+     *     <tt>srcDevice</tt> are the base pointers of the destination and
+     *     source, respectively. <tt>ByteCount</tt> specifies the number of bytes
+     *     to copy. Note that this function is asynchronous and can optionally be
+     *     associated to a stream
+     *     by passing a non-zero <tt>hStream</tt>
+     *     argument
+     *   </p>
+     *   <div>
+     *     <span>Note:</span>
+     *     <p>Note that this
+     *       function may also return error codes from previous, asynchronous
+     *       launches.
+     *     </p>
+     *   </div>
+     *   </p>
+     * </div>
+     * 
+     * @param dstDevice Destination device pointer
+     * @param srcDevice Source device pointer
+     * @param ByteCount Size of memory copy in bytes
+     * @param hStream Stream identifier
+     * 
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE
+     * 
+     * @see JCudaDriver#cuArray3DCreate
+     * @see JCudaDriver#cuArray3DGetDescriptor
+     * @see JCudaDriver#cuArrayCreate
+     * @see JCudaDriver#cuArrayDestroy
+     * @see JCudaDriver#cuArrayGetDescriptor
+     * @see JCudaDriver#cuMemAlloc
+     * @see JCudaDriver#cuMemAllocHost
+     * @see JCudaDriver#cuMemAllocPitch
+     * @see JCudaDriver#cuMemcpy2D
+     * @see JCudaDriver#cuMemcpy2DAsync
+     * @see JCudaDriver#cuMemcpy2DUnaligned
+     * @see JCudaDriver#cuMemcpy3D
+     * @see JCudaDriver#cuMemcpy3DAsync
+     * @see JCudaDriver#cuMemcpyAtoA
+     * @see JCudaDriver#cuMemcpyAtoD
+     * @see JCudaDriver#cuMemcpyAtoH
+     * @see JCudaDriver#cuMemcpyAtoHAsync
+     * @see JCudaDriver#cuMemcpyDtoA
+     * @see JCudaDriver#cuMemcpyDtoD
+     * @see JCudaDriver#cuMemcpyDtoH
+     * @see JCudaDriver#cuMemcpyDtoHAsync
+     * @see JCudaDriver#cuMemcpyHtoA
+     * @see JCudaDriver#cuMemcpyHtoAAsync
+     * @see JCudaDriver#cuMemcpyHtoD
+     * @see JCudaDriver#cuMemcpyHtoDAsync
+     * @see JCudaDriver#cuMemFree
+     * @see JCudaDriver#cuMemFreeHost
+     * @see JCudaDriver#cuMemGetAddressRange
+     * @see JCudaDriver#cuMemGetInfo
+     * @see JCudaDriver#cuMemHostAlloc
+     * @see JCudaDriver#cuMemHostGetDevicePointer
+     * @see JCudaDriver#cuMemsetD2D8
+     * @see JCudaDriver#cuMemsetD2D8Async
+     * @see JCudaDriver#cuMemsetD2D16
+     * @see JCudaDriver#cuMemsetD2D16Async
+     * @see JCudaDriver#cuMemsetD2D32
+     * @see JCudaDriver#cuMemsetD2D32Async
+     * @see JCudaDriver#cuMemsetD8
+     * @see JCudaDriver#cuMemsetD8Async
+     * @see JCudaDriver#cuMemsetD16
+     * @see JCudaDriver#cuMemsetD16Async
+     * @see JCudaDriver#cuMemsetD32
+     * @see JCudaDriver#cuMemsetD32Async
+     */    
+    public static int cuMemcpyDtoDAsync(CUdeviceptr dstDevice,CUdeviceptr srcDevice, long ByteCount, CUstream hStream)
+    {
+        return checkResult(cuMemcpyDtoDAsyncNative(dstDevice, srcDevice, ByteCount, hStream));
+    }
+
+    private static native int cuMemcpyDtoDAsyncNative(CUdeviceptr dstDevice,CUdeviceptr srcDevice, long ByteCount, CUstream hStream);
+
+
+    /**
+     * Copies memory from Host to Array.
+     * 
+     * <pre>
      * CUresult cuMemcpyHtoAAsync (
      *      CUarray dstArray,
      *      size_t dstOffset,
@@ -6424,55 +8160,376 @@ public class JCudaDriver
 
 
     /**
-     * Initializes device memory.
-     * 
-     * <pre>
-     * CUresult cuMemsetD8 (
-     *      CUdeviceptr dstDevice,
-     *      unsigned char  uc,
-     *      size_t N )
-     * </pre>
-     * <div>
-     *   <p>Initializes device memory.  Sets the
-     *     memory range of <tt>N</tt> 8-bit values to the specified value <tt>uc</tt>.
-     *   </p>
-     *   <p>Note that this function is asynchronous
-     *     with respect to the host unless <tt>dstDevice</tt> refers to pinned
-     *     host memory.
-     *   </p>
-     *   <div>
-     *     <span>Note:</span>
-     *     <p>Note that this
-     *       function may also return error codes from previous, asynchronous
-     *       launches.
-     *     </p>
-     *   </div>
-     *   </p>
-     * </div>
-     * 
-     * @param dstDevice Destination device pointer
-     * @param uc Value to set
-     * @param N Number of elements
-     * 
-     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
-     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE
-     * 
-     * @see JCudaDriver#cuArray3DCreate
-     * @see JCudaDriver#cuArray3DGetDescriptor
-     * @see JCudaDriver#cuArrayCreate
-     * @see JCudaDriver#cuArrayDestroy
-     * @see JCudaDriver#cuArrayGetDescriptor
-     * @see JCudaDriver#cuMemAlloc
-     * @see JCudaDriver#cuMemAllocHost
-     * @see JCudaDriver#cuMemAllocPitch
-     * @see JCudaDriver#cuMemcpy2D
-     * @see JCudaDriver#cuMemcpy2DAsync
-     * @see JCudaDriver#cuMemcpy2DUnaligned
-     * @see JCudaDriver#cuMemcpy3D
-     * @see JCudaDriver#cuMemcpy3DAsync
-     * @see JCudaDriver#cuMemcpyAtoA
-     * @see JCudaDriver#cuMemcpyAtoD
-     * @see JCudaDriver#cuMemcpyAtoH
+     * Initializes the given memory copy descriptor. This allocates the
+     * native structure that stores the fields of the descriptor. All
+     * fields are initially 0 or <code>null</code>.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param descriptor The descriptor
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuMemcpyDescriptorDestroy
+     */
+    public static int cuMemcpyDescriptorCreate(CUmemcpyDescriptor descriptor)
+    {
+        if (descriptor == null)
+        {
+            throw new NullPointerException(
+                "Parameter 'descriptor' is null for cuMemcpyDescriptorCreate");
+        }
+        return checkResult(cuMemcpyDescriptorCreateNative(descriptor, descriptor.getDescriptorType()));
+    }
+    private static native int cuMemcpyDescriptorCreateNative(CUmemcpyDescriptor descriptor, int type);
+
+
+    /**
+     * Destroys the given memory copy descriptor, releasing its native
+     * structure.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param descriptor The descriptor
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuMemcpyDescriptorCreate
+     */
+    public static int cuMemcpyDescriptorDestroy(CUmemcpyDescriptor descriptor)
+    {
+        return checkResult(cuMemcpyDescriptorDestroyNative(descriptor));
+    }
+    private static native int cuMemcpyDescriptorDestroyNative(CUmemcpyDescriptor descriptor);
+
+
+    /**
+     * Stores the address that the given object refers to in the field
+     * with the given index of the given memory copy descriptor. The
+     * field index is one of the constants of the descriptor class, and
+     * must refer to a host pointer, device pointer, array or context
+     * field. Host pointers must refer to native memory, because the
+     * address is accessed in later copies. The typed setters of the
+     * descriptor classes delegate to this function.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param descriptor The descriptor
+     * @param field The field index
+     * @param pointer The pointer, array or context. May be
+     * <code>null</code>.
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_INVALID_VALUE
+     */
+    public static int cuMemcpyDescriptorSetPointer(CUmemcpyDescriptor descriptor, int field, NativePointerObject pointer)
+    {
+        return checkResult(cuMemcpyDescriptorSetPointerNative(descriptor, field, pointer));
+    }
+    private static native int cuMemcpyDescriptorSetPointerNative(CUmemcpyDescriptor descriptor, int field, NativePointerObject pointer);
+
+
+    /**
+     * Performs a memory copy according to the given descriptor. This
+     * is equivalent to {@link JCudaDriver#cuMemcpy2D(CUDA_MEMCPY2D)}, but
+     * the parameters are read from the native structure of the
+     * descriptor, without accessing any Java fields.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pCopy Parameters for the memory copy
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuMemcpyDescriptorCreate
+     */
+    public static int cuMemcpy2D(CUmemcpy2DDescriptor pCopy)
+    {
+        return checkResult(cuMemcpy2DDescriptorNative(pCopy));
+    }
+    private static native int cuMemcpy2DDescriptorNative(CUmemcpy2DDescriptor pCopy);
+
+
+    /**
+     * Performs a memory copy according to the given descriptor. This
+     * is equivalent to {@link JCudaDriver#cuMemcpy2DUnaligned(CUDA_MEMCPY2D)}, but
+     * the parameters are read from the native structure of the
+     * descriptor, without accessing any Java fields.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pCopy Parameters for the memory copy
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuMemcpyDescriptorCreate
+     */
+    public static int cuMemcpy2DUnaligned(CUmemcpy2DDescriptor pCopy)
+    {
+        return checkResult(cuMemcpy2DUnalignedDescriptorNative(pCopy));
+    }
+    private static native int cuMemcpy2DUnalignedDescriptorNative(CUmemcpy2DDescriptor pCopy);
+
+
+    /**
+     * Performs a memory copy according to the given descriptor. This
+     * is equivalent to {@link JCudaDriver#cuMemcpy2DAsync(CUDA_MEMCPY2D, CUstream)}, but
+     * the parameters are read from the native structure of the
+     * descriptor, without accessing any Java fields.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pCopy Parameters for the memory copy
+     * @param hStream Stream identifier
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuMemcpyDescriptorCreate
+     */
+    public static int cuMemcpy2DAsync(CUmemcpy2DDescriptor pCopy, CUstream hStream)
+    {
+        return checkResult(cuMemcpy2DAsyncDescriptorNative(pCopy, hStream));
+    }
+    private static native int cuMemcpy2DAsyncDescriptorNative(CUmemcpy2DDescriptor pCopy, CUstream hStream);
+
+
+    /**
+     * Performs a memory copy according to the given descriptor. This
+     * is equivalent to {@link JCudaDriver#cuMemcpy3D(CUDA_MEMCPY3D)}, but
+     * the parameters are read from the native structure of the
+     * descriptor, without accessing any Java fields.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pCopy Parameters for the memory copy
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuMemcpyDescriptorCreate
+     */
+    public static int cuMemcpy3D(CUmemcpy3DDescriptor pCopy)
+    {
+        return checkResult(cuMemcpy3DDescriptorNative(pCopy));
+    }
+    private static native int cuMemcpy3DDescriptorNative(CUmemcpy3DDescriptor pCopy);
+
+
+    /**
+     * Performs a memory copy according to the given descriptor. This
+     * is equivalent to {@link JCudaDriver#cuMemcpy3DAsync(CUDA_MEMCPY3D, CUstream)}, but
+     * the parameters are read from the native structure of the
+     * descriptor, without accessing any Java fields.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pCopy Parameters for the memory copy
+     * @param hStream Stream identifier
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuMemcpyDescriptorCreate
+     */
+    public static int cuMemcpy3DAsync(CUmemcpy3DDescriptor pCopy, CUstream hStream)
+    {
+        return checkResult(cuMemcpy3DAsyncDescriptorNative(pCopy, hStream));
+    }
+    private static native int cuMemcpy3DAsyncDescriptorNative(CUmemcpy3DDescriptor pCopy, CUstream hStream);
+
+
+    /**
+     * Performs a memory copy according to the given descriptor. This
+     * is equivalent to {@link JCudaDriver#cuMemcpy3DPeer(CUDA_MEMCPY3D_PEER)}, but
+     * the parameters are read from the native structure of the
+     * descriptor, without accessing any Java fields.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pCopy Parameters for the memory copy
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuMemcpyDescriptorCreate
+     */
+    public static int cuMemcpy3DPeer(CUmemcpy3DPeerDescriptor pCopy)
+    {
+        return checkResult(cuMemcpy3DPeerDescriptorNative(pCopy));
+    }
+    private static native int cuMemcpy3DPeerDescriptorNative(CUmemcpy3DPeerDescriptor pCopy);
+
+
+    /**
+     * Performs a memory copy according to the given descriptor. This
+     * is equivalent to {@link JCudaDriver#cuMemcpy3DPeerAsync(CUDA_MEMCPY3D_PEER, CUstream)}, but
+     * the parameters are read from the native structure of the
+     * descriptor, without accessing any Java fields.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pCopy Parameters for the memory copy
+     * @param hStream Stream identifier
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuMemcpyDescriptorCreate
+     */
+    public static int cuMemcpy3DPeerAsync(CUmemcpy3DPeerDescriptor pCopy, CUstream hStream)
+    {
+        return checkResult(cuMemcpy3DPeerAsyncDescriptorNative(pCopy, hStream));
+    }
+    private static native int cuMemcpy3DPeerAsyncDescriptorNative(CUmemcpy3DPeerDescriptor pCopy, CUstream hStream);
+
+
+    /**
+     * Performs a batch of 2D copies of sub-rectangles between the source
+     * and the destination of the given descriptor. The memory types,
+     * pointers, arrays and pitches are taken from the descriptor. The
+     * rectangles are given as a packed array, with 6 values for each
+     * rectangle:
+     * <pre>
+     *   srcXInBytes, srcY, dstXInBytes, dstY, WidthInBytes, Height
+     * </pre>
+     * The copies are issued in the given stream in a native loop.
+     * Consecutive rectangles that are adjacent in the source and in the
+     * destination and together form a rectangle (e.g. the tiles of one
+     * row of an image) are coalesced into a single copy.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pCopy The descriptor for the source and destination
+     * @param rects The packed rectangles
+     * @param count The number of rectangles
+     * @param hStream Stream identifier
+     * @param copies Returned number of copies that have been issued
+     * after coalescing. May be <code>null</code>.
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuMemcpy2DAsync(CUmemcpy2DDescriptor, CUstream)
+     */
+    public static int cuMemcpy2DBatchAsync(CUmemcpy2DDescriptor pCopy, long rects[], int count, CUstream hStream, int copies[])
+    {
+        return checkResult(cuMemcpy2DBatchAsyncNative(pCopy, rects, count, hStream, copies));
+    }
+    private static native int cuMemcpy2DBatchAsyncNative(CUmemcpy2DDescriptor pCopy, long rects[], int count, CUstream hStream, int copies[]);
+
+
+    /**
+     * Performs a batch of 3D copies of sub-boxes between the source and
+     * the destination of the given descriptor. The memory types,
+     * pointers, arrays, pitches and heights are taken from the descriptor.
+     * The boxes are given as a packed array, with 9 values for each box:
+     * <pre>
+     *   srcXInBytes, srcY, srcZ, dstXInBytes, dstY, dstZ,
+     *   WidthInBytes, Height, Depth
+     * </pre>
+     * The copies are issued in the given stream in a native loop.
+     * Consecutive boxes that are adjacent in the source and in the
+     * destination and together form a box are coalesced into a single
+     * copy.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pCopy The descriptor for the source and destination
+     * @param rects The packed boxes
+     * @param count The number of boxes
+     * @param hStream Stream identifier
+     * @param copies Returned number of copies that have been issued
+     * after coalescing. May be <code>null</code>.
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuMemcpy3DAsync(CUmemcpy3DDescriptor, CUstream)
+     */
+    public static int cuMemcpy3DBatchAsync(CUmemcpy3DDescriptor pCopy, long rects[], int count, CUstream hStream, int copies[])
+    {
+        return checkResult(cuMemcpy3DBatchAsyncNative(pCopy, rects, count, hStream, copies));
+    }
+    private static native int cuMemcpy3DBatchAsyncNative(CUmemcpy3DDescriptor pCopy, long rects[], int count, CUstream hStream, int copies[]);
+
+
+    /**
+     * Initializes device memory.
+     * 
+     * <pre>
+     * CUresult cuMemsetD8 (
+     *      CUdeviceptr dstDevice,
+     *      unsigned char  uc,
+     *      size_t N )
+     * </pre>
+     * <div>
+     *   <p>Initializes device memory.  Sets the
+     *     memory range of <tt>N</tt> 8-bit values to the specified value <tt>uc</tt>.
+     *   </p>
+     *   <p>Note that this function is asynchronous
+     *     with respect to the host unless <tt>dstDevice</tt> refers to pinned
+     *     host memory.
+     *   </p>
+     *   <div>
+     *     <span>Note:</span>
+     *     <p>Note that this
+     *       function may also return error codes from previous, asynchronous
+     *       launches.
+     *     </p>
+     *   </div>
+     *   </p>
+     * </div>
+     * 
+     * @param dstDevice Destination device pointer
+     * @param uc Value to set
+     * @param N Number of elements
+     * 
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE
+     * 
+     * @see JCudaDriver#cuArray3DCreate
+     * @see JCudaDriver#cuArray3DGetDescriptor
+     * @see JCudaDriver#cuArrayCreate
+     * @see JCudaDriver#cuArrayDestroy
+     * @see JCudaDriver#cuArrayGetDescriptor
+     * @see JCudaDriver#cuMemAlloc
+     * @see JCudaDriver#cuMemAllocHost
+     * @see JCudaDriver#cuMemAllocPitch
+     * @see JCudaDriver#cuMemcpy2D
+     * @see JCudaDriver#cuMemcpy2DAsync
+     * @see JCudaDriver#cuMemcpy2DUnaligned
+     * @see JCudaDriver#cuMemcpy3D
+     * @see JCudaDriver#cuMemcpy3DAsync
+     * @see JCudaDriver#cuMemcpyAtoA
+     * @see JCudaDriver#cuMemcpyAtoD
+     * @see JCudaDriver#cuMemcpyAtoH
      * @see JCudaDriver#cuMemcpyAtoHAsync
      * @see JCudaDriver#cuMemcpyDtoA
      * @see JCudaDriver#cuMemcpyDtoD
@@ -7616,6 +9673,160 @@ public class JCudaDriver
     private static native int cuFuncGetAttributeNative(int pi[], int attrib, CUfunction func);
 
 
+    /**
+     * Computes the occupancy for launching the given function on the
+     * given device with the given block size and number of bytes of
+     * dynamic shared memory per block. The result is computed from the
+     * register and shared memory usage of the function, as reported by
+     * cuFuncGetAttribute, and the limits of the multiprocessors of the
+     * device, in the same way as the CUDA occupancy calculator. No
+     * kernel is launched.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param occupancy Will store the occupancy
+     * @param f Function to compute the occupancy for
+     * @param dev Device that the function will be launched on
+     * @param blockSize Number of threads per block
+     * @param dynamicSharedMemBytes Dynamic shared memory per block, in bytes
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_HANDLE, CUDA_ERROR_INVALID_DEVICE
+     *
+     * @see JCudaDriver#cuOccupancyRecommend
+     * @see JCudaDriver#cuOccupancyAutotune
+     * @see JCudaDriver#cuFuncGetAttribute
+     */
+    public static int cuOccupancyCalculate(CUoccupancy occupancy, CUfunction f, CUdevice dev, int blockSize, int dynamicSharedMemBytes)
+    {
+        return checkResult(cuOccupancyCalculateNative(occupancy, f, dev, blockSize, dynamicSharedMemBytes));
+    }
+    private static native int cuOccupancyCalculateNative(CUoccupancy occupancy, CUfunction f, CUdevice dev, int blockSize, int dynamicSharedMemBytes);
+
+
+    /**
+     * Computes the block size that achieves the highest occupancy when
+     * launching the given function on the given device. The dynamic
+     * shared memory for a block size is assumed to be
+     * <code>dynamicSharedMemBytes + blockSize * dynamicSharedMemBytesPerThread</code>.
+     * If the blockSizeLimit is positive, then only block sizes up to
+     * this limit are considered. When several block sizes achieve the
+     * same occupancy, the largest one is chosen.<br />
+     * <br />
+     * The maxDynamicSharedMemBytes of the result is the number of bytes
+     * of dynamic shared memory that each block may use without reducing
+     * the number of active blocks per multiprocessor.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param occupancy Will store the recommended configuration
+     * @param f Function to compute the configuration for
+     * @param dev Device that the function will be launched on
+     * @param dynamicSharedMemBytes Dynamic shared memory per block, in bytes
+     * @param dynamicSharedMemBytesPerThread Additional dynamic shared
+     * memory per thread, in bytes
+     * @param blockSizeLimit The maximum block size, or 0
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_HANDLE, CUDA_ERROR_INVALID_DEVICE
+     *
+     * @see JCudaDriver#cuOccupancyCalculate
+     * @see JCudaDriver#cuOccupancyAutotune
+     */
+    public static int cuOccupancyRecommend(CUoccupancy occupancy, CUfunction f, CUdevice dev, int dynamicSharedMemBytes, int dynamicSharedMemBytesPerThread, int blockSizeLimit)
+    {
+        return checkResult(cuOccupancyRecommendNative(occupancy, f, dev, dynamicSharedMemBytes, dynamicSharedMemBytesPerThread, blockSizeLimit));
+    }
+    private static native int cuOccupancyRecommendNative(CUoccupancy occupancy, CUfunction f, CUdevice dev, int dynamicSharedMemBytes, int dynamicSharedMemBytesPerThread, int blockSizeLimit);
+
+
+    /**
+     * Determines the fastest block size for launching the given function
+     * in the current context, for a one-dimensional problem with the
+     * given number of threads.<br />
+     * <br />
+     * If a result for the given key, thread count and dynamic shared
+     * memory has already been determined for a device with the same
+     * PCI bus ID and name (possibly in an earlier run, see
+     * {@link #cuOccupancySetCacheFile}), then this result is returned
+     * without launching the function. Otherwise, all block sizes that
+     * achieve at least half of the highest possible occupancy (including
+     * ones that are larger than the block size with the highest
+     * occupancy) are timed with events: The function is launched once for warming up, and
+     * then the given number of times, with a grid size of
+     * <code>ceil(threadCount / blockSize)</code> and the given kernel
+     * parameters. The fastest configuration is stored for the key, and
+     * the elapsedTime of the result is set to the time of one launch,
+     * in milliseconds.<br />
+     * <br />
+     * Since the function is actually launched, it is executed
+     * repeatedly with the given parameters, and modifies the memory
+     * that they refer to each time. So the parameters should refer to
+     * scratch buffers, unless the function is idempotent. Block sizes
+     * that can not be launched are skipped, but autotuning stops at
+     * the first other error, because an error during the execution
+     * leaves the context unusable. The key should identify the
+     * function (e.g. by the module and function name), and may include
+     * everything else that affects the best block size. Pending updates
+     * of global variables are flushed before the function is launched.
+     * Since the launches have to be executed, this may not be called
+     * while an operation graph is being captured.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param occupancy Will store the fastest configuration
+     * @param f Function to autotune
+     * @param key The key that identifies the function
+     * @param threadCount The total number of threads
+     * @param dynamicSharedMemBytes Dynamic shared memory per block, in bytes
+     * @param hStream Stream identifier
+     * @param kernelParams Array of pointers to kernel parameters, as for
+     * {@link #cuLaunchKernel}
+     * @param iterations The number of timed launches per block size
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_INVALID_VALUE, CUDA_ERROR_LAUNCH_FAILED,
+     * CUDA_ERROR_LAUNCH_OUT_OF_RESOURCES, CUDA_ERROR_NOT_PERMITTED
+     *
+     * @see JCudaDriver#cuOccupancyRecommend
+     * @see JCudaDriver#cuOccupancySetCacheFile
+     * @see JCudaDriver#cuLaunchKernel
+     */
+    public static int cuOccupancyAutotune(CUoccupancy occupancy, CUfunction f, String key, long threadCount, int dynamicSharedMemBytes, CUstream hStream, Pointer kernelParams, int iterations)
+    {
+        return checkResult(cuOccupancyAutotuneNative(occupancy, f, key, threadCount, dynamicSharedMemBytes, hStream, kernelParams, iterations));
+    }
+    private static native int cuOccupancyAutotuneNative(CUoccupancy occupancy, CUfunction f, String key, long threadCount, int dynamicSharedMemBytes, CUstream hStream, Pointer kernelParams, int iterations);
+
+
+    /**
+     * Sets the file that the results of {@link #cuOccupancyAutotune}
+     * are persisted in. The results that are already contained in the
+     * file are read, and new results are appended to the file. If the
+     * given file name is <code>null</code>, then new results are no
+     * longer persisted.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param fileName The name of the file, or <code>null</code>
+     * @return CUDA_SUCCESS, or CUDA_ERROR_INVALID_VALUE if the file
+     * contained invalid entries, which have been ignored
+     *
+     * @see JCudaDriver#cuOccupancyAutotune
+     */
+    public static int cuOccupancySetCacheFile(String fileName)
+    {
+        return checkResult(cuOccupancySetCacheFileNative(fileName));
+    }
+    private static native int cuOccupancySetCacheFileNative(String fileName);
+
+
     /**
      * Sets the block-dimensions for the function.
      * 
@@ -11724,9 +13935,165 @@ public class JCudaDriver
 
 
     /**
-     * Computes the elapsed time between two events.
-     * 
-     * <pre>
+     * Creates a pool for events that are created with the given flags,
+     * which may be CU_EVENT_DEFAULT, or a combination of
+     * CU_EVENT_BLOCKING_SYNC and CU_EVENT_DISABLE_TIMING. Separate pools
+     * should be used for events with and without timing.<br />
+     * <br />
+     * Acquiring an event from the pool and releasing it are lock-free
+     * operations. A new event is only created when the pool is empty,
+     * and an event is only destroyed when it is released while the pool
+     * already holds the given maximum number of idle events.<br />
+     * <br />
+     * The events belong to the context that is current when they are
+     * created, so a pool should only be used with one context.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pool Returned pool
+     * @param Flags The flags for the events
+     * @param capacity The maximum number of idle events in the pool
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuEventPoolAcquire
+     * @see JCudaDriver#cuEventPoolRelease
+     * @see JCudaDriver#cuEventPoolDestroy
+     */
+    public static int cuEventPoolCreate(CUeventPool pool, int Flags, int capacity)
+    {
+        return checkResult(cuEventPoolCreateNative(pool, Flags, capacity));
+    }
+    private static native int cuEventPoolCreateNative(CUeventPool pool, int Flags, int capacity);
+
+
+    /**
+     * Destroys the given pool, and all idle events in the pool.
+     * Events that have been acquired and not released remain valid,
+     * and have to be destroyed with {@link JCudaDriver#cuEventDestroy}.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pool The pool
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuEventPoolCreate
+     */
+    public static int cuEventPoolDestroy(CUeventPool pool)
+    {
+        return checkResult(cuEventPoolDestroyNative(pool));
+    }
+    private static native int cuEventPoolDestroyNative(CUeventPool pool);
+
+
+    /**
+     * Acquires an event from the given pool. If the pool is empty,
+     * a new event is created with the flags of the pool. The event
+     * should be returned with {@link JCudaDriver#cuEventPoolRelease}
+     * instead of being destroyed.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pool The pool
+     * @param phEvent Returned event
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE, or the error codes
+     * of cuEventCreate
+     *
+     * @see JCudaDriver#cuEventPoolRelease
+     */
+    public static int cuEventPoolAcquire(CUeventPool pool, CUevent phEvent)
+    {
+        return checkResult(cuEventPoolAcquireNative(pool, phEvent));
+    }
+    private static native int cuEventPoolAcquireNative(CUeventPool pool, CUevent phEvent);
+
+
+    /**
+     * Returns the given event to the given pool. The event must have
+     * been acquired from this pool. It may still be pending, and may
+     * not be used by the caller any more.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pool The pool
+     * @param hEvent The event
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuEventPoolAcquire
+     */
+    public static int cuEventPoolRelease(CUeventPool pool, CUevent hEvent)
+    {
+        return checkResult(cuEventPoolReleaseNative(pool, hEvent));
+    }
+    private static native int cuEventPoolReleaseNative(CUeventPool pool, CUevent hEvent);
+
+
+    /**
+     * Registers the given event, which must have been recorded with
+     * {@link JCudaDriver#cuEventRecord}, so that the given future is
+     * completed when the event has been completed. A single native
+     * thread polls all registered events, and completes the futures
+     * in batches, so the calling thread does not block, and no thread
+     * has to block for each pending event.<br />
+     * <br />
+     * The event must not be destroyed or recorded again until the
+     * future has been completed. A future may only be registered once.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param future The future
+     * @param hEvent The event
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_UNKNOWN
+     *
+     * @see EventFuture#addListener(jcuda.EventFutureListener)
+     */
+    public static int cuEventRegisterFuture(EventFuture future, CUevent hEvent)
+    {
+        return checkResult(cuEventRegisterFutureNative(future, hEvent));
+    }
+    private static native int cuEventRegisterFutureNative(EventFuture future, CUevent hEvent);
+
+
+    /**
+     * Returns the number of events that are registered and not completed
+     * yet, the number of events that have been completed, and the number
+     * of batches in which the futures of these events have been completed.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pending Will store the number of pending events
+     * @param completed Will store the number of completed events
+     * @param batches Will store the number of batches
+     *
+     * @return CUDA_SUCCESS
+     */
+    public static int cuEventFutureGetStatistics(long pending[], long completed[], long batches[])
+    {
+        return checkResult(cuEventFutureGetStatisticsNative(pending, completed, batches));
+    }
+    private static native int cuEventFutureGetStatisticsNative(long pending[], long completed[], long batches[]);
+
+
+    /**
+     * Computes the elapsed time between two events.
+     * 
+     * <pre>
      * CUresult cuEventElapsedTime (
      *      float* pMilliseconds,
      *      CUevent hStart,
@@ -12219,99 +14586,1045 @@ public class JCudaDriver
      */    
     public static int cuStreamQuery(CUstream hStream)
     {
-        return checkResult(cuStreamQueryNative(hStream));
+        return checkResult(cuStreamQueryNative(hStream));
+    }
+
+    private static native int cuStreamQueryNative(CUstream hStream);
+
+
+    /**
+     * Wait until a stream's tasks are completed.
+     * 
+     * <pre>
+     * CUresult cuStreamSynchronize (
+     *      CUstream hStream )
+     * </pre>
+     * <div>
+     *   <p>Wait until a stream's tasks are completed.
+     *     Waits until the device has completed all operations in the stream
+     *     specified by
+     *     <tt>hStream</tt>. If the context was
+     *     created with the CU_CTX_SCHED_BLOCKING_SYNC flag, the CPU thread will
+     *     block until the stream is finished with all of its tasks.
+     *   </p>
+     *   <div>
+     *     <span>Note:</span>
+     *     <p>Note that this
+     *       function may also return error codes from previous, asynchronous
+     *       launches.
+     *     </p>
+     *   </div>
+     *   </p>
+     * </div>
+     * 
+     * @param hStream Stream to wait for
+     * 
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_HANDLE
+     * 
+     * @see JCudaDriver#cuStreamCreate
+     * @see JCudaDriver#cuStreamDestroy
+     * @see JCudaDriver#cuStreamWaitEvent
+     * @see JCudaDriver#cuStreamQuery
+     * @see JCudaDriver#cuStreamAddCallback
+     */    
+    public static int cuStreamSynchronize(CUstream hStream)
+    {
+        return checkResult(cuStreamSynchronizeNative(hStream));
+    }
+
+    private static native int cuStreamSynchronizeNative(CUstream hStream);
+
+
+    /**
+     * Destroys a stream.
+     * 
+     * <pre>
+     * CUresult cuStreamDestroy (
+     *      CUstream hStream )
+     * </pre>
+     * <div>
+     *   <p>Destroys a stream.  Destroys the stream
+     *     specified by <tt>hStream</tt>.
+     *   </p>
+     *   <p>In case the device is still doing work
+     *     in the stream <tt>hStream</tt> when cuStreamDestroy() is called, the
+     *     function will return immediately and the resources associated with <tt>hStream</tt> will be released automatically once the device has
+     *     completed all work in <tt>hStream</tt>.
+     *   </p>
+     *   <div>
+     *     <span>Note:</span>
+     *     <p>Note that this
+     *       function may also return error codes from previous, asynchronous
+     *       launches.
+     *     </p>
+     *   </div>
+     *   </p>
+     * </div>
+     * 
+     * @param hStream Stream to destroy
+     * 
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE
+     * 
+     * @see JCudaDriver#cuStreamCreate
+     * @see JCudaDriver#cuStreamWaitEvent
+     * @see JCudaDriver#cuStreamQuery
+     * @see JCudaDriver#cuStreamSynchronize
+     * @see JCudaDriver#cuStreamAddCallback
+     */    
+    public static int cuStreamDestroy(CUstream hStream)
+    {
+        return checkResult(cuStreamDestroyNative(hStream));
+    }
+
+    private static native int cuStreamDestroyNative(CUstream hStream);
+
+
+    /**
+     * Creates a pool for streams. The pool keeps the idle streams
+     * separately for each combination of flags and priority, so that
+     * streams with different flags and priorities may be acquired
+     * from the same pool. The priorities are clamped to the range that
+     * is reported by cuCtxGetStreamPriorityRange for the current
+     * context.<br />
+     * <br />
+     * Acquiring a stream from the pool and releasing it are lock-free
+     * operations. A new stream is only created when there is no idle
+     * stream with the requested flags and priority, and a stream is
+     * only destroyed when it is released while the pool already holds
+     * the given maximum number of idle streams with its flags and
+     * priority.<br />
+     * <br />
+     * The streams belong to the context that is current when they are
+     * created, so a pool should only be used with the context that is
+     * current when the pool is created.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pool Returned pool
+     * @param capacity The maximum number of idle streams in the pool,
+     * for each combination of flags and priority
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE,
+     * CUDA_ERROR_INVALID_CONTEXT
+     *
+     * @see JCudaDriver#cuStreamPoolAcquire
+     * @see JCudaDriver#cuStreamPoolRelease
+     * @see JCudaDriver#cuStreamPoolDestroy
+     */
+    public static int cuStreamPoolCreate(CUstreamPool pool, int capacity)
+    {
+        return checkResult(cuStreamPoolCreateNative(pool, capacity));
+    }
+    private static native int cuStreamPoolCreateNative(CUstreamPool pool, int capacity);
+
+
+    /**
+     * Destroys the given pool, and all idle streams in the pool.
+     * Streams that have been acquired and not released remain valid,
+     * and have to be destroyed with {@link JCudaDriver#cuStreamDestroy}.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pool The pool
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuStreamPoolCreate
+     */
+    public static int cuStreamPoolDestroy(CUstreamPool pool)
+    {
+        return checkResult(cuStreamPoolDestroyNative(pool));
+    }
+    private static native int cuStreamPoolDestroyNative(CUstreamPool pool);
+
+
+    /**
+     * Acquires a stream with the given flags and priority from the
+     * given pool. The flags may be CU_STREAM_DEFAULT or
+     * CU_STREAM_NON_BLOCKING. If the pool has no idle stream with
+     * these flags and priority, then a new stream is created. Streams
+     * with a priority other than 0 are created with
+     * cuStreamCreateWithPriority. The stream should be returned with
+     * {@link JCudaDriver#cuStreamPoolRelease} instead of being
+     * destroyed.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pool The pool
+     * @param phStream Returned stream
+     * @param Flags The flags for the stream
+     * @param priority The priority of the stream
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE, CUDA_ERROR_INVALID_VALUE,
+     * or the error codes of cuStreamCreate
+     *
+     * @see JCudaDriver#cuStreamPoolRelease
+     */
+    public static int cuStreamPoolAcquire(CUstreamPool pool, CUstream phStream, int Flags, int priority)
+    {
+        return checkResult(cuStreamPoolAcquireNative(pool, phStream, Flags, priority));
+    }
+    private static native int cuStreamPoolAcquireNative(CUstreamPool pool, CUstream phStream, int Flags, int priority);
+
+
+    /**
+     * Returns the given stream to the given pool. The stream must have
+     * been acquired from this pool, and may not be used by the caller
+     * any more. It is kept with the other idle streams that have its
+     * flags and priority. Work that is still pending in the stream will
+     * precede the work of the next user of the stream.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pool The pool
+     * @param hStream The stream
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuStreamPoolAcquire
+     */
+    public static int cuStreamPoolRelease(CUstreamPool pool, CUstream hStream)
+    {
+        return checkResult(cuStreamPoolReleaseNative(pool, hStream));
+    }
+    private static native int cuStreamPoolReleaseNative(CUstreamPool pool, CUstream hStream);
+
+
+    /**
+     * Creates a scheduler that distributes tasks over all devices. For
+     * each device, the scheduler creates a context with the given flags
+     * (see {@link JCudaDriver#cuCtxCreate}), the given number of streams,
+     * and a worker thread. The context stack of the calling thread is
+     * not modified.<br />
+     * <br />
+     * Each device has a deque of tasks. Tasks that are not bound to a
+     * device are put into the deque of the device with the lowest load.
+     * When a device has a free stream and its own deque is empty, it
+     * steals tasks from the deques of the other devices. So faster
+     * devices automatically execute more tasks, and the slowest device
+     * does not determine the time that is required for all tasks.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param scheduler Returned scheduler
+     * @param Flags The context creation flags
+     * @param streamsPerDevice The number of streams per device, which
+     * is the maximum number of tasks that run concurrently on a device
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED,
+     * CUDA_ERROR_NOT_INITIALIZED, CUDA_ERROR_INVALID_VALUE,
+     * CUDA_ERROR_NO_DEVICE, CUDA_ERROR_OUT_OF_MEMORY, CUDA_ERROR_UNKNOWN
+     *
+     * @see JCudaDriver#cuTaskSchedulerSubmit
+     * @see JCudaDriver#cuTaskSchedulerSynchronize
+     * @see JCudaDriver#cuTaskSchedulerDestroy
+     */
+    public static int cuTaskSchedulerCreate(CUtaskScheduler scheduler, int Flags, int streamsPerDevice)
+    {
+        return checkResult(cuTaskSchedulerCreateNative(scheduler, Flags, streamsPerDevice));
+    }
+    private static native int cuTaskSchedulerCreateNative(CUtaskScheduler scheduler, int Flags, int streamsPerDevice);
+
+
+    /**
+     * Destroys the given scheduler, after waiting for all tasks.
+     * The contexts of the scheduler are destroyed, together with
+     * all resources that are associated with them, like for
+     * {@link JCudaDriver#cuCtxDestroy}. This must not be called
+     * from within a task of the scheduler: In this case,
+     * CUDA_ERROR_NOT_PERMITTED is returned.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param scheduler The scheduler
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_NOT_PERMITTED
+     *
+     * @see JCudaDriver#cuTaskSchedulerCreate
+     */
+    public static int cuTaskSchedulerDestroy(CUtaskScheduler scheduler)
+    {
+        return checkResult(cuTaskSchedulerDestroyNative(scheduler));
+    }
+    private static native int cuTaskSchedulerDestroyNative(CUtaskScheduler scheduler);
+
+
+    /**
+     * Returns the number of devices that are used by the given
+     * scheduler.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param scheduler The scheduler
+     * @param count Returned number of devices
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuTaskSchedulerGetContext
+     */
+    public static int cuTaskSchedulerGetDeviceCount(CUtaskScheduler scheduler, int count[])
+    {
+        return checkResult(cuTaskSchedulerGetDeviceCountNative(scheduler, count));
+    }
+    private static native int cuTaskSchedulerGetDeviceCountNative(CUtaskScheduler scheduler, int count[]);
+
+
+    /**
+     * Returns the context that the given scheduler created for the
+     * device with the given index. This context may be used to
+     * allocate the memory that is used by the tasks that are
+     * bound to this device.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param scheduler The scheduler
+     * @param device The index of the device
+     * @param pctx Returned context
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuTaskSchedulerGetDeviceCount
+     */
+    public static int cuTaskSchedulerGetContext(CUtaskScheduler scheduler, int device, CUcontext pctx)
+    {
+        return checkResult(cuTaskSchedulerGetContextNative(scheduler, device, pctx));
+    }
+    private static native int cuTaskSchedulerGetContextNative(CUtaskScheduler scheduler, int device, CUcontext pctx);
+
+
+    /**
+     * Submits a task to the given scheduler. The given callback will be
+     * called by the worker thread of the device that executes the task,
+     * with the context of this device being current, and should enqueue
+     * the work of the task in the given stream. If the given device
+     * index is -1, the task may be executed on any device. Otherwise,
+     * it is bound to the device with the given index, and will not be
+     * stolen by other devices.<br />
+     * <br />
+     * If the given task is not <code>null</code>, it may be used to
+     * wait for the completion of the task, and has to be destroyed
+     * with {@link JCudaDriver#cuTaskDestroy}.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param scheduler The scheduler
+     * @param task Returned task. May be <code>null</code>.
+     * @param callback The callback that executes the task
+     * @param userData User parameter that is passed to the callback
+     * @param device The index of the device, or -1
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuTaskQuery
+     * @see JCudaDriver#cuTaskSynchronize
+     * @see JCudaDriver#cuTaskSchedulerSynchronize
+     */
+    public static int cuTaskSchedulerSubmit(CUtaskScheduler scheduler, CUtask task, CUtaskCallback callback, Object userData, int device)
+    {
+        return checkResult(cuTaskSchedulerSubmitNative(scheduler, task, callback, userData, device));
+    }
+    private static native int cuTaskSchedulerSubmitNative(CUtaskScheduler scheduler, CUtask task, CUtaskCallback callback, Object userData, int device);
+
+
+    /**
+     * Waits until all tasks that have been submitted to the given
+     * scheduler are complete. This must not be called from within
+     * a task.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param scheduler The scheduler
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuTaskSchedulerSubmit
+     */
+    public static int cuTaskSchedulerSynchronize(CUtaskScheduler scheduler)
+    {
+        return checkResult(cuTaskSchedulerSynchronizeNative(scheduler));
+    }
+    private static native int cuTaskSchedulerSynchronizeNative(CUtaskScheduler scheduler);
+
+
+    /**
+     * Returns the number of tasks that have been executed on the device
+     * with the given index, and how many of them have been stolen from
+     * the deques of other devices.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param scheduler The scheduler
+     * @param device The index of the device
+     * @param executed Returned number of executed tasks
+     * @param stolen Returned number of stolen tasks
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_INVALID_VALUE
+     */
+    public static int cuTaskSchedulerGetStatistics(CUtaskScheduler scheduler, int device, long executed[], long stolen[])
+    {
+        return checkResult(cuTaskSchedulerGetStatisticsNative(scheduler, device, executed, stolen));
+    }
+    private static native int cuTaskSchedulerGetStatisticsNative(CUtaskScheduler scheduler, int device, long executed[], long stolen[]);
+
+
+    /**
+     * Creates a scheduler that separates latency-critical work from
+     * batch work. For each device, the scheduler creates a context with
+     * the given flags, the given number of streams with the greatest
+     * stream priority for latency-critical tasks, the given number of
+     * streams with the least stream priority for batch tasks, and a
+     * worker thread.<br />
+     * <br />
+     * Queued latency-critical tasks are always launched before batch
+     * tasks. At most the given number of batch tasks are in flight on
+     * one device at any time, so that latency-critical tasks do not
+     * have to wait behind a deep queue of batch work.<br />
+     * <br />
+     * On devices that do not support stream priorities, all streams
+     * have the same priority, and the latency classes are only
+     * separated by the order and the limit described above.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param scheduler Returned scheduler
+     * @param Flags The context creation flags
+     * @param criticalStreams The number of streams for latency-critical
+     * tasks per device
+     * @param batchStreams The number of streams for batch tasks per device
+     * @param maxBatchInFlight The maximum number of batch tasks that
+     * are in flight on one device
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE, CUDA_ERROR_NO_DEVICE,
+     * or the error code from creating a context or stream
+     *
+     * @see JCudaDriver#cuPrioritySchedulerDestroy
+     */
+    public static int cuPrioritySchedulerCreate(CUpriorityScheduler scheduler, int Flags, int criticalStreams, int batchStreams, int maxBatchInFlight)
+    {
+        return checkResult(cuPrioritySchedulerCreateNative(scheduler, Flags, criticalStreams, batchStreams, maxBatchInFlight));
+    }
+    private static native int cuPrioritySchedulerCreateNative(CUpriorityScheduler scheduler, int Flags, int criticalStreams, int batchStreams, int maxBatchInFlight);
+
+
+    /**
+     * Destroys the given scheduler, after waiting for all tasks. The
+     * contexts of the scheduler are destroyed, together with all
+     * resources that are associated with them, like for
+     * {@link JCudaDriver#cuCtxDestroy}. This must not be called from
+     * within a task of the scheduler: In this case,
+     * CUDA_ERROR_NOT_PERMITTED is returned.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param scheduler The scheduler
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_NOT_PERMITTED
+     *
+     * @see JCudaDriver#cuPrioritySchedulerCreate
+     */
+    public static int cuPrioritySchedulerDestroy(CUpriorityScheduler scheduler)
+    {
+        return checkResult(cuPrioritySchedulerDestroyNative(scheduler));
+    }
+    private static native int cuPrioritySchedulerDestroyNative(CUpriorityScheduler scheduler);
+
+
+    /**
+     * Returns the number of devices that are used by the given
+     * scheduler.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param scheduler The scheduler
+     * @param count Returned number of devices
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     */
+    public static int cuPrioritySchedulerGetDeviceCount(CUpriorityScheduler scheduler, int count[])
+    {
+        return checkResult(cuPrioritySchedulerGetDeviceCountNative(scheduler, count));
+    }
+    private static native int cuPrioritySchedulerGetDeviceCountNative(CUpriorityScheduler scheduler, int count[]);
+
+
+    /**
+     * Returns the context that the given scheduler created for the
+     * device with the given index.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param scheduler The scheduler
+     * @param device The index of the device
+     * @param pctx Returned context
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_INVALID_VALUE
+     */
+    public static int cuPrioritySchedulerGetContext(CUpriorityScheduler scheduler, int device, CUcontext pctx)
+    {
+        return checkResult(cuPrioritySchedulerGetContextNative(scheduler, device, pctx));
+    }
+    private static native int cuPrioritySchedulerGetContextNative(CUpriorityScheduler scheduler, int device, CUcontext pctx);
+
+
+    /**
+     * Submits a task with the given latency class to the given scheduler.
+     * The given callback will be called by the worker thread of the
+     * device that executes the task, with the context of this device
+     * being current, and should enqueue the work of the task in the
+     * given stream. If the given device index is -1, the task is
+     * assigned to the device with the fewest queued and running tasks.
+     * <br />
+     * <br />
+     * If the given task is not <code>null</code>, it may be used to
+     * wait for the completion of the task, and has to be destroyed
+     * with {@link JCudaDriver#cuTaskDestroy}.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param scheduler The scheduler
+     * @param task Returned task. May be <code>null</code>.
+     * @param callback The callback that executes the task
+     * @param userData User parameter that is passed to the callback
+     * @param device The index of the device, or -1
+     * @param latencyClass The latency class, one of
+     * {@link CUpriorityScheduler#LATENCY_CRITICAL} or
+     * {@link CUpriorityScheduler#LATENCY_BATCH}
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_INVALID_VALUE
+     */
+    public static int cuPrioritySchedulerSubmit(CUpriorityScheduler scheduler, CUtask task, CUtaskCallback callback, Object userData, int device, int latencyClass)
+    {
+        return checkResult(cuPrioritySchedulerSubmitNative(scheduler, task, callback, userData, device, latencyClass));
+    }
+    private static native int cuPrioritySchedulerSubmitNative(CUpriorityScheduler scheduler, CUtask task, CUtaskCallback callback, Object userData, int device, int latencyClass);
+
+
+    /**
+     * Waits until all tasks that have been submitted to the given
+     * scheduler are complete. This must not be called from within
+     * a task callback.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param scheduler The scheduler
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     */
+    public static int cuPrioritySchedulerSynchronize(CUpriorityScheduler scheduler)
+    {
+        return checkResult(cuPrioritySchedulerSynchronizeNative(scheduler));
+    }
+    private static native int cuPrioritySchedulerSynchronizeNative(CUpriorityScheduler scheduler);
+
+
+    /**
+     * Obtains the queueing statistics of the given latency class: The
+     * number of tasks of this class that have been launched, and the
+     * total and maximum time, in nanoseconds, that these tasks spent
+     * in the queue between their submission and their launch.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param scheduler The scheduler
+     * @param latencyClass The latency class
+     * @param launched Returned number of launched tasks
+     * @param totalQueueDelay Returned total queueing delay, in nanoseconds
+     * @param maxQueueDelay Returned maximum queueing delay, in nanoseconds
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_INVALID_VALUE
+     */
+    public static int cuPrioritySchedulerGetStatistics(CUpriorityScheduler scheduler, int latencyClass, long launched[], long totalQueueDelay[], long maxQueueDelay[])
+    {
+        return checkResult(cuPrioritySchedulerGetStatisticsNative(scheduler, latencyClass, launched, totalQueueDelay, maxQueueDelay));
+    }
+    private static native int cuPrioritySchedulerGetStatisticsNative(CUpriorityScheduler scheduler, int latencyClass, long launched[], long totalQueueDelay[], long maxQueueDelay[]);
+
+
+    /**
+     * Enables the memory governor for device memory. The governor
+     * tracks the memory that is allocated with {@link JCudaDriver#cuMemAlloc}
+     * and {@link JCudaDriver#cuMemAllocPitch}, and queries the free
+     * memory of the device with cuMemGetInfo, at most once per poll
+     * interval.<br />
+     * <br />
+     * When an allocation would let the free memory fall below the low
+     * watermark, the governor first trims the caches of the bindings
+     * that hold device memory, and then calls the registered
+     * {@link CUevictionCallback}s, until enough memory has been
+     * released. Currently, the idle handles of IPC registries are the
+     * only such cache. Caches of host memory, like host arenas and
+     * registered host memory, are not trimmed.<br />
+     * <br />
+     * Allocations of at least the given large allocation size that
+     * would let the free memory fall below the critical watermark are
+     * throttled: They wait until other threads have freed enough
+     * memory, or until the throttle timeout elapsed. When an
+     * allocation fails with CUDA_ERROR_OUT_OF_MEMORY, the
+     * governor releases memory in the same way, and retries the
+     * allocation once.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param lowWatermark The free memory, in bytes, below which memory
+     * is released
+     * @param criticalWatermark The free memory, in bytes, below which
+     * large allocations are throttled. This must not be greater than
+     * the low watermark.
+     * @param largeAllocationSize The minimum size of allocations, in
+     * bytes, that are throttled
+     * @param pollIntervalMs The interval between queries of the free
+     * memory, in milliseconds
+     * @param throttleTimeoutMs The maximum time that a throttled
+     * allocation waits, in milliseconds
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuMemGovernorDisable
+     * @see JCudaDriver#cuMemGovernorAddEvictionCallback
+     */
+    public static int cuMemGovernorEnable(long lowWatermark, long criticalWatermark, long largeAllocationSize, int pollIntervalMs, int throttleTimeoutMs)
+    {
+        return checkResult(cuMemGovernorEnableNative(lowWatermark, criticalWatermark, largeAllocationSize, pollIntervalMs, throttleTimeoutMs));
+    }
+    private static native int cuMemGovernorEnableNative(long lowWatermark, long criticalWatermark, long largeAllocationSize, int pollIntervalMs, int throttleTimeoutMs);
+
+
+    /**
+     * Disables the memory governor. Allocations and frees are no
+     * longer tracked while the governor is disabled.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @return CUDA_SUCCESS
+     *
+     * @see JCudaDriver#cuMemGovernorEnable
+     */
+    public static int cuMemGovernorDisable()
+    {
+        return checkResult(cuMemGovernorDisableNative());
+    }
+    private static native int cuMemGovernorDisableNative();
+
+
+    /**
+     * Adds a callback that is called by the memory governor to release
+     * memory of the given device, or of all devices if the given device
+     * is -1. The callbacks are called in the order in which they have
+     * been added, until enough memory has been released.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param callback The callback
+     * @param userData User parameter that is passed to the callback
+     * @param device The device ordinal, or -1
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuMemGovernorRemoveEvictionCallback
+     */
+    public static int cuMemGovernorAddEvictionCallback(CUevictionCallback callback, Object userData, int device)
+    {
+        return checkResult(cuMemGovernorAddEvictionCallbackNative(callback, userData, device));
+    }
+    private static native int cuMemGovernorAddEvictionCallbackNative(CUevictionCallback callback, Object userData, int device);
+
+
+    /**
+     * Removes all registrations of the given callback from the memory
+     * governor. This waits until the callback is no longer executed
+     * by other threads.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param callback The callback
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE if the callback
+     * was not registered
+     */
+    public static int cuMemGovernorRemoveEvictionCallback(CUevictionCallback callback)
+    {
+        return checkResult(cuMemGovernorRemoveEvictionCallbackNative(callback));
+    }
+    private static native int cuMemGovernorRemoveEvictionCallbackNative(CUevictionCallback callback);
+
+
+    /**
+     * Obtains the statistics of the memory governor for the given
+     * device: The number of bytes that have been allocated through
+     * the bindings while the governor was enabled, the estimated
+     * number of free bytes, the number of
+     * bytes that eviction callbacks reported as released, and the
+     * number of allocations that have been throttled.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param device The device ordinal
+     * @param allocated Returned number of allocated bytes
+     * @param free Returned estimated number of free bytes
+     * @param evicted Returned number of evicted bytes
+     * @param throttled Returned number of throttled allocations
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE if no memory
+     * was allocated on the given device
+     */
+    public static int cuMemGovernorGetStatistics(int device, long allocated[], long free[], long evicted[], long throttled[])
+    {
+        return checkResult(cuMemGovernorGetStatisticsNative(device, allocated, free, evicted, throttled));
+    }
+    private static native int cuMemGovernorGetStatisticsNative(int device, long allocated[], long free[], long evicted[], long throttled[]);
+
+
+    /**
+     * Creates a service that loads modules concurrently into the given
+     * context. The service has the given number of worker threads, which
+     * all make the given context current. If the given number is not
+     * positive, one thread per processor is used.<br />
+     * <br />
+     * Most of the time of loading a PTX module is spent in the JIT
+     * compiler. When many modules are loaded with this service, the
+     * total time is approximately the time for the largest modules,
+     * and not the sum of the times for all modules.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param loader Returned loader
+     * @param ctx The context that the modules are loaded into
+     * @param threadCount The number of worker threads
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_UNKNOWN if the threads
+     * could not be started
+     *
+     * @see JCudaDriver#cuModuleLoaderLoadData
+     * @see JCudaDriver#cuModuleLoaderDestroy
+     */
+    public static int cuModuleLoaderCreate(CUmoduleLoader loader, CUcontext ctx, int threadCount)
+    {
+        return checkResult(cuModuleLoaderCreateNative(loader, ctx, threadCount));
+    }
+    private static native int cuModuleLoaderCreateNative(CUmoduleLoader loader, CUcontext ctx, int threadCount);
+
+
+    /**
+     * Destroys the given loader, after all modules that have been
+     * queued have been loaded. The futures of these modules remain
+     * valid, and have to be destroyed with
+     * {@link JCudaDriver#cuModuleFutureDestroy}.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param loader The loader
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     */
+    public static int cuModuleLoaderDestroy(CUmoduleLoader loader)
+    {
+        return checkResult(cuModuleLoaderDestroyNative(loader));
+    }
+    private static native int cuModuleLoaderDestroyNative(CUmoduleLoader loader);
+
+
+    /**
+     * Queues the given module image for loading, and returns
+     * immediately. The image is copied, and may be a PTX file (which
+     * does not have to be terminated with a 0-byte), a cubin or a
+     * fatbin. The module is loaded by one of the worker threads with
+     * cuModuleLoadDataEx. The given future may be used to wait for
+     * the module, and to obtain its functions.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param loader The loader
+     * @param future Returned future of the module
+     * @param image The module image
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuModuleFutureGetModule
+     * @see JCudaDriver#cuModuleFutureGetFunction
+     */
+    public static int cuModuleLoaderLoadData(CUmoduleLoader loader, CUmoduleFuture future, byte image[])
+    {
+        return checkResult(cuModuleLoaderLoadDataNative(loader, future, image));
+    }
+    private static native int cuModuleLoaderLoadDataNative(CUmoduleLoader loader, CUmoduleFuture future, byte image[]);
+
+
+    /**
+     * Waits until all modules that have been queued in the given
+     * loader have been loaded.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param loader The loader
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     */
+    public static int cuModuleLoaderSynchronize(CUmoduleLoader loader)
+    {
+        return checkResult(cuModuleLoaderSynchronizeNative(loader));
+    }
+    private static native int cuModuleLoaderSynchronizeNative(CUmoduleLoader loader);
+
+
+    /**
+     * Returns whether the module of the given future has been
+     * loaded.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param future The future
+     *
+     * @return CUDA_ERROR_NOT_READY if the module is not loaded yet,
+     * and otherwise the result of loading the module
+     */
+    public static int cuModuleFutureQuery(CUmoduleFuture future)
+    {
+        return checkResult(cuModuleFutureQueryNative(future));
+    }
+    private static native int cuModuleFutureQueryNative(CUmoduleFuture future);
+
+
+    /**
+     * Waits until the module of the given future has been loaded, and
+     * returns it. The module has to be unloaded with
+     * {@link JCudaDriver#cuModuleUnload}.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param future The future
+     * @param module Returned module
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE, or the error
+     * from loading the module
+     */
+    public static int cuModuleFutureGetModule(CUmoduleFuture future, CUmodule module)
+    {
+        return checkResult(cuModuleFutureGetModuleNative(future, module));
+    }
+    private static native int cuModuleFutureGetModuleNative(CUmoduleFuture future, CUmodule module);
+
+
+    /**
+     * Returns a handle to the function with the given name in the module
+     * of the given future. This returns immediately. The function is
+     * looked up when the handle is first passed to any function, for
+     * example {@link JCudaDriver#cuLaunchKernel} or
+     * {@link JCudaDriver#cuFuncGetAttribute}, which waits until the
+     * module has been loaded if necessary. Errors from loading the
+     * module or looking up the function are reported at this time.
+     * Lookups of functions that are never used are avoided.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param future The future
+     * @param hfunc Returned function handle
+     * @param name The name of the function
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     */
+    public static int cuModuleFutureGetFunction(CUmoduleFuture future, CUfunction hfunc, String name)
+    {
+        return checkResult(cuModuleFutureGetFunctionNative(future, hfunc, name));
+    }
+    private static native int cuModuleFutureGetFunctionNative(CUmoduleFuture future, CUfunction hfunc, String name);
+
+
+    /**
+     * Waits until the module of the given future has been loaded, and
+     * returns the error log of the JIT compiler.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param future The future
+     * @param log Returned error log
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     */
+    public static int cuModuleFutureGetErrorLog(CUmoduleFuture future, String log[])
+    {
+        return checkResult(cuModuleFutureGetErrorLogNative(future, log));
+    }
+    private static native int cuModuleFutureGetErrorLogNative(CUmoduleFuture future, String log[]);
+
+
+    /**
+     * Destroys the given future. The module is not unloaded. Functions
+     * that have been obtained from the future, and have not been used
+     * yet, become invalid, and using them causes
+     * CUDA_ERROR_INVALID_HANDLE.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param future The future
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     */
+    public static int cuModuleFutureDestroy(CUmoduleFuture future)
+    {
+        return checkResult(cuModuleFutureDestroyNative(future));
     }
-
-    private static native int cuStreamQueryNative(CUstream hStream);
+    private static native int cuModuleFutureDestroyNative(CUmoduleFuture future);
 
 
     /**
-     * Wait until a stream's tasks are completed.
-     * 
-     * <pre>
-     * CUresult cuStreamSynchronize (
-     *      CUstream hStream )
-     * </pre>
-     * <div>
-     *   <p>Wait until a stream's tasks are completed.
-     *     Waits until the device has completed all operations in the stream
-     *     specified by
-     *     <tt>hStream</tt>. If the context was
-     *     created with the CU_CTX_SCHED_BLOCKING_SYNC flag, the CPU thread will
-     *     block until the stream is finished with all of its tasks.
-     *   </p>
-     *   <div>
-     *     <span>Note:</span>
-     *     <p>Note that this
-     *       function may also return error codes from previous, asynchronous
-     *       launches.
-     *     </p>
-     *   </div>
-     *   </p>
-     * </div>
-     * 
-     * @param hStream Stream to wait for
-     * 
-     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
-     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_HANDLE
-     * 
-     * @see JCudaDriver#cuStreamCreate
-     * @see JCudaDriver#cuStreamDestroy
-     * @see JCudaDriver#cuStreamWaitEvent
-     * @see JCudaDriver#cuStreamQuery
-     * @see JCudaDriver#cuStreamAddCallback
-     */    
-    public static int cuStreamSynchronize(CUstream hStream)
+     * Returns CUDA_ERROR_NOT_READY if the given task is not complete
+     * yet. Otherwise, returns CUDA_SUCCESS, or the error that occurred
+     * while the task was executed. If the callback of the task threw
+     * an exception, the result is CUDA_ERROR_UNKNOWN.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param task The task
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_NOT_READY,
+     * CUDA_ERROR_INVALID_HANDLE, CUDA_ERROR_UNKNOWN
+     *
+     * @see JCudaDriver#cuTaskSynchronize
+     */
+    public static int cuTaskQuery(CUtask task)
     {
-        return checkResult(cuStreamSynchronizeNative(hStream));
+        return checkResult(cuTaskQueryNative(task));
     }
+    private static native int cuTaskQueryNative(CUtask task);
 
-    private static native int cuStreamSynchronizeNative(CUstream hStream);
+
+    /**
+     * Waits until the given task is complete, and returns CUDA_SUCCESS,
+     * or the error that occurred while the task was executed.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param task The task
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_UNKNOWN
+     *
+     * @see JCudaDriver#cuTaskQuery
+     */
+    public static int cuTaskSynchronize(CUtask task)
+    {
+        return checkResult(cuTaskSynchronizeNative(task));
+    }
+    private static native int cuTaskSynchronizeNative(CUtask task);
 
 
     /**
-     * Destroys a stream.
-     * 
-     * <pre>
-     * CUresult cuStreamDestroy (
-     *      CUstream hStream )
-     * </pre>
-     * <div>
-     *   <p>Destroys a stream.  Destroys the stream
-     *     specified by <tt>hStream</tt>.
-     *   </p>
-     *   <p>In case the device is still doing work
-     *     in the stream <tt>hStream</tt> when cuStreamDestroy() is called, the
-     *     function will return immediately and the resources associated with <tt>hStream</tt> will be released automatically once the device has
-     *     completed all work in <tt>hStream</tt>.
-     *   </p>
-     *   <div>
-     *     <span>Note:</span>
-     *     <p>Note that this
-     *       function may also return error codes from previous, asynchronous
-     *       launches.
-     *     </p>
-     *   </div>
-     *   </p>
-     * </div>
-     * 
-     * @param hStream Stream to destroy
-     * 
-     * @return CUDA_SUCCESS, CUDA_ERROR_DEINITIALIZED, CUDA_ERROR_NOT_INITIALIZED,
-     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_VALUE
-     * 
-     * @see JCudaDriver#cuStreamCreate
-     * @see JCudaDriver#cuStreamWaitEvent
-     * @see JCudaDriver#cuStreamQuery
-     * @see JCudaDriver#cuStreamSynchronize
-     * @see JCudaDriver#cuStreamAddCallback
-     */    
-    public static int cuStreamDestroy(CUstream hStream)
+     * Returns the index of the device that executes the given task,
+     * or -1 if the task was not assigned to a device yet.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param task The task
+     * @param device Returned device index
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     */
+    public static int cuTaskGetDevice(CUtask task, int device[])
     {
-        return checkResult(cuStreamDestroyNative(hStream));
+        return checkResult(cuTaskGetDeviceNative(task, device));
     }
+    private static native int cuTaskGetDeviceNative(CUtask task, int device[]);
 
-    private static native int cuStreamDestroyNative(CUstream hStream);
+
+    /**
+     * Destroys the given task. If the task is not complete yet, it
+     * will still be executed.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param task The task
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuTaskSchedulerSubmit
+     */
+    public static int cuTaskDestroy(CUtask task)
+    {
+        return checkResult(cuTaskDestroyNative(task));
+    }
+    private static native int cuTaskDestroyNative(CUtask task);
 
 
 
@@ -14215,6 +17528,219 @@ public class JCudaDriver
         Pointer kernelParams,
         Pointer extra);
 
+
+    /**
+     * Creates a new, empty operation graph. Operations are added to
+     * the graph by capturing them, see
+     * {@link JCudaDriver#cuOpGraphBeginCapture}.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param graph Returned graph
+     *
+     * @return CUDA_SUCCESS
+     *
+     * @see JCudaDriver#cuOpGraphDestroy
+     */
+    public static int cuOpGraphCreate(CUopGraph graph)
+    {
+        return checkResult(cuOpGraphCreateNative(graph));
+    }
+    private static native int cuOpGraphCreateNative(CUopGraph graph);
+
+
+    /**
+     * Destroys the given operation graph. A graph that any thread is
+     * currently capturing into can not be destroyed, and
+     * CUDA_ERROR_INVALID_VALUE is returned.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param graph The graph
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_INVALID_VALUE
+     *
+     * @see JCudaDriver#cuOpGraphCreate
+     */
+    public static int cuOpGraphDestroy(CUopGraph graph)
+    {
+        return checkResult(cuOpGraphDestroyNative(graph));
+    }
+    private static native int cuOpGraphDestroyNative(CUopGraph graph);
+
+
+    /**
+     * Starts capturing into the given graph on the calling thread.
+     * Until {@link JCudaDriver#cuOpGraphEndCapture} is called, the
+     * following functions are not executed when they are called on
+     * this thread, but are appended to the graph, and return
+     * CUDA_SUCCESS:
+     * <ul>
+     *   <li>{@link JCudaDriver#cuLaunchKernel}</li>
+     *   <li>{@link JCudaDriver#cuMemcpyAsync}</li>
+     *   <li>{@link JCudaDriver#cuMemcpyHtoDAsync}</li>
+     *   <li>{@link JCudaDriver#cuMemcpyDtoHAsync}</li>
+     *   <li>{@link JCudaDriver#cuMemcpyDtoDAsync}</li>
+     *   <li>{@link JCudaDriver#cuMemsetD8Async},
+     *       {@link JCudaDriver#cuMemsetD16Async},
+     *       {@link JCudaDriver#cuMemsetD32Async}</li>
+     *   <li>{@link JCudaDriver#cuEventRecord}</li>
+     *   <li>{@link JCudaDriver#cuStreamWaitEvent}</li>
+     * </ul>
+     * The values of the kernel parameters are copied when a launch is
+     * captured. For this, the kernel parameters must be given as a
+     * pointer to pointers that have been created for arrays or
+     * buffers, as in <code>Pointer.to(Pointer.to(deviceData),
+     * Pointer.to(new int[]{n}))</code>, and the <code>extra</code>
+     * parameter must be <code>null</code>. The host memory of captured
+     * copies is accessed when the graph is launched, so it must be
+     * native memory, e.g. page-locked memory or a direct buffer.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param graph The graph
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_INVALID_VALUE if the calling thread is already
+     * capturing into a graph
+     *
+     * @see JCudaDriver#cuOpGraphEndCapture
+     */
+    public static int cuOpGraphBeginCapture(CUopGraph graph)
+    {
+        return checkResult(cuOpGraphBeginCaptureNative(graph));
+    }
+    private static native int cuOpGraphBeginCaptureNative(CUopGraph graph);
+
+
+    /**
+     * Stops capturing into the given graph on the calling thread.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param graph The graph
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_INVALID_VALUE if the calling thread is not capturing
+     * into the given graph
+     *
+     * @see JCudaDriver#cuOpGraphBeginCapture
+     */
+    public static int cuOpGraphEndCapture(CUopGraph graph)
+    {
+        return checkResult(cuOpGraphEndCaptureNative(graph));
+    }
+    private static native int cuOpGraphEndCaptureNative(CUopGraph graph);
+
+
+    /**
+     * Obtains the number of operations that have been captured in
+     * the given graph.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param graph The graph
+     * @param count Returned number of operations
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     */
+    public static int cuOpGraphGetOperationCount(CUopGraph graph, int count[])
+    {
+        return checkResult(cuOpGraphGetOperationCountNative(graph, count));
+    }
+    private static native int cuOpGraphGetOperationCountNative(CUopGraph graph, int count[]);
+
+
+    /**
+     * Issues all operations of the given graph, in the order in which
+     * they have been captured, to the streams that they have been
+     * captured for. If one operation fails, the remaining operations
+     * are not issued, and its error code is returned.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param graph The graph
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE, or the error
+     * code of the first operation that failed
+     */
+    public static int cuOpGraphLaunch(CUopGraph graph)
+    {
+        return checkResult(cuOpGraphLaunchNative(graph));
+    }
+    private static native int cuOpGraphLaunchNative(CUopGraph graph);
+
+
+    /**
+     * Sets the value of a kernel parameter of a launch that has been
+     * captured in the given graph. The operation index refers to the
+     * order in which the operations have been captured. The given
+     * pointer must be a pointer to an array or buffer that contains
+     * at least as many bytes as the captured parameter value. The
+     * new value is used for all following launches of the graph.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param graph The graph
+     * @param operation The index of the launch operation
+     * @param param The index of the kernel parameter
+     * @param value A pointer to the new value
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE,
+     * CUDA_ERROR_INVALID_VALUE
+     */
+    public static int cuOpGraphSetKernelParam(CUopGraph graph, int operation, int param, Pointer value)
+    {
+        return checkResult(cuOpGraphSetKernelParamNative(graph, operation, param, value));
+    }
+    private static native int cuOpGraphSetKernelParamNative(CUopGraph graph, int operation, int param, Pointer value);
+
+
+    /**
+     * Replaces all device addresses in the given graph that are in
+     * the range of the given size that starts at the old address by
+     * the corresponding addresses in the range that starts at the new
+     * address. This affects the device addresses of copies, the
+     * destination addresses of memsets, and the kernel parameters that
+     * have been created with <code>Pointer.to(CUdeviceptr)</code>.
+     * Host addresses and other kernel parameters are not changed. This
+     * allows replaying a graph on different buffers without capturing
+     * it again.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param graph The graph
+     * @param oldAddress The start of the old address range
+     * @param size The size of the address range, in bytes
+     * @param newAddress The start of the new address range
+     * @param count Returned number of addresses that have been
+     * replaced. May be <code>null</code>.
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_HANDLE
+     */
+    public static int cuOpGraphRebindAddress(CUopGraph graph, CUdeviceptr oldAddress, long size, CUdeviceptr newAddress, int count[])
+    {
+        return checkResult(cuOpGraphRebindAddressNative(graph, oldAddress, size, newAddress, count));
+    }
+    private static native int cuOpGraphRebindAddressNative(CUopGraph graph, CUdeviceptr oldAddress, long size, CUdeviceptr newAddress, int count[]);
+
     /**
      * Returns resource limits.
      * 
@@ -14447,6 +17973,159 @@ public class JCudaDriver
     private static native int cuProfilerStopNative();
 
 
+    /**
+     * Enables the profiler for ranges that are pushed and popped with
+     * {@link JCudaDriver#cuRangePush} and {@link JCudaDriver#cuRangePop}.
+     * A background thread polls the events that mark the ranges in
+     * the given interval, and aggregates the elapsed GPU times. The
+     * profiler does not synchronize any stream or context, so it may
+     * remain enabled in production code. It is disabled by default.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pollIntervalMicros The interval in which the pending
+     * events are polled, in microseconds
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE,
+     * CUDA_ERROR_OUT_OF_MEMORY
+     */
+    public static int cuRangeProfilerEnable(int pollIntervalMicros)
+    {
+        return checkResult(cuRangeProfilerEnableNative(pollIntervalMicros));
+    }
+    private static native int cuRangeProfilerEnableNative(int pollIntervalMicros);
+
+
+    /**
+     * Disables the range profiler. The times of the ranges that are
+     * already complete are still aggregated. Afterwards, pushing and
+     * popping ranges has no effect.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @return CUDA_SUCCESS
+     */
+    public static int cuRangeProfilerDisable()
+    {
+        return checkResult(cuRangeProfilerDisableNative());
+    }
+    private static native int cuRangeProfilerDisableNative();
+
+
+    /**
+     * Starts a range with the given name, by recording an event in
+     * the given stream of the current context. Ranges may be nested,
+     * and are identified by the names of the enclosing ranges of the
+     * calling thread, separated by '/'. Has no effect if the profiler
+     * is not enabled.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param name The name of the range
+     * @param hStream The stream
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE,
+     * CUDA_ERROR_INVALID_CONTEXT, CUDA_ERROR_INVALID_HANDLE
+     *
+     * @see JCudaDriver#cuRangePop
+     */
+    public static int cuRangePush(String name, CUstream hStream)
+    {
+        return checkResult(cuRangePushNative(name, hStream));
+    }
+    private static native int cuRangePushNative(String name, CUstream hStream);
+
+
+    /**
+     * Ends the innermost range of the calling thread, by recording
+     * an event in the stream that the range was started in. Has no
+     * effect if the profiler is not enabled.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE if there is
+     * no range on the calling thread
+     *
+     * @see JCudaDriver#cuRangePush
+     */
+    public static int cuRangePop()
+    {
+        return checkResult(cuRangePopNative());
+    }
+    private static native int cuRangePopNative();
+
+
+    /**
+     * Returns the number of ranges for which statistics have been
+     * aggregated.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param count Will store the number of ranges
+     *
+     * @return CUDA_SUCCESS
+     */
+    public static int cuRangeGetCount(int count[])
+    {
+        return checkResult(cuRangeGetCountNative(count));
+    }
+    private static native int cuRangeGetCountNative(int count[]);
+
+
+    /**
+     * Returns the statistics of the range with the given index, in
+     * the order of the range paths. All times are given in milliseconds.
+     * Bin <i>i</i> of the histogram counts the times between 2<sup>i</sup>
+     * and 2<sup>i+1</sup> microseconds. As many bins are returned as
+     * fit into the given array (at most 24).<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param index The index of the range
+     * @param name Will store the path of the range
+     * @param count Will store the number of times of the range
+     * @param totalTime Will store the total time
+     * @param minTime Will store the minimum time
+     * @param maxTime Will store the maximum time
+     * @param histogram Will store the histogram of the times
+     *
+     * @return CUDA_SUCCESS, CUDA_ERROR_INVALID_VALUE
+     */
+    public static int cuRangeGetStatistics(int index, String name[], long count[], double totalTime[], float minTime[], float maxTime[], long histogram[])
+    {
+        return checkResult(cuRangeGetStatisticsNative(index, name, count, totalTime, minTime, maxTime, histogram));
+    }
+    private static native int cuRangeGetStatisticsNative(int index, String name[], long count[], double totalTime[], float minTime[], float maxTime[], long histogram[]);
+
+
+    /**
+     * Removes the statistics of all ranges.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @return CUDA_SUCCESS
+     */
+    public static int cuRangeReset()
+    {
+        return checkResult(cuRangeResetNative());
+    }
+    private static native int cuRangeResetNative();
+
+
 
 
 
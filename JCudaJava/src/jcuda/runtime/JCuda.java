@@ -27,6 +27,9 @@
 
 package jcuda.runtime;
 
+import java.util.List;
+import java.util.concurrent.CopyOnWriteArrayList;
+
 import jcuda.*;
 
 
@@ -302,6 +305,13 @@ public class JCuda
      */
     private static boolean exceptionsEnabled = false;
 
+    /**
+     * The listeners that are informed before devices are reset and
+     * streams are destroyed
+     */
+    private static final List<cudaResourceListener> resourceListeners =
+        new CopyOnWriteArrayList<cudaResourceListener>();
+
 
     /* Private constructor to prevent instantiation */
     private JCuda()
@@ -1546,6 +1556,31 @@ public class JCuda
         return checkResult(cudaDeviceGetAttributeNative(value, cudaDeviceAttr_attr, device));
     }
     private static native int cudaDeviceGetAttributeNative(int value[], int cudaDeviceAttr_attr, int device);
+
+
+    /**
+     * Obtains a snapshot of the attributes, the total global memory
+     * and the name of all devices. The snapshot is created once, when
+     * this function is first called, and the same data is returned for
+     * all subsequent calls. This allows querying all device properties
+     * without one native call per attribute. The layout of the data
+     * is described in the {@link cudaDeviceSnapshot} class.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param snapshot The snapshot that will be initialized
+     * @return cudaSuccess, cudaErrorNoDevice, cudaErrorInsufficientDriver
+     *
+     * @see JCuda#cudaDeviceGetAttribute
+     * @see JCuda#cudaGetDeviceProperties
+     */
+    public static int cudaGetDeviceSnapshot(cudaDeviceSnapshot snapshot)
+    {
+        return checkResult(cudaGetDeviceSnapshotNative(snapshot));
+    }
+    private static native int cudaGetDeviceSnapshotNative(cudaDeviceSnapshot snapshot);
     
 
     /**
@@ -3603,6 +3638,120 @@ public class JCuda
     private static native int cudaHostUnregisterNative(Pointer ptr);
 
 
+    /**
+     * Enables the registration cache for direct ByteBuffers. The
+     * transfers between host and device memory with
+     * {@link JCuda#cudaMemcpy} and {@link JCuda#cudaMemcpyAsync} are
+     * counted for each direct ByteBuffer. When a buffer has been used
+     * for the given number of transfers, its memory is registered as
+     * page-locked memory, as if with {@link JCuda#cudaHostRegister},
+     * so that the following transfers may use the full bandwidth, and
+     * asynchronous transfers do not have to be staged synchronously.<br />
+     * <br />
+     * The total size of the registered buffers does not exceed the
+     * given budget. When another buffer has to be registered, the
+     * least recently used buffers are evicted. An evicted buffer is
+     * unregistered as soon as the asynchronous transfers that used
+     * it are complete, without synchronizing the device, and the
+     * other buffer is registered with one of its next transfers.<br />
+     * <br />
+     * A registered buffer can not be garbage collected until it has
+     * been unregistered. Buffers whose memory is freed explicitly
+     * should be released with {@link JCuda#cudaRegistrationCacheRelease} before.<br />
+     * <br />
+     * If the cache is already enabled, then its parameters are updated.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param threshold The number of transfers after which a buffer
+     * is registered
+     * @param budget The maximum number of bytes that are registered
+     *
+     * @return cudaSuccess, cudaErrorInvalidValue
+     *
+     * @see JCuda#cudaRegistrationCacheDisable
+     * @see JCuda#cudaRegistrationCacheGetStatistics
+     */
+    public static int cudaRegistrationCacheEnable(int threshold, long budget)
+    {
+        return checkResult(cudaRegistrationCacheEnableNative(threshold, budget));
+    }
+    private static native int cudaRegistrationCacheEnableNative(int threshold, long budget);
+
+
+    /**
+     * Disables the registration cache, and unregisters all buffers that
+     * have been registered by the cache, after the pending asynchronous
+     * transfers from or to these buffers are complete.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @return cudaSuccess
+     *
+     * @see JCuda#cudaRegistrationCacheEnable
+     */
+    public static int cudaRegistrationCacheDisable()
+    {
+        return checkResult(cudaRegistrationCacheDisableNative());
+    }
+    private static native int cudaRegistrationCacheDisableNative();
+
+
+    /**
+     * Unregisters the direct ByteBuffer that the given pointer refers
+     * to, if it has been registered by the registration cache, after
+     * the pending asynchronous transfers from or to the buffer are
+     * complete. This should be called before the memory of the buffer
+     * is freed.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param buffer The pointer to the direct ByteBuffer
+     *
+     * @return cudaSuccess
+     *
+     * @see JCuda#cudaRegistrationCacheEnable
+     */
+    public static int cudaRegistrationCacheRelease(Pointer buffer)
+    {
+        return checkResult(cudaRegistrationCacheReleaseNative(buffer));
+    }
+    private static native int cudaRegistrationCacheReleaseNative(Pointer buffer);
+
+
+    /**
+     * Returns the statistics of the registration cache: The number of
+     * buffers and bytes that are currently registered, the number of
+     * transfers that did and did not use a registered buffer, and the
+     * number of buffers that have been unregistered to meet the budget.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param registeredCount Will store the number of registered buffers
+     * @param registeredBytes Will store the number of registered bytes
+     * @param hits Will store the number of transfers that used a
+     * registered buffer
+     * @param misses Will store the number of transfers that used a
+     * buffer that was not registered
+     * @param evictions Will store the number of evicted buffers
+     *
+     * @return cudaSuccess
+     */
+    public static int cudaRegistrationCacheGetStatistics(long registeredCount[], long registeredBytes[], long hits[], long misses[], long evictions[])
+    {
+        return checkResult(cudaRegistrationCacheGetStatisticsNative(registeredCount, registeredBytes, hits, misses, evictions));
+    }
+    private static native int cudaRegistrationCacheGetStatisticsNative(long registeredCount[], long registeredBytes[], long hits[], long misses[], long evictions[]);
+
+
     /**
      * Passes back device pointer of mapped host memory allocated by cudaHostAlloc or registered by cudaHostRegister.
      * 
@@ -4145,6 +4294,233 @@ public class JCuda
     private static native int cudaFreeHostNative(Pointer ptr);
 
 
+    /**
+     * Sets the placement mode for page-locked host memory that is
+     * allocated with {@link JCuda#cudaHostAlloc} and
+     * {@link JCuda#cudaMallocHost}, as one of the
+     * {@link cudaHostPlacement} constants.<br />
+     * <br />
+     * With cudaHostPlacementDevice, the memory is allocated on the NUMA
+     * node that the current device is attached to, as reported by
+     * {@link JCuda#cudaDeviceGetHostNumaNode}, and then page-locked.
+     * Memory that should be write-combined, and memory for devices
+     * whose node is not known, is allocated as usual. The memory has
+     * to be freed with {@link JCuda#cudaFreeHost}. Currently, this
+     * placement is only supported on Linux.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param mode The cudaHostPlacement mode
+     *
+     * @return cudaSuccess, cudaErrorInvalidValue
+     *
+     * @see JCuda#cudaHostGetNumaNode
+     */
+    public static int cudaHostSetPlacement(int mode)
+    {
+        return checkResult(cudaHostSetPlacementNative(mode));
+    }
+    private static native int cudaHostSetPlacementNative(int mode);
+
+
+    /**
+     * Returns the NUMA node that the given host memory is located on,
+     * or -1 if this is not known, e.g. because the platform does not
+     * support NUMA, or the memory was not accessed yet.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param node Will store the NUMA node
+     * @param ptr The host memory
+     *
+     * @return cudaSuccess
+     *
+     * @see JCuda#cudaHostSetPlacement
+     */
+    public static int cudaHostGetNumaNode(int node[], Pointer ptr)
+    {
+        return checkResult(cudaHostGetNumaNodeNative(node, ptr));
+    }
+    private static native int cudaHostGetNumaNodeNative(int node[], Pointer ptr);
+
+
+    /**
+     * Returns the NUMA node that the given device is attached to, as
+     * read from the numa_node entry of its PCI bus ID in the sysfs
+     * tree, or -1 if this is not known.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param node Will store the NUMA node
+     * @param device The device
+     *
+     * @return cudaSuccess
+     *
+     * @see JCuda#cudaHostSetPlacement
+     */
+    public static int cudaDeviceGetHostNumaNode(int node[], int device)
+    {
+        return checkResult(cudaDeviceGetHostNumaNodeNative(node, device));
+    }
+    private static native int cudaDeviceGetHostNumaNodeNative(int node[], int device);
+
+
+    /**
+     * Creates a new arena for page-locked host memory.<br />
+     * <br />
+     * The arena allocates regions of the given size with
+     * {@link JCuda#cudaHostAlloc(Pointer, long, int)}, using the
+     * given flags, and hands out slices of these regions that are
+     * aligned to the given alignment. Allocating and freeing a slice
+     * does not involve any call to the driver, except for when the
+     * arena has to allocate a new region. Each thread keeps a small
+     * cache of freed slices, so that allocating and freeing slices
+     * from multiple threads does not cause contention.<br />
+     * <br />
+     * Requests are rounded up to one of the internal size classes. The
+     * largest size class is a quarter of the region size. Larger requests
+     * receive a dedicated allocation, which is released when the slice
+     * is freed.<br />
+     * <br />
+     * The regions are allocated for the current device. Unless the
+     * cudaHostAllocPortable flag is given, the slices are only
+     * considered as page-locked memory by the context of this device.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param arena Returned arena
+     * @param regionSize The size of the regions, in bytes
+     * @param alignment The alignment of the slices, which must be a
+     * power of two
+     * @param flags The flags for cudaHostAlloc
+     *
+     * @return cudaSuccess, cudaErrorInvalidValue
+     *
+     * @see JCuda#cudaHostArenaAlloc
+     * @see JCuda#cudaHostArenaFree
+     * @see JCuda#cudaHostArenaGetStatistics
+     * @see JCuda#cudaHostArenaDestroy
+     */
+    public static int cudaHostArenaCreate(cudaHostArena arena, long regionSize, long alignment, int flags)
+    {
+        return checkResult(cudaHostArenaCreateNative(arena, regionSize, alignment, flags));
+    }
+    private static native int cudaHostArenaCreateNative(cudaHostArena arena, long regionSize, long alignment, int flags);
+
+
+    /**
+     * Destroys the given arena, and releases all regions of page-locked
+     * memory that are held by the arena. All slices that have been
+     * allocated from this arena become invalid.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param arena The arena to destroy
+     *
+     * @return cudaSuccess, cudaErrorInvalidResourceHandle
+     *
+     * @see JCuda#cudaHostArenaCreate
+     */
+    public static int cudaHostArenaDestroy(cudaHostArena arena)
+    {
+        return checkResult(cudaHostArenaDestroyNative(arena));
+    }
+    private static native int cudaHostArenaDestroyNative(cudaHostArena arena);
+
+
+    /**
+     * Allocates a slice of page-locked host memory from the given arena.
+     * The given pointer will afterwards point to the slice, and
+     * {@link Pointer#getByteBuffer(long, long)} may be used to access
+     * the memory, just as for memory that was allocated with
+     * {@link JCuda#cudaHostAlloc(Pointer, long, int)}.<br />
+     * <br />
+     * The slice must be freed with
+     * {@link JCuda#cudaHostArenaFree(cudaHostArena, Pointer)},
+     * passing in the same pointer object.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param arena The arena
+     * @param ptr Returned host pointer to page-locked memory
+     * @param size Requested allocation size in bytes
+     *
+     * @return cudaSuccess, cudaErrorInvalidResourceHandle, cudaErrorInvalidValue,
+     * or the error code of cudaHostAlloc when a new region could not
+     * be allocated
+     *
+     * @see JCuda#cudaHostArenaCreate
+     * @see JCuda#cudaHostArenaFree
+     */
+    public static int cudaHostArenaAlloc(cudaHostArena arena, Pointer ptr, long size)
+    {
+        return checkResult(cudaHostArenaAllocNative(arena, ptr, size));
+    }
+    private static native int cudaHostArenaAllocNative(cudaHostArena arena, Pointer ptr, long size);
+
+
+    /**
+     * Returns the given slice to the given arena. The pointer must have
+     * been obtained with
+     * {@link JCuda#cudaHostArenaAlloc(cudaHostArena, Pointer, long)}
+     * from the same arena. Afterwards, the pointer is cleared, so
+     * that freeing it again, or freeing a pointer that was not
+     * obtained from the arena, fails with an error instead of
+     * corrupting the arena.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param arena The arena
+     * @param ptr The pointer to the slice
+     *
+     * @return cudaSuccess, cudaErrorInvalidResourceHandle, cudaErrorInvalidValue
+     *
+     * @see JCuda#cudaHostArenaCreate
+     * @see JCuda#cudaHostArenaAlloc
+     */
+    public static int cudaHostArenaFree(cudaHostArena arena, Pointer ptr)
+    {
+        return checkResult(cudaHostArenaFreeNative(arena, ptr));
+    }
+    private static native int cudaHostArenaFreeNative(cudaHostArena arena, Pointer ptr);
+
+
+    /**
+     * Writes the current statistics of the given arena, including its
+     * high-water mark and fragmentation, into the given object.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param arena The arena
+     * @param statistics Returned statistics
+     *
+     * @return cudaSuccess, cudaErrorInvalidResourceHandle
+     *
+     * @see JCuda#cudaHostArenaCreate
+     */
+    public static int cudaHostArenaGetStatistics(cudaHostArena arena, cudaHostArenaStatistics statistics)
+    {
+        return checkResult(cudaHostArenaGetStatisticsNative(arena, statistics));
+    }
+    private static native int cudaHostArenaGetStatisticsNative(cudaHostArena arena, cudaHostArenaStatistics statistics);
+
+
     /**
      * Frees an array on the device.
      * 
@@ -4302,6 +4678,77 @@ public class JCuda
     private static native int cudaMemcpyNative(Pointer dst, Pointer src, long count, int cudaMemcpyKind_kind);
 
 
+    /**
+     * Copies data between two memory regions, determining the direction
+     * of the copy automatically.<br />
+     * <br />
+     * All allocations that are made through JCuda (with cudaMalloc,
+     * cudaMallocPitch, cudaMalloc3D, cudaMallocHost, cudaHostAlloc,
+     * cudaHostRegister and the host arenas) are recorded natively,
+     * together with their kind and the device that was current when
+     * they were made. This function looks up the given pointers in this
+     * record, and uses the appropriate cudaMemcpyKind, or cudaMemcpyPeer
+     * for copies between devices. Copies between Java arrays or buffers
+     * that are not page-locked are done with a plain memcpy. When one of
+     * the pointers is not known (e.g. because the memory was allocated
+     * by another library), then cudaMemcpyDefault is used, which requires
+     * unified virtual addressing.<br />
+     * <br />
+     * The allocations are only recorded after the record has been used
+     * for the first time, by this function, by
+     * {@link #cudaMemRegistryLookup} or by the copy planner, so that
+     * allocations do not pay for it otherwise. Allocations that have
+     * been made before are not known. The record only contains the
+     * allocations of the runtime API bindings. The allocations of the
+     * driver API bindings are recorded separately.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param dst Destination memory address
+     * @param src Source memory address
+     * @param count Size in bytes to copy
+     * @return cudaSuccess, cudaErrorInvalidValue, cudaErrorInvalidDevicePointer
+     *
+     * @see JCuda#cudaMemcpy
+     * @see JCuda#cudaMemRegistryLookup
+     */
+    public static int cudaMemcpyAuto(Pointer dst, Pointer src, long count)
+    {
+        return checkResult(cudaMemcpyAutoNative(dst, src, count));
+    }
+    private static native int cudaMemcpyAutoNative(Pointer dst, Pointer src, long count);
+
+
+    /**
+     * Looks up the given pointer in the record of the allocations that
+     * have been made through JCuda (see {@link #cudaMemcpyAuto}). The
+     * memory type will be set to the {@link cudaMemoryType} of the
+     * allocation that contains the pointer, or to 0 if the pointer is
+     * not contained in any known allocation. The device will be set to
+     * the device that was current when the allocation was made, or to
+     * -1 if it is not known.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param memoryType Will store the memory type
+     * @param device Will store the device
+     * @param ptr The pointer to look up
+     * @return cudaSuccess
+     *
+     * @see JCuda#cudaMemcpyAuto
+     * @see JCuda#cudaPointerGetAttributes
+     */
+    public static int cudaMemRegistryLookup(int memoryType[], int device[], Pointer ptr)
+    {
+        return checkResult(cudaMemRegistryLookupNative(memoryType, device, ptr));
+    }
+    private static native int cudaMemRegistryLookupNative(int memoryType[], int device[], Pointer ptr);
+
+
     /**
      * Copies memory between two devices.
      * 
@@ -5153,6 +5600,344 @@ public class JCuda
     }
     private static native int cudaMemcpyAsyncNative(Pointer dst, Pointer src, long count, int cudaMemcpyKind_kind, cudaStream_t stream);
 
+
+    /**
+     * Enables the copy planner for {@link JCuda#cudaMemcpy} and
+     * {@link JCuda#cudaMemcpyAsync}. The planner classifies the host
+     * memory of each copy between host and device memory as a Java
+     * array, a pageable direct buffer, or page-locked memory, and
+     * chooses a {@link cudaCopyStrategy}:<br />
+     * <br />
+     * Copies from or to page-locked memory, and copies that are smaller
+     * than the given staging threshold, are executed directly.<br />
+     * <br />
+     * Copies from or to Java arrays and pageable direct buffers are
+     * staged through page-locked buffers of the given chunk size. The
+     * host memory is only accessed while a chunk is copied into or out
+     * of a staging buffer, so that Java arrays are not pinned for the
+     * whole transfer. Copies that are larger than one chunk are
+     * pipelined over a ring of staging buffers and two internal
+     * streams.<br />
+     * <br />
+     * Staged copies are ordered with respect to the stream of the
+     * caller. Staged copies from the device to the host are complete
+     * when the call returns, also for {@link JCuda#cudaMemcpyAsync}.
+     * The staging buffers are allocated for each device when they are
+     * first used, and released by {@link JCuda#cudaDeviceReset}.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param chunkSize The size of the staging buffers, in bytes
+     * @param stagingThreshold The minimum size of copies that are staged
+     *
+     * @return cudaSuccess, cudaErrorInvalidValue
+     *
+     * @see JCuda#cudaCopyPlannerDisable
+     * @see JCuda#cudaCopyPlannerGetLastStrategy
+     * @see JCuda#cudaCopyPlannerGetStatistics
+     */
+    public static int cudaCopyPlannerEnable(long chunkSize, long stagingThreshold)
+    {
+        return checkResult(cudaCopyPlannerEnableNative(chunkSize, stagingThreshold));
+    }
+    private static native int cudaCopyPlannerEnableNative(long chunkSize, long stagingThreshold);
+
+
+    /**
+     * Disables the copy planner, so that all copies are executed
+     * directly.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @return cudaSuccess
+     *
+     * @see JCuda#cudaCopyPlannerEnable
+     */
+    public static int cudaCopyPlannerDisable()
+    {
+        return checkResult(cudaCopyPlannerDisableNative());
+    }
+    private static native int cudaCopyPlannerDisableNative();
+
+
+    /**
+     * Returns the {@link cudaCopyStrategy} that was chosen for the
+     * last copy between host and device memory of the calling thread
+     * with {@link JCuda#cudaMemcpy} or {@link JCuda#cudaMemcpyAsync},
+     * or -1 if there was no such copy. Only the copies that are made
+     * while the planner is enabled are recorded.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param strategy Will store the strategy
+     *
+     * @return cudaSuccess
+     *
+     * @see JCuda#cudaCopyPlannerEnable
+     */
+    public static int cudaCopyPlannerGetLastStrategy(int strategy[])
+    {
+        return checkResult(cudaCopyPlannerGetLastStrategyNative(strategy));
+    }
+    private static native int cudaCopyPlannerGetLastStrategyNative(int strategy[]);
+
+
+    /**
+     * Returns the number of copies and bytes that have been copied
+     * with each {@link cudaCopyStrategy}.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param directCount Will store the number of direct copies
+     * @param directBytes Will store the number of bytes copied directly
+     * @param stagedCount Will store the number of staged copies
+     * @param stagedBytes Will store the number of bytes copied staged
+     * @param chunkedCount Will store the number of chunked copies
+     * @param chunkedBytes Will store the number of bytes copied in chunks
+     *
+     * @return cudaSuccess
+     *
+     * @see JCuda#cudaCopyPlannerEnable
+     */
+    public static int cudaCopyPlannerGetStatistics(long directCount[], long directBytes[], long stagedCount[], long stagedBytes[], long chunkedCount[], long chunkedBytes[])
+    {
+        return checkResult(cudaCopyPlannerGetStatisticsNative(directCount, directBytes, stagedCount, stagedBytes, chunkedCount, chunkedBytes));
+    }
+    private static native int cudaCopyPlannerGetStatisticsNative(long directCount[], long directBytes[], long stagedCount[], long stagedBytes[], long chunkedCount[], long chunkedBytes[]);
+
+
+    /**
+     * Enables the bounce ring for asynchronous copies between Java
+     * arrays and device memory with {@link JCuda#cudaMemcpyAsync}. Each
+     * stream gets up to the given number of page-locked slots of the
+     * given size, which are used in turn:<br />
+     * <br />
+     * For a copy from a Java array, the array is copied into the next
+     * slot, and the copy from this slot is enqueued, so that the array
+     * may be modified as soon as the call returns. For a copy into a
+     * Java array, the copy into the next slot is enqueued, and the slot
+     * is copied into the array when the copy is known to be complete:
+     * When the stream, device or event is synchronized with
+     * {@link JCuda#cudaStreamSynchronize},
+     * {@link JCuda#cudaDeviceSynchronize} or
+     * {@link JCuda#cudaEventSynchronize}, or found to be complete with
+     * {@link JCuda#cudaStreamQuery} or {@link JCuda#cudaEventQuery}, or
+     * when an event future is completed. The array must not be accessed
+     * before that, as usual for asynchronous copies.<br />
+     * <br />
+     * Only the synchronization functions of the runtime API complete
+     * the copies into Java arrays. Synchronizing with the driver API,
+     * for example with cuCtxSynchronize, does not complete them.<br />
+     * <br />
+     * The calling thread only waits when all slots of the stream are
+     * still used by pending copies. Copies that are larger than one slot
+     * are split into chunks of the slot size. If no slot is available
+     * for a chunk, then the remaining chunks are copied directly, and
+     * a copy into a Java array then waits until the stream is complete.
+     * The slots of a stream are released by
+     * {@link JCuda#cudaStreamDestroy} and
+     * {@link JCuda#cudaDeviceReset}.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param slotSize The size of each slot, in bytes
+     * @param slotCount The maximum number of slots for each stream
+     *
+     * @return cudaSuccess, cudaErrorInvalidValue
+     *
+     * @see JCuda#cudaBounceRingDisable
+     * @see JCuda#cudaBounceRingGetStatistics
+     */
+    public static int cudaBounceRingEnable(long slotSize, int slotCount)
+    {
+        return checkResult(cudaBounceRingEnableNative(slotSize, slotCount));
+    }
+    private static native int cudaBounceRingEnableNative(long slotSize, int slotCount);
+
+
+    /**
+     * Disables the bounce ring. The pending copies are completed, and
+     * all slots are released.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @return cudaSuccess
+     *
+     * @see JCuda#cudaBounceRingEnable
+     */
+    public static int cudaBounceRingDisable()
+    {
+        return checkResult(cudaBounceRingDisableNative());
+    }
+    private static native int cudaBounceRingDisableNative();
+
+
+    /**
+     * Returns the statistics of the bounce ring: The number of copies
+     * and bytes that went through a slot, the number of times that a
+     * thread had to wait for a slot, and the number of copies into Java
+     * arrays that have not been completed yet.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param copies Will store the number of bounced copies
+     * @param bytes Will store the number of bounced bytes
+     * @param waits Will store the number of waits for a slot
+     * @param pending Will store the number of pending copies into arrays
+     *
+     * @return cudaSuccess
+     *
+     * @see JCuda#cudaBounceRingEnable
+     */
+    public static int cudaBounceRingGetStatistics(long copies[], long bytes[], long waits[], long pending[])
+    {
+        return checkResult(cudaBounceRingGetStatisticsNative(copies, bytes, waits, pending));
+    }
+    private static native int cudaBounceRingGetStatisticsNative(long copies[], long bytes[], long waits[], long pending[]);
+
+
+    /**
+     * Adds the given listener, which will be informed before the
+     * current device is reset with {@link JCuda#cudaDeviceReset} or
+     * {@link JCuda#cudaThreadExit}, and before a stream is destroyed
+     * with {@link JCuda#cudaStreamDestroy}. This allows libraries that
+     * keep their own resources for devices or streams to release
+     * them.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param listener The listener
+     * @throws NullPointerException If the listener is null
+     *
+     * @see JCuda#removeResourceListener(cudaResourceListener)
+     */
+    public static void addResourceListener(cudaResourceListener listener)
+    {
+        if (listener == null)
+        {
+            throw new NullPointerException("The listener is null");
+        }
+        resourceListeners.add(listener);
+    }
+
+    /**
+     * Removes the given listener, so that it is no longer informed
+     * about devices that are reset and streams that are destroyed.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param listener The listener
+     *
+     * @see JCuda#addResourceListener(cudaResourceListener)
+     */
+    public static void removeResourceListener(cudaResourceListener listener)
+    {
+        resourceListeners.remove(listener);
+    }
+
+
+    /**
+     * Enables the pitch packer for 2D and 3D copies between Java arrays
+     * and device memory, with {@link JCuda#cudaMemcpy2D} and
+     * {@link JCuda#cudaMemcpy3D}, as long as no CUDA array is involved.
+     * Instead of passing the pitched rows of the array to CUDA, which
+     * copies them from pageable memory, the rows are packed into a
+     * contiguous page-locked staging buffer, which is then transferred
+     * with a single copy. For copies into Java arrays, the staging
+     * buffer is unpacked into the rows of the array. The array is only
+     * accessed while it is packed or unpacked, and not during the
+     * transfer.<br />
+     * <br />
+     * The rows are copied by the calling thread and a pool of worker
+     * threads, and are written into the staging buffer with non-temporal
+     * SSE2 stores where available. Copies that are smaller than the
+     * given threshold are executed directly. The staging buffers are
+     * released by {@link JCuda#cudaDeviceReset}.<br />
+     * <br />
+     * The time that is spent for packing and unpacking is reported by
+     * {@link JCuda#cudaPitchPackerGetStatistics}, so that it may be
+     * compared to the time of the copies without the packer.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param threadCount The number of threads, including the calling
+     * thread, or 0 to use the number of processors
+     * @param threshold The minimum size of packed copies, in bytes
+     *
+     * @return cudaSuccess, cudaErrorInvalidValue, cudaErrorUnknown
+     *
+     * @see JCuda#cudaPitchPackerDisable
+     * @see JCuda#cudaPitchPackerGetStatistics
+     */
+    public static int cudaPitchPackerEnable(int threadCount, long threshold)
+    {
+        return checkResult(cudaPitchPackerEnableNative(threadCount, threshold));
+    }
+    private static native int cudaPitchPackerEnableNative(int threadCount, long threshold);
+
+
+    /**
+     * Disables the pitch packer, stops its worker threads, and releases
+     * all staging buffers.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @return cudaSuccess
+     *
+     * @see JCuda#cudaPitchPackerEnable
+     */
+    public static int cudaPitchPackerDisable()
+    {
+        return checkResult(cudaPitchPackerDisableNative());
+    }
+    private static native int cudaPitchPackerDisableNative();
+
+
+    /**
+     * Returns the statistics of the pitch packer: The number of copies
+     * and bytes that have been packed or unpacked, and the time that
+     * was spent for packing and unpacking, in nanoseconds.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param copies Will store the number of packed copies
+     * @param bytes Will store the number of packed bytes
+     * @param nanos Will store the time for packing, in nanoseconds
+     *
+     * @return cudaSuccess
+     *
+     * @see JCuda#cudaPitchPackerEnable
+     */
+    public static int cudaPitchPackerGetStatistics(long copies[], long bytes[], long nanos[])
+    {
+        return checkResult(cudaPitchPackerGetStatisticsNative(copies, bytes, nanos));
+    }
+    private static native int cudaPitchPackerGetStatisticsNative(long copies[], long bytes[], long nanos[]);
+
     /**
      * Copies memory between two devices asynchronously.
      * 
@@ -5217,6 +6002,100 @@ public class JCuda
     private static native int cudaMemcpyPeerAsyncNative(Pointer dst, int dstDevice, Pointer src, int srcDevice, long count, cudaStream_t stream);
 
 
+    /**
+     * Enables the routing of copies between devices with
+     * {@link JCuda#cudaMemcpyPeer} and {@link JCuda#cudaMemcpyPeerAsync}.
+     * When it is enabled for the first time, the topology is discovered:
+     * Which devices may access each other, and their PCI bus IDs. Peer
+     * access between two devices is enabled when the first copy between
+     * them is made. Copies between devices that can not access each
+     * other are split into chunks of the given size, and staged through
+     * two page-locked buffers, so that the transfers out of the source
+     * device overlap with the transfers into the destination device.<br />
+     * <br />
+     * For an asynchronous copy that is staged, the given stream must
+     * belong to the destination device.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param chunkSize The size of the chunks of staged copies, in bytes
+     *
+     * @return cudaSuccess, cudaErrorInvalidValue
+     *
+     * @see JCuda#cudaPeerRouterGetRoute
+     */
+    public static int cudaPeerRouterEnable(long chunkSize)
+    {
+        return checkResult(cudaPeerRouterEnableNative(chunkSize));
+    }
+    private static native int cudaPeerRouterEnableNative(long chunkSize);
+
+
+    /**
+     * Disables the routing of copies between devices, after all staged
+     * copies have been completed, and releases the staging buffers.
+     * Peer access that has been enabled remains enabled.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @return cudaSuccess
+     */
+    public static int cudaPeerRouterDisable()
+    {
+        return checkResult(cudaPeerRouterDisableNative());
+    }
+    private static native int cudaPeerRouterDisableNative();
+
+
+    /**
+     * Returns the route that is taken for copies from the given source
+     * device to the given destination device, as one of the
+     * {@link cudaPeerRoute} constants.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param route Will store the route
+     * @param srcDevice The source device
+     * @param dstDevice The destination device
+     *
+     * @return cudaSuccess
+     */
+    public static int cudaPeerRouterGetRoute(int route[], int srcDevice, int dstDevice)
+    {
+        return checkResult(cudaPeerRouterGetRouteNative(route, srcDevice, dstDevice));
+    }
+    private static native int cudaPeerRouterGetRouteNative(int route[], int srcDevice, int dstDevice);
+
+
+    /**
+     * Returns the number of copies and bytes that have been routed
+     * while the router was enabled, directly or staged through host
+     * memory.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param directCount Will store the number of direct copies
+     * @param directBytes Will store the number of bytes of direct copies
+     * @param stagedCount Will store the number of staged copies
+     * @param stagedBytes Will store the number of bytes of staged copies
+     *
+     * @return cudaSuccess
+     */
+    public static int cudaPeerRouterGetStatistics(long directCount[], long directBytes[], long stagedCount[], long stagedBytes[])
+    {
+        return checkResult(cudaPeerRouterGetStatisticsNative(directCount, directBytes, stagedCount, stagedBytes));
+    }
+    private static native int cudaPeerRouterGetStatisticsNative(long directCount[], long directBytes[], long stagedCount[], long stagedBytes[]);
+
+
     /**
      * Copies data between host and device.
      * 
@@ -6352,6 +7231,10 @@ public class JCuda
      */    
     public static int cudaStreamDestroy(cudaStream_t stream)
     {
+        for (cudaResourceListener listener : resourceListeners)
+        {
+            listener.streamDestroying(stream);
+        }
         return checkResult(cudaStreamDestroyNative(stream));
     }
     private static native int cudaStreamDestroyNative(cudaStream_t stream);
@@ -6908,6 +7791,57 @@ public class JCuda
     private static native int cudaEventDestroyNative(cudaEvent_t event);
 
 
+    /**
+     * Registers the given event, which must have been recorded with
+     * {@link JCuda#cudaEventRecord}, so that the given future is
+     * completed when the event has been completed. A single native
+     * thread polls all registered events, and completes the futures
+     * in batches, so the calling thread does not block, and no thread
+     * has to block for each pending event.<br />
+     * <br />
+     * The event must not be destroyed or recorded again until the
+     * future has been completed. A future may only be registered once.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param future The future
+     * @param event The event
+     *
+     * @return cudaSuccess, cudaErrorUnknown
+     *
+     * @see EventFuture#addListener(jcuda.EventFutureListener)
+     */
+    public static int cudaEventRegisterFuture(EventFuture future, cudaEvent_t event)
+    {
+        return checkResult(cudaEventRegisterFutureNative(future, event));
+    }
+    private static native int cudaEventRegisterFutureNative(EventFuture future, cudaEvent_t event);
+
+
+    /**
+     * Returns the number of events that are registered and not completed
+     * yet, the number of events that have been completed, and the number
+     * of batches in which the futures of these events have been completed.<br />
+     * <br />
+     * <u>Note:</u> This is not a CUDA function, but a JCuda-specific
+     * extension. It should be considered as preliminary, and might
+     * change in future releases.
+     *
+     * @param pending Will store the number of pending events
+     * @param completed Will store the number of completed events
+     * @param batches Will store the number of batches
+     *
+     * @return cudaSuccess
+     */
+    public static int cudaEventFutureGetStatistics(long pending[], long completed[], long batches[])
+    {
+        return checkResult(cudaEventFutureGetStatisticsNative(pending, completed, batches));
+    }
+    private static native int cudaEventFutureGetStatisticsNative(long pending[], long completed[], long batches[]);
+
+
     /**
      * Computes the elapsed time between events.
      * 
@@ -7015,6 +7949,10 @@ public class JCuda
      */    
     public static int cudaDeviceReset()
     {
+        for (cudaResourceListener listener : resourceListeners)
+        {
+            listener.deviceResetting();
+        }
         return checkResult(cudaDeviceResetNative());
     }
     private static native int cudaDeviceResetNative();
@@ -7931,6 +8869,10 @@ public class JCuda
      */    
     public static int cudaThreadExit()
     {
+        for (cudaResourceListener listener : resourceListeners)
+        {
+            listener.deviceResetting();
+        }
         return checkResult(cudaThreadExitNative());
     }
     private static native int cudaThreadExitNative();
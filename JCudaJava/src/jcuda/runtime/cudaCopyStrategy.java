@@ -0,0 +1,82 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+package jcuda.runtime;
+
+/**
+ * The strategies that the copy planner may choose for copies between
+ * host and device memory.<br />
+ * <br />
+ * <u>Note:</u> This is not a CUDA type, but a JCuda-specific extension.
+ *
+ * @see jcuda.runtime.JCuda#cudaCopyPlannerEnable
+ */
+public class cudaCopyStrategy
+{
+    /**
+     * The memory of the caller is passed to the runtime
+     */
+    public static final int cudaCopyStrategyDirect = 0;
+
+    /**
+     * The host memory is copied through one page-locked
+     * staging buffer
+     */
+    public static final int cudaCopyStrategyStaged = 1;
+
+    /**
+     * The copy is split into chunks that are staged through
+     * a ring of page-locked buffers, and distributed over
+     * several streams
+     */
+    public static final int cudaCopyStrategyChunked = 2;
+
+    /**
+     * Returns the String identifying the given cudaCopyStrategy
+     *
+     * @param n The cudaCopyStrategy
+     * @return The String identifying the given cudaCopyStrategy
+     */
+    public static String stringFor(int n)
+    {
+        switch (n)
+        {
+            case cudaCopyStrategyDirect: return "cudaCopyStrategyDirect";
+            case cudaCopyStrategyStaged: return "cudaCopyStrategyStaged";
+            case cudaCopyStrategyChunked: return "cudaCopyStrategyChunked";
+        }
+        return "INVALID cudaCopyStrategy: "+n;
+    }
+
+    /**
+     * Private constructor to prevent instantiation.
+     */
+    private cudaCopyStrategy()
+    {
+    }
+
+}
@@ -0,0 +1,98 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+package jcuda.runtime;
+
+/**
+ * Statistics about the state of a {@link cudaHostArena}.<br />
+ * <br />
+ * <u>Note:</u> This is not a CUDA type, but a JCuda-specific extension.
+ *
+ * @see jcuda.runtime.JCuda#cudaHostArenaGetStatistics
+ */
+public class cudaHostArenaStatistics
+{
+    /**
+     * The number of bytes of page-locked memory that are held by the arena
+     */
+    public long reservedBytes;
+
+    /**
+     * The number of bytes in the slices that are currently allocated.
+     * This includes the bytes that are added due to the rounding
+     * to the internal size classes.
+     */
+    public long usedBytes;
+
+    /**
+     * The number of bytes that have been requested for the slices
+     * that are currently allocated
+     */
+    public long requestedBytes;
+
+    /**
+     * The maximum value that {@link #usedBytes} ever had
+     */
+    public long highWaterMark;
+
+    /**
+     * The number of regions of page-locked memory that are held by the arena
+     */
+    public long regionCount;
+
+    /**
+     * The fraction of the memory that was handed out of the regions
+     * that does not hold requested data: The waste due to rounding
+     * to size classes, plus the slices that have been freed and are
+     * kept for re-use.
+     */
+    public float fragmentation;
+
+    /**
+     * Creates a new, uninitialized cudaHostArenaStatistics
+     */
+    public cudaHostArenaStatistics()
+    {
+    }
+
+    /**
+     * Returns a String representation of this object.
+     *
+     * @return A String representation of this object.
+     */
+    @Override
+    public String toString()
+    {
+        return "cudaHostArenaStatistics["+
+            "reservedBytes="+reservedBytes+","+
+            "usedBytes="+usedBytes+","+
+            "requestedBytes="+requestedBytes+","+
+            "highWaterMark="+highWaterMark+","+
+            "regionCount="+regionCount+","+
+            "fragmentation="+fragmentation+"]";
+    }
+}
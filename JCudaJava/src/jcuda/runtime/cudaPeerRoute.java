@@ -0,0 +1,80 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+package jcuda.runtime;
+
+/**
+ * The routes that a copy between two devices may take, when the
+ * peer router is enabled.<br />
+ * <br />
+ * <u>Note:</u> This is not a CUDA type, but a JCuda-specific extension.
+ *
+ * @see jcuda.runtime.JCuda#cudaPeerRouterEnable
+ * @see jcuda.runtime.JCuda#cudaPeerRouterGetRoute
+ */
+public class cudaPeerRoute
+{
+    /**
+     * The devices are the same, and the copy is passed to the driver
+     */
+    public static final int cudaPeerRouteLocal = 0;
+
+    /**
+     * The devices may access each other, and peer access is enabled
+     */
+    public static final int cudaPeerRouteDirect = 1;
+
+    /**
+     * The copy is staged through page-locked host memory
+     */
+    public static final int cudaPeerRouteStaged = 2;
+
+    /**
+     * Returns the String identifying the given cudaPeerRoute
+     *
+     * @param n The cudaPeerRoute
+     * @return The String identifying the given cudaPeerRoute
+     */
+    public static String stringFor(int n)
+    {
+        switch (n)
+        {
+            case cudaPeerRouteLocal: return "cudaPeerRouteLocal";
+            case cudaPeerRouteDirect: return "cudaPeerRouteDirect";
+            case cudaPeerRouteStaged: return "cudaPeerRouteStaged";
+        }
+        return "INVALID cudaPeerRoute: "+n;
+    }
+
+    /**
+     * Private constructor to prevent instantiation.
+     */
+    private cudaPeerRoute()
+    {
+    }
+
+}
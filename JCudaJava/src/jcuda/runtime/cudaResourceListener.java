@@ -0,0 +1,55 @@
+/*
+ * JCuda - Java bindings for NVIDIA CUDA driver and runtime API
+ *
+ * Copyright (c) 2009-2012 Marco Hutter - http://www.jcuda.org
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jcuda.runtime;
+
+/**
+ * Interface for listeners that are informed before resources of the
+ * runtime API are released, so that libraries which keep their own
+ * state for devices or streams, like JCublas2, can release it.<br />
+ * <br />
+ * <u>Note:</u> This is not a CUDA type, but a JCuda-specific extension.
+ *
+ * @see JCuda#addResourceListener(cudaResourceListener)
+ */
+public interface cudaResourceListener
+{
+    /**
+     * The function that will be called before the current device is
+     * reset with {@link JCuda#cudaDeviceReset} or
+     * {@link JCuda#cudaThreadExit}, by the calling thread
+     */
+    void deviceResetting();
+
+    /**
+     * The function that will be called before the given stream is
+     * destroyed with {@link JCuda#cudaStreamDestroy}, by the calling
+     * thread
+     *
+     * @param stream The stream
+     */
+    void streamDestroying(cudaStream_t stream);
+}
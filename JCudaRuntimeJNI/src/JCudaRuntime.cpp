@@ -29,6 +29,16 @@
 
 #include <cstring>
 #include "JCudaRuntime_common.hpp"
+#include "AllocationRegistry.hpp"
+#include "BounceRing.hpp"
+#include "CompletionService.hpp"
+#include "CopyPlanner.hpp"
+#include "HostArena.hpp"
+#include "DeviceSnapshot.hpp"
+#include "NumaPlacement.hpp"
+#include "PeerRouter.hpp"
+#include "PitchPacker.hpp"
+#include "RegistrationCache.hpp"
 
 jfieldID cudaDeviceProp_name; // byte[256]
 jfieldID cudaDeviceProp_totalGlobalMem; // size_t
@@ -191,6 +201,1092 @@ jfieldID cudaTextureDesc_mipmapLevelBias; // float
 jfieldID cudaTextureDesc_minMipmapLevelClamp; // float
 jfieldID cudaTextureDesc_maxMipmapLevelClamp; // float
 
+jfieldID cudaHostArenaStatistics_reservedBytes; // long
+jfieldID cudaHostArenaStatistics_usedBytes; // long
+jfieldID cudaHostArenaStatistics_requestedBytes; // long
+jfieldID cudaHostArenaStatistics_highWaterMark; // long
+jfieldID cudaHostArenaStatistics_regionCount; // long
+jfieldID cudaHostArenaStatistics_fragmentation; // float
+
+jfieldID cudaDeviceSnapshot_buffer; // ByteBuffer
+
+jmethodID EventFuture_complete; // (I)V
+
+// The VM, for attaching native worker threads
+JavaVM *globalJvm = NULL;
+
+
+/**
+ * The registry of all allocations that are made through the
+ * runtime API bindings
+ */
+AllocationRegistry allocationRegistry;
+
+/**
+ * Records the given allocation in the allocationRegistry, for the
+ * device that is current for the calling thread. The device is only
+ * queried if the registry is active.
+ */
+void registerAllocation(void *pointer, size_t size, int kind)
+{
+    if (!allocationRegistry.isActive())
+    {
+        return;
+    }
+    int device = -1;
+    if (cudaGetDevice(&device) != cudaSuccess)
+    {
+        device = -1;
+    }
+    allocationRegistry.add(pointer, size, kind, device, NULL);
+}
+
+/**
+ * Removes all allocations of the current device from the
+ * allocationRegistry
+ */
+void unregisterDeviceAllocations()
+{
+    if (!allocationRegistry.isActive())
+    {
+        return;
+    }
+    int device = -1;
+    if (cudaGetDevice(&device) == cudaSuccess)
+    {
+        allocationRegistry.removeDevice(device);
+    }
+}
+
+/**
+ * Looks up the given pointer in the allocationRegistry, activating
+ * the registry if necessary. If it is not found, but the given Java
+ * pointer object refers to a buffer or an array, then the kind is
+ * set to ALLOCATION_KIND_PAGEABLE.
+ */
+void lookupAllocation(JNIEnv *env, jobject pointerObject, void *pointer, AllocationInfo *info)
+{
+    allocationRegistry.activate();
+    if (!allocationRegistry.lookup(pointer, info))
+    {
+        if (isPointerBackedByBuffer(env, pointerObject))
+        {
+            info->kind = ALLOCATION_KIND_PAGEABLE;
+        }
+    }
+}
+
+/**
+ * Makes the given device current for the lifetime of this object,
+ * and restores the previous device afterwards
+ */
+class DeviceScope
+{
+    public:
+        DeviceScope(int device)
+        {
+            changed = false;
+            result = cudaGetDevice(&previous);
+            if (result == cudaSuccess && previous != device)
+            {
+                result = cudaSetDevice(device);
+                changed = (result == cudaSuccess);
+            }
+        }
+        ~DeviceScope()
+        {
+            if (changed)
+            {
+                cudaSetDevice(previous);
+            }
+        }
+
+        int getResult()
+        {
+            return result;
+        }
+
+    private:
+        int previous;
+        int result;
+        bool changed;
+
+        DeviceScope(const DeviceScope&);
+        DeviceScope& operator=(const DeviceScope&);
+};
+
+/**
+ * Obtains the number of devices
+ */
+static int getPeerDeviceCount(int *count)
+{
+    return cudaGetDeviceCount(count);
+}
+
+/**
+ * Obtains whether the given device can access the memory of the given
+ * peer device
+ */
+static int getPeerCanAccess(int *canAccess, int device, int peerDevice)
+{
+    return cudaDeviceCanAccessPeer(canAccess, device, peerDevice);
+}
+
+/**
+ * Obtains the PCI bus ID of the given device
+ */
+static int getPeerPCIBusId(char *busId, int length, int device)
+{
+    return cudaDeviceGetPCIBusId(busId, length, device);
+}
+
+/**
+ * Enables the access of the device of the given endpoint to the memory
+ * of the device of the given peer. Access that is already enabled is
+ * not an error.
+ */
+static int enablePeerDeviceAccess(PeerEndpoint endpoint, PeerEndpoint peer)
+{
+    DeviceScope scope(endpoint.device);
+    if (scope.getResult() != cudaSuccess) return scope.getResult();
+    int result = cudaDeviceEnablePeerAccess(peer.device, 0);
+    if (result == cudaErrorPeerAccessAlreadyEnabled)
+    {
+        // Clear the error, which would otherwise be returned by
+        // the next call to cudaGetLastError
+        cudaGetLastError();
+        return cudaSuccess;
+    }
+    return result;
+}
+
+/**
+ * Copies the given number of bytes directly between the memory of the
+ * given endpoints, asynchronously in the given stream if requested
+ */
+static int copyPeerDirect(void *dst, PeerEndpoint dstEndpoint, const void *src, PeerEndpoint srcEndpoint, size_t bytes, void *stream, bool async)
+{
+    if (async)
+    {
+        return cudaMemcpyPeerAsync(dst, dstEndpoint.device, src, srcEndpoint.device, bytes, (cudaStream_t)stream);
+    }
+    return cudaMemcpyPeer(dst, dstEndpoint.device, src, srcEndpoint.device, bytes);
+}
+
+/**
+ * Allocates portable page-locked host memory, for copies that are
+ * staged through the host
+ */
+static int allocPeerHost(PeerEndpoint endpoint, void **pointer, size_t size)
+{
+    DeviceScope scope(endpoint.device);
+    if (scope.getResult() != cudaSuccess) return scope.getResult();
+    return cudaHostAlloc(pointer, size, cudaHostAllocPortable);
+}
+
+/**
+ * Frees host memory that was allocated with allocPeerHost
+ */
+static int freePeerHost(PeerEndpoint /*endpoint*/, void *pointer)
+{
+    return cudaFreeHost(pointer);
+}
+
+/**
+ * Creates a stream for the given endpoint
+ */
+static int createPeerStream(PeerEndpoint endpoint, void **stream)
+{
+    DeviceScope scope(endpoint.device);
+    if (scope.getResult() != cudaSuccess) return scope.getResult();
+    return cudaStreamCreate((cudaStream_t*)stream);
+}
+
+/**
+ * Destroys the given stream of the given endpoint
+ */
+static int destroyPeerStream(PeerEndpoint endpoint, void *stream)
+{
+    DeviceScope scope(endpoint.device);
+    if (scope.getResult() != cudaSuccess) return scope.getResult();
+    return cudaStreamDestroy((cudaStream_t)stream);
+}
+
+/**
+ * Waits until all work in the given stream of the given endpoint is
+ * complete
+ */
+static int synchronizePeerStream(PeerEndpoint endpoint, void *stream)
+{
+    DeviceScope scope(endpoint.device);
+    if (scope.getResult() != cudaSuccess) return scope.getResult();
+    return cudaStreamSynchronize((cudaStream_t)stream);
+}
+
+/**
+ * Waits until the given event has been reached
+ */
+static int synchronizePeerEvent(PeerEndpoint /*endpoint*/, void *event)
+{
+    return cudaEventSynchronize((cudaEvent_t)event);
+}
+
+/**
+ * Creates an event without timing for the given endpoint
+ */
+static int createPeerEvent(PeerEndpoint endpoint, void **event)
+{
+    DeviceScope scope(endpoint.device);
+    if (scope.getResult() != cudaSuccess) return scope.getResult();
+    return cudaEventCreateWithFlags((cudaEvent_t*)event, cudaEventDisableTiming);
+}
+
+/**
+ * Destroys the given event of the given endpoint
+ */
+static int destroyPeerEvent(PeerEndpoint endpoint, void *event)
+{
+    DeviceScope scope(endpoint.device);
+    if (scope.getResult() != cudaSuccess) return scope.getResult();
+    return cudaEventDestroy((cudaEvent_t)event);
+}
+
+/**
+ * Records the given event in the given stream of the given endpoint
+ */
+static int recordPeerEvent(PeerEndpoint endpoint, void *event, void *stream)
+{
+    DeviceScope scope(endpoint.device);
+    if (scope.getResult() != cudaSuccess) return scope.getResult();
+    return cudaEventRecord((cudaEvent_t)event, (cudaStream_t)stream);
+}
+
+/**
+ * Lets the given stream of the given endpoint wait for the given event
+ */
+static int peerStreamWaitEvent(PeerEndpoint endpoint, void *stream, void *event)
+{
+    DeviceScope scope(endpoint.device);
+    if (scope.getResult() != cudaSuccess) return scope.getResult();
+    return cudaStreamWaitEvent((cudaStream_t)stream, (cudaEvent_t)event, 0);
+}
+
+/**
+ * Copies the given number of bytes from device memory of the given
+ * endpoint into page-locked host memory, asynchronously in the given
+ * stream
+ */
+static int copyPeerDtoHAsync(PeerEndpoint endpoint, void *dst, const void *src, size_t bytes, void *stream)
+{
+    DeviceScope scope(endpoint.device);
+    if (scope.getResult() != cudaSuccess) return scope.getResult();
+    return cudaMemcpyAsync(dst, src, bytes, cudaMemcpyDeviceToHost, (cudaStream_t)stream);
+}
+
+/**
+ * Copies the given number of bytes from page-locked host memory into
+ * device memory of the given endpoint, asynchronously in the given
+ * stream
+ */
+static int copyPeerHtoDAsync(PeerEndpoint endpoint, void *dst, const void *src, size_t bytes, void *stream)
+{
+    DeviceScope scope(endpoint.device);
+    if (scope.getResult() != cudaSuccess) return scope.getResult();
+    return cudaMemcpyAsync(dst, src, bytes, cudaMemcpyHostToDevice, (cudaStream_t)stream);
+}
+
+/**
+ * The functions that are used by the peer router. The functions that
+ * receive an endpoint make the device of this endpoint current.
+ */
+PeerRouterFunctions peerRouterFunctions =
+{
+    &getPeerDeviceCount,
+    &getPeerCanAccess,
+    &getPeerPCIBusId,
+    &enablePeerDeviceAccess,
+    &copyPeerDirect,
+    &allocPeerHost,
+    &freePeerHost,
+    &createPeerStream,
+    &destroyPeerStream,
+    &synchronizePeerStream,
+    &synchronizePeerEvent,
+    &createPeerEvent,
+    &destroyPeerEvent,
+    &recordPeerEvent,
+    &peerStreamWaitEvent,
+    &copyPeerDtoHAsync,
+    &copyPeerHtoDAsync
+};
+PeerRouter peerRouter(peerRouterFunctions);
+
+/**
+ * Returns the endpoint of a peer copy for the given device
+ */
+static PeerEndpoint getPeerEndpoint(int device)
+{
+    PeerEndpoint endpoint;
+    endpoint.device = device;
+    endpoint.context = NULL;
+    return endpoint;
+}
+
+/**
+ * Releases the peer routing resources of the current device
+ */
+void removeDevicePeerEndpoint()
+{
+    int device = -1;
+    if (cudaGetDevice(&device) == cudaSuccess)
+    {
+        peerRouter.removeEndpoint(getPeerEndpoint(device));
+    }
+}
+
+
+/**
+ * Registers the given host memory, and obtains the device and the
+ * owner of the registration
+ */
+static int registerCachedHost(void *pointer, size_t size, int *device, void **owner)
+{
+    int result = cudaHostRegister(pointer, size, cudaHostRegisterPortable);
+    if (result == cudaSuccess)
+    {
+        registerAllocation(pointer, size, ALLOCATION_KIND_HOST);
+        if (cudaGetDevice(device) != cudaSuccess)
+        {
+            *device = -1;
+        }
+        *owner = NULL;
+    }
+    return result;
+}
+
+/**
+ * Unregisters host memory that was registered with registerCachedHost
+ */
+static int unregisterCachedHost(void *pointer)
+{
+    allocationRegistry.remove(pointer);
+    return cudaHostUnregister(pointer);
+}
+
+/**
+ * Obtains the device and the owner of the events of the calling
+ * thread, which is the current device, and no owner
+ */
+static int getRegistrationOwner(int *device, void **owner)
+{
+    *owner = NULL;
+    return cudaGetDevice(device);
+}
+
+/**
+ * Creates an event without timing
+ */
+static int createRegistrationEvent(void **event)
+{
+    return cudaEventCreateWithFlags((cudaEvent_t*)event, cudaEventDisableTiming);
+}
+
+/**
+ * Destroys the given event
+ */
+static int destroyRegistrationEvent(void *event)
+{
+    return cudaEventDestroy((cudaEvent_t)event);
+}
+
+/**
+ * Records the given event in the given stream
+ */
+static int recordRegistrationEvent(void *event, void *stream)
+{
+    return cudaEventRecord((cudaEvent_t)event, (cudaStream_t)stream);
+}
+
+/**
+ * Queries whether the given event has been reached
+ */
+static int queryRegistrationEvent(void *event)
+{
+    return cudaEventQuery((cudaEvent_t)event);
+}
+
+/**
+ * Waits until the given event has been reached
+ */
+static int synchronizeRegistrationEvent(void *event)
+{
+    return cudaEventSynchronize((cudaEvent_t)event);
+}
+
+/**
+ * The functions for the registrationCache. The memory of the buffers
+ * is registered as portable memory, but the registration belongs to
+ * the device that is current when it is made.
+ */
+RegistrationCacheFunctions registrationCacheFunctions =
+{
+    &registerCachedHost,
+    &unregisterCachedHost,
+    &getRegistrationOwner,
+    &createRegistrationEvent,
+    &destroyRegistrationEvent,
+    &recordRegistrationEvent,
+    &queryRegistrationEvent,
+    &synchronizeRegistrationEvent
+};
+RegistrationCache registrationCache(registrationCacheFunctions, cudaErrorHostMemoryAlreadyRegistered, cudaErrorNotReady);
+
+/**
+ * Removes the buffers whose registration belongs to the current
+ * device from the registrationCache
+ */
+void removeDeviceRegistrations(JNIEnv *env)
+{
+    int device = -1;
+    if (cudaGetDevice(&device) == cudaSuccess)
+    {
+        registrationCache.removeDevice(env, device);
+    }
+}
+
+
+/**
+ * Obtains the current device
+ */
+static int getNumaCurrentDevice(int *device)
+{
+    return cudaGetDevice(device);
+}
+
+/**
+ * Registers the given host memory with the given flags
+ */
+static int registerNumaHost(void *pointer, size_t size, unsigned int flags)
+{
+    return cudaHostRegister(pointer, size, flags);
+}
+
+/**
+ * Unregisters host memory that was registered with registerNumaHost
+ */
+static int unregisterNumaHost(void *pointer)
+{
+    return cudaHostUnregister(pointer);
+}
+
+/**
+ * The functions for the numaPlacement. The cudaHostAlloc flags for
+ * portable and mapped memory have the same values as the respective
+ * cudaHostRegister flags.
+ */
+NumaPlacementFunctions numaPlacementFunctions =
+{
+    &getNumaCurrentDevice,
+    &getPeerPCIBusId,
+    &registerNumaHost,
+    &unregisterNumaHost
+};
+NumaPlacement numaPlacement(numaPlacementFunctions);
+
+
+/**
+ * Obtains the current device
+ */
+static int getCopyCurrentDevice(int *device)
+{
+    return cudaGetDevice(device);
+}
+
+/**
+ * Copies the given number of bytes between host and device memory in
+ * the given direction, asynchronously in the given stream if requested
+ */
+static int copyPlanned(void *dst, const void *src, size_t bytes, bool toDevice, void *stream, bool async)
+{
+    cudaMemcpyKind kind = toDevice ? cudaMemcpyHostToDevice : cudaMemcpyDeviceToHost;
+    if (async)
+    {
+        return cudaMemcpyAsync(dst, src, bytes, kind, (cudaStream_t)stream);
+    }
+    return cudaMemcpy(dst, src, bytes, kind);
+}
+
+/**
+ * Allocates portable page-locked memory for a staging buffer
+ */
+static int allocCopyHost(void **pointer, size_t size)
+{
+    return cudaHostAlloc(pointer, size, cudaHostAllocPortable);
+}
+
+/**
+ * Frees a staging buffer that was allocated with allocCopyHost
+ */
+static int freeCopyHost(void *pointer)
+{
+    return cudaFreeHost(pointer);
+}
+
+/**
+ * Creates a stream for staged copies
+ */
+static int createCopyStream(void **stream)
+{
+    return cudaStreamCreate((cudaStream_t*)stream);
+}
+
+/**
+ * Destroys a stream that was created with createCopyStream
+ */
+static int destroyCopyStream(void *stream)
+{
+    return cudaStreamDestroy((cudaStream_t)stream);
+}
+
+/**
+ * Creates an event without timing
+ */
+static int createCopyEvent(void **event)
+{
+    return cudaEventCreateWithFlags((cudaEvent_t*)event, cudaEventDisableTiming);
+}
+
+/**
+ * Destroys the given event
+ */
+static int destroyCopyEvent(void *event)
+{
+    return cudaEventDestroy((cudaEvent_t)event);
+}
+
+/**
+ * Records the given event in the given stream
+ */
+static int recordCopyEvent(void *event, void *stream)
+{
+    return cudaEventRecord((cudaEvent_t)event, (cudaStream_t)stream);
+}
+
+/**
+ * Waits until the given event has been reached
+ */
+static int synchronizeCopyEvent(void *event)
+{
+    return cudaEventSynchronize((cudaEvent_t)event);
+}
+
+/**
+ * Lets the given stream wait for the given event
+ */
+static int copyStreamWaitEvent(void *stream, void *event)
+{
+    return cudaStreamWaitEvent((cudaStream_t)stream, (cudaEvent_t)event, 0);
+}
+
+/**
+ * The functions for the copyPlanner. The staging buffers are
+ * allocated as portable memory.
+ */
+CopyPlannerFunctions copyPlannerFunctions =
+{
+    &getCopyCurrentDevice,
+    &copyPlanned,
+    &allocCopyHost,
+    &freeCopyHost,
+    &createCopyStream,
+    &destroyCopyStream,
+    &createCopyEvent,
+    &destroyCopyEvent,
+    &recordCopyEvent,
+    &synchronizeCopyEvent,
+    &copyStreamWaitEvent
+};
+CopyPlanner copyPlanner(copyPlannerFunctions);
+
+/**
+ * Releases the staging buffers of the current device
+ */
+void removeDeviceCopyStaging()
+{
+    int device = -1;
+    if (cudaGetDevice(&device) == cudaSuccess)
+    {
+        copyPlanner.removeDevice(device);
+    }
+}
+
+/**
+ * Returns the COPY_MEMORY kind of the host memory that the given Java
+ * Pointer object refers to, with the given PointerData. Memory that
+ * was page-locked through these bindings is PINNED, other buffers
+ * are PAGEABLE or ARRAY, and arrays of pointers are OTHER.
+ */
+static int classifyHostMemory(JNIEnv *env, jobject pointerObject, PointerData *pointerData)
+{
+    if (!env->IsInstanceOf(pointerObject, Pointer_class) ||
+        env->GetObjectField(pointerObject, Pointer_pointers) != NULL)
+    {
+        return COPY_MEMORY_OTHER;
+    }
+    jobject buffer = env->GetObjectField(pointerObject, Pointer_buffer);
+    if (buffer != NULL && !env->CallBooleanMethod(buffer, Buffer_isDirect))
+    {
+        return COPY_MEMORY_ARRAY;
+    }
+    if (env->ExceptionCheck())
+    {
+        return COPY_MEMORY_OTHER;
+    }
+    AllocationInfo info;
+    if (allocationRegistry.lookup(pointerData->getPointer(env), &info))
+    {
+        if (info.kind == ALLOCATION_KIND_HOST)
+        {
+            return COPY_MEMORY_PINNED;
+        }
+        if (info.kind == ALLOCATION_KIND_DEVICE)
+        {
+            return COPY_MEMORY_DEVICE;
+        }
+    }
+    return buffer != NULL ? COPY_MEMORY_PAGEABLE : COPY_MEMORY_OTHER;
+}
+
+/**
+ * Executes the given copy with the copyPlanner, if it chooses to stage
+ * the copy. Returns whether the copy was handled, and stores the error
+ * code in the given result. If this returns false, the copy has to be
+ * executed directly. While the copyPlanner is enabled, the strategy of
+ * direct copies is recorded.
+ */
+static bool executePlannedCopy(JNIEnv *env, jobject dst, PointerData *dstPointerData, jobject src, PointerData *srcPointerData, size_t count, int kind, cudaStream_t stream, bool async, int *result)
+{
+    if (kind != cudaMemcpyHostToDevice && kind != cudaMemcpyDeviceToHost)
+    {
+        return false;
+    }
+    if (!copyPlanner.isEnabled())
+    {
+        return false;
+    }
+    int strategy = COPY_STRATEGY_DIRECT;
+    if (kind == cudaMemcpyHostToDevice)
+    {
+        strategy = copyPlanner.plan(COPY_MEMORY_DEVICE, classifyHostMemory(env, src, srcPointerData), count);
+    }
+    else
+    {
+        strategy = copyPlanner.plan(classifyHostMemory(env, dst, dstPointerData), COPY_MEMORY_DEVICE, count);
+    }
+    if (strategy == COPY_STRATEGY_DIRECT)
+    {
+        copyPlanner.record(COPY_STRATEGY_DIRECT, count);
+        return false;
+    }
+    Logger::log(LOG_TRACE, "Copying %ld bytes with strategy %d\n", (long)count, strategy);
+    bool accessible = false;
+    if (kind == cudaMemcpyHostToDevice)
+    {
+        accessible = copyPlanner.copyHtoD(env, dstPointerData->getPointer(env), srcPointerData, count, strategy, stream, async, result);
+    }
+    else
+    {
+        // Copies to the host are complete when this call returns,
+        // also when they are asynchronous
+        accessible = copyPlanner.copyDtoH(env, dstPointerData, srcPointerData->getPointer(env), count, strategy, stream, result);
+    }
+    if (!accessible)
+    {
+        *result = JCUDA_INTERNAL_ERROR;
+    }
+    return true;
+}
+
+
+/**
+ * Obtains the owner of the slots of the calling thread, which is the
+ * current device, offset by one, so that it is never NULL
+ */
+static int getBounceOwner(void **owner)
+{
+    int device = -1;
+    int result = cudaGetDevice(&device);
+    if (result == cudaSuccess)
+    {
+        *owner = (void*)((size_t)device + 1);
+    }
+    return result;
+}
+
+/**
+ * Allocates portable page-locked memory for a slot
+ */
+static int allocBounceHost(void **pointer, size_t size)
+{
+    return cudaHostAlloc(pointer, size, cudaHostAllocPortable);
+}
+
+/**
+ * Frees the memory of a slot
+ */
+static int freeBounceHost(void *pointer)
+{
+    return cudaFreeHost(pointer);
+}
+
+/**
+ * Creates an event without timing
+ */
+static int createBounceEvent(void **event)
+{
+    return cudaEventCreateWithFlags((cudaEvent_t*)event, cudaEventDisableTiming);
+}
+
+/**
+ * Destroys the given event
+ */
+static int destroyBounceEvent(void *event)
+{
+    return cudaEventDestroy((cudaEvent_t)event);
+}
+
+/**
+ * Records the given event in the given stream
+ */
+static int recordBounceEvent(void *event, void *stream)
+{
+    return cudaEventRecord((cudaEvent_t)event, (cudaStream_t)stream);
+}
+
+/**
+ * Queries whether the given event has been reached
+ */
+static int queryBounceEvent(void *event)
+{
+    return cudaEventQuery((cudaEvent_t)event);
+}
+
+/**
+ * Waits until the given event has been reached
+ */
+static int synchronizeBounceEvent(void *event)
+{
+    return cudaEventSynchronize((cudaEvent_t)event);
+}
+
+/**
+ * The functions for the bounceRing. The owner of the streams is the
+ * current device, offset by one, so that it is never NULL.
+ */
+BounceRingFunctions bounceRingFunctions =
+{
+    &getBounceOwner,
+    &allocBounceHost,
+    &freeBounceHost,
+    &createBounceEvent,
+    &destroyBounceEvent,
+    &recordBounceEvent,
+    &queryBounceEvent,
+    &synchronizeBounceEvent
+};
+BounceRing bounceRing(bounceRingFunctions, cudaErrorNotReady);
+
+/**
+ * Completes the pending copies of the current device in the
+ * bounceRing, and releases its slots
+ */
+void removeDeviceBounceSlots(JNIEnv *env)
+{
+    void *owner = NULL;
+    if (getBounceOwner(&owner) == cudaSuccess)
+    {
+        bounceRing.removeOwner(env, owner);
+    }
+}
+
+/**
+ * Executes the remainder of a bounced copy, starting at the given offset,
+ * directly between the Java array and device memory. A copy into the
+ * array is completed before this returns, since the array may not be
+ * accessed after the call returned.
+ */
+static int executeRemainingCopy(JNIEnv *env, jobject host, char *device, size_t offset, size_t count, bool toDevice, cudaStream_t stream)
+{
+    PointerData *hostPointerData = initPointerData(env, host);
+    if (hostPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    char *hostMemory = (char*)hostPointerData->getPointer(env) + offset;
+    int result = cudaSuccess;
+    if (toDevice)
+    {
+        result = cudaMemcpyAsync(device + offset, hostMemory, count - offset, cudaMemcpyHostToDevice, stream);
+        if (!releasePointerData(env, hostPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    }
+    else
+    {
+        result = cudaMemcpyAsync(hostMemory, device + offset, count - offset, cudaMemcpyDeviceToHost, stream);
+        if (result == cudaSuccess)
+        {
+            result = cudaStreamSynchronize(stream);
+        }
+        if (!releasePointerData(env, hostPointerData)) return JCUDA_INTERNAL_ERROR;
+    }
+    return result;
+}
+
+/**
+ * Executes the given asynchronous copy through the slots of the
+ * bounceRing, if the host memory is a Java array. Copies that are larger
+ * than one slot are split into chunks of the slot size. If no slot is
+ * available for a later chunk, then the remainder of the copy is
+ * executed directly. Returns whether the copy was handled, and stores
+ * the error code in the given result. If this returns false, the copy
+ * has to be executed directly.
+ */
+static bool executeBouncedCopy(JNIEnv *env, jobject dst, jobject src, size_t count, int kind, cudaStream_t stream, int *result)
+{
+    if (kind != cudaMemcpyHostToDevice && kind != cudaMemcpyDeviceToHost)
+    {
+        return false;
+    }
+    bool toDevice = kind == cudaMemcpyHostToDevice;
+    jobject host = toDevice ? src : dst;
+    char *device = (char*)getPointer(env, toDevice ? dst : src);
+    size_t slotSize = bounceRing.getSlotSize();
+    size_t offset = 0;
+    while (offset < count)
+    {
+        size_t chunk = count - offset;
+        if (chunk > slotSize)
+        {
+            chunk = slotSize;
+        }
+        BounceSlot *slot = NULL;
+        if (!bounceRing.acquire(env, host, offset, stream, chunk, toDevice, &slot))
+        {
+            *result = JCUDA_INTERNAL_ERROR;
+            return true;
+        }
+        if (slot == NULL)
+        {
+            break;
+        }
+        int copyResult = cudaSuccess;
+        if (toDevice)
+        {
+            copyResult = cudaMemcpyAsync(device + offset, slot->buffer, chunk, cudaMemcpyHostToDevice, stream);
+        }
+        else
+        {
+            copyResult = cudaMemcpyAsync(slot->buffer, device + offset, chunk, cudaMemcpyDeviceToHost, stream);
+        }
+        *result = bounceRing.commit(env, slot, stream, copyResult);
+        if (*result != cudaSuccess)
+        {
+            return true;
+        }
+        offset += chunk;
+    }
+    if (offset == 0)
+    {
+        return false;
+    }
+    if (offset < count)
+    {
+        *result = executeRemainingCopy(env, host, device, offset, count, toDevice, stream);
+    }
+    return true;
+}
+
+/**
+ * The packer for 2D and 3D copies between Java arrays and device
+ * memory. Its staging buffers are kept for each device, like the
+ * slots of the bounceRing.
+ */
+PitchPackerFunctions pitchPackerFunctions =
+{
+    &getBounceOwner,
+    &allocBounceHost,
+    &freeBounceHost
+};
+PitchPacker pitchPacker(pitchPackerFunctions);
+
+/**
+ * Releases the staging buffers of the current device in the pitchPacker
+ */
+void removeDevicePitchStaging()
+{
+    void *owner = NULL;
+    if (getBounceOwner(&owner) == cudaSuccess)
+    {
+        pitchPacker.removeOwner(owner);
+    }
+}
+
+/**
+ * Executes the given 2D copy through a staging buffer of the
+ * pitchPacker, if it is a copy between a Java array and device
+ * memory. The rows of the array are only accessed while they are
+ * packed into or unpacked from the staging buffer, and the staging
+ * buffer is transferred with a single copy. Returns whether the copy
+ * was handled, and stores the error code in the given result. If this
+ * returns false, the copy has to be executed directly.
+ */
+static bool executePackedCopy2D(JNIEnv *env, jobject dst, PointerData *dstPointerData, size_t dpitch, jobject src, PointerData *srcPointerData, size_t spitch, size_t width, size_t height, int kind, int *result)
+{
+    if (kind != cudaMemcpyHostToDevice && kind != cudaMemcpyDeviceToHost)
+    {
+        return false;
+    }
+    bool toDevice = kind == cudaMemcpyHostToDevice;
+    size_t bytes = width * height;
+    if ((toDevice ? spitch : dpitch) < width)
+    {
+        return false;
+    }
+    if (!isPointerBackedByArray(env, toDevice ? src : dst) || !pitchPacker.accepts(bytes))
+    {
+        return false;
+    }
+    PitchStaging staging;
+    if (pitchPacker.acquire(bytes, &staging) != cudaSuccess)
+    {
+        return false;
+    }
+    Logger::log(LOG_TRACE, "Packing 2D copy of %ld bytes\n", (long)bytes);
+
+    if (toDevice)
+    {
+        void *srcPointer = srcPointerData->getPointer(env);
+        if (srcPointer == NULL)
+        {
+            pitchPacker.release(&staging);
+            *result = JCUDA_INTERNAL_ERROR;
+            return true;
+        }
+        pitchPacker.pack(staging.buffer, srcPointer, spitch, height, width, height, 1);
+        srcPointerData->releasePointer(env, JNI_ABORT);
+        *result = cudaMemcpy2D(dstPointerData->getPointer(env), dpitch, staging.buffer, width, width, height, cudaMemcpyHostToDevice);
+    }
+    else
+    {
+        *result = cudaMemcpy2D(staging.buffer, width, srcPointerData->getPointer(env), spitch, width, height, cudaMemcpyDeviceToHost);
+        if (*result == cudaSuccess)
+        {
+            void *dstPointer = dstPointerData->getPointer(env);
+            if (dstPointer == NULL)
+            {
+                *result = JCUDA_INTERNAL_ERROR;
+            }
+            else
+            {
+                pitchPacker.unpack(dstPointer, dpitch, height, staging.buffer, width, height, 1);
+            }
+        }
+    }
+    pitchPacker.release(&staging);
+    return true;
+}
+
+/**
+ * Executes the given 3D copy through a staging buffer of the
+ * pitchPacker, if it is a copy between a Java array and linear device
+ * memory. Unlike direct 3D copies, which only use the native pointer
+ * of the host memory, this accesses the Java array through its
+ * PointerData. See executePackedCopy2D.
+ */
+static bool executePackedCopy3D(JNIEnv *env, jobject p, const cudaMemcpy3DParms *nativeP, int *result)
+{
+    if (nativeP->kind != cudaMemcpyHostToDevice && nativeP->kind != cudaMemcpyDeviceToHost)
+    {
+        return false;
+    }
+    // If an array is involved, then the extent is given in elements
+    if (nativeP->srcArray != NULL || nativeP->dstArray != NULL)
+    {
+        return false;
+    }
+    bool toDevice = nativeP->kind == cudaMemcpyHostToDevice;
+    cudaExtent extent = nativeP->extent;
+    size_t bytes = extent.width * extent.height * extent.depth;
+    jobject hostPitchedPtr = env->GetObjectField(p, toDevice ? cudaMemcpy3DParms_srcPtr : cudaMemcpy3DParms_dstPtr);
+    jobject host = env->GetObjectField(hostPitchedPtr, cudaPitchedPtr_ptr);
+    if (!isPointerBackedByArray(env, host) || !pitchPacker.accepts(bytes))
+    {
+        return false;
+    }
+    cudaPitchedPtr hostPtr = toDevice ? nativeP->srcPtr : nativeP->dstPtr;
+    cudaPos hostPos = toDevice ? nativeP->srcPos : nativeP->dstPos;
+    if (hostPtr.pitch < extent.width || hostPtr.ysize < extent.height)
+    {
+        return false;
+    }
+    PitchStaging staging;
+    if (pitchPacker.acquire(bytes, &staging) != cudaSuccess)
+    {
+        return false;
+    }
+    PointerData *hostPointerData = initPointerData(env, host);
+    if (hostPointerData == NULL)
+    {
+        pitchPacker.release(&staging);
+        *result = JCUDA_INTERNAL_ERROR;
+        return true;
+    }
+    Logger::log(LOG_TRACE, "Packing 3D copy of %ld bytes\n", (long)bytes);
+
+    size_t offset = (hostPos.z * hostPtr.ysize + hostPos.y) * hostPtr.pitch + hostPos.x;
+    cudaMemcpy3DParms staged = *nativeP;
+    cudaPitchedPtr stagingPtr = make_cudaPitchedPtr(staging.buffer, extent.width, extent.width, extent.height);
+    if (toDevice)
+    {
+        char *srcPointer = (char*)hostPointerData->getPointer(env);
+        if (srcPointer == NULL)
+        {
+            releasePointerData(env, hostPointerData, JNI_ABORT);
+            pitchPacker.release(&staging);
+            *result = JCUDA_INTERNAL_ERROR;
+            return true;
+        }
+        pitchPacker.pack(staging.buffer, srcPointer + offset, hostPtr.pitch, hostPtr.ysize, extent.width, extent.height, extent.depth);
+        hostPointerData->releasePointer(env, JNI_ABORT);
+        staged.srcPtr = stagingPtr;
+        staged.srcPos = make_cudaPos(0, 0, 0);
+        *result = cudaMemcpy3D(&staged);
+    }
+    else
+    {
+        staged.dstPtr = stagingPtr;
+        staged.dstPos = make_cudaPos(0, 0, 0);
+        *result = cudaMemcpy3D(&staged);
+        if (*result == cudaSuccess)
+        {
+            char *dstPointer = (char*)hostPointerData->getPointer(env);
+            if (dstPointer == NULL)
+            {
+                *result = JCUDA_INTERNAL_ERROR;
+            }
+            else
+            {
+                pitchPacker.unpack(dstPointer + offset, hostPtr.pitch, hostPtr.ysize, staging.buffer, extent.width, extent.height, extent.depth);
+            }
+        }
+    }
+    pitchPacker.release(&staging);
+    if (!releasePointerData(env, hostPointerData, toDevice ? JNI_ABORT : 0))
+    {
+        *result = JCUDA_INTERNAL_ERROR;
+    }
+    return true;
+}
+
 
 
 /**
@@ -423,6 +1519,25 @@ JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *jvm, void *reserved)
     if (!init(env, cls, cudaTextureDesc_minMipmapLevelClamp, "minMipmapLevelClamp", "F")) return JNI_ERR;
     if (!init(env, cls, cudaTextureDesc_maxMipmapLevelClamp, "maxMipmapLevelClamp", "F")) return JNI_ERR;
 
+    // Obtain the fieldIDs of the cudaHostArenaStatistics class
+    if (!init(env, cls, "jcuda/runtime/cudaHostArenaStatistics")) return JNI_ERR;
+    if (!init(env, cls, cudaHostArenaStatistics_reservedBytes,  "reservedBytes",  "J")) return JNI_ERR;
+    if (!init(env, cls, cudaHostArenaStatistics_usedBytes,      "usedBytes",      "J")) return JNI_ERR;
+    if (!init(env, cls, cudaHostArenaStatistics_requestedBytes, "requestedBytes", "J")) return JNI_ERR;
+    if (!init(env, cls, cudaHostArenaStatistics_highWaterMark,  "highWaterMark",  "J")) return JNI_ERR;
+    if (!init(env, cls, cudaHostArenaStatistics_regionCount,    "regionCount",    "J")) return JNI_ERR;
+    if (!init(env, cls, cudaHostArenaStatistics_fragmentation,  "fragmentation",  "F")) return JNI_ERR;
+
+    // Obtain the fieldID of the cudaDeviceSnapshot class
+    if (!init(env, cls, "jcuda/runtime/cudaDeviceSnapshot")) return JNI_ERR;
+    if (!init(env, cls, cudaDeviceSnapshot_buffer, "buffer", "Ljava/nio/ByteBuffer;")) return JNI_ERR;
+
+    // Obtain the method that completes an EventFuture
+    if (!init(env, cls, "jcuda/EventFuture")) return JNI_ERR;
+    if (!init(env, cls, EventFuture_complete, "complete", "(I)V")) return JNI_ERR;
+
+    globalJvm = jvm;
+
     return JNI_VERSION_1_4;
 }
 
@@ -1253,6 +2368,12 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaDeviceResetNative
 {
     Logger::log(LOG_TRACE, "Executing cudaDeviceReset\n");
 
+    unregisterDeviceAllocations();
+    removeDevicePeerEndpoint();
+    removeDeviceRegistrations(env);
+    removeDeviceCopyStaging();
+    removeDeviceBounceSlots(env);
+    removeDevicePitchStaging();
     int result = cudaDeviceReset();
     return result;
 }
@@ -1268,6 +2389,7 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaDeviceSynchronizeNative
     Logger::log(LOG_TRACE, "Executing cudaDeviceSynchronize\n");
 
     int result = cudaDeviceSynchronize();
+    bounceRing.completeReady(env);
     return result;
 }
 
@@ -1772,6 +2894,98 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaDeviceGetAttributeNative
 
 
 
+/**
+ * Obtains the number of devices
+ */
+static int getSnapshotDeviceCount(int *count)
+{
+    return cudaGetDeviceCount(count);
+}
+
+/**
+ * Obtains the value of the given attribute of the given device
+ */
+static int getSnapshotAttribute(int *value, int attribute, int device)
+{
+    return cudaDeviceGetAttribute(value, (cudaDeviceAttr)attribute, device);
+}
+
+/**
+ * Obtains the total memory of the given device, in bytes
+ */
+static int getSnapshotTotalMem(size_t *bytes, int device)
+{
+    cudaDeviceProp prop;
+    int result = cudaGetDeviceProperties(&prop, device);
+    if (result != cudaSuccess)
+    {
+        return result;
+    }
+    *bytes = prop.totalGlobalMem;
+    return cudaSuccess;
+}
+
+/**
+ * Obtains the name of the given device
+ */
+static int getSnapshotName(char *name, int length, int device)
+{
+    cudaDeviceProp prop;
+    int result = cudaGetDeviceProperties(&prop, device);
+    if (result != cudaSuccess)
+    {
+        return result;
+    }
+    strncpy(name, prop.name, length);
+    name[length-1] = 0;
+    return cudaSuccess;
+}
+
+/**
+ * The functions that are used for creating the device snapshot
+ */
+DeviceSnapshotFunctions deviceSnapshotFunctions =
+{
+    &getSnapshotDeviceCount,
+    &getSnapshotAttribute,
+    &getSnapshotTotalMem,
+    &getSnapshotName
+};
+DeviceSnapshot deviceSnapshot(deviceSnapshotFunctions);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaGetDeviceSnapshotNative
+ * Signature: (Ljcuda/runtime/cudaDeviceSnapshot;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaGetDeviceSnapshotNative
+  (JNIEnv *env, jclass cls, jobject snapshot)
+{
+    if (snapshot == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'snapshot' is null for cudaGetDeviceSnapshot");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cudaGetDeviceSnapshot\n");
+
+    void *data = NULL;
+    size_t size = 0;
+    int result = deviceSnapshot.get(&data, &size);
+    if (result != cudaSuccess)
+    {
+        return result;
+    }
+    jobject buffer = env->NewDirectByteBuffer(data, (jlong)size);
+    if (buffer == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    env->SetObjectField(snapshot, cudaDeviceSnapshot_buffer, buffer);
+    return cudaSuccess;
+}
+
+
+
 /*
  * Class:     jcuda_runtime_JCuda
  * Method:    cudaChooseDeviceNative
@@ -1827,9 +3041,14 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostAllocNative
     Logger::log(LOG_TRACE, "Executing cudaHostAlloc\n");
 
     void *nativePtr;
-    int result = cudaHostAlloc(&nativePtr, (size_t)size, (unsigned int)flags);
+    int result = cudaSuccess;
+    if (!numaPlacement.allocate(&nativePtr, (size_t)size, (unsigned int)flags, &result))
+    {
+        result = cudaHostAlloc(&nativePtr, (size_t)size, (unsigned int)flags);
+    }
     if (result == cudaSuccess)
     {
+        registerAllocation(nativePtr, (size_t)size, ALLOCATION_KIND_HOST);
         jobject object = env->NewDirectByteBuffer(nativePtr, size);
         env->SetObjectField(ptr, Pointer_buffer, object);
         env->SetObjectField(ptr, Pointer_pointers, NULL);
@@ -1867,7 +3086,12 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostRegisterNative
     {
         return JCUDA_INTERNAL_ERROR;
     }
-    int result = cudaHostRegister((void*)ptrPointerData->getPointer(env), (size_t)size, (unsigned int)flags);
+    void *nativePtr = (void*)ptrPointerData->getPointer(env);
+    int result = cudaHostRegister(nativePtr, (size_t)size, (unsigned int)flags);
+    if (result == cudaSuccess)
+    {
+        registerAllocation(nativePtr, (size_t)size, ALLOCATION_KIND_HOST);
+    }
     if (!releasePointerData(env, ptrPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
     return result;
 
@@ -1893,13 +3117,121 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostUnregisterNative
     {
         return JCUDA_INTERNAL_ERROR;
     }
-    int result = cudaHostUnregister((void*)ptrPointerData->getPointer(env));
+    void *nativePtr = (void*)ptrPointerData->getPointer(env);
+    int result = cudaHostUnregister(nativePtr);
+    if (result == cudaSuccess)
+    {
+        allocationRegistry.remove(nativePtr);
+    }
     if (!releasePointerData(env, ptrPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
     return result;
 
 }
 
 
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaRegistrationCacheEnableNative
+ * Signature: (IJ)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaRegistrationCacheEnableNative
+  (JNIEnv *env, jclass cls, jint threshold, jlong budget)
+{
+    Logger::log(LOG_TRACE, "Executing cudaRegistrationCacheEnable\n");
+
+    if (threshold < 1 || budget < 0)
+    {
+        return cudaErrorInvalidValue;
+    }
+    if (!registrationCache.enable(env, (int)threshold, (jcuda_int64)budget))
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    return cudaSuccess;
+}
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaRegistrationCacheDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaRegistrationCacheDisableNative
+  (JNIEnv *env, jclass cls)
+{
+    Logger::log(LOG_TRACE, "Executing cudaRegistrationCacheDisable\n");
+
+    registrationCache.disable(env);
+    return cudaSuccess;
+}
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaRegistrationCacheReleaseNative
+ * Signature: (Ljcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaRegistrationCacheReleaseNative
+  (JNIEnv *env, jclass cls, jobject buffer)
+{
+    if (buffer == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'buffer' is null for cudaRegistrationCacheRelease");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cudaRegistrationCacheRelease\n");
+
+    registrationCache.release(env, buffer);
+    return cudaSuccess;
+}
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaRegistrationCacheGetStatisticsNative
+ * Signature: ([J[J[J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaRegistrationCacheGetStatisticsNative
+  (JNIEnv *env, jclass cls, jlongArray registeredCount, jlongArray registeredBytes, jlongArray hits, jlongArray misses, jlongArray evictions)
+{
+    if (registeredCount == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'registeredCount' is null for cudaRegistrationCacheGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (registeredBytes == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'registeredBytes' is null for cudaRegistrationCacheGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (hits == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'hits' is null for cudaRegistrationCacheGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (misses == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'misses' is null for cudaRegistrationCacheGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (evictions == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'evictions' is null for cudaRegistrationCacheGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cudaRegistrationCacheGetStatistics\n");
+
+    RegistrationCacheStatistics statistics;
+    registrationCache.getStatistics(&statistics);
+    if (!set(env, registeredCount, 0, (jlong)statistics.registeredCount)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, registeredBytes, 0, (jlong)statistics.registeredBytes)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, hits, 0, (jlong)statistics.hits)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, misses, 0, (jlong)statistics.misses)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, evictions, 0, (jlong)statistics.evictions)) return JCUDA_INTERNAL_ERROR;
+    return cudaSuccess;
+}
+
+
 
 
 /*
@@ -1948,6 +3280,10 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMallocNative
 
     void *nativeDevPtr = NULL;
     int result = cudaMalloc(&nativeDevPtr, (size_t)size);
+    if (result == cudaSuccess)
+    {
+        registerAllocation(nativeDevPtr, (size_t)size, ALLOCATION_KIND_DEVICE);
+    }
     setPointer(env, devPtr, (jlong)nativeDevPtr);
 
     return result;
@@ -1972,6 +3308,10 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaFreeNative
     void *nativeDevPtr = NULL;
     nativeDevPtr = getPointer(env, devPtr);
     int result = cudaFree(nativeDevPtr);
+    if (result == cudaSuccess)
+    {
+        allocationRegistry.remove(nativeDevPtr);
+    }
     return result;
 }
 
@@ -2007,6 +3347,11 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMalloc3DNative
 
     cudaPitchedPtr nativePitchDevPtr;
     int result = cudaMalloc3D(&nativePitchDevPtr, nativeExtent);
+    if (result == cudaSuccess)
+    {
+        size_t size = nativePitchDevPtr.pitch * nativeExtent.height * nativeExtent.depth;
+        registerAllocation(nativePitchDevPtr.ptr, size, ALLOCATION_KIND_DEVICE);
+    }
 
     setCudaPitchedPtr(env, pitchDevPtr, nativePitchDevPtr);
 
@@ -2035,6 +3380,18 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpyNative
     }
     Logger::log(LOG_TRACE, "Executing cudaMemcpy of %ld bytes\n", (long)count);
 
+    // Count the transfers from and to host buffers for the registration cache
+    jobject host = NULL;
+    if (kind == cudaMemcpyHostToDevice)
+    {
+        host = src;
+    }
+    else if (kind == cudaMemcpyDeviceToHost)
+    {
+        host = dst;
+    }
+    RegistrationTransfer transfer(registrationCache, env, host);
+
     // Obtain the destination and source pointers
     PointerData *dstPointerData = initPointerData(env, dst);
     if (dstPointerData == NULL)
@@ -2047,9 +3404,13 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpyNative
         return JCUDA_INTERNAL_ERROR;
     }
 
-    // Execute the cudaMemcpy operation
+    // Execute the cudaMemcpy operation, staged if the copyPlanner chooses to
     int result = JCUDA_INTERNAL_ERROR;
-    if (kind == cudaMemcpyHostToHost)
+    if (executePlannedCopy(env, dst, dstPointerData, src, srcPointerData, (size_t)count, kind, 0, false, &result))
+    {
+        Logger::log(LOG_TRACE, "Copied %ld bytes through staging buffers\n", (long)count);
+    }
+    else if (kind == cudaMemcpyHostToHost)
     {
         Logger::log(LOG_TRACE, "Copying %ld bytes from host to host\n", (long)count);
         result = cudaMemcpy((void*)dstPointerData->getPointer(env), (void*)srcPointerData->getPointer(env), (size_t)count, cudaMemcpyHostToHost);
@@ -2061,24 +3422,145 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpyNative
     }
     else if (kind == cudaMemcpyDeviceToHost)
     {
-        Logger::log(LOG_TRACE, "Copying %ld bytes from device to host\n", (long)count);
-        result = cudaMemcpy((void*)dstPointerData->getPointer(env), (void*)srcPointerData->getPointer(env), (size_t)count, cudaMemcpyDeviceToHost);
+        Logger::log(LOG_TRACE, "Copying %ld bytes from device to host\n", (long)count);
+        result = cudaMemcpy((void*)dstPointerData->getPointer(env), (void*)srcPointerData->getPointer(env), (size_t)count, cudaMemcpyDeviceToHost);
+    }
+    else if (kind == cudaMemcpyDeviceToDevice)
+    {
+        Logger::log(LOG_TRACE, "Copying %ld bytes from device to device\n", (long)count);
+        result = cudaMemcpy((void*)dstPointerData->getPointer(env), (void*)srcPointerData->getPointer(env), (size_t)count, cudaMemcpyDeviceToDevice);
+    }
+    else
+    {
+        Logger::log(LOG_ERROR, "Invalid cudaMemcpyKind given: %d\n", kind);
+        return cudaErrorInvalidMemcpyDirection;
+    }
+
+    // Release the pointer data
+    if (!releasePointerData(env, dstPointerData)) return JCUDA_INTERNAL_ERROR;
+    if (!releasePointerData(env, srcPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    return result;
+}
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaMemcpyAutoNative
+ * Signature: (Ljcuda/Pointer;Ljcuda/Pointer;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpyAutoNative
+  (JNIEnv *env, jclass cls, jobject dst, jobject src, jlong count)
+{
+    if (dst == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dst' is null for cudaMemcpyAuto");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (src == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'src' is null for cudaMemcpyAuto");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cudaMemcpyAuto of %ld bytes\n", (long)count);
+
+    // Obtain the destination and source pointers
+    PointerData *dstPointerData = initPointerData(env, dst);
+    if (dstPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    PointerData *srcPointerData = initPointerData(env, src);
+    if (srcPointerData == NULL)
+    {
+        releasePointerData(env, dstPointerData, JNI_ABORT);
+        return JCUDA_INTERNAL_ERROR;
+    }
+    void *nativeDst = dstPointerData->getPointer(env);
+    void *nativeSrc = srcPointerData->getPointer(env);
+    size_t nativeCount = (size_t)count;
+
+    AllocationInfo dstInfo;
+    AllocationInfo srcInfo;
+    lookupAllocation(env, dst, nativeDst, &dstInfo);
+    lookupAllocation(env, src, nativeSrc, &srcInfo);
+
+    int result = JCUDA_INTERNAL_ERROR;
+    CopyPath path = AllocationRegistry::selectCopyPath(dstInfo, srcInfo);
+    switch (path)
+    {
+        case COPY_PATH_HOST_TO_HOST:
+            Logger::log(LOG_DEBUGTRACE, "Copying %ld bytes from host to host\n", (long)count);
+            memcpy(nativeDst, nativeSrc, nativeCount);
+            result = cudaSuccess;
+            break;
+
+        case COPY_PATH_HOST_TO_DEVICE:
+            Logger::log(LOG_DEBUGTRACE, "Copying %ld bytes from host to device\n", (long)count);
+            result = cudaMemcpy(nativeDst, nativeSrc, nativeCount, cudaMemcpyHostToDevice);
+            break;
+
+        case COPY_PATH_DEVICE_TO_HOST:
+            Logger::log(LOG_DEBUGTRACE, "Copying %ld bytes from device to host\n", (long)count);
+            result = cudaMemcpy(nativeDst, nativeSrc, nativeCount, cudaMemcpyDeviceToHost);
+            break;
+
+        case COPY_PATH_DEVICE_TO_DEVICE:
+            Logger::log(LOG_DEBUGTRACE, "Copying %ld bytes from device to device\n", (long)count);
+            result = cudaMemcpy(nativeDst, nativeSrc, nativeCount, cudaMemcpyDeviceToDevice);
+            break;
+
+        case COPY_PATH_PEER:
+            if (dstInfo.device != -1 && srcInfo.device != -1)
+            {
+                Logger::log(LOG_DEBUGTRACE, "Copying %ld bytes from device %d to device %d\n", (long)count, srcInfo.device, dstInfo.device);
+                result = cudaMemcpyPeer(nativeDst, dstInfo.device, nativeSrc, srcInfo.device, nativeCount);
+                break;
+            }
+            // Fall through if the devices are not known
+
+        default:
+            Logger::log(LOG_DEBUGTRACE, "Copying %ld bytes with unified addressing\n", (long)count);
+            result = cudaMemcpy(nativeDst, nativeSrc, nativeCount, cudaMemcpyDefault);
+            break;
+    }
+
+    // Release the pointer data
+    if (!releasePointerData(env, dstPointerData)) return JCUDA_INTERNAL_ERROR;
+    if (!releasePointerData(env, srcPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    return result;
+}
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaMemRegistryLookupNative
+ * Signature: ([I[ILjcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemRegistryLookupNative
+  (JNIEnv *env, jclass cls, jintArray memoryType, jintArray device, jobject ptr)
+{
+    if (memoryType == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'memoryType' is null for cudaMemRegistryLookup");
+        return JCUDA_INTERNAL_ERROR;
     }
-    else if (kind == cudaMemcpyDeviceToDevice)
+    if (device == NULL)
     {
-        Logger::log(LOG_TRACE, "Copying %ld bytes from device to device\n", (long)count);
-        result = cudaMemcpy((void*)dstPointerData->getPointer(env), (void*)srcPointerData->getPointer(env), (size_t)count, cudaMemcpyDeviceToDevice);
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'device' is null for cudaMemRegistryLookup");
+        return JCUDA_INTERNAL_ERROR;
     }
-    else
+    if (ptr == NULL)
     {
-        Logger::log(LOG_ERROR, "Invalid cudaMemcpyKind given: %d\n", kind);
-        return cudaErrorInvalidMemcpyDirection;
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ptr' is null for cudaMemRegistryLookup");
+        return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cudaMemRegistryLookup\n");
 
-    // Release the pointer data
-    if (!releasePointerData(env, dstPointerData)) return JCUDA_INTERNAL_ERROR;
-    if (!releasePointerData(env, srcPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
-    return result;
+    void *nativePtr = getPointer(env, ptr);
+    AllocationInfo info;
+    allocationRegistry.activate();
+    allocationRegistry.lookup(nativePtr, &info);
+    if (!set(env, memoryType, 0, info.kind)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, device, 0, info.device)) return JCUDA_INTERNAL_ERROR;
+    return cudaSuccess;
 }
 
 
@@ -2114,7 +3596,8 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpyPeerNative
         return JCUDA_INTERNAL_ERROR;
     }
 
-    int result = cudaMemcpyPeer((void*)dstPointerData->getPointer(env), (int)dstDevice, (void*)srcPointerData->getPointer(env), (int)srcDevice, (size_t)count);
+    int result = peerRouter.copy((void*)dstPointerData->getPointer(env), getPeerEndpoint((int)dstDevice),
+        (void*)srcPointerData->getPointer(env), getPeerEndpoint((int)srcDevice), (size_t)count, NULL, false);
 
     // Release the pointer data
     if (!releasePointerData(env, dstPointerData)) return JCUDA_INTERNAL_ERROR;
@@ -2375,7 +3858,11 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpy3DNative
     Logger::log(LOG_TRACE, "Executing cudaMemcpy3D\n");
 
     cudaMemcpy3DParms nativeP = getCudaMemcpy3DParms(env, p);
-    int result = cudaMemcpy3D(&nativeP);
+    int result = cudaSuccess;
+    if (!executePackedCopy3D(env, p, &nativeP, &result))
+    {
+        result = cudaMemcpy3D(&nativeP);
+    }
     return result;
 }
 
@@ -2530,22 +4017,341 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaArrayGetInfoNative
  * Method:    cudaMallocHostNative
  * Signature: (Ljcuda/Pointer;J)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMallocHostNative
-  (JNIEnv *env, jclass cls, jobject ptr, jlong size)
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMallocHostNative
+  (JNIEnv *env, jclass cls, jobject ptr, jlong size)
+{
+    if (ptr == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ptr' is null for cudaMallocHost");
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+    Logger::log(LOG_TRACE, "Executing cudaMallocHost of %ld bytes\n", (long)size);
+
+    void *nativePtr;
+    int result = cudaSuccess;
+    if (!numaPlacement.allocate(&nativePtr, (size_t)size, 0, &result))
+    {
+        result = cudaMallocHost(&nativePtr, (size_t)size);
+    }
+    if (result == cudaSuccess)
+    {
+        registerAllocation(nativePtr, (size_t)size, ALLOCATION_KIND_HOST);
+        jobject object = env->NewDirectByteBuffer(nativePtr, size);
+        env->SetObjectField(ptr, Pointer_buffer, object);
+        env->SetObjectField(ptr, Pointer_pointers, NULL);
+        env->SetLongField(ptr, Pointer_byteOffset, 0);
+        env->SetLongField(ptr, NativePointerObject_nativePointer, (jlong)nativePtr);
+    }
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaMallocPitchNative
+ * Signature: (Ljcuda/Pointer;[JJJ)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMallocPitchNative
+  (JNIEnv *env, jclass cls, jobject devPtr, jlongArray pitch, jlong width, jlong height)
+{
+    if (devPtr == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'devPtr' is null for cudaMallocPitch");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (pitch == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pitch' is null for cudaMallocPitch");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cudaMallocPitch with width %ld and height %d\n", (long)width, (long)height);
+
+    void *nativeDevPtr = NULL;
+
+    size_t *nativePitch = new size_t[3];
+    jlong *nativePitchJava = (jlong*)env->GetPrimitiveArrayCritical(pitch, NULL);
+    for (int i=0; i<3; i++)
+    {
+        nativePitch[i] = (size_t)nativePitchJava[i];
+    }
+
+    int result = cudaMallocPitch(&nativeDevPtr, nativePitch, (size_t)width, (size_t)height);
+    if (result == cudaSuccess)
+    {
+        registerAllocation(nativeDevPtr, nativePitch[0] * (size_t)height, ALLOCATION_KIND_DEVICE);
+    }
+
+    setPointer(env, devPtr, (jlong)nativeDevPtr);
+    for (int i=0; i<3; i++)
+    {
+        nativePitchJava[i] = nativePitch[i];
+    }
+    delete[] nativePitch;
+    env->ReleasePrimitiveArrayCritical(pitch, nativePitchJava, 0);
+
+    return result;
+}
+
+
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaMallocArrayNative
+ * Signature: (Ljcuda/runtime/cudaArray;Ljcuda/runtime/cudaChannelFormatDesc;JJI)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMallocArrayNative
+  (JNIEnv *env, jclass cls, jobject array, jobject desc, jlong width, jlong height, jint flags)
+{
+    if (array == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'array' is null for cudaMallocArray");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (desc == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'desc' is null for cudaMallocArray");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cudaMallocArray with width %ld and height %d\n", (long)width, (long)height);
+
+    cudaArray *nativeArray;
+    cudaChannelFormatDesc nativeDesc = getCudaChannelFormatDesc(env, desc);
+    unsigned int nativeFlags = (unsigned int)flags;
+
+    int result = cudaMallocArray(&nativeArray, &nativeDesc, (size_t)width, (size_t)height, nativeFlags);
+
+    setNativePointerValue(env, array, (jlong)nativeArray);
+
+    return result;
+}
+
+
+
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaFreeHostNative
+ * Signature: (Ljava/nio/ByteBuffer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaFreeHostNative
+  (JNIEnv *env, jclass cls, jobject ptr)
+{
+    if (ptr == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ptr' is null for cudaFreeHost");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cudaFreeHost\n");
+
+    void *nativePtr = getPointer(env, ptr);
+    int result = cudaSuccess;
+    if (!numaPlacement.free(nativePtr, &result))
+    {
+        result = cudaFreeHost(nativePtr);
+    }
+    if (result == cudaSuccess)
+    {
+        allocationRegistry.remove(nativePtr);
+    }
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaHostSetPlacementNative
+ * Signature: (I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostSetPlacementNative
+  (JNIEnv *env, jclass cls, jint mode)
+{
+    Logger::log(LOG_TRACE, "Executing cudaHostSetPlacement\n");
+
+    if (mode != HOST_PLACEMENT_DEFAULT && mode != HOST_PLACEMENT_DEVICE)
+    {
+        return cudaErrorInvalidValue;
+    }
+    numaPlacement.setMode((int)mode);
+    return cudaSuccess;
+}
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaHostGetNumaNodeNative
+ * Signature: ([ILjcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostGetNumaNodeNative
+  (JNIEnv *env, jclass cls, jintArray node, jobject ptr)
+{
+    if (node == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'node' is null for cudaHostGetNumaNode");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (ptr == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ptr' is null for cudaHostGetNumaNode");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cudaHostGetNumaNode\n");
+
+    PointerData *ptrPointerData = initPointerData(env, ptr);
+    if (ptrPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    int nativeNode = numaPlacement.getMemoryNode((void*)ptrPointerData->getPointer(env));
+    if (!releasePointerData(env, ptrPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, node, 0, nativeNode)) return JCUDA_INTERNAL_ERROR;
+    return cudaSuccess;
+}
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaDeviceGetHostNumaNodeNative
+ * Signature: ([II)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaDeviceGetHostNumaNodeNative
+  (JNIEnv *env, jclass cls, jintArray node, jint device)
+{
+    if (node == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'node' is null for cudaDeviceGetHostNumaNode");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cudaDeviceGetHostNumaNode\n");
+
+    int nativeNode = numaPlacement.getDeviceNode((int)device);
+    if (!set(env, node, 0, nativeNode)) return JCUDA_INTERNAL_ERROR;
+    return cudaSuccess;
+}
+
+
+
+/**
+ * The HostArenaAllocFunction for arenas of the runtime API
+ */
+static int runtimeHostArenaAlloc(void **pointer, size_t size, unsigned int flags)
+{
+    int result = cudaHostAlloc(pointer, size, flags);
+    if (result == cudaSuccess)
+    {
+        registerAllocation(*pointer, size, ALLOCATION_KIND_HOST);
+    }
+    return result;
+}
+
+/**
+ * The HostArenaFreeFunction for arenas of the runtime API
+ */
+static int runtimeHostArenaFree(void *pointer)
+{
+    allocationRegistry.remove(pointer);
+    return cudaFreeHost(pointer);
+}
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaHostArenaCreateNative
+ * Signature: (Ljcuda/runtime/cudaHostArena;JJI)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostArenaCreateNative
+  (JNIEnv *env, jclass cls, jobject arena, jlong regionSize, jlong alignment, jint flags)
+{
+    if (arena == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'arena' is null for cudaHostArenaCreate");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cudaHostArenaCreate\n");
+
+    if (regionSize <= 0 || alignment <= 0 || (alignment & (alignment - 1)) != 0)
+    {
+        return cudaErrorInvalidValue;
+    }
+    HostArena *nativeArena = new HostArena(&runtimeHostArenaAlloc, &runtimeHostArenaFree,
+        (size_t)regionSize, (size_t)alignment, (unsigned int)flags);
+    if (nativeArena == NULL)
+    {
+        ThrowByName(env, "java/lang/OutOfMemoryError",
+            "Out of memory while creating host arena");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    setNativePointerValue(env, arena, (jlong)nativeArena);
+    return cudaSuccess;
+}
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaHostArenaDestroyNative
+ * Signature: (Ljcuda/runtime/cudaHostArena;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostArenaDestroyNative
+  (JNIEnv *env, jclass cls, jobject arena)
+{
+    if (arena == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'arena' is null for cudaHostArenaDestroy");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cudaHostArenaDestroy\n");
+
+    HostArena *nativeArena = (HostArena*)getNativePointerValue(env, arena);
+    if (nativeArena == NULL)
+    {
+        return cudaErrorInvalidResourceHandle;
+    }
+    delete nativeArena;
+    setNativePointerValue(env, arena, 0);
+    return cudaSuccess;
+}
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaHostArenaAllocNative
+ * Signature: (Ljcuda/runtime/cudaHostArena;Ljcuda/Pointer;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostArenaAllocNative
+  (JNIEnv *env, jclass cls, jobject arena, jobject ptr, jlong size)
 {
+    if (arena == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'arena' is null for cudaHostArenaAlloc");
+        return JCUDA_INTERNAL_ERROR;
+    }
     if (ptr == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ptr' is null for cudaMallocHost");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ptr' is null for cudaHostArenaAlloc");
         return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cudaHostArenaAlloc\n");
 
-    Logger::log(LOG_TRACE, "Executing cudaMallocHost of %ld bytes\n", (long)size);
-
+    HostArena *nativeArena = (HostArena*)getNativePointerValue(env, arena);
+    if (nativeArena == NULL)
+    {
+        return cudaErrorInvalidResourceHandle;
+    }
+    if (size <= 0)
+    {
+        return cudaErrorInvalidValue;
+    }
     void *nativePtr;
-    int result = cudaMallocHost(&nativePtr, (size_t)size);
+    int result = nativeArena->allocate(&nativePtr, (size_t)size);
     if (result == cudaSuccess)
     {
         jobject object = env->NewDirectByteBuffer(nativePtr, size);
+        if (object == NULL)
+        {
+            nativeArena->free(nativePtr, (size_t)size);
+            return JCUDA_INTERNAL_ERROR;
+        }
         env->SetObjectField(ptr, Pointer_buffer, object);
         env->SetObjectField(ptr, Pointer_pointers, NULL);
         env->SetLongField(ptr, Pointer_byteOffset, 0);
@@ -2554,107 +4360,93 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMallocHostNative
     return result;
 }
 
-
-
-
 /*
  * Class:     jcuda_runtime_JCuda
- * Method:    cudaMallocPitchNative
- * Signature: (Ljcuda/Pointer;[JJJ)I
+ * Method:    cudaHostArenaFreeNative
+ * Signature: (Ljcuda/runtime/cudaHostArena;Ljcuda/Pointer;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMallocPitchNative
-  (JNIEnv *env, jclass cls, jobject devPtr, jlongArray pitch, jlong width, jlong height)
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostArenaFreeNative
+  (JNIEnv *env, jclass cls, jobject arena, jobject ptr)
 {
-    if (devPtr == NULL)
+    if (arena == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'devPtr' is null for cudaMallocPitch");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'arena' is null for cudaHostArenaFree");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (pitch == NULL)
+    if (ptr == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pitch' is null for cudaMallocPitch");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ptr' is null for cudaHostArenaFree");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cudaMallocPitch with width %ld and height %d\n", (long)width, (long)height);
-
-    void *nativeDevPtr = NULL;
+    Logger::log(LOG_TRACE, "Executing cudaHostArenaFree\n");
 
-    size_t *nativePitch = new size_t[3];
-    jlong *nativePitchJava = (jlong*)env->GetPrimitiveArrayCritical(pitch, NULL);
-    for (int i=0; i<3; i++)
+    HostArena *nativeArena = (HostArena*)getNativePointerValue(env, arena);
+    if (nativeArena == NULL)
     {
-        nativePitch[i] = (size_t)nativePitchJava[i];
+        return cudaErrorInvalidResourceHandle;
     }
 
-    int result = cudaMallocPitch(&nativeDevPtr, nativePitch, (size_t)width, (size_t)height);
+    // The size of the block is the capacity of the buffer that
+    // was created in cudaHostArenaAlloc
+    jobject buffer = env->GetObjectField(ptr, Pointer_buffer);
+    if (buffer == NULL || env->GetLongField(ptr, Pointer_byteOffset) != 0)
+    {
+        return cudaErrorInvalidValue;
+    }
+    void *nativePtr = env->GetDirectBufferAddress(buffer);
+    jlong capacity = env->GetDirectBufferCapacity(buffer);
+    if (nativePtr == NULL || capacity <= 0)
+    {
+        return cudaErrorInvalidValue;
+    }
 
-    setPointer(env, devPtr, (jlong)nativeDevPtr);
-    for (int i=0; i<3; i++)
+    // Pointers that refer to other memory would corrupt the free lists
+    if (!nativeArena->owns(nativePtr, (size_t)capacity))
     {
-        nativePitchJava[i] = nativePitch[i];
+        return cudaErrorInvalidValue;
     }
-    delete[] nativePitch;
-    env->ReleasePrimitiveArrayCritical(pitch, nativePitchJava, 0);
+    nativeArena->free(nativePtr, (size_t)capacity);
 
-    return result;
+    // Clear the pointer, so that freeing it twice is detected
+    env->SetObjectField(ptr, Pointer_buffer, NULL);
+    env->SetLongField(ptr, NativePointerObject_nativePointer, 0);
+    return cudaSuccess;
 }
 
-
-
-
 /*
  * Class:     jcuda_runtime_JCuda
- * Method:    cudaMallocArrayNative
- * Signature: (Ljcuda/runtime/cudaArray;Ljcuda/runtime/cudaChannelFormatDesc;JJI)I
+ * Method:    cudaHostArenaGetStatisticsNative
+ * Signature: (Ljcuda/runtime/cudaHostArena;Ljcuda/runtime/cudaHostArenaStatistics;)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMallocArrayNative
-  (JNIEnv *env, jclass cls, jobject array, jobject desc, jlong width, jlong height, jint flags)
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostArenaGetStatisticsNative
+  (JNIEnv *env, jclass cls, jobject arena, jobject statistics)
 {
-    if (array == NULL)
+    if (arena == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'array' is null for cudaMallocArray");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'arena' is null for cudaHostArenaGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (desc == NULL)
+    if (statistics == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'desc' is null for cudaMallocArray");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'statistics' is null for cudaHostArenaGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cudaMallocArray with width %ld and height %d\n", (long)width, (long)height);
-
-    cudaArray *nativeArray;
-    cudaChannelFormatDesc nativeDesc = getCudaChannelFormatDesc(env, desc);
-    unsigned int nativeFlags = (unsigned int)flags;
-
-    int result = cudaMallocArray(&nativeArray, &nativeDesc, (size_t)width, (size_t)height, nativeFlags);
-
-    setNativePointerValue(env, array, (jlong)nativeArray);
-
-    return result;
-}
-
-
+    Logger::log(LOG_TRACE, "Executing cudaHostArenaGetStatistics\n");
 
-
-
-/*
- * Class:     jcuda_runtime_JCuda
- * Method:    cudaFreeHostNative
- * Signature: (Ljava/nio/ByteBuffer;)I
- */
-JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaFreeHostNative
-  (JNIEnv *env, jclass cls, jobject ptr)
-{
-    if (ptr == NULL)
+    HostArena *nativeArena = (HostArena*)getNativePointerValue(env, arena);
+    if (nativeArena == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'ptr' is null for cudaFreeHost");
-        return JCUDA_INTERNAL_ERROR;
+        return cudaErrorInvalidResourceHandle;
     }
-    Logger::log(LOG_TRACE, "Executing cudaFreeHost\n");
-
-    void *nativePtr = getPointer(env, ptr);
-    int result = cudaFreeHost(nativePtr);
-    return result;
+    HostArenaStatistics nativeStatistics;
+    nativeArena->getStatistics(&nativeStatistics);
+    env->SetLongField(statistics,  cudaHostArenaStatistics_reservedBytes,  (jlong)nativeStatistics.reservedBytes);
+    env->SetLongField(statistics,  cudaHostArenaStatistics_usedBytes,      (jlong)nativeStatistics.usedBytes);
+    env->SetLongField(statistics,  cudaHostArenaStatistics_requestedBytes, (jlong)nativeStatistics.requestedBytes);
+    env->SetLongField(statistics,  cudaHostArenaStatistics_highWaterMark,  (jlong)nativeStatistics.highWaterMark);
+    env->SetLongField(statistics,  cudaHostArenaStatistics_regionCount,    (jlong)nativeStatistics.regionCount);
+    env->SetFloatField(statistics, cudaHostArenaStatistics_fragmentation,  (jfloat)nativeStatistics.fragmentation);
+    return cudaSuccess;
 }
 
 
@@ -2838,7 +4630,11 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpy2DNative
         return JCUDA_INTERNAL_ERROR;
     }
 
-    int result = cudaMemcpy2D((void*)dstPointerData->getPointer(env), (size_t)dpitch, (void*)srcPointerData->getPointer(env), (size_t)spitch, (size_t)width, (size_t)height, (cudaMemcpyKind)kind);
+    int result = cudaSuccess;
+    if (!executePackedCopy2D(env, dst, dstPointerData, (size_t)dpitch, src, srcPointerData, (size_t)spitch, (size_t)width, (size_t)height, (int)kind, &result))
+    {
+        result = cudaMemcpy2D((void*)dstPointerData->getPointer(env), (size_t)dpitch, (void*)srcPointerData->getPointer(env), (size_t)spitch, (size_t)width, (size_t)height, (cudaMemcpyKind)kind);
+    }
 
     if (!releasePointerData(env, srcPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
     if (!releasePointerData(env, dstPointerData)) return JCUDA_INTERNAL_ERROR;
@@ -3014,111 +4810,389 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpyFromSymbolNative
     /*
     if (dst == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dst' is null for cudaMemcpyFromSymbol");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dst' is null for cudaMemcpyFromSymbol");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (symbol == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'symbol' is null for cudaMemcpyFromSymbol");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cudaMemcpyFromSymbol\n");
+
+    PointerData *dstPointerData = initPointerData(env, dst);
+    if (dstPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    char *nativeSymbol = convertString(env, symbol);
+
+    int result = cudaMemcpyFromSymbol((void*)dstPointerData->getPointer(env), nativeSymbol, (size_t)count, (size_t)offset, (cudaMemcpyKind)kind);
+    delete[] nativeSymbol;
+
+    if (!releasePointerData(env, dstPointerData)) return JCUDA_INTERNAL_ERROR;
+
+    return result;
+    */
+}
+
+
+
+
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaMemcpyAsyncNative
+ * Signature: (Ljcuda/Pointer;Ljcuda/Pointer;JILjcuda/runtime/cudaStream_t;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpyAsyncNative
+  (JNIEnv *env, jclass cls, jobject dst, jobject src, jlong count, jint kind, jobject stream)
+{
+    if (dst == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dst' is null for cudaMemcpyAsync");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (src == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'src' is null for cudaMemcpyAsync");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    /* May be null
+    if (stream == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'stream' is null for cudaMemcpyAsync");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    */
+
+    Logger::log(LOG_TRACE, "Executing cudaMemcpyAsync of %ld bytes\n", (long)count);
+
+    cudaStream_t nativeStream = (cudaStream_t)getNativePointerValue(env, stream);
+
+    // Count the transfers from and to host buffers for the registration cache
+    jobject host = NULL;
+    if (kind == cudaMemcpyHostToDevice)
+    {
+        host = src;
+    }
+    else if (kind == cudaMemcpyDeviceToHost)
+    {
+        host = dst;
+    }
+    RegistrationTransfer transfer(registrationCache, env, host);
+
+    // Copies between Java arrays and device memory are bounced through
+    // page-locked slots, so that the arrays are not used asynchronously
+    int result = JCUDA_INTERNAL_ERROR;
+    if (executeBouncedCopy(env, dst, src, (size_t)count, kind, nativeStream, &result))
+    {
+        return result;
+    }
+
+    // Obtain the destination and source pointers
+    PointerData *dstPointerData = initPointerData(env, dst);
+    if (dstPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    PointerData *srcPointerData = initPointerData(env, src);
+    if (srcPointerData == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+
+    // Execute the cudaMemcpy operation, staged if the copyPlanner chooses to
+    if (executePlannedCopy(env, dst, dstPointerData, src, srcPointerData, (size_t)count, kind, nativeStream, true, &result))
+    {
+        Logger::log(LOG_TRACE, "Copied %ld bytes through staging buffers\n", (long)count);
+    }
+    else if (kind == cudaMemcpyHostToHost)
+    {
+        Logger::log(LOG_TRACE, "Copying %ld bytes from host to host (async)\n", (long)count);
+        result = cudaMemcpyAsync((void*)dstPointerData->getPointer(env), (void*)srcPointerData->getPointer(env), (size_t)count, cudaMemcpyHostToHost, nativeStream);
+    }
+    else if (kind == cudaMemcpyHostToDevice)
+    {
+        Logger::log(LOG_TRACE, "Copying %ld bytes from host to device (async)\n", (long)count);
+        result = cudaMemcpyAsync((void*)dstPointerData->getPointer(env), (void*)srcPointerData->getPointer(env), (size_t)count, cudaMemcpyHostToDevice, nativeStream);
+    }
+    else if (kind == cudaMemcpyDeviceToHost)
+    {
+        Logger::log(LOG_TRACE, "Copying %ld bytes from device to host (async)\n", (long)count);
+        result = cudaMemcpyAsync((void*)dstPointerData->getPointer(env), (void*)srcPointerData->getPointer(env), (size_t)count, cudaMemcpyDeviceToHost, nativeStream);
+    }
+    else if (kind == cudaMemcpyDeviceToDevice)
+    {
+        Logger::log(LOG_TRACE, "Copying %ld bytes from device to device (async)\n", (long)count);
+        result = cudaMemcpyAsync((void*)dstPointerData->getPointer(env), (void*)srcPointerData->getPointer(env), (size_t)count, cudaMemcpyDeviceToDevice, nativeStream);
+    }
+    else
+    {
+        Logger::log(LOG_ERROR, "Invalid cudaMemcpyKind given: %d\n", kind);
+        return cudaErrorInvalidMemcpyDirection;
+    }
+    transfer.issued(nativeStream);
+
+    // Release the pointer data
+    if (!releasePointerData(env, dstPointerData)) return JCUDA_INTERNAL_ERROR;
+    if (!releasePointerData(env, srcPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaCopyPlannerEnableNative
+ * Signature: (JJ)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaCopyPlannerEnableNative
+  (JNIEnv *env, jclass cls, jlong chunkSize, jlong stagingThreshold)
+{
+    Logger::log(LOG_TRACE, "Executing cudaCopyPlannerEnable\n");
+
+    if (chunkSize < 1 || stagingThreshold < 0)
+    {
+        return cudaErrorInvalidValue;
+    }
+
+    // The page-locked and device memory is recognized with the registry
+    allocationRegistry.activate();
+    copyPlanner.enable((size_t)chunkSize, (size_t)stagingThreshold);
+    return cudaSuccess;
+}
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaCopyPlannerDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaCopyPlannerDisableNative
+  (JNIEnv *env, jclass cls)
+{
+    Logger::log(LOG_TRACE, "Executing cudaCopyPlannerDisable\n");
+
+    copyPlanner.disable();
+    return cudaSuccess;
+}
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaCopyPlannerGetLastStrategyNative
+ * Signature: ([I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaCopyPlannerGetLastStrategyNative
+  (JNIEnv *env, jclass cls, jintArray strategy)
+{
+    if (strategy == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'strategy' is null for cudaCopyPlannerGetLastStrategy");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cudaCopyPlannerGetLastStrategy\n");
+
+    if (!set(env, strategy, 0, (jint)CopyPlanner::getLastStrategy())) return JCUDA_INTERNAL_ERROR;
+    return cudaSuccess;
+}
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaCopyPlannerGetStatisticsNative
+ * Signature: ([J[J[J[J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaCopyPlannerGetStatisticsNative
+  (JNIEnv *env, jclass cls, jlongArray directCount, jlongArray directBytes, jlongArray stagedCount, jlongArray stagedBytes, jlongArray chunkedCount, jlongArray chunkedBytes)
+{
+    if (directCount == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'directCount' is null for cudaCopyPlannerGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (directBytes == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'directBytes' is null for cudaCopyPlannerGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (stagedCount == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'stagedCount' is null for cudaCopyPlannerGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (stagedBytes == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'stagedBytes' is null for cudaCopyPlannerGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    if (symbol == NULL)
+    if (chunkedCount == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'symbol' is null for cudaMemcpyFromSymbol");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'chunkedCount' is null for cudaCopyPlannerGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    Logger::log(LOG_TRACE, "Executing cudaMemcpyFromSymbol\n");
-
-    PointerData *dstPointerData = initPointerData(env, dst);
-    if (dstPointerData == NULL)
+    if (chunkedBytes == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'chunkedBytes' is null for cudaCopyPlannerGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    char *nativeSymbol = convertString(env, symbol);
+    Logger::log(LOG_TRACE, "Executing cudaCopyPlannerGetStatistics\n");
 
-    int result = cudaMemcpyFromSymbol((void*)dstPointerData->getPointer(env), nativeSymbol, (size_t)count, (size_t)offset, (cudaMemcpyKind)kind);
-    delete[] nativeSymbol;
+    CopyPlannerStatistics statistics;
+    copyPlanner.getStatistics(&statistics);
+    if (!set(env, directCount, 0, (jlong)statistics.counts[COPY_STRATEGY_DIRECT])) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, directBytes, 0, (jlong)statistics.bytes[COPY_STRATEGY_DIRECT])) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, stagedCount, 0, (jlong)statistics.counts[COPY_STRATEGY_STAGED])) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, stagedBytes, 0, (jlong)statistics.bytes[COPY_STRATEGY_STAGED])) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, chunkedCount, 0, (jlong)statistics.counts[COPY_STRATEGY_CHUNKED])) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, chunkedBytes, 0, (jlong)statistics.bytes[COPY_STRATEGY_CHUNKED])) return JCUDA_INTERNAL_ERROR;
+    return cudaSuccess;
+}
 
-    if (!releasePointerData(env, dstPointerData)) return JCUDA_INTERNAL_ERROR;
 
-    return result;
-    */
-}
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaBounceRingEnableNative
+ * Signature: (JI)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaBounceRingEnableNative
+  (JNIEnv *env, jclass cls, jlong slotSize, jint slotCount)
+{
+    Logger::log(LOG_TRACE, "Executing cudaBounceRingEnable\n");
 
+    if (slotSize < 1 || slotCount < 1)
+    {
+        return cudaErrorInvalidValue;
+    }
+    bounceRing.enable(env, (size_t)slotSize, (int)slotCount);
+    return cudaSuccess;
+}
 
 
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaBounceRingDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaBounceRingDisableNative
+  (JNIEnv *env, jclass cls)
+{
+    Logger::log(LOG_TRACE, "Executing cudaBounceRingDisable\n");
 
+    bounceRing.disable(env);
+    return cudaSuccess;
+}
 
 
 /*
  * Class:     jcuda_runtime_JCuda
- * Method:    cudaMemcpyAsyncNative
- * Signature: (Ljcuda/Pointer;Ljcuda/Pointer;JILjcuda/runtime/cudaStream_t;)I
+ * Method:    cudaBounceRingGetStatisticsNative
+ * Signature: ([J[J[J[J)I
  */
-JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpyAsyncNative
-  (JNIEnv *env, jclass cls, jobject dst, jobject src, jlong count, jint kind, jobject stream)
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaBounceRingGetStatisticsNative
+  (JNIEnv *env, jclass cls, jlongArray copies, jlongArray bytes, jlongArray waits, jlongArray pending)
 {
-    if (dst == NULL)
-    {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'dst' is null for cudaMemcpyAsync");
-        return JCUDA_INTERNAL_ERROR;
-    }
-    if (src == NULL)
+    if (copies == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'src' is null for cudaMemcpyAsync");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'copies' is null for cudaBounceRingGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    /* May be null
-    if (stream == NULL)
+    if (bytes == NULL)
     {
-        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'stream' is null for cudaMemcpyAsync");
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'bytes' is null for cudaBounceRingGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    */
-
-    Logger::log(LOG_TRACE, "Executing cudaMemcpyAsync of %ld bytes\n", (long)count);
-
-    cudaStream_t nativeStream = (cudaStream_t)getNativePointerValue(env, stream);
-
-    // Obtain the destination and source pointers
-    PointerData *dstPointerData = initPointerData(env, dst);
-    if (dstPointerData == NULL)
+    if (waits == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'waits' is null for cudaBounceRingGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
-    PointerData *srcPointerData = initPointerData(env, src);
-    if (srcPointerData == NULL)
+    if (pending == NULL)
     {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pending' is null for cudaBounceRingGetStatistics");
         return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cudaBounceRingGetStatistics\n");
 
-    // Execute the cudaMemcpy operation
-    int result = JCUDA_INTERNAL_ERROR;
-    if (kind == cudaMemcpyHostToHost)
+    BounceRingStatistics statistics;
+    bounceRing.getStatistics(&statistics);
+    if (!set(env, copies, 0, (jlong)statistics.copies)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, bytes, 0, (jlong)statistics.bytes)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, waits, 0, (jlong)statistics.waits)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, pending, 0, (jlong)statistics.pending)) return JCUDA_INTERNAL_ERROR;
+    return cudaSuccess;
+}
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaPitchPackerEnableNative
+ * Signature: (IJ)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaPitchPackerEnableNative
+  (JNIEnv *env, jclass cls, jint threadCount, jlong threshold)
+{
+    Logger::log(LOG_TRACE, "Executing cudaPitchPackerEnable\n");
+
+    if (threshold < 0)
     {
-        Logger::log(LOG_TRACE, "Copying %ld bytes from host to host (async)\n", (long)count);
-        result = cudaMemcpyAsync((void*)dstPointerData->getPointer(env), (void*)srcPointerData->getPointer(env), (size_t)count, cudaMemcpyHostToHost, nativeStream);
+        return cudaErrorInvalidValue;
     }
-    else if (kind == cudaMemcpyHostToDevice)
+    if (!pitchPacker.enable((int)threadCount, (size_t)threshold))
     {
-        Logger::log(LOG_TRACE, "Copying %ld bytes from host to device (async)\n", (long)count);
-        result = cudaMemcpyAsync((void*)dstPointerData->getPointer(env), (void*)srcPointerData->getPointer(env), (size_t)count, cudaMemcpyHostToDevice, nativeStream);
+        return cudaErrorUnknown;
     }
-    else if (kind == cudaMemcpyDeviceToHost)
+    return cudaSuccess;
+}
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaPitchPackerDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaPitchPackerDisableNative
+  (JNIEnv *env, jclass cls)
+{
+    Logger::log(LOG_TRACE, "Executing cudaPitchPackerDisable\n");
+
+    pitchPacker.disable();
+    return cudaSuccess;
+}
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaPitchPackerGetStatisticsNative
+ * Signature: ([J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaPitchPackerGetStatisticsNative
+  (JNIEnv *env, jclass cls, jlongArray copies, jlongArray bytes, jlongArray nanos)
+{
+    if (copies == NULL)
     {
-        Logger::log(LOG_TRACE, "Copying %ld bytes from device to host (async)\n", (long)count);
-        result = cudaMemcpyAsync((void*)dstPointerData->getPointer(env), (void*)srcPointerData->getPointer(env), (size_t)count, cudaMemcpyDeviceToHost, nativeStream);
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'copies' is null for cudaPitchPackerGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
     }
-    else if (kind == cudaMemcpyDeviceToDevice)
+    if (bytes == NULL)
     {
-        Logger::log(LOG_TRACE, "Copying %ld bytes from device to device (async)\n", (long)count);
-        result = cudaMemcpyAsync((void*)dstPointerData->getPointer(env), (void*)srcPointerData->getPointer(env), (size_t)count, cudaMemcpyDeviceToDevice, nativeStream);
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'bytes' is null for cudaPitchPackerGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
     }
-    else
+    if (nanos == NULL)
     {
-        Logger::log(LOG_ERROR, "Invalid cudaMemcpyKind given: %d\n", kind);
-        return cudaErrorInvalidMemcpyDirection;
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'nanos' is null for cudaPitchPackerGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
     }
+    Logger::log(LOG_TRACE, "Executing cudaPitchPackerGetStatistics\n");
 
-    // Release the pointer data
-    if (!releasePointerData(env, dstPointerData)) return JCUDA_INTERNAL_ERROR;
-    if (!releasePointerData(env, srcPointerData, JNI_ABORT)) return JCUDA_INTERNAL_ERROR;
-    return result;
+    PitchPackerStatistics statistics;
+    pitchPacker.getStatistics(&statistics);
+    if (!set(env, copies, 0, (jlong)statistics.copies)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, bytes, 0, (jlong)statistics.bytes)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, nanos, 0, (jlong)statistics.nanos)) return JCUDA_INTERNAL_ERROR;
+    return cudaSuccess;
 }
 
 
@@ -3165,7 +5239,8 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpyPeerAsyncNative
     }
 
     // Execute the cudaMemcpy operation
-    int result = cudaMemcpyPeerAsync((void*)dstPointerData->getPointer(env), (int)dstDevice, (void*)srcPointerData->getPointer(env), (int)srcDevice, (size_t)count, nativeStream);
+    int result = peerRouter.copy((void*)dstPointerData->getPointer(env), getPeerEndpoint((int)dstDevice),
+        (void*)srcPointerData->getPointer(env), getPeerEndpoint((int)srcDevice), (size_t)count, nativeStream, true);
 
     // Release the pointer data
     if (!releasePointerData(env, dstPointerData)) return JCUDA_INTERNAL_ERROR;
@@ -3174,6 +5249,101 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpyPeerAsyncNative
 }
 
 
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaPeerRouterEnableNative
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaPeerRouterEnableNative
+  (JNIEnv *env, jclass cls, jlong chunkSize)
+{
+    Logger::log(LOG_TRACE, "Executing cudaPeerRouterEnable\n");
+
+    if (chunkSize <= 0)
+    {
+        return cudaErrorInvalidValue;
+    }
+    return peerRouter.enable((size_t)chunkSize);
+}
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaPeerRouterDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaPeerRouterDisableNative
+  (JNIEnv *env, jclass cls)
+{
+    Logger::log(LOG_TRACE, "Executing cudaPeerRouterDisable\n");
+
+    peerRouter.disable();
+    return cudaSuccess;
+}
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaPeerRouterGetRouteNative
+ * Signature: ([III)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaPeerRouterGetRouteNative
+  (JNIEnv *env, jclass cls, jintArray route, jint srcDevice, jint dstDevice)
+{
+    if (route == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'route' is null for cudaPeerRouterGetRoute");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cudaPeerRouterGetRoute\n");
+
+    int nativeRoute = 0;
+    int result = peerRouter.getRoute((int)srcDevice, (int)dstDevice, &nativeRoute);
+    if (!set(env, route, 0, nativeRoute)) return JCUDA_INTERNAL_ERROR;
+    return result;
+}
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaPeerRouterGetStatisticsNative
+ * Signature: ([J[J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaPeerRouterGetStatisticsNative
+  (JNIEnv *env, jclass cls, jlongArray directCount, jlongArray directBytes, jlongArray stagedCount, jlongArray stagedBytes)
+{
+    if (directCount == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'directCount' is null for cudaPeerRouterGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (directBytes == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'directBytes' is null for cudaPeerRouterGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (stagedCount == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'stagedCount' is null for cudaPeerRouterGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (stagedBytes == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'stagedBytes' is null for cudaPeerRouterGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cudaPeerRouterGetStatistics\n");
+
+    PeerRouterStatistics statistics;
+    peerRouter.getStatistics(&statistics);
+    if (!set(env, directCount, 0, (jlong)statistics.directCount)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, directBytes, 0, (jlong)statistics.directBytes)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, stagedCount, 0, (jlong)statistics.stagedCount)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, stagedBytes, 0, (jlong)statistics.stagedBytes)) return JCUDA_INTERNAL_ERROR;
+    return cudaSuccess;
+}
+
+
 /*
  * Class:     jcuda_runtime_JCuda
  * Method:    cudaMemcpyToArrayAsyncNative
@@ -3780,6 +5950,7 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaStreamDestroyNative
     Logger::log(LOG_TRACE, "Executing cudaStreamDestroy\n");
 
     cudaStream_t nativeStream = (cudaStream_t)getNativePointerValue(env, stream);
+    bounceRing.removeStream(env, nativeStream);
     return cudaStreamDestroy(nativeStream);
 }
 
@@ -3845,7 +6016,9 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaStreamSynchronizeNative
     Logger::log(LOG_TRACE, "Executing cudaStreamSynchronize\n");
 
     cudaStream_t nativeStream = (cudaStream_t)getNativePointerValue(env, stream);
-    return cudaStreamSynchronize(nativeStream);
+    int result = cudaStreamSynchronize(nativeStream);
+    bounceRing.completeReady(env);
+    return result;
 }
 
 
@@ -3869,7 +6042,12 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaStreamQueryNative
     Logger::log(LOG_TRACE, "Executing cudaStreamQuery\n");
 
     cudaStream_t nativeStream = (cudaStream_t)getNativePointerValue(env, stream);
-    return cudaStreamQuery(nativeStream);
+    int result = cudaStreamQuery(nativeStream);
+    if (result == cudaSuccess)
+    {
+        bounceRing.completeReady(env);
+    }
+    return result;
 }
 
 
@@ -3969,7 +6147,12 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaEventQueryNative
     Logger::log(LOG_TRACE, "Executing cudaEventQuery\n");
 
     cudaEvent_t nativeEvent = (cudaEvent_t)getNativePointerValue(env, event);
-    return cudaEventQuery(nativeEvent);
+    int result = cudaEventQuery(nativeEvent);
+    if (result == cudaSuccess)
+    {
+        bounceRing.completeReady(env);
+    }
+    return result;
 }
 
 
@@ -3991,7 +6174,9 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaEventSynchronizeNative
     Logger::log(LOG_TRACE, "Executing cudaEventSynchronize\n");
 
     cudaEvent_t nativeEvent = (cudaEvent_t)getNativePointerValue(env, event);
-    return cudaEventSynchronize(nativeEvent);
+    int result = cudaEventSynchronize(nativeEvent);
+    bounceRing.completeReady(env);
+    return result;
 }
 
 
@@ -4019,6 +6204,179 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaEventDestroyNative
 
 
 
+/**
+ * Returns the JNIEnv of the calling thread, attaching the thread
+ * to the VM as a daemon thread if necessary
+ */
+static JNIEnv* getWorkerEnv()
+{
+    JNIEnv *env = NULL;
+    if (globalJvm->GetEnv((void **)&env, JNI_VERSION_1_4) == JNI_EDETACHED)
+    {
+        if (globalJvm->AttachCurrentThreadAsDaemon((void **)&env, NULL) != JNI_OK)
+        {
+            Logger::log(LOG_ERROR, "Could not attach worker thread\n");
+            return NULL;
+        }
+    }
+    return env;
+}
+
+/**
+ * The exit function of native worker threads
+ */
+static void detachWorker(void * /*argument*/)
+{
+    JNIEnv *env = NULL;
+    if (globalJvm->GetEnv((void **)&env, JNI_VERSION_1_4) == JNI_OK)
+    {
+        globalJvm->DetachCurrentThread();
+    }
+}
+
+/**
+ * The service that completes the EventFutures. It is created when the
+ * first future is registered, and is never destroyed, because its
+ * thread calls into the VM.
+ */
+Mutex completionServiceMutex;
+CompletionService *completionService = NULL;
+
+/**
+ * The maximum time between two queries of a pending event
+ */
+#define COMPLETION_MAX_POLL_MICROS 1000
+
+/**
+ * The CompletionQueryFunction for events of the runtime API, whose
+ * context is always NULL
+ */
+static void queryCompletionEvents(void * /*context*/, void **events, int *results, int count)
+{
+    for (int i=0; i<count; i++)
+    {
+        results[i] = cudaEventQuery((cudaEvent_t)events[i]);
+    }
+}
+
+/**
+ * The CompletionBatchFunction that completes the EventFutures that
+ * are the user data of the given entries, and deletes the global
+ * references to them. The polling thread stays attached, so all
+ * batches are completed with the same JNIEnv. If the thread can not
+ * be attached, the entries are kept by the service and passed again.
+ */
+static bool completeEventFutures(CompletionEntry *entries, int count)
+{
+    JNIEnv *env = getWorkerEnv();
+    if (env == NULL)
+    {
+        return false;
+    }
+
+    // Complete the bounced copies into Java arrays before the futures,
+    // so that the listeners see the data of the completed copies
+    bounceRing.completeReady(env);
+    for (int i=0; i<count; i++)
+    {
+        jobject future = (jobject)entries[i].userData;
+        env->CallVoidMethod(future, EventFuture_complete, (jint)entries[i].result);
+        if (env->ExceptionCheck())
+        {
+            Logger::log(LOG_ERROR, "Exception in event future listener\n");
+            env->ExceptionDescribe();
+            env->ExceptionClear();
+        }
+        env->DeleteGlobalRef(future);
+    }
+    return true;
+}
+
+/**
+ * Returns the completion service, creating it if necessary
+ */
+static CompletionService* getCompletionService()
+{
+    MutexLock lock(completionServiceMutex);
+    if (completionService == NULL)
+    {
+        completionService = new CompletionService(&queryCompletionEvents, cudaErrorNotReady,
+            &completeEventFutures, COMPLETION_MAX_POLL_MICROS, &detachWorker);
+    }
+    return completionService;
+}
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaEventRegisterFutureNative
+ * Signature: (Ljcuda/EventFuture;Ljcuda/runtime/cudaEvent_t;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaEventRegisterFutureNative
+  (JNIEnv *env, jclass cls, jobject future, jobject event)
+{
+    if (future == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'future' is null for cudaEventRegisterFuture");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (event == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'event' is null for cudaEventRegisterFuture");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cudaEventRegisterFuture\n");
+
+    cudaEvent_t nativeEvent = (cudaEvent_t)getNativePointerValue(env, event);
+    jobject globalFuture = env->NewGlobalRef(future);
+    if (globalFuture == NULL)
+    {
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (!getCompletionService()->add(NULL, nativeEvent, globalFuture))
+    {
+        env->DeleteGlobalRef(globalFuture);
+        return cudaErrorUnknown;
+    }
+    return cudaSuccess;
+}
+
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaEventFutureGetStatisticsNative
+ * Signature: ([J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaEventFutureGetStatisticsNative
+  (JNIEnv *env, jclass cls, jlongArray pending, jlongArray completed, jlongArray batches)
+{
+    if (pending == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'pending' is null for cudaEventFutureGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (completed == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'completed' is null for cudaEventFutureGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    if (batches == NULL)
+    {
+        ThrowByName(env, "java/lang/NullPointerException", "Parameter 'batches' is null for cudaEventFutureGetStatistics");
+        return JCUDA_INTERNAL_ERROR;
+    }
+    Logger::log(LOG_TRACE, "Executing cudaEventFutureGetStatistics\n");
+
+    jcuda_int64 nativePending = 0;
+    jcuda_int64 nativeCompleted = 0;
+    jcuda_int64 nativeBatches = 0;
+    getCompletionService()->getStatistics(&nativePending, &nativeCompleted, &nativeBatches);
+    if (!set(env, pending, 0, (jlong)nativePending)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, completed, 0, (jlong)nativeCompleted)) return JCUDA_INTERNAL_ERROR;
+    if (!set(env, batches, 0, (jlong)nativeBatches)) return JCUDA_INTERNAL_ERROR;
+    return cudaSuccess;
+}
+
+
 /*
  * Class:     jcuda_runtime_JCuda
  * Method:    cudaEventElapsedTimeNative
@@ -4071,6 +6429,12 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaThreadExitNative
 {
     Logger::log(LOG_TRACE, "Executing cudaThreadExit\n");
 
+    unregisterDeviceAllocations();
+    removeDevicePeerEndpoint();
+    removeDeviceRegistrations(env);
+    removeDeviceCopyStaging();
+    removeDeviceBounceSlots(env);
+    removeDevicePitchStaging();
     return cudaThreadExit();
 }
 
@@ -4087,7 +6451,9 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaThreadSynchronizeNative
 {
     Logger::log(LOG_TRACE, "Executing cudaThreadSynchronize\n");
 
-    return cudaThreadSynchronize();
+    int result = cudaThreadSynchronize();
+    bounceRing.completeReady(env);
+    return result;
 }
 
 
@@ -190,6 +190,14 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaGetDevicePropertiesNative
 JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaDeviceGetAttributeNative
   (JNIEnv *, jclass, jintArray, jint, jint);
 
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaGetDeviceSnapshotNative
+ * Signature: (Ljcuda/runtime/cudaDeviceSnapshot;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaGetDeviceSnapshotNative
+  (JNIEnv *, jclass, jobject);
+
 /*
  * Class:     jcuda_runtime_JCuda
  * Method:    cudaChooseDeviceNative
@@ -334,6 +342,38 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostRegisterNative
 JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostUnregisterNative
   (JNIEnv *, jclass, jobject);
 
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaRegistrationCacheEnableNative
+ * Signature: (IJ)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaRegistrationCacheEnableNative
+  (JNIEnv *, jclass, jint, jlong);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaRegistrationCacheDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaRegistrationCacheDisableNative
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaRegistrationCacheReleaseNative
+ * Signature: (Ljcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaRegistrationCacheReleaseNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaRegistrationCacheGetStatisticsNative
+ * Signature: ([J[J[J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaRegistrationCacheGetStatisticsNative
+  (JNIEnv *, jclass, jlongArray, jlongArray, jlongArray, jlongArray, jlongArray);
+
 /*
  * Class:     jcuda_runtime_JCuda
  * Method:    cudaHostGetDevicePointerNative
@@ -390,6 +430,70 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaFreeNative
 JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaFreeHostNative
   (JNIEnv *, jclass, jobject);
 
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaHostSetPlacementNative
+ * Signature: (I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostSetPlacementNative
+  (JNIEnv *, jclass, jint);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaHostGetNumaNodeNative
+ * Signature: ([ILjcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostGetNumaNodeNative
+  (JNIEnv *, jclass, jintArray, jobject);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaDeviceGetHostNumaNodeNative
+ * Signature: ([II)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaDeviceGetHostNumaNodeNative
+  (JNIEnv *, jclass, jintArray, jint);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaHostArenaCreateNative
+ * Signature: (Ljcuda/runtime/cudaHostArena;JJI)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostArenaCreateNative
+  (JNIEnv *, jclass, jobject, jlong, jlong, jint);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaHostArenaDestroyNative
+ * Signature: (Ljcuda/runtime/cudaHostArena;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostArenaDestroyNative
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaHostArenaAllocNative
+ * Signature: (Ljcuda/runtime/cudaHostArena;Ljcuda/Pointer;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostArenaAllocNative
+  (JNIEnv *, jclass, jobject, jobject, jlong);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaHostArenaFreeNative
+ * Signature: (Ljcuda/runtime/cudaHostArena;Ljcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostArenaFreeNative
+  (JNIEnv *, jclass, jobject, jobject);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaHostArenaGetStatisticsNative
+ * Signature: (Ljcuda/runtime/cudaHostArena;Ljcuda/runtime/cudaHostArenaStatistics;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaHostArenaGetStatisticsNative
+  (JNIEnv *, jclass, jobject, jobject);
+
 /*
  * Class:     jcuda_runtime_JCuda
  * Method:    cudaFreeArrayNative
@@ -414,6 +518,22 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaFreeMipmappedArrayNative
 JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpyNative
   (JNIEnv *, jclass, jobject, jobject, jlong, jint);
 
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaMemcpyAutoNative
+ * Signature: (Ljcuda/Pointer;Ljcuda/Pointer;J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpyAutoNative
+  (JNIEnv *, jclass, jobject, jobject, jlong);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaMemRegistryLookupNative
+ * Signature: ([I[ILjcuda/Pointer;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemRegistryLookupNative
+  (JNIEnv *, jclass, jintArray, jintArray, jobject);
+
 /*
  * Class:     jcuda_runtime_JCuda
  * Method:    cudaMemcpyPeerNative
@@ -502,6 +622,86 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpyFromSymbolNative
 JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpyAsyncNative
   (JNIEnv *, jclass, jobject, jobject, jlong, jint, jobject);
 
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaCopyPlannerEnableNative
+ * Signature: (JJ)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaCopyPlannerEnableNative
+  (JNIEnv *, jclass, jlong, jlong);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaCopyPlannerDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaCopyPlannerDisableNative
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaCopyPlannerGetLastStrategyNative
+ * Signature: ([I)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaCopyPlannerGetLastStrategyNative
+  (JNIEnv *, jclass, jintArray);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaCopyPlannerGetStatisticsNative
+ * Signature: ([J[J[J[J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaCopyPlannerGetStatisticsNative
+  (JNIEnv *, jclass, jlongArray, jlongArray, jlongArray, jlongArray, jlongArray, jlongArray);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaBounceRingEnableNative
+ * Signature: (JI)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaBounceRingEnableNative
+  (JNIEnv *, jclass, jlong, jint);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaBounceRingDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaBounceRingDisableNative
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaBounceRingGetStatisticsNative
+ * Signature: ([J[J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaBounceRingGetStatisticsNative
+  (JNIEnv *, jclass, jlongArray, jlongArray, jlongArray, jlongArray);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaPitchPackerEnableNative
+ * Signature: (IJ)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaPitchPackerEnableNative
+  (JNIEnv *, jclass, jint, jlong);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaPitchPackerDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaPitchPackerDisableNative
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaPitchPackerGetStatisticsNative
+ * Signature: ([J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaPitchPackerGetStatisticsNative
+  (JNIEnv *, jclass, jlongArray, jlongArray, jlongArray);
+
 /*
  * Class:     jcuda_runtime_JCuda
  * Method:    cudaMemcpyPeerAsyncNative
@@ -510,6 +710,38 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpyAsyncNative
 JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaMemcpyPeerAsyncNative
   (JNIEnv *, jclass, jobject, jint, jobject, jint, jlong, jobject);
 
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaPeerRouterEnableNative
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaPeerRouterEnableNative
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaPeerRouterDisableNative
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaPeerRouterDisableNative
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaPeerRouterGetRouteNative
+ * Signature: ([III)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaPeerRouterGetRouteNative
+  (JNIEnv *, jclass, jintArray, jint, jint);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaPeerRouterGetStatisticsNative
+ * Signature: ([J[J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaPeerRouterGetStatisticsNative
+  (JNIEnv *, jclass, jlongArray, jlongArray, jlongArray, jlongArray);
+
 /*
  * Class:     jcuda_runtime_JCuda
  * Method:    cudaMemcpyToArrayAsyncNative
@@ -750,6 +982,22 @@ JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaEventSynchronizeNative
 JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaEventDestroyNative
   (JNIEnv *, jclass, jobject);
 
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaEventRegisterFutureNative
+ * Signature: (Ljcuda/EventFuture;Ljcuda/runtime/cudaEvent_t;)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaEventRegisterFutureNative
+  (JNIEnv *, jclass, jobject, jobject);
+
+/*
+ * Class:     jcuda_runtime_JCuda
+ * Method:    cudaEventFutureGetStatisticsNative
+ * Signature: ([J[J[J)I
+ */
+JNIEXPORT jint JNICALL Java_jcuda_runtime_JCuda_cudaEventFutureGetStatisticsNative
+  (JNIEnv *, jclass, jlongArray, jlongArray, jlongArray);
+
 /*
  * Class:     jcuda_runtime_JCuda
  * Method:    cudaEventElapsedTimeNative